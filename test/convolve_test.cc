@@ -579,6 +579,70 @@ TEST_P(ConvolveTest, CheckScalingFiltering) {
   }
 }
 
+/* This test compares the filters of scaled references with the C versions,
+   from the 16x upscale to the 2x downscale, with the two directions scaled
+   together and on their own. */
+TEST_P(ConvolveTest, MatchesCScaledFilter) {
+  uint8_t* const in = input();
+  uint8_t* const out = output();
+  uint8_t ref[kOutputStride * kMaxDimension];
+  const ConvolveFunc funcs[] = {
+    UUT_->h8_, UUT_->v8_, UUT_->hv8_,
+    UUT_->h8_avg_, UUT_->v8_avg_, UUT_->hv8_avg_
+  };
+  const ConvolveFunc ref_funcs[] = {
+    vp9_convolve8_horiz_c, vp9_convolve8_vert_c, vp9_convolve8_c,
+    vp9_convolve8_avg_horiz_c, vp9_convolve8_avg_vert_c, vp9_convolve8_avg_c
+  };
+
+  ::libvpx_test::ACMRandom prng;
+  for (int i = 0; i < kInputBufferSize; ++i)
+    input_[i] = prng.Rand8();
+
+  for (int step = 1; step <= 32; ++step) {
+    const int steps[3][2] = { { step, step }, { step, 16 }, { 16, step } };
+    for (int s = 0; s < 3; ++s) {
+      const int x_step_q4 = steps[s][0];
+      const int y_step_q4 = steps[s][1];
+      for (int filter_bank = 0; filter_bank < kNumFilterBanks;
+           ++filter_bank) {
+        const InterpKernel *filters =
+            vp9_get_interp_kernel(static_cast<INTERP_FILTER>(filter_bank));
+        const int filter_x = prng.Rand8() % kNumFilters;
+        const int filter_y = prng.Rand8() % kNumFilters;
+
+        for (int f = 0; f < 6; ++f) {
+          for (int y = 0; y < Height(); ++y) {
+            for (int x = 0; x < Width(); ++x) {
+              const uint8_t r = prng.Rand8();
+              out[y * kOutputStride + x] = r;
+              ref[y * kOutputStride + x] = r;
+            }
+          }
+
+          ref_funcs[f](in, kInputStride, ref, kOutputStride,
+                       filters[filter_x], x_step_q4,
+                       filters[filter_y], y_step_q4, Width(), Height());
+          ASM_REGISTER_STATE_CHECK(
+              funcs[f](in, kInputStride, out, kOutputStride,
+                       filters[filter_x], x_step_q4,
+                       filters[filter_y], y_step_q4, Width(), Height()));
+
+          for (int y = 0; y < Height(); ++y)
+            for (int x = 0; x < Width(); ++x)
+              ASSERT_EQ(ref[y * kOutputStride + x],
+                        out[y * kOutputStride + x])
+                  << "mismatch at (" << x << "," << y << "), "
+                  << "function " << f << ", filters (" << filter_bank << ","
+                  << filter_x << "," << filter_y << "), steps ("
+                  << x_step_q4 << "," << y_step_q4 << ")";
+        }
+      }
+    }
+  }
+  CheckGuardBlocks();
+}
+
 using std::tr1::make_tuple;
 
 #if CONFIG_VP9_HIGHBITDEPTH
@@ -34,21 +34,24 @@ void Encoder::EncodeFrame(VideoSource *video, const unsigned long frame_flags) {
   }
 }
 
-void Encoder::EncodeFrameInternal(const VideoSource &video,
-                                  const unsigned long frame_flags) {
-  vpx_codec_err_t res;
-  const vpx_image_t *img = video.img();
+void Encoder::InitEncoder(VideoSource *video) {
+  const vpx_image_t *img = video->img();
 
-  // Handle first frame initialization
-  if (!encoder_.priv) {
+  if (img && !encoder_.priv) {
     cfg_.g_w = img->d_w;
     cfg_.g_h = img->d_h;
-    cfg_.g_timebase = video.timebase();
+    cfg_.g_timebase = video->timebase();
     cfg_.rc_twopass_stats_in = stats_->buf();
-    res = vpx_codec_enc_init(&encoder_, CodecInterface(), &cfg_,
-                             init_flags_);
+    const vpx_codec_err_t res = vpx_codec_enc_init(&encoder_, CodecInterface(),
+                                                   &cfg_, init_flags_);
     ASSERT_EQ(VPX_CODEC_OK, res) << EncoderError();
   }
+}
+
+void Encoder::EncodeFrameInternal(const VideoSource &video,
+                                  const unsigned long frame_flags) {
+  vpx_codec_err_t res;
+  const vpx_image_t *img = video.img();
 
   // Handle frame resizing
   if (cfg_.g_w != img->d_w || cfg_.g_h != img->d_h) {
@@ -159,8 +162,11 @@ void EncoderTest::RunLoop(VideoSource *video) {
                                                    &stats_);
     ASSERT_TRUE(encoder != NULL);
     Decoder* const decoder = codec_->CreateDecoder(dec_cfg, 0);
+    video->Begin();
+    encoder->InitEncoder(video);
+    ASSERT_FALSE(::testing::Test::HasFatalFailure());
     bool again;
-    for (again = true, video->Begin(); again; video->Next()) {
+    for (again = true; again; video->Next()) {
       again = (video->img() != NULL);
 
       PreEncodeFrameHook(video);
@@ -200,6 +206,8 @@ void EncoderTest::RunLoop(VideoSource *video) {
         }
       }
 
+      PostEncodeFrameHook(video, encoder);
+
       if (has_dxdata && has_cxdata) {
         const vpx_image_t *img_enc = encoder->GetPreviewFrame();
         DxDataIterator dec_iter = decoder->GetDxData();
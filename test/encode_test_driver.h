@@ -107,6 +107,11 @@ class Encoder {
   const vpx_image_t *GetPreviewFrame() {
     return vpx_codec_get_preview_frame(&encoder_);
   }
+
+  // Initialize the encoder for the first frame of the video, so that the
+  // controls can be set before it is encoded.
+  void InitEncoder(VideoSource *video);
+
   // This is a thin wrapper around vpx_codec_encode(), so refer to
   // vpx_encoder.h for its semantics.
   void EncodeFrame(VideoSource *video, const unsigned long frame_flags);
@@ -136,6 +141,11 @@ class Encoder {
     const vpx_codec_err_t res = vpx_codec_control_(&encoder_, ctrl_id, arg);
     ASSERT_EQ(VPX_CODEC_OK, res) << EncoderError();
   }
+
+  void Control(int ctrl_id, vpx_frame_stats_t *arg) {
+    const vpx_codec_err_t res = vpx_codec_control_(&encoder_, ctrl_id, arg);
+    ASSERT_EQ(VPX_CODEC_OK, res) << EncoderError();
+  }
 #endif
 
   void set_deadline(unsigned long deadline) {
@@ -199,6 +209,10 @@ class EncoderTest {
   virtual void PreEncodeFrameHook(VideoSource* /*video*/,
                                   Encoder* /*encoder*/) {}
 
+  // Hook to be called after the packets of a frame have been handled.
+  virtual void PostEncodeFrameHook(VideoSource* /*video*/,
+                                   Encoder* /*encoder*/) {}
+
   // Hook to be called on every compressed data packet.
   virtual void FramePktHook(const vpx_codec_cx_pkt_t* /*pkt*/) {}
 
@@ -8,6 +8,7 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <algorithm>
 #include <string>
 
 #include "./vpx_config.h"
@@ -17,6 +18,7 @@
 #include "test/md5_helper.h"
 #include "test/test_vectors.h"
 #include "test/util.h"
+#include "vpx/vp8dx.h"
 #if CONFIG_WEBM_IO
 #include "test/webm_video_source.h"
 #endif
@@ -121,6 +123,24 @@ class ExternalFrameBufferList {
     }
   }
 
+  // Checks that the state of each frame buffer reported by |decoder| matches
+  // the frame buffers handed out to libvpx. Returns the number of reference
+  // slots pointing to the frame buffers.
+  int CheckFrameBufferStates(libvpx_test::Decoder *decoder) {
+    int num_refs = 0;
+    for (int i = 0; i < num_buffers_; ++i) {
+      vpx_frame_buffer_state_t state;
+      state.priv = &ext_fb_list_[i];
+      decoder->Control(VP9D_GET_FRAME_BUFFER_STATE, &state);
+      EXPECT_EQ(ext_fb_list_[i].in_use, state.in_use);
+      if (!state.in_use) {
+        EXPECT_EQ(0, state.num_refs);
+      }
+      num_refs += state.num_refs;
+    }
+    return num_refs;
+  }
+
  private:
   // Returns the index of the first free frame buffer. Returns |num_buffers_|
   // if there are no free frame buffers.
@@ -278,7 +298,9 @@ class ExternalFrameBufferTest : public ::testing::Test {
   ExternalFrameBufferTest()
       : video_(NULL),
         decoder_(NULL),
-        num_buffers_(0) {}
+        num_buffers_(0),
+        frame_border_(0),
+        check_states_(false) {}
 
   virtual void SetUp() {
     video_ = new libvpx_test::WebMVideoSource(kVP9TestFile);
@@ -309,6 +331,14 @@ class ExternalFrameBufferTest : public ::testing::Test {
     return decoder_->SetFrameBufferFunctions(cb_get, cb_release, &fb_list_);
   }
 
+  // Has libvpx extend the decoded frames into a border of |border| pixels.
+  void SetFrameBorder(int border) {
+    frame_border_ = border;
+    decoder_->Control(VP9D_SET_FRAME_BORDER, border);
+  }
+
+  void set_check_states(bool check_states) { check_states_ = check_states; }
+
   vpx_codec_err_t DecodeOneFrame() {
     const vpx_codec_err_t res =
         decoder_->DecodeFrame(video_->cxdata(), video_->frame_size());
@@ -337,12 +367,41 @@ class ExternalFrameBufferTest : public ::testing::Test {
     // Get decompressed data
     while ((img = dec_iter.Next()) != NULL) {
       fb_list_.CheckXImageFrameBuffer(img);
+      if (frame_border_ > 0)
+        CheckFrameBorder(img);
+    }
+
+    // All the reference slots point to a frame buffer once the first key
+    // frame is decoded.
+    if (check_states_) {
+      EXPECT_EQ(8, fb_list_.CheckFrameBufferStates(decoder_));
+    }
+  }
+
+  // Checks that the luma plane of |img| is extended into the border.
+  void CheckFrameBorder(const vpx_image_t *img) {
+    const int stride = img->stride[VPX_PLANE_Y];
+    const int w = img->d_w;
+    const int h = img->d_h;
+    const uint8_t *const y = img->planes[VPX_PLANE_Y];
+
+    for (int r = -frame_border_; r < h + frame_border_; ++r) {
+      const uint8_t *const row = y + std::min(std::max(r, 0), h - 1) * stride;
+      for (int c = 1; c <= frame_border_; ++c) {
+        ASSERT_EQ(row[0], y[r * stride - c]) << "row " << r;
+        ASSERT_EQ(row[w - 1], y[r * stride + w - 1 + c]) << "row " << r;
+      }
+      if (r < 0 || r >= h) {
+        ASSERT_EQ(0, memcmp(row, y + r * stride, w)) << "row " << r;
+      }
     }
   }
 
   libvpx_test::WebMVideoSource *video_;
   libvpx_test::VP9Decoder *decoder_;
   int num_buffers_;
+  int frame_border_;
+  bool check_states_;
   ExternalFrameBufferList fb_list_;
 };
 #endif  // CONFIG_WEBM_IO
@@ -415,6 +474,26 @@ TEST_F(ExternalFrameBufferTest, EightJitterBuffers) {
   ASSERT_EQ(VPX_CODEC_OK, DecodeRemainingFrames());
 }
 
+TEST_F(ExternalFrameBufferTest, FrameBufferStates) {
+  const int jitter_buffers = 8;
+  const int num_buffers =
+      VP9_MAXIMUM_REF_BUFFERS + VPX_MAXIMUM_WORK_BUFFERS + jitter_buffers;
+  ASSERT_EQ(VPX_CODEC_OK,
+            SetFrameBufferFunctions(
+                num_buffers, get_vp9_frame_buffer, release_vp9_frame_buffer));
+  set_check_states(true);
+  ASSERT_EQ(VPX_CODEC_OK, DecodeRemainingFrames());
+}
+
+TEST_F(ExternalFrameBufferTest, ExtendedFrameBorder) {
+  const int num_buffers = VP9_MAXIMUM_REF_BUFFERS + VPX_MAXIMUM_WORK_BUFFERS;
+  ASSERT_EQ(VPX_CODEC_OK,
+            SetFrameBufferFunctions(
+                num_buffers, get_vp9_frame_buffer, release_vp9_frame_buffer));
+  ASSERT_NO_FATAL_FAILURE(SetFrameBorder(64));
+  ASSERT_EQ(VPX_CODEC_OK, DecodeRemainingFrames());
+}
+
 TEST_F(ExternalFrameBufferTest, NotEnoughBuffers) {
   // Minimum number of external frame buffers for VP9 is
   // #VP9_MAXIMUM_REF_BUFFERS + #VPX_MAXIMUM_WORK_BUFFERS. Most files will
@@ -495,4 +495,41 @@ INSTANTIATE_TEST_CASE_P(
         make_tuple(&vp9_fht4x4_sse2, &vp9_iht4x4_16_add_sse2, 3, VPX_BITS_8)));
 #endif
 
+#if HAVE_SSE2 && CONFIG_VP9_HIGHBITDEPTH
+INSTANTIATE_TEST_CASE_P(
+    SSE2, Trans4x4DCT,
+    ::testing::Values(
+        make_tuple(&vp9_high_fdct4x4_sse2, &idct4x4_10, 0, VPX_BITS_10),
+        make_tuple(&vp9_high_fdct4x4_sse2, &idct4x4_12, 0, VPX_BITS_12),
+        make_tuple(&vp9_high_fdct4x4_sse2, &vp9_idct4x4_16_add_c, 0,
+                   VPX_BITS_8)));
+INSTANTIATE_TEST_CASE_P(
+    SSE2, Trans4x4HT,
+    ::testing::Values(
+        make_tuple(&vp9_high_fht4x4_sse2, &iht4x4_10, 0, VPX_BITS_10),
+        make_tuple(&vp9_high_fht4x4_sse2, &iht4x4_10, 1, VPX_BITS_10),
+        make_tuple(&vp9_high_fht4x4_sse2, &iht4x4_10, 2, VPX_BITS_10),
+        make_tuple(&vp9_high_fht4x4_sse2, &iht4x4_10, 3, VPX_BITS_10),
+        make_tuple(&vp9_high_fht4x4_sse2, &iht4x4_12, 0, VPX_BITS_12),
+        make_tuple(&vp9_high_fht4x4_sse2, &iht4x4_12, 1, VPX_BITS_12),
+        make_tuple(&vp9_high_fht4x4_sse2, &iht4x4_12, 2, VPX_BITS_12),
+        make_tuple(&vp9_high_fht4x4_sse2, &iht4x4_12, 3, VPX_BITS_12),
+        make_tuple(&vp9_high_fht4x4_sse2, &vp9_iht4x4_16_add_c, 0,
+                   VPX_BITS_8),
+        make_tuple(&vp9_high_fht4x4_sse2, &vp9_iht4x4_16_add_c, 1,
+                   VPX_BITS_8),
+        make_tuple(&vp9_high_fht4x4_sse2, &vp9_iht4x4_16_add_c, 2,
+                   VPX_BITS_8),
+        make_tuple(&vp9_high_fht4x4_sse2, &vp9_iht4x4_16_add_c, 3,
+                   VPX_BITS_8)));
+#endif
+
+#if HAVE_AVX2 && !CONFIG_VP9_HIGHBITDEPTH
+INSTANTIATE_TEST_CASE_P(
+    AVX2, Trans4x4DCT,
+    ::testing::Values(
+        make_tuple(&vp9_fdct4x4_sse2,
+                   &vp9_idct4x4_16_add_avx2, 0, VPX_BITS_8)));
+#endif
+
 }  // namespace
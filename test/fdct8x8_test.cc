@@ -598,6 +598,35 @@ INSTANTIATE_TEST_CASE_P(
         make_tuple(&vp9_fht8x8_sse2, &vp9_iht8x8_64_add_sse2, 3, VPX_BITS_8)));
 #endif
 
+#if HAVE_SSE2 && CONFIG_VP9_HIGHBITDEPTH
+INSTANTIATE_TEST_CASE_P(
+    SSE2, FwdTrans8x8DCT,
+    ::testing::Values(
+        make_tuple(&vp9_high_fdct8x8_sse2, &idct8x8_10, 0, VPX_BITS_10),
+        make_tuple(&vp9_high_fdct8x8_sse2, &idct8x8_12, 0, VPX_BITS_12),
+        make_tuple(&vp9_high_fdct8x8_sse2, &vp9_idct8x8_64_add_c, 0,
+                   VPX_BITS_8)));
+INSTANTIATE_TEST_CASE_P(
+    SSE2, FwdTrans8x8HT,
+    ::testing::Values(
+        make_tuple(&vp9_high_fht8x8_sse2, &iht8x8_10, 0, VPX_BITS_10),
+        make_tuple(&vp9_high_fht8x8_sse2, &iht8x8_10, 1, VPX_BITS_10),
+        make_tuple(&vp9_high_fht8x8_sse2, &iht8x8_10, 2, VPX_BITS_10),
+        make_tuple(&vp9_high_fht8x8_sse2, &iht8x8_10, 3, VPX_BITS_10),
+        make_tuple(&vp9_high_fht8x8_sse2, &iht8x8_12, 0, VPX_BITS_12),
+        make_tuple(&vp9_high_fht8x8_sse2, &iht8x8_12, 1, VPX_BITS_12),
+        make_tuple(&vp9_high_fht8x8_sse2, &iht8x8_12, 2, VPX_BITS_12),
+        make_tuple(&vp9_high_fht8x8_sse2, &iht8x8_12, 3, VPX_BITS_12),
+        make_tuple(&vp9_high_fht8x8_sse2, &vp9_iht8x8_64_add_c, 0,
+                   VPX_BITS_8),
+        make_tuple(&vp9_high_fht8x8_sse2, &vp9_iht8x8_64_add_c, 1,
+                   VPX_BITS_8),
+        make_tuple(&vp9_high_fht8x8_sse2, &vp9_iht8x8_64_add_c, 2,
+                   VPX_BITS_8),
+        make_tuple(&vp9_high_fht8x8_sse2, &vp9_iht8x8_64_add_c, 3,
+                   VPX_BITS_8)));
+#endif
+
 #if HAVE_SSSE3 && ARCH_X86_64 && !CONFIG_VP9_HIGHBITDEPTH
 INSTANTIATE_TEST_CASE_P(
     SSSE3, FwdTrans8x8DCT,
@@ -22,6 +22,7 @@
 #include "vp9/common/vp9_blockd.h"
 #include "vp9/common/vp9_scan.h"
 #include "vpx/vpx_integer.h"
+#include "vpx_ports/vpx_timer.h"
 
 using libvpx_test::ACMRandom;
 
@@ -196,6 +197,37 @@ TEST_P(PartialIDctTest, ResultsMatch) {
   EXPECT_EQ(0, max_error)
       << "Error: partial inverse transform produces different results";
 }
+TEST_P(PartialIDctTest, DISABLED_Speed) {
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  const int size = 4 << tx_size_;
+  const int block_size = size * size;
+  const int num_blocks = 100000;
+  DECLARE_ALIGNED_ARRAY(16, tran_low_t, coeff, kMaxNumCoeffs);
+  DECLARE_ALIGNED_ARRAY(16, uint8_t, dst, kMaxNumCoeffs);
+
+  memset(coeff, 0, sizeof(*coeff) * block_size);
+  for (int j = 0; j < last_nonzero_; ++j)
+    coeff[vp9_default_scan_orders[tx_size_].scan[j]] = rnd.Rand8() - 128;
+  for (int j = 0; j < block_size; ++j)
+    dst[j] = rnd.Rand8();
+
+  vpx_usec_timer timer;
+  vpx_usec_timer_start(&timer);
+  for (int i = 0; i < num_blocks; ++i)
+    full_itxfm_(coeff, dst, size);
+  vpx_usec_timer_mark(&timer);
+  const int full_time = static_cast<int>(vpx_usec_timer_elapsed(&timer));
+
+  vpx_usec_timer_start(&timer);
+  for (int i = 0; i < num_blocks; ++i)
+    partial_itxfm_(coeff, dst, size);
+  vpx_usec_timer_mark(&timer);
+  const int partial_time = static_cast<int>(vpx_usec_timer_elapsed(&timer));
+
+  printf("%dx%d, %d coefficients: full %d us, partial %d us for %d blocks\n",
+         size, size, last_nonzero_, full_time, partial_time, num_blocks);
+}
+
 using std::tr1::make_tuple;
 
 INSTANTIATE_TEST_CASE_P(
@@ -294,6 +326,42 @@ INSTANTIATE_TEST_CASE_P(
                    TX_4X4, 1)));
 #endif
 
+#if HAVE_AVX2 && !CONFIG_VP9_HIGHBITDEPTH
+// The full transforms are checked against the C code as partial transforms
+// of all the coefficients.
+INSTANTIATE_TEST_CASE_P(
+    AVX2, PartialIDctTest,
+    ::testing::Values(
+        make_tuple(&vp9_fdct32x32_c,
+                   &vp9_idct32x32_1024_add_c,
+                   &vp9_idct32x32_1024_add_avx2,
+                   TX_32X32, 1024),
+        make_tuple(&vp9_fdct32x32_c,
+                   &vp9_idct32x32_1024_add_c,
+                   &vp9_idct32x32_34_add_avx2,
+                   TX_32X32, 34),
+        make_tuple(&vp9_fdct32x32_c,
+                   &vp9_idct32x32_1024_add_c,
+                   &vp9_idct32x32_1_add_avx2,
+                   TX_32X32, 1),
+        make_tuple(&vp9_fdct16x16_c,
+                   &vp9_idct16x16_256_add_c,
+                   &vp9_idct16x16_256_add_avx2,
+                   TX_16X16, 256),
+        make_tuple(&vp9_fdct16x16_c,
+                   &vp9_idct16x16_256_add_c,
+                   &vp9_idct16x16_10_add_avx2,
+                   TX_16X16, 10),
+        make_tuple(&vp9_fdct16x16_c,
+                   &vp9_idct16x16_256_add_c,
+                   &vp9_idct16x16_1_add_avx2,
+                   TX_16X16, 1),
+        make_tuple(&vp9_fdct4x4_c,
+                   &vp9_idct4x4_16_add_c,
+                   &vp9_idct4x4_16_add_avx2,
+                   TX_4X4, 16)));
+#endif
+
 #if HAVE_SSSE3 && ARCH_X86_64 && !CONFIG_VP9_HIGHBITDEPTH
 INSTANTIATE_TEST_CASE_P(
     SSSE3_64, PartialIDctTest,
@@ -313,4 +381,188 @@ INSTANTIATE_TEST_CASE_P(
                    &vp9_idct16x16_10_add_ssse3,
                    TX_16X16, 10)));
 #endif
+
+#if CONFIG_VP9_HIGHBITDEPTH
+typedef void (*HighInvTxfmFunc)(const tran_low_t *in, uint8_t *out, int stride,
+                                int bd);
+typedef void (*HighIhtFunc)(const tran_low_t *in, uint8_t *out, int stride,
+                            int tx_type, int bd);
+typedef std::tr1::tuple<HighInvTxfmFunc,
+                        HighInvTxfmFunc,
+                        TX_SIZE, int> HighInvTxfmParam;
+
+template <HighIhtFunc iht, int tx_type>
+void HighIht(const tran_low_t *in, uint8_t *out, int stride, int bd) {
+  iht(in, out, stride, tx_type, bd);
+}
+
+class HighInvTxfmTest : public ::testing::TestWithParam<HighInvTxfmParam> {
+ public:
+  virtual ~HighInvTxfmTest() {}
+  virtual void SetUp() {
+    ref_itxfm_ = GET_PARAM(0);
+    itxfm_ = GET_PARAM(1);
+    tx_size_  = GET_PARAM(2);
+    last_nonzero_ = GET_PARAM(3);
+  }
+
+  virtual void TearDown() { libvpx_test::ClearSystemState(); }
+
+ protected:
+  int last_nonzero_;
+  TX_SIZE tx_size_;
+  HighInvTxfmFunc ref_itxfm_;
+  HighInvTxfmFunc itxfm_;
+};
+
+// The transforms match the reference exactly at every bit depth, from small
+// coefficients up to the ones out of the range of the SIMD kernels.
+TEST_P(HighInvTxfmTest, ResultsMatch) {
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  const int size = 4 << tx_size_;
+  const int block_size = size * size;
+  const int count_test_block = 1000;
+  DECLARE_ALIGNED_ARRAY(16, tran_low_t, coeff, kMaxNumCoeffs);
+  DECLARE_ALIGNED_ARRAY(16, uint16_t, ref_dst, kMaxNumCoeffs);
+  DECLARE_ALIGNED_ARRAY(16, uint16_t, dst, kMaxNumCoeffs);
+
+  for (int bd = 8; bd <= 12; bd += 2) {
+    const int mask = (1 << bd) - 1;
+    for (int i = 0; i < count_test_block; ++i) {
+      const int bits = 1 + i % (bd + 8);
+      memset(coeff, 0, sizeof(*coeff) * block_size);
+      if (i % 10 == 9) {
+        // A single large coefficient, some out of the range of the SIMD
+        // kernels. No stage of the C transforms multiplies it by more than
+        // 1.5, so they do not overflow.
+        const int shift = 22 + rnd(8);
+        const int large = (1 << shift) + rnd(1 << shift);
+        coeff[vp9_default_scan_orders[tx_size_].scan[rnd(last_nonzero_)]] =
+            rnd(2) ? large : -large;
+      } else {
+        for (int j = 0; j < last_nonzero_; ++j) {
+          coeff[vp9_default_scan_orders[tx_size_].scan[j]] =
+              rnd(2 << bits) - (1 << bits);
+        }
+      }
+      for (int j = 0; j < block_size; ++j) {
+        if (i & 1)
+          ref_dst[j] = rnd(2) ? mask : 0;
+        else
+          ref_dst[j] = rnd.Rand16() & mask;
+        dst[j] = ref_dst[j];
+      }
+
+      ref_itxfm_(coeff, CONVERT_TO_BYTEPTR(ref_dst), size, bd);
+      ASM_REGISTER_STATE_CHECK(itxfm_(coeff, CONVERT_TO_BYTEPTR(dst), size,
+                                      bd));
+
+      for (int j = 0; j < block_size; ++j) {
+        ASSERT_EQ(ref_dst[j], dst[j])
+            << "bd " << bd << ", block " << i << ", at " << j;
+      }
+    }
+  }
+}
+
+INSTANTIATE_TEST_CASE_P(
+    C, HighInvTxfmTest,
+    ::testing::Values(
+        make_tuple(&vp9_high_idct32x32_1024_add_c,
+                   &vp9_high_idct32x32_34_add_c,
+                   TX_32X32, 34),
+        make_tuple(&vp9_high_idct32x32_1024_add_c,
+                   &vp9_high_idct32x32_1_add_c,
+                   TX_32X32, 1),
+        make_tuple(&vp9_high_idct16x16_256_add_c,
+                   &vp9_high_idct16x16_10_add_c,
+                   TX_16X16, 10),
+        make_tuple(&vp9_high_idct16x16_256_add_c,
+                   &vp9_high_idct16x16_1_add_c,
+                   TX_16X16, 1),
+        make_tuple(&vp9_high_idct8x8_64_add_c,
+                   &vp9_high_idct8x8_10_add_c,
+                   TX_8X8, 10),
+        make_tuple(&vp9_high_idct8x8_64_add_c,
+                   &vp9_high_idct8x8_1_add_c,
+                   TX_8X8, 1),
+        make_tuple(&vp9_high_idct4x4_16_add_c,
+                   &vp9_high_idct4x4_1_add_c,
+                   TX_4X4, 1),
+        make_tuple(&vp9_high_idct16x16_256_add_c,
+                   &HighIht<vp9_high_iht16x16_256_add_c, 0>,
+                   TX_16X16, 256),
+        make_tuple(&vp9_high_idct8x8_64_add_c,
+                   &HighIht<vp9_high_iht8x8_64_add_c, 0>,
+                   TX_8X8, 64),
+        make_tuple(&vp9_high_idct4x4_16_add_c,
+                   &HighIht<vp9_high_iht4x4_16_add_c, 0>,
+                   TX_4X4, 16)));
+
+#if HAVE_SSE2
+INSTANTIATE_TEST_CASE_P(
+    SSE2, HighInvTxfmTest,
+    ::testing::Values(
+        make_tuple(&vp9_high_idct32x32_1024_add_c,
+                   &vp9_high_idct32x32_1024_add_sse2,
+                   TX_32X32, 1024),
+        make_tuple(&vp9_high_idct32x32_34_add_c,
+                   &vp9_high_idct32x32_34_add_sse2,
+                   TX_32X32, 34),
+        make_tuple(&vp9_high_idct32x32_1_add_c,
+                   &vp9_high_idct32x32_1_add_sse2,
+                   TX_32X32, 1),
+        make_tuple(&vp9_high_idct16x16_256_add_c,
+                   &vp9_high_idct16x16_256_add_sse2,
+                   TX_16X16, 256),
+        make_tuple(&vp9_high_idct16x16_10_add_c,
+                   &vp9_high_idct16x16_10_add_sse2,
+                   TX_16X16, 10),
+        make_tuple(&vp9_high_idct16x16_1_add_c,
+                   &vp9_high_idct16x16_1_add_sse2,
+                   TX_16X16, 1),
+        make_tuple(&vp9_high_idct8x8_64_add_c,
+                   &vp9_high_idct8x8_64_add_sse2,
+                   TX_8X8, 64),
+        make_tuple(&vp9_high_idct8x8_10_add_c,
+                   &vp9_high_idct8x8_10_add_sse2,
+                   TX_8X8, 10),
+        make_tuple(&vp9_high_idct8x8_1_add_c,
+                   &vp9_high_idct8x8_1_add_sse2,
+                   TX_8X8, 1),
+        make_tuple(&vp9_high_idct4x4_16_add_c,
+                   &vp9_high_idct4x4_16_add_sse2,
+                   TX_4X4, 16),
+        make_tuple(&vp9_high_idct4x4_1_add_c,
+                   &vp9_high_idct4x4_1_add_sse2,
+                   TX_4X4, 1),
+        make_tuple(&HighIht<vp9_high_iht16x16_256_add_c, 1>,
+                   &HighIht<vp9_high_iht16x16_256_add_sse2, 1>,
+                   TX_16X16, 256),
+        make_tuple(&HighIht<vp9_high_iht16x16_256_add_c, 2>,
+                   &HighIht<vp9_high_iht16x16_256_add_sse2, 2>,
+                   TX_16X16, 256),
+        make_tuple(&HighIht<vp9_high_iht16x16_256_add_c, 3>,
+                   &HighIht<vp9_high_iht16x16_256_add_sse2, 3>,
+                   TX_16X16, 256),
+        make_tuple(&HighIht<vp9_high_iht8x8_64_add_c, 1>,
+                   &HighIht<vp9_high_iht8x8_64_add_sse2, 1>,
+                   TX_8X8, 64),
+        make_tuple(&HighIht<vp9_high_iht8x8_64_add_c, 2>,
+                   &HighIht<vp9_high_iht8x8_64_add_sse2, 2>,
+                   TX_8X8, 64),
+        make_tuple(&HighIht<vp9_high_iht8x8_64_add_c, 3>,
+                   &HighIht<vp9_high_iht8x8_64_add_sse2, 3>,
+                   TX_8X8, 64),
+        make_tuple(&HighIht<vp9_high_iht4x4_16_add_c, 1>,
+                   &HighIht<vp9_high_iht4x4_16_add_sse2, 1>,
+                   TX_4X4, 16),
+        make_tuple(&HighIht<vp9_high_iht4x4_16_add_c, 2>,
+                   &HighIht<vp9_high_iht4x4_16_add_sse2, 2>,
+                   TX_4X4, 16),
+        make_tuple(&HighIht<vp9_high_iht4x4_16_add_c, 3>,
+                   &HighIht<vp9_high_iht4x4_16_add_sse2, 3>,
+                   TX_4X4, 16)));
+#endif
+#endif  // CONFIG_VP9_HIGHBITDEPTH
 }  // namespace
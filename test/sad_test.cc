@@ -19,8 +19,12 @@
 #endif
 #if CONFIG_VP9_ENCODER
 #include "./vp9_rtcd.h"
+#if CONFIG_VP9_HIGHBITDEPTH
+#include "vp9/common/vp9_common.h"
+#endif
 #endif
 #include "vpx_mem/vpx_mem.h"
+#include "vpx_ports/mem.h"
 
 #include "test/acm_random.h"
 #include "test/clear_system_state.h"
@@ -375,6 +379,110 @@ TEST_P(SADx4Test, ShortSrc) {
   source_stride_ = tmp_stride;
 }
 
+#if CONFIG_VP9_ENCODER && CONFIG_VP9_HIGHBITDEPTH
+typedef std::tr1::tuple<int, int, SadMxNVp9Func, SadMxNx4Func> HighSadMxNParam;
+
+// The high bitdepth SAD and SADx4 of a block size, checked against a plain
+// SAD of 16 bit pixels at each of the bit depths.
+class HighSADTest : public ::testing::TestWithParam<HighSadMxNParam> {
+ public:
+  virtual void SetUp() {
+    width_ = GET_PARAM(0);
+    height_ = GET_PARAM(1);
+    rnd_.Reset(ACMRandom::DeterministicSeed());
+  }
+
+  virtual void TearDown() {
+    libvpx_test::ClearSystemState();
+  }
+
+ protected:
+  static const int kStride = 2 * 64 + 8;
+  // Rows below the block for the SADx4 references at their offsets.
+  static const int kBlockSize = 66 * kStride;
+
+  void FillConstant(uint16_t *data, int value) {
+    for (int i = 0; i < kBlockSize; ++i)
+      data[i] = value;
+  }
+
+  void FillRandom(uint16_t *data, int mask) {
+    for (int i = 0; i < kBlockSize; ++i)
+      data[i] = rnd_.Rand16() & mask;
+  }
+
+  unsigned int ReferenceSAD(const uint16_t *ref, int ref_stride) const {
+    unsigned int sad = 0;
+    for (int h = 0; h < height_; ++h)
+      for (int w = 0; w < width_; ++w)
+        sad += abs(source_[h * kStride + w] - ref[h * ref_stride + w]);
+    return sad;
+  }
+
+  // Checks both functions, the references of SADx4 starting 'offset' pixels
+  // apart so that they are not all aligned.
+  void CheckSADs(int ref_stride, int offset) {
+    const uint8_t *refs[4];
+    unsigned int sad, sads[4];
+
+    ASM_REGISTER_STATE_CHECK(sad = GET_PARAM(2)(CONVERT_TO_BYTEPTR(source_),
+                                                kStride,
+                                                CONVERT_TO_BYTEPTR(reference_),
+                                                ref_stride));
+    EXPECT_EQ(ReferenceSAD(reference_, ref_stride), sad);
+
+    for (int i = 0; i < 4; ++i) {
+      const uint16_t *const ref = reference_ + i * offset;
+      refs[i] = CONVERT_TO_BYTEPTR(ref);
+    }
+    ASM_REGISTER_STATE_CHECK(GET_PARAM(3)(CONVERT_TO_BYTEPTR(source_),
+                                          kStride, refs, ref_stride, sads));
+    for (int i = 0; i < 4; ++i)
+      EXPECT_EQ(ReferenceSAD(reference_ + i * offset, ref_stride), sads[i])
+          << "block " << i;
+  }
+
+  int width_, height_;
+  ACMRandom rnd_;
+  DECLARE_ALIGNED(16, uint16_t, source_[kBlockSize]);
+  DECLARE_ALIGNED(16, uint16_t, reference_[kBlockSize]);
+};
+
+TEST_P(HighSADTest, MaxRef) {
+  for (int bd = 8; bd <= 12; bd += 2) {
+    FillConstant(source_, 0);
+    FillConstant(reference_, (1 << bd) - 1);
+    CheckSADs(kStride, 0);
+  }
+}
+
+TEST_P(HighSADTest, MaxSrc) {
+  for (int bd = 8; bd <= 12; bd += 2) {
+    FillConstant(source_, (1 << bd) - 1);
+    FillConstant(reference_, 0);
+    CheckSADs(kStride, 0);
+  }
+}
+
+TEST_P(HighSADTest, Random) {
+  for (int bd = 8; bd <= 12; bd += 2) {
+    for (int i = 0; i < 16; ++i) {
+      FillRandom(source_, (1 << bd) - 1);
+      FillRandom(reference_, (1 << bd) - 1);
+      CheckSADs(kStride, width_);
+    }
+  }
+}
+
+TEST_P(HighSADTest, UnalignedRef) {
+  for (int bd = 8; bd <= 12; bd += 2) {
+    FillRandom(source_, (1 << bd) - 1);
+    FillRandom(reference_, (1 << bd) - 1);
+    CheckSADs(kStride - 1, 1);
+  }
+}
+#endif  // CONFIG_VP9_ENCODER && CONFIG_VP9_HIGHBITDEPTH
+
 using std::tr1::make_tuple;
 
 //------------------------------------------------------------------------------
@@ -445,6 +553,23 @@ INSTANTIATE_TEST_CASE_P(C, SADx4Test, ::testing::Values(
                         make_tuple(8, 4, sad_8x4x4d_c),
                         make_tuple(4, 8, sad_4x8x4d_c),
                         make_tuple(4, 4, sad_4x4x4d_c)));
+
+#if CONFIG_VP9_HIGHBITDEPTH
+INSTANTIATE_TEST_CASE_P(C, HighSADTest, ::testing::Values(
+    make_tuple(64, 64, vp9_high_sad64x64_c, vp9_high_sad64x64x4d_c),
+    make_tuple(64, 32, vp9_high_sad64x32_c, vp9_high_sad64x32x4d_c),
+    make_tuple(32, 64, vp9_high_sad32x64_c, vp9_high_sad32x64x4d_c),
+    make_tuple(32, 32, vp9_high_sad32x32_c, vp9_high_sad32x32x4d_c),
+    make_tuple(32, 16, vp9_high_sad32x16_c, vp9_high_sad32x16x4d_c),
+    make_tuple(16, 32, vp9_high_sad16x32_c, vp9_high_sad16x32x4d_c),
+    make_tuple(16, 16, vp9_high_sad16x16_c, vp9_high_sad16x16x4d_c),
+    make_tuple(16, 8, vp9_high_sad16x8_c, vp9_high_sad16x8x4d_c),
+    make_tuple(8, 16, vp9_high_sad8x16_c, vp9_high_sad8x16x4d_c),
+    make_tuple(8, 8, vp9_high_sad8x8_c, vp9_high_sad8x8x4d_c),
+    make_tuple(8, 4, vp9_high_sad8x4_c, vp9_high_sad8x4x4d_c),
+    make_tuple(4, 8, vp9_high_sad4x8_c, vp9_high_sad4x8x4d_c),
+    make_tuple(4, 4, vp9_high_sad4x4_c, vp9_high_sad4x4x4d_c)));
+#endif  // CONFIG_VP9_HIGHBITDEPTH
 #endif  // CONFIG_VP9_ENCODER
 
 //------------------------------------------------------------------------------
@@ -594,6 +719,23 @@ INSTANTIATE_TEST_CASE_P(SSE2, SADx4Test, ::testing::Values(
                         make_tuple(8, 8, sad_8x8x4d_sse2),
                         make_tuple(8, 4, sad_8x4x4d_sse2)));
 #endif  // CONFIG_USE_X86INC
+
+#if CONFIG_VP9_HIGHBITDEPTH
+INSTANTIATE_TEST_CASE_P(SSE2, HighSADTest, ::testing::Values(
+    make_tuple(64, 64, vp9_high_sad64x64_sse2, vp9_high_sad64x64x4d_sse2),
+    make_tuple(64, 32, vp9_high_sad64x32_sse2, vp9_high_sad64x32x4d_sse2),
+    make_tuple(32, 64, vp9_high_sad32x64_sse2, vp9_high_sad32x64x4d_sse2),
+    make_tuple(32, 32, vp9_high_sad32x32_sse2, vp9_high_sad32x32x4d_sse2),
+    make_tuple(32, 16, vp9_high_sad32x16_sse2, vp9_high_sad32x16x4d_sse2),
+    make_tuple(16, 32, vp9_high_sad16x32_sse2, vp9_high_sad16x32x4d_sse2),
+    make_tuple(16, 16, vp9_high_sad16x16_sse2, vp9_high_sad16x16x4d_sse2),
+    make_tuple(16, 8, vp9_high_sad16x8_sse2, vp9_high_sad16x8x4d_sse2),
+    make_tuple(8, 16, vp9_high_sad8x16_sse2, vp9_high_sad8x16x4d_sse2),
+    make_tuple(8, 8, vp9_high_sad8x8_sse2, vp9_high_sad8x8x4d_sse2),
+    make_tuple(8, 4, vp9_high_sad8x4_sse2, vp9_high_sad8x4x4d_sse2),
+    make_tuple(4, 8, vp9_high_sad4x8_sse2, vp9_high_sad4x8x4d_sse2),
+    make_tuple(4, 4, vp9_high_sad4x4_sse2, vp9_high_sad4x4x4d_sse2)));
+#endif  // CONFIG_VP9_HIGHBITDEPTH
 #endif  // CONFIG_VP9_ENCODER
 #endif  // HAVE_SSE2
 
@@ -630,6 +772,18 @@ const SadMxNx4Func sad_32x32x4d_avx2 = vp9_sad32x32x4d_avx2;
 INSTANTIATE_TEST_CASE_P(AVX2, SADx4Test, ::testing::Values(
                         make_tuple(32, 32, sad_32x32x4d_avx2),
                         make_tuple(64, 64, sad_64x64x4d_avx2)));
+
+#if CONFIG_VP9_HIGHBITDEPTH
+INSTANTIATE_TEST_CASE_P(AVX2, HighSADTest, ::testing::Values(
+    make_tuple(64, 64, vp9_high_sad64x64_avx2, vp9_high_sad64x64x4d_avx2),
+    make_tuple(64, 32, vp9_high_sad64x32_avx2, vp9_high_sad64x32x4d_avx2),
+    make_tuple(32, 64, vp9_high_sad32x64_avx2, vp9_high_sad32x64x4d_avx2),
+    make_tuple(32, 32, vp9_high_sad32x32_avx2, vp9_high_sad32x32x4d_avx2),
+    make_tuple(32, 16, vp9_high_sad32x16_avx2, vp9_high_sad32x16x4d_avx2),
+    make_tuple(16, 32, vp9_high_sad16x32_avx2, vp9_high_sad16x32x4d_avx2),
+    make_tuple(16, 16, vp9_high_sad16x16_avx2, vp9_high_sad16x16x4d_avx2),
+    make_tuple(16, 8, vp9_high_sad16x8_avx2, vp9_high_sad16x8x4d_avx2)));
+#endif  // CONFIG_VP9_HIGHBITDEPTH
 #endif  // CONFIG_VP9_ENCODER
 #endif  // HAVE_AVX2
 
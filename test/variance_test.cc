@@ -25,6 +25,9 @@
 #if CONFIG_VP9_ENCODER
 # include "./vp9_rtcd.h"
 # include "vp9/encoder/vp9_variance.h"
+# if CONFIG_VP9_HIGHBITDEPTH
+#  include "vp9/common/vp9_common.h"
+# endif
 #endif
 #include "test/acm_random.h"
 
@@ -428,6 +431,176 @@ void SubpelVarianceTest<vp9_subp_avg_variance_fn_t>::RefTest() {
   }
 }
 
+
+#if CONFIG_VP9_HIGHBITDEPTH
+// The variance of 16 bit pixels, with 'second_pred' averaged into the
+// bilinear prediction when set. The sums are rounded to 8 bit precision the
+// way the high bitdepth functions do.
+unsigned int high_variance_ref(const uint16_t *ref, const uint16_t *src,
+                               const uint16_t *second_pred,
+                               int l2w, int l2h, int xoff, int yoff,
+                               int bit_depth, unsigned int *sse_ptr) {
+  const int w = 1 << l2w, h = 1 << l2h;
+  const int shift = bit_depth - 8;
+  int64_t se = 0;
+  uint64_t sse = 0;
+  for (int y = 0; y < h; y++) {
+    for (int x = 0; x < w; x++) {
+      // bilinear interpolation at a 16th pel step
+      const int a1 = ref[(w + 1) * (y + 0) + x + 0];
+      const int a2 = ref[(w + 1) * (y + 0) + x + 1];
+      const int b1 = ref[(w + 1) * (y + 1) + x + 0];
+      const int b2 = ref[(w + 1) * (y + 1) + x + 1];
+      const int a = a1 + (((a2 - a1) * xoff + 8) >> 4);
+      const int b = b1 + (((b2 - b1) * xoff + 8) >> 4);
+      int r = a + (((b - a) * yoff + 8) >> 4);
+      if (second_pred != NULL)
+        r = (r + second_pred[w * y + x] + 1) >> 1;
+      const int64_t diff = r - src[w * y + x];
+      se += diff;
+      sse += diff * diff;
+    }
+  }
+  se = (se + ((1 << shift) >> 1)) >> shift;
+  sse = (sse + ((1 << 2 * shift) >> 1)) >> (2 * shift);
+  *sse_ptr = static_cast<unsigned int>(sse);
+  return static_cast<unsigned int>(static_cast<int64_t>(sse) -
+                                   se * se / (w * h));
+}
+
+typedef tuple<int, int, int, vp9_variance_fn_t, vp9_subpixvariance_fn_t,
+              vp9_subp_avg_variance_fn_t> HighVarianceParam;
+
+// The variance, sub pixel variance and sub pixel average variance of a block
+// size at one bit depth.
+class HighVarianceTest : public ::testing::TestWithParam<HighVarianceParam> {
+ public:
+  virtual void SetUp() {
+    const HighVarianceParam &params = GetParam();
+    log2width_ = get<0>(params);
+    width_ = 1 << log2width_;
+    log2height_ = get<1>(params);
+    height_ = 1 << log2height_;
+    bit_depth_ = get<2>(params);
+    mask_ = (1 << bit_depth_) - 1;
+    variance_ = get<3>(params);
+    subpel_variance_ = get<4>(params);
+    subpel_avg_variance_ = get<5>(params);
+
+    rnd_.Reset(ACMRandom::DeterministicSeed());
+    block_size_ = width_ * height_;
+    ref_size_ = (width_ + 1) * (height_ + 1);
+    src_ = reinterpret_cast<uint16_t *>(
+        vpx_memalign(16, block_size_ * sizeof(*src_)));
+    sec_ = reinterpret_cast<uint16_t *>(
+        vpx_memalign(16, block_size_ * sizeof(*sec_)));
+    ref_ = new uint16_t[ref_size_];
+    ASSERT_TRUE(src_ != NULL);
+    ASSERT_TRUE(sec_ != NULL);
+    ASSERT_TRUE(ref_ != NULL);
+  }
+
+  virtual void TearDown() {
+    vpx_free(src_);
+    vpx_free(sec_);
+    delete[] ref_;
+    libvpx_test::ClearSystemState();
+  }
+
+ protected:
+  void FillRandom() {
+    for (int j = 0; j < block_size_; j++) {
+      src_[j] = rnd_.Rand16() & mask_;
+      sec_[j] = rnd_.Rand16() & mask_;
+    }
+    for (int j = 0; j < ref_size_; j++)
+      ref_[j] = rnd_.Rand16() & mask_;
+  }
+
+  ACMRandom rnd_;
+  uint16_t *src_;
+  uint16_t *ref_;
+  uint16_t *sec_;
+  int width_, log2width_;
+  int height_, log2height_;
+  int bit_depth_, mask_;
+  int block_size_, ref_size_;
+  vp9_variance_fn_t variance_;
+  vp9_subpixvariance_fn_t subpel_variance_;
+  vp9_subp_avg_variance_fn_t subpel_avg_variance_;
+};
+
+TEST_P(HighVarianceTest, Ref) {
+  for (int i = 0; i < 10; ++i) {
+    FillRandom();
+    unsigned int sse1, sse2;
+    unsigned int var1;
+    ASM_REGISTER_STATE_CHECK(
+        var1 = variance_(CONVERT_TO_BYTEPTR(ref_), width_ + 1,
+                         CONVERT_TO_BYTEPTR(src_), width_, &sse1));
+    const unsigned int var2 = high_variance_ref(ref_, src_, NULL, log2width_,
+                                                log2height_, 0, 0, bit_depth_,
+                                                &sse2);
+    EXPECT_EQ(sse1, sse2);
+    EXPECT_EQ(var1, var2);
+  }
+}
+
+TEST_P(HighVarianceTest, Max) {
+  // The largest sums of squares, half of the differences at either end.
+  for (int j = 0; j < block_size_; j++)
+    src_[j] = (j & 1) ? mask_ : 0;
+  for (int j = 0; j < ref_size_; j++)
+    ref_[j] = mask_ - src_[(j % (width_ + 1)) & 1];
+  unsigned int sse1, sse2;
+  unsigned int var1;
+  ASM_REGISTER_STATE_CHECK(
+      var1 = variance_(CONVERT_TO_BYTEPTR(ref_), width_ + 1,
+                       CONVERT_TO_BYTEPTR(src_), width_, &sse1));
+  const unsigned int var2 = high_variance_ref(ref_, src_, NULL, log2width_,
+                                              log2height_, 0, 0, bit_depth_,
+                                              &sse2);
+  EXPECT_EQ(sse1, sse2);
+  EXPECT_EQ(var1, var2);
+}
+
+TEST_P(HighVarianceTest, SubpelRef) {
+  for (int x = 0; x < 16; ++x) {
+    for (int y = 0; y < 16; ++y) {
+      FillRandom();
+      unsigned int sse1, sse2;
+      unsigned int var1;
+      ASM_REGISTER_STATE_CHECK(
+          var1 = subpel_variance_(CONVERT_TO_BYTEPTR(ref_), width_ + 1, x, y,
+                                  CONVERT_TO_BYTEPTR(src_), width_, &sse1));
+      const unsigned int var2 = high_variance_ref(ref_, src_, NULL, log2width_,
+                                                  log2height_, x, y,
+                                                  bit_depth_, &sse2);
+      EXPECT_EQ(sse1, sse2) << "at position " << x << ", " << y;
+      EXPECT_EQ(var1, var2) << "at position " << x << ", " << y;
+    }
+  }
+}
+
+TEST_P(HighVarianceTest, SubpelAvgRef) {
+  for (int x = 0; x < 16; ++x) {
+    for (int y = 0; y < 16; ++y) {
+      FillRandom();
+      unsigned int sse1, sse2;
+      unsigned int var1;
+      ASM_REGISTER_STATE_CHECK(
+          var1 = subpel_avg_variance_(CONVERT_TO_BYTEPTR(ref_), width_ + 1,
+                                      x, y, CONVERT_TO_BYTEPTR(src_), width_,
+                                      &sse1, CONVERT_TO_BYTEPTR(sec_)));
+      const unsigned int var2 = high_variance_ref(ref_, src_, sec_, log2width_,
+                                                  log2height_, x, y,
+                                                  bit_depth_, &sse2);
+      EXPECT_EQ(sse1, sse2) << "at position " << x << ", " << y;
+      EXPECT_EQ(var1, var2) << "at position " << x << ", " << y;
+    }
+  }
+}
+#endif  // CONFIG_VP9_HIGHBITDEPTH
 #endif  // CONFIG_VP9_ENCODER
 
 // -----------------------------------------------------------------------------
@@ -932,6 +1105,330 @@ INSTANTIATE_TEST_CASE_P(
                       make_tuple(4, 4, subpel_variance16x16_neon),
                       make_tuple(5, 5, subpel_variance32x32_neon)));
 #endif  // HAVE_NEON
+
+#if CONFIG_VP9_HIGHBITDEPTH
+INSTANTIATE_TEST_CASE_P(
+    C, HighVarianceTest,
+    ::testing::Values(
+        make_tuple(2, 2, 8, vp9_high_variance4x4_c,
+                   vp9_high_sub_pixel_variance4x4_c,
+                   vp9_high_sub_pixel_avg_variance4x4_c),
+        make_tuple(2, 3, 8, vp9_high_variance4x8_c,
+                   vp9_high_sub_pixel_variance4x8_c,
+                   vp9_high_sub_pixel_avg_variance4x8_c),
+        make_tuple(3, 2, 8, vp9_high_variance8x4_c,
+                   vp9_high_sub_pixel_variance8x4_c,
+                   vp9_high_sub_pixel_avg_variance8x4_c),
+        make_tuple(3, 3, 8, vp9_high_variance8x8_c,
+                   vp9_high_sub_pixel_variance8x8_c,
+                   vp9_high_sub_pixel_avg_variance8x8_c),
+        make_tuple(3, 4, 8, vp9_high_variance8x16_c,
+                   vp9_high_sub_pixel_variance8x16_c,
+                   vp9_high_sub_pixel_avg_variance8x16_c),
+        make_tuple(4, 3, 8, vp9_high_variance16x8_c,
+                   vp9_high_sub_pixel_variance16x8_c,
+                   vp9_high_sub_pixel_avg_variance16x8_c),
+        make_tuple(4, 4, 8, vp9_high_variance16x16_c,
+                   vp9_high_sub_pixel_variance16x16_c,
+                   vp9_high_sub_pixel_avg_variance16x16_c),
+        make_tuple(4, 5, 8, vp9_high_variance16x32_c,
+                   vp9_high_sub_pixel_variance16x32_c,
+                   vp9_high_sub_pixel_avg_variance16x32_c),
+        make_tuple(5, 4, 8, vp9_high_variance32x16_c,
+                   vp9_high_sub_pixel_variance32x16_c,
+                   vp9_high_sub_pixel_avg_variance32x16_c),
+        make_tuple(5, 5, 8, vp9_high_variance32x32_c,
+                   vp9_high_sub_pixel_variance32x32_c,
+                   vp9_high_sub_pixel_avg_variance32x32_c),
+        make_tuple(5, 6, 8, vp9_high_variance32x64_c,
+                   vp9_high_sub_pixel_variance32x64_c,
+                   vp9_high_sub_pixel_avg_variance32x64_c),
+        make_tuple(6, 5, 8, vp9_high_variance64x32_c,
+                   vp9_high_sub_pixel_variance64x32_c,
+                   vp9_high_sub_pixel_avg_variance64x32_c),
+        make_tuple(6, 6, 8, vp9_high_variance64x64_c,
+                   vp9_high_sub_pixel_variance64x64_c,
+                   vp9_high_sub_pixel_avg_variance64x64_c),
+        make_tuple(2, 2, 10, vp9_high_10_variance4x4_c,
+                   vp9_high_10_sub_pixel_variance4x4_c,
+                   vp9_high_10_sub_pixel_avg_variance4x4_c),
+        make_tuple(2, 3, 10, vp9_high_10_variance4x8_c,
+                   vp9_high_10_sub_pixel_variance4x8_c,
+                   vp9_high_10_sub_pixel_avg_variance4x8_c),
+        make_tuple(3, 2, 10, vp9_high_10_variance8x4_c,
+                   vp9_high_10_sub_pixel_variance8x4_c,
+                   vp9_high_10_sub_pixel_avg_variance8x4_c),
+        make_tuple(3, 3, 10, vp9_high_10_variance8x8_c,
+                   vp9_high_10_sub_pixel_variance8x8_c,
+                   vp9_high_10_sub_pixel_avg_variance8x8_c),
+        make_tuple(3, 4, 10, vp9_high_10_variance8x16_c,
+                   vp9_high_10_sub_pixel_variance8x16_c,
+                   vp9_high_10_sub_pixel_avg_variance8x16_c),
+        make_tuple(4, 3, 10, vp9_high_10_variance16x8_c,
+                   vp9_high_10_sub_pixel_variance16x8_c,
+                   vp9_high_10_sub_pixel_avg_variance16x8_c),
+        make_tuple(4, 4, 10, vp9_high_10_variance16x16_c,
+                   vp9_high_10_sub_pixel_variance16x16_c,
+                   vp9_high_10_sub_pixel_avg_variance16x16_c),
+        make_tuple(4, 5, 10, vp9_high_10_variance16x32_c,
+                   vp9_high_10_sub_pixel_variance16x32_c,
+                   vp9_high_10_sub_pixel_avg_variance16x32_c),
+        make_tuple(5, 4, 10, vp9_high_10_variance32x16_c,
+                   vp9_high_10_sub_pixel_variance32x16_c,
+                   vp9_high_10_sub_pixel_avg_variance32x16_c),
+        make_tuple(5, 5, 10, vp9_high_10_variance32x32_c,
+                   vp9_high_10_sub_pixel_variance32x32_c,
+                   vp9_high_10_sub_pixel_avg_variance32x32_c),
+        make_tuple(5, 6, 10, vp9_high_10_variance32x64_c,
+                   vp9_high_10_sub_pixel_variance32x64_c,
+                   vp9_high_10_sub_pixel_avg_variance32x64_c),
+        make_tuple(6, 5, 10, vp9_high_10_variance64x32_c,
+                   vp9_high_10_sub_pixel_variance64x32_c,
+                   vp9_high_10_sub_pixel_avg_variance64x32_c),
+        make_tuple(6, 6, 10, vp9_high_10_variance64x64_c,
+                   vp9_high_10_sub_pixel_variance64x64_c,
+                   vp9_high_10_sub_pixel_avg_variance64x64_c),
+        make_tuple(2, 2, 12, vp9_high_12_variance4x4_c,
+                   vp9_high_12_sub_pixel_variance4x4_c,
+                   vp9_high_12_sub_pixel_avg_variance4x4_c),
+        make_tuple(2, 3, 12, vp9_high_12_variance4x8_c,
+                   vp9_high_12_sub_pixel_variance4x8_c,
+                   vp9_high_12_sub_pixel_avg_variance4x8_c),
+        make_tuple(3, 2, 12, vp9_high_12_variance8x4_c,
+                   vp9_high_12_sub_pixel_variance8x4_c,
+                   vp9_high_12_sub_pixel_avg_variance8x4_c),
+        make_tuple(3, 3, 12, vp9_high_12_variance8x8_c,
+                   vp9_high_12_sub_pixel_variance8x8_c,
+                   vp9_high_12_sub_pixel_avg_variance8x8_c),
+        make_tuple(3, 4, 12, vp9_high_12_variance8x16_c,
+                   vp9_high_12_sub_pixel_variance8x16_c,
+                   vp9_high_12_sub_pixel_avg_variance8x16_c),
+        make_tuple(4, 3, 12, vp9_high_12_variance16x8_c,
+                   vp9_high_12_sub_pixel_variance16x8_c,
+                   vp9_high_12_sub_pixel_avg_variance16x8_c),
+        make_tuple(4, 4, 12, vp9_high_12_variance16x16_c,
+                   vp9_high_12_sub_pixel_variance16x16_c,
+                   vp9_high_12_sub_pixel_avg_variance16x16_c),
+        make_tuple(4, 5, 12, vp9_high_12_variance16x32_c,
+                   vp9_high_12_sub_pixel_variance16x32_c,
+                   vp9_high_12_sub_pixel_avg_variance16x32_c),
+        make_tuple(5, 4, 12, vp9_high_12_variance32x16_c,
+                   vp9_high_12_sub_pixel_variance32x16_c,
+                   vp9_high_12_sub_pixel_avg_variance32x16_c),
+        make_tuple(5, 5, 12, vp9_high_12_variance32x32_c,
+                   vp9_high_12_sub_pixel_variance32x32_c,
+                   vp9_high_12_sub_pixel_avg_variance32x32_c),
+        make_tuple(5, 6, 12, vp9_high_12_variance32x64_c,
+                   vp9_high_12_sub_pixel_variance32x64_c,
+                   vp9_high_12_sub_pixel_avg_variance32x64_c),
+        make_tuple(6, 5, 12, vp9_high_12_variance64x32_c,
+                   vp9_high_12_sub_pixel_variance64x32_c,
+                   vp9_high_12_sub_pixel_avg_variance64x32_c),
+        make_tuple(6, 6, 12, vp9_high_12_variance64x64_c,
+                   vp9_high_12_sub_pixel_variance64x64_c,
+                   vp9_high_12_sub_pixel_avg_variance64x64_c)));
+
+#if HAVE_SSE2
+INSTANTIATE_TEST_CASE_P(
+    SSE2, HighVarianceTest,
+    ::testing::Values(
+        make_tuple(2, 2, 8, vp9_high_variance4x4_sse2,
+                   vp9_high_sub_pixel_variance4x4_sse2,
+                   vp9_high_sub_pixel_avg_variance4x4_sse2),
+        make_tuple(2, 3, 8, vp9_high_variance4x8_sse2,
+                   vp9_high_sub_pixel_variance4x8_sse2,
+                   vp9_high_sub_pixel_avg_variance4x8_sse2),
+        make_tuple(3, 2, 8, vp9_high_variance8x4_sse2,
+                   vp9_high_sub_pixel_variance8x4_sse2,
+                   vp9_high_sub_pixel_avg_variance8x4_sse2),
+        make_tuple(3, 3, 8, vp9_high_variance8x8_sse2,
+                   vp9_high_sub_pixel_variance8x8_sse2,
+                   vp9_high_sub_pixel_avg_variance8x8_sse2),
+        make_tuple(3, 4, 8, vp9_high_variance8x16_sse2,
+                   vp9_high_sub_pixel_variance8x16_sse2,
+                   vp9_high_sub_pixel_avg_variance8x16_sse2),
+        make_tuple(4, 3, 8, vp9_high_variance16x8_sse2,
+                   vp9_high_sub_pixel_variance16x8_sse2,
+                   vp9_high_sub_pixel_avg_variance16x8_sse2),
+        make_tuple(4, 4, 8, vp9_high_variance16x16_sse2,
+                   vp9_high_sub_pixel_variance16x16_sse2,
+                   vp9_high_sub_pixel_avg_variance16x16_sse2),
+        make_tuple(4, 5, 8, vp9_high_variance16x32_sse2,
+                   vp9_high_sub_pixel_variance16x32_sse2,
+                   vp9_high_sub_pixel_avg_variance16x32_sse2),
+        make_tuple(5, 4, 8, vp9_high_variance32x16_sse2,
+                   vp9_high_sub_pixel_variance32x16_sse2,
+                   vp9_high_sub_pixel_avg_variance32x16_sse2),
+        make_tuple(5, 5, 8, vp9_high_variance32x32_sse2,
+                   vp9_high_sub_pixel_variance32x32_sse2,
+                   vp9_high_sub_pixel_avg_variance32x32_sse2),
+        make_tuple(5, 6, 8, vp9_high_variance32x64_sse2,
+                   vp9_high_sub_pixel_variance32x64_sse2,
+                   vp9_high_sub_pixel_avg_variance32x64_sse2),
+        make_tuple(6, 5, 8, vp9_high_variance64x32_sse2,
+                   vp9_high_sub_pixel_variance64x32_sse2,
+                   vp9_high_sub_pixel_avg_variance64x32_sse2),
+        make_tuple(6, 6, 8, vp9_high_variance64x64_sse2,
+                   vp9_high_sub_pixel_variance64x64_sse2,
+                   vp9_high_sub_pixel_avg_variance64x64_sse2),
+        make_tuple(2, 2, 10, vp9_high_10_variance4x4_sse2,
+                   vp9_high_10_sub_pixel_variance4x4_sse2,
+                   vp9_high_10_sub_pixel_avg_variance4x4_sse2),
+        make_tuple(2, 3, 10, vp9_high_10_variance4x8_sse2,
+                   vp9_high_10_sub_pixel_variance4x8_sse2,
+                   vp9_high_10_sub_pixel_avg_variance4x8_sse2),
+        make_tuple(3, 2, 10, vp9_high_10_variance8x4_sse2,
+                   vp9_high_10_sub_pixel_variance8x4_sse2,
+                   vp9_high_10_sub_pixel_avg_variance8x4_sse2),
+        make_tuple(3, 3, 10, vp9_high_10_variance8x8_sse2,
+                   vp9_high_10_sub_pixel_variance8x8_sse2,
+                   vp9_high_10_sub_pixel_avg_variance8x8_sse2),
+        make_tuple(3, 4, 10, vp9_high_10_variance8x16_sse2,
+                   vp9_high_10_sub_pixel_variance8x16_sse2,
+                   vp9_high_10_sub_pixel_avg_variance8x16_sse2),
+        make_tuple(4, 3, 10, vp9_high_10_variance16x8_sse2,
+                   vp9_high_10_sub_pixel_variance16x8_sse2,
+                   vp9_high_10_sub_pixel_avg_variance16x8_sse2),
+        make_tuple(4, 4, 10, vp9_high_10_variance16x16_sse2,
+                   vp9_high_10_sub_pixel_variance16x16_sse2,
+                   vp9_high_10_sub_pixel_avg_variance16x16_sse2),
+        make_tuple(4, 5, 10, vp9_high_10_variance16x32_sse2,
+                   vp9_high_10_sub_pixel_variance16x32_sse2,
+                   vp9_high_10_sub_pixel_avg_variance16x32_sse2),
+        make_tuple(5, 4, 10, vp9_high_10_variance32x16_sse2,
+                   vp9_high_10_sub_pixel_variance32x16_sse2,
+                   vp9_high_10_sub_pixel_avg_variance32x16_sse2),
+        make_tuple(5, 5, 10, vp9_high_10_variance32x32_sse2,
+                   vp9_high_10_sub_pixel_variance32x32_sse2,
+                   vp9_high_10_sub_pixel_avg_variance32x32_sse2),
+        make_tuple(5, 6, 10, vp9_high_10_variance32x64_sse2,
+                   vp9_high_10_sub_pixel_variance32x64_sse2,
+                   vp9_high_10_sub_pixel_avg_variance32x64_sse2),
+        make_tuple(6, 5, 10, vp9_high_10_variance64x32_sse2,
+                   vp9_high_10_sub_pixel_variance64x32_sse2,
+                   vp9_high_10_sub_pixel_avg_variance64x32_sse2),
+        make_tuple(6, 6, 10, vp9_high_10_variance64x64_sse2,
+                   vp9_high_10_sub_pixel_variance64x64_sse2,
+                   vp9_high_10_sub_pixel_avg_variance64x64_sse2),
+        make_tuple(2, 2, 12, vp9_high_12_variance4x4_sse2,
+                   vp9_high_12_sub_pixel_variance4x4_sse2,
+                   vp9_high_12_sub_pixel_avg_variance4x4_sse2),
+        make_tuple(2, 3, 12, vp9_high_12_variance4x8_sse2,
+                   vp9_high_12_sub_pixel_variance4x8_sse2,
+                   vp9_high_12_sub_pixel_avg_variance4x8_sse2),
+        make_tuple(3, 2, 12, vp9_high_12_variance8x4_sse2,
+                   vp9_high_12_sub_pixel_variance8x4_sse2,
+                   vp9_high_12_sub_pixel_avg_variance8x4_sse2),
+        make_tuple(3, 3, 12, vp9_high_12_variance8x8_sse2,
+                   vp9_high_12_sub_pixel_variance8x8_sse2,
+                   vp9_high_12_sub_pixel_avg_variance8x8_sse2),
+        make_tuple(3, 4, 12, vp9_high_12_variance8x16_sse2,
+                   vp9_high_12_sub_pixel_variance8x16_sse2,
+                   vp9_high_12_sub_pixel_avg_variance8x16_sse2),
+        make_tuple(4, 3, 12, vp9_high_12_variance16x8_sse2,
+                   vp9_high_12_sub_pixel_variance16x8_sse2,
+                   vp9_high_12_sub_pixel_avg_variance16x8_sse2),
+        make_tuple(4, 4, 12, vp9_high_12_variance16x16_sse2,
+                   vp9_high_12_sub_pixel_variance16x16_sse2,
+                   vp9_high_12_sub_pixel_avg_variance16x16_sse2),
+        make_tuple(4, 5, 12, vp9_high_12_variance16x32_sse2,
+                   vp9_high_12_sub_pixel_variance16x32_sse2,
+                   vp9_high_12_sub_pixel_avg_variance16x32_sse2),
+        make_tuple(5, 4, 12, vp9_high_12_variance32x16_sse2,
+                   vp9_high_12_sub_pixel_variance32x16_sse2,
+                   vp9_high_12_sub_pixel_avg_variance32x16_sse2),
+        make_tuple(5, 5, 12, vp9_high_12_variance32x32_sse2,
+                   vp9_high_12_sub_pixel_variance32x32_sse2,
+                   vp9_high_12_sub_pixel_avg_variance32x32_sse2),
+        make_tuple(5, 6, 12, vp9_high_12_variance32x64_sse2,
+                   vp9_high_12_sub_pixel_variance32x64_sse2,
+                   vp9_high_12_sub_pixel_avg_variance32x64_sse2),
+        make_tuple(6, 5, 12, vp9_high_12_variance64x32_sse2,
+                   vp9_high_12_sub_pixel_variance64x32_sse2,
+                   vp9_high_12_sub_pixel_avg_variance64x32_sse2),
+        make_tuple(6, 6, 12, vp9_high_12_variance64x64_sse2,
+                   vp9_high_12_sub_pixel_variance64x64_sse2,
+                   vp9_high_12_sub_pixel_avg_variance64x64_sse2)));
+#endif  // HAVE_SSE2
+
+#if HAVE_AVX2
+INSTANTIATE_TEST_CASE_P(
+    AVX2, HighVarianceTest,
+    ::testing::Values(
+        make_tuple(4, 3, 8, vp9_high_variance16x8_avx2,
+                   vp9_high_sub_pixel_variance16x8_avx2,
+                   vp9_high_sub_pixel_avg_variance16x8_avx2),
+        make_tuple(4, 4, 8, vp9_high_variance16x16_avx2,
+                   vp9_high_sub_pixel_variance16x16_avx2,
+                   vp9_high_sub_pixel_avg_variance16x16_avx2),
+        make_tuple(4, 5, 8, vp9_high_variance16x32_avx2,
+                   vp9_high_sub_pixel_variance16x32_avx2,
+                   vp9_high_sub_pixel_avg_variance16x32_avx2),
+        make_tuple(5, 4, 8, vp9_high_variance32x16_avx2,
+                   vp9_high_sub_pixel_variance32x16_avx2,
+                   vp9_high_sub_pixel_avg_variance32x16_avx2),
+        make_tuple(5, 5, 8, vp9_high_variance32x32_avx2,
+                   vp9_high_sub_pixel_variance32x32_avx2,
+                   vp9_high_sub_pixel_avg_variance32x32_avx2),
+        make_tuple(5, 6, 8, vp9_high_variance32x64_avx2,
+                   vp9_high_sub_pixel_variance32x64_avx2,
+                   vp9_high_sub_pixel_avg_variance32x64_avx2),
+        make_tuple(6, 5, 8, vp9_high_variance64x32_avx2,
+                   vp9_high_sub_pixel_variance64x32_avx2,
+                   vp9_high_sub_pixel_avg_variance64x32_avx2),
+        make_tuple(6, 6, 8, vp9_high_variance64x64_avx2,
+                   vp9_high_sub_pixel_variance64x64_avx2,
+                   vp9_high_sub_pixel_avg_variance64x64_avx2),
+        make_tuple(4, 3, 10, vp9_high_10_variance16x8_avx2,
+                   vp9_high_10_sub_pixel_variance16x8_avx2,
+                   vp9_high_10_sub_pixel_avg_variance16x8_avx2),
+        make_tuple(4, 4, 10, vp9_high_10_variance16x16_avx2,
+                   vp9_high_10_sub_pixel_variance16x16_avx2,
+                   vp9_high_10_sub_pixel_avg_variance16x16_avx2),
+        make_tuple(4, 5, 10, vp9_high_10_variance16x32_avx2,
+                   vp9_high_10_sub_pixel_variance16x32_avx2,
+                   vp9_high_10_sub_pixel_avg_variance16x32_avx2),
+        make_tuple(5, 4, 10, vp9_high_10_variance32x16_avx2,
+                   vp9_high_10_sub_pixel_variance32x16_avx2,
+                   vp9_high_10_sub_pixel_avg_variance32x16_avx2),
+        make_tuple(5, 5, 10, vp9_high_10_variance32x32_avx2,
+                   vp9_high_10_sub_pixel_variance32x32_avx2,
+                   vp9_high_10_sub_pixel_avg_variance32x32_avx2),
+        make_tuple(5, 6, 10, vp9_high_10_variance32x64_avx2,
+                   vp9_high_10_sub_pixel_variance32x64_avx2,
+                   vp9_high_10_sub_pixel_avg_variance32x64_avx2),
+        make_tuple(6, 5, 10, vp9_high_10_variance64x32_avx2,
+                   vp9_high_10_sub_pixel_variance64x32_avx2,
+                   vp9_high_10_sub_pixel_avg_variance64x32_avx2),
+        make_tuple(6, 6, 10, vp9_high_10_variance64x64_avx2,
+                   vp9_high_10_sub_pixel_variance64x64_avx2,
+                   vp9_high_10_sub_pixel_avg_variance64x64_avx2),
+        make_tuple(4, 3, 12, vp9_high_12_variance16x8_avx2,
+                   vp9_high_12_sub_pixel_variance16x8_avx2,
+                   vp9_high_12_sub_pixel_avg_variance16x8_avx2),
+        make_tuple(4, 4, 12, vp9_high_12_variance16x16_avx2,
+                   vp9_high_12_sub_pixel_variance16x16_avx2,
+                   vp9_high_12_sub_pixel_avg_variance16x16_avx2),
+        make_tuple(4, 5, 12, vp9_high_12_variance16x32_avx2,
+                   vp9_high_12_sub_pixel_variance16x32_avx2,
+                   vp9_high_12_sub_pixel_avg_variance16x32_avx2),
+        make_tuple(5, 4, 12, vp9_high_12_variance32x16_avx2,
+                   vp9_high_12_sub_pixel_variance32x16_avx2,
+                   vp9_high_12_sub_pixel_avg_variance32x16_avx2),
+        make_tuple(5, 5, 12, vp9_high_12_variance32x32_avx2,
+                   vp9_high_12_sub_pixel_variance32x32_avx2,
+                   vp9_high_12_sub_pixel_avg_variance32x32_avx2),
+        make_tuple(5, 6, 12, vp9_high_12_variance32x64_avx2,
+                   vp9_high_12_sub_pixel_variance32x64_avx2,
+                   vp9_high_12_sub_pixel_avg_variance32x64_avx2),
+        make_tuple(6, 5, 12, vp9_high_12_variance64x32_avx2,
+                   vp9_high_12_sub_pixel_variance64x32_avx2,
+                   vp9_high_12_sub_pixel_avg_variance64x32_avx2),
+        make_tuple(6, 6, 12, vp9_high_12_variance64x64_avx2,
+                   vp9_high_12_sub_pixel_variance64x64_avx2,
+                   vp9_high_12_sub_pixel_avg_variance64x64_avx2)));
+#endif  // HAVE_AVX2
+#endif  // CONFIG_VP9_HIGHBITDEPTH
 #endif  // CONFIG_VP9_ENCODER
 
 }  // namespace vp9
@@ -13,8 +13,10 @@
 #if defined(_WIN32)
 #include <windows.h>
 #endif
+#include <climits>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <string>
 #include "test/acm_random.h"
 #include "vpx/vpx_encoder.h"
@@ -224,6 +226,44 @@ class RandomVideoSource : public DummyVideoSource {
   int seed_;
 };
 
+// A textured scene whose top half is still while its bottom half pans, so
+// that the frames have both static and moving areas. From the scene cut on,
+// a different texture is drawn.
+class SyntheticVideoSource : public DummyVideoSource {
+ public:
+  SyntheticVideoSource() : scene_cut_(UINT_MAX) {}
+
+  void set_scene_cut(unsigned int scene_cut) {
+    scene_cut_ = scene_cut;
+  }
+
+ protected:
+  virtual void FillFrame() {
+    if (!img_)
+      return;
+    const int scene = frame_ >= scene_cut_;
+    for (unsigned int r = 0; r < height_; ++r) {
+      const int moving = r >= height_ / 2;
+      const int y = r + moving * frame_;
+      uint8_t *const row = img_->planes[VPX_PLANE_Y] +
+                           r * img_->stride[VPX_PLANE_Y];
+      for (unsigned int c = 0; c < width_; ++c) {
+        const int x = c + 3 * moving * frame_;
+        row[c] = static_cast<uint8_t>(
+            scene ? (x >> 4) * 11 + (y >> 4) * 23 + ((x ^ y) & 15) :
+                    ((x >> 3) ^ (y >> 2)) * 29 + (x * y >> 5));
+      }
+    }
+    for (int plane = VPX_PLANE_U; plane <= VPX_PLANE_V; ++plane) {
+      for (unsigned int r = 0; r < (height_ + 1) / 2; ++r)
+        memset(img_->planes[plane] + r * img_->stride[plane],
+               scene ? 160 - 16 * plane : 96 + 16 * plane, (width_ + 1) / 2);
+    }
+  }
+
+  unsigned int scene_cut_;
+};
+
 // Abstract base class for test video sources, which provide a stream of
 // decompressed images to the decoder.
 class CompressedVideoSource {
@@ -0,0 +1,145 @@
+/*
+ *  Copyright (c) 2014 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include "third_party/googletest/src/include/gtest/gtest.h"
+#include "test/md5_helper.h"
+#include "./vpx_config.h"
+#include "vpx/vp8cx.h"
+#include "vpx/vp8dx.h"
+#include "vpx/vpx_decoder.h"
+#include "vpx/vpx_encoder.h"
+
+namespace {
+
+const int kFrames = 6;
+const int kWidth = 352;
+const int kHeight = 288;
+
+// Encodes the frames at a low bitrate, so that the post processing has
+// blocking to filter, with 4 token partitions so that the decoder can use its
+// threads.
+std::vector<std::string> EncodeFrames() {
+  vpx_codec_enc_cfg_t cfg;
+  vpx_codec_ctx_t enc;
+  vpx_image_t img;
+  std::vector<std::string> frames;
+
+  EXPECT_EQ(VPX_CODEC_OK,
+            vpx_codec_enc_config_default(&vpx_codec_vp8_cx_algo, &cfg, 0));
+  cfg.g_w = kWidth;
+  cfg.g_h = kHeight;
+  cfg.g_lag_in_frames = 0;
+  cfg.rc_target_bitrate = 100;
+  EXPECT_EQ(VPX_CODEC_OK,
+            vpx_codec_enc_init(&enc, &vpx_codec_vp8_cx_algo, &cfg, 0));
+  EXPECT_EQ(VPX_CODEC_OK,
+            vpx_codec_control(&enc, VP8E_SET_TOKEN_PARTITIONS,
+                              VP8_FOUR_TOKENPARTITION));
+  EXPECT_TRUE(vpx_img_alloc(&img, VPX_IMG_FMT_I420, kWidth, kHeight, 16) !=
+              NULL);
+
+  for (int frame = 0; frame < kFrames; ++frame) {
+    vpx_codec_iter_t iter = NULL;
+    const vpx_codec_cx_pkt_t *pkt;
+
+    for (unsigned int r = 0; r < img.d_h; ++r) {
+      for (unsigned int c = 0; c < img.d_w; ++c) {
+        const int x = c + 3 * frame;
+        img.planes[VPX_PLANE_Y][r * img.stride[VPX_PLANE_Y] + c] =
+            static_cast<uint8_t>(((x >> 3) ^ (r >> 2)) * 29 + (x * r >> 5));
+      }
+    }
+    for (int plane = VPX_PLANE_U; plane <= VPX_PLANE_V; ++plane) {
+      for (unsigned int r = 0; r < (img.d_h + 1) / 2; ++r)
+        memset(img.planes[plane] + r * img.stride[plane], 96 + 16 * plane,
+               (img.d_w + 1) / 2);
+    }
+    EXPECT_EQ(VPX_CODEC_OK, vpx_codec_encode(&enc, &img, frame, 1, 0,
+                                             VPX_DL_REALTIME));
+    while ((pkt = vpx_codec_get_cx_data(&enc, &iter)) != NULL) {
+      if (pkt->kind == VPX_CODEC_CX_FRAME_PKT)
+        frames.push_back(
+            std::string(static_cast<const char *>(pkt->data.frame.buf),
+                        pkt->data.frame.sz));
+    }
+  }
+
+  vpx_img_free(&img);
+  EXPECT_EQ(VPX_CODEC_OK, vpx_codec_destroy(&enc));
+  return frames;
+}
+
+// The post processing of the decoding threads has to give the same frames as
+// the one of a single thread. The noise is drawn from rand(), which is seeded
+// the same before each decode. The parameter is the post processing flags.
+class VP8PostProcMtTest : public ::testing::TestWithParam<int> {
+ protected:
+  std::vector<std::string> Decode(const std::vector<std::string> &frames,
+                                  int threads) {
+    vpx_codec_dec_cfg_t cfg = vpx_codec_dec_cfg_t();
+    vpx_codec_ctx_t dec;
+    vp8_postproc_cfg_t pp_cfg = { GetParam(), 16, 4 };
+    std::vector<std::string> md5s;
+
+    cfg.threads = threads;
+    EXPECT_EQ(VPX_CODEC_OK,
+              vpx_codec_dec_init(&dec, &vpx_codec_vp8_dx_algo, &cfg,
+                                 VPX_CODEC_USE_POSTPROC));
+    EXPECT_EQ(VPX_CODEC_OK, vpx_codec_control(&dec, VP8_SET_POSTPROC, &pp_cfg));
+    srand(1);
+
+    for (size_t i = 0; i < frames.size(); ++i) {
+      vpx_codec_iter_t iter = NULL;
+      vpx_image_t *img;
+
+      EXPECT_EQ(VPX_CODEC_OK,
+                vpx_codec_decode(&dec,
+                                 reinterpret_cast<const uint8_t *>(
+                                     frames[i].data()),
+                                 static_cast<unsigned int>(frames[i].size()),
+                                 NULL, 0));
+      while ((img = vpx_codec_get_frame(&dec, &iter)) != NULL) {
+        libvpx_test::MD5 md5;
+        md5.Add(img);
+        md5s.push_back(md5.Get());
+      }
+    }
+
+    EXPECT_EQ(VPX_CODEC_OK, vpx_codec_destroy(&dec));
+    return md5s;
+  }
+};
+
+TEST_P(VP8PostProcMtTest, MatchesSingleThread) {
+  const std::vector<std::string> frames = EncodeFrames();
+  const std::vector<std::string> reference = Decode(frames, 1);
+
+  ASSERT_EQ(static_cast<size_t>(kFrames), reference.size());
+  for (int threads = 2; threads <= 4; ++threads) {
+    const std::vector<std::string> md5s = Decode(frames, threads);
+
+    ASSERT_EQ(reference.size(), md5s.size());
+    for (size_t i = 0; i < reference.size(); ++i)
+      EXPECT_EQ(reference[i], md5s[i]) << threads << " threads, frame " << i;
+  }
+}
+
+INSTANTIATE_TEST_CASE_P(
+    VP8, VP8PostProcMtTest,
+    ::testing::Values(VP8_DEBLOCK | VP8_DEMACROBLOCK,
+                      VP8_DEBLOCK | VP8_DEMACROBLOCK | VP8_ADDNOISE,
+                      VP8_DEBLOCK | VP8_DEMACROBLOCK | VP8_ADDNOISE | VP8_MFQE));
+
+}  // namespace
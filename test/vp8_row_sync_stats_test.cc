@@ -0,0 +1,129 @@
+/*
+ *  Copyright (c) 2014 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include "third_party/googletest/src/include/gtest/gtest.h"
+#include "./vpx_config.h"
+#include "vpx/vp8cx.h"
+#include "vpx/vp8dx.h"
+#include "vpx/vpx_decoder.h"
+#include "vpx/vpx_encoder.h"
+
+namespace {
+
+const int kFramesPerSize = 4;
+
+// Encodes frames at 352x288 then 176x144, with 4 token partitions so that
+// the decoder can use its threads, and returns them.
+std::vector<std::string> EncodeFrames() {
+  const int sizes[2][2] = { { 352, 288 }, { 176, 144 } };
+  vpx_codec_enc_cfg_t cfg;
+  vpx_codec_ctx_t enc;
+  std::vector<std::string> frames;
+
+  EXPECT_EQ(VPX_CODEC_OK,
+            vpx_codec_enc_config_default(&vpx_codec_vp8_cx_algo, &cfg, 0));
+  cfg.g_w = sizes[0][0];
+  cfg.g_h = sizes[0][1];
+  cfg.g_lag_in_frames = 0;
+  EXPECT_EQ(VPX_CODEC_OK,
+            vpx_codec_enc_init(&enc, &vpx_codec_vp8_cx_algo, &cfg, 0));
+  EXPECT_EQ(VPX_CODEC_OK,
+            vpx_codec_control(&enc, VP8E_SET_TOKEN_PARTITIONS,
+                              VP8_FOUR_TOKENPARTITION));
+
+  for (int size = 0; size < 2; ++size) {
+    vpx_image_t img;
+
+    if (size > 0) {
+      cfg.g_w = sizes[size][0];
+      cfg.g_h = sizes[size][1];
+      EXPECT_EQ(VPX_CODEC_OK, vpx_codec_enc_config_set(&enc, &cfg));
+    }
+    EXPECT_TRUE(vpx_img_alloc(&img, VPX_IMG_FMT_I420, cfg.g_w, cfg.g_h, 16) !=
+                NULL);
+    for (int frame = 0; frame < kFramesPerSize; ++frame) {
+      const int pts = size * kFramesPerSize + frame;
+      vpx_codec_iter_t iter = NULL;
+      const vpx_codec_cx_pkt_t *pkt;
+
+      for (unsigned int r = 0; r < img.d_h; ++r) {
+        for (unsigned int c = 0; c < img.d_w; ++c) {
+          img.planes[VPX_PLANE_Y][r * img.stride[VPX_PLANE_Y] + c] =
+              static_cast<uint8_t>(((c + 2 * pts) ^ r) * 13);
+        }
+      }
+      for (int plane = VPX_PLANE_U; plane <= VPX_PLANE_V; ++plane) {
+        for (unsigned int r = 0; r < (img.d_h + 1) / 2; ++r)
+          memset(img.planes[plane] + r * img.stride[plane], 128,
+                 (img.d_w + 1) / 2);
+      }
+      EXPECT_EQ(VPX_CODEC_OK, vpx_codec_encode(&enc, &img, pts, 1, 0,
+                                               VPX_DL_REALTIME));
+      while ((pkt = vpx_codec_get_cx_data(&enc, &iter)) != NULL) {
+        if (pkt->kind == VPX_CODEC_CX_FRAME_PKT)
+          frames.push_back(
+              std::string(static_cast<const char *>(pkt->data.frame.buf),
+                          pkt->data.frame.sz));
+      }
+    }
+    vpx_img_free(&img);
+  }
+
+  EXPECT_EQ(VPX_CODEC_OK, vpx_codec_destroy(&enc));
+  return frames;
+}
+
+// The counts only ever grow while the decoder lives, including when the
+// frame size changes.
+TEST(VP8RowSyncStatsTest, KeptAcrossSizeChanges) {
+  const std::vector<std::string> frames = EncodeFrames();
+  vpx_codec_dec_cfg_t cfg = vpx_codec_dec_cfg_t();
+  vpx_codec_ctx_t dec;
+  vpx_row_sync_stats_t last;
+
+  ASSERT_EQ(static_cast<size_t>(2 * kFramesPerSize), frames.size());
+  cfg.threads = 4;
+  ASSERT_EQ(VPX_CODEC_OK,
+            vpx_codec_dec_init(&dec, &vpx_codec_vp8_dx_algo, &cfg, 0));
+  EXPECT_EQ(VPX_CODEC_INVALID_PARAM,
+            vpx_codec_control(&dec, VP8D_GET_ROW_SYNC_STATS,
+                              static_cast<vpx_row_sync_stats_t *>(NULL)));
+  memset(&last, 0, sizeof(last));
+
+  for (size_t i = 0; i < frames.size(); ++i) {
+    vpx_row_sync_stats_t stats;
+
+    ASSERT_EQ(VPX_CODEC_OK,
+              vpx_codec_decode(&dec,
+                               reinterpret_cast<const uint8_t *>(
+                                   frames[i].data()),
+                               static_cast<unsigned int>(frames[i].size()),
+                               NULL, 0));
+    ASSERT_EQ(VPX_CODEC_OK,
+              vpx_codec_control(&dec, VP8D_GET_ROW_SYNC_STATS, &stats));
+    EXPECT_GE(stats.stalls, last.stalls) << "frame " << i;
+    EXPECT_GE(stats.spins, last.spins) << "frame " << i;
+    EXPECT_GE(stats.waits, last.waits) << "frame " << i;
+    EXPECT_LE(stats.waits, stats.stalls) << "frame " << i;
+    // Both sizes are narrower than 640 pixels, the range is 0 when the
+    // decoder does not use threads, e.g. on a single core.
+    EXPECT_TRUE(stats.sync_range == 0 || stats.sync_range == 1)
+        << "frame " << i;
+    last = stats;
+  }
+
+  EXPECT_EQ(VPX_CODEC_OK, vpx_codec_destroy(&dec));
+}
+
+}  // namespace
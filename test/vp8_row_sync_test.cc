@@ -0,0 +1,107 @@
+/*
+ *  Copyright (c) 2014 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "third_party/googletest/src/include/gtest/gtest.h"
+#include "./vpx_config.h"
+#include "vp8/common/rowsync.h"
+
+namespace {
+
+#if CONFIG_MULTITHREAD
+const int kNumThreads = 4;
+const int kMbRows = 36;
+
+struct WavefrontData {
+  VP8_ROW_SYNC *row_sync;
+  int mb_cols;
+  int start;
+  // Per MB completion flags, written by the thread owning the row.
+  volatile int *done;
+  // Number of MBs started before their above-right MB was complete.
+  int violations;
+};
+
+THREAD_FUNCTION WavefrontProc(void *p_data) {
+  WavefrontData *const wd = reinterpret_cast<WavefrontData *>(p_data);
+  for (int r = wd->start; r < kMbRows; r += kNumThreads) {
+    for (int c = 0; c < wd->mb_cols; ++c) {
+      vp8_row_sync_write(wd->row_sync, r, c - 1);
+      vp8_row_sync_read(wd->row_sync, r, c);
+      if (r > 0) {
+        const int above_right = std::min(c + 1, wd->mb_cols - 1);
+        if (!wd->done[(r - 1) * wd->mb_cols + above_right])
+          ++wd->violations;
+      }
+      ++wd->done[r * wd->mb_cols + c];
+    }
+    vp8_row_sync_write_row(wd->row_sync, r, wd->mb_cols);
+  }
+  return 0;
+}
+
+class VP8RowSyncTest : public ::testing::TestWithParam<int> {
+ protected:
+  virtual void SetUp() {
+    memset(&row_sync_, 0, sizeof(row_sync_));
+  }
+
+  virtual void TearDown() {
+    vp8_row_sync_dealloc(&row_sync_);
+  }
+
+  VP8_ROW_SYNC row_sync_;
+};
+
+TEST_P(VP8RowSyncTest, Wavefront) {
+  const int sync_range = GetParam();
+  // Not a multiple of the sync range, so that the last read of a row waits
+  // for the whole row above.
+  const int mb_cols = 8 * sync_range + 3;
+  std::vector<int> done_flags(kMbRows * mb_cols);
+  pthread_t threads[kNumThreads];
+  WavefrontData data[kNumThreads];
+
+  ASSERT_EQ(0, vp8_row_sync_alloc(&row_sync_, kMbRows, sync_range));
+
+  for (int pass = 0; pass < 4; ++pass) {
+    std::fill(done_flags.begin(), done_flags.end(), 0);
+    vp8_row_sync_reset(&row_sync_);
+    for (int i = 0; i < kNumThreads; ++i) {
+      data[i].row_sync = &row_sync_;
+      data[i].mb_cols = mb_cols;
+      data[i].start = i;
+      data[i].done = &done_flags[0];
+      data[i].violations = 0;
+      ASSERT_EQ(0, pthread_create(&threads[i], 0, WavefrontProc, &data[i]));
+    }
+    for (int i = 0; i < kNumThreads; ++i) {
+      pthread_join(threads[i], 0);
+      EXPECT_EQ(0, data[i].violations);
+    }
+    for (int i = 0; i < kMbRows * mb_cols; ++i)
+      EXPECT_EQ(1, done_flags[i]);
+  }
+
+  VP8_ROW_SYNC_STATS stats;
+  vp8_row_sync_get_stats(&row_sync_, &stats);
+  EXPECT_LE(stats.waits, stats.stalls);
+}
+
+// The sync ranges picked by the encoder and the decoder.
+INSTANTIATE_TEST_CASE_P(Synchronization, VP8RowSyncTest,
+                        ::testing::Values(1, 4, 8, 16, 32));
+#endif  // CONFIG_MULTITHREAD
+
+}  // namespace
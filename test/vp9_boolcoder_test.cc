@@ -87,3 +87,38 @@ TEST(VP9, TestBitIO) {
     }
   }
 }
+
+TEST(VP9, TestBitIOSizeLimit) {
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  const int kBitsToTest = 1000;
+  const int kBufferSize = 200;
+  const uint8_t kGuard = 0xa5;
+  uint8_t bits[kBitsToTest];
+  uint8_t full[kBufferSize];
+  unsigned int full_size;
+
+  for (int i = 0; i < kBitsToTest; ++i)
+    bits[i] = rnd(2);
+
+  // Equiprobable bits take a byte per 8 bits.
+  vp9_writer bw;
+  vp9_start_encode_size(&bw, full, kBufferSize);
+  for (int i = 0; i < kBitsToTest; ++i)
+    vp9_write_bit(&bw, bits[i]);
+  vp9_stop_encode(&bw);
+  ASSERT_EQ(0, bw.error);
+  full_size = bw.pos;
+
+  // The same bits in a buffer one byte too small leave the bytes past it
+  // alone.
+  uint8_t small[kBufferSize + 1];
+  memset(small, kGuard, sizeof(small));
+  vp9_start_encode_size(&bw, small, full_size - 1);
+  for (int i = 0; i < kBitsToTest; ++i)
+    vp9_write_bit(&bw, bits[i]);
+  vp9_stop_encode(&bw);
+  EXPECT_EQ(1, bw.error);
+  EXPECT_EQ(full_size - 1, bw.pos);
+  for (unsigned int i = full_size - 1; i < sizeof(small); ++i)
+    EXPECT_EQ(kGuard, small[i]) << "byte " << i;
+}
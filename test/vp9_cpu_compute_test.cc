@@ -0,0 +1,90 @@
+/*
+ *  Copyright (c) 2014 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "third_party/googletest/src/include/gtest/gtest.h"
+#include "test/codec_factory.h"
+#include "test/encode_test_driver.h"
+#include "test/md5_helper.h"
+#include "test/util.h"
+#include "test/video_source.h"
+
+namespace {
+
+const int kFrames = 10;
+
+struct CpuComputeParam {
+  int width;
+  int height;
+  int log2_tile_cols;
+  // md5 of the frames coded with the data parallel pick mode run by the
+  // encoding threads, i.e. without a GPU compute backend.
+  const char *md5;
+};
+
+const CpuComputeParam kCpuComputeParams[] = {
+  { 352, 288, 0, "8c2d6d27e2bd7fdd3cfde957ee63a569" },
+  { 608, 200, 1, "9f5b92d494716fceb9191e97ec42add6" },
+};
+
+// The frames coded with the GPU block analysis have to be the same whether
+// the analysis is run by the encoding threads, or, with --enable-cpu-compute,
+// by the workers of the CPU backend of the GPU compute interface, whatever
+// the number of threads. Speed 5 is the real time speed whose partitioning
+// analyzes the GPU block sizes.
+class VP9CpuComputeTest
+    : public ::libvpx_test::EncoderTest,
+      public ::libvpx_test::CodecTestWith2Params<CpuComputeParam, int> {
+ protected:
+  VP9CpuComputeTest()
+      : EncoderTest(GET_PARAM(0)), param_(GET_PARAM(1)),
+        threads_(GET_PARAM(2)) {}
+  virtual ~VP9CpuComputeTest() {}
+
+  virtual void SetUp() {
+    InitializeConfig();
+    SetMode(::libvpx_test::kRealTime);
+    cfg_.g_threads = threads_;
+    cfg_.g_lag_in_frames = 0;
+    cfg_.rc_end_usage = VPX_CBR;
+    cfg_.rc_target_bitrate = 400;
+    cfg_.use_gpu = 1;
+  }
+
+  virtual void PreEncodeFrameHook(::libvpx_test::VideoSource *video,
+                                  ::libvpx_test::Encoder *encoder) {
+    if (video->frame() == 1) {
+      encoder->Control(VP8E_SET_CPUUSED, 5);
+      encoder->Control(VP9E_SET_TILE_COLUMNS, param_.log2_tile_cols);
+    }
+  }
+
+  virtual void DecompressedFrameHook(const vpx_image_t &img,
+                                     vpx_codec_pts_t /*pts*/) {
+    md5_.Add(&img);
+  }
+
+  const CpuComputeParam param_;
+  const int threads_;
+  ::libvpx_test::MD5 md5_;
+};
+
+TEST_P(VP9CpuComputeTest, MatchesDataParallelPickMode) {
+  ::libvpx_test::SyntheticVideoSource video;
+  video.SetSize(param_.width, param_.height);
+  video.set_limit(kFrames);
+  ASSERT_NO_FATAL_FAILURE(RunLoop(&video));
+  EXPECT_STREQ(param_.md5, md5_.Get());
+}
+
+VP9_INSTANTIATE_TEST_CASE(VP9CpuComputeTest,
+                          ::testing::ValuesIn(kCpuComputeParams),
+                          ::testing::Values(1, 2, 4));
+
+}  // namespace
@@ -0,0 +1,122 @@
+/*
+ *  Copyright (c) 2014 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string.h>
+
+#include "third_party/googletest/src/include/gtest/gtest.h"
+#include "test/acm_random.h"
+#include "test/clear_system_state.h"
+#include "test/register_state_check.h"
+#include "./vpx_config.h"
+#include "./vp9_rtcd.h"
+#include "vpx_ports/mem.h"
+#include "vp9/common/vp9_enums.h"
+
+typedef int (*DenoiserFilterFunc)(const uint8_t *sig, int sig_stride,
+                                  const uint8_t *mc_avg, int mc_avg_stride,
+                                  uint8_t *avg, int avg_stride,
+                                  int increase_denoising, BLOCK_SIZE bs,
+                                  int motion_magnitude);
+
+namespace {
+
+using libvpx_test::ACMRandom;
+
+const int kStride = 80;
+const int kSize = 64 * kStride;
+
+class VP9DenoiserTest
+    : public ::testing::TestWithParam<DenoiserFilterFunc> {
+ public:
+  virtual void TearDown() {
+    libvpx_test::ClearSystemState();
+  }
+
+ protected:
+  // Fill the signal, and the motion compensated average within 'max_diff'
+  // of it, with some pixels at the ends of the range so that the adjustments
+  // saturate.
+  void FillBlocks(ACMRandom *rnd, int max_diff) {
+    for (int i = 0; i < kSize; ++i) {
+      int sig = rnd->Rand8();
+      int mc_avg;
+      if (rnd->PseudoUniform(8) == 0)
+        sig = rnd->PseudoUniform(2) ? rnd->PseudoUniform(4)
+                                    : 255 - rnd->PseudoUniform(4);
+      mc_avg = sig + rnd->PseudoUniform(2 * max_diff + 1) - max_diff;
+      sig_[i] = static_cast<uint8_t>(sig);
+      mc_avg_[i] = static_cast<uint8_t>(
+          mc_avg < 0 ? 0 : mc_avg > 255 ? 255 : mc_avg);
+      avg_[i] = rnd->Rand8();
+    }
+  }
+
+  DECLARE_ALIGNED(16, uint8_t, sig_[kSize]);
+  DECLARE_ALIGNED(16, uint8_t, mc_avg_[kSize]);
+  DECLARE_ALIGNED(16, uint8_t, avg_[kSize]);
+};
+
+// The decision and the denoised block match the C version, whether the
+// strong filter is kept, dampened or given up.
+TEST_P(VP9DenoiserTest, MatchesC) {
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  DECLARE_ALIGNED_ARRAY(16, uint8_t, ref_avg, kSize);
+  int decisions[2] = { 0, 0 };
+
+  for (int n = 0; n < 2000; ++n) {
+    const BLOCK_SIZE bs = static_cast<BLOCK_SIZE>(n % BLOCK_SIZES);
+    const int increase_denoising = rnd(2);
+    const int motion_magnitude = rnd(50);
+    // Offset the blocks, the buffers of the encoder are not aligned.
+    const int offset = rnd(16);
+    int ref_decision, decision;
+
+    FillBlocks(&rnd, 1 + rnd(rnd(2) ? 8 : 32));
+    memcpy(ref_avg, avg_, sizeof(avg_));
+
+    ref_decision = vp9_denoiser_filter_c(sig_ + offset, kStride,
+                                         mc_avg_ + offset, kStride,
+                                         ref_avg + offset, kStride,
+                                         increase_denoising, bs,
+                                         motion_magnitude);
+    ASM_REGISTER_STATE_CHECK(decision = GetParam()(sig_ + offset, kStride,
+                                                   mc_avg_ + offset, kStride,
+                                                   avg_ + offset, kStride,
+                                                   increase_denoising, bs,
+                                                   motion_magnitude));
+
+    ASSERT_EQ(ref_decision, decision) << "block size " << bs;
+    ++decisions[ref_decision != 0];
+    for (int i = 0; i < kSize; ++i) {
+      ASSERT_EQ(ref_avg[i], avg_[i])
+          << "block size " << bs << ", increase " << increase_denoising
+          << ", motion " << motion_magnitude << ", at " << i;
+    }
+  }
+
+  // Both decisions have to be covered.
+  EXPECT_GT(decisions[0], 0);
+  EXPECT_GT(decisions[1], 0);
+}
+
+INSTANTIATE_TEST_CASE_P(C, VP9DenoiserTest,
+                        ::testing::Values(vp9_denoiser_filter_c));
+
+#if HAVE_SSE2
+INSTANTIATE_TEST_CASE_P(SSE2, VP9DenoiserTest,
+                        ::testing::Values(vp9_denoiser_filter_sse2));
+#endif
+
+#if HAVE_AVX2
+INSTANTIATE_TEST_CASE_P(AVX2, VP9DenoiserTest,
+                        ::testing::Values(vp9_denoiser_filter_avx2));
+#endif
+
+}  // namespace
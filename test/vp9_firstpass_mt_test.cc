@@ -0,0 +1,87 @@
+/*
+ *  Copyright (c) 2014 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string>
+
+#include "third_party/googletest/src/include/gtest/gtest.h"
+#include "test/codec_factory.h"
+#include "test/encode_test_driver.h"
+#include "test/util.h"
+#include "test/video_source.h"
+
+namespace {
+
+const int kFrames = 8;
+
+// The first pass statistics have to be the same whatever the number of
+// threads the MB rows are analyzed with. The parameter is the aq mode.
+class VP9FirstPassMtTest : public ::libvpx_test::EncoderTest,
+                           public ::libvpx_test::CodecTestWithParam<int> {
+ protected:
+  VP9FirstPassMtTest() : EncoderTest(GET_PARAM(0)), aq_mode_(GET_PARAM(1)) {}
+  virtual ~VP9FirstPassMtTest() {}
+
+  virtual void SetUp() {
+    InitializeConfig();
+    SetMode(::libvpx_test::kTwoPassGood);
+  }
+
+  virtual void PreEncodeFrameHook(::libvpx_test::VideoSource *video,
+                                  ::libvpx_test::Encoder *encoder) {
+    if (video->frame() == 0)
+      encoder->Control(VP9E_SET_AQ_MODE, aq_mode_);
+  }
+
+  // Only the first pass is run.
+  virtual void EndPassHook() {
+    const vpx_fixed_buf_t buf = stats_.buf();
+    first_pass_stats_.assign(static_cast<const char *>(buf.buf), buf.sz);
+    abort_ = true;
+  }
+
+  virtual bool DoDecode() const { return false; }
+
+  std::string FirstPass(unsigned int width, unsigned int height,
+                        unsigned int threads) {
+    ::libvpx_test::SyntheticVideoSource video;
+    video.SetSize(width, height);
+    video.set_limit(kFrames);
+    cfg_.g_threads = threads;
+    abort_ = false;
+    first_pass_stats_.clear();
+    RunLoop(&video);
+    return first_pass_stats_;
+  }
+
+  void CheckThreads(unsigned int width, unsigned int height) {
+    const std::string reference = FirstPass(width, height, 1);
+
+    ASSERT_FALSE(reference.empty());
+    for (unsigned int threads = 2; threads <= 4; ++threads)
+      EXPECT_TRUE(reference == FirstPass(width, height, threads))
+          << width << "x" << height << ", " << threads << " threads";
+  }
+
+  const int aq_mode_;
+  std::string first_pass_stats_;
+};
+
+TEST_P(VP9FirstPassMtTest, BitExact) {
+  CheckThreads(352, 288);
+}
+
+TEST_P(VP9FirstPassMtTest, BitExactOddSize) {
+  CheckThreads(330, 250);
+}
+
+// Without and with variance adaptive quantization.
+VP9_INSTANTIATE_TEST_CASE(VP9FirstPassMtTest, ::testing::Values(0, 1));
+
+}  // namespace
@@ -0,0 +1,156 @@
+/*
+ *  Copyright (c) 2014 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string.h>
+#include <vector>
+
+#include "third_party/googletest/src/include/gtest/gtest.h"
+#include "test/codec_factory.h"
+#include "test/encode_test_driver.h"
+#include "test/util.h"
+#include "test/video_source.h"
+
+namespace {
+
+const int kFrames = 6;
+
+class VP9FrameStatsTest
+    : public ::libvpx_test::EncoderTest,
+      public ::libvpx_test::CodecTestWith2Params<libvpx_test::TestMode, int> {
+ protected:
+  VP9FrameStatsTest()
+      : EncoderTest(GET_PARAM(0)), encoding_mode_(GET_PARAM(1)),
+        set_cpu_used_(GET_PARAM(2)), enable_stats_(true),
+        frame_coded_(false) {}
+  virtual ~VP9FrameStatsTest() {}
+
+  virtual void SetUp() {
+    InitializeConfig();
+    SetMode(encoding_mode_);
+    cfg_.g_lag_in_frames = 0;
+  }
+
+  virtual void PreEncodeFrameHook(::libvpx_test::VideoSource *video,
+                                  ::libvpx_test::Encoder *encoder) {
+    if (video->frame() == 0) {
+      encoder->Control(VP8E_SET_CPUUSED, set_cpu_used_);
+      if (enable_stats_)
+        encoder->Control(VP9E_SET_FRAME_STATS, 1);
+    }
+  }
+
+  virtual void FramePktHook(const vpx_codec_cx_pkt_t * /*pkt*/) {
+    frame_coded_ = true;
+  }
+
+  // The statistics are those of the last frame returned by the encoder.
+  virtual void PostEncodeFrameHook(::libvpx_test::VideoSource * /*video*/,
+                                   ::libvpx_test::Encoder *encoder) {
+    if (frame_coded_) {
+      vpx_frame_stats_t frame_stats;
+      memset(&frame_stats, 0xff, sizeof(frame_stats));
+      encoder->Control(VP9E_GET_FRAME_STATS, &frame_stats);
+      stats_.push_back(frame_stats);
+      frame_coded_ = false;
+    }
+  }
+
+  void Encode() {
+    ::libvpx_test::SyntheticVideoSource video;
+    video.SetSize(352, 288);
+    video.set_limit(kFrames);
+    ASSERT_NO_FATAL_FAILURE(RunLoop(&video));
+    ASSERT_EQ(static_cast<size_t>(kFrames), stats_.size());
+  }
+
+  void CheckStats() {
+    for (size_t i = 0; i < stats_.size(); ++i) {
+      const vpx_frame_stats_t &stats = stats_[i];
+      const vpx_stage_time_t &encode = stats.stages[VP9E_STAGE_ENCODE];
+
+      EXPECT_EQ(static_cast<int>(cfg_.g_threads ? cfg_.g_threads : 1),
+                stats.threads) << "frame " << i;
+      EXPECT_GT(stats.frame_us, 0) << "frame " << i;
+      EXPECT_GT(encode.wall_us, 0) << "frame " << i;
+      EXPECT_LE(encode.wall_us, stats.frame_us) << "frame " << i;
+      EXPECT_GT(stats.rd_evals, 0u) << "frame " << i;
+      for (int stage = 0; stage < VP9E_STAGE_COUNT; ++stage) {
+        EXPECT_GE(stats.stages[stage].wall_us, 0);
+        EXPECT_GE(stats.stages[stage].busy_us, 0);
+      }
+      // The stages timed block by block are only accounted as busy time.
+      EXPECT_EQ(0, stats.stages[VP9E_STAGE_MODE_DECISION].wall_us);
+      EXPECT_EQ(0, stats.stages[VP9E_STAGE_MOTION_SEARCH].wall_us);
+      EXPECT_EQ(0, stats.stages[VP9E_STAGE_TOKENIZE].wall_us);
+      EXPECT_LE(stats.stages[VP9E_STAGE_MOTION_SEARCH].busy_us,
+                stats.stages[VP9E_STAGE_MODE_DECISION].busy_us);
+      for (int t = 0; t < stats.threads; ++t)
+        EXPECT_GE(stats.thread_idle_us[t], 0) << "thread " << t;
+      for (int t = stats.threads; t < VP9E_STATS_MAX_THREADS; ++t)
+        EXPECT_EQ(0, stats.thread_idle_us[t]) << "thread " << t;
+      if (stats.threads == 1)
+        EXPECT_EQ(0, stats.thread_idle_us[0]) << "frame " << i;
+      if (i > 0) {
+        EXPECT_GT(stats.sad_calls, 0u) << "frame " << i;
+        EXPECT_GT(stats.subpel_searches, 0u) << "frame " << i;
+      }
+    }
+  }
+
+  const ::libvpx_test::TestMode encoding_mode_;
+  const int set_cpu_used_;
+  bool enable_stats_;
+  bool frame_coded_;
+  std::vector<vpx_frame_stats_t> stats_;
+};
+
+TEST_P(VP9FrameStatsTest, DisabledByDefault) {
+  enable_stats_ = false;
+  ASSERT_NO_FATAL_FAILURE(Encode());
+
+  vpx_frame_stats_t zero;
+  memset(&zero, 0, sizeof(zero));
+  for (size_t i = 0; i < stats_.size(); ++i)
+    EXPECT_EQ(0, memcmp(&zero, &stats_[i], sizeof(zero))) << "frame " << i;
+}
+
+TEST_P(VP9FrameStatsTest, SingleThread) {
+  ASSERT_NO_FATAL_FAILURE(Encode());
+  CheckStats();
+}
+
+#if CONFIG_MULTITHREAD
+TEST_P(VP9FrameStatsTest, Threads) {
+  cfg_.g_threads = 3;
+  ASSERT_NO_FATAL_FAILURE(Encode());
+  CheckStats();
+}
+#endif
+
+TEST(VP9FrameStatsControlTest, RejectsNullStats) {
+  vpx_codec_enc_cfg_t cfg;
+  vpx_codec_ctx_t enc;
+
+  ASSERT_EQ(VPX_CODEC_OK,
+            vpx_codec_enc_config_default(&vpx_codec_vp9_cx_algo, &cfg, 0));
+  ASSERT_EQ(VPX_CODEC_OK,
+            vpx_codec_enc_init(&enc, &vpx_codec_vp9_cx_algo, &cfg, 0));
+  EXPECT_EQ(VPX_CODEC_INVALID_PARAM,
+            vpx_codec_control(&enc, VP9E_GET_FRAME_STATS,
+                              static_cast<vpx_frame_stats_t *>(NULL)));
+  EXPECT_EQ(VPX_CODEC_OK, vpx_codec_destroy(&enc));
+}
+
+VP9_INSTANTIATE_TEST_CASE(
+    VP9FrameStatsTest,
+    ::testing::Values(::libvpx_test::kOnePassGood, ::libvpx_test::kRealTime),
+    ::testing::Values(4, 5));
+
+}  // namespace
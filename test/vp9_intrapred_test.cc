@@ -127,8 +127,127 @@ TEST_P(VP9IntraPredTest, IntraPredTests) {
   RunTest(left_col, above_data, dst, ref_dst);
 }
 
+typedef void (*IntraPredFunc)(uint8_t *dst, ptrdiff_t stride,
+                              const uint8_t *above, const uint8_t *left);
+typedef std::tr1::tuple<IntraPredFunc, IntraPredFunc, int> IntraPredParam;
+
+// The 8 bit predictors against their C versions. The pixels around the block
+// are checked too, they must be left as they were.
+class VP9IntraPredictorTest : public ::testing::TestWithParam<IntraPredParam> {
+ public:
+  virtual ~VP9IntraPredictorTest() { libvpx_test::ClearSystemState(); }
+
+ protected:
+  virtual void SetUp() {
+    pred_fn_ = GET_PARAM(0);
+    ref_fn_ = GET_PARAM(1);
+    block_size_ = GET_PARAM(2);
+    stride_ = block_size_ * 3;
+  }
+
+  IntraPredFunc pred_fn_;
+  IntraPredFunc ref_fn_;
+  int block_size_;
+  ptrdiff_t stride_;
+};
+
+TEST_P(VP9IntraPredictorTest, MatchesC) {
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  // The above row, with the above left and the above right pixels.
+  DECLARE_ALIGNED_ARRAY(16, uint8_t, above_data, 16 + 2 * 32);
+  DECLARE_ALIGNED_ARRAY(16, uint8_t, left_col, 32);
+  DECLARE_ALIGNED_ARRAY(16, uint8_t, dst, 3 * 32 * 32);
+  DECLARE_ALIGNED_ARRAY(16, uint8_t, ref_dst, 3 * 32 * 32);
+  uint8_t *const above_row = above_data + 16;
+  const int dst_size = static_cast<int>(stride_) * block_size_;
+
+  for (int i = 0; i < count_test_block / 10; ++i) {
+    // Saturated edges first.
+    for (int x = -1; x < 2 * block_size_; ++x)
+      above_row[x] = i == 0 ? 255 : i == 1 ? 0 : rnd.Rand8();
+    for (int y = 0; y < block_size_; ++y)
+      left_col[y] = i == 0 ? 255 : i == 1 ? 0 : rnd.Rand8();
+    for (int j = 0; j < dst_size; ++j)
+      dst[j] = ref_dst[j] = rnd.Rand8();
+
+    ref_fn_(ref_dst, stride_, above_row, left_col);
+    ASM_REGISTER_STATE_CHECK(pred_fn_(dst, stride_, above_row, left_col));
+    for (int j = 0; j < dst_size; ++j) {
+      ASSERT_EQ(ref_dst[j], dst[j])
+          << "at row " << j / stride_ << ", column " << j % stride_
+          << ", test block " << i;
+    }
+  }
+}
+
 using std::tr1::make_tuple;
 
+#if HAVE_SSE2
+INSTANTIATE_TEST_CASE_P(SSE2, VP9IntraPredictorTest, ::testing::Values(
+    make_tuple(&vp9_dc_128_predictor_4x4_sse2,
+               &vp9_dc_128_predictor_4x4_c, 4),
+    make_tuple(&vp9_dc_128_predictor_8x8_sse2,
+               &vp9_dc_128_predictor_8x8_c, 8),
+    make_tuple(&vp9_dc_128_predictor_16x16_sse2,
+               &vp9_dc_128_predictor_16x16_c, 16),
+    make_tuple(&vp9_dc_128_predictor_32x32_sse2,
+               &vp9_dc_128_predictor_32x32_c, 32),
+    make_tuple(&vp9_dc_left_predictor_4x4_sse2,
+               &vp9_dc_left_predictor_4x4_c, 4),
+    make_tuple(&vp9_dc_left_predictor_8x8_sse2,
+               &vp9_dc_left_predictor_8x8_c, 8),
+    make_tuple(&vp9_dc_left_predictor_16x16_sse2,
+               &vp9_dc_left_predictor_16x16_c, 16),
+    make_tuple(&vp9_dc_left_predictor_32x32_sse2,
+               &vp9_dc_left_predictor_32x32_c, 32),
+    make_tuple(&vp9_dc_top_predictor_4x4_sse2,
+               &vp9_dc_top_predictor_4x4_c, 4),
+    make_tuple(&vp9_dc_top_predictor_8x8_sse2,
+               &vp9_dc_top_predictor_8x8_c, 8),
+    make_tuple(&vp9_dc_top_predictor_16x16_sse2,
+               &vp9_dc_top_predictor_16x16_c, 16),
+    make_tuple(&vp9_dc_top_predictor_32x32_sse2,
+               &vp9_dc_top_predictor_32x32_c, 32)));
+#endif  // HAVE_SSE2
+
+#if HAVE_SSSE3
+INSTANTIATE_TEST_CASE_P(SSSE3, VP9IntraPredictorTest, ::testing::Values(
+    make_tuple(&vp9_d117_predictor_4x4_ssse3,
+               &vp9_d117_predictor_4x4_c, 4),
+    make_tuple(&vp9_d117_predictor_8x8_ssse3,
+               &vp9_d117_predictor_8x8_c, 8),
+    make_tuple(&vp9_d117_predictor_16x16_ssse3,
+               &vp9_d117_predictor_16x16_c, 16),
+    make_tuple(&vp9_d117_predictor_32x32_ssse3,
+               &vp9_d117_predictor_32x32_c, 32),
+    make_tuple(&vp9_d135_predictor_4x4_ssse3,
+               &vp9_d135_predictor_4x4_c, 4),
+    make_tuple(&vp9_d135_predictor_8x8_ssse3,
+               &vp9_d135_predictor_8x8_c, 8),
+    make_tuple(&vp9_d135_predictor_16x16_ssse3,
+               &vp9_d135_predictor_16x16_c, 16),
+    make_tuple(&vp9_d135_predictor_32x32_ssse3,
+               &vp9_d135_predictor_32x32_c, 32),
+    make_tuple(&vp9_d153_predictor_32x32_ssse3,
+               &vp9_d153_predictor_32x32_c, 32)));
+#endif  // HAVE_SSSE3
+
+#if HAVE_AVX2
+INSTANTIATE_TEST_CASE_P(AVX2, VP9IntraPredictorTest, ::testing::Values(
+    make_tuple(&vp9_d117_predictor_32x32_avx2,
+               &vp9_d117_predictor_32x32_c, 32),
+    make_tuple(&vp9_d135_predictor_32x32_avx2,
+               &vp9_d135_predictor_32x32_c, 32),
+    make_tuple(&vp9_d153_predictor_32x32_avx2,
+               &vp9_d153_predictor_32x32_c, 32),
+    make_tuple(&vp9_dc_128_predictor_32x32_avx2,
+               &vp9_dc_128_predictor_32x32_c, 32),
+    make_tuple(&vp9_dc_left_predictor_32x32_avx2,
+               &vp9_dc_left_predictor_32x32_c, 32),
+    make_tuple(&vp9_dc_top_predictor_32x32_avx2,
+               &vp9_dc_top_predictor_32x32_c, 32)));
+#endif  // HAVE_AVX2
+
 #if HAVE_SSE2
 #if CONFIG_VP9_HIGHBITDEPTH
 #if ARCH_X86_64
@@ -0,0 +1,111 @@
+/*
+ *  Copyright (c) 2014 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string>
+#include <vector>
+
+#include "third_party/googletest/src/include/gtest/gtest.h"
+#include "test/codec_factory.h"
+#include "test/encode_test_driver.h"
+#include "test/util.h"
+#include "test/video_source.h"
+
+namespace {
+
+const int kFrames = 30;
+const int kSceneCut = 17;
+
+// One pass encodes running the second pass over the statistics of their
+// lookahead frames. The parameter is the lag.
+class VP9LookaheadStatsTest : public ::libvpx_test::EncoderTest,
+                              public ::libvpx_test::CodecTestWithParam<int> {
+ protected:
+  VP9LookaheadStatsTest() : EncoderTest(GET_PARAM(0)), lag_(GET_PARAM(1)) {}
+  virtual ~VP9LookaheadStatsTest() {}
+
+  virtual void SetUp() {
+    InitializeConfig();
+    SetMode(::libvpx_test::kOnePassGood);
+    cfg_.g_lag_in_frames = lag_;
+    cfg_.rc_target_bitrate = 300;
+  }
+
+  virtual void PreEncodeFrameHook(::libvpx_test::VideoSource *video,
+                                  ::libvpx_test::Encoder *encoder) {
+    if (video->frame() == 0) {
+      encoder->Control(VP8E_SET_CPUUSED, 4);
+      encoder->Control(VP9E_SET_LOOKAHEAD_STATS, 1);
+    }
+  }
+
+  virtual void FramePktHook(const vpx_codec_cx_pkt_t *pkt) {
+    if (pkt->data.frame.flags & VPX_FRAME_IS_KEY)
+      key_frames_.push_back(static_cast<int>(pkt->data.frame.pts));
+    frames_.push_back(
+        std::string(static_cast<const char *>(pkt->data.frame.buf),
+                    pkt->data.frame.sz));
+  }
+
+  // Encode the frames, returning the compressed frames.
+  std::vector<std::string> Encode(int frames = kFrames) {
+    ::libvpx_test::SyntheticVideoSource video;
+    video.SetSize(176, 144);
+    video.set_limit(frames);
+    video.set_scene_cut(kSceneCut);
+    key_frames_.clear();
+    frames_.clear();
+    RunLoop(&video);
+    EXPECT_EQ(static_cast<size_t>(frames), frames_.size());
+    return frames_;
+  }
+
+  const int lag_;
+  std::vector<int> key_frames_;
+  std::vector<std::string> frames_;
+};
+
+TEST_P(VP9LookaheadStatsTest, KeyFrameAtSceneCut) {
+  const std::vector<std::string> reference = Encode();
+  const std::vector<int> reference_key_frames = key_frames_;
+
+  ASSERT_EQ(2u, reference_key_frames.size());
+  EXPECT_EQ(0, reference_key_frames[0]);
+  EXPECT_EQ(kSceneCut, reference_key_frames[1]);
+
+  // The statistics are analyzed on a worker thread, the encode has to be
+  // the same whatever the scheduling.
+  EXPECT_TRUE(reference == Encode());
+  EXPECT_TRUE(reference_key_frames == key_frames_);
+}
+
+// The gf groups are defined from the stats of a single lookahead frame. Long
+// enough for the stats to run out right after a gf group.
+TEST_P(VP9LookaheadStatsTest, SingleFrameLag) {
+  cfg_.g_lag_in_frames = 1;
+  Encode(80);
+}
+
+TEST(VP9LookaheadStatsControlTest, RequiresOnePassWithLag) {
+  vpx_codec_enc_cfg_t cfg;
+  vpx_codec_ctx_t enc;
+
+  ASSERT_EQ(VPX_CODEC_OK,
+            vpx_codec_enc_config_default(&vpx_codec_vp9_cx_algo, &cfg, 0));
+  cfg.g_lag_in_frames = 0;
+  ASSERT_EQ(VPX_CODEC_OK,
+            vpx_codec_enc_init(&enc, &vpx_codec_vp9_cx_algo, &cfg, 0));
+  EXPECT_NE(VPX_CODEC_OK,
+            vpx_codec_control(&enc, VP9E_SET_LOOKAHEAD_STATS, 1));
+  EXPECT_EQ(VPX_CODEC_OK, vpx_codec_destroy(&enc));
+}
+
+VP9_INSTANTIATE_TEST_CASE(VP9LookaheadStatsTest, ::testing::Values(16, 25));
+
+}  // namespace
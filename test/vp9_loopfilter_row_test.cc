@@ -0,0 +1,222 @@
+/*
+ *  Copyright (c) 2014 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string.h>
+
+#include "test/acm_random.h"
+#include "test/clear_system_state.h"
+#include "test/register_state_check.h"
+#include "test/util.h"
+#include "third_party/googletest/src/include/gtest/gtest.h"
+
+#include "./vpx_config.h"
+#include "./vp9_rtcd.h"
+#include "vp9/common/vp9_loopfilter.h"
+
+namespace {
+
+using libvpx_test::ACMRandom;
+
+const int kNumTests = 2000;
+// The rows of a superblock with 16 rows and columns around them.
+const int kBorder = 16;
+const int kStride = kBorder + 64 + kBorder;
+const int kRows = kBorder + 64 + kBorder;
+
+typedef void (*VerticalRowFunc)(uint8_t *s, int pitch, int plane_type,
+                                unsigned int mask_16x16,
+                                unsigned int mask_8x8,
+                                unsigned int mask_4x4,
+                                unsigned int mask_4x4_int,
+                                const loop_filter_info_n *lfi_n,
+                                const uint8_t *lfl);
+typedef void (*HorizontalRowFunc)(uint8_t *s, int pitch,
+                                  unsigned int mask_16x16,
+                                  unsigned int mask_8x8,
+                                  unsigned int mask_4x4,
+                                  unsigned int mask_4x4_int,
+                                  const loop_filter_info_n *lfi_n,
+                                  const uint8_t *lfl);
+
+// Filters the edges of random masks, filter levels and sharpness in blocks
+// of pixels smooth enough for the 8 and 16 wide filters to apply.
+class LoopFilterRowTestBase {
+ public:
+  virtual ~LoopFilterRowTestBase() { libvpx_test::ClearSystemState(); }
+
+ protected:
+  LoopFilterRowTestBase() : rnd_(ACMRandom::DeterministicSeed()) {}
+
+  void SetThresholds() {
+    const int sharpness = Rand(8);
+    for (int lvl = 0; lvl <= MAX_LOOP_FILTER; ++lvl) {
+      // As in vp9_loop_filter_update_sharpness().
+      int block_inside_limit = lvl >> ((sharpness > 0) + (sharpness > 4));
+      if (sharpness > 0 && block_inside_limit > 9 - sharpness)
+        block_inside_limit = 9 - sharpness;
+      if (block_inside_limit < 1)
+        block_inside_limit = 1;
+      memset(lfi_.lfthr[lvl].lim, block_inside_limit, SIMD_WIDTH);
+      memset(lfi_.lfthr[lvl].mblim, 2 * (lvl + 2) + block_inside_limit,
+             SIMD_WIDTH);
+      memset(lfi_.lfthr[lvl].hev_thr, lvl >> 4, SIMD_WIDTH);
+    }
+    // Many low levels, their thresholds are the ones most pixels fail.
+    for (int i = 0; i < 64; ++i)
+      lfl_[i] = Rand(2) ? Rand(8) : Rand(MAX_LOOP_FILTER + 1);
+  }
+
+  void FillBlocks() {
+    // Each block is around the average of the blocks above and to the left.
+    int base[kRows / 8][kStride / 8];
+    for (int r = 0; r < kRows; r += 8) {
+      for (int c = 0; c < kStride; c += 8) {
+        const int noise = Rand(8) == 0 ? 255 : Rand(2) ? Rand(2) : Rand(6);
+        const int above = r ? base[r / 8 - 1][c / 8] : -1;
+        const int left = c ? base[r / 8][c / 8 - 1] : above;
+        int &b = base[r / 8][c / 8];
+        b = left < 0 ? rnd_.Rand8() :
+            clamp((above < 0 ? left : (above + left + 1) / 2) + Rand(9) - 4);
+        for (int y = r; y < r + 8; ++y) {
+          for (int x = c; x < c + 8; ++x)
+            pixels_[y * kStride + x] = clamp(b + Rand(noise + 1));
+        }
+      }
+    }
+    memcpy(ref_pixels_, pixels_, sizeof(pixels_));
+  }
+
+  // One bit per block in 'bits' for a disjoint set of 16x16, 8x8 and 4x4
+  // masks, the internal 4x4 edges not being on 16x16 ones.
+  void SetMasks(int bits) {
+    mask_16x16_ = mask_8x8_ = mask_4x4_ = mask_4x4_int_ = 0;
+    for (int i = 0; i < bits; ++i) {
+      const unsigned int bit = 1u << i;
+      switch (Rand(4)) {
+        case 1: mask_4x4_ |= bit; break;
+        case 2: mask_8x8_ |= bit; break;
+        case 3: mask_16x16_ |= bit; break;
+        default: break;
+      }
+      if (!(mask_16x16_ & bit) && Rand(2))
+        mask_4x4_int_ |= bit;
+    }
+  }
+
+  void CheckPixels(int test) const {
+    for (int i = 0; i < kStride * kRows; ++i) {
+      ASSERT_EQ(ref_pixels_[i], pixels_[i])
+          << "at row " << i / kStride - kBorder << ", column "
+          << i % kStride - kBorder << ", test " << test;
+    }
+  }
+
+  uint8_t *Origin(uint8_t *pixels) const {
+    return pixels + kBorder * kStride + kBorder;
+  }
+
+  // The low bits of PseudoUniform() repeat too often for the masks.
+  int Rand(int range) {
+    return rnd_.Rand16() % range;
+  }
+
+  static uint8_t clamp(int v) {
+    return v < 0 ? 0 : v > 255 ? 255 : v;
+  }
+
+  ACMRandom rnd_;
+  loop_filter_info_n lfi_;
+  uint8_t lfl_[64];
+  uint8_t pixels_[kStride * kRows];
+  uint8_t ref_pixels_[kStride * kRows];
+  unsigned int mask_16x16_;
+  unsigned int mask_8x8_;
+  unsigned int mask_4x4_;
+  unsigned int mask_4x4_int_;
+};
+
+typedef std::tr1::tuple<VerticalRowFunc, VerticalRowFunc, int>
+    VerticalRowParam;
+
+class VP9LoopFilterVerticalRowTest
+    : public LoopFilterRowTestBase,
+      public ::testing::TestWithParam<VerticalRowParam> {
+ protected:
+  virtual void SetUp() {
+    filter_ = GET_PARAM(0);
+    ref_filter_ = GET_PARAM(1);
+    plane_type_ = GET_PARAM(2);
+  }
+
+  VerticalRowFunc filter_;
+  VerticalRowFunc ref_filter_;
+  int plane_type_;
+};
+
+TEST_P(VP9LoopFilterVerticalRowTest, MatchesC) {
+  const int cols = plane_type_ ? 4 : 8;
+  for (int i = 0; i < kNumTests; ++i) {
+    SetThresholds();
+    FillBlocks();
+    SetMasks(4 * cols);
+    ref_filter_(Origin(ref_pixels_), kStride, plane_type_, mask_16x16_,
+                mask_8x8_, mask_4x4_, mask_4x4_int_, &lfi_, lfl_);
+    ASM_REGISTER_STATE_CHECK(filter_(Origin(pixels_), kStride, plane_type_,
+                                     mask_16x16_, mask_8x8_, mask_4x4_,
+                                     mask_4x4_int_, &lfi_, lfl_));
+    CheckPixels(i);
+  }
+}
+
+typedef std::tr1::tuple<HorizontalRowFunc, HorizontalRowFunc, int>
+    HorizontalRowParam;
+
+class VP9LoopFilterHorizontalRowTest
+    : public LoopFilterRowTestBase,
+      public ::testing::TestWithParam<HorizontalRowParam> {
+ protected:
+  virtual void SetUp() {
+    filter_ = GET_PARAM(0);
+    ref_filter_ = GET_PARAM(1);
+    cols_ = GET_PARAM(2);
+  }
+
+  HorizontalRowFunc filter_;
+  HorizontalRowFunc ref_filter_;
+  int cols_;
+};
+
+TEST_P(VP9LoopFilterHorizontalRowTest, MatchesC) {
+  for (int i = 0; i < kNumTests; ++i) {
+    SetThresholds();
+    FillBlocks();
+    SetMasks(cols_);
+    ref_filter_(Origin(ref_pixels_), kStride, mask_16x16_, mask_8x8_,
+                mask_4x4_, mask_4x4_int_, &lfi_, lfl_);
+    ASM_REGISTER_STATE_CHECK(filter_(Origin(pixels_), kStride, mask_16x16_,
+                                     mask_8x8_, mask_4x4_, mask_4x4_int_,
+                                     &lfi_, lfl_));
+    CheckPixels(i);
+  }
+}
+
+using std::tr1::make_tuple;
+
+#if HAVE_AVX2
+INSTANTIATE_TEST_CASE_P(AVX2, VP9LoopFilterVerticalRowTest, ::testing::Values(
+    make_tuple(&vp9_lpf_vertical_row4_avx2, &vp9_lpf_vertical_row4_c, 0),
+    make_tuple(&vp9_lpf_vertical_row4_avx2, &vp9_lpf_vertical_row4_c, 1)));
+
+INSTANTIATE_TEST_CASE_P(AVX2, VP9LoopFilterHorizontalRowTest,
+                        ::testing::Values(
+    make_tuple(&vp9_lpf_horizontal_row_avx2, &vp9_lpf_horizontal_row_c, 8),
+    make_tuple(&vp9_lpf_horizontal_row_avx2, &vp9_lpf_horizontal_row_c, 4)));
+#endif  // HAVE_AVX2
+}  // namespace
@@ -0,0 +1,154 @@
+/*
+ *  Copyright (c) 2014 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string>
+#include <vector>
+
+#include "third_party/googletest/src/include/gtest/gtest.h"
+#include "test/codec_factory.h"
+#include "test/encode_test_driver.h"
+#include "test/util.h"
+#include "test/video_source.h"
+#include "vp9/decoder/vp9_read_bit_buffer.h"
+
+namespace {
+
+const int kFrames = 4;
+
+// Returns the loop filter level of a profile 0 frame, read from its
+// uncompressed header.
+int ReadFilterLevel(const uint8_t *data, size_t size) {
+  struct vp9_read_bit_buffer rb = { data, data + size, 0, NULL, NULL };
+
+  EXPECT_EQ(2, vp9_rb_read_literal(&rb, 2));  // frame marker
+  EXPECT_EQ(0, vp9_rb_read_literal(&rb, 2));  // profile
+  EXPECT_EQ(0, vp9_rb_read_bit(&rb));         // show existing frame
+  const int key_frame = !vp9_rb_read_bit(&rb);
+  const int show_frame = vp9_rb_read_bit(&rb);
+  const int error_resilient_mode = vp9_rb_read_bit(&rb);
+
+  if (key_frame) {
+    vp9_rb_read_literal(&rb, 24);  // sync code
+    if (vp9_rb_read_literal(&rb, 3) != 7)  // color space, not sRGB
+      vp9_rb_read_bit(&rb);  // color range
+    vp9_rb_read_literal(&rb, 32);  // frame size
+    if (vp9_rb_read_bit(&rb))
+      vp9_rb_read_literal(&rb, 32);  // display size
+  } else {
+    const int intra_only = show_frame ? 0 : vp9_rb_read_bit(&rb);
+    if (!error_resilient_mode)
+      vp9_rb_read_literal(&rb, 2);  // reset frame context
+    if (intra_only) {
+      vp9_rb_read_literal(&rb, 24);  // sync code
+      vp9_rb_read_literal(&rb, 8);   // refresh frame flags
+      vp9_rb_read_literal(&rb, 32);  // frame size
+    } else {
+      int found = 0;
+      vp9_rb_read_literal(&rb, 8);  // refresh frame flags
+      for (int i = 0; i < 3; ++i)
+        vp9_rb_read_literal(&rb, 4);  // reference index and sign bias
+      for (int i = 0; i < 3 && !found; ++i)
+        found = vp9_rb_read_bit(&rb);
+      if (!found)
+        vp9_rb_read_literal(&rb, 32);  // frame size
+    }
+    if (vp9_rb_read_bit(&rb))
+      vp9_rb_read_literal(&rb, 32);  // display size
+    if (!intra_only) {
+      vp9_rb_read_bit(&rb);  // high precision motion vectors
+      if (!vp9_rb_read_bit(&rb))
+        vp9_rb_read_literal(&rb, 2);  // interpolation filter
+    }
+  }
+
+  if (!error_resilient_mode)
+    vp9_rb_read_literal(&rb, 2);  // refresh context, frame parallel mode
+  vp9_rb_read_literal(&rb, 2);  // frame context index
+  return vp9_rb_read_literal(&rb, 6);
+}
+
+// The loop filter level searched by the encoder has to be the same whatever
+// the number of threads the SB rows are filtered with. Speed 1 still searches
+// the level on the full image and, unlike speed 0, codes the frames the same
+// with any number of threads, so the search runs on the same reconstruction.
+// The parameter is the sharpness.
+class VP9LpfSearchMtTest : public ::libvpx_test::EncoderTest,
+                           public ::libvpx_test::CodecTestWithParam<int> {
+ protected:
+  VP9LpfSearchMtTest() : EncoderTest(GET_PARAM(0)), sharpness_(GET_PARAM(1)) {}
+  virtual ~VP9LpfSearchMtTest() {}
+
+  virtual void SetUp() {
+    InitializeConfig();
+    SetMode(::libvpx_test::kOnePassGood);
+    // No hidden frames, so that each packet holds a single frame.
+    cfg_.g_lag_in_frames = 0;
+    cfg_.rc_end_usage = VPX_Q;
+  }
+
+  virtual void PreEncodeFrameHook(::libvpx_test::VideoSource *video,
+                                  ::libvpx_test::Encoder *encoder) {
+    if (video->frame() == 0) {
+      encoder->Control(VP8E_SET_CPUUSED, 1);
+      encoder->Control(VP8E_SET_SHARPNESS, sharpness_);
+      encoder->Control(VP8E_SET_CQ_LEVEL, 30);
+    }
+  }
+
+  virtual void FramePktHook(const vpx_codec_cx_pkt_t *pkt) {
+    const uint8_t *const data =
+        static_cast<const uint8_t *>(pkt->data.frame.buf);
+    levels_.push_back(ReadFilterLevel(data, pkt->data.frame.sz));
+    frames_.push_back(std::string(reinterpret_cast<const char *>(data),
+                                  pkt->data.frame.sz));
+  }
+
+  void CheckThreads(unsigned int width, unsigned int height) {
+    ::libvpx_test::SyntheticVideoSource video;
+    video.SetSize(width, height);
+    video.set_limit(kFrames);
+
+    cfg_.g_threads = 1;
+    ASSERT_NO_FATAL_FAILURE(RunLoop(&video));
+    ASSERT_EQ(static_cast<size_t>(kFrames), levels_.size());
+    const std::vector<int> reference = levels_;
+    const std::vector<std::string> reference_frames = frames_;
+
+    for (unsigned int threads = 2; threads <= 4; ++threads) {
+      levels_.clear();
+      frames_.clear();
+      cfg_.g_threads = threads;
+      ASSERT_NO_FATAL_FAILURE(RunLoop(&video));
+      ASSERT_EQ(reference.size(), levels_.size());
+      for (int i = 0; i < kFrames; ++i) {
+        EXPECT_EQ(reference[i], levels_[i])
+            << threads << " threads, frame " << i;
+        EXPECT_TRUE(reference_frames[i] == frames_[i])
+            << threads << " threads, frame " << i;
+      }
+    }
+  }
+
+  const int sharpness_;
+  std::vector<int> levels_;
+  std::vector<std::string> frames_;
+};
+
+TEST_P(VP9LpfSearchMtTest, SameLevel) {
+  CheckThreads(176, 144);
+}
+
+TEST_P(VP9LpfSearchMtTest, SameLevelOddSize) {
+  CheckThreads(202, 122);
+}
+
+VP9_INSTANTIATE_TEST_CASE(VP9LpfSearchMtTest, ::testing::Values(0, 5));
+
+}  // namespace
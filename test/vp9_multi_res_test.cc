@@ -0,0 +1,262 @@
+/*
+ *  Copyright (c) 2014 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include "third_party/googletest/src/include/gtest/gtest.h"
+#include "test/codec_factory.h"
+#include "test/decode_test_driver.h"
+#include "test/video_source.h"
+#include "./vpx_config.h"
+#include "vpx/vp8cx.h"
+#include "vpx/vpx_encoder.h"
+
+namespace {
+
+// Resolutions from the highest to the lowest, as vpx_codec_enc_init_multi()
+// expects them.
+const int kNumResolutions = 3;
+const int kWidth = 256;
+const int kHeight = 144;
+const int kFrames = 30;
+const int kSceneCut = 17;
+
+struct CodedFrame {
+  int pts;
+  bool key;
+  std::string data;
+};
+
+class VP9MultiResTest : public ::testing::Test {
+ protected:
+  virtual void SetUp() {
+    for (int i = 0; i < kNumResolutions; ++i) {
+      ASSERT_EQ(VPX_CODEC_OK,
+                vpx_codec_enc_config_default(&vpx_codec_vp9_cx_algo, &cfg_[i],
+                                             0));
+      cfg_[i].g_w = kWidth >> i;
+      cfg_[i].g_h = kHeight >> i;
+      cfg_[i].g_threads = 1;
+      cfg_[i].rc_target_bitrate = 400 >> (2 * i);
+      cfg_[i].kf_mode = VPX_KF_AUTO;
+      dsf_[i].num = 2;
+      dsf_[i].den = 1;
+    }
+    lookahead_stats_ = false;
+  }
+
+  // Set up one pass realtime encodes without lag.
+  void SetRealtime(int key_frame_interval) {
+    for (int i = 0; i < kNumResolutions; ++i) {
+      cfg_[i].g_lag_in_frames = 0;
+      cfg_[i].rc_end_usage = VPX_CBR;
+      cfg_[i].kf_max_dist = key_frame_interval;
+    }
+    deadline_ = VPX_DL_REALTIME;
+    speed_ = 5;
+  }
+
+  // Set up encodes with lag, sharing the first pass statistics of the lowest
+  // resolution.
+  void SetLookaheadStats(int lag) {
+    for (int i = 0; i < kNumResolutions; ++i)
+      cfg_[i].g_lag_in_frames = lag;
+    deadline_ = VPX_DL_GOOD_QUALITY;
+    speed_ = 4;
+    lookahead_stats_ = true;
+  }
+
+  // Encode the video, every encoder downscales the full resolution frames.
+  void Encode() {
+    ::libvpx_test::SyntheticVideoSource video;
+    vpx_codec_ctx_t enc[kNumResolutions];
+    vpx_image_t img[kNumResolutions];
+
+    video.SetSize(kWidth, kHeight);
+    video.set_limit(kFrames);
+    video.set_scene_cut(kSceneCut);
+    for (int i = 0; i < kNumResolutions; ++i)
+      cfg_[i].g_timebase = video.timebase();
+
+    ASSERT_EQ(VPX_CODEC_OK,
+              vpx_codec_enc_init_multi(enc, &vpx_codec_vp9_cx_algo, cfg_,
+                                       kNumResolutions, 0, dsf_));
+    for (int i = 0; i < kNumResolutions; ++i) {
+      EXPECT_EQ(VPX_CODEC_OK,
+                vpx_codec_control(&enc[i], VP8E_SET_CPUUSED, speed_));
+      if (lookahead_stats_) {
+        EXPECT_EQ(VPX_CODEC_OK,
+                  vpx_codec_control(&enc[i], VP9E_SET_LOOKAHEAD_STATS, 1));
+      }
+    }
+
+    for (video.Begin(); video.img() != NULL; video.Next()) {
+      for (int i = 0; i < kNumResolutions; ++i)
+        img[i] = *video.img();
+      ASSERT_EQ(VPX_CODEC_OK, vpx_codec_encode(enc, img, video.pts(),
+                                               video.duration(), 0,
+                                               deadline_));
+      GetFrames(enc);
+    }
+    // Flush the lookahead.
+    bool again;
+    do {
+      ASSERT_EQ(VPX_CODEC_OK,
+                vpx_codec_encode(enc, NULL, 0, 0, 0, deadline_));
+      again = GetFrames(enc);
+    } while (again);
+
+    for (int i = 0; i < kNumResolutions; ++i) {
+      EXPECT_EQ(VPX_CODEC_OK, vpx_codec_destroy(&enc[i]));
+      ASSERT_EQ(static_cast<size_t>(kFrames), frames_[i].size())
+          << "resolution " << i;
+    }
+  }
+
+  // Returns whether there was any compressed frame.
+  bool GetFrames(vpx_codec_ctx_t *enc) {
+    bool got_frames = false;
+    for (int i = 0; i < kNumResolutions; ++i) {
+      vpx_codec_iter_t iter = NULL;
+      const vpx_codec_cx_pkt_t *pkt;
+      while ((pkt = vpx_codec_get_cx_data(&enc[i], &iter)) != NULL) {
+        if (pkt->kind != VPX_CODEC_CX_FRAME_PKT)
+          continue;
+        CodedFrame coded;
+        coded.pts = static_cast<int>(pkt->data.frame.pts);
+        coded.key = (pkt->data.frame.flags & VPX_FRAME_IS_KEY) != 0;
+        coded.data.assign(static_cast<const char *>(pkt->data.frame.buf),
+                          pkt->data.frame.sz);
+        frames_[i].push_back(coded);
+        got_frames = true;
+      }
+    }
+    return got_frames;
+  }
+
+  std::vector<int> KeyFrames(int resolution) const {
+    std::vector<int> key_frames;
+    for (size_t frame = 0; frame < frames_[resolution].size(); ++frame) {
+      if (frames_[resolution][frame].key)
+        key_frames.push_back(frames_[resolution][frame].pts);
+    }
+    return key_frames;
+  }
+
+  // Every stream decodes to frames of the size of its encoder.
+  void ExpectStreamsDecode() {
+    for (int i = 0; i < kNumResolutions; ++i) {
+      const vpx_codec_dec_cfg_t cfg = vpx_codec_dec_cfg_t();
+      ::libvpx_test::VP9Decoder decoder(cfg, 0);
+      for (size_t frame = 0; frame < frames_[i].size(); ++frame) {
+        const std::string &data = frames_[i][frame].data;
+        ASSERT_EQ(VPX_CODEC_OK,
+                  decoder.DecodeFrame(
+                      reinterpret_cast<const uint8_t *>(data.data()),
+                      data.size()))
+            << "resolution " << i << " frame " << frame;
+        ::libvpx_test::DxDataIterator dec_iter = decoder.GetDxData();
+        const vpx_image_t *const img = dec_iter.Next();
+        ASSERT_TRUE(img != NULL);
+        EXPECT_EQ(cfg_[i].g_w, img->d_w);
+        EXPECT_EQ(cfg_[i].g_h, img->d_h);
+      }
+    }
+  }
+
+  vpx_codec_enc_cfg_t cfg_[kNumResolutions];
+  vpx_rational_t dsf_[kNumResolutions];
+  unsigned long deadline_;
+  int speed_;
+  bool lookahead_stats_;
+  std::vector<CodedFrame> frames_[kNumResolutions];
+};
+
+TEST_F(VP9MultiResTest, RealtimeKeyFramesAreAligned) {
+  SetRealtime(6);
+  Encode();
+
+  const std::vector<int> key_frames = KeyFrames(kNumResolutions - 1);
+  // The higher resolutions only follow the key frames of the lowest one.
+  EXPECT_GT(key_frames.size(), 1u);
+  for (int i = 0; i < kNumResolutions - 1; ++i)
+    EXPECT_TRUE(key_frames == KeyFrames(i)) << "resolution " << i;
+  ExpectStreamsDecode();
+}
+
+TEST_F(VP9MultiResTest, LookaheadStatsKeyFramesAtSceneCut) {
+  SetLookaheadStats(16);
+  Encode();
+
+  // The scene cut is only found in the first pass statistics, which the
+  // higher resolutions read from the lowest one.
+  std::vector<int> expected;
+  expected.push_back(0);
+  expected.push_back(kSceneCut);
+  for (int i = 0; i < kNumResolutions; ++i)
+    EXPECT_TRUE(expected == KeyFrames(i)) << "resolution " << i;
+  ExpectStreamsDecode();
+}
+
+TEST_F(VP9MultiResTest, LookaheadStatsAreDeterministic) {
+  SetLookaheadStats(25);
+  Encode();
+
+  std::vector<CodedFrame> reference[kNumResolutions];
+  for (int i = 0; i < kNumResolutions; ++i)
+    reference[i].swap(frames_[i]);
+  Encode();
+  for (int i = 0; i < kNumResolutions; ++i) {
+    for (int frame = 0; frame < kFrames; ++frame)
+      EXPECT_TRUE(reference[i][frame].data == frames_[i][frame].data)
+          << "resolution " << i << " frame " << frame;
+  }
+}
+
+TEST_F(VP9MultiResTest, RejectsSmallerImage) {
+  vpx_codec_ctx_t enc[kNumResolutions];
+  vpx_image_t img[kNumResolutions];
+
+  SetRealtime(6);
+  ASSERT_EQ(VPX_CODEC_OK,
+            vpx_codec_enc_init_multi(enc, &vpx_codec_vp9_cx_algo, cfg_,
+                                     kNumResolutions, 0, dsf_));
+  // The highest resolution gets the image of the next one.
+  for (int i = 0; i < kNumResolutions; ++i)
+    ASSERT_TRUE(vpx_img_alloc(&img[i], VPX_IMG_FMT_I420, cfg_[1].g_w,
+                              cfg_[1].g_h, 16) != NULL);
+  EXPECT_EQ(VPX_CODEC_INVALID_PARAM,
+            vpx_codec_encode(enc, img, 0, 1, 0, VPX_DL_REALTIME));
+  for (int i = 0; i < kNumResolutions; ++i) {
+    vpx_img_free(&img[i]);
+    EXPECT_EQ(VPX_CODEC_OK, vpx_codec_destroy(&enc[i]));
+  }
+}
+
+TEST_F(VP9MultiResTest, FailedInitStaysInBounds) {
+  // The encoders follow a guard context, which a failed initialization must
+  // leave alone.
+  vpx_codec_ctx_t ctx[kNumResolutions + 1];
+
+  memset(ctx, 0, sizeof(ctx));
+  // The second encoder fails, after the first one is set up.
+  cfg_[1].rc_max_quantizer = 64;
+  EXPECT_EQ(VPX_CODEC_INVALID_PARAM,
+            vpx_codec_enc_init_multi(&ctx[1], &vpx_codec_vp9_cx_algo, cfg_,
+                                     kNumResolutions, 0, dsf_));
+  EXPECT_EQ(VPX_CODEC_OK, ctx[0].err);
+  EXPECT_EQ(VPX_CODEC_INVALID_PARAM, ctx[1].err);
+  for (int i = 1; i <= kNumResolutions; ++i)
+    EXPECT_TRUE(ctx[i].priv == NULL) << "encoder " << i - 1;
+}
+
+}  // namespace
@@ -0,0 +1,221 @@
+/*
+ *  Copyright (c) 2014 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string.h>
+
+#include "third_party/googletest/src/include/gtest/gtest.h"
+#include "test/acm_random.h"
+#include "test/clear_system_state.h"
+#include "test/register_state_check.h"
+#include "test/util.h"
+
+#include "./vpx_config.h"
+#include "./vp9_rtcd.h"
+#include "vp9/common/vp9_common.h"
+#include "vp9/common/vp9_quant_common.h"
+#include "vp9/common/vp9_scan.h"
+#include "vpx/vpx_codec.h"
+#include "vpx/vpx_integer.h"
+
+using libvpx_test::ACMRandom;
+
+namespace {
+#if CONFIG_VP9_HIGHBITDEPTH
+const int kNumCoeffs = 1024;
+const int kNumTests = 1000;
+
+typedef void (*QuantizeFunc)(const tran_low_t *coeff_ptr, intptr_t n_coeffs,
+                             int skip_block, const int16_t *zbin_ptr,
+                             const int16_t *round_ptr,
+                             const int16_t *quant_ptr,
+                             const int16_t *quant_shift_ptr,
+                             tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr,
+                             const int16_t *dequant_ptr, int zbin_oq_value,
+                             uint16_t *eob_ptr, const int16_t *scan,
+                             const int16_t *iscan);
+
+// The quantizer, its C reference, whether it is a 32x32 one and whether it
+// is an fp one, and the bit depth.
+typedef std::tr1::tuple<QuantizeFunc, QuantizeFunc, int, int, vpx_bit_depth_t>
+    QuantizeParam;
+
+class VP9QuantizeTest : public ::testing::TestWithParam<QuantizeParam> {
+ public:
+  virtual ~VP9QuantizeTest() {}
+  virtual void SetUp() {
+    quantize_ = GET_PARAM(0);
+    ref_quantize_ = GET_PARAM(1);
+    is_32x32_ = GET_PARAM(2);
+    is_fp_ = GET_PARAM(3);
+    bit_depth_ = GET_PARAM(4);
+    // The SIMD versions find the end of block with the inverse scans.
+    vp9_init_neighbors();
+  }
+
+  virtual void TearDown() { libvpx_test::ClearSystemState(); }
+
+ protected:
+  // Sets up the quantizer of 'qindex' the way the encoder does, with random
+  // rounding and zero bin factors.
+  void SetQuantizer(ACMRandom *rnd, int qindex) {
+    for (int i = 0; i < 2; ++i) {
+      const int d = i == 0 ? vp9_dc_quant(qindex, 0, bit_depth_)
+                           : vp9_ac_quant(qindex, 0, bit_depth_);
+      dequant_[i] = d;
+      zbin_[i] = ROUND_POWER_OF_TWO((64 + rnd->PseudoUniform(32)) * d, 7);
+      round_[i] = (rnd->PseudoUniform(128) * d) >> 7;
+      if (is_fp_) {
+        quant_[i] = (1 << 16) / d;
+        quant_shift_[i] = 0;
+      } else {
+        unsigned t = d;
+        int l;
+        for (l = 0; t > 1; l++)
+          t >>= 1;
+        t = 1 + (1 << (16 + l)) / d;
+        quant_[i] = (int16_t)(t - (1 << 16));
+        quant_shift_[i] = 1 << (16 - l);
+      }
+    }
+  }
+
+  void RunCheck(int max_bits, int large) {
+    ACMRandom rnd(ACMRandom::DeterministicSeed());
+    DECLARE_ALIGNED_ARRAY(16, tran_low_t, coeff, kNumCoeffs);
+    DECLARE_ALIGNED_ARRAY(16, tran_low_t, qcoeff, kNumCoeffs);
+    DECLARE_ALIGNED_ARRAY(16, tran_low_t, dqcoeff, kNumCoeffs);
+    DECLARE_ALIGNED_ARRAY(16, tran_low_t, ref_qcoeff, kNumCoeffs);
+    DECLARE_ALIGNED_ARRAY(16, tran_low_t, ref_dqcoeff, kNumCoeffs);
+
+    for (int i = 0; i < kNumTests; ++i) {
+      const TX_SIZE tx_size = is_32x32_ ? TX_32X32
+          : static_cast<TX_SIZE>(rnd.PseudoUniform(TX_32X32));
+      const scan_order *const so = &vp9_default_scan_orders[tx_size];
+      const int count = 16 << (2 * tx_size);
+      const int mask = (1 << max_bits) - 1;
+      const int zbin_oq_value = is_fp_ ? 0 : rnd.PseudoUniform(16);
+      const int skip_block = i == 0;
+      uint16_t eob, ref_eob;
+
+      SetQuantizer(&rnd, rnd.PseudoUniform(256));
+      // Sparse blocks, so that the end of block varies.
+      for (int j = 0; j < count; ++j) {
+        const int sparse = rnd.PseudoUniform(4) == 0;
+        const int v = (rnd.Rand16() << 15 | rnd.Rand16()) & mask;
+        coeff[j] = sparse ? 0 : (rnd.Rand8() & 1 ? v : -v);
+      }
+      // A single coefficient past the range of the 32 bit lanes.
+      if (large)
+        coeff[rnd.PseudoUniform(count)] = (1 << 24) + rnd.Rand16();
+      memset(qcoeff, 0, sizeof(*qcoeff) * kNumCoeffs);
+      memset(dqcoeff, 0, sizeof(*dqcoeff) * kNumCoeffs);
+
+      ref_quantize_(coeff, count, skip_block, zbin_, round_, quant_,
+                    quant_shift_, ref_qcoeff, ref_dqcoeff, dequant_,
+                    zbin_oq_value, &ref_eob, so->scan, so->iscan);
+      ASM_REGISTER_STATE_CHECK(
+          quantize_(coeff, count, skip_block, zbin_, round_, quant_,
+                    quant_shift_, qcoeff, dqcoeff, dequant_, zbin_oq_value,
+                    &eob, so->scan, so->iscan));
+
+      ASSERT_EQ(ref_eob, eob) << "test " << i;
+      for (int j = 0; j < count; ++j) {
+        ASSERT_EQ(ref_qcoeff[j], qcoeff[j]) << "test " << i << ", coeff " << j;
+        ASSERT_EQ(ref_dqcoeff[j], dqcoeff[j])
+            << "test " << i << ", coeff " << j;
+      }
+    }
+  }
+
+  QuantizeFunc quantize_;
+  QuantizeFunc ref_quantize_;
+  int is_32x32_;
+  int is_fp_;
+  vpx_bit_depth_t bit_depth_;
+  int16_t zbin_[2];
+  int16_t round_[2];
+  int16_t quant_[2];
+  int16_t quant_shift_[2];
+  int16_t dequant_[2];
+};
+
+// The coefficients of the forward transforms of the bit depth.
+TEST_P(VP9QuantizeTest, OperationCheck) {
+  RunCheck(bit_depth_ + 8, 0);
+}
+
+// Coefficients up to 2^24, and one past it, which leaves the block to C.
+TEST_P(VP9QuantizeTest, ExtremeCheck) {
+  RunCheck(24, 1);
+}
+
+using std::tr1::make_tuple;
+
+#if HAVE_SSE2
+INSTANTIATE_TEST_CASE_P(
+    SSE2, VP9QuantizeTest,
+    ::testing::Values(
+        make_tuple(&vp9_high_quantize_b_sse2, &vp9_high_quantize_b_c, 0, 0,
+                   VPX_BITS_8),
+        make_tuple(&vp9_high_quantize_b_sse2, &vp9_high_quantize_b_c, 0, 0,
+                   VPX_BITS_10),
+        make_tuple(&vp9_high_quantize_b_sse2, &vp9_high_quantize_b_c, 0, 0,
+                   VPX_BITS_12),
+        make_tuple(&vp9_high_quantize_b_32x32_sse2,
+                   &vp9_high_quantize_b_32x32_c, 1, 0, VPX_BITS_8),
+        make_tuple(&vp9_high_quantize_b_32x32_sse2,
+                   &vp9_high_quantize_b_32x32_c, 1, 0, VPX_BITS_10),
+        make_tuple(&vp9_high_quantize_b_32x32_sse2,
+                   &vp9_high_quantize_b_32x32_c, 1, 0, VPX_BITS_12),
+        make_tuple(&vp9_high_quantize_fp_sse2, &vp9_high_quantize_fp_c, 0, 1,
+                   VPX_BITS_8),
+        make_tuple(&vp9_high_quantize_fp_sse2, &vp9_high_quantize_fp_c, 0, 1,
+                   VPX_BITS_10),
+        make_tuple(&vp9_high_quantize_fp_sse2, &vp9_high_quantize_fp_c, 0, 1,
+                   VPX_BITS_12),
+        make_tuple(&vp9_high_quantize_fp_32x32_sse2,
+                   &vp9_high_quantize_fp_32x32_c, 1, 1, VPX_BITS_8),
+        make_tuple(&vp9_high_quantize_fp_32x32_sse2,
+                   &vp9_high_quantize_fp_32x32_c, 1, 1, VPX_BITS_10),
+        make_tuple(&vp9_high_quantize_fp_32x32_sse2,
+                   &vp9_high_quantize_fp_32x32_c, 1, 1, VPX_BITS_12)));
+#endif
+
+#if HAVE_AVX2
+INSTANTIATE_TEST_CASE_P(
+    AVX2, VP9QuantizeTest,
+    ::testing::Values(
+        make_tuple(&vp9_high_quantize_b_avx2, &vp9_high_quantize_b_c, 0, 0,
+                   VPX_BITS_8),
+        make_tuple(&vp9_high_quantize_b_avx2, &vp9_high_quantize_b_c, 0, 0,
+                   VPX_BITS_10),
+        make_tuple(&vp9_high_quantize_b_avx2, &vp9_high_quantize_b_c, 0, 0,
+                   VPX_BITS_12),
+        make_tuple(&vp9_high_quantize_b_32x32_avx2,
+                   &vp9_high_quantize_b_32x32_c, 1, 0, VPX_BITS_8),
+        make_tuple(&vp9_high_quantize_b_32x32_avx2,
+                   &vp9_high_quantize_b_32x32_c, 1, 0, VPX_BITS_10),
+        make_tuple(&vp9_high_quantize_b_32x32_avx2,
+                   &vp9_high_quantize_b_32x32_c, 1, 0, VPX_BITS_12),
+        make_tuple(&vp9_high_quantize_fp_avx2, &vp9_high_quantize_fp_c, 0, 1,
+                   VPX_BITS_8),
+        make_tuple(&vp9_high_quantize_fp_avx2, &vp9_high_quantize_fp_c, 0, 1,
+                   VPX_BITS_10),
+        make_tuple(&vp9_high_quantize_fp_avx2, &vp9_high_quantize_fp_c, 0, 1,
+                   VPX_BITS_12),
+        make_tuple(&vp9_high_quantize_fp_32x32_avx2,
+                   &vp9_high_quantize_fp_32x32_c, 1, 1, VPX_BITS_8),
+        make_tuple(&vp9_high_quantize_fp_32x32_avx2,
+                   &vp9_high_quantize_fp_32x32_c, 1, 1, VPX_BITS_10),
+        make_tuple(&vp9_high_quantize_fp_32x32_avx2,
+                   &vp9_high_quantize_fp_32x32_c, 1, 1, VPX_BITS_12)));
+#endif
+#endif  // CONFIG_VP9_HIGHBITDEPTH
+}  // namespace
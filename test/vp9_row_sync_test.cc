@@ -0,0 +1,126 @@
+/*
+ *  Copyright (c) 2014 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <algorithm>
+#include <vector>
+
+#include "third_party/googletest/src/include/gtest/gtest.h"
+#include "./vpx_config.h"
+#include "vp9/common/vp9_onyxc_int.h"
+#include "vp9/common/vp9_row_sync.h"
+#include "vp9/common/vp9_thread.h"
+
+namespace {
+
+#if CONFIG_MULTITHREAD
+const int kNumWorkers = 4;
+const int kSbRows = 24;
+
+struct WavefrontData {
+  VP9RowSync *row_sync;
+  int sb_cols;
+  // Rows are taken from the row queue of 'row_sync' when 'step' is 0.
+  int start;
+  int step;
+  // Per SB completion flags, written by the worker owning the row.
+  volatile int *done;
+  // Number of SBs started before their top-right dependency was complete.
+  int violations;
+};
+
+int WavefrontHook(void *data, void *unused) {
+  WavefrontData *const wd = reinterpret_cast<WavefrontData *>(data);
+  (void)unused;
+  int r = wd->step ? wd->start : vp9_row_sync_next_row(wd->row_sync);
+  while (r < kSbRows) {
+    for (int c = 0; c < wd->sb_cols; ++c) {
+      vp9_row_sync_read(wd->row_sync, r, c);
+      if (r > 0) {
+        const int top_right = c + 1 < wd->sb_cols ? c + 1 : wd->sb_cols - 1;
+        if (!wd->done[(r - 1) * wd->sb_cols + top_right])
+          ++wd->violations;
+      }
+      ++wd->done[r * wd->sb_cols + c];
+      vp9_row_sync_write(wd->row_sync, r, c, wd->sb_cols);
+    }
+    r = wd->step ? r + wd->step : vp9_row_sync_next_row(wd->row_sync);
+  }
+  return 1;
+}
+
+class VP9RowSyncTest : public ::testing::TestWithParam<int> {
+ protected:
+  virtual void SetUp() {
+    cm_ = new VP9_COMMON();
+    vp9_zero(row_sync_);
+  }
+
+  virtual void TearDown() {
+    vp9_row_sync_dealloc(&row_sync_);
+    delete cm_;
+  }
+
+  VP9_COMMON *cm_;
+  VP9RowSync row_sync_;
+};
+
+TEST_P(VP9RowSyncTest, Wavefront) {
+  const int width = GetParam();
+  const int sb_cols = (width + 63) >> 6;
+  const VP9WorkerInterface *const winterface = vp9_get_worker_interface();
+  std::vector<int> done_flags(kSbRows * sb_cols);
+  VP9Worker workers[kNumWorkers];
+  WavefrontData data[kNumWorkers];
+
+  vp9_row_sync_alloc(&row_sync_, cm_, kSbRows, width);
+
+  for (int i = 0; i < kNumWorkers; ++i) {
+    winterface->init(&workers[i]);
+    ASSERT_NE(winterface->reset(&workers[i]), 0);
+  }
+
+  // Alternate static row interleaving and the row queue.
+  for (int pass = 0; pass < 4; ++pass) {
+    std::fill(done_flags.begin(), done_flags.end(), 0);
+    vp9_row_sync_reset(&row_sync_);
+    for (int i = 0; i < kNumWorkers; ++i) {
+      data[i].row_sync = &row_sync_;
+      data[i].sb_cols = sb_cols;
+      data[i].start = i;
+      data[i].step = (pass & 1) ? 0 : kNumWorkers;
+      data[i].done = &done_flags[0];
+      data[i].violations = 0;
+      workers[i].hook = WavefrontHook;
+      workers[i].data1 = &data[i];
+      workers[i].data2 = NULL;
+      winterface->launch(&workers[i]);
+    }
+    for (int i = 0; i < kNumWorkers; ++i) {
+      EXPECT_NE(winterface->sync(&workers[i]), 0);
+      EXPECT_EQ(0, data[i].violations);
+    }
+    for (int i = 0; i < kSbRows * sb_cols; ++i)
+      EXPECT_EQ(1, done_flags[i]);
+  }
+
+  VP9RowSyncStats stats;
+  vp9_row_sync_get_stats(&row_sync_, &stats);
+  EXPECT_LE(stats.waits, stats.stalls);
+
+  for (int i = 0; i < kNumWorkers; ++i)
+    winterface->end(&workers[i]);
+}
+
+// Widths covering all the sync ranges.
+INSTANTIATE_TEST_CASE_P(Synchronization, VP9RowSyncTest,
+                        ::testing::Values(352, 1280, 1920, 4352));
+#endif  // CONFIG_MULTITHREAD
+
+}  // namespace
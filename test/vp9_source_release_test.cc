@@ -0,0 +1,219 @@
+/*
+ *  Copyright (c) 2014 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string.h>
+#include <vector>
+
+#include "third_party/googletest/src/include/gtest/gtest.h"
+#include "./vpx_config.h"
+#include "vpx/vp8cx.h"
+#include "vpx/vpx_encoder.h"
+#include "vpx_mem/vpx_mem.h"
+
+namespace {
+
+const int kWidth = 200;
+const int kHeight = 118;
+const int kFrames = 12;
+const int kLagInFrames = 6;
+// Border of the encoder's frame buffers, the stride of referenced images
+// has to match theirs.
+const int kEncoderBorder = 160;
+
+struct ReleaseData {
+  std::vector<vpx_image_t> *images;
+  std::vector<int> releases;
+  int frames_released;
+};
+
+void ReleaseSource(void *priv, const vpx_image_t *img) {
+  ReleaseData *const data = reinterpret_cast<ReleaseData *>(priv);
+  for (size_t i = 0; i < data->images->size(); ++i) {
+    if ((*data->images)[i].planes[VPX_PLANE_Y] == img->planes[VPX_PLANE_Y]) {
+      ++data->releases[i];
+      ++data->frames_released;
+      return;
+    }
+  }
+  ADD_FAILURE() << "Unknown image released";
+}
+
+class VP9SourceReleaseTest : public ::testing::Test {
+ protected:
+  virtual void TearDown() {
+    for (size_t i = 0; i < buffers_.size(); ++i)
+      vpx_free(buffers_[i]);
+  }
+
+  // Allocate the frames with the layout of frame buffers with 'border' pixels
+  // of border, and fill them with a moving pattern.
+  void AllocFrames(int border) {
+    const int aligned_width = (kWidth + 7) & ~7;
+    const int aligned_height = (kHeight + 7) & ~7;
+    const int y_stride = (aligned_width + 2 * border + 31) & ~31;
+    const int uv_stride = y_stride >> 1;
+    const int y_size = (aligned_height + 2 * border) * y_stride;
+    const int uv_size = (aligned_height / 2 + border) * uv_stride;
+
+    for (int i = 0; i < kFrames; ++i) {
+      uint8_t *const buf = reinterpret_cast<uint8_t *>(
+          vpx_memalign(32, y_size + 2 * uv_size));
+      ASSERT_TRUE(buf != NULL);
+      memset(buf, 0, y_size + 2 * uv_size);
+      buffers_.push_back(buf);
+
+      vpx_image_t img;
+      memset(&img, 0, sizeof(img));
+      img.fmt = VPX_IMG_FMT_I420;
+      img.w = img.d_w = kWidth;
+      img.h = img.d_h = kHeight;
+      img.x_chroma_shift = img.y_chroma_shift = 1;
+      img.bps = 12;
+      img.stride[VPX_PLANE_Y] = y_stride;
+      img.stride[VPX_PLANE_U] = img.stride[VPX_PLANE_V] = uv_stride;
+      img.planes[VPX_PLANE_Y] = buf + border * y_stride + border;
+      img.planes[VPX_PLANE_U] = buf + y_size + (border / 2) * uv_stride +
+                                border / 2;
+      img.planes[VPX_PLANE_V] = img.planes[VPX_PLANE_U] + uv_size;
+
+      for (int r = 0; r < kHeight; ++r) {
+        for (int c = 0; c < kWidth; ++c) {
+          img.planes[VPX_PLANE_Y][r * y_stride + c] =
+              static_cast<uint8_t>(((r + 2 * i) * 3) ^ ((c + 3 * i) * 5));
+        }
+      }
+      for (int r = 0; r < (kHeight + 1) / 2; ++r) {
+        for (int c = 0; c < (kWidth + 1) / 2; ++c) {
+          img.planes[VPX_PLANE_U][r * uv_stride + c] =
+              static_cast<uint8_t>(128 + ((r + c + i) & 31));
+          img.planes[VPX_PLANE_V][r * uv_stride + c] =
+              static_cast<uint8_t>(128 - ((r - c + i) & 31));
+        }
+      }
+      images_.push_back(img);
+    }
+  }
+
+  // Encode all the frames, with a release callback if 'release' is set.
+  // 'copied' tells whether the encoder is expected to copy the frames.
+  // Returns the compressed frames back to back.
+  std::vector<uint8_t> Encode(ReleaseData *release, int border, bool copied) {
+    std::vector<uint8_t> data;
+    vpx_codec_enc_cfg_t cfg;
+    vpx_codec_ctx_t enc;
+
+    EXPECT_EQ(VPX_CODEC_OK,
+              vpx_codec_enc_config_default(&vpx_codec_vp9_cx_algo, &cfg, 0));
+    cfg.g_w = kWidth;
+    cfg.g_h = kHeight;
+    cfg.g_threads = 1;
+    cfg.g_lag_in_frames = kLagInFrames;
+    cfg.rc_target_bitrate = 300;
+    EXPECT_EQ(VPX_CODEC_OK,
+              vpx_codec_enc_init(&enc, &vpx_codec_vp9_cx_algo, &cfg, 0));
+    EXPECT_EQ(VPX_CODEC_OK, vpx_codec_control(&enc, VP8E_SET_CPUUSED, 4));
+    EXPECT_EQ(VPX_CODEC_OK,
+              vpx_codec_control(&enc, VP8E_SET_ENABLEAUTOALTREF, 1));
+    if (release != NULL) {
+      vpx_source_release_cb_t cb = { ReleaseSource, release, border };
+      release->images = &images_;
+      release->releases.assign(kFrames, 0);
+      release->frames_released = 0;
+      EXPECT_EQ(VPX_CODEC_OK,
+                vpx_codec_control(&enc, VP9E_SET_SOURCE_RELEASE_CB, &cb));
+    }
+
+    for (int i = 0; i <= kFrames; ++i) {
+      // Flush once all the frames are in.
+      vpx_image_t *const img = i < kFrames ? &images_[i] : NULL;
+      bool got_data;
+      do {
+        vpx_codec_iter_t iter = NULL;
+        const vpx_codec_cx_pkt_t *pkt;
+        EXPECT_EQ(VPX_CODEC_OK,
+                  vpx_codec_encode(&enc, img, i, 1, 0, VPX_DL_GOOD_QUALITY));
+        got_data = false;
+        while ((pkt = vpx_codec_get_cx_data(&enc, &iter)) != NULL) {
+          if (pkt->kind != VPX_CODEC_CX_FRAME_PKT)
+            continue;
+          const uint8_t *const buf =
+              reinterpret_cast<const uint8_t *>(pkt->data.frame.buf);
+          data.insert(data.end(), buf, buf + pkt->data.frame.sz);
+          got_data = true;
+        }
+      } while (img == NULL && got_data);
+
+      if (release != NULL && img != NULL) {
+        if (copied) {
+          EXPECT_EQ(i + 1, release->frames_released);
+        } else {
+          // Frames are kept as long as the lookahead queue needs them, and
+          // not longer.
+          EXPECT_LT(release->frames_released, i + 1);
+          EXPECT_GE(release->frames_released, i - kLagInFrames - 2);
+        }
+      }
+    }
+
+    EXPECT_EQ(VPX_CODEC_OK, vpx_codec_destroy(&enc));
+    return data;
+  }
+
+  std::vector<uint8_t *> buffers_;
+  std::vector<vpx_image_t> images_;
+};
+
+TEST_F(VP9SourceReleaseTest, ReferencedSourceMatchesCopy) {
+  AllocFrames(kEncoderBorder);
+  const std::vector<uint8_t> copied = Encode(NULL, 0, true);
+  ReleaseData release;
+  const std::vector<uint8_t> referenced =
+      Encode(&release, kEncoderBorder, false);
+
+  ASSERT_FALSE(copied.empty());
+  EXPECT_TRUE(copied == referenced);
+  for (int i = 0; i < kFrames; ++i)
+    EXPECT_EQ(1, release.releases[i]) << "frame " << i;
+}
+
+TEST_F(VP9SourceReleaseTest, IncompatibleSourceIsCopied) {
+  // The strides differ from the encoder's: each frame has to be copied and
+  // released right away.
+  AllocFrames(32);
+  ReleaseData release;
+  Encode(&release, 32, true);
+  for (int i = 0; i < kFrames; ++i)
+    EXPECT_EQ(1, release.releases[i]) << "frame " << i;
+}
+
+TEST_F(VP9SourceReleaseTest, SetAfterFirstFrame) {
+  AllocFrames(kEncoderBorder);
+  vpx_codec_enc_cfg_t cfg;
+  vpx_codec_ctx_t enc;
+  ReleaseData release;
+  vpx_source_release_cb_t cb = { ReleaseSource, &release, kEncoderBorder };
+
+  ASSERT_EQ(VPX_CODEC_OK,
+            vpx_codec_enc_config_default(&vpx_codec_vp9_cx_algo, &cfg, 0));
+  cfg.g_w = kWidth;
+  cfg.g_h = kHeight;
+  ASSERT_EQ(VPX_CODEC_OK,
+            vpx_codec_enc_init(&enc, &vpx_codec_vp9_cx_algo, &cfg, 0));
+  EXPECT_EQ(VPX_CODEC_INVALID_PARAM,
+            vpx_codec_control(&enc, VP9E_SET_SOURCE_RELEASE_CB,
+                              static_cast<vpx_source_release_cb_t *>(NULL)));
+  EXPECT_EQ(VPX_CODEC_OK,
+            vpx_codec_encode(&enc, &images_[0], 0, 1, 0, VPX_DL_REALTIME));
+  EXPECT_EQ(VPX_CODEC_ERROR,
+            vpx_codec_control(&enc, VP9E_SET_SOURCE_RELEASE_CB, &cb));
+  EXPECT_EQ(VPX_CODEC_OK, vpx_codec_destroy(&enc));
+}
+
+}  // namespace
@@ -0,0 +1,89 @@
+/*
+ *  Copyright (c) 2014 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string>
+#include <vector>
+
+#include "third_party/googletest/src/include/gtest/gtest.h"
+#include "test/codec_factory.h"
+#include "test/encode_test_driver.h"
+#include "test/util.h"
+#include "test/video_source.h"
+
+namespace {
+
+const int kFrames = 12;
+
+// The static segmentation analyzes the motion of the lookahead frames of each
+// alt ref group, on the encoding threads when there are several. The frames
+// have to be coded the same whatever the number of threads, which the best
+// quality speed otherwise does.
+class VP9StaticSegmentationTest
+    : public ::libvpx_test::EncoderTest,
+      public ::libvpx_test::CodecTestWithParam<int> {
+ protected:
+  VP9StaticSegmentationTest()
+      : EncoderTest(GET_PARAM(0)), threads_(GET_PARAM(1)),
+        static_segmentation_(1) {}
+  virtual ~VP9StaticSegmentationTest() {}
+
+  virtual void SetUp() {
+    InitializeConfig();
+    SetMode(::libvpx_test::kTwoPassGood);
+    cfg_.rc_end_usage = VPX_VBR;
+    cfg_.rc_target_bitrate = 300;
+  }
+
+  virtual void PreEncodeFrameHook(::libvpx_test::VideoSource *video,
+                                  ::libvpx_test::Encoder *encoder) {
+    if (video->frame() == 0)
+      encoder->Control(VP9E_SET_STATIC_SEGMENTATION, static_segmentation_);
+  }
+
+  virtual void FramePktHook(const vpx_codec_cx_pkt_t *pkt) {
+    frames_.push_back(
+        std::string(static_cast<const char *>(pkt->data.frame.buf),
+                    pkt->data.frame.sz));
+  }
+
+  // The still top half of the frames is the static segment.
+  std::vector<std::string> Encode(unsigned int threads,
+                                  int static_segmentation) {
+    ::libvpx_test::SyntheticVideoSource video;
+    video.SetSize(256, 256);
+    video.set_limit(kFrames);
+    cfg_.g_threads = threads;
+    static_segmentation_ = static_segmentation;
+    frames_.clear();
+    RunLoop(&video);
+    return frames_;
+  }
+
+  const int threads_;
+  int static_segmentation_;
+  std::vector<std::string> frames_;
+};
+
+TEST_P(VP9StaticSegmentationTest, MatchesSingleThread) {
+  const std::vector<std::string> reference = Encode(1, 1);
+
+  ASSERT_FALSE(reference.empty());
+  // The segmentation is used.
+  EXPECT_TRUE(Encode(1, 0) != reference);
+
+  const std::vector<std::string> frames = Encode(threads_, 1);
+  ASSERT_EQ(reference.size(), frames.size());
+  for (size_t i = 0; i < reference.size(); ++i)
+    EXPECT_TRUE(reference[i] == frames[i]) << "frame " << i;
+}
+
+VP9_INSTANTIATE_TEST_CASE(VP9StaticSegmentationTest, ::testing::Values(2, 4));
+
+}  // namespace
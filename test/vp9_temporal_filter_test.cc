@@ -0,0 +1,133 @@
+/*
+ *  Copyright (c) 2014 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "third_party/googletest/src/include/gtest/gtest.h"
+#include "test/acm_random.h"
+#include "test/clear_system_state.h"
+#include "test/register_state_check.h"
+#include "./vpx_config.h"
+#include "./vp9_rtcd.h"
+#include "vpx_ports/mem.h"
+
+typedef void (*TemporalFilterApplyFunc)(uint8_t *frame1, unsigned int stride,
+                                        uint8_t *frame2,
+                                        unsigned int block_width,
+                                        unsigned int block_height,
+                                        int strength, int filter_weight,
+                                        unsigned int *accumulator,
+                                        uint16_t *count);
+
+namespace {
+
+using libvpx_test::ACMRandom;
+
+const int kStride = 48;
+const unsigned int kBlockSizes[][2] = { {16, 16}, {8, 8}, {8, 16}, {16, 8} };
+
+class VP9TemporalFilterTest
+    : public ::testing::TestWithParam<TemporalFilterApplyFunc> {
+ public:
+  virtual void TearDown() {
+    libvpx_test::ClearSystemState();
+  }
+
+ protected:
+  // Fill the source and the predictor. With 'max_diff' below 256 the
+  // predictor stays within 'max_diff' of the source.
+  void FillBlocks(ACMRandom *rnd, unsigned int block_width,
+                  unsigned int block_height, int max_diff) {
+    for (int i = 0; i < 16 * kStride; ++i)
+      src_[i] = rnd->Rand8();
+    for (unsigned int r = 0; r < block_height; ++r) {
+      for (unsigned int c = 0; c < block_width; ++c) {
+        const int src = src_[r * kStride + c];
+        int pred = rnd->Rand8();
+        if (abs(pred - src) > max_diff)
+          pred = src + (rnd->Rand8() % (2 * max_diff + 1)) - max_diff;
+        pred_[r * block_width + c] = static_cast<uint8_t>(
+            pred < 0 ? 0 : pred > 255 ? 255 : pred);
+      }
+    }
+    for (int i = 0; i < 16 * 16; ++i) {
+      accumulator_[i] = rnd->Rand16();
+      count_[i] = rnd->Rand16() & 0xfff;
+    }
+  }
+
+  void CheckMatch(TemporalFilterApplyFunc ref_func, int max_diff) {
+    ACMRandom rnd(ACMRandom::DeterministicSeed());
+    DECLARE_ALIGNED_ARRAY(16, unsigned int, ref_accumulator, 16 * 16);
+    DECLARE_ALIGNED_ARRAY(16, uint16_t, ref_count, 16 * 16);
+
+    for (int n = 0; n < 1000; ++n) {
+      const unsigned int *const size = kBlockSizes[n & 3];
+      const int strength = rnd(7);
+      const int filter_weight = rnd(3);
+
+      FillBlocks(&rnd, size[0], size[1], max_diff);
+      memcpy(ref_accumulator, accumulator_, sizeof(accumulator_));
+      memcpy(ref_count, count_, sizeof(count_));
+
+      ref_func(src_, kStride, pred_, size[0], size[1], strength,
+               filter_weight, ref_accumulator, ref_count);
+      ASM_REGISTER_STATE_CHECK(GetParam()(src_, kStride, pred_, size[0],
+                                          size[1], strength, filter_weight,
+                                          accumulator_, count_));
+
+      for (int i = 0; i < 16 * 16; ++i) {
+        ASSERT_EQ(ref_accumulator[i], accumulator_[i])
+            << size[0] << "x" << size[1] << ", strength " << strength
+            << ", weight " << filter_weight << ", at " << i;
+        ASSERT_EQ(ref_count[i], count_[i])
+            << size[0] << "x" << size[1] << ", strength " << strength
+            << ", weight " << filter_weight << ", at " << i;
+      }
+    }
+  }
+
+  DECLARE_ALIGNED(16, uint8_t, src_[16 * kStride]);
+  DECLARE_ALIGNED(16, uint8_t, pred_[16 * 16]);
+  DECLARE_ALIGNED(16, unsigned int, accumulator_[16 * 16]);
+  DECLARE_ALIGNED(16, uint16_t, count_[16 * 16]);
+};
+
+// The SIMD versions compute the modifiers on 16 bits, they only match the C
+// version while the weighted square of the differences fits.
+TEST_P(VP9TemporalFilterTest, MatchesC) {
+  CheckMatch(vp9_temporal_filter_apply_c, 147);
+}
+
+INSTANTIATE_TEST_CASE_P(C, VP9TemporalFilterTest,
+                        ::testing::Values(vp9_temporal_filter_apply_c));
+
+#if HAVE_SSE2
+INSTANTIATE_TEST_CASE_P(SSE2, VP9TemporalFilterTest,
+                        ::testing::Values(vp9_temporal_filter_apply_sse2));
+#endif
+
+#if HAVE_AVX2
+INSTANTIATE_TEST_CASE_P(AVX2, VP9TemporalFilterTest,
+                        ::testing::Values(vp9_temporal_filter_apply_avx2));
+
+class VP9TemporalFilterAvx2Test : public VP9TemporalFilterTest {};
+
+// For any input the AVX2 version matches the SSE2 one.
+TEST_P(VP9TemporalFilterAvx2Test, MatchesSSE2) {
+  CheckMatch(vp9_temporal_filter_apply_sse2, 255);
+}
+
+INSTANTIATE_TEST_CASE_P(AVX2, VP9TemporalFilterAvx2Test,
+                        ::testing::Values(vp9_temporal_filter_apply_avx2));
+#endif
+
+}  // namespace
@@ -158,19 +158,27 @@ struct FileList {
   const char *expected_md5;
 };
 
-// Decodes |filename| with |num_threads|. Returns the md5 of the decoded frames.
-string DecodeFile(const string& filename, int num_threads) {
+// Decodes |filename| with |num_threads|, in frame parallel mode if
+// |frame_parallel| is set. Returns the md5 of the decoded frames.
+string DecodeFile(const string& filename, int num_threads,
+                  bool frame_parallel) {
   libvpx_test::WebMVideoSource video(filename);
   video.Init();
 
   vpx_codec_dec_cfg_t cfg = vpx_codec_dec_cfg_t();
   cfg.threads = num_threads;
-  libvpx_test::VP9Decoder decoder(cfg, 0);
+  const vpx_codec_flags_t flags =
+      frame_parallel ? VPX_CODEC_USE_FRAME_THREADING : 0;
+  libvpx_test::VP9Decoder decoder(cfg, flags, 0);
 
   libvpx_test::MD5 md5;
-  for (video.Begin(); video.cxdata(); video.Next()) {
+  video.Begin();
+  for (;;) {
+    // Flush the decoder at the end of the file, so the frames still being
+    // decoded in frame parallel mode are output.
+    const uint8_t *const cxdata = video.cxdata();
     const vpx_codec_err_t res =
-        decoder.DecodeFrame(video.cxdata(), video.frame_size());
+        decoder.DecodeFrame(cxdata, cxdata != NULL ? video.frame_size() : 0);
     if (res != VPX_CODEC_OK) {
       EXPECT_EQ(VPX_CODEC_OK, res) << decoder.DecodeError();
       break;
@@ -183,10 +191,18 @@ string DecodeFile(const string& filename, int num_threads) {
     while ((img = dec_iter.Next())) {
       md5.Add(img);
     }
+
+    if (cxdata == NULL)
+      break;
+    video.Next();
   }
   return string(md5.Get());
 }
 
+string DecodeFile(const string& filename, int num_threads) {
+  return DecodeFile(filename, num_threads, false);
+}
+
 void DecodeFiles(const FileList files[]) {
   for (const FileList *iter = files; iter->name != NULL; ++iter) {
     SCOPED_TRACE(iter->name);
@@ -255,6 +271,29 @@ TEST(VP9DecodeMultiThreadedTest, Decode2) {
   DecodeFiles(files);
 }
 
+// Frame parallel decoding must match the serial decoder, whatever the number
+// of frames decoded at once.
+TEST(VP9DecodeMultiThreadedTest, FrameParallel) {
+  static const FileList files[] = {
+    { "vp90-2-03-size-226x226.webm", "b35a1b707b28e82be025d960aba039bc" },
+    { "vp90-2-08-tile_1x2_frame_parallel.webm",
+      "68ede6abd66bae0a2edf2eb9232241b6" },
+    { "vp90-2-08-tile_1x4_frame_parallel.webm",
+      "368ebc6ebf3a5e478d85b2c3149b2848" },
+    { "vp90-2-14-resize-fp-tiles-16-8-4-2-1.webm",
+      "eecf17290739bc708506fa4827665989" },
+    { NULL, NULL }
+  };
+
+  for (const FileList *iter = files; iter->name != NULL; ++iter) {
+    SCOPED_TRACE(iter->name);
+    for (int t = 2; t <= 8; ++t) {
+      EXPECT_EQ(iter->expected_md5, DecodeFile(iter->name, t, true))
+          << "threads = " << t;
+    }
+  }
+}
+
 // Test tile quantity changes within one file.
 TEST(VP9DecodeMultiThreadedTest, Decode3) {
   static const FileList files[] = {
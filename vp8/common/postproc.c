@@ -268,7 +268,6 @@ void vp8_mbpost_proc_across_ip_c(unsigned char *src, int pitch, int rows, int co
 void vp8_mbpost_proc_down_c(unsigned char *dst, int pitch, int rows, int cols, int flimit)
 {
     int r, c, i;
-    const short *rv3 = &vp8_rv[63&rand()];
 
     for (c = 0; c < cols; c++ )
     {
@@ -276,7 +275,10 @@ void vp8_mbpost_proc_down_c(unsigned char *dst, int pitch, int rows, int cols, i
         int sumsq = 0;
         int sum   = 0;
         unsigned char d[16];
-        const short *rv2 = rv3 + ((c * 17) & 127);
+        /* The same rounding noise as the SSE2 version, a function of the
+         * position only, so that column strips can be filtered in any order.
+         */
+        const short *rv2 = vp8_rv + (c & 7);
 
         for (i = -8; i < 0; i++)
           s[i*pitch]=s[0];
@@ -311,13 +313,59 @@ void vp8_mbpost_proc_down_c(unsigned char *dst, int pitch, int rows, int cols, i
 }
 
 #if CONFIG_POSTPROC
-static void vp8_de_mblock(YV12_BUFFER_CONFIG         *post,
-                          int                         q)
+static void deblock_mb_rows(VP8_COMMON                 *cm,
+                            YV12_BUFFER_CONFIG         *source,
+                            YV12_BUFFER_CONFIG         *post,
+                            int                         ppl,
+                            unsigned char              *limits,
+                            int                         start_mb_row,
+                            int                         end_mb_row)
 {
-    vp8_mbpost_proc_across_ip(post->y_buffer, post->y_stride, post->y_height,
-                              post->y_width, q2mbl(q));
-    vp8_mbpost_proc_down(post->y_buffer, post->y_stride, post->y_height,
-                         post->y_width, q2mbl(q));
+    const MODE_INFO *mode_info_context = cm->show_frame_mi +
+                                         start_mb_row * cm->mode_info_stride;
+    int mbr, mbc;
+
+    /* The pixel thresholds are adjusted according to if or not the macroblock
+     * is a skipped block.  */
+    unsigned char *ylimits = limits;
+    unsigned char *uvlimits = limits + 16 * cm->mb_cols;
+
+    for (mbr = start_mb_row; mbr < end_mb_row; mbr++)
+    {
+        unsigned char *ylptr = ylimits;
+        unsigned char *uvlptr = uvlimits;
+        for (mbc = 0; mbc < cm->mb_cols; mbc++)
+        {
+            unsigned char mb_ppl;
+
+            if (mode_info_context->mbmi.mb_skip_coeff)
+                mb_ppl = (unsigned char)ppl >> 1;
+            else
+                mb_ppl = (unsigned char)ppl;
+
+            vpx_memset(ylptr, mb_ppl, 16);
+            vpx_memset(uvlptr, mb_ppl, 8);
+
+            ylptr += 16;
+            uvlptr += 8;
+            mode_info_context++;
+        }
+        mode_info_context++;
+
+        vp8_post_proc_down_and_across_mb_row(
+            source->y_buffer + 16 * mbr * source->y_stride,
+            post->y_buffer + 16 * mbr * post->y_stride, source->y_stride,
+            post->y_stride, source->y_width, ylimits, 16);
+
+        vp8_post_proc_down_and_across_mb_row(
+            source->u_buffer + 8 * mbr * source->uv_stride,
+            post->u_buffer + 8 * mbr * post->uv_stride, source->uv_stride,
+            post->uv_stride, source->uv_width, uvlimits, 8);
+        vp8_post_proc_down_and_across_mb_row(
+            source->v_buffer + 8 * mbr * source->uv_stride,
+            post->v_buffer + 8 * mbr * post->uv_stride, source->uv_stride,
+            post->uv_stride, source->uv_width, uvlimits, 8);
+    }
 }
 
 void vp8_deblock(VP8_COMMON                 *cm,
@@ -329,58 +377,130 @@ void vp8_deblock(VP8_COMMON                 *cm,
 {
     double level = 6.0e-05 * q * q * q - .0067 * q * q + .306 * q + .0065;
     int ppl = (int)(level + .5);
-
-    const MODE_INFO *mode_info_context = cm->show_frame_mi;
-    int mbr, mbc;
-
-    /* The pixel thresholds are adjusted according to if or not the macroblock
-     * is a skipped block.  */
-    unsigned char *ylimits = cm->pp_limits_buffer;
-    unsigned char *uvlimits = cm->pp_limits_buffer + 16 * cm->mb_cols;
     (void) low_var_thresh;
     (void) flag;
 
     if (ppl > 0)
     {
-        for (mbr = 0; mbr < cm->mb_rows; mbr++)
-        {
-            unsigned char *ylptr = ylimits;
-            unsigned char *uvlptr = uvlimits;
-            for (mbc = 0; mbc < cm->mb_cols; mbc++)
-            {
-                unsigned char mb_ppl;
+        deblock_mb_rows(cm, source, post, ppl, cm->pp_limits_buffer,
+                        0, cm->mb_rows);
+    } else
+    {
+        vp8_yv12_copy_frame(source, post);
+    }
+}
 
-                if (mode_info_context->mbmi.mb_skip_coeff)
-                    mb_ppl = (unsigned char)ppl >> 1;
-                else
-                    mb_ppl = (unsigned char)ppl;
+static void copy_plane_rows(const unsigned char *src, int src_stride,
+                            unsigned char *dst, int dst_stride, int width,
+                            int height, int start, int end, int extend)
+{
+    int r;
 
-                vpx_memset(ylptr, mb_ppl, 16);
-                vpx_memset(uvlptr, mb_ppl, 8);
+    for (r = start; r < end; r++)
+        vpx_memcpy(dst + r * dst_stride, src + r * src_stride, width);
 
-                ylptr += 16;
-                uvlptr += 8;
-                mode_info_context++;
-            }
-            mode_info_context++;
+    if (extend && start == 0)
+    {
+        for (r = -2; r < 0; r++)
+            vpx_memcpy(dst + r * dst_stride, dst, width);
+    }
 
-            vp8_post_proc_down_and_across_mb_row(
-                source->y_buffer + 16 * mbr * source->y_stride,
-                post->y_buffer + 16 * mbr * post->y_stride, source->y_stride,
-                post->y_stride, source->y_width, ylimits, 16);
-
-            vp8_post_proc_down_and_across_mb_row(
-                source->u_buffer + 8 * mbr * source->uv_stride,
-                post->u_buffer + 8 * mbr * post->uv_stride, source->uv_stride,
-                post->uv_stride, source->uv_width, uvlimits, 8);
-            vp8_post_proc_down_and_across_mb_row(
-                source->v_buffer + 8 * mbr * source->uv_stride,
-                post->v_buffer + 8 * mbr * post->uv_stride, source->uv_stride,
-                post->uv_stride, source->uv_width, uvlimits, 8);
-        }
-    } else
+    if (extend && end == height)
     {
-        vp8_yv12_copy_frame(source, post);
+        for (r = height; r < height + 2; r++)
+            vpx_memcpy(dst + r * dst_stride, dst + (height - 1) * dst_stride,
+                       width);
+    }
+}
+
+/* Copies the MB rows [start_mb_row, end_mb_row) of 'src' to 'dst'. With
+ * 'extend' the two rows above and below the frame, which the deblock reads,
+ * are extended.
+ */
+static void copy_mb_rows(const YV12_BUFFER_CONFIG *src,
+                         YV12_BUFFER_CONFIG *dst, int mb_rows,
+                         int start_mb_row, int end_mb_row, int extend)
+{
+    copy_plane_rows(src->y_buffer, src->y_stride, dst->y_buffer,
+                    dst->y_stride, src->y_width, 16 * mb_rows,
+                    16 * start_mb_row, 16 * end_mb_row, extend);
+    copy_plane_rows(src->u_buffer, src->uv_stride, dst->u_buffer,
+                    dst->uv_stride, src->uv_width, 8 * mb_rows,
+                    8 * start_mb_row, 8 * end_mb_row, extend);
+    copy_plane_rows(src->v_buffer, src->uv_stride, dst->v_buffer,
+                    dst->uv_stride, src->uv_width, 8 * mb_rows,
+                    8 * start_mb_row, 8 * end_mb_row, extend);
+}
+
+void vp8_post_proc_band(VP8_COMMON *oci, int stage, int band, int num_bands,
+                        unsigned char *limits)
+{
+    struct postproc_state *const state = &oci->postproc_state;
+    YV12_BUFFER_CONFIG *const post = &oci->post_proc_buffer;
+    const int start_mb_row = band * oci->mb_rows / num_bands;
+    const int end_mb_row = (band + 1) * oci->mb_rows / num_bands;
+    const int q = state->deblock_q;
+
+    if (stage == VP8_PP_DEMACROBLOCK_DOWN)
+    {
+        /* The vertical filter runs down whole columns, the strips are MB
+         * columns. The noise it adds repeats every 8 columns.
+         */
+        const int strips = (post->y_width + 15) >> 4;
+        const int start_col = (band * strips / num_bands) << 4;
+        const int end_col = MIN(((band + 1) * strips / num_bands) << 4,
+                                post->y_width);
+
+        if (end_col > start_col)
+            vp8_mbpost_proc_down(post->y_buffer + start_col, post->y_stride,
+                                 post->y_height, end_col - start_col,
+                                 q2mbl(q));
+        return;
+    }
+
+    if (start_mb_row == end_mb_row)
+        return;
+
+    switch (stage)
+    {
+    case VP8_PP_MFQE:
+        vp8_multiframe_quality_enhance(oci, start_mb_row, end_mb_row);
+
+        /* The deblock reads the enhanced frame from a copy */
+        if (state->source == &oci->post_proc_buffer_int)
+            copy_mb_rows(post, &oci->post_proc_buffer_int, oci->mb_rows,
+                         start_mb_row, end_mb_row, 1);
+        break;
+    case VP8_PP_COPY:
+        copy_mb_rows(oci->frame_to_show, post, oci->mb_rows,
+                     start_mb_row, end_mb_row, 0);
+        break;
+    case VP8_PP_DEBLOCK:
+    {
+        double level = 6.0e-05 * q * q * q - .0067 * q * q + .306 * q + .0065;
+        int ppl = (int)(level + .5);
+
+        if (ppl > 0)
+            deblock_mb_rows(oci, state->source, post, ppl, limits,
+                            start_mb_row, end_mb_row);
+        else
+            copy_mb_rows(state->source, post, oci->mb_rows,
+                         start_mb_row, end_mb_row, 0);
+        break;
+    }
+    case VP8_PP_DEMACROBLOCK_ACROSS:
+        vp8_mbpost_proc_across_ip(
+            post->y_buffer + 16 * start_mb_row * post->y_stride,
+            post->y_stride, 16 * (end_mb_row - start_mb_row), post->y_width,
+            q2mbl(q));
+        break;
+    case VP8_PP_ADDNOISE:
+        vp8_plane_add_noise(
+            post->y_buffer + 16 * start_mb_row * post->y_stride,
+            state->noise, state->blackclamp, state->whiteclamp,
+            state->bothclamp, post->y_width,
+            16 * (end_mb_row - start_mb_row), post->y_stride);
+        break;
     }
 }
 #endif
@@ -716,8 +836,25 @@ static void constrain_line (int x_0, int *x_1, int y_0, int *y_1, int width, int
 }
 
 #if CONFIG_POSTPROC
+static void run_stage(VP8_COMMON *oci, int stage, vp8_pp_stage_fn run_bands,
+                      void *arg)
+{
+    if (run_bands)
+        run_bands(arg, oci, stage);
+    else
+        vp8_post_proc_band(oci, stage, 0, 1, oci->pp_limits_buffer);
+}
+
 int vp8_post_proc_frame(VP8_COMMON *oci, YV12_BUFFER_CONFIG *dest, vp8_ppflags_t *ppflags)
 {
+    return vp8_post_proc_frame_mt(oci, dest, ppflags, NULL, NULL);
+}
+
+int vp8_post_proc_frame_mt(VP8_COMMON *oci, YV12_BUFFER_CONFIG *dest,
+                           vp8_ppflags_t *ppflags, vp8_pp_stage_fn run_bands,
+                           void *arg)
+{
+    struct postproc_state *const state = &oci->postproc_state;
     int q = oci->filter_level * 10 / 6;
     int flags = ppflags->post_proc_flag;
     int deblock_level = ppflags->deblocking_level;
@@ -767,50 +904,50 @@ int vp8_post_proc_frame(VP8_COMMON *oci, YV12_BUFFER_CONFIG *dest, vp8_ppflags_t
 
     vp8_clear_system_state();
 
+    if (flags & VP8D_DEMACROBLOCK)
+        state->deblock_q = q + (deblock_level - 5) * 10;
+    else
+        state->deblock_q = q;
+
     if ((flags & VP8D_MFQE) &&
          oci->postproc_state.last_frame_valid &&
          oci->current_video_frame >= 2 &&
          oci->postproc_state.last_base_qindex < 60 &&
          oci->base_qindex - oci->postproc_state.last_base_qindex >= 20)
     {
-        vp8_multiframe_quality_enhance(oci);
+        state->source = NULL;
         if (((flags & VP8D_DEBLOCK) || (flags & VP8D_DEMACROBLOCK)) &&
             oci->post_proc_buffer_int_used)
+            state->source = &oci->post_proc_buffer_int;
+
+        run_stage(oci, VP8_PP_MFQE, run_bands, arg);
+        if (state->source)
         {
-            vp8_yv12_copy_frame(&oci->post_proc_buffer, &oci->post_proc_buffer_int);
+            run_stage(oci, VP8_PP_DEBLOCK, run_bands, arg);
             if (flags & VP8D_DEMACROBLOCK)
             {
-                vp8_deblock(oci, &oci->post_proc_buffer_int, &oci->post_proc_buffer,
-                                               q + (deblock_level - 5) * 10, 1, 0);
-                vp8_de_mblock(&oci->post_proc_buffer,
-                              q + (deblock_level - 5) * 10);
-            }
-            else if (flags & VP8D_DEBLOCK)
-            {
-                vp8_deblock(oci, &oci->post_proc_buffer_int, &oci->post_proc_buffer,
-                            q, 1, 0);
+                run_stage(oci, VP8_PP_DEMACROBLOCK_ACROSS, run_bands, arg);
+                run_stage(oci, VP8_PP_DEMACROBLOCK_DOWN, run_bands, arg);
             }
         }
         /* Move partially towards the base q of the previous frame */
         oci->postproc_state.last_base_qindex = (3*oci->postproc_state.last_base_qindex + oci->base_qindex)>>2;
     }
-    else if (flags & VP8D_DEMACROBLOCK)
+    else if ((flags & VP8D_DEMACROBLOCK) || (flags & VP8D_DEBLOCK))
     {
-        vp8_deblock(oci, oci->frame_to_show, &oci->post_proc_buffer,
-                                     q + (deblock_level - 5) * 10, 1, 0);
-        vp8_de_mblock(&oci->post_proc_buffer, q + (deblock_level - 5) * 10);
+        state->source = oci->frame_to_show;
+        run_stage(oci, VP8_PP_DEBLOCK, run_bands, arg);
+        if (flags & VP8D_DEMACROBLOCK)
+        {
+            run_stage(oci, VP8_PP_DEMACROBLOCK_ACROSS, run_bands, arg);
+            run_stage(oci, VP8_PP_DEMACROBLOCK_DOWN, run_bands, arg);
+        }
 
         oci->postproc_state.last_base_qindex = oci->base_qindex;
     }
-    else if (flags & VP8D_DEBLOCK)
-    {
-        vp8_deblock(oci, oci->frame_to_show, &oci->post_proc_buffer,
-                    q, 1, 0);
-        oci->postproc_state.last_base_qindex = oci->base_qindex;
-    }
     else
     {
-        vp8_yv12_copy_frame(oci->frame_to_show, &oci->post_proc_buffer);
+        run_stage(oci, VP8_PP_COPY, run_bands, arg);
         oci->postproc_state.last_base_qindex = oci->base_qindex;
     }
     oci->postproc_state.last_frame_valid = 1;
@@ -823,14 +960,11 @@ int vp8_post_proc_frame(VP8_COMMON *oci, YV12_BUFFER_CONFIG *dest, vp8_ppflags_t
             fillrd(&oci->postproc_state, 63 - q, noise_level);
         }
 
-        vp8_plane_add_noise
-        (oci->post_proc_buffer.y_buffer,
-         oci->postproc_state.noise,
-         oci->postproc_state.blackclamp,
-         oci->postproc_state.whiteclamp,
-         oci->postproc_state.bothclamp,
-         oci->post_proc_buffer.y_width, oci->post_proc_buffer.y_height,
-         oci->post_proc_buffer.y_stride);
+        /* The noise of each row starts at a rand() offset. The rows are done
+         * by this thread in order, so that they get the same offsets with or
+         * without threads.
+         */
+        vp8_post_proc_band(oci, VP8_PP_ADDNOISE, 0, 1, oci->pp_limits_buffer);
     }
 
 #if CONFIG_POSTPROC_VISUALIZER
@@ -23,6 +23,11 @@ struct postproc_state
     DECLARE_ALIGNED(16, char, blackclamp[16]);
     DECLARE_ALIGNED(16, char, whiteclamp[16]);
     DECLARE_ALIGNED(16, char, bothclamp[16]);
+
+    /* The frame deblocked into the post_proc_buffer and the q of the
+     * deblock and demacroblock stages, see vp8_post_proc_band(). */
+    struct yv12_buffer_config *source;
+    int           deblock_q;
 };
 #include "onyxc_int.h"
 #include "ppflags.h"
@@ -33,6 +38,38 @@ extern "C" {
 int vp8_post_proc_frame(struct VP8Common *oci, YV12_BUFFER_CONFIG *dest,
                         vp8_ppflags_t *flags);
 
+/* The stages of vp8_post_proc_frame() which are split in bands of MB rows,
+ * or column strips for the vertical demacroblock filter. All the bands of a
+ * stage are done before the next one starts. Add noise is always run as a
+ * single band by vp8_post_proc_frame_mt(), as it draws from rand().
+ */
+enum
+{
+    VP8_PP_MFQE,
+    VP8_PP_COPY,
+    VP8_PP_DEBLOCK,
+    VP8_PP_DEMACROBLOCK_ACROSS,
+    VP8_PP_DEMACROBLOCK_DOWN,
+    VP8_PP_ADDNOISE
+};
+
+/* Runs all the bands of 'stage' with vp8_post_proc_band(), returning when
+ * they are done.
+ */
+typedef void (*vp8_pp_stage_fn)(void *arg, struct VP8Common *oci, int stage);
+
+/* vp8_post_proc_frame() with the stages run by 'run_stage'. */
+int vp8_post_proc_frame_mt(struct VP8Common *oci, YV12_BUFFER_CONFIG *dest,
+                           vp8_ppflags_t *flags, vp8_pp_stage_fn run_stage,
+                           void *arg);
+
+/* Runs the band 'band' of 'num_bands' of 'stage'. 'limits' holds the
+ * deblock thresholds of a MB row, 24 * mb_cols bytes not shared with the
+ * other bands.
+ */
+void vp8_post_proc_band(struct VP8Common *oci, int stage, int band,
+                        int num_bands, unsigned char *limits);
+
 
 void vp8_de_noise(struct VP8Common           *oci,
                   YV12_BUFFER_CONFIG         *source,
@@ -50,7 +87,8 @@ void vp8_deblock(struct VP8Common           *oci,
 
 #define MFQE_PRECISION 4
 
-void vp8_multiframe_quality_enhance(struct VP8Common *cm);
+void vp8_multiframe_quality_enhance(struct VP8Common *cm, int start_mb_row,
+                                    int end_mb_row);
 #ifdef __cplusplus
 }  // extern "C"
 #endif
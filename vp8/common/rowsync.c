@@ -0,0 +1,169 @@
+/*
+ *  Copyright (c) 2014 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+
+#include "vpx_config.h"
+#include "vpx_mem/vpx_mem.h"
+#include "rowsync.h"
+
+/* Bounds of the pause iterations a reader spins for before it blocks. The
+ * upper one is roughly the time it takes to encode a few MBs, so a row
+ * about to catch up does not cost a context switch, while a reader on an
+ * oversubscribed system does not burn the time slice the writer needs.
+ */
+#define ROW_SYNC_MIN_SPINS 16
+#define ROW_SYNC_MAX_SPINS 2048
+
+int vp8_row_sync_alloc(VP8_ROW_SYNC *sync, int rows, int sync_range)
+{
+    int i;
+
+    vpx_memset(sync, 0, sizeof(*sync));
+
+    sync->current_mb_col = vpx_malloc(sizeof(*sync->current_mb_col) * rows);
+    sync->waiting = vpx_calloc(rows, sizeof(*sync->waiting));
+    sync->row_event = vpx_malloc(sizeof(*sync->row_event) * rows);
+    sync->max_spins = vpx_malloc(sizeof(*sync->max_spins) * rows);
+    sync->stats = vpx_calloc(rows, sizeof(*sync->stats));
+
+    if (!sync->current_mb_col || !sync->waiting || !sync->row_event ||
+        !sync->max_spins || !sync->stats)
+    {
+        vp8_row_sync_dealloc(sync);
+        return 1;
+    }
+
+    for (i = 0; i < rows; i++)
+    {
+        sem_init(&sync->row_event[i], 0, 0);
+        sync->max_spins[i] = ROW_SYNC_MAX_SPINS;
+    }
+
+    sync->rows = rows;
+    sync->sync_range = sync_range;
+    vp8_row_sync_reset(sync);
+    return 0;
+}
+
+void vp8_row_sync_dealloc(VP8_ROW_SYNC *sync)
+{
+    int i;
+
+    for (i = 0; i < sync->rows; i++)
+        sem_destroy(&sync->row_event[i]);
+
+    vpx_free(sync->current_mb_col);
+    vpx_free(sync->waiting);
+    vpx_free(sync->row_event);
+    vpx_free(sync->max_spins);
+    vpx_free(sync->stats);
+    vpx_memset(sync, 0, sizeof(*sync));
+}
+
+void vp8_row_sync_reset(VP8_ROW_SYNC *sync)
+{
+    int i;
+
+    for (i = 0; i < sync->rows; i++)
+        vpx_atomic_init(&sync->current_mb_col[i], -1);
+}
+
+void vp8_row_sync_read(VP8_ROW_SYNC *sync, int r, int c)
+{
+    const int nsync = sync->sync_range;
+    const vpx_atomic_int *above;
+    VP8_ROW_SYNC_STATS *stats;
+    int max_spins, i;
+
+    if (!r || (c & (nsync - 1)))
+        return;
+
+    above = &sync->current_mb_col[r - 1];
+    if (vpx_atomic_load_acquire(above) >= c + nsync)
+        return;
+
+    stats = &sync->stats[r];
+    max_spins = sync->max_spins[r];
+    ++stats->stalls;
+
+    for (i = 1; i <= max_spins; i++)
+    {
+        x86_pause_hint();
+        if (vpx_atomic_load_acquire(above) >= c + nsync)
+        {
+            stats->spins += i;
+
+            /* Spinning paid off, allow longer spins again */
+            if (max_spins < ROW_SYNC_MAX_SPINS)
+                sync->max_spins[r] = max_spins << 1;
+            return;
+        }
+    }
+    stats->spins += max_spins;
+
+    if (max_spins > ROW_SYNC_MIN_SPINS)
+        sync->max_spins[r] = max_spins >> 1;
+
+    /* Announce the waiter before checking the row again: either the writer
+     * sees the announcement and posts, or this thread sees the progress. A
+     * post which arrives once the row caught up is only a spurious wake up
+     * for a later read.
+     */
+    vpx_atomic_store_release(&sync->waiting[r - 1], 1);
+    vpx_atomic_memory_barrier();
+    if (vpx_atomic_load_acquire(above) < c + nsync)
+    {
+        ++stats->waits;
+        do
+        {
+            sem_wait(&sync->row_event[r - 1]);
+            vpx_atomic_store_release(&sync->waiting[r - 1], 1);
+            vpx_atomic_memory_barrier();
+        } while (vpx_atomic_load_acquire(above) < c + nsync);
+    }
+    vpx_atomic_store_release(&sync->waiting[r - 1], 0);
+}
+
+static void publish(VP8_ROW_SYNC *sync, int r, int c)
+{
+    vpx_atomic_store_release(&sync->current_mb_col[r], c);
+    vpx_atomic_memory_barrier();
+    if (vpx_atomic_load_acquire(&sync->waiting[r]))
+    {
+        vpx_atomic_store_release(&sync->waiting[r], 0);
+        sem_post(&sync->row_event[r]);
+    }
+}
+
+void vp8_row_sync_write(VP8_ROW_SYNC *sync, int r, int c)
+{
+    /* The row below only reads the progress at multiples of sync_range */
+    if (c >= 0 && !(c & (sync->sync_range - 1)))
+        publish(sync, r, c);
+}
+
+void vp8_row_sync_write_row(VP8_ROW_SYNC *sync, int r, int mb_cols)
+{
+    publish(sync, r, mb_cols + sync->sync_range);
+}
+
+void vp8_row_sync_get_stats(const VP8_ROW_SYNC *sync,
+                            VP8_ROW_SYNC_STATS *stats)
+{
+    int i;
+
+    vpx_memset(stats, 0, sizeof(*stats));
+    for (i = 0; i < sync->rows; i++)
+    {
+        stats->stalls += sync->stats[i].stalls;
+        stats->spins += sync->stats[i].spins;
+        stats->waits += sync->stats[i].waits;
+    }
+}
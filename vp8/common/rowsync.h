@@ -0,0 +1,76 @@
+/*
+ *  Copyright (c) 2014 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+
+#ifndef VP8_COMMON_ROWSYNC_H_
+#define VP8_COMMON_ROWSYNC_H_
+
+#include "vpx_config.h"
+#include "vpx_ports/vpx_atomics.h"
+#include "vp8/common/threading.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct
+{
+    unsigned int stalls;    /* reads which found the row above behind */
+    unsigned int spins;     /* pause iterations spent spinning on it */
+    unsigned int waits;     /* reads which blocked after spinning */
+} VP8_ROW_SYNC_STATS;
+
+/* Synchronizes the MB rows of a frame: MB 'c' of row 'r' is processed once
+ * the MBs up to 'c + sync_range' of row 'r - 1' are complete.
+ *
+ * The progress of a row is published with release stores and polled with
+ * acquire loads. A reader spins on it for a while, then blocks on the
+ * semaphore of the row until its writer posts it. How long a reader spins
+ * adapts to whether spinning paid off on the previous reads of the row.
+ * Each row has one writer and one reader, the thread on the row below.
+ */
+typedef struct
+{
+    vpx_atomic_int *current_mb_col;     /* last complete MB of each row */
+    vpx_atomic_int *waiting;            /* set while the row below blocks */
+    sem_t *row_event;
+    int *max_spins;                     /* spin budget of each row's reader */
+    VP8_ROW_SYNC_STATS *stats;          /* updated by each row's reader */
+    int rows;
+    int sync_range;
+} VP8_ROW_SYNC;
+
+/* Allocates the sync of 'rows' MB rows, returns 0 on success. 'sync_range'
+ * has to be a power of 2.
+ */
+int vp8_row_sync_alloc(VP8_ROW_SYNC *sync, int rows, int sync_range);
+void vp8_row_sync_dealloc(VP8_ROW_SYNC *sync);
+
+/* Marks all rows as not started, while no thread uses 'sync'. */
+void vp8_row_sync_reset(VP8_ROW_SYNC *sync);
+
+/* Waits until MB 'c' of row 'r' can be processed. */
+void vp8_row_sync_read(VP8_ROW_SYNC *sync, int r, int c);
+
+/* Publishes the completion of MB 'c' of row 'r'. */
+void vp8_row_sync_write(VP8_ROW_SYNC *sync, int r, int c);
+
+/* Publishes the completion of row 'r', unblocking all of the row below. */
+void vp8_row_sync_write_row(VP8_ROW_SYNC *sync, int r, int mb_cols);
+
+/* Sum of the counters of all the rows since vp8_row_sync_alloc(). */
+void vp8_row_sync_get_stats(const VP8_ROW_SYNC *sync,
+                            VP8_ROW_SYNC_STATS *stats);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // VP8_COMMON_ROWSYNC_H_
@@ -21,6 +21,16 @@ void vp8_decoder_remove_threads(VP8D_COMP *pbi);
 void vp8_decoder_create_threads(VP8D_COMP *pbi);
 void vp8mt_alloc_temp_buffers(VP8D_COMP *pbi, int width, int prev_mb_rows);
 void vp8mt_de_alloc_temp_buffers(VP8D_COMP *pbi, int mb_rows);
+/* Contention of the MB row synchronization since the decoder was created. */
+void vp8mt_get_row_sync_stats(const VP8D_COMP *pbi,
+                              vpx_row_sync_stats_t *stats);
+#if CONFIG_POSTPROC
+/* vp8_post_proc_frame() with each stage split in bands over the decoding
+ * threads.
+ */
+int vp8mt_post_proc_frame(VP8D_COMP *pbi, YV12_BUFFER_CONFIG *sd,
+                          vp8_ppflags_t *flags);
+#endif
 #endif
 
 #ifdef __cplusplus
@@ -405,7 +405,12 @@ int vp8dx_get_raw_frame(VP8D_COMP *pbi, YV12_BUFFER_CONFIG *sd, int64_t *time_st
     *time_end_stamp = 0;
 
 #if CONFIG_POSTPROC
-    ret = vp8_post_proc_frame(&pbi->common, sd, flags);
+#if CONFIG_MULTITHREAD
+    if (pbi->b_multithreaded_rd)
+        ret = vp8mt_post_proc_frame(pbi, sd, flags);
+    else
+#endif
+        ret = vp8_post_proc_frame(&pbi->common, sd, flags);
 #else
 
     if (pbi->common.frame_to_show)
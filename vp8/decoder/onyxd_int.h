@@ -17,6 +17,10 @@
 #include "treereader.h"
 #include "vp8/common/onyxc_int.h"
 #include "vp8/common/threading.h"
+#if CONFIG_MULTITHREAD
+#include "vp8/common/rowsync.h"
+#include "vpx/vp8dx.h"
+#endif
 
 #if CONFIG_ERROR_CONCEALMENT
 #include "ec_types.h"
@@ -88,8 +92,8 @@ typedef struct VP8D_COMP
     int allocated_decoding_thread_count;
 
     int mt_baseline_filter_level[MAX_MB_SEGMENTS];
-    int sync_range;
-    int *mt_current_mb_col;                  /* Each row remembers its already decoded column. */
+    VP8_ROW_SYNC row_sync;                   /* Each row publishes its already decoded column. */
+    vpx_row_sync_stats_t row_sync_totals;    /* Counts of the row syncs freed on size changes. */
 
     unsigned char **mt_yabove_row;           /* mb_rows x width */
     unsigned char **mt_uabove_row;
@@ -98,6 +102,11 @@ typedef struct VP8D_COMP
     unsigned char **mt_uleft_col;            /* mb_rows x 8 */
     unsigned char **mt_vleft_col;            /* mb_rows x 8 */
 
+#if CONFIG_POSTPROC
+    int mt_pp_stage;                         /* Postproc stage the threads run, -1 when decoding. */
+    unsigned char **mt_pp_limits;            /* decoding_thread_count x deblock limits */
+#endif
+
     MB_ROW_DEC           *mb_row_di;
     DECODETHREAD_DATA    *de_thread_data;
 
@@ -25,6 +25,9 @@
 #include "vp8/common/reconintra4x4.h"
 #include "vp8/common/reconinter.h"
 #include "vp8/common/setupintrarecon.h"
+#if CONFIG_POSTPROC
+#include "vp8/common/postproc.h"
+#endif
 #if CONFIG_ERROR_CONCEALMENT
 #include "error_concealment.h"
 #endif
@@ -85,8 +88,7 @@ static void setup_decoding_thread_data(VP8D_COMP *pbi, MACROBLOCKD *xd, MB_ROW_D
 
     }
 
-    for (i = 0; i < pc->mb_rows; i++)
-        pbi->mt_current_mb_col[i] = -1;
+    vp8_row_sync_reset(&pbi->row_sync);
 }
 
 static void mt_decode_macroblock(VP8D_COMP *pbi, MACROBLOCKD *xd,
@@ -295,14 +297,10 @@ static void mt_decode_macroblock(VP8D_COMP *pbi, MACROBLOCKD *xd,
 
 static void mt_decode_mb_rows(VP8D_COMP *pbi, MACROBLOCKD *xd, int start_mb_row)
 {
-    volatile const int *last_row_current_mb_col;
-    volatile int *current_mb_col;
+    VP8_ROW_SYNC *const row_sync = &pbi->row_sync;
     int mb_row;
     VP8_COMMON *pc = &pbi->common;
-    const int nsync = pbi->sync_range;
-    const int first_row_no_sync_above = pc->mb_cols + nsync;
     int num_part = 1 << pbi->common.multi_token_partition;
-    int last_mb_row = start_mb_row;
 
     YV12_BUFFER_CONFIG *yv12_fb_new = pbi->dec_fb_ref[INTRA_FRAME];
     YV12_BUFFER_CONFIG *yv12_fb_lst = pbi->dec_fb_ref[LAST_FRAME];
@@ -341,18 +339,9 @@ static void mt_decode_mb_rows(VP8D_COMP *pbi, MACROBLOCKD *xd, int start_mb_row)
        int filter_level;
        loop_filter_info_n *lfi_n = &pc->lf_info;
 
-       /* save last row processed by this thread */
-       last_mb_row = mb_row;
        /* select bool coder for current partition */
        xd->current_bc =  &pbi->mbc[mb_row%num_part];
 
-       if (mb_row > 0)
-           last_row_current_mb_col = &pbi->mt_current_mb_col[mb_row -1];
-       else
-           last_row_current_mb_col = &first_row_no_sync_above;
-
-       current_mb_col = &pbi->mt_current_mb_col[mb_row];
-
        recon_yoffset = mb_row * recon_y_stride * 16;
        recon_uvoffset = mb_row * recon_uv_stride * 8;
 
@@ -404,16 +393,8 @@ static void mt_decode_mb_rows(VP8D_COMP *pbi, MACROBLOCKD *xd, int start_mb_row)
 
        for (mb_col = 0; mb_col < pc->mb_cols; mb_col++)
        {
-           *current_mb_col = mb_col - 1;
-
-           if ((mb_col & (nsync - 1)) == 0)
-           {
-               while (mb_col > (*last_row_current_mb_col - nsync))
-               {
-                   x86_pause_hint();
-                   thread_sleep(0);
-               }
-           }
+           vp8_row_sync_write(row_sync, mb_row, mb_col - 1);
+           vp8_row_sync_read(row_sync, mb_row, mb_col);
 
            /* Distance of MB to the various image edges.
             * These are specified to 8th pel as they are always
@@ -601,7 +582,7 @@ static void mt_decode_mb_rows(VP8D_COMP *pbi, MACROBLOCKD *xd, int start_mb_row)
                              xd->dst.u_buffer + 8, xd->dst.v_buffer + 8);
 
        /* last MB of row is ready just after extension is done */
-       *current_mb_col = mb_col + nsync;
+       vp8_row_sync_write_row(row_sync, mb_row, pc->mb_cols);
 
        ++xd->mode_info_context;      /* skip prediction column */
        xd->up_available = 1;
@@ -609,11 +590,6 @@ static void mt_decode_mb_rows(VP8D_COMP *pbi, MACROBLOCKD *xd, int start_mb_row)
        /* since we have multithread */
        xd->mode_info_context += xd->mode_info_stride * pbi->decoding_thread_count;
     }
-
-    /* signal end of frame decoding if this thread processed the last mb_row */
-    if (last_mb_row == (pc->mb_rows - 1))
-        sem_post(&pbi->h_event_end_decoding);
-
 }
 
 
@@ -633,12 +609,26 @@ static THREAD_FUNCTION thread_decoding_proc(void *p_data)
         {
             if (pbi->b_multithreaded_rd == 0)
                 break;
+#if CONFIG_POSTPROC
+            else if (pbi->mt_pp_stage >= 0)
+            {
+                vp8_post_proc_band(&pbi->common, pbi->mt_pp_stage, ithread + 1,
+                                   pbi->decoding_thread_count + 1,
+                                   pbi->mt_pp_limits[ithread]);
+                sem_post(&pbi->h_event_end_decoding);
+            }
+#endif
             else
             {
                 MACROBLOCKD *xd = &mbrd->mbd;
                 xd->left_context = &mb_row_left_context;
 
                 mt_decode_mb_rows(pbi, xd, ithread+1);
+
+                /* Signal the end of the rows of this thread, its MB_ROW_DEC
+                 * is set up again for the next frame once all of them are.
+                 */
+                sem_post(&pbi->h_event_end_decoding);
             }
         }
     }
@@ -666,6 +656,9 @@ void vp8_decoder_create_threads(VP8D_COMP *pbi)
     {
         pbi->b_multithreaded_rd = 1;
         pbi->decoding_thread_count = core_count - 1;
+#if CONFIG_POSTPROC
+        pbi->mt_pp_stage = -1;
+#endif
 
         CALLOC_ARRAY(pbi->h_decoding_thread, pbi->decoding_thread_count);
         CALLOC_ARRAY(pbi->h_event_start_decoding, pbi->decoding_thread_count);
@@ -692,14 +685,28 @@ void vp8_decoder_create_threads(VP8D_COMP *pbi)
 }
 
 
+void vp8mt_get_row_sync_stats(const VP8D_COMP *pbi,
+                              vpx_row_sync_stats_t *stats)
+{
+    VP8_ROW_SYNC_STATS row_stats;
+
+    vp8_row_sync_get_stats(&pbi->row_sync, &row_stats);
+    stats->stalls = pbi->row_sync_totals.stalls + row_stats.stalls;
+    stats->spins = pbi->row_sync_totals.spins + row_stats.spins;
+    stats->waits = pbi->row_sync_totals.waits + row_stats.waits;
+    stats->sync_range = pbi->row_sync.sync_range;
+}
+
+
 void vp8mt_de_alloc_temp_buffers(VP8D_COMP *pbi, int mb_rows)
 {
     int i;
 
     if (pbi->b_multithreaded_rd)
     {
-            vpx_free(pbi->mt_current_mb_col);
-            pbi->mt_current_mb_col = NULL ;
+        /* Keep the counts of the frame size being left. */
+        vp8mt_get_row_sync_stats(pbi, &pbi->row_sync_totals);
+        vp8_row_sync_dealloc(&pbi->row_sync);
 
         /* Free above_row buffers. */
         if (pbi->mt_yabove_row)
@@ -768,6 +775,19 @@ void vp8mt_de_alloc_temp_buffers(VP8D_COMP *pbi, int mb_rows)
             vpx_free(pbi->mt_vleft_col);
             pbi->mt_vleft_col = NULL ;
         }
+
+#if CONFIG_POSTPROC
+        if (pbi->mt_pp_limits)
+        {
+            for (i=0; i< (int)pbi->decoding_thread_count; i++)
+            {
+                    vpx_free(pbi->mt_pp_limits[i]);
+                    pbi->mt_pp_limits[i] = NULL ;
+            }
+            vpx_free(pbi->mt_pp_limits);
+            pbi->mt_pp_limits = NULL ;
+        }
+#endif
     }
 }
 
@@ -777,6 +797,7 @@ void vp8mt_alloc_temp_buffers(VP8D_COMP *pbi, int width, int prev_mb_rows)
     VP8_COMMON *const pc = & pbi->common;
     int i;
     int uv_width;
+    int sync_range;
 
     if (pbi->b_multithreaded_rd)
     {
@@ -786,15 +807,17 @@ void vp8mt_alloc_temp_buffers(VP8D_COMP *pbi, int width, int prev_mb_rows)
         if ((width & 0xf) != 0)
             width += 16 - (width & 0xf);
 
-        if (width < 640) pbi->sync_range = 1;
-        else if (width <= 1280) pbi->sync_range = 8;
-        else if (width <= 2560) pbi->sync_range =16;
-        else pbi->sync_range = 32;
+        if (width < 640) sync_range = 1;
+        else if (width <= 1280) sync_range = 8;
+        else if (width <= 2560) sync_range =16;
+        else sync_range = 32;
 
         uv_width = width >>1;
 
-        /* Allocate an int for each mb row. */
-        CALLOC_ARRAY(pbi->mt_current_mb_col, pc->mb_rows);
+        /* Allocate the progress of each mb row. */
+        if (vp8_row_sync_alloc(&pbi->row_sync, pc->mb_rows, sync_range))
+            vpx_internal_error(&pc->error, VPX_CODEC_MEM_ERROR,
+                               "Failed to allocate row sync");
 
         /* Allocate memory for above_row buffers. */
         CALLOC_ARRAY(pbi->mt_yabove_row, pc->mb_rows);
@@ -821,6 +844,13 @@ void vp8mt_alloc_temp_buffers(VP8D_COMP *pbi, int width, int prev_mb_rows)
         CALLOC_ARRAY(pbi->mt_vleft_col, pc->mb_rows);
         for (i = 0; i < pc->mb_rows; i++)
             CHECK_MEM_ERROR(pbi->mt_vleft_col[i], vpx_calloc(sizeof(unsigned char) * 8, 1));
+
+#if CONFIG_POSTPROC
+        /* Allocate the deblock limits of each thread, as pp_limits_buffer. */
+        CALLOC_ARRAY(pbi->mt_pp_limits, pbi->decoding_thread_count);
+        for (i = 0; i < (int)pbi->decoding_thread_count; i++)
+            CHECK_MEM_ERROR(pbi->mt_pp_limits[i], vpx_memalign(16, 24 * ((pc->mb_cols + 1) & ~1)));
+#endif
     }
 }
 
@@ -906,5 +936,35 @@ void vp8mt_decode_mb_rows( VP8D_COMP *pbi, MACROBLOCKD *xd)
 
     mt_decode_mb_rows(pbi, xd, 0);
 
-    sem_wait(&pbi->h_event_end_decoding);   /* add back for each frame */
+    for (i = 0; i < pbi->decoding_thread_count; i++)
+        sem_wait(&pbi->h_event_end_decoding);   /* add back for each frame */
 }
+
+#if CONFIG_POSTPROC
+static void mt_post_proc_stage(void *arg, VP8_COMMON *oci, int stage)
+{
+    VP8D_COMP *pbi = (VP8D_COMP *)arg;
+    unsigned int i;
+
+    pbi->mt_pp_stage = stage;
+
+    for (i = 0; i < pbi->decoding_thread_count; i++)
+        sem_post(&pbi->h_event_start_decoding[i]);
+
+    vp8_post_proc_band(oci, stage, 0, pbi->decoding_thread_count + 1,
+                       oci->pp_limits_buffer);
+
+    /* every thread signals the end of its band */
+    for (i = 0; i < pbi->decoding_thread_count; i++)
+        sem_wait(&pbi->h_event_end_decoding);
+
+    pbi->mt_pp_stage = -1;
+}
+
+int vp8mt_post_proc_frame(VP8D_COMP *pbi, YV12_BUFFER_CONFIG *sd,
+                          vp8_ppflags_t *flags)
+{
+    return vp8_post_proc_frame_mt(&pbi->common, sd, flags, mt_post_proc_stage,
+                                  pbi);
+}
+#endif
@@ -406,6 +406,82 @@ static void pack_tokens_into_partitions_c(VP8_COMP *cpi, unsigned char *cx_data,
     }
 }
 
+#if CONFIG_MULTITHREAD
+int vp8_pack_token_partitions(VP8_COMP *cpi, int first, int step)
+{
+    const int num_part = 1 << cpi->common.multi_token_partition;
+    struct vpx_internal_error_info error;
+    int i;
+
+    /* A partition overflowing its buffer ends up here. */
+    if (setjmp(error.jmp))
+        return 0;
+
+    error.setjmp = 1;
+
+    for (i = first; i < num_part; i += step)
+    {
+        vp8_writer *const w = cpi->bc + i + 1;
+        int mb_row;
+
+        w->error = &error;
+
+        for (mb_row = i; mb_row < cpi->common.mb_rows; mb_row += num_part)
+        {
+            const TOKENEXTRA *p    = cpi->tplist[mb_row].start;
+            const TOKENEXTRA *stop = cpi->tplist[mb_row].stop;
+            int tokens = (int)(stop - p);
+
+            pack_tokens(w, p, tokens);
+        }
+
+        vp8_stop_encode(w);
+    }
+
+    return 1;
+}
+
+#if !(CONFIG_REALTIME_ONLY & CONFIG_ONTHEFLY_BITPACKING)
+extern int vp8cx_pack_token_partitions_mt(VP8_COMP *cpi);
+
+/* Pack the partitions on the encoding threads, each to its own slice of the
+ * buffer, and move them together. Returns 0 if one did not fit its slice.
+ */
+static int pack_tokens_into_partitions_mt(VP8_COMP *cpi,
+                                          unsigned char *cx_data,
+                                          unsigned char *cx_data_end,
+                                          int num_part)
+{
+    const size_t slice = (cx_data_end - cx_data) / num_part;
+    unsigned char *ptr = cx_data;
+    int i, ok;
+
+    for (i = 0; i < num_part; i++)
+    {
+        vp8_start_encode(cpi->bc + i + 1, cx_data + i * slice,
+                         cx_data + (i + 1) * slice);
+    }
+
+    ok = vp8cx_pack_token_partitions_mt(cpi);
+
+    for (i = 0; i < num_part; i++)
+    {
+        vp8_writer *const w = cpi->bc + i + 1;
+
+        w->error = &cpi->common.error;
+
+        if (ok)
+        {
+            vpx_memmove(ptr, w->buffer, w->pos);
+            ptr += w->pos;
+        }
+    }
+
+    return ok;
+}
+#endif
+#endif
+
 
 static void pack_mb_row_tokens_c(VP8_COMP *cpi, vp8_writer *w)
 {
@@ -1650,8 +1726,16 @@ void vp8_pack_bitstream(VP8_COMP *cpi, unsigned char *dest, unsigned char * dest
             cpi->bc[i].error = &pc->error;
         }
 
-        pack_tokens_into_partitions(cpi, cx_data + 3 * (num_part - 1),
-                                    cx_data_end, num_part);
+#if CONFIG_MULTITHREAD
+        /* Fall back to packing on this thread if a partition was larger than
+         * its share of the buffer.
+         */
+        if (!cpi->b_multi_threaded ||
+            !pack_tokens_into_partitions_mt(cpi, cx_data + 3 * (num_part - 1),
+                                            cx_data_end, num_part))
+#endif
+            pack_tokens_into_partitions(cpi, cx_data + 3 * (num_part - 1),
+                                        cx_data_end, num_part);
 
         for(i = 1; i < num_part; i++)
         {
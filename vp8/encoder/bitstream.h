@@ -47,6 +47,13 @@ void vp8_pack_tokens_c(vp8_writer *w, const TOKENEXTRA *p, int xcount);
 # define pack_mb_row_tokens(a,b)               pack_mb_row_tokens_c(a,b)
 #endif
 
+#if CONFIG_MULTITHREAD
+/* Pack the token partitions 'first', 'first' + 'step', ... with the bool
+ * coders started on their buffers. Returns 0 if a buffer was too small.
+ */
+int vp8_pack_token_partitions(VP8_COMP *cpi, int first, int step);
+#endif
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
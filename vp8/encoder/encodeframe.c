@@ -381,18 +381,6 @@ void encode_mb_row(VP8_COMP *cpi,
     vp8_writer *w;
 #endif
 
-#if CONFIG_MULTITHREAD
-    const int nsync = cpi->mt_sync_range;
-    const int rightmost_col = cm->mb_cols + nsync;
-    volatile const int *last_row_current_mb_col;
-    volatile int *current_mb_col = &cpi->mt_current_mb_col[mb_row];
-
-    if ((cpi->b_multi_threaded != 0) && (mb_row != 0))
-        last_row_current_mb_col = &cpi->mt_current_mb_col[mb_row - 1];
-    else
-        last_row_current_mb_col = &rightmost_col;
-#endif
-
 #if (CONFIG_REALTIME_ONLY & CONFIG_ONTHEFLY_BITPACKING)
     if(num_part > 1)
         w= &cpi->bc[1 + (mb_row % num_part)];
@@ -461,16 +449,9 @@ void encode_mb_row(VP8_COMP *cpi,
 #if CONFIG_MULTITHREAD
         if (cpi->b_multi_threaded != 0)
         {
-            *current_mb_col = mb_col - 1; /* set previous MB done */
-
-            if ((mb_col & (nsync - 1)) == 0)
-            {
-                while (mb_col > (*last_row_current_mb_col - nsync))
-                {
-                    x86_pause_hint();
-                    thread_sleep(0);
-                }
-            }
+            /* set previous MB done */
+            vp8_row_sync_write(&cpi->row_sync, mb_row, mb_col - 1);
+            vp8_row_sync_read(&cpi->row_sync, mb_row, mb_col);
         }
 #endif
 
@@ -608,7 +589,7 @@ void encode_mb_row(VP8_COMP *cpi,
 
 #if CONFIG_MULTITHREAD
     if (cpi->b_multi_threaded != 0)
-        *current_mb_col = rightmost_col;
+        vp8_row_sync_write_row(&cpi->row_sync, mb_row, cm->mb_cols);
 #endif
 
     /* this is to account for the border */
@@ -821,8 +802,7 @@ void vp8_encode_frame(VP8_COMP *cpi)
             vp8cx_init_mbrthread_data(cpi, x, cpi->mb_row_ei,
                                       cpi->encoding_thread_count);
 
-            for (i = 0; i < cm->mb_rows; i++)
-                cpi->mt_current_mb_col[i] = -1;
+            vp8_row_sync_reset(&cpi->row_sync);
 
             for (i = 0; i < cpi->encoding_thread_count; i++)
             {
@@ -849,14 +829,11 @@ void vp8_encode_frame(VP8_COMP *cpi)
                 xd->mode_info_context += xd->mode_info_stride * cpi->encoding_thread_count;
                 x->partition_info  += xd->mode_info_stride * cpi->encoding_thread_count;
                 x->gf_active_ptr   += cm->mb_cols * cpi->encoding_thread_count;
-
-                if(mb_row == cm->mb_rows - 1)
-                {
-                    sem_post(&cpi->h_event_end_encoding); /* signal frame encoding end */
-                }
             }
 
-            sem_wait(&cpi->h_event_end_encoding); /* wait for other threads to finish */
+            /* wait for other threads to finish */
+            for (i = 0; i < cpi->encoding_thread_count; i++)
+                sem_wait(&cpi->h_event_end_encoding);
 
             for (mb_row = 0; mb_row < cm->mb_rows; mb_row ++)
             {
@@ -60,7 +60,7 @@ THREAD_FUNCTION thread_encoding_proc(void *p_data)
 
         if (sem_wait(&cpi->h_event_start_encoding[ithread]) == 0)
         {
-            const int nsync = cpi->mt_sync_range;
+            VP8_ROW_SYNC *const row_sync = &cpi->row_sync;
             VP8_COMMON *cm = &cpi->common;
             int mb_row;
             MACROBLOCK *x = &mbri->mb;
@@ -77,6 +77,14 @@ THREAD_FUNCTION thread_encoding_proc(void *p_data)
             if (cpi->b_multi_threaded == 0) /* we're shutting down */
                 break;
 
+            if (cpi->b_pack_tokens)
+            {
+                mbri->tokens_packed = vp8_pack_token_partitions(
+                    cpi, ithread + 1, cpi->encoding_thread_count + 1);
+                sem_post(&cpi->h_event_end_encoding);
+                continue;
+            }
+
             for (mb_row = ithread + 1; mb_row < cm->mb_rows; mb_row += (cpi->encoding_thread_count + 1))
             {
 
@@ -87,8 +95,6 @@ THREAD_FUNCTION thread_encoding_proc(void *p_data)
                 int recon_y_stride = cm->yv12_fb[ref_fb_idx].y_stride;
                 int recon_uv_stride = cm->yv12_fb[ref_fb_idx].uv_stride;
                 int map_index = (mb_row * cm->mb_cols);
-                volatile const int *last_row_current_mb_col;
-                volatile int *current_mb_col = &cpi->mt_current_mb_col[mb_row];
 
 #if  (CONFIG_REALTIME_ONLY & CONFIG_ONTHEFLY_BITPACKING)
                 vp8_writer *w = &cpi->bc[1 + (mb_row % num_part)];
@@ -97,8 +103,6 @@ THREAD_FUNCTION thread_encoding_proc(void *p_data)
                 cpi->tplist[mb_row].start = tp;
 #endif
 
-                last_row_current_mb_col = &cpi->mt_current_mb_col[mb_row - 1];
-
                 /* reset above block coeffs */
                 xd->above_context = cm->above_context;
                 xd->left_context = &mb_row_left_context;
@@ -115,16 +119,8 @@ THREAD_FUNCTION thread_encoding_proc(void *p_data)
                 /* for each macroblock col in image */
                 for (mb_col = 0; mb_col < cm->mb_cols; mb_col++)
                 {
-                    *current_mb_col = mb_col - 1;
-
-                    if ((mb_col & (nsync - 1)) == 0)
-                    {
-                        while (mb_col > (*last_row_current_mb_col - nsync))
-                        {
-                            x86_pause_hint();
-                            thread_sleep(0);
-                        }
-                    }
+                    vp8_row_sync_write(row_sync, mb_row, mb_col - 1);
+                    vp8_row_sync_read(row_sync, mb_row, mb_col);
 
 #if CONFIG_REALTIME_ONLY & CONFIG_ONTHEFLY_BITPACKING
                     tp = tp_start;
@@ -294,7 +290,7 @@ THREAD_FUNCTION thread_encoding_proc(void *p_data)
                                     xd->dst.u_buffer + 8,
                                     xd->dst.v_buffer + 8);
 
-                *current_mb_col = mb_col + nsync;
+                vp8_row_sync_write_row(row_sync, mb_row, cm->mb_cols);
 
                 /* this is to account for the border */
                 xd->mode_info_context++;
@@ -307,12 +303,12 @@ THREAD_FUNCTION thread_encoding_proc(void *p_data)
                 xd->mode_info_context += xd->mode_info_stride * cpi->encoding_thread_count;
                 x->partition_info += xd->mode_info_stride * cpi->encoding_thread_count;
                 x->gf_active_ptr   += cm->mb_cols * cpi->encoding_thread_count;
-
-                if (mb_row == cm->mb_rows - 1)
-                {
-                    sem_post(&cpi->h_event_end_encoding); /* signal frame encoding end */
-                }
             }
+
+            /* Signal the end of the rows of this thread, its MB_ROW_COMP is
+             * set up again for the next frame once all of them are.
+             */
+            sem_post(&cpi->h_event_end_encoding);
         }
     }
 
@@ -509,6 +505,34 @@ void vp8cx_init_mbrthread_data(VP8_COMP *cpi,
     }
 }
 
+/* Pack the token partitions of the frame, those of each thread being the
+ * ones with the index of the thread modulo the thread count. Returns 0 if
+ * one did not fit its buffer.
+ */
+int vp8cx_pack_token_partitions_mt(VP8_COMP *cpi)
+{
+    const int num_part = 1 << cpi->common.multi_token_partition;
+    const int thread_count = MIN(cpi->encoding_thread_count, num_part - 1);
+    int ok, i;
+
+    cpi->b_pack_tokens = 1;
+
+    for (i = 0; i < thread_count; i++)
+        sem_post(&cpi->h_event_start_encoding[i]);
+
+    ok = vp8_pack_token_partitions(cpi, 0, cpi->encoding_thread_count + 1);
+
+    for (i = 0; i < thread_count; i++)
+        sem_wait(&cpi->h_event_end_encoding);
+
+    cpi->b_pack_tokens = 0;
+
+    for (i = 0; i < thread_count; i++)
+        ok &= cpi->mb_row_ei[i].tokens_packed;
+
+    return ok;
+}
+
 int vp8cx_create_encoder_threads(VP8_COMP *cpi)
 {
     const VP8_COMMON * cm = &cpi->common;
@@ -516,6 +540,7 @@ int vp8cx_create_encoder_threads(VP8_COMP *cpi)
     cpi->b_multi_threaded = 0;
     cpi->encoding_thread_count = 0;
     cpi->b_lpf_running = 0;
+    cpi->b_pack_tokens = 0;
 
     if (cm->processor_core_count > 1 && cpi->oxcf.multi_threaded > 1)
     {
@@ -529,9 +554,9 @@ int vp8cx_create_encoder_threads(VP8_COMP *cpi)
 
         /* we have th_count + 1 (main) threads processing one row each */
         /* no point to have more threads than the sync range allows */
-        if(th_count > ((cm->mb_cols / cpi->mt_sync_range) - 1))
+        if(th_count > ((cm->mb_cols / cpi->row_sync.sync_range) - 1))
         {
-            th_count = (cm->mb_cols / cpi->mt_sync_range) - 1;
+            th_count = (cm->mb_cols / cpi->row_sync.sync_range) - 1;
         }
 
         if(th_count == 0)
@@ -483,8 +483,7 @@ static void dealloc_compressor_data(VP8_COMP *cpi)
     cpi->mb.pip = 0;
 
 #if CONFIG_MULTITHREAD
-    vpx_free(cpi->mt_current_mb_col);
-    cpi->mt_current_mb_col = NULL;
+    vp8_row_sync_dealloc(&cpi->row_sync);
 #endif
 }
 
@@ -1259,20 +1258,23 @@ void vp8_alloc_compressor_data(VP8_COMP *cpi)
     vpx_memset(cpi->active_map , 1, (cm->mb_rows * cm->mb_cols));
 
 #if CONFIG_MULTITHREAD
-    if (width < 640)
-        cpi->mt_sync_range = 1;
-    else if (width <= 1280)
-        cpi->mt_sync_range = 4;
-    else if (width <= 2560)
-        cpi->mt_sync_range = 8;
-    else
-        cpi->mt_sync_range = 16;
-
-    if (cpi->oxcf.multi_threaded > 1)
     {
-        vpx_free(cpi->mt_current_mb_col);
-        CHECK_MEM_ERROR(cpi->mt_current_mb_col,
-                    vpx_malloc(sizeof(*cpi->mt_current_mb_col) * cm->mb_rows));
+        int sync_range;
+
+        if (width < 640)
+            sync_range = 1;
+        else if (width <= 1280)
+            sync_range = 4;
+        else if (width <= 2560)
+            sync_range = 8;
+        else
+            sync_range = 16;
+
+        vp8_row_sync_dealloc(&cpi->row_sync);
+        if (cpi->oxcf.multi_threaded > 1 &&
+            vp8_row_sync_alloc(&cpi->row_sync, cm->mb_rows, sync_range))
+            vpx_internal_error(&cm->error, VPX_CODEC_MEM_ERROR,
+                               "Failed to allocate row sync");
     }
 
 #endif
@@ -2298,6 +2300,18 @@ void vp8_remove_compressor(VP8_COMP **ptr)
                 }
             }
 
+#if CONFIG_MULTITHREAD
+            if (cpi->b_multi_threaded)
+            {
+                VP8_ROW_SYNC_STATS sync_stats;
+
+                vp8_row_sync_get_stats(&cpi->row_sync, &sync_stats);
+                fprintf(f, "SyncRng\t Stalls\t    Spins\t  Waits\n");
+                fprintf(f, "%7d\t%7u\t%9u\t%7u\n", cpi->row_sync.sync_range,
+                        sync_stats.stalls, sync_stats.spins, sync_stats.waits);
+            }
+#endif
+
             fclose(f);
 #if 0
             f = fopen("qskip.stt", "a");
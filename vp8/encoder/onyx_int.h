@@ -23,6 +23,9 @@
 #include "quantize.h"
 #include "vp8/common/entropy.h"
 #include "vp8/common/threading.h"
+#if CONFIG_MULTITHREAD
+#include "vp8/common/rowsync.h"
+#endif
 #include "vpx_ports/mem.h"
 #include "vpx/internal/vpx_codec_internal.h"
 #include "vpx/vp8.h"
@@ -200,6 +203,8 @@ typedef struct
     MACROBLOCK  mb;
     int segment_counts[MAX_MB_SEGMENTS];
     int totalrate;
+    /* Whether the token partitions given to the thread fit their buffers */
+    int tokens_packed;
 } MB_ROW_COMP;
 
 typedef struct
@@ -520,11 +525,12 @@ typedef struct VP8_COMP
 
 #if CONFIG_MULTITHREAD
     /* multithread data */
-    int * mt_current_mb_col;
-    int mt_sync_range;
+    VP8_ROW_SYNC row_sync;
     int b_multi_threaded;
     int encoding_thread_count;
     int b_lpf_running;
+    /* The encoding threads are woken up to pack token partitions */
+    int b_pack_tokens;
 
     pthread_t *h_encoding_thread;
     pthread_t h_filter_thread;
@@ -51,6 +51,8 @@ VP8_COMMON_SRCS-yes += common/setupintrarecon.h
 VP8_COMMON_SRCS-yes += common/swapyv12buffer.h
 VP8_COMMON_SRCS-yes += common/systemdependent.h
 VP8_COMMON_SRCS-yes += common/threading.h
+VP8_COMMON_SRCS-$(CONFIG_MULTITHREAD) += common/rowsync.h
+VP8_COMMON_SRCS-$(CONFIG_MULTITHREAD) += common/rowsync.c
 VP8_COMMON_SRCS-yes += common/treecoder.h
 VP8_COMMON_SRCS-yes += common/loopfilter.c
 VP8_COMMON_SRCS-yes += common/loopfilter_filters.c
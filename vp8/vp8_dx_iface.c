@@ -781,6 +781,29 @@ static vpx_codec_err_t vp8_set_decryptor(vpx_codec_alg_priv_t *ctx,
     return VPX_CODEC_OK;
 }
 
+static vpx_codec_err_t vp8_get_row_sync_stats(vpx_codec_alg_priv_t *ctx,
+                                              va_list args)
+{
+    vpx_row_sync_stats_t *stats = va_arg(args, vpx_row_sync_stats_t *);
+
+    if (stats && !ctx->yv12_frame_buffers.use_frame_threads)
+    {
+#if CONFIG_MULTITHREAD
+        VP8D_COMP *pbi = (VP8D_COMP *)ctx->yv12_frame_buffers.pbi[0];
+
+        if (pbi)
+            vp8mt_get_row_sync_stats(pbi, stats);
+        else
+            vpx_memset(stats, 0, sizeof(*stats));
+#else
+        vpx_memset(stats, 0, sizeof(*stats));
+#endif
+        return VPX_CODEC_OK;
+    }
+    else
+        return VPX_CODEC_INVALID_PARAM;
+}
+
 vpx_codec_ctrl_fn_map_t vp8_ctf_maps[] =
 {
     {VP8_SET_REFERENCE,             vp8_set_reference},
@@ -794,6 +817,7 @@ vpx_codec_ctrl_fn_map_t vp8_ctf_maps[] =
     {VP8D_GET_FRAME_CORRUPTED,      vp8_get_frame_corrupted},
     {VP8D_GET_LAST_REF_USED,        vp8_get_last_ref_frame},
     {VPXD_SET_DECRYPTOR,            vp8_set_decryptor},
+    {VP8D_GET_ROW_SYNC_STATS,       vp8_get_row_sync_stats},
     { -1, NULL},
 };
 
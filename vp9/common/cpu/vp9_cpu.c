@@ -0,0 +1,59 @@
+/*
+ *  Copyright (c) 2014 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <assert.h>
+
+#include "vpx_mem/vpx_mem.h"
+
+#include "vp9/common/cpu/vp9_cpu.h"
+
+// The CPU compute backend works directly on host memory, so frame buffers are
+// plain aligned allocations that never need to be mapped or unmapped.
+static void *vp9_cpu_alloc_frame_buffers(VP9_COMMON *cm, int frame_size,
+                                         void **gpu_mem) {
+  (void)cm;
+  *gpu_mem = NULL;
+  return vpx_memalign(32, frame_size);
+}
+
+static void vp9_cpu_release_frame_buffers(VP9_COMMON *cm, void **gpu_mem,
+                                          void **mapped_pointer) {
+  (void)cm;
+  (void)gpu_mem;
+  vpx_free(*mapped_pointer);
+  *mapped_pointer = NULL;
+}
+
+static void vp9_cpu_acquire_frame_buffers(VP9_COMMON *cm, void **gpu_mem,
+                                          void **mapped_pointer, int size) {
+  (void)cm;
+  (void)gpu_mem;
+  (void)mapped_pointer;
+  (void)size;
+  // Host memory is never unmapped.
+  assert(*mapped_pointer != NULL);
+}
+
+static void vp9_cpu_remove(VP9_COMMON *cm) {
+  (void)cm;
+}
+
+int vp9_cpu_init(VP9_COMMON *cm) {
+  VP9_GPU *gpu = &cm->gpu;
+
+  gpu->compute_framework = NULL;
+
+  gpu->alloc_frame_buffers = vp9_cpu_alloc_frame_buffers;
+  gpu->release_frame_buffers = vp9_cpu_release_frame_buffers;
+  gpu->acquire_frame_buffers = vp9_cpu_acquire_frame_buffers;
+  gpu->remove = vp9_cpu_remove;
+
+  return 0;
+}
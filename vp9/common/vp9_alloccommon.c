@@ -107,7 +107,7 @@ static void free_mi(VP9_COMMON *cm) {
 void vp9_free_ref_frame_buffers(VP9_COMMON *cm) {
   int i;
 
-  for (i = 0; i < FRAME_BUFFERS; ++i) {
+  for (i = 0; cm->frame_bufs != NULL && i < FRAME_BUFFERS; ++i) {
 #if CONFIG_GPU_COMPUTE
     if (cm->use_gpu)
       vp9_gpu_free_frame_buffer(cm, &cm->frame_bufs[i].buf);
@@ -249,6 +249,9 @@ void vp9_remove_common(VP9_COMMON *cm) {
   vp9_free_ref_frame_buffers(cm);
   vp9_free_context_buffers(cm);
   vp9_free_internal_frame_buffers(&cm->int_frame_buffers);
+
+  vpx_free(cm->frame_bufs);
+  cm->frame_bufs = NULL;
 }
 
 void vp9_init_context_buffers(VP9_COMMON *cm) {
@@ -12,6 +12,7 @@
 
 #include "./vpx_config.h"
 #include "vpx/vpx_integer.h"
+#include "vp9/common/vp9_filter.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -23,6 +24,20 @@ typedef void (*convolve_fn_t)(const uint8_t *src, ptrdiff_t src_stride,
                               const int16_t *filter_y, int y_step_q4,
                               int w, int h);
 
+// The filter tables of the convolve functions are passed as the kernel of the
+// first output pixel, from which the table and the subpixel position of that
+// pixel are recovered.
+static INLINE const InterpKernel *get_filter_base(const int16_t *filter) {
+  // NOTE: This assumes that the filter table is 256-byte aligned.
+  // TODO(agrange) Modify to make independent of table alignment.
+  return (const InterpKernel *)(((intptr_t)filter) & ~((intptr_t)0xFF));
+}
+
+static INLINE int get_filter_offset(const int16_t *f,
+                                    const InterpKernel *base) {
+  return (int)((const InterpKernel *)(intptr_t)f - base);
+}
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
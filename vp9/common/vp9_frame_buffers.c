@@ -18,7 +18,7 @@ int vp9_alloc_internal_frame_buffers(InternalFrameBufferList *list) {
   vp9_free_internal_frame_buffers(list);
 
   list->num_internal_frame_buffers =
-      VP9_MAXIMUM_REF_BUFFERS + VPX_MAXIMUM_WORK_BUFFERS;
+      VP9_MAXIMUM_REF_BUFFERS + VPX_MAXIMUM_FRAME_PARALLEL_WORK_BUFFERS;
   list->int_fb =
       (InternalFrameBuffer *)vpx_calloc(list->num_internal_frame_buffers,
                                         sizeof(*list->int_fb));
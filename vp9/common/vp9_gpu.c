@@ -13,6 +13,9 @@
 #if CONFIG_OPENCL
 #include "vp9/common/opencl/vp9_opencl.h"
 #endif
+#if CONFIG_CPU_COMPUTE
+#include "vp9/common/cpu/vp9_cpu.h"
+#endif
 
 #if CONFIG_GPU_COMPUTE
 
@@ -75,7 +78,15 @@ void vp9_acquire_frame_buffer(VP9_COMMON *cm, YV12_BUFFER_CONFIG *ybf) {
 
 int vp9_gpu_init(VP9_COMMON *cm) {
 #if CONFIG_OPENCL
-  return vp9_opencl_init(cm);
+  if (!vp9_opencl_init(cm))
+    return 0;
+  // No usable OpenCL device. Drop the partially initialized framework so
+  // that the CPU backend (if built) can take over.
+  vpx_free(cm->gpu.compute_framework);
+  cm->gpu.compute_framework = NULL;
+#endif
+#if CONFIG_CPU_COMPUTE
+  return vp9_cpu_init(cm);
 #else
   return 1;
 #endif
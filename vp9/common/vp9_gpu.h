@@ -15,7 +15,7 @@
 extern "C" {
 #endif
 
-#if CONFIG_OPENCL
+#if CONFIG_OPENCL || CONFIG_CPU_COMPUTE
 #define CONFIG_GPU_COMPUTE 1
 #else
 #define CONFIG_GPU_COMPUTE 0
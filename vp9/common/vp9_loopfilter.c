@@ -248,22 +248,25 @@ void vp9_loop_filter_init(VP9_COMMON *cm) {
     vpx_memset(lfi->lfthr[lvl].hev_thr, (lvl >> 4), SIMD_WIDTH);
 }
 
-void vp9_loop_filter_frame_init(VP9_COMMON *cm, int default_filt_lvl) {
+void vp9_loop_filter_update_sharpness(VP9_COMMON *cm) {
+  struct loopfilter *const lf = &cm->lf;
+
+  if (lf->last_sharpness_level != lf->sharpness_level) {
+    update_sharpness(&cm->lf_info, lf->sharpness_level);
+    lf->last_sharpness_level = lf->sharpness_level;
+  }
+}
+
+void vp9_loop_filter_set_levels(const VP9_COMMON *cm, loop_filter_info_n *lfi,
+                                int default_filt_lvl) {
   int seg_id;
   // n_shift is the multiplier for lf_deltas
   // the multiplier is 1 for when filter_lvl is between 0 and 31;
   // 2 when filter_lvl is between 32 and 63
   const int scale = 1 << (default_filt_lvl >> 5);
-  loop_filter_info_n *const lfi = &cm->lf_info;
-  struct loopfilter *const lf = &cm->lf;
+  const struct loopfilter *const lf = &cm->lf;
   const struct segmentation *const seg = &cm->seg;
 
-  // update limits if sharpness has changed
-  if (lf->last_sharpness_level != lf->sharpness_level) {
-    update_sharpness(lfi, lf->sharpness_level);
-    lf->last_sharpness_level = lf->sharpness_level;
-  }
-
   for (seg_id = 0; seg_id < MAX_SEGMENTS; seg_id++) {
     int lvl_seg = default_filt_lvl;
     if (vp9_segfeature_active(seg, seg_id, SEG_LVL_ALT_LF)) {
@@ -293,6 +296,12 @@ void vp9_loop_filter_frame_init(VP9_COMMON *cm, int default_filt_lvl) {
   }
 }
 
+void vp9_loop_filter_frame_init(VP9_COMMON *cm, int default_filt_lvl) {
+  // update limits if sharpness has changed
+  vp9_loop_filter_update_sharpness(cm);
+  vp9_loop_filter_set_levels(cm, &cm->lf_info, default_filt_lvl);
+}
+
 static void filter_selectively_vert_row2(PLANE_TYPE plane_type,
                                          uint8_t *s, int pitch,
                                          unsigned int mask_16x16_l,
@@ -392,13 +401,42 @@ static void filter_selectively_vert_row2(PLANE_TYPE plane_type,
   }
 }
 
-static void filter_selectively_horiz(uint8_t *s, int pitch,
-                                     unsigned int mask_16x16,
-                                     unsigned int mask_8x8,
-                                     unsigned int mask_4x4,
-                                     unsigned int mask_4x4_int,
-                                     const loop_filter_info_n *lfi_n,
-                                     const uint8_t *lfl) {
+// The vertical edges of 4 rows of 8x8 blocks, the masks holding the 2 rows of
+// each filter_selectively_vert_row2() call one after the other.
+void vp9_lpf_vertical_row4_c(uint8_t *s, int pitch, int plane_type,
+                             unsigned int mask_16x16,
+                             unsigned int mask_8x8,
+                             unsigned int mask_4x4,
+                             unsigned int mask_4x4_int,
+                             const loop_filter_info_n *lfi_n,
+                             const uint8_t *lfl) {
+  const int mask_shift = plane_type ? 8 : 16;
+  const unsigned int mask_cutoff = (1u << mask_shift) - 1;
+  int r;
+
+  for (r = 0; r < 4; r += 2) {
+    filter_selectively_vert_row2(plane_type, s, pitch,
+                                 mask_16x16 & mask_cutoff,
+                                 mask_8x8 & mask_cutoff,
+                                 mask_4x4 & mask_cutoff,
+                                 mask_4x4_int & mask_cutoff,
+                                 lfi_n, lfl);
+    s += 16 * pitch;
+    lfl += mask_shift;
+    mask_16x16 >>= mask_shift;
+    mask_8x8 >>= mask_shift;
+    mask_4x4 >>= mask_shift;
+    mask_4x4_int >>= mask_shift;
+  }
+}
+
+void vp9_lpf_horizontal_row_c(uint8_t *s, int pitch,
+                              unsigned int mask_16x16,
+                              unsigned int mask_8x8,
+                              unsigned int mask_4x4,
+                              unsigned int mask_4x4_int,
+                              const loop_filter_info_n *lfi_n,
+                              const uint8_t *lfl) {
   unsigned int mask;
   int count;
 
@@ -621,8 +659,16 @@ static void build_y_mask(const loop_filter_info_n *const lfi_n,
 void vp9_setup_mask(VP9_COMMON *const cm, const int mi_row, const int mi_col,
                     MODE_INFO **mi, const int mode_info_stride,
                     LOOP_FILTER_MASK *lfm) {
+  vp9_setup_mask_lfi(cm, &cm->lf_info, mi_row, mi_col, mi, mode_info_stride,
+                     lfm);
+}
+
+void vp9_setup_mask_lfi(VP9_COMMON *const cm,
+                        const loop_filter_info_n *const lfi_n,
+                        const int mi_row, const int mi_col,
+                        MODE_INFO **mi, const int mode_info_stride,
+                        LOOP_FILTER_MASK *lfm) {
   int idx_32, idx_16, idx_8;
-  const loop_filter_info_n *const lfi_n = &cm->lf_info;
   MODE_INFO **mip = mi;
   MODE_INFO **mip2 = mi;
 
@@ -1031,12 +1077,12 @@ static void filter_block_plane_non420(VP9_COMMON *cm,
       mask_4x4_r = mask_4x4[r];
     }
 
-    filter_selectively_horiz(dst->buf, dst->stride,
-                             mask_16x16_r,
-                             mask_8x8_r,
-                             mask_4x4_r,
-                             mask_4x4_int_r,
-                             &cm->lf_info, &lfl[r << 3]);
+    vp9_lpf_horizontal_row(dst->buf, dst->stride,
+                           mask_16x16_r,
+                           mask_8x8_r,
+                           mask_4x4_r,
+                           mask_4x4_int_r,
+                           &cm->lf_info, &lfl[r << 3]);
     dst->buf += 8 * dst->stride;
   }
 }
@@ -1055,27 +1101,21 @@ void vp9_filter_block_plane(VP9_COMMON *const cm,
     uint64_t mask_4x4 = lfm->left_y[TX_4X4];
     uint64_t mask_4x4_int = lfm->int_4x4_y;
 
-    // Vertical pass: do 2 rows at one time
-    for (r = 0; r < MI_BLOCK_SIZE && mi_row + r < cm->mi_rows; r += 2) {
-      unsigned int mask_16x16_l = mask_16x16 & 0xffff;
-      unsigned int mask_8x8_l = mask_8x8 & 0xffff;
-      unsigned int mask_4x4_l = mask_4x4 & 0xffff;
-      unsigned int mask_4x4_int_l = mask_4x4_int & 0xffff;
-
+    // Vertical pass: do 4 rows at one time
+    for (r = 0; r < MI_BLOCK_SIZE && mi_row + r < cm->mi_rows; r += 4) {
       // Disable filtering on the leftmost column
-      filter_selectively_vert_row2(plane->plane_type,
-                                   dst->buf, dst->stride,
-                                   mask_16x16_l,
-                                   mask_8x8_l,
-                                   mask_4x4_l,
-                                   mask_4x4_int_l,
-                                   &cm->lf_info, &lfm->lfl_y[r << 3]);
-
-      dst->buf += 16 * dst->stride;
-      mask_16x16 >>= 16;
-      mask_8x8 >>= 16;
-      mask_4x4 >>= 16;
-      mask_4x4_int >>= 16;
+      vp9_lpf_vertical_row4(dst->buf, dst->stride, plane->plane_type,
+                            (unsigned int)mask_16x16,
+                            (unsigned int)mask_8x8,
+                            (unsigned int)mask_4x4,
+                            (unsigned int)mask_4x4_int,
+                            &cm->lf_info, &lfm->lfl_y[r << 3]);
+
+      dst->buf += 32 * dst->stride;
+      mask_16x16 >>= 32;
+      mask_8x8 >>= 32;
+      mask_4x4 >>= 32;
+      mask_4x4_int >>= 32;
     }
 
     // Horizontal pass
@@ -1100,12 +1140,12 @@ void vp9_filter_block_plane(VP9_COMMON *const cm,
         mask_4x4_r = mask_4x4 & 0xff;
       }
 
-      filter_selectively_horiz(dst->buf, dst->stride,
-                               mask_16x16_r,
-                               mask_8x8_r,
-                               mask_4x4_r,
-                               mask_4x4_int & 0xff,
-                               &cm->lf_info, &lfm->lfl_y[r << 3]);
+      vp9_lpf_horizontal_row(dst->buf, dst->stride,
+                             mask_16x16_r,
+                             mask_8x8_r,
+                             mask_4x4_r,
+                             mask_4x4_int & 0xff,
+                             &cm->lf_info, &lfm->lfl_y[r << 3]);
 
       dst->buf += 8 * dst->stride;
       mask_16x16 >>= 8;
@@ -1119,39 +1159,25 @@ void vp9_filter_block_plane(VP9_COMMON *const cm,
     uint16_t mask_4x4 = lfm->left_uv[TX_4X4];
     uint16_t mask_4x4_int = lfm->int_4x4_uv;
 
-    // Vertical pass: do 2 rows at one time
-    for (r = 0; r < MI_BLOCK_SIZE && mi_row + r < cm->mi_rows; r += 4) {
-      if (plane->plane_type == 1) {
+    // Vertical pass: do all 4 rows at one time
+    if (plane->plane_type == 1) {
+      for (r = 0; r < MI_BLOCK_SIZE && mi_row + r < cm->mi_rows; r += 4) {
         for (c = 0; c < (MI_BLOCK_SIZE >> 1); c++) {
           lfm->lfl_uv[(r << 1) + c] = lfm->lfl_y[(r << 3) + (c << 1)];
           lfm->lfl_uv[((r + 2) << 1) + c] = lfm->lfl_y[((r + 2) << 3) +
                                                        (c << 1)];
         }
       }
-
-      {
-        unsigned int mask_16x16_l = mask_16x16 & 0xff;
-        unsigned int mask_8x8_l = mask_8x8 & 0xff;
-        unsigned int mask_4x4_l = mask_4x4 & 0xff;
-        unsigned int mask_4x4_int_l = mask_4x4_int & 0xff;
-
-        // Disable filtering on the leftmost column
-        filter_selectively_vert_row2(plane->plane_type,
-                                     dst->buf, dst->stride,
-                                     mask_16x16_l,
-                                     mask_8x8_l,
-                                     mask_4x4_l,
-                                     mask_4x4_int_l,
-                                     &cm->lf_info, &lfm->lfl_uv[r << 1]);
-
-        dst->buf += 16 * dst->stride;
-        mask_16x16 >>= 8;
-        mask_8x8 >>= 8;
-        mask_4x4 >>= 8;
-        mask_4x4_int >>= 8;
-      }
     }
 
+    // Disable filtering on the leftmost column
+    vp9_lpf_vertical_row4(dst->buf, dst->stride, plane->plane_type,
+                          mask_16x16,
+                          mask_8x8,
+                          mask_4x4,
+                          mask_4x4_int,
+                          &cm->lf_info, lfm->lfl_uv);
+
     // Horizontal pass
     dst->buf = dst0;
     mask_16x16 = lfm->above_uv[TX_16X16];
@@ -1177,12 +1203,12 @@ void vp9_filter_block_plane(VP9_COMMON *const cm,
         mask_4x4_r = mask_4x4 & 0xf;
       }
 
-      filter_selectively_horiz(dst->buf, dst->stride,
-                               mask_16x16_r,
-                               mask_8x8_r,
-                               mask_4x4_r,
-                               mask_4x4_int_r,
-                               &cm->lf_info, &lfm->lfl_uv[r << 1]);
+      vp9_lpf_horizontal_row(dst->buf, dst->stride,
+                             mask_16x16_r,
+                             mask_8x8_r,
+                             mask_4x4_r,
+                             mask_4x4_int_r,
+                             &cm->lf_info, &lfm->lfl_uv[r << 1]);
 
       dst->buf += 8 * dst->stride;
       mask_16x16 >>= 4;
@@ -55,7 +55,7 @@ typedef struct {
   DECLARE_ALIGNED(SIMD_WIDTH, uint8_t, hev_thr[SIMD_WIDTH]);
 } loop_filter_thresh;
 
-typedef struct {
+typedef struct loop_filter_info_n {
   loop_filter_thresh lfthr[MAX_LOOP_FILTER + 1];
   uint8_t lvl[MAX_SEGMENTS][MAX_REF_FRAMES][MAX_MODE_LF_DELTAS];
 } loop_filter_info_n;
@@ -83,7 +83,7 @@ typedef struct {
 /* assorted loopfilter functions which get used elsewhere */
 struct VP9Common;
 struct macroblockd;
-struct VP9LfSyncData;
+struct VP9RowSync;
 
 // This function sets up the bit masks for the entire 64x64 region represented
 // by mi_row, mi_col.
@@ -92,6 +92,14 @@ void vp9_setup_mask(struct VP9Common *const cm,
                     MODE_INFO **mi_8x8, const int mode_info_stride,
                     LOOP_FILTER_MASK *lfm);
 
+// As vp9_setup_mask(), with the filter levels of the blocks taken from 'lfi_n'
+// rather than from the frame's loop filter info.
+void vp9_setup_mask_lfi(struct VP9Common *const cm,
+                        const loop_filter_info_n *const lfi_n,
+                        const int mi_row, const int mi_col,
+                        MODE_INFO **mi_8x8, const int mode_info_stride,
+                        LOOP_FILTER_MASK *lfm);
+
 void vp9_filter_block_plane(struct VP9Common *const cm,
                             struct macroblockd_plane *const plane,
                             int mi_row,
@@ -104,6 +112,15 @@ void vp9_loop_filter_init(struct VP9Common *cm);
 // calls this function directly.
 void vp9_loop_filter_frame_init(struct VP9Common *cm, int default_filt_lvl);
 
+// Update the filter limits of the frame if the sharpness has changed.
+void vp9_loop_filter_update_sharpness(struct VP9Common *cm);
+
+// Set the filter level of each segment, reference frame and mode in 'lfi' for
+// a frame filter level of 'default_filt_lvl'. The limits of 'lfi' are left
+// untouched.
+void vp9_loop_filter_set_levels(const struct VP9Common *cm,
+                                loop_filter_info_n *lfi, int default_filt_lvl);
+
 void vp9_loop_filter_frame(YV12_BUFFER_CONFIG *frame,
                            struct VP9Common *cm,
                            struct macroblockd *mbd,
@@ -130,8 +147,7 @@ typedef struct LoopFilterWorkerData {
   int stop;
   int y_only;
 
-  struct VP9LfSyncData *lf_sync;
-  int num_lf_workers;
+  struct VP9RowSync *lf_sync;
 } LFWorkerData;
 
 // Operates on the rows described by 'lf_data'.
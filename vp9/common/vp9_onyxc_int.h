@@ -91,7 +91,9 @@ typedef struct VP9Common {
 
   YV12_BUFFER_CONFIG *frame_to_show;
 
-  RefCntBuffer frame_bufs[FRAME_BUFFERS];
+  // FRAME_BUFFERS entries. Owned by the codec instance; shared with the
+  // frame workers in frame parallel decoding.
+  RefCntBuffer *frame_bufs;
 
   int ref_frame_map[REF_FRAMES]; /* maps fb_idx to reference slot */
 
@@ -367,22 +367,24 @@ static void dec_build_inter_predictors(MACROBLOCKD *xd, int plane, int block,
     buf_ptr = ref_frame + y0 * pre_buf->stride + x0;
     buf_stride = pre_buf->stride;
 
-    // Do border extension if there is motion or the
-    // width/height is not a multiple of 8 pixels.
-    if (scaled_mv.col || scaled_mv.row ||
+    // Do border extension if there is motion, the reference is scaled or the
+    // width/height is not a multiple of 8 pixels. The borders of the
+    // references are never extended in the decoder.
+    if (vp9_is_scaled(sf) || scaled_mv.col || scaled_mv.row ||
         (frame_width & 0x7) || (frame_height & 0x7)) {
       // Get reference block bottom right coordinate.
       int x1 = ((x0_16 + (w - 1) * xs) >> SUBPEL_BITS) + 1;
       int y1 = ((y0_16 + (h - 1) * ys) >> SUBPEL_BITS) + 1;
       int x_pad = 0, y_pad = 0;
 
-      if (subpel_x || (sf->x_step_q4 & SUBPEL_MASK)) {
+      // Scaled predictions always run the filters, even at full-pel phases.
+      if (subpel_x || sf->x_step_q4 != SUBPEL_SHIFTS) {
         x0 -= VP9_INTERP_EXTEND - 1;
         x1 += VP9_INTERP_EXTEND;
         x_pad = 1;
       }
 
-      if (subpel_y || (sf->y_step_q4 & SUBPEL_MASK)) {
+      if (subpel_y || sf->y_step_q4 != SUBPEL_SHIFTS) {
         y0 -= VP9_INTERP_EXTEND - 1;
         y1 += VP9_INTERP_EXTEND;
         y_pad = 1;
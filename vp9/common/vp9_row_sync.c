@@ -0,0 +1,196 @@
+/*
+ *  Copyright (c) 2014 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "./vpx_config.h"
+#include "vpx_mem/vpx_mem.h"
+
+#include "vp9/common/vp9_onyxc_int.h"
+#include "vp9/common/vp9_row_sync.h"
+
+#if ARCH_X86 || ARCH_X86_64
+#include "vpx_ports/x86.h"
+#else
+#define x86_pause_hint()
+#endif
+
+// Number of pause iterations a reader spins for before it blocks. This is
+// roughly the time it takes to process a few 8x8 blocks, so a dependency that
+// is about to be resolved does not cost a context switch, while an
+// oversubscribed system does not burn a time slice on a waiting thread.
+#define ROW_SYNC_MAX_SPINS 1024
+
+// Set up nsync by width.
+static int get_sync_range(int width) {
+  // nsync numbers are picked by testing. For example, for 4k
+  // video, using 4 gives best performance.
+  if (width < 640)
+    return 1;
+  else if (width <= 1280)
+    return 2;
+  else if (width <= 4096)
+    return 4;
+  else
+    return 8;
+}
+
+void vp9_row_sync_alloc(VP9RowSync *row_sync, VP9_COMMON *cm, int rows,
+                        int width) {
+  row_sync->rows = rows;
+#if CONFIG_MULTITHREAD
+  {
+    int i;
+
+    CHECK_MEM_ERROR(cm, row_sync->mutex_,
+                    vpx_malloc(sizeof(*row_sync->mutex_) * rows));
+    for (i = 0; i < rows; ++i) {
+      pthread_mutex_init(&row_sync->mutex_[i], NULL);
+    }
+
+    CHECK_MEM_ERROR(cm, row_sync->cond_,
+                    vpx_malloc(sizeof(*row_sync->cond_) * rows));
+    for (i = 0; i < rows; ++i) {
+      pthread_cond_init(&row_sync->cond_[i], NULL);
+    }
+  }
+#endif  // CONFIG_MULTITHREAD
+
+  CHECK_MEM_ERROR(cm, row_sync->cur_sb_col,
+                  vpx_malloc(sizeof(*row_sync->cur_sb_col) * rows));
+  CHECK_MEM_ERROR(cm, row_sync->num_waiters,
+                  vpx_calloc(rows, sizeof(*row_sync->num_waiters)));
+  CHECK_MEM_ERROR(cm, row_sync->row_stats,
+                  vpx_calloc(rows, sizeof(*row_sync->row_stats)));
+
+  // Set up nsync.
+  row_sync->sync_range = get_sync_range(width);
+
+  vp9_row_sync_reset(row_sync);
+}
+
+void vp9_row_sync_dealloc(VP9RowSync *row_sync) {
+  if (row_sync != NULL) {
+#if CONFIG_MULTITHREAD
+    int i;
+
+    if (row_sync->mutex_ != NULL) {
+      for (i = 0; i < row_sync->rows; ++i) {
+        pthread_mutex_destroy(&row_sync->mutex_[i]);
+      }
+      vpx_free(row_sync->mutex_);
+    }
+    if (row_sync->cond_ != NULL) {
+      for (i = 0; i < row_sync->rows; ++i) {
+        pthread_cond_destroy(&row_sync->cond_[i]);
+      }
+      vpx_free(row_sync->cond_);
+    }
+#endif  // CONFIG_MULTITHREAD
+    vpx_free(row_sync->cur_sb_col);
+    vpx_free(row_sync->num_waiters);
+    vpx_free(row_sync->row_stats);
+    // clear the structure as the source of this call may be a resize in which
+    // case this call will be followed by an _alloc() which may fail.
+    vp9_zero(*row_sync);
+  }
+}
+
+void vp9_row_sync_reset(VP9RowSync *row_sync) {
+  int i;
+
+  for (i = 0; i < row_sync->rows; ++i)
+    vpx_atomic_init(&row_sync->cur_sb_col[i], -1);
+  vpx_atomic_init(&row_sync->next_row, 0);
+}
+
+int vp9_row_sync_next_row(VP9RowSync *row_sync) {
+  return vpx_atomic_fetch_add(&row_sync->next_row, 1);
+}
+
+void vp9_row_sync_read(VP9RowSync *row_sync, int r, int c) {
+#if CONFIG_MULTITHREAD
+  const int nsync = row_sync->sync_range;
+
+  if (r && !(c & (nsync - 1))) {
+    const vpx_atomic_int *const top_sb_col = &row_sync->cur_sb_col[r - 1];
+    VP9RowSyncStats *const stats = &row_sync->row_stats[r];
+    pthread_mutex_t *mutex;
+    int i;
+
+    if (vpx_atomic_load_acquire(top_sb_col) >= c + nsync)
+      return;
+
+    ++stats->stalls;
+    for (i = 1; i <= ROW_SYNC_MAX_SPINS; ++i) {
+      x86_pause_hint();
+      if (vpx_atomic_load_acquire(top_sb_col) >= c + nsync) {
+        stats->spins += i;
+        return;
+      }
+    }
+    stats->spins += ROW_SYNC_MAX_SPINS;
+
+    // Announce the waiter before checking the row again: either the writer
+    // sees the announcement and signals, or this thread sees its progress.
+    mutex = &row_sync->mutex_[r - 1];
+    pthread_mutex_lock(mutex);
+    vpx_atomic_store_release(&row_sync->num_waiters[r - 1], 1);
+    vpx_atomic_memory_barrier();
+    if (vpx_atomic_load_acquire(top_sb_col) < c + nsync) {
+      ++stats->waits;
+      do {
+        pthread_cond_wait(&row_sync->cond_[r - 1], mutex);
+      } while (vpx_atomic_load_acquire(top_sb_col) < c + nsync);
+    }
+    vpx_atomic_store_release(&row_sync->num_waiters[r - 1], 0);
+    pthread_mutex_unlock(mutex);
+  }
+#else
+  (void)row_sync;
+  (void)r;
+  (void)c;
+#endif  // CONFIG_MULTITHREAD
+}
+
+void vp9_row_sync_write(VP9RowSync *row_sync, int r, int c, int sb_cols) {
+  const int nsync = row_sync->sync_range;
+  int cur;
+
+  // Only publish when there are enough complete SBs for the next row to run.
+  if (c < sb_cols - 1) {
+    cur = c;
+    if (c % nsync)
+      return;
+  } else {
+    cur = sb_cols + nsync;
+  }
+
+  vpx_atomic_store_release(&row_sync->cur_sb_col[r], cur);
+
+#if CONFIG_MULTITHREAD
+  vpx_atomic_memory_barrier();
+  if (vpx_atomic_load_acquire(&row_sync->num_waiters[r])) {
+    pthread_mutex_lock(&row_sync->mutex_[r]);
+    pthread_cond_signal(&row_sync->cond_[r]);
+    pthread_mutex_unlock(&row_sync->mutex_[r]);
+  }
+#endif  // CONFIG_MULTITHREAD
+}
+
+void vp9_row_sync_get_stats(const VP9RowSync *row_sync,
+                            VP9RowSyncStats *stats) {
+  int i;
+
+  vp9_zero(*stats);
+  for (i = 0; i < row_sync->rows; ++i) {
+    stats->stalls += row_sync->row_stats[i].stalls;
+    stats->spins += row_sync->row_stats[i].spins;
+    stats->waits += row_sync->row_stats[i].waits;
+  }
+}
@@ -0,0 +1,94 @@
+/*
+ *  Copyright (c) 2014 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef VP9_COMMON_VP9_ROW_SYNC_H_
+#define VP9_COMMON_VP9_ROW_SYNC_H_
+
+#include "./vpx_config.h"
+#include "vpx_ports/vpx_atomics.h"
+
+#include "vp9/common/vp9_thread.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct VP9Common;
+
+typedef struct VP9RowSyncStats {
+  // Number of reads that found their dependency unresolved.
+  unsigned int stalls;
+  // Number of pause iterations spent spinning on unresolved dependencies.
+  unsigned int spins;
+  // Number of times a reader had to block, after spinning did not help.
+  unsigned int waits;
+} VP9RowSyncStats;
+
+// Wavefront synchronization of SB rows: before processing SB 'c' of row 'r',
+// the SBs up to 'c + sync_range' of row 'r - 1' have to be complete.
+// Progress is published with release stores and polled with acquire loads;
+// a reader spins for a bounded number of iterations and then blocks on a
+// per row condition variable. Each row is expected to have a single reader
+// (the thread working on the row below).
+// The rows of a pass are also handed out dynamically: a thread asks for the
+// next row as soon as it is done with its current one, so a thread that got
+// cheap rows is not left idle while another one works through expensive
+// ones. Rows are handed out in increasing order, which keeps the wavefront
+// free of deadlocks: the rows a row depends on are always being processed.
+typedef struct VP9RowSync {
+#if CONFIG_MULTITHREAD
+  pthread_mutex_t *mutex_;
+  pthread_cond_t *cond_;
+#endif
+  // Index of the last complete SB of each row, -1 if none is.
+  vpx_atomic_int *cur_sb_col;
+  // Set while the reader of the row below is blocked on the row.
+  vpx_atomic_int *num_waiters;
+  // Counters of each row, only ever updated by the reader of the row.
+  VP9RowSyncStats *row_stats;
+  // Index of the next row to be handed out.
+  vpx_atomic_int next_row;
+  // The optimal sync_range for different resolution and platform should be
+  // determined by testing. Currently, it is chosen to be a power-of-2 number.
+  int sync_range;
+  int rows;
+} VP9RowSync;
+
+// Allocate the synchronization data of 'rows' SB rows of a frame 'width'
+// pixels wide.
+void vp9_row_sync_alloc(VP9RowSync *row_sync, struct VP9Common *cm, int rows,
+                        int width);
+
+void vp9_row_sync_dealloc(VP9RowSync *row_sync);
+
+// Mark all rows as not started. Has to be called before each pass over the
+// frame, while no thread is using 'row_sync'.
+void vp9_row_sync_reset(VP9RowSync *row_sync);
+
+// Take the next row of the pass. Returns the index of the row, counted from
+// the first row of the pass; the pass is complete once the returned index is
+// past its last row.
+int vp9_row_sync_next_row(VP9RowSync *row_sync);
+
+// Wait until SB 'c' of row 'r' can be processed.
+void vp9_row_sync_read(VP9RowSync *row_sync, int r, int c);
+
+// Publish the completion of SB 'c' of row 'r', of a row of 'sb_cols' SBs.
+void vp9_row_sync_write(VP9RowSync *row_sync, int r, int c, int sb_cols);
+
+// Sum of the counters of all the rows since the last vp9_row_sync_alloc().
+void vp9_row_sync_get_stats(const VP9RowSync *row_sync,
+                            VP9RowSyncStats *stats);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // VP9_COMMON_VP9_ROW_SYNC_H_
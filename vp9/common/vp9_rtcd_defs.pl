@@ -9,6 +9,7 @@ print <<EOF
 #include "vp9/common/vp9_idct.h"
 
 struct macroblockd;
+struct loop_filter_info_n;
 
 /* Encoder forward decls */
 struct macroblock;
@@ -70,10 +71,10 @@ specialize qw/vp9_h_predictor_4x4 neon_asm dspr2/, "$ssse3_x86inc";
 $vp9_h_predictor_4x4_neon_asm=vp9_h_predictor_4x4_neon;
 
 add_proto qw/void vp9_d117_predictor_4x4/, "uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left";
-specialize qw/vp9_d117_predictor_4x4/;
+specialize qw/vp9_d117_predictor_4x4 ssse3/;
 
 add_proto qw/void vp9_d135_predictor_4x4/, "uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left";
-specialize qw/vp9_d135_predictor_4x4/;
+specialize qw/vp9_d135_predictor_4x4 ssse3/;
 
 add_proto qw/void vp9_d153_predictor_4x4/, "uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left";
 specialize qw/vp9_d153_predictor_4x4/, "$ssse3_x86inc";
@@ -90,13 +91,13 @@ add_proto qw/void vp9_dc_predictor_4x4/, "uint8_t *dst, ptrdiff_t y_stride, cons
 specialize qw/vp9_dc_predictor_4x4 dspr2/, "$sse_x86inc";
 
 add_proto qw/void vp9_dc_top_predictor_4x4/, "uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left";
-specialize qw/vp9_dc_top_predictor_4x4/;
+specialize qw/vp9_dc_top_predictor_4x4 sse2/;
 
 add_proto qw/void vp9_dc_left_predictor_4x4/, "uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left";
-specialize qw/vp9_dc_left_predictor_4x4/;
+specialize qw/vp9_dc_left_predictor_4x4 sse2/;
 
 add_proto qw/void vp9_dc_128_predictor_4x4/, "uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left";
-specialize qw/vp9_dc_128_predictor_4x4/;
+specialize qw/vp9_dc_128_predictor_4x4 sse2/;
 
 add_proto qw/void vp9_d207_predictor_8x8/, "uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left";
 specialize qw/vp9_d207_predictor_8x8/, "$ssse3_x86inc";
@@ -112,10 +113,10 @@ specialize qw/vp9_h_predictor_8x8 neon_asm dspr2/, "$ssse3_x86inc";
 $vp9_h_predictor_8x8_neon_asm=vp9_h_predictor_8x8_neon;
 
 add_proto qw/void vp9_d117_predictor_8x8/, "uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left";
-specialize qw/vp9_d117_predictor_8x8/;
+specialize qw/vp9_d117_predictor_8x8 ssse3/;
 
 add_proto qw/void vp9_d135_predictor_8x8/, "uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left";
-specialize qw/vp9_d135_predictor_8x8/;
+specialize qw/vp9_d135_predictor_8x8 ssse3/;
 
 add_proto qw/void vp9_d153_predictor_8x8/, "uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left";
 specialize qw/vp9_d153_predictor_8x8/, "$ssse3_x86inc";
@@ -133,13 +134,13 @@ specialize qw/vp9_dc_predictor_8x8 neon_asm dspr2/, "$sse_x86inc";
 $vp9_dc_predictor_8x8_neon_asm=vp9_dc_predictor_8x8_neon;
 
 add_proto qw/void vp9_dc_top_predictor_8x8/, "uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left";
-specialize qw/vp9_dc_top_predictor_8x8/;
+specialize qw/vp9_dc_top_predictor_8x8 sse2/;
 
 add_proto qw/void vp9_dc_left_predictor_8x8/, "uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left";
-specialize qw/vp9_dc_left_predictor_8x8/;
+specialize qw/vp9_dc_left_predictor_8x8 sse2/;
 
 add_proto qw/void vp9_dc_128_predictor_8x8/, "uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left";
-specialize qw/vp9_dc_128_predictor_8x8/;
+specialize qw/vp9_dc_128_predictor_8x8 sse2/;
 
 add_proto qw/void vp9_d207_predictor_16x16/, "uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left";
 specialize qw/vp9_d207_predictor_16x16/, "$ssse3_x86inc";
@@ -155,10 +156,10 @@ specialize qw/vp9_h_predictor_16x16 neon_asm dspr2/, "$ssse3_x86inc";
 $vp9_h_predictor_16x16_neon_asm=vp9_h_predictor_16x16_neon;
 
 add_proto qw/void vp9_d117_predictor_16x16/, "uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left";
-specialize qw/vp9_d117_predictor_16x16/;
+specialize qw/vp9_d117_predictor_16x16 ssse3/;
 
 add_proto qw/void vp9_d135_predictor_16x16/, "uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left";
-specialize qw/vp9_d135_predictor_16x16/;
+specialize qw/vp9_d135_predictor_16x16 ssse3/;
 
 add_proto qw/void vp9_d153_predictor_16x16/, "uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left";
 specialize qw/vp9_d153_predictor_16x16/, "$ssse3_x86inc";
@@ -176,13 +177,13 @@ specialize qw/vp9_dc_predictor_16x16 neon_asm dspr2/, "$sse2_x86inc";
 $vp9_dc_predictor_16x16_neon_asm=vp9_dc_predictor_16x16_neon;
 
 add_proto qw/void vp9_dc_top_predictor_16x16/, "uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left";
-specialize qw/vp9_dc_top_predictor_16x16/;
+specialize qw/vp9_dc_top_predictor_16x16 sse2/;
 
 add_proto qw/void vp9_dc_left_predictor_16x16/, "uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left";
-specialize qw/vp9_dc_left_predictor_16x16/;
+specialize qw/vp9_dc_left_predictor_16x16 sse2/;
 
 add_proto qw/void vp9_dc_128_predictor_16x16/, "uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left";
-specialize qw/vp9_dc_128_predictor_16x16/;
+specialize qw/vp9_dc_128_predictor_16x16 sse2/;
 
 add_proto qw/void vp9_d207_predictor_32x32/, "uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left";
 specialize qw/vp9_d207_predictor_32x32/, "$ssse3_x86inc";
@@ -198,13 +199,13 @@ specialize qw/vp9_h_predictor_32x32 neon_asm/, "$ssse3_x86inc";
 $vp9_h_predictor_32x32_neon_asm=vp9_h_predictor_32x32_neon;
 
 add_proto qw/void vp9_d117_predictor_32x32/, "uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left";
-specialize qw/vp9_d117_predictor_32x32/;
+specialize qw/vp9_d117_predictor_32x32 ssse3 avx2/;
 
 add_proto qw/void vp9_d135_predictor_32x32/, "uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left";
-specialize qw/vp9_d135_predictor_32x32/;
+specialize qw/vp9_d135_predictor_32x32 ssse3 avx2/;
 
 add_proto qw/void vp9_d153_predictor_32x32/, "uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left";
-specialize qw/vp9_d153_predictor_32x32/;
+specialize qw/vp9_d153_predictor_32x32 ssse3 avx2/;
 
 add_proto qw/void vp9_v_predictor_32x32/, "uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left";
 specialize qw/vp9_v_predictor_32x32 neon_asm/, "$sse2_x86inc";
@@ -219,13 +220,13 @@ specialize qw/vp9_dc_predictor_32x32 neon_asm/, "$sse2_x86inc";
 $vp9_dc_predictor_32x32_neon_asm=vp9_dc_predictor_32x32_neon;
 
 add_proto qw/void vp9_dc_top_predictor_32x32/, "uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left";
-specialize qw/vp9_dc_top_predictor_32x32/;
+specialize qw/vp9_dc_top_predictor_32x32 sse2 avx2/;
 
 add_proto qw/void vp9_dc_left_predictor_32x32/, "uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left";
-specialize qw/vp9_dc_left_predictor_32x32/;
+specialize qw/vp9_dc_left_predictor_32x32 sse2 avx2/;
 
 add_proto qw/void vp9_dc_128_predictor_32x32/, "uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left";
-specialize qw/vp9_dc_128_predictor_32x32/;
+specialize qw/vp9_dc_128_predictor_32x32 sse2 avx2/;
 
 #
 # Loopfilter
@@ -274,6 +275,14 @@ add_proto qw/void vp9_lpf_horizontal_4_dual/, "uint8_t *s, int pitch, const uint
 specialize qw/vp9_lpf_horizontal_4_dual sse2 neon_asm dspr2/;
 $vp9_lpf_horizontal_4_dual_neon_asm=vp9_lpf_horizontal_4_dual_neon;
 
+# All the edges of a superblock row at once, as selected by the masks of
+# vp9_setup_mask().
+add_proto qw/void vp9_lpf_vertical_row4/, "uint8_t *s, int pitch, int plane_type, unsigned int mask_16x16, unsigned int mask_8x8, unsigned int mask_4x4, unsigned int mask_4x4_int, const struct loop_filter_info_n *lfi_n, const uint8_t *lfl";
+specialize qw/vp9_lpf_vertical_row4 avx2/;
+
+add_proto qw/void vp9_lpf_horizontal_row/, "uint8_t *s, int pitch, unsigned int mask_16x16, unsigned int mask_8x8, unsigned int mask_4x4, unsigned int mask_4x4_int, const struct loop_filter_info_n *lfi_n, const uint8_t *lfl";
+specialize qw/vp9_lpf_horizontal_row avx2/;
+
 #
 # post proc
 #
@@ -389,7 +398,7 @@ if (vpx_config("CONFIG_VP9_HIGHBITDEPTH") eq "yes") {
   $vp9_idct4x4_1_add_neon_asm=vp9_idct4x4_1_add_neon;
 
   add_proto qw/void vp9_idct4x4_16_add/, "const tran_low_t *input, uint8_t *dest, int dest_stride";
-  specialize qw/vp9_idct4x4_16_add sse2 neon_asm dspr2/;
+  specialize qw/vp9_idct4x4_16_add sse2 avx2 neon_asm dspr2/;
   $vp9_idct4x4_16_add_neon_asm=vp9_idct4x4_16_add_neon;
 
   add_proto qw/void vp9_idct8x8_1_add/, "const tran_low_t *input, uint8_t *dest, int dest_stride";
@@ -405,27 +414,27 @@ if (vpx_config("CONFIG_VP9_HIGHBITDEPTH") eq "yes") {
   $vp9_idct8x8_12_add_neon_asm=vp9_idct8x8_12_add_neon;
 
   add_proto qw/void vp9_idct16x16_1_add/, "const tran_low_t *input, uint8_t *dest, int dest_stride";
-  specialize qw/vp9_idct16x16_1_add sse2 neon_asm dspr2/;
+  specialize qw/vp9_idct16x16_1_add sse2 avx2 neon_asm dspr2/;
   $vp9_idct16x16_1_add_neon_asm=vp9_idct16x16_1_add_neon;
 
   add_proto qw/void vp9_idct16x16_256_add/, "const tran_low_t *input, uint8_t *dest, int dest_stride";
-  specialize qw/vp9_idct16x16_256_add sse2 ssse3 neon_asm dspr2/;
+  specialize qw/vp9_idct16x16_256_add sse2 ssse3 avx2 neon_asm dspr2/;
   $vp9_idct16x16_256_add_neon_asm=vp9_idct16x16_256_add_neon;
 
   add_proto qw/void vp9_idct16x16_10_add/, "const tran_low_t *input, uint8_t *dest, int dest_stride";
-  specialize qw/vp9_idct16x16_10_add sse2 ssse3 neon_asm dspr2/;
+  specialize qw/vp9_idct16x16_10_add sse2 ssse3 avx2 neon_asm dspr2/;
   $vp9_idct16x16_10_add_neon_asm=vp9_idct16x16_10_add_neon;
 
   add_proto qw/void vp9_idct32x32_1024_add/, "const tran_low_t *input, uint8_t *dest, int dest_stride";
-  specialize qw/vp9_idct32x32_1024_add sse2 neon_asm dspr2/;
+  specialize qw/vp9_idct32x32_1024_add sse2 avx2 neon_asm dspr2/;
   $vp9_idct32x32_1024_add_neon_asm=vp9_idct32x32_1024_add_neon;
 
   add_proto qw/void vp9_idct32x32_34_add/, "const tran_low_t *input, uint8_t *dest, int dest_stride";
-  specialize qw/vp9_idct32x32_34_add sse2 neon_asm dspr2/;
+  specialize qw/vp9_idct32x32_34_add sse2 avx2 neon_asm dspr2/;
   $vp9_idct32x32_34_add_neon_asm=vp9_idct32x32_1024_add_neon;
 
   add_proto qw/void vp9_idct32x32_1_add/, "const tran_low_t *input, uint8_t *dest, int dest_stride";
-  specialize qw/vp9_idct32x32_1_add sse2 neon_asm dspr2/;
+  specialize qw/vp9_idct32x32_1_add sse2 avx2 neon_asm dspr2/;
   $vp9_idct32x32_1_add_neon_asm=vp9_idct32x32_1_add_neon;
 
   add_proto qw/void vp9_iht4x4_16_add/, "const tran_low_t *input, uint8_t *dest, int dest_stride, int tx_type";
@@ -437,7 +446,7 @@ if (vpx_config("CONFIG_VP9_HIGHBITDEPTH") eq "yes") {
   $vp9_iht8x8_64_add_neon_asm=vp9_iht8x8_64_add_neon;
 
   add_proto qw/void vp9_iht16x16_256_add/, "const tran_low_t *input, uint8_t *output, int pitch, int tx_type";
-  specialize qw/vp9_iht16x16_256_add sse2 dspr2 neon/;
+  specialize qw/vp9_iht16x16_256_add sse2 avx2 dspr2 neon/;
 
   # dct and add
 
@@ -613,46 +622,46 @@ if (vpx_config("CONFIG_VP9_HIGHBITDEPTH") eq "yes") {
   # dct
   #
   add_proto qw/void vp9_high_idct4x4_1_add/, "const tran_low_t *input, uint8_t *dest, int dest_stride, int bd";
-  specialize qw/vp9_high_idct4x4_1_add/;
+  specialize qw/vp9_high_idct4x4_1_add sse2/;
 
   add_proto qw/void vp9_high_idct4x4_16_add/, "const tran_low_t *input, uint8_t *dest, int dest_stride, int bd";
-  specialize qw/vp9_high_idct4x4_16_add/;
+  specialize qw/vp9_high_idct4x4_16_add sse2/;
 
   add_proto qw/void vp9_high_idct8x8_1_add/, "const tran_low_t *input, uint8_t *dest, int dest_stride, int bd";
-  specialize qw/vp9_high_idct8x8_1_add/;
+  specialize qw/vp9_high_idct8x8_1_add sse2/;
 
   add_proto qw/void vp9_high_idct8x8_64_add/, "const tran_low_t *input, uint8_t *dest, int dest_stride, int bd";
-  specialize qw/vp9_high_idct8x8_64_add/;
+  specialize qw/vp9_high_idct8x8_64_add sse2/;
 
   add_proto qw/void vp9_high_idct8x8_10_add/, "const tran_low_t *input, uint8_t *dest, int dest_stride, int bd";
-  specialize qw/vp9_high_idct8x8_10_add/;
+  specialize qw/vp9_high_idct8x8_10_add sse2/;
 
   add_proto qw/void vp9_high_idct16x16_1_add/, "const tran_low_t *input, uint8_t *dest, int dest_stride, int bd";
-  specialize qw/vp9_high_idct16x16_1_add/;
+  specialize qw/vp9_high_idct16x16_1_add sse2/;
 
   add_proto qw/void vp9_high_idct16x16_256_add/, "const tran_low_t *input, uint8_t *dest, int dest_stride, int bd";
-  specialize qw/vp9_high_idct16x16_256_add/;
+  specialize qw/vp9_high_idct16x16_256_add sse2/;
 
   add_proto qw/void vp9_high_idct16x16_10_add/, "const tran_low_t *input, uint8_t *dest, int dest_stride, int bd";
-  specialize qw/vp9_high_idct16x16_10_add/;
+  specialize qw/vp9_high_idct16x16_10_add sse2/;
 
   add_proto qw/void vp9_high_idct32x32_1024_add/, "const tran_low_t *input, uint8_t *dest, int dest_stride, int bd";
-  specialize qw/vp9_high_idct32x32_1024_add/;
+  specialize qw/vp9_high_idct32x32_1024_add sse2/;
 
   add_proto qw/void vp9_high_idct32x32_34_add/, "const tran_low_t *input, uint8_t *dest, int dest_stride, int bd";
-  specialize qw/vp9_high_idct32x32_34_add/;
+  specialize qw/vp9_high_idct32x32_34_add sse2/;
 
   add_proto qw/void vp9_high_idct32x32_1_add/, "const tran_low_t *input, uint8_t *dest, int dest_stride, int bd";
-  specialize qw/vp9_high_idct32x32_1_add/;
+  specialize qw/vp9_high_idct32x32_1_add sse2/;
 
   add_proto qw/void vp9_high_iht4x4_16_add/, "const tran_low_t *input, uint8_t *dest, int dest_stride, int tx_type, int bd";
-  specialize qw/vp9_high_iht4x4_16_add/;
+  specialize qw/vp9_high_iht4x4_16_add sse2/;
 
   add_proto qw/void vp9_high_iht8x8_64_add/, "const tran_low_t *input, uint8_t *dest, int dest_stride, int tx_type, int bd";
-  specialize qw/vp9_high_iht8x8_64_add/;
+  specialize qw/vp9_high_iht8x8_64_add sse2/;
 
   add_proto qw/void vp9_high_iht16x16_256_add/, "const tran_low_t *input, uint8_t *output, int pitch, int tx_type, int bd";
-  specialize qw/vp9_high_iht16x16_256_add/;
+  specialize qw/vp9_high_iht16x16_256_add sse2/;
 
   # dct and add
 
@@ -1125,581 +1134,586 @@ add_proto qw/int vp9_full_range_search/, "const struct macroblock *x, const stru
 specialize qw/vp9_full_range_search/;
 
 add_proto qw/void vp9_temporal_filter_apply/, "uint8_t *frame1, unsigned int stride, uint8_t *frame2, unsigned int block_width, unsigned int block_height, int strength, int filter_weight, unsigned int *accumulator, uint16_t *count";
-specialize qw/vp9_temporal_filter_apply sse2/;
+specialize qw/vp9_temporal_filter_apply sse2 avx2/;
+
+if (vpx_config("CONFIG_VP9_TEMPORAL_DENOISING") eq "yes") {
+  add_proto qw/int vp9_denoiser_filter/, "const uint8_t *sig, int sig_stride, const uint8_t *mc_avg, int mc_avg_stride, uint8_t *avg, int avg_stride, int increase_denoising, BLOCK_SIZE bs, int motion_magnitude";
+  specialize qw/vp9_denoiser_filter sse2 avx2/;
+}
 
 if (vpx_config("CONFIG_VP9_HIGHBITDEPTH") eq "yes") {
 
   # variance
   add_proto qw/unsigned int vp9_high_variance32x16/, "const uint8_t *src_ptr, int source_stride, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse";
-  specialize qw/vp9_high_variance32x16/;
+  specialize qw/vp9_high_variance32x16 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_variance16x32/, "const uint8_t *src_ptr, int source_stride, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse";
-  specialize qw/vp9_high_variance16x32/;
+  specialize qw/vp9_high_variance16x32 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_variance64x32/, "const uint8_t *src_ptr, int source_stride, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse";
-  specialize qw/vp9_high_variance64x32/;
+  specialize qw/vp9_high_variance64x32 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_variance32x64/, "const uint8_t *src_ptr, int source_stride, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse";
-  specialize qw/vp9_high_variance32x64/;
+  specialize qw/vp9_high_variance32x64 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_variance32x32/, "const uint8_t *src_ptr, int source_stride, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse";
-  specialize qw/vp9_high_variance32x32/;
+  specialize qw/vp9_high_variance32x32 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_variance64x64/, "const uint8_t *src_ptr, int source_stride, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse";
-  specialize qw/vp9_high_variance64x64/;
+  specialize qw/vp9_high_variance64x64 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_variance16x16/, "const uint8_t *src_ptr, int source_stride, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse";
-  specialize qw/vp9_high_variance16x16/;
+  specialize qw/vp9_high_variance16x16 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_variance16x8/, "const uint8_t *src_ptr, int source_stride, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse";
-  specialize qw/vp9_high_variance16x8/;
+  specialize qw/vp9_high_variance16x8 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_variance8x16/, "const uint8_t *src_ptr, int source_stride, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse";
-  specialize qw/vp9_high_variance8x16/;
+  specialize qw/vp9_high_variance8x16 sse2/;
 
   add_proto qw/unsigned int vp9_high_variance8x8/, "const uint8_t *src_ptr, int source_stride, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse";
-  specialize qw/vp9_high_variance8x8/;
+  specialize qw/vp9_high_variance8x8 sse2/;
 
   add_proto qw/unsigned int vp9_high_variance8x4/, "const uint8_t *src_ptr, int source_stride, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse";
-  specialize qw/vp9_high_variance8x4/;
+  specialize qw/vp9_high_variance8x4 sse2/;
 
   add_proto qw/unsigned int vp9_high_variance4x8/, "const uint8_t *src_ptr, int source_stride, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse";
-  specialize qw/vp9_high_variance4x8/;
+  specialize qw/vp9_high_variance4x8 sse2/;
 
   add_proto qw/unsigned int vp9_high_variance4x4/, "const uint8_t *src_ptr, int source_stride, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse";
-  specialize qw/vp9_high_variance4x4/;
+  specialize qw/vp9_high_variance4x4 sse2/;
 
   add_proto qw/void vp9_high_get8x8var/, "const uint8_t *src_ptr, int source_stride, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse, int *sum";
-  specialize qw/vp9_high_get8x8var/;
+  specialize qw/vp9_high_get8x8var sse2/;
 
   add_proto qw/void vp9_high_get16x16var/, "const uint8_t *src_ptr, int source_stride, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse, int *sum";
-  specialize qw/vp9_high_get16x16var/;
+  specialize qw/vp9_high_get16x16var sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_10_variance32x16/, "const uint8_t *src_ptr, int source_stride, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse";
-  specialize qw/vp9_high_10_variance32x16/;
+  specialize qw/vp9_high_10_variance32x16 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_10_variance16x32/, "const uint8_t *src_ptr, int source_stride, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse";
-  specialize qw/vp9_high_10_variance16x32/;
+  specialize qw/vp9_high_10_variance16x32 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_10_variance64x32/, "const uint8_t *src_ptr, int source_stride, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse";
-  specialize qw/vp9_high_10_variance64x32/;
+  specialize qw/vp9_high_10_variance64x32 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_10_variance32x64/, "const uint8_t *src_ptr, int source_stride, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse";
-  specialize qw/vp9_high_10_variance32x64/;
+  specialize qw/vp9_high_10_variance32x64 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_10_variance32x32/, "const uint8_t *src_ptr, int source_stride, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse";
-  specialize qw/vp9_high_10_variance32x32/;
+  specialize qw/vp9_high_10_variance32x32 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_10_variance64x64/, "const uint8_t *src_ptr, int source_stride, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse";
-  specialize qw/vp9_high_10_variance64x64/;
+  specialize qw/vp9_high_10_variance64x64 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_10_variance16x16/, "const uint8_t *src_ptr, int source_stride, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse";
-  specialize qw/vp9_high_10_variance16x16/;
+  specialize qw/vp9_high_10_variance16x16 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_10_variance16x8/, "const uint8_t *src_ptr, int source_stride, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse";
-  specialize qw/vp9_high_10_variance16x8/;
+  specialize qw/vp9_high_10_variance16x8 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_10_variance8x16/, "const uint8_t *src_ptr, int source_stride, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse";
-  specialize qw/vp9_high_10_variance8x16/;
+  specialize qw/vp9_high_10_variance8x16 sse2/;
 
   add_proto qw/unsigned int vp9_high_10_variance8x8/, "const uint8_t *src_ptr, int source_stride, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse";
-  specialize qw/vp9_high_10_variance8x8/;
+  specialize qw/vp9_high_10_variance8x8 sse2/;
 
   add_proto qw/unsigned int vp9_high_10_variance8x4/, "const uint8_t *src_ptr, int source_stride, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse";
-  specialize qw/vp9_high_10_variance8x4/;
+  specialize qw/vp9_high_10_variance8x4 sse2/;
 
   add_proto qw/unsigned int vp9_high_10_variance4x8/, "const uint8_t *src_ptr, int source_stride, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse";
-  specialize qw/vp9_high_10_variance4x8/;
+  specialize qw/vp9_high_10_variance4x8 sse2/;
 
   add_proto qw/unsigned int vp9_high_10_variance4x4/, "const uint8_t *src_ptr, int source_stride, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse";
-  specialize qw/vp9_high_10_variance4x4/;
+  specialize qw/vp9_high_10_variance4x4 sse2/;
 
   add_proto qw/void vp9_high_10_get8x8var/, "const uint8_t *src_ptr, int source_stride, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse, int *sum";
-  specialize qw/vp9_high_10_get8x8var/;
+  specialize qw/vp9_high_10_get8x8var sse2/;
 
   add_proto qw/void vp9_high_10_get16x16var/, "const uint8_t *src_ptr, int source_stride, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse, int *sum";
-  specialize qw/vp9_high_10_get16x16var/;
+  specialize qw/vp9_high_10_get16x16var sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_12_variance32x16/, "const uint8_t *src_ptr, int source_stride, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse";
-  specialize qw/vp9_high_12_variance32x16/;
+  specialize qw/vp9_high_12_variance32x16 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_12_variance16x32/, "const uint8_t *src_ptr, int source_stride, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse";
-  specialize qw/vp9_high_12_variance16x32/;
+  specialize qw/vp9_high_12_variance16x32 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_12_variance64x32/, "const uint8_t *src_ptr, int source_stride, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse";
-  specialize qw/vp9_high_12_variance64x32/;
+  specialize qw/vp9_high_12_variance64x32 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_12_variance32x64/, "const uint8_t *src_ptr, int source_stride, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse";
-  specialize qw/vp9_high_12_variance32x64/;
+  specialize qw/vp9_high_12_variance32x64 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_12_variance32x32/, "const uint8_t *src_ptr, int source_stride, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse";
-  specialize qw/vp9_high_12_variance32x32/;
+  specialize qw/vp9_high_12_variance32x32 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_12_variance64x64/, "const uint8_t *src_ptr, int source_stride, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse";
-  specialize qw/vp9_high_12_variance64x64/;
+  specialize qw/vp9_high_12_variance64x64 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_12_variance16x16/, "const uint8_t *src_ptr, int source_stride, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse";
-  specialize qw/vp9_high_12_variance16x16/;
+  specialize qw/vp9_high_12_variance16x16 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_12_variance16x8/, "const uint8_t *src_ptr, int source_stride, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse";
-  specialize qw/vp9_high_12_variance16x8/;
+  specialize qw/vp9_high_12_variance16x8 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_12_variance8x16/, "const uint8_t *src_ptr, int source_stride, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse";
-  specialize qw/vp9_high_12_variance8x16/;
+  specialize qw/vp9_high_12_variance8x16 sse2/;
 
   add_proto qw/unsigned int vp9_high_12_variance8x8/, "const uint8_t *src_ptr, int source_stride, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse";
-  specialize qw/vp9_high_12_variance8x8/;
+  specialize qw/vp9_high_12_variance8x8 sse2/;
 
   add_proto qw/unsigned int vp9_high_12_variance8x4/, "const uint8_t *src_ptr, int source_stride, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse";
-  specialize qw/vp9_high_12_variance8x4/;
+  specialize qw/vp9_high_12_variance8x4 sse2/;
 
   add_proto qw/unsigned int vp9_high_12_variance4x8/, "const uint8_t *src_ptr, int source_stride, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse";
-  specialize qw/vp9_high_12_variance4x8/;
+  specialize qw/vp9_high_12_variance4x8 sse2/;
 
   add_proto qw/unsigned int vp9_high_12_variance4x4/, "const uint8_t *src_ptr, int source_stride, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse";
-  specialize qw/vp9_high_12_variance4x4/;
+  specialize qw/vp9_high_12_variance4x4 sse2/;
 
   add_proto qw/void vp9_high_12_get8x8var/, "const uint8_t *src_ptr, int source_stride, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse, int *sum";
-  specialize qw/vp9_high_12_get8x8var/;
+  specialize qw/vp9_high_12_get8x8var sse2/;
 
   add_proto qw/void vp9_high_12_get16x16var/, "const uint8_t *src_ptr, int source_stride, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse, int *sum";
-  specialize qw/vp9_high_12_get16x16var/;
+  specialize qw/vp9_high_12_get16x16var sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_sub_pixel_variance64x64/, "const uint8_t *src_ptr, int source_stride, int xoffset, int  yoffset, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse";
-  specialize qw/vp9_high_sub_pixel_variance64x64/;
+  specialize qw/vp9_high_sub_pixel_variance64x64 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_sub_pixel_avg_variance64x64/, "const uint8_t *src_ptr, int source_stride, int xoffset, int  yoffset, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse, const uint8_t *second_pred";
-  specialize qw/vp9_high_sub_pixel_avg_variance64x64/;
+  specialize qw/vp9_high_sub_pixel_avg_variance64x64 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_sub_pixel_variance32x64/, "const uint8_t *src_ptr, int source_stride, int xoffset, int  yoffset, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse";
-  specialize qw/vp9_high_sub_pixel_variance32x64/;
+  specialize qw/vp9_high_sub_pixel_variance32x64 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_sub_pixel_avg_variance32x64/, "const uint8_t *src_ptr, int source_stride, int xoffset, int  yoffset, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse, const uint8_t *second_pred";
-  specialize qw/vp9_high_sub_pixel_avg_variance32x64/;
+  specialize qw/vp9_high_sub_pixel_avg_variance32x64 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_sub_pixel_variance64x32/, "const uint8_t *src_ptr, int source_stride, int xoffset, int  yoffset, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse";
-  specialize qw/vp9_high_sub_pixel_variance64x32/;
+  specialize qw/vp9_high_sub_pixel_variance64x32 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_sub_pixel_avg_variance64x32/, "const uint8_t *src_ptr, int source_stride, int xoffset, int  yoffset, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse, const uint8_t *second_pred";
-  specialize qw/vp9_high_sub_pixel_avg_variance64x32/;
+  specialize qw/vp9_high_sub_pixel_avg_variance64x32 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_sub_pixel_variance32x16/, "const uint8_t *src_ptr, int source_stride, int xoffset, int  yoffset, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse";
-  specialize qw/vp9_high_sub_pixel_variance32x16/;
+  specialize qw/vp9_high_sub_pixel_variance32x16 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_sub_pixel_avg_variance32x16/, "const uint8_t *src_ptr, int source_stride, int xoffset, int  yoffset, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse, const uint8_t *second_pred";
-  specialize qw/vp9_high_sub_pixel_avg_variance32x16/;
+  specialize qw/vp9_high_sub_pixel_avg_variance32x16 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_sub_pixel_variance16x32/, "const uint8_t *src_ptr, int source_stride, int xoffset, int  yoffset, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse";
-  specialize qw/vp9_high_sub_pixel_variance16x32/;
+  specialize qw/vp9_high_sub_pixel_variance16x32 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_sub_pixel_avg_variance16x32/, "const uint8_t *src_ptr, int source_stride, int xoffset, int  yoffset, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse, const uint8_t *second_pred";
-  specialize qw/vp9_high_sub_pixel_avg_variance16x32/;
+  specialize qw/vp9_high_sub_pixel_avg_variance16x32 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_sub_pixel_variance32x32/, "const uint8_t *src_ptr, int source_stride, int xoffset, int  yoffset, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse";
-  specialize qw/vp9_high_sub_pixel_variance32x32/;
+  specialize qw/vp9_high_sub_pixel_variance32x32 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_sub_pixel_avg_variance32x32/, "const uint8_t *src_ptr, int source_stride, int xoffset, int  yoffset, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse, const uint8_t *second_pred";
-  specialize qw/vp9_high_sub_pixel_avg_variance32x32/;
+  specialize qw/vp9_high_sub_pixel_avg_variance32x32 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_sub_pixel_variance16x16/, "const uint8_t *src_ptr, int source_stride, int xoffset, int  yoffset, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse";
-  specialize qw/vp9_high_sub_pixel_variance16x16/;
+  specialize qw/vp9_high_sub_pixel_variance16x16 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_sub_pixel_avg_variance16x16/, "const uint8_t *src_ptr, int source_stride, int xoffset, int  yoffset, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse, const uint8_t *second_pred";
-  specialize qw/vp9_high_sub_pixel_avg_variance16x16/;
+  specialize qw/vp9_high_sub_pixel_avg_variance16x16 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_sub_pixel_variance8x16/, "const uint8_t *src_ptr, int source_stride, int xoffset, int  yoffset, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse";
-  specialize qw/vp9_high_sub_pixel_variance8x16/;
+  specialize qw/vp9_high_sub_pixel_variance8x16 sse2/;
 
   add_proto qw/unsigned int vp9_high_sub_pixel_avg_variance8x16/, "const uint8_t *src_ptr, int source_stride, int xoffset, int  yoffset, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse, const uint8_t *second_pred";
-  specialize qw/vp9_high_sub_pixel_avg_variance8x16/;
+  specialize qw/vp9_high_sub_pixel_avg_variance8x16 sse2/;
 
   add_proto qw/unsigned int vp9_high_sub_pixel_variance16x8/, "const uint8_t *src_ptr, int source_stride, int xoffset, int  yoffset, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse";
-  specialize qw/vp9_high_sub_pixel_variance16x8/;
+  specialize qw/vp9_high_sub_pixel_variance16x8 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_sub_pixel_avg_variance16x8/, "const uint8_t *src_ptr, int source_stride, int xoffset, int  yoffset, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse, const uint8_t *second_pred";
-  specialize qw/vp9_high_sub_pixel_avg_variance16x8/;
+  specialize qw/vp9_high_sub_pixel_avg_variance16x8 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_sub_pixel_variance8x8/, "const uint8_t *src_ptr, int source_stride, int xoffset, int  yoffset, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse";
-  specialize qw/vp9_high_sub_pixel_variance8x8/;
+  specialize qw/vp9_high_sub_pixel_variance8x8 sse2/;
 
   add_proto qw/unsigned int vp9_high_sub_pixel_avg_variance8x8/, "const uint8_t *src_ptr, int source_stride, int xoffset, int  yoffset, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse, const uint8_t *second_pred";
-  specialize qw/vp9_high_sub_pixel_avg_variance8x8/;
+  specialize qw/vp9_high_sub_pixel_avg_variance8x8 sse2/;
 
   add_proto qw/unsigned int vp9_high_sub_pixel_variance8x4/, "const uint8_t *src_ptr, int source_stride, int xoffset, int yoffset, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse";
-  specialize qw/vp9_high_sub_pixel_variance8x4/;
+  specialize qw/vp9_high_sub_pixel_variance8x4 sse2/;
 
   add_proto qw/unsigned int vp9_high_sub_pixel_avg_variance8x4/, "const uint8_t *src_ptr, int source_stride, int xoffset, int yoffset, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse, const uint8_t *second_pred";
-  specialize qw/vp9_high_sub_pixel_avg_variance8x4/;
+  specialize qw/vp9_high_sub_pixel_avg_variance8x4 sse2/;
 
   add_proto qw/unsigned int vp9_high_sub_pixel_variance4x8/, "const uint8_t *src_ptr, int source_stride, int xoffset, int yoffset, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse";
-  specialize qw/vp9_high_sub_pixel_variance4x8/;
+  specialize qw/vp9_high_sub_pixel_variance4x8 sse2/;
 
   add_proto qw/unsigned int vp9_high_sub_pixel_avg_variance4x8/, "const uint8_t *src_ptr, int source_stride, int xoffset, int yoffset, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse, const uint8_t *second_pred";
-  specialize qw/vp9_high_sub_pixel_avg_variance4x8/;
+  specialize qw/vp9_high_sub_pixel_avg_variance4x8 sse2/;
 
   add_proto qw/unsigned int vp9_high_sub_pixel_variance4x4/, "const uint8_t *src_ptr, int source_stride, int xoffset, int  yoffset, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse";
-  specialize qw/vp9_high_sub_pixel_variance4x4/;
+  specialize qw/vp9_high_sub_pixel_variance4x4 sse2/;
 
   add_proto qw/unsigned int vp9_high_sub_pixel_avg_variance4x4/, "const uint8_t *src_ptr, int source_stride, int xoffset, int  yoffset, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse, const uint8_t *second_pred";
-  specialize qw/vp9_high_sub_pixel_avg_variance4x4/;
+  specialize qw/vp9_high_sub_pixel_avg_variance4x4 sse2/;
 
   add_proto qw/unsigned int vp9_high_10_sub_pixel_variance64x64/, "const uint8_t *src_ptr, int source_stride, int xoffset, int  yoffset, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse";
-  specialize qw/vp9_high_10_sub_pixel_variance64x64/;
+  specialize qw/vp9_high_10_sub_pixel_variance64x64 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_10_sub_pixel_avg_variance64x64/, "const uint8_t *src_ptr, int source_stride, int xoffset, int  yoffset, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse, const uint8_t *second_pred";
-  specialize qw/vp9_high_10_sub_pixel_avg_variance64x64/;
+  specialize qw/vp9_high_10_sub_pixel_avg_variance64x64 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_10_sub_pixel_variance32x64/, "const uint8_t *src_ptr, int source_stride, int xoffset, int  yoffset, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse";
-  specialize qw/vp9_high_10_sub_pixel_variance32x64/;
+  specialize qw/vp9_high_10_sub_pixel_variance32x64 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_10_sub_pixel_avg_variance32x64/, "const uint8_t *src_ptr, int source_stride, int xoffset, int  yoffset, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse, const uint8_t *second_pred";
-  specialize qw/vp9_high_10_sub_pixel_avg_variance32x64/;
+  specialize qw/vp9_high_10_sub_pixel_avg_variance32x64 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_10_sub_pixel_variance64x32/, "const uint8_t *src_ptr, int source_stride, int xoffset, int  yoffset, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse";
-  specialize qw/vp9_high_10_sub_pixel_variance64x32/;
+  specialize qw/vp9_high_10_sub_pixel_variance64x32 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_10_sub_pixel_avg_variance64x32/, "const uint8_t *src_ptr, int source_stride, int xoffset, int  yoffset, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse, const uint8_t *second_pred";
-  specialize qw/vp9_high_10_sub_pixel_avg_variance64x32/;
+  specialize qw/vp9_high_10_sub_pixel_avg_variance64x32 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_10_sub_pixel_variance32x16/, "const uint8_t *src_ptr, int source_stride, int xoffset, int  yoffset, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse";
-  specialize qw/vp9_high_10_sub_pixel_variance32x16/;
+  specialize qw/vp9_high_10_sub_pixel_variance32x16 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_10_sub_pixel_avg_variance32x16/, "const uint8_t *src_ptr, int source_stride, int xoffset, int  yoffset, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse, const uint8_t *second_pred";
-  specialize qw/vp9_high_10_sub_pixel_avg_variance32x16/;
+  specialize qw/vp9_high_10_sub_pixel_avg_variance32x16 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_10_sub_pixel_variance16x32/, "const uint8_t *src_ptr, int source_stride, int xoffset, int  yoffset, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse";
-  specialize qw/vp9_high_10_sub_pixel_variance16x32/;
+  specialize qw/vp9_high_10_sub_pixel_variance16x32 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_10_sub_pixel_avg_variance16x32/, "const uint8_t *src_ptr, int source_stride, int xoffset, int  yoffset, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse, const uint8_t *second_pred";
-  specialize qw/vp9_high_10_sub_pixel_avg_variance16x32/;
+  specialize qw/vp9_high_10_sub_pixel_avg_variance16x32 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_10_sub_pixel_variance32x32/, "const uint8_t *src_ptr, int source_stride, int xoffset, int  yoffset, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse";
-  specialize qw/vp9_high_10_sub_pixel_variance32x32/;
+  specialize qw/vp9_high_10_sub_pixel_variance32x32 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_10_sub_pixel_avg_variance32x32/, "const uint8_t *src_ptr, int source_stride, int xoffset, int  yoffset, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse, const uint8_t *second_pred";
-  specialize qw/vp9_high_10_sub_pixel_avg_variance32x32/;
+  specialize qw/vp9_high_10_sub_pixel_avg_variance32x32 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_10_sub_pixel_variance16x16/, "const uint8_t *src_ptr, int source_stride, int xoffset, int  yoffset, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse";
-  specialize qw/vp9_high_10_sub_pixel_variance16x16/;
+  specialize qw/vp9_high_10_sub_pixel_variance16x16 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_10_sub_pixel_avg_variance16x16/, "const uint8_t *src_ptr, int source_stride, int xoffset, int  yoffset, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse, const uint8_t *second_pred";
-  specialize qw/vp9_high_10_sub_pixel_avg_variance16x16/;
+  specialize qw/vp9_high_10_sub_pixel_avg_variance16x16 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_10_sub_pixel_variance8x16/, "const uint8_t *src_ptr, int source_stride, int xoffset, int  yoffset, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse";
-  specialize qw/vp9_high_10_sub_pixel_variance8x16/;
+  specialize qw/vp9_high_10_sub_pixel_variance8x16 sse2/;
 
   add_proto qw/unsigned int vp9_high_10_sub_pixel_avg_variance8x16/, "const uint8_t *src_ptr, int source_stride, int xoffset, int  yoffset, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse, const uint8_t *second_pred";
-  specialize qw/vp9_high_10_sub_pixel_avg_variance8x16/;
+  specialize qw/vp9_high_10_sub_pixel_avg_variance8x16 sse2/;
 
   add_proto qw/unsigned int vp9_high_10_sub_pixel_variance16x8/, "const uint8_t *src_ptr, int source_stride, int xoffset, int  yoffset, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse";
-  specialize qw/vp9_high_10_sub_pixel_variance16x8/;
+  specialize qw/vp9_high_10_sub_pixel_variance16x8 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_10_sub_pixel_avg_variance16x8/, "const uint8_t *src_ptr, int source_stride, int xoffset, int  yoffset, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse, const uint8_t *second_pred";
-  specialize qw/vp9_high_10_sub_pixel_avg_variance16x8/;
+  specialize qw/vp9_high_10_sub_pixel_avg_variance16x8 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_10_sub_pixel_variance8x8/, "const uint8_t *src_ptr, int source_stride, int xoffset, int  yoffset, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse";
-  specialize qw/vp9_high_10_sub_pixel_variance8x8/;
+  specialize qw/vp9_high_10_sub_pixel_variance8x8 sse2/;
 
   add_proto qw/unsigned int vp9_high_10_sub_pixel_avg_variance8x8/, "const uint8_t *src_ptr, int source_stride, int xoffset, int  yoffset, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse, const uint8_t *second_pred";
-  specialize qw/vp9_high_10_sub_pixel_avg_variance8x8/;
+  specialize qw/vp9_high_10_sub_pixel_avg_variance8x8 sse2/;
 
   add_proto qw/unsigned int vp9_high_10_sub_pixel_variance8x4/, "const uint8_t *src_ptr, int source_stride, int xoffset, int yoffset, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse";
-  specialize qw/vp9_high_10_sub_pixel_variance8x4/;
+  specialize qw/vp9_high_10_sub_pixel_variance8x4 sse2/;
 
   add_proto qw/unsigned int vp9_high_10_sub_pixel_avg_variance8x4/, "const uint8_t *src_ptr, int source_stride, int xoffset, int yoffset, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse, const uint8_t *second_pred";
-  specialize qw/vp9_high_10_sub_pixel_avg_variance8x4/;
+  specialize qw/vp9_high_10_sub_pixel_avg_variance8x4 sse2/;
 
   add_proto qw/unsigned int vp9_high_10_sub_pixel_variance4x8/, "const uint8_t *src_ptr, int source_stride, int xoffset, int yoffset, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse";
-  specialize qw/vp9_high_10_sub_pixel_variance4x8/;
+  specialize qw/vp9_high_10_sub_pixel_variance4x8 sse2/;
 
   add_proto qw/unsigned int vp9_high_10_sub_pixel_avg_variance4x8/, "const uint8_t *src_ptr, int source_stride, int xoffset, int yoffset, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse, const uint8_t *second_pred";
-  specialize qw/vp9_high_10_sub_pixel_avg_variance4x8/;
+  specialize qw/vp9_high_10_sub_pixel_avg_variance4x8 sse2/;
 
   add_proto qw/unsigned int vp9_high_10_sub_pixel_variance4x4/, "const uint8_t *src_ptr, int source_stride, int xoffset, int  yoffset, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse";
-  specialize qw/vp9_high_10_sub_pixel_variance4x4/;
+  specialize qw/vp9_high_10_sub_pixel_variance4x4 sse2/;
 
   add_proto qw/unsigned int vp9_high_10_sub_pixel_avg_variance4x4/, "const uint8_t *src_ptr, int source_stride, int xoffset, int  yoffset, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse, const uint8_t *second_pred";
-  specialize qw/vp9_high_10_sub_pixel_avg_variance4x4/;
+  specialize qw/vp9_high_10_sub_pixel_avg_variance4x4 sse2/;
 
   add_proto qw/unsigned int vp9_high_12_sub_pixel_variance64x64/, "const uint8_t *src_ptr, int source_stride, int xoffset, int  yoffset, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse";
-  specialize qw/vp9_high_12_sub_pixel_variance64x64/;
+  specialize qw/vp9_high_12_sub_pixel_variance64x64 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_12_sub_pixel_avg_variance64x64/, "const uint8_t *src_ptr, int source_stride, int xoffset, int  yoffset, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse, const uint8_t *second_pred";
-  specialize qw/vp9_high_12_sub_pixel_avg_variance64x64/;
+  specialize qw/vp9_high_12_sub_pixel_avg_variance64x64 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_12_sub_pixel_variance32x64/, "const uint8_t *src_ptr, int source_stride, int xoffset, int  yoffset, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse";
-  specialize qw/vp9_high_12_sub_pixel_variance32x64/;
+  specialize qw/vp9_high_12_sub_pixel_variance32x64 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_12_sub_pixel_avg_variance32x64/, "const uint8_t *src_ptr, int source_stride, int xoffset, int  yoffset, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse, const uint8_t *second_pred";
-  specialize qw/vp9_high_12_sub_pixel_avg_variance32x64/;
+  specialize qw/vp9_high_12_sub_pixel_avg_variance32x64 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_12_sub_pixel_variance64x32/, "const uint8_t *src_ptr, int source_stride, int xoffset, int  yoffset, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse";
-  specialize qw/vp9_high_12_sub_pixel_variance64x32/;
+  specialize qw/vp9_high_12_sub_pixel_variance64x32 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_12_sub_pixel_avg_variance64x32/, "const uint8_t *src_ptr, int source_stride, int xoffset, int  yoffset, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse, const uint8_t *second_pred";
-  specialize qw/vp9_high_12_sub_pixel_avg_variance64x32/;
+  specialize qw/vp9_high_12_sub_pixel_avg_variance64x32 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_12_sub_pixel_variance32x16/, "const uint8_t *src_ptr, int source_stride, int xoffset, int  yoffset, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse";
-  specialize qw/vp9_high_12_sub_pixel_variance32x16/;
+  specialize qw/vp9_high_12_sub_pixel_variance32x16 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_12_sub_pixel_avg_variance32x16/, "const uint8_t *src_ptr, int source_stride, int xoffset, int  yoffset, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse, const uint8_t *second_pred";
-  specialize qw/vp9_high_12_sub_pixel_avg_variance32x16/;
+  specialize qw/vp9_high_12_sub_pixel_avg_variance32x16 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_12_sub_pixel_variance16x32/, "const uint8_t *src_ptr, int source_stride, int xoffset, int  yoffset, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse";
-  specialize qw/vp9_high_12_sub_pixel_variance16x32/;
+  specialize qw/vp9_high_12_sub_pixel_variance16x32 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_12_sub_pixel_avg_variance16x32/, "const uint8_t *src_ptr, int source_stride, int xoffset, int  yoffset, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse, const uint8_t *second_pred";
-  specialize qw/vp9_high_12_sub_pixel_avg_variance16x32/;
+  specialize qw/vp9_high_12_sub_pixel_avg_variance16x32 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_12_sub_pixel_variance32x32/, "const uint8_t *src_ptr, int source_stride, int xoffset, int  yoffset, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse";
-  specialize qw/vp9_high_12_sub_pixel_variance32x32/;
+  specialize qw/vp9_high_12_sub_pixel_variance32x32 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_12_sub_pixel_avg_variance32x32/, "const uint8_t *src_ptr, int source_stride, int xoffset, int  yoffset, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse, const uint8_t *second_pred";
-  specialize qw/vp9_high_12_sub_pixel_avg_variance32x32/;
+  specialize qw/vp9_high_12_sub_pixel_avg_variance32x32 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_12_sub_pixel_variance16x16/, "const uint8_t *src_ptr, int source_stride, int xoffset, int  yoffset, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse";
-  specialize qw/vp9_high_12_sub_pixel_variance16x16/;
+  specialize qw/vp9_high_12_sub_pixel_variance16x16 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_12_sub_pixel_avg_variance16x16/, "const uint8_t *src_ptr, int source_stride, int xoffset, int  yoffset, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse, const uint8_t *second_pred";
-  specialize qw/vp9_high_12_sub_pixel_avg_variance16x16/;
+  specialize qw/vp9_high_12_sub_pixel_avg_variance16x16 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_12_sub_pixel_variance8x16/, "const uint8_t *src_ptr, int source_stride, int xoffset, int  yoffset, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse";
-  specialize qw/vp9_high_12_sub_pixel_variance8x16/;
+  specialize qw/vp9_high_12_sub_pixel_variance8x16 sse2/;
 
   add_proto qw/unsigned int vp9_high_12_sub_pixel_avg_variance8x16/, "const uint8_t *src_ptr, int source_stride, int xoffset, int  yoffset, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse, const uint8_t *second_pred";
-  specialize qw/vp9_high_12_sub_pixel_avg_variance8x16/;
+  specialize qw/vp9_high_12_sub_pixel_avg_variance8x16 sse2/;
 
   add_proto qw/unsigned int vp9_high_12_sub_pixel_variance16x8/, "const uint8_t *src_ptr, int source_stride, int xoffset, int  yoffset, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse";
-  specialize qw/vp9_high_12_sub_pixel_variance16x8/;
+  specialize qw/vp9_high_12_sub_pixel_variance16x8 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_12_sub_pixel_avg_variance16x8/, "const uint8_t *src_ptr, int source_stride, int xoffset, int  yoffset, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse, const uint8_t *second_pred";
-  specialize qw/vp9_high_12_sub_pixel_avg_variance16x8/;
+  specialize qw/vp9_high_12_sub_pixel_avg_variance16x8 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_12_sub_pixel_variance8x8/, "const uint8_t *src_ptr, int source_stride, int xoffset, int  yoffset, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse";
-  specialize qw/vp9_high_12_sub_pixel_variance8x8/;
+  specialize qw/vp9_high_12_sub_pixel_variance8x8 sse2/;
 
   add_proto qw/unsigned int vp9_high_12_sub_pixel_avg_variance8x8/, "const uint8_t *src_ptr, int source_stride, int xoffset, int  yoffset, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse, const uint8_t *second_pred";
-  specialize qw/vp9_high_12_sub_pixel_avg_variance8x8/;
+  specialize qw/vp9_high_12_sub_pixel_avg_variance8x8 sse2/;
 
   add_proto qw/unsigned int vp9_high_12_sub_pixel_variance8x4/, "const uint8_t *src_ptr, int source_stride, int xoffset, int yoffset, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse";
-  specialize qw/vp9_high_12_sub_pixel_variance8x4/;
+  specialize qw/vp9_high_12_sub_pixel_variance8x4 sse2/;
 
   add_proto qw/unsigned int vp9_high_12_sub_pixel_avg_variance8x4/, "const uint8_t *src_ptr, int source_stride, int xoffset, int yoffset, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse, const uint8_t *second_pred";
-  specialize qw/vp9_high_12_sub_pixel_avg_variance8x4/;
+  specialize qw/vp9_high_12_sub_pixel_avg_variance8x4 sse2/;
 
   add_proto qw/unsigned int vp9_high_12_sub_pixel_variance4x8/, "const uint8_t *src_ptr, int source_stride, int xoffset, int yoffset, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse";
-  specialize qw/vp9_high_12_sub_pixel_variance4x8/;
+  specialize qw/vp9_high_12_sub_pixel_variance4x8 sse2/;
 
   add_proto qw/unsigned int vp9_high_12_sub_pixel_avg_variance4x8/, "const uint8_t *src_ptr, int source_stride, int xoffset, int yoffset, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse, const uint8_t *second_pred";
-  specialize qw/vp9_high_12_sub_pixel_avg_variance4x8/;
+  specialize qw/vp9_high_12_sub_pixel_avg_variance4x8 sse2/;
 
   add_proto qw/unsigned int vp9_high_12_sub_pixel_variance4x4/, "const uint8_t *src_ptr, int source_stride, int xoffset, int  yoffset, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse";
-  specialize qw/vp9_high_12_sub_pixel_variance4x4/;
+  specialize qw/vp9_high_12_sub_pixel_variance4x4 sse2/;
 
   add_proto qw/unsigned int vp9_high_12_sub_pixel_avg_variance4x4/, "const uint8_t *src_ptr, int source_stride, int xoffset, int  yoffset, const uint8_t *ref_ptr, int ref_stride, unsigned int *sse, const uint8_t *second_pred";
-  specialize qw/vp9_high_12_sub_pixel_avg_variance4x4/;
+  specialize qw/vp9_high_12_sub_pixel_avg_variance4x4 sse2/;
 
   add_proto qw/unsigned int vp9_high_sad64x64/, "const uint8_t *src_ptr, int source_stride, const uint8_t *ref_ptr, int  ref_stride";
-  specialize qw/vp9_high_sad64x64/;
+  specialize qw/vp9_high_sad64x64 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_sad32x64/, "const uint8_t *src_ptr, int source_stride, const uint8_t *ref_ptr, int ref_stride";
-  specialize qw/vp9_high_sad32x64/;
+  specialize qw/vp9_high_sad32x64 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_sad64x32/, "const uint8_t *src_ptr, int source_stride, const uint8_t *ref_ptr, int ref_stride";
-  specialize qw/vp9_high_sad64x32/;
+  specialize qw/vp9_high_sad64x32 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_sad32x16/, "const uint8_t *src_ptr, int source_stride, const uint8_t *ref_ptr, int ref_stride";
-  specialize qw/vp9_high_sad32x16/;
+  specialize qw/vp9_high_sad32x16 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_sad16x32/, "const uint8_t *src_ptr, int source_stride, const uint8_t *ref_ptr, int ref_stride";
-  specialize qw/vp9_high_sad16x32/;
+  specialize qw/vp9_high_sad16x32 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_sad32x32/, "const uint8_t *src_ptr, int source_stride, const uint8_t *ref_ptr, int  ref_stride";
-  specialize qw/vp9_high_sad32x32/;
+  specialize qw/vp9_high_sad32x32 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_sad16x16/, "const uint8_t *src_ptr, int source_stride, const uint8_t *ref_ptr, int  ref_stride";
-  specialize qw/vp9_high_sad16x16/;
+  specialize qw/vp9_high_sad16x16 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_sad16x8/, "const uint8_t *src_ptr, int source_stride, const uint8_t *ref_ptr, int  ref_stride";
-  specialize qw/vp9_high_sad16x8/;
+  specialize qw/vp9_high_sad16x8 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_sad8x16/, "const uint8_t *src_ptr, int source_stride, const uint8_t *ref_ptr, int  ref_stride";
-  specialize qw/vp9_high_sad8x16/;
+  specialize qw/vp9_high_sad8x16 sse2/;
 
   add_proto qw/unsigned int vp9_high_sad8x8/, "const uint8_t *src_ptr, int source_stride, const uint8_t *ref_ptr, int  ref_stride";
-  specialize qw/vp9_high_sad8x8/;
+  specialize qw/vp9_high_sad8x8 sse2/;
 
   add_proto qw/unsigned int vp9_high_sad8x4/, "const uint8_t *src_ptr, int source_stride, const uint8_t *ref_ptr, int ref_stride";
-  specialize qw/vp9_high_sad8x4/;
+  specialize qw/vp9_high_sad8x4 sse2/;
 
   add_proto qw/unsigned int vp9_high_sad4x8/, "const uint8_t *src_ptr, int source_stride, const uint8_t *ref_ptr, int ref_stride";
-  specialize qw/vp9_high_sad4x8/;
+  specialize qw/vp9_high_sad4x8 sse2/;
 
   add_proto qw/unsigned int vp9_high_sad4x4/, "const uint8_t *src_ptr, int source_stride, const uint8_t *ref_ptr, int  ref_stride";
-  specialize qw/vp9_high_sad4x4/;
+  specialize qw/vp9_high_sad4x4 sse2/;
 
   add_proto qw/unsigned int vp9_high_sad64x64_avg/, "const uint8_t *src_ptr, int source_stride, const uint8_t *ref_ptr, int  ref_stride, const uint8_t *second_pred";
-  specialize qw/vp9_high_sad64x64_avg/;
+  specialize qw/vp9_high_sad64x64_avg sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_sad32x64_avg/, "const uint8_t *src_ptr, int source_stride, const uint8_t *ref_ptr, int ref_stride, const uint8_t *second_pred";
-  specialize qw/vp9_high_sad32x64_avg/;
+  specialize qw/vp9_high_sad32x64_avg sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_sad64x32_avg/, "const uint8_t *src_ptr, int source_stride, const uint8_t *ref_ptr, int ref_stride, const uint8_t *second_pred";
-  specialize qw/vp9_high_sad64x32_avg/;
+  specialize qw/vp9_high_sad64x32_avg sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_sad32x16_avg/, "const uint8_t *src_ptr, int source_stride, const uint8_t *ref_ptr, int ref_stride, const uint8_t *second_pred";
-  specialize qw/vp9_high_sad32x16_avg/;
+  specialize qw/vp9_high_sad32x16_avg sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_sad16x32_avg/, "const uint8_t *src_ptr, int source_stride, const uint8_t *ref_ptr, int ref_stride, const uint8_t *second_pred";
-  specialize qw/vp9_high_sad16x32_avg/;
+  specialize qw/vp9_high_sad16x32_avg sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_sad32x32_avg/, "const uint8_t *src_ptr, int source_stride, const uint8_t *ref_ptr, int  ref_stride, const uint8_t *second_pred";
-  specialize qw/vp9_high_sad32x32_avg/;
+  specialize qw/vp9_high_sad32x32_avg sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_sad16x16_avg/, "const uint8_t *src_ptr, int source_stride, const uint8_t *ref_ptr, int  ref_stride, const uint8_t *second_pred";
-  specialize qw/vp9_high_sad16x16_avg/;
+  specialize qw/vp9_high_sad16x16_avg sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_sad16x8_avg/, "const uint8_t *src_ptr, int source_stride, const uint8_t *ref_ptr, int  ref_stride, const uint8_t *second_pred";
-  specialize qw/vp9_high_sad16x8_avg/;
+  specialize qw/vp9_high_sad16x8_avg sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_sad8x16_avg/, "const uint8_t *src_ptr, int source_stride, const uint8_t *ref_ptr, int  ref_stride, const uint8_t *second_pred";
-  specialize qw/vp9_high_sad8x16_avg/;
+  specialize qw/vp9_high_sad8x16_avg sse2/;
 
   add_proto qw/unsigned int vp9_high_sad8x8_avg/, "const uint8_t *src_ptr, int source_stride, const uint8_t *ref_ptr, int  ref_stride, const uint8_t *second_pred";
-  specialize qw/vp9_high_sad8x8_avg/;
+  specialize qw/vp9_high_sad8x8_avg sse2/;
 
   add_proto qw/unsigned int vp9_high_sad8x4_avg/, "const uint8_t *src_ptr, int source_stride, const uint8_t *ref_ptr, int ref_stride, const uint8_t *second_pred";
-  specialize qw/vp9_high_sad8x4_avg/;
+  specialize qw/vp9_high_sad8x4_avg sse2/;
 
   add_proto qw/unsigned int vp9_high_sad4x8_avg/, "const uint8_t *src_ptr, int source_stride, const uint8_t *ref_ptr, int ref_stride, const uint8_t *second_pred";
-  specialize qw/vp9_high_sad4x8_avg/;
+  specialize qw/vp9_high_sad4x8_avg sse2/;
 
   add_proto qw/unsigned int vp9_high_sad4x4_avg/, "const uint8_t *src_ptr, int source_stride, const uint8_t *ref_ptr, int  ref_stride, const uint8_t *second_pred";
-  specialize qw/vp9_high_sad4x4_avg/;
+  specialize qw/vp9_high_sad4x4_avg sse2/;
 
   add_proto qw/void vp9_high_sad64x64x3/, "const uint8_t *src_ptr, int source_stride, const uint8_t *ref_ptr, int  ref_stride, unsigned int *sad_array";
-  specialize qw/vp9_high_sad64x64x3/;
+  specialize qw/vp9_high_sad64x64x3 sse2/;
 
   add_proto qw/void vp9_high_sad32x32x3/, "const uint8_t *src_ptr, int source_stride, const uint8_t *ref_ptr, int  ref_stride, unsigned int *sad_array";
-  specialize qw/vp9_high_sad32x32x3/;
+  specialize qw/vp9_high_sad32x32x3 sse2/;
 
   add_proto qw/void vp9_high_sad16x16x3/, "const uint8_t *src_ptr, int source_stride, const uint8_t *ref_ptr, int  ref_stride, unsigned int *sad_array";
-  specialize qw/vp9_high_sad16x16x3/;
+  specialize qw/vp9_high_sad16x16x3 sse2/;
 
   add_proto qw/void vp9_high_sad16x8x3/, "const uint8_t *src_ptr, int source_stride, const uint8_t *ref_ptr, int  ref_stride, unsigned int *sad_array";
-  specialize qw/vp9_high_sad16x8x3/;
+  specialize qw/vp9_high_sad16x8x3 sse2/;
 
   add_proto qw/void vp9_high_sad8x16x3/, "const uint8_t *src_ptr, int source_stride, const uint8_t *ref_ptr, int  ref_stride, unsigned int *sad_array";
-  specialize qw/vp9_high_sad8x16x3/;
+  specialize qw/vp9_high_sad8x16x3 sse2/;
 
   add_proto qw/void vp9_high_sad8x8x3/, "const uint8_t *src_ptr, int source_stride, const uint8_t *ref_ptr, int  ref_stride, unsigned int *sad_array";
-  specialize qw/vp9_high_sad8x8x3/;
+  specialize qw/vp9_high_sad8x8x3 sse2/;
 
   add_proto qw/void vp9_high_sad4x4x3/, "const uint8_t *src_ptr, int source_stride, const uint8_t *ref_ptr, int  ref_stride, unsigned int *sad_array";
-  specialize qw/vp9_high_sad4x4x3/;
+  specialize qw/vp9_high_sad4x4x3 sse2/;
 
   add_proto qw/void vp9_high_sad64x64x8/, "const uint8_t *src_ptr, int  src_stride, const uint8_t *ref_ptr, int  ref_stride, uint32_t *sad_array";
-  specialize qw/vp9_high_sad64x64x8/;
+  specialize qw/vp9_high_sad64x64x8 sse2/;
 
   add_proto qw/void vp9_high_sad32x32x8/, "const uint8_t *src_ptr, int  src_stride, const uint8_t *ref_ptr, int  ref_stride, uint32_t *sad_array";
-  specialize qw/vp9_high_sad32x32x8/;
+  specialize qw/vp9_high_sad32x32x8 sse2/;
 
   add_proto qw/void vp9_high_sad16x16x8/, "const uint8_t *src_ptr, int  src_stride, const uint8_t *ref_ptr, int  ref_stride, uint32_t *sad_array";
-  specialize qw/vp9_high_sad16x16x8/;
+  specialize qw/vp9_high_sad16x16x8 sse2/;
 
   add_proto qw/void vp9_high_sad16x8x8/, "const uint8_t *src_ptr, int  src_stride, const uint8_t *ref_ptr, int  ref_stride, uint32_t *sad_array";
-  specialize qw/vp9_high_sad16x8x8/;
+  specialize qw/vp9_high_sad16x8x8 sse2/;
 
   add_proto qw/void vp9_high_sad8x16x8/, "const uint8_t *src_ptr, int  src_stride, const uint8_t *ref_ptr, int  ref_stride, uint32_t *sad_array";
-  specialize qw/vp9_high_sad8x16x8/;
+  specialize qw/vp9_high_sad8x16x8 sse2/;
 
   add_proto qw/void vp9_high_sad8x8x8/, "const uint8_t *src_ptr, int  src_stride, const uint8_t *ref_ptr, int  ref_stride, uint32_t *sad_array";
-  specialize qw/vp9_high_sad8x8x8/;
+  specialize qw/vp9_high_sad8x8x8 sse2/;
 
   add_proto qw/void vp9_high_sad8x4x8/, "const uint8_t *src_ptr, int src_stride, const uint8_t *ref_ptr, int ref_stride, uint32_t *sad_array";
-  specialize qw/vp9_high_sad8x4x8/;
+  specialize qw/vp9_high_sad8x4x8 sse2/;
 
   add_proto qw/void vp9_high_sad4x8x8/, "const uint8_t *src_ptr, int src_stride, const uint8_t *ref_ptr, int ref_stride, uint32_t *sad_array";
-  specialize qw/vp9_high_sad4x8x8/;
+  specialize qw/vp9_high_sad4x8x8 sse2/;
 
   add_proto qw/void vp9_high_sad4x4x8/, "const uint8_t *src_ptr, int  src_stride, const uint8_t *ref_ptr, int  ref_stride, uint32_t *sad_array";
-  specialize qw/vp9_high_sad4x4x8/;
+  specialize qw/vp9_high_sad4x4x8 sse2/;
 
   add_proto qw/void vp9_high_sad64x64x4d/, "const uint8_t *src_ptr, int  src_stride, const uint8_t* const ref_ptr[], int  ref_stride, unsigned int *sad_array";
-  specialize qw/vp9_high_sad64x64x4d/;
+  specialize qw/vp9_high_sad64x64x4d sse2 avx2/;
 
   add_proto qw/void vp9_high_sad32x64x4d/, "const uint8_t *src_ptr, int  src_stride, const uint8_t* const ref_ptr[], int  ref_stride, unsigned int *sad_array";
-  specialize qw/vp9_high_sad32x64x4d/;
+  specialize qw/vp9_high_sad32x64x4d sse2 avx2/;
 
   add_proto qw/void vp9_high_sad64x32x4d/, "const uint8_t *src_ptr, int  src_stride, const uint8_t* const ref_ptr[], int  ref_stride, unsigned int *sad_array";
-  specialize qw/vp9_high_sad64x32x4d/;
+  specialize qw/vp9_high_sad64x32x4d sse2 avx2/;
 
   add_proto qw/void vp9_high_sad32x16x4d/, "const uint8_t *src_ptr, int  src_stride, const uint8_t* const ref_ptr[], int  ref_stride, unsigned int *sad_array";
-  specialize qw/vp9_high_sad32x16x4d/;
+  specialize qw/vp9_high_sad32x16x4d sse2 avx2/;
 
   add_proto qw/void vp9_high_sad16x32x4d/, "const uint8_t *src_ptr, int  src_stride, const uint8_t* const ref_ptr[], int  ref_stride, unsigned int *sad_array";
-  specialize qw/vp9_high_sad16x32x4d/;
+  specialize qw/vp9_high_sad16x32x4d sse2 avx2/;
 
   add_proto qw/void vp9_high_sad32x32x4d/, "const uint8_t *src_ptr, int  src_stride, const uint8_t* const ref_ptr[], int  ref_stride, unsigned int *sad_array";
-  specialize qw/vp9_high_sad32x32x4d/;
+  specialize qw/vp9_high_sad32x32x4d sse2 avx2/;
 
   add_proto qw/void vp9_high_sad16x16x4d/, "const uint8_t *src_ptr, int  src_stride, const uint8_t* const ref_ptr[], int  ref_stride, unsigned int *sad_array";
-  specialize qw/vp9_high_sad16x16x4d/;
+  specialize qw/vp9_high_sad16x16x4d sse2 avx2/;
 
   add_proto qw/void vp9_high_sad16x8x4d/, "const uint8_t *src_ptr, int  src_stride, const uint8_t* const ref_ptr[], int  ref_stride, unsigned int *sad_array";
-  specialize qw/vp9_high_sad16x8x4d/;
+  specialize qw/vp9_high_sad16x8x4d sse2 avx2/;
 
   add_proto qw/void vp9_high_sad8x16x4d/, "const uint8_t *src_ptr, int  src_stride, const uint8_t* const ref_ptr[], int  ref_stride, unsigned int *sad_array";
-  specialize qw/vp9_high_sad8x16x4d/;
+  specialize qw/vp9_high_sad8x16x4d sse2/;
 
   add_proto qw/void vp9_high_sad8x8x4d/, "const uint8_t *src_ptr, int  src_stride, const uint8_t* const ref_ptr[], int  ref_stride, unsigned int *sad_array";
-  specialize qw/vp9_high_sad8x8x4d/;
+  specialize qw/vp9_high_sad8x8x4d sse2/;
 
   # TODO(jingning): need to convert these 4x8/8x4 functions into sse2 form
   add_proto qw/void vp9_high_sad8x4x4d/, "const uint8_t *src_ptr, int src_stride, const uint8_t* const ref_ptr[], int ref_stride, unsigned int *sad_array";
-  specialize qw/vp9_high_sad8x4x4d/;
+  specialize qw/vp9_high_sad8x4x4d sse2/;
 
   add_proto qw/void vp9_high_sad4x8x4d/, "const uint8_t *src_ptr, int src_stride, const uint8_t* const ref_ptr[], int ref_stride, unsigned int *sad_array";
-  specialize qw/vp9_high_sad4x8x4d/;
+  specialize qw/vp9_high_sad4x8x4d sse2/;
 
   add_proto qw/void vp9_high_sad4x4x4d/, "const uint8_t *src_ptr, int  src_stride, const uint8_t* const ref_ptr[], int  ref_stride, unsigned int *sad_array";
-  specialize qw/vp9_high_sad4x4x4d/;
+  specialize qw/vp9_high_sad4x4x4d sse2/;
 
   add_proto qw/unsigned int vp9_high_mse16x16/, "const uint8_t *src_ptr, int  source_stride, const uint8_t *ref_ptr, int  recon_stride, unsigned int *sse";
-  specialize qw/vp9_high_mse16x16/;
+  specialize qw/vp9_high_mse16x16 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_mse8x16/, "const uint8_t *src_ptr, int  source_stride, const uint8_t *ref_ptr, int  recon_stride, unsigned int *sse";
-  specialize qw/vp9_high_mse8x16/;
+  specialize qw/vp9_high_mse8x16 sse2/;
 
   add_proto qw/unsigned int vp9_high_mse16x8/, "const uint8_t *src_ptr, int  source_stride, const uint8_t *ref_ptr, int  recon_stride, unsigned int *sse";
-  specialize qw/vp9_high_mse16x8/;
+  specialize qw/vp9_high_mse16x8 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_mse8x8/, "const uint8_t *src_ptr, int  source_stride, const uint8_t *ref_ptr, int  recon_stride, unsigned int *sse";
-  specialize qw/vp9_high_mse8x8/;
+  specialize qw/vp9_high_mse8x8 sse2/;
 
   add_proto qw/unsigned int vp9_high_10_mse16x16/, "const uint8_t *src_ptr, int  source_stride, const uint8_t *ref_ptr, int  recon_stride, unsigned int *sse";
-  specialize qw/vp9_high_10_mse16x16/;
+  specialize qw/vp9_high_10_mse16x16 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_10_mse8x16/, "const uint8_t *src_ptr, int  source_stride, const uint8_t *ref_ptr, int  recon_stride, unsigned int *sse";
-  specialize qw/vp9_high_10_mse8x16/;
+  specialize qw/vp9_high_10_mse8x16 sse2/;
 
   add_proto qw/unsigned int vp9_high_10_mse16x8/, "const uint8_t *src_ptr, int  source_stride, const uint8_t *ref_ptr, int  recon_stride, unsigned int *sse";
-  specialize qw/vp9_high_10_mse16x8/;
+  specialize qw/vp9_high_10_mse16x8 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_10_mse8x8/, "const uint8_t *src_ptr, int  source_stride, const uint8_t *ref_ptr, int  recon_stride, unsigned int *sse";
-  specialize qw/vp9_high_10_mse8x8/;
+  specialize qw/vp9_high_10_mse8x8 sse2/;
 
   add_proto qw/unsigned int vp9_high_12_mse16x16/, "const uint8_t *src_ptr, int  source_stride, const uint8_t *ref_ptr, int  recon_stride, unsigned int *sse";
-  specialize qw/vp9_high_12_mse16x16/;
+  specialize qw/vp9_high_12_mse16x16 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_12_mse8x16/, "const uint8_t *src_ptr, int  source_stride, const uint8_t *ref_ptr, int  recon_stride, unsigned int *sse";
-  specialize qw/vp9_high_12_mse8x16/;
+  specialize qw/vp9_high_12_mse8x16 sse2/;
 
   add_proto qw/unsigned int vp9_high_12_mse16x8/, "const uint8_t *src_ptr, int  source_stride, const uint8_t *ref_ptr, int  recon_stride, unsigned int *sse";
-  specialize qw/vp9_high_12_mse16x8/;
+  specialize qw/vp9_high_12_mse16x8 sse2 avx2/;
 
   add_proto qw/unsigned int vp9_high_12_mse8x8/, "const uint8_t *src_ptr, int  source_stride, const uint8_t *ref_ptr, int  recon_stride, unsigned int *sse";
-  specialize qw/vp9_high_12_mse8x8/;
+  specialize qw/vp9_high_12_mse8x8 sse2/;
 
   # ENCODEMB INVOKE
 
@@ -1710,16 +1724,16 @@ if (vpx_config("CONFIG_VP9_HIGHBITDEPTH") eq "yes") {
   specialize qw/vp9_high_subtract_block/;
 
   add_proto qw/void vp9_high_quantize_fp/, "const tran_low_t *coeff_ptr, intptr_t n_coeffs, int skip_block, const int16_t *zbin_ptr, const int16_t *round_ptr, const int16_t *quant_ptr, const int16_t *quant_shift_ptr, tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr, const int16_t *dequant_ptr, int zbin_oq_value, uint16_t *eob_ptr, const int16_t *scan, const int16_t *iscan";
-  specialize qw/vp9_high_quantize_fp/;
+  specialize qw/vp9_high_quantize_fp sse2 avx2/;
 
   add_proto qw/void vp9_high_quantize_fp_32x32/, "const tran_low_t *coeff_ptr, intptr_t n_coeffs, int skip_block, const int16_t *zbin_ptr, const int16_t *round_ptr, const int16_t *quant_ptr, const int16_t *quant_shift_ptr, tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr, const int16_t *dequant_ptr, int zbin_oq_value, uint16_t *eob_ptr, const int16_t *scan, const int16_t *iscan";
-  specialize qw/vp9_high_quantize_fp_32x32/;
+  specialize qw/vp9_high_quantize_fp_32x32 sse2 avx2/;
 
   add_proto qw/void vp9_high_quantize_b/, "const tran_low_t *coeff_ptr, intptr_t n_coeffs, int skip_block, const int16_t *zbin_ptr, const int16_t *round_ptr, const int16_t *quant_ptr, const int16_t *quant_shift_ptr, tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr, const int16_t *dequant_ptr, int zbin_oq_value, uint16_t *eob_ptr, const int16_t *scan, const int16_t *iscan";
-  specialize qw/vp9_high_quantize_b/;
+  specialize qw/vp9_high_quantize_b sse2 avx2/;
 
   add_proto qw/void vp9_high_quantize_b_32x32/, "const tran_low_t *coeff_ptr, intptr_t n_coeffs, int skip_block, const int16_t *zbin_ptr, const int16_t *round_ptr, const int16_t *quant_ptr, const int16_t *quant_shift_ptr, tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr, const int16_t *dequant_ptr, int zbin_oq_value, uint16_t *eob_ptr, const int16_t *scan, const int16_t *iscan";
-  specialize qw/vp9_high_quantize_b_32x32/;
+  specialize qw/vp9_high_quantize_b_32x32 sse2 avx2/;
 
   #
   # Structured Similarity (SSIM)
@@ -1734,40 +1748,40 @@ if (vpx_config("CONFIG_VP9_HIGHBITDEPTH") eq "yes") {
 
   # fdct functions
   add_proto qw/void vp9_high_fht4x4/, "const int16_t *input, tran_low_t *output, int stride, int tx_type";
-  specialize qw/vp9_high_fht4x4/;
+  specialize qw/vp9_high_fht4x4 sse2/;
 
   add_proto qw/void vp9_high_fht8x8/, "const int16_t *input, tran_low_t *output, int stride, int tx_type";
-  specialize qw/vp9_high_fht8x8/;
+  specialize qw/vp9_high_fht8x8 sse2/;
 
   add_proto qw/void vp9_high_fht16x16/, "const int16_t *input, tran_low_t *output, int stride, int tx_type";
-  specialize qw/vp9_high_fht16x16/;
+  specialize qw/vp9_high_fht16x16 sse2/;
 
   add_proto qw/void vp9_high_fwht4x4/, "const int16_t *input, tran_low_t *output, int stride";
   specialize qw/vp9_high_fwht4x4/;
 
   add_proto qw/void vp9_high_fdct4x4/, "const int16_t *input, tran_low_t *output, int stride";
-  specialize qw/vp9_high_fdct4x4/;
+  specialize qw/vp9_high_fdct4x4 sse2/;
 
   add_proto qw/void vp9_high_fdct8x8_1/, "const int16_t *input, tran_low_t *output, int stride";
-  specialize qw/vp9_high_fdct8x8_1/;
+  specialize qw/vp9_high_fdct8x8_1 sse2/;
 
   add_proto qw/void vp9_high_fdct8x8/, "const int16_t *input, tran_low_t *output, int stride";
-  specialize qw/vp9_high_fdct8x8/;
+  specialize qw/vp9_high_fdct8x8 sse2/;
 
   add_proto qw/void vp9_high_fdct16x16_1/, "const int16_t *input, tran_low_t *output, int stride";
-  specialize qw/vp9_high_fdct16x16_1/;
+  specialize qw/vp9_high_fdct16x16_1 sse2/;
 
   add_proto qw/void vp9_high_fdct16x16/, "const int16_t *input, tran_low_t *output, int stride";
-  specialize qw/vp9_high_fdct16x16/;
+  specialize qw/vp9_high_fdct16x16 sse2/;
 
   add_proto qw/void vp9_high_fdct32x32_1/, "const int16_t *input, tran_low_t *output, int stride";
-  specialize qw/vp9_high_fdct32x32_1/;
+  specialize qw/vp9_high_fdct32x32_1 sse2/;
 
   add_proto qw/void vp9_high_fdct32x32/, "const int16_t *input, tran_low_t *output, int stride";
-  specialize qw/vp9_high_fdct32x32/;
+  specialize qw/vp9_high_fdct32x32 sse2/;
 
   add_proto qw/void vp9_high_fdct32x32_rd/, "const int16_t *input, tran_low_t *output, int stride";
-  specialize qw/vp9_high_fdct32x32_rd/;
+  specialize qw/vp9_high_fdct32x32_rd sse2/;
 
   add_proto qw/void vp9_high_temporal_filter_apply/, "uint8_t *frame1, unsigned int stride, uint8_t *frame2, unsigned int block_width, unsigned int block_height, int strength, int filter_weight, unsigned int *accumulator, uint16_t *count";
   specialize qw/vp9_high_temporal_filter_apply/;
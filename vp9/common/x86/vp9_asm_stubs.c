@@ -23,7 +23,16 @@ typedef void filter8_1dfunction (
   const short *filter
 );
 
-#define FUN_CONV_1D(name, step_q4, filter, dir, src_start, avg, opt) \
+typedef void convolve_function(const uint8_t *src, ptrdiff_t src_stride,
+                               uint8_t *dst, ptrdiff_t dst_stride,
+                               const int16_t *filter_x, int x_step_q4,
+                               const int16_t *filter_y, int y_step_q4,
+                               int w, int h);
+
+// The steps other than 16, from scaled references, and the remaining columns
+// are filtered by the 'fallback' version, e.g. vp9_convolve8_horiz_c().
+#define FUN_CONV_1D(name, step_q4, filter, dir, src_start, avg, opt, \
+                    fallback) \
   void vp9_convolve8_##name##_##opt(const uint8_t *src, ptrdiff_t src_stride, \
                                    uint8_t *dst, ptrdiff_t dst_stride, \
                                    const int16_t *filter_x, int x_step_q4, \
@@ -101,13 +110,13 @@ typedef void filter8_1dfunction (
     } \
   } \
   if (w) { \
-    vp9_convolve8_##name##_c(src, src_stride, dst, dst_stride, \
-                             filter_x, x_step_q4, filter_y, y_step_q4, \
-                             w, h); \
+    vp9_convolve8_##name##_##fallback(src, src_stride, dst, dst_stride, \
+                                      filter_x, x_step_q4, filter_y, \
+                                      y_step_q4, w, h); \
   } \
 }
 
-#define FUN_CONV_2D(avg, opt) \
+#define FUN_CONV_2D(avg, opt, fallback) \
 void vp9_convolve8_##avg##opt(const uint8_t *src, ptrdiff_t src_stride, \
                               uint8_t *dst, ptrdiff_t dst_stride, \
                               const int16_t *filter_x, int x_step_q4, \
@@ -135,8 +144,9 @@ void vp9_convolve8_##avg##opt(const uint8_t *src, ptrdiff_t src_stride, \
                                       y_step_q4, w, h); \
     } \
   } else { \
-    vp9_convolve8_##avg##c(src, src_stride, dst, dst_stride, \
-                           filter_x, x_step_q4, filter_y, y_step_q4, w, h); \
+    vp9_convolve8_##avg##fallback(src, src_stride, dst, dst_stride, \
+                                  filter_x, x_step_q4, filter_y, y_step_q4, \
+                                  w, h); \
   } \
 }
 #if HAVE_AVX2 && HAVE_SSSE3
@@ -171,6 +181,9 @@ filter8_1dfunction vp9_filter_block1d4_h2_ssse3;
 #define vp9_filter_block1d8_h2_avx2  vp9_filter_block1d8_h2_ssse3
 #define vp9_filter_block1d4_v2_avx2  vp9_filter_block1d4_v2_ssse3
 #define vp9_filter_block1d4_h2_avx2  vp9_filter_block1d4_h2_ssse3
+convolve_function vp9_convolve8_horiz_scaled_avx2;
+convolve_function vp9_convolve8_vert_scaled_avx2;
+convolve_function vp9_convolve8_scaled_avx2;
 // void vp9_convolve8_horiz_avx2(const uint8_t *src, ptrdiff_t src_stride,
 //                                uint8_t *dst, ptrdiff_t dst_stride,
 //                                const int16_t *filter_x, int x_step_q4,
@@ -181,15 +194,16 @@ filter8_1dfunction vp9_filter_block1d4_h2_ssse3;
 //                               const int16_t *filter_x, int x_step_q4,
 //                               const int16_t *filter_y, int y_step_q4,
 //                               int w, int h);
-FUN_CONV_1D(horiz, x_step_q4, filter_x, h, src, , avx2);
-FUN_CONV_1D(vert, y_step_q4, filter_y, v, src - src_stride * 3, , avx2);
+FUN_CONV_1D(horiz, x_step_q4, filter_x, h, src, , avx2, scaled_avx2);
+FUN_CONV_1D(vert, y_step_q4, filter_y, v, src - src_stride * 3, , avx2,
+            scaled_avx2);
 
 // void vp9_convolve8_avx2(const uint8_t *src, ptrdiff_t src_stride,
 //                          uint8_t *dst, ptrdiff_t dst_stride,
 //                          const int16_t *filter_x, int x_step_q4,
 //                          const int16_t *filter_y, int y_step_q4,
 //                          int w, int h);
-FUN_CONV_2D(, avx2);
+FUN_CONV_2D(, avx2, scaled_avx2);
 #endif  // HAVE_AX2 && HAVE_SSSE3
 #if HAVE_SSSE3
 #if ARCH_X86_64
@@ -232,6 +246,13 @@ filter8_1dfunction vp9_filter_block1d8_h2_avg_ssse3;
 filter8_1dfunction vp9_filter_block1d4_v2_avg_ssse3;
 filter8_1dfunction vp9_filter_block1d4_h2_avg_ssse3;
 
+convolve_function vp9_convolve8_horiz_scaled_ssse3;
+convolve_function vp9_convolve8_vert_scaled_ssse3;
+convolve_function vp9_convolve8_avg_horiz_scaled_ssse3;
+convolve_function vp9_convolve8_avg_vert_scaled_ssse3;
+convolve_function vp9_convolve8_scaled_ssse3;
+convolve_function vp9_convolve8_avg_scaled_ssse3;
+
 // void vp9_convolve8_horiz_ssse3(const uint8_t *src, ptrdiff_t src_stride,
 //                                uint8_t *dst, ptrdiff_t dst_stride,
 //                                const int16_t *filter_x, int x_step_q4,
@@ -252,11 +273,13 @@ filter8_1dfunction vp9_filter_block1d4_h2_avg_ssse3;
 //                                   const int16_t *filter_x, int x_step_q4,
 //                                   const int16_t *filter_y, int y_step_q4,
 //                                   int w, int h);
-FUN_CONV_1D(horiz, x_step_q4, filter_x, h, src, , ssse3);
-FUN_CONV_1D(vert, y_step_q4, filter_y, v, src - src_stride * 3, , ssse3);
-FUN_CONV_1D(avg_horiz, x_step_q4, filter_x, h, src, avg_, ssse3);
+FUN_CONV_1D(horiz, x_step_q4, filter_x, h, src, , ssse3, scaled_ssse3);
+FUN_CONV_1D(vert, y_step_q4, filter_y, v, src - src_stride * 3, , ssse3,
+            scaled_ssse3);
+FUN_CONV_1D(avg_horiz, x_step_q4, filter_x, h, src, avg_, ssse3,
+            scaled_ssse3);
 FUN_CONV_1D(avg_vert, y_step_q4, filter_y, v, src - src_stride * 3, avg_,
-            ssse3);
+            ssse3, scaled_ssse3);
 
 // void vp9_convolve8_ssse3(const uint8_t *src, ptrdiff_t src_stride,
 //                          uint8_t *dst, ptrdiff_t dst_stride,
@@ -268,8 +291,8 @@ FUN_CONV_1D(avg_vert, y_step_q4, filter_y, v, src - src_stride * 3, avg_,
 //                              const int16_t *filter_x, int x_step_q4,
 //                              const int16_t *filter_y, int y_step_q4,
 //                              int w, int h);
-FUN_CONV_2D(, ssse3);
-FUN_CONV_2D(avg_ , ssse3);
+FUN_CONV_2D(, ssse3, scaled_ssse3);
+FUN_CONV_2D(avg_ , ssse3, scaled_ssse3);
 #endif  // HAVE_SSSE3
 
 #if HAVE_SSE2
@@ -319,10 +342,11 @@ filter8_1dfunction vp9_filter_block1d4_h2_avg_sse2;
 //                                  const int16_t *filter_x, int x_step_q4,
 //                                  const int16_t *filter_y, int y_step_q4,
 //                                  int w, int h);
-FUN_CONV_1D(horiz, x_step_q4, filter_x, h, src, , sse2);
-FUN_CONV_1D(vert, y_step_q4, filter_y, v, src - src_stride * 3, , sse2);
-FUN_CONV_1D(avg_horiz, x_step_q4, filter_x, h, src, avg_, sse2);
-FUN_CONV_1D(avg_vert, y_step_q4, filter_y, v, src - src_stride * 3, avg_, sse2);
+FUN_CONV_1D(horiz, x_step_q4, filter_x, h, src, , sse2, c);
+FUN_CONV_1D(vert, y_step_q4, filter_y, v, src - src_stride * 3, , sse2, c);
+FUN_CONV_1D(avg_horiz, x_step_q4, filter_x, h, src, avg_, sse2, c);
+FUN_CONV_1D(avg_vert, y_step_q4, filter_y, v, src - src_stride * 3, avg_, sse2,
+            c);
 
 // void vp9_convolve8_sse2(const uint8_t *src, ptrdiff_t src_stride,
 //                         uint8_t *dst, ptrdiff_t dst_stride,
@@ -334,6 +358,6 @@ FUN_CONV_1D(avg_vert, y_step_q4, filter_y, v, src - src_stride * 3, avg_, sse2);
 //                             const int16_t *filter_x, int x_step_q4,
 //                             const int16_t *filter_y, int y_step_q4,
 //                             int w, int h);
-FUN_CONV_2D(, sse2);
-FUN_CONV_2D(avg_ , sse2);
+FUN_CONV_2D(, sse2, c);
+FUN_CONV_2D(avg_ , sse2, c);
 #endif  // HAVE_SSE2
@@ -0,0 +1,874 @@
+/*
+ *  Copyright (c) 2015 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>  // AVX2
+
+#include "./vp9_rtcd.h"
+#include "vp9/common/vp9_idct.h"
+#include "vpx_ports/mem.h"
+
+// The 16 and 32-point 1-D transforms below work on 16 columns at once: in[k]
+// holds the k-th input of each column in its 16-bit lanes. The 4-point one
+// holds the 4x4 block in one register, two rows per 128-bit half. The 2-D
+// transforms transpose the block in between to apply them to the rows first,
+// then to the columns.
+// All the products are rounded as dct_const_round_shift() does, the results
+// match the C code bit for bit.
+
+#define pair256_set_epi16(a, b) \
+  _mm256_set_epi16(b, a, b, a, b, a, b, a, b, a, b, a, b, a, b, a)
+
+static INLINE __m256i round_shift_pack(__m256i lo, __m256i hi) {
+  const __m256i rounding = _mm256_set1_epi32(DCT_CONST_ROUNDING);
+  lo = _mm256_srai_epi32(_mm256_add_epi32(lo, rounding), DCT_CONST_BITS);
+  hi = _mm256_srai_epi32(_mm256_add_epi32(hi, rounding), DCT_CONST_BITS);
+  return _mm256_packs_epi32(lo, hi);
+}
+
+// out0 = a * c0 + b * c1, out1 = a * c2 + b * c3. 'out0' and 'out1' may
+// alias 'a' and 'b'.
+static INLINE void butterfly(const __m256i *a, const __m256i *b,
+                             int c0, int c1, int c2, int c3,
+                             __m256i *out0, __m256i *out1) {
+  const __m256i k0 = pair256_set_epi16(c0, c1);
+  const __m256i k1 = pair256_set_epi16(c2, c3);
+  const __m256i lo = _mm256_unpacklo_epi16(*a, *b);
+  const __m256i hi = _mm256_unpackhi_epi16(*a, *b);
+  *out0 = round_shift_pack(_mm256_madd_epi16(lo, k0),
+                           _mm256_madd_epi16(hi, k0));
+  *out1 = round_shift_pack(_mm256_madd_epi16(lo, k1),
+                           _mm256_madd_epi16(hi, k1));
+}
+
+// a * c, when the other input of the butterfly is known to be zero.
+static INLINE __m256i multiply(const __m256i *a, int c) {
+  // (a * 2c + (1 << 14)) >> 15 is the same as dct_const_round_shift(a * c).
+  return _mm256_mulhrs_epi16(*a, _mm256_set1_epi16(2 * c));
+}
+
+// Same as butterfly(), with the 32-bit sums kept for the ADST, which adds
+// two products before rounding: s[0] and s[1] hold the low and high lanes.
+static INLINE void butterfly_32(const __m256i *a, const __m256i *b,
+                                int c0, int c1, int c2, int c3,
+                                __m256i *s0, __m256i *s1) {
+  const __m256i k0 = pair256_set_epi16(c0, c1);
+  const __m256i k1 = pair256_set_epi16(c2, c3);
+  const __m256i lo = _mm256_unpacklo_epi16(*a, *b);
+  const __m256i hi = _mm256_unpackhi_epi16(*a, *b);
+  s0[0] = _mm256_madd_epi16(lo, k0);
+  s0[1] = _mm256_madd_epi16(hi, k0);
+  s1[0] = _mm256_madd_epi16(lo, k1);
+  s1[1] = _mm256_madd_epi16(hi, k1);
+}
+
+static INLINE __m256i add_round_shift(const __m256i *s0, const __m256i *s1) {
+  return round_shift_pack(_mm256_add_epi32(s0[0], s1[0]),
+                          _mm256_add_epi32(s0[1], s1[1]));
+}
+
+static INLINE __m256i sub_round_shift(const __m256i *s0, const __m256i *s1) {
+  return round_shift_pack(_mm256_sub_epi32(s0[0], s1[0]),
+                          _mm256_sub_epi32(s0[1], s1[1]));
+}
+
+// Transpose the 8x8 blocks held in each 128-bit half of in[0..7].
+static INLINE void transpose_8x8_lanes(const __m256i *in, __m256i *out) {
+  const __m256i tr0_0 = _mm256_unpacklo_epi16(in[0], in[1]);
+  const __m256i tr0_1 = _mm256_unpacklo_epi16(in[2], in[3]);
+  const __m256i tr0_2 = _mm256_unpackhi_epi16(in[0], in[1]);
+  const __m256i tr0_3 = _mm256_unpackhi_epi16(in[2], in[3]);
+  const __m256i tr0_4 = _mm256_unpacklo_epi16(in[4], in[5]);
+  const __m256i tr0_5 = _mm256_unpacklo_epi16(in[6], in[7]);
+  const __m256i tr0_6 = _mm256_unpackhi_epi16(in[4], in[5]);
+  const __m256i tr0_7 = _mm256_unpackhi_epi16(in[6], in[7]);
+
+  const __m256i tr1_0 = _mm256_unpacklo_epi32(tr0_0, tr0_1);
+  const __m256i tr1_1 = _mm256_unpacklo_epi32(tr0_4, tr0_5);
+  const __m256i tr1_2 = _mm256_unpackhi_epi32(tr0_0, tr0_1);
+  const __m256i tr1_3 = _mm256_unpackhi_epi32(tr0_4, tr0_5);
+  const __m256i tr1_4 = _mm256_unpacklo_epi32(tr0_2, tr0_3);
+  const __m256i tr1_5 = _mm256_unpacklo_epi32(tr0_6, tr0_7);
+  const __m256i tr1_6 = _mm256_unpackhi_epi32(tr0_2, tr0_3);
+  const __m256i tr1_7 = _mm256_unpackhi_epi32(tr0_6, tr0_7);
+
+  out[0] = _mm256_unpacklo_epi64(tr1_0, tr1_1);
+  out[1] = _mm256_unpackhi_epi64(tr1_0, tr1_1);
+  out[2] = _mm256_unpacklo_epi64(tr1_2, tr1_3);
+  out[3] = _mm256_unpackhi_epi64(tr1_2, tr1_3);
+  out[4] = _mm256_unpacklo_epi64(tr1_4, tr1_5);
+  out[5] = _mm256_unpackhi_epi64(tr1_4, tr1_5);
+  out[6] = _mm256_unpacklo_epi64(tr1_6, tr1_7);
+  out[7] = _mm256_unpackhi_epi64(tr1_6, tr1_7);
+}
+
+static INLINE void transpose_16x16(__m256i *in) {
+  __m256i tr[16];
+  int i;
+
+  // tr[i] holds columns i and i + 8 of rows 0-7 in its low and high halves,
+  // tr[i + 8] the same columns of rows 8-15.
+  transpose_8x8_lanes(in, tr);
+  transpose_8x8_lanes(in + 8, tr + 8);
+  for (i = 0; i < 8; ++i) {
+    in[i] = _mm256_permute2x128_si256(tr[i], tr[i + 8], 0x20);
+    in[i + 8] = _mm256_permute2x128_si256(tr[i], tr[i + 8], 0x31);
+  }
+}
+
+static INLINE void load_buffer_16x16(const int16_t *input, int stride,
+                                     __m256i *in) {
+  int i;
+  for (i = 0; i < 16; ++i)
+    in[i] = _mm256_loadu_si256((const __m256i *)(input + i * stride));
+}
+
+static INLINE int is_zero_16x16(const __m256i *in) {
+  __m256i acc = in[0];
+  int i;
+  for (i = 1; i < 16; ++i)
+    acc = _mm256_or_si256(acc, in[i]);
+  return _mm256_testz_si256(acc, acc);
+}
+
+// Round the 16 residuals of 'in' and add them to the pixels of 'dest'.
+static INLINE void recon_and_store_16(uint8_t *dest, __m256i in) {
+  const __m256i final_rounding = _mm256_set1_epi16(1 << 5);
+  const __m256i d = _mm256_cvtepu8_epi16(_mm_loadu_si128((__m128i *)dest));
+  __m256i res;
+
+  in = _mm256_srai_epi16(_mm256_adds_epi16(in, final_rounding), 6);
+  res = _mm256_add_epi16(d, in);
+  _mm_storeu_si128((__m128i *)dest,
+                   _mm_packus_epi16(_mm256_castsi256_si128(res),
+                                    _mm256_extracti128_si256(res, 1)));
+}
+
+static INLINE void write_buffer_16xn(const __m256i *in, int rows,
+                                     uint8_t *dest, int stride) {
+  int i;
+  for (i = 0; i < rows; ++i)
+    recon_and_store_16(dest + i * stride, in[i]);
+}
+
+// Add the DC-only residual 'a' to the 32 pixels of two 16-pixel rows, or one
+// 32-pixel row.
+static INLINE __m256i add_dc(__m256i d, int a) {
+  if (a >= 0)
+    return _mm256_adds_epu8(d, _mm256_set1_epi8((char)MIN(a, 255)));
+  else
+    return _mm256_subs_epu8(d, _mm256_set1_epi8((char)MIN(-a, 255)));
+}
+
+static INLINE int dc_only_residual(const int16_t *input) {
+  int a = dct_const_round_shift(input[0] * cospi_16_64);
+  a = dct_const_round_shift(a * cospi_16_64);
+  return ROUND_POWER_OF_TWO(a, 6);
+}
+
+// The 4-point IDCT of the 4 rows of 'in', two per 128-bit half, with their
+// inputs in the order 0, 2, 1, 3.
+static INLINE __m256i idct4_avx2(__m256i in) {
+  const __m256i k = _mm256_setr_epi16(
+      cospi_16_64, cospi_16_64, cospi_16_64, -cospi_16_64,
+      cospi_24_64, -cospi_8_64, cospi_8_64, cospi_24_64,
+      cospi_16_64, cospi_16_64, cospi_16_64, -cospi_16_64,
+      cospi_24_64, -cospi_8_64, cospi_8_64, cospi_24_64);
+  // step[0], step[1], step[1], step[0] and step[3], step[2], step[2], step[3]
+  // of each row.
+  const __m256i even = _mm256_setr_epi8(
+      0, 1, 2, 3, 2, 3, 0, 1, 8, 9, 10, 11, 10, 11, 8, 9,
+      0, 1, 2, 3, 2, 3, 0, 1, 8, 9, 10, 11, 10, 11, 8, 9);
+  const __m256i odd = _mm256_setr_epi8(
+      6, 7, 4, 5, 4, 5, 6, 7, 14, 15, 12, 13, 12, 13, 14, 15,
+      6, 7, 4, 5, 4, 5, 6, 7, 14, 15, 12, 13, 12, 13, 14, 15);
+  const __m256i sign = _mm256_setr_epi16(1, 1, -1, -1, 1, 1, -1, -1,
+                                         1, 1, -1, -1, 1, 1, -1, -1);
+  const __m256i rounding = _mm256_set1_epi32(DCT_CONST_ROUNDING);
+  __m256i row02 = _mm256_madd_epi16(_mm256_unpacklo_epi32(in, in), k);
+  __m256i row13 = _mm256_madd_epi16(_mm256_unpackhi_epi32(in, in), k);
+  __m256i step;
+
+  row02 = _mm256_srai_epi32(_mm256_add_epi32(row02, rounding),
+                            DCT_CONST_BITS);
+  row13 = _mm256_srai_epi32(_mm256_add_epi32(row13, rounding),
+                            DCT_CONST_BITS);
+  step = _mm256_packs_epi32(row02, row13);
+  return _mm256_adds_epi16(
+      _mm256_shuffle_epi8(step, even),
+      _mm256_sign_epi16(_mm256_shuffle_epi8(step, odd), sign));
+}
+
+// Transpose the 4x4 block of rows 0 and 1 in the low half of 'in' and rows 2
+// and 3 in the high half.
+static INLINE __m256i transpose_4x4(__m256i in) {
+  const __m256i pairs = _mm256_setr_epi8(
+      0, 1, 8, 9, 2, 3, 10, 11, 4, 5, 12, 13, 6, 7, 14, 15,
+      0, 1, 8, 9, 2, 3, 10, 11, 4, 5, 12, 13, 6, 7, 14, 15);
+  const __m256i columns = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+  // Pair up rows 0 and 1, and rows 2 and 3, of each column, then gather the
+  // pairs of each column.
+  in = _mm256_shuffle_epi8(in, pairs);
+  return _mm256_permutevar8x32_epi32(in, columns);
+}
+
+void vp9_idct4x4_16_add_avx2(const int16_t *input, uint8_t *dest,
+                             int stride) {
+  const __m256i order = _mm256_setr_epi8(
+      0, 1, 4, 5, 2, 3, 6, 7, 8, 9, 12, 13, 10, 11, 14, 15,
+      0, 1, 4, 5, 2, 3, 6, 7, 8, 9, 12, 13, 10, 11, 14, 15);
+  const __m256i final_rounding = _mm256_set1_epi16(1 << 3);
+  __m256i in = _mm256_loadu_si256((const __m256i *)input);
+  __m128i d;
+
+  in = idct4_avx2(_mm256_shuffle_epi8(in, order));
+  in = idct4_avx2(_mm256_shuffle_epi8(transpose_4x4(in), order));
+  in = transpose_4x4(in);
+  in = _mm256_srai_epi16(_mm256_adds_epi16(in, final_rounding), 4);
+
+  d = _mm_setr_epi32(*(const int *)dest, *(const int *)(dest + stride),
+                     *(const int *)(dest + 2 * stride),
+                     *(const int *)(dest + 3 * stride));
+  in = _mm256_add_epi16(_mm256_cvtepu8_epi16(d), in);
+  d = _mm_packus_epi16(_mm256_castsi256_si128(in),
+                       _mm256_extracti128_si256(in, 1));
+  *(int *)dest = _mm_cvtsi128_si32(d);
+  *(int *)(dest + stride) = _mm_extract_epi32(d, 1);
+  *(int *)(dest + 2 * stride) = _mm_extract_epi32(d, 2);
+  *(int *)(dest + 3 * stride) = _mm_extract_epi32(d, 3);
+}
+
+// Stages 3 to 7 of the 16-point IDCT, from the outputs of stage 2 in 'step2'.
+static INLINE void idct16_stages3_7(const __m256i *step2, __m256i *out) {
+  __m256i step1[16], step3[16];
+  int i;
+
+  // stage 3
+  step1[0] = step2[0];
+  step1[1] = step2[1];
+  step1[2] = step2[2];
+  step1[3] = step2[3];
+  butterfly(&step2[4], &step2[7], cospi_28_64, -cospi_4_64,
+            cospi_4_64, cospi_28_64, &step1[4], &step1[7]);
+  butterfly(&step2[5], &step2[6], cospi_12_64, -cospi_20_64,
+            cospi_20_64, cospi_12_64, &step1[5], &step1[6]);
+  step1[8] = _mm256_add_epi16(step2[8], step2[9]);
+  step1[9] = _mm256_sub_epi16(step2[8], step2[9]);
+  step1[10] = _mm256_sub_epi16(step2[11], step2[10]);
+  step1[11] = _mm256_add_epi16(step2[10], step2[11]);
+  step1[12] = _mm256_add_epi16(step2[12], step2[13]);
+  step1[13] = _mm256_sub_epi16(step2[12], step2[13]);
+  step1[14] = _mm256_sub_epi16(step2[15], step2[14]);
+  step1[15] = _mm256_add_epi16(step2[14], step2[15]);
+
+  // stage 4
+  butterfly(&step1[0], &step1[1], cospi_16_64, cospi_16_64,
+            cospi_16_64, -cospi_16_64, &step3[0], &step3[1]);
+  butterfly(&step1[2], &step1[3], cospi_24_64, -cospi_8_64,
+            cospi_8_64, cospi_24_64, &step3[2], &step3[3]);
+  step3[4] = _mm256_add_epi16(step1[4], step1[5]);
+  step3[5] = _mm256_sub_epi16(step1[4], step1[5]);
+  step3[6] = _mm256_sub_epi16(step1[7], step1[6]);
+  step3[7] = _mm256_add_epi16(step1[6], step1[7]);
+  step3[8] = step1[8];
+  butterfly(&step1[9], &step1[14], -cospi_8_64, cospi_24_64,
+            cospi_24_64, cospi_8_64, &step3[9], &step3[14]);
+  butterfly(&step1[10], &step1[13], -cospi_24_64, -cospi_8_64,
+            -cospi_8_64, cospi_24_64, &step3[10], &step3[13]);
+  step3[11] = step1[11];
+  step3[12] = step1[12];
+  step3[15] = step1[15];
+
+  // stage 5
+  step1[0] = _mm256_add_epi16(step3[0], step3[3]);
+  step1[1] = _mm256_add_epi16(step3[1], step3[2]);
+  step1[2] = _mm256_sub_epi16(step3[1], step3[2]);
+  step1[3] = _mm256_sub_epi16(step3[0], step3[3]);
+  step1[4] = step3[4];
+  butterfly(&step3[5], &step3[6], -cospi_16_64, cospi_16_64,
+            cospi_16_64, cospi_16_64, &step1[5], &step1[6]);
+  step1[7] = step3[7];
+  step1[8] = _mm256_add_epi16(step3[8], step3[11]);
+  step1[9] = _mm256_add_epi16(step3[9], step3[10]);
+  step1[10] = _mm256_sub_epi16(step3[9], step3[10]);
+  step1[11] = _mm256_sub_epi16(step3[8], step3[11]);
+  step1[12] = _mm256_sub_epi16(step3[15], step3[12]);
+  step1[13] = _mm256_sub_epi16(step3[14], step3[13]);
+  step1[14] = _mm256_add_epi16(step3[13], step3[14]);
+  step1[15] = _mm256_add_epi16(step3[12], step3[15]);
+
+  // stage 6
+  for (i = 0; i < 4; ++i) {
+    step3[i] = _mm256_add_epi16(step1[i], step1[7 - i]);
+    step3[7 - i] = _mm256_sub_epi16(step1[i], step1[7 - i]);
+  }
+  step3[8] = step1[8];
+  step3[9] = step1[9];
+  butterfly(&step1[10], &step1[13], -cospi_16_64, cospi_16_64,
+            cospi_16_64, cospi_16_64, &step3[10], &step3[13]);
+  butterfly(&step1[11], &step1[12], -cospi_16_64, cospi_16_64,
+            cospi_16_64, cospi_16_64, &step3[11], &step3[12]);
+  step3[14] = step1[14];
+  step3[15] = step1[15];
+
+  // stage 7
+  for (i = 0; i < 8; ++i) {
+    out[i] = _mm256_add_epi16(step3[i], step3[15 - i]);
+    out[15 - i] = _mm256_sub_epi16(step3[i], step3[15 - i]);
+  }
+}
+
+static void idct16_avx2(__m256i *in) {
+  __m256i step2[16];
+
+  // stages 1 and 2
+  step2[0] = in[0];
+  step2[1] = in[8];
+  step2[2] = in[4];
+  step2[3] = in[12];
+  step2[4] = in[2];
+  step2[5] = in[10];
+  step2[6] = in[6];
+  step2[7] = in[14];
+  butterfly(&in[1], &in[15], cospi_30_64, -cospi_2_64,
+            cospi_2_64, cospi_30_64, &step2[8], &step2[15]);
+  butterfly(&in[9], &in[7], cospi_14_64, -cospi_18_64,
+            cospi_18_64, cospi_14_64, &step2[9], &step2[14]);
+  butterfly(&in[5], &in[11], cospi_22_64, -cospi_10_64,
+            cospi_10_64, cospi_22_64, &step2[10], &step2[13]);
+  butterfly(&in[13], &in[3], cospi_6_64, -cospi_26_64,
+            cospi_26_64, cospi_6_64, &step2[11], &step2[12]);
+
+  idct16_stages3_7(step2, in);
+}
+
+// 16-point IDCT of inputs where only in[0..3] may be non-zero.
+static void idct16_4_avx2(__m256i *in) {
+  const __m256i zero = _mm256_setzero_si256();
+  __m256i step2[16];
+
+  // stages 1 and 2
+  step2[0] = in[0];
+  step2[1] = zero;
+  step2[2] = zero;
+  step2[3] = zero;
+  step2[4] = in[2];
+  step2[5] = zero;
+  step2[6] = zero;
+  step2[7] = zero;
+  step2[8] = multiply(&in[1], cospi_30_64);
+  step2[9] = zero;
+  step2[10] = zero;
+  step2[11] = multiply(&in[3], -cospi_26_64);
+  step2[12] = multiply(&in[3], cospi_6_64);
+  step2[13] = zero;
+  step2[14] = zero;
+  step2[15] = multiply(&in[1], cospi_2_64);
+
+  idct16_stages3_7(step2, in);
+}
+
+static void iadst16_avx2(__m256i *in) {
+  const __m256i zero = _mm256_setzero_si256();
+  __m256i s[16][2];
+  __m256i x[16], y[16];
+  int i;
+
+  // stage 1
+  butterfly_32(&in[15], &in[0], cospi_1_64, cospi_31_64,
+               cospi_31_64, -cospi_1_64, s[0], s[1]);
+  butterfly_32(&in[13], &in[2], cospi_5_64, cospi_27_64,
+               cospi_27_64, -cospi_5_64, s[2], s[3]);
+  butterfly_32(&in[11], &in[4], cospi_9_64, cospi_23_64,
+               cospi_23_64, -cospi_9_64, s[4], s[5]);
+  butterfly_32(&in[9], &in[6], cospi_13_64, cospi_19_64,
+               cospi_19_64, -cospi_13_64, s[6], s[7]);
+  butterfly_32(&in[7], &in[8], cospi_17_64, cospi_15_64,
+               cospi_15_64, -cospi_17_64, s[8], s[9]);
+  butterfly_32(&in[5], &in[10], cospi_21_64, cospi_11_64,
+               cospi_11_64, -cospi_21_64, s[10], s[11]);
+  butterfly_32(&in[3], &in[12], cospi_25_64, cospi_7_64,
+               cospi_7_64, -cospi_25_64, s[12], s[13]);
+  butterfly_32(&in[1], &in[14], cospi_29_64, cospi_3_64,
+               cospi_3_64, -cospi_29_64, s[14], s[15]);
+  for (i = 0; i < 8; ++i) {
+    x[i] = add_round_shift(s[i], s[i + 8]);
+    x[i + 8] = sub_round_shift(s[i], s[i + 8]);
+  }
+
+  // stage 2
+  butterfly_32(&x[8], &x[9], cospi_4_64, cospi_28_64,
+               cospi_28_64, -cospi_4_64, s[8], s[9]);
+  butterfly_32(&x[10], &x[11], cospi_20_64, cospi_12_64,
+               cospi_12_64, -cospi_20_64, s[10], s[11]);
+  butterfly_32(&x[12], &x[13], -cospi_28_64, cospi_4_64,
+               cospi_4_64, cospi_28_64, s[12], s[13]);
+  butterfly_32(&x[14], &x[15], -cospi_12_64, cospi_20_64,
+               cospi_20_64, cospi_12_64, s[14], s[15]);
+  for (i = 0; i < 4; ++i) {
+    y[i] = _mm256_add_epi16(x[i], x[i + 4]);
+    y[i + 4] = _mm256_sub_epi16(x[i], x[i + 4]);
+    y[i + 8] = add_round_shift(s[i + 8], s[i + 12]);
+    y[i + 12] = sub_round_shift(s[i + 8], s[i + 12]);
+  }
+
+  // stage 3
+  butterfly_32(&y[4], &y[5], cospi_8_64, cospi_24_64,
+               cospi_24_64, -cospi_8_64, s[4], s[5]);
+  butterfly_32(&y[6], &y[7], -cospi_24_64, cospi_8_64,
+               cospi_8_64, cospi_24_64, s[6], s[7]);
+  butterfly_32(&y[12], &y[13], cospi_8_64, cospi_24_64,
+               cospi_24_64, -cospi_8_64, s[12], s[13]);
+  butterfly_32(&y[14], &y[15], -cospi_24_64, cospi_8_64,
+               cospi_8_64, cospi_24_64, s[14], s[15]);
+  for (i = 0; i < 16; i += 8) {
+    x[i] = _mm256_add_epi16(y[i], y[i + 2]);
+    x[i + 1] = _mm256_add_epi16(y[i + 1], y[i + 3]);
+    x[i + 2] = _mm256_sub_epi16(y[i], y[i + 2]);
+    x[i + 3] = _mm256_sub_epi16(y[i + 1], y[i + 3]);
+    x[i + 4] = add_round_shift(s[i + 4], s[i + 6]);
+    x[i + 5] = add_round_shift(s[i + 5], s[i + 7]);
+    x[i + 6] = sub_round_shift(s[i + 4], s[i + 6]);
+    x[i + 7] = sub_round_shift(s[i + 5], s[i + 7]);
+  }
+
+  // stage 4
+  butterfly(&x[2], &x[3], -cospi_16_64, -cospi_16_64,
+            cospi_16_64, -cospi_16_64, &x[2], &x[3]);
+  butterfly(&x[6], &x[7], cospi_16_64, cospi_16_64,
+            -cospi_16_64, cospi_16_64, &x[6], &x[7]);
+  butterfly(&x[10], &x[11], cospi_16_64, cospi_16_64,
+            -cospi_16_64, cospi_16_64, &x[10], &x[11]);
+  butterfly(&x[14], &x[15], -cospi_16_64, -cospi_16_64,
+            cospi_16_64, -cospi_16_64, &x[14], &x[15]);
+
+  in[0] = x[0];
+  in[1] = _mm256_sub_epi16(zero, x[8]);
+  in[2] = x[12];
+  in[3] = _mm256_sub_epi16(zero, x[4]);
+  in[4] = x[6];
+  in[5] = x[14];
+  in[6] = x[10];
+  in[7] = x[2];
+  in[8] = x[3];
+  in[9] = x[11];
+  in[10] = x[15];
+  in[11] = x[7];
+  in[12] = x[5];
+  in[13] = _mm256_sub_epi16(zero, x[13]);
+  in[14] = x[9];
+  in[15] = _mm256_sub_epi16(zero, x[1]);
+}
+
+void vp9_idct16x16_256_add_avx2(const int16_t *input, uint8_t *dest,
+                                int stride) {
+  __m256i in[16];
+
+  load_buffer_16x16(input, 16, in);
+  transpose_16x16(in);
+  idct16_avx2(in);
+  transpose_16x16(in);
+  idct16_avx2(in);
+  write_buffer_16xn(in, 16, dest, stride);
+}
+
+void vp9_iht16x16_256_add_avx2(const int16_t *input, uint8_t *dest,
+                               int stride, int tx_type) {
+  __m256i in[16];
+
+  load_buffer_16x16(input, 16, in);
+  transpose_16x16(in);
+  switch (tx_type) {
+    case 0:  // DCT_DCT
+      idct16_avx2(in);
+      transpose_16x16(in);
+      idct16_avx2(in);
+      break;
+    case 1:  // ADST_DCT
+      idct16_avx2(in);
+      transpose_16x16(in);
+      iadst16_avx2(in);
+      break;
+    case 2:  // DCT_ADST
+      iadst16_avx2(in);
+      transpose_16x16(in);
+      idct16_avx2(in);
+      break;
+    case 3:  // ADST_ADST
+      iadst16_avx2(in);
+      transpose_16x16(in);
+      iadst16_avx2(in);
+      break;
+    default:
+      assert(0);
+      break;
+  }
+  write_buffer_16xn(in, 16, dest, stride);
+}
+
+void vp9_idct16x16_10_add_avx2(const int16_t *input, uint8_t *dest,
+                               int stride) {
+  const __m256i zero = _mm256_setzero_si256();
+  __m256i in[16];
+  int i;
+
+  // Only the upper-left 4x4 coefficients are non-zero, so are only the first
+  // 4 rows after the row transform.
+  for (i = 0; i < 4; ++i)
+    in[i] = _mm256_loadu_si256((const __m256i *)(input + i * 16));
+  for (i = 4; i < 16; ++i)
+    in[i] = zero;
+  transpose_16x16(in);
+  idct16_4_avx2(in);
+  transpose_16x16(in);
+  idct16_4_avx2(in);
+  write_buffer_16xn(in, 16, dest, stride);
+}
+
+void vp9_idct16x16_1_add_avx2(const int16_t *input, uint8_t *dest,
+                              int stride) {
+  const int a = dc_only_residual(input);
+  int i;
+
+  for (i = 0; i < 16; i += 2) {
+    const __m128i d0 = _mm_loadu_si128((const __m128i *)dest);
+    const __m128i d1 = _mm_loadu_si128((const __m128i *)(dest + stride));
+    const __m256i d = add_dc(
+        _mm256_inserti128_si256(_mm256_castsi128_si256(d0), d1, 1), a);
+    _mm_storeu_si128((__m128i *)dest, _mm256_castsi256_si128(d));
+    _mm_storeu_si128((__m128i *)(dest + stride),
+                     _mm256_extracti128_si256(d, 1));
+    dest += 2 * stride;
+  }
+}
+
+// Stage 2 additions of the 32-point IDCT, on the odd half of stage 1.
+static INLINE void idct32_stage2_odd(const __m256i *step1, __m256i *step2) {
+  int i;
+  for (i = 16; i < 32; i += 4) {
+    step2[i] = _mm256_add_epi16(step1[i], step1[i + 1]);
+    step2[i + 1] = _mm256_sub_epi16(step1[i], step1[i + 1]);
+    step2[i + 2] = _mm256_sub_epi16(step1[i + 3], step1[i + 2]);
+    step2[i + 3] = _mm256_add_epi16(step1[i + 2], step1[i + 3]);
+  }
+}
+
+// Stages 3 to 7 of the 32-point IDCT, from the outputs of stage 2 in 'step2'.
+static void idct32_stages3_7(const __m256i *step2, __m256i *out) {
+  __m256i step1[32], step3[32];
+  int i;
+
+  // stage 3
+  step1[0] = step2[0];
+  step1[1] = step2[1];
+  step1[2] = step2[2];
+  step1[3] = step2[3];
+  butterfly(&step2[4], &step2[7], cospi_28_64, -cospi_4_64,
+            cospi_4_64, cospi_28_64, &step1[4], &step1[7]);
+  butterfly(&step2[5], &step2[6], cospi_12_64, -cospi_20_64,
+            cospi_20_64, cospi_12_64, &step1[5], &step1[6]);
+  for (i = 8; i < 16; i += 4) {
+    step1[i] = _mm256_add_epi16(step2[i], step2[i + 1]);
+    step1[i + 1] = _mm256_sub_epi16(step2[i], step2[i + 1]);
+    step1[i + 2] = _mm256_sub_epi16(step2[i + 3], step2[i + 2]);
+    step1[i + 3] = _mm256_add_epi16(step2[i + 2], step2[i + 3]);
+  }
+  step1[16] = step2[16];
+  butterfly(&step2[17], &step2[30], -cospi_4_64, cospi_28_64,
+            cospi_28_64, cospi_4_64, &step1[17], &step1[30]);
+  butterfly(&step2[18], &step2[29], -cospi_28_64, -cospi_4_64,
+            -cospi_4_64, cospi_28_64, &step1[18], &step1[29]);
+  step1[19] = step2[19];
+  step1[20] = step2[20];
+  butterfly(&step2[21], &step2[26], -cospi_20_64, cospi_12_64,
+            cospi_12_64, cospi_20_64, &step1[21], &step1[26]);
+  butterfly(&step2[22], &step2[25], -cospi_12_64, -cospi_20_64,
+            -cospi_20_64, cospi_12_64, &step1[22], &step1[25]);
+  step1[23] = step2[23];
+  step1[24] = step2[24];
+  step1[27] = step2[27];
+  step1[28] = step2[28];
+  step1[31] = step2[31];
+
+  // stage 4
+  butterfly(&step1[0], &step1[1], cospi_16_64, cospi_16_64,
+            cospi_16_64, -cospi_16_64, &step3[0], &step3[1]);
+  butterfly(&step1[2], &step1[3], cospi_24_64, -cospi_8_64,
+            cospi_8_64, cospi_24_64, &step3[2], &step3[3]);
+  step3[4] = _mm256_add_epi16(step1[4], step1[5]);
+  step3[5] = _mm256_sub_epi16(step1[4], step1[5]);
+  step3[6] = _mm256_sub_epi16(step1[7], step1[6]);
+  step3[7] = _mm256_add_epi16(step1[6], step1[7]);
+  step3[8] = step1[8];
+  butterfly(&step1[9], &step1[14], -cospi_8_64, cospi_24_64,
+            cospi_24_64, cospi_8_64, &step3[9], &step3[14]);
+  butterfly(&step1[10], &step1[13], -cospi_24_64, -cospi_8_64,
+            -cospi_8_64, cospi_24_64, &step3[10], &step3[13]);
+  step3[11] = step1[11];
+  step3[12] = step1[12];
+  step3[15] = step1[15];
+  for (i = 16; i < 32; i += 8) {
+    step3[i] = _mm256_add_epi16(step1[i], step1[i + 3]);
+    step3[i + 1] = _mm256_add_epi16(step1[i + 1], step1[i + 2]);
+    step3[i + 2] = _mm256_sub_epi16(step1[i + 1], step1[i + 2]);
+    step3[i + 3] = _mm256_sub_epi16(step1[i], step1[i + 3]);
+    step3[i + 4] = _mm256_sub_epi16(step1[i + 7], step1[i + 4]);
+    step3[i + 5] = _mm256_sub_epi16(step1[i + 6], step1[i + 5]);
+    step3[i + 6] = _mm256_add_epi16(step1[i + 5], step1[i + 6]);
+    step3[i + 7] = _mm256_add_epi16(step1[i + 4], step1[i + 7]);
+  }
+
+  // stage 5
+  step1[0] = _mm256_add_epi16(step3[0], step3[3]);
+  step1[1] = _mm256_add_epi16(step3[1], step3[2]);
+  step1[2] = _mm256_sub_epi16(step3[1], step3[2]);
+  step1[3] = _mm256_sub_epi16(step3[0], step3[3]);
+  step1[4] = step3[4];
+  butterfly(&step3[5], &step3[6], -cospi_16_64, cospi_16_64,
+            cospi_16_64, cospi_16_64, &step1[5], &step1[6]);
+  step1[7] = step3[7];
+  step1[8] = _mm256_add_epi16(step3[8], step3[11]);
+  step1[9] = _mm256_add_epi16(step3[9], step3[10]);
+  step1[10] = _mm256_sub_epi16(step3[9], step3[10]);
+  step1[11] = _mm256_sub_epi16(step3[8], step3[11]);
+  step1[12] = _mm256_sub_epi16(step3[15], step3[12]);
+  step1[13] = _mm256_sub_epi16(step3[14], step3[13]);
+  step1[14] = _mm256_add_epi16(step3[13], step3[14]);
+  step1[15] = _mm256_add_epi16(step3[12], step3[15]);
+  step1[16] = step3[16];
+  step1[17] = step3[17];
+  butterfly(&step3[18], &step3[29], -cospi_8_64, cospi_24_64,
+            cospi_24_64, cospi_8_64, &step1[18], &step1[29]);
+  butterfly(&step3[19], &step3[28], -cospi_8_64, cospi_24_64,
+            cospi_24_64, cospi_8_64, &step1[19], &step1[28]);
+  butterfly(&step3[20], &step3[27], -cospi_24_64, -cospi_8_64,
+            -cospi_8_64, cospi_24_64, &step1[20], &step1[27]);
+  butterfly(&step3[21], &step3[26], -cospi_24_64, -cospi_8_64,
+            -cospi_8_64, cospi_24_64, &step1[21], &step1[26]);
+  step1[22] = step3[22];
+  step1[23] = step3[23];
+  step1[24] = step3[24];
+  step1[25] = step3[25];
+  step1[30] = step3[30];
+  step1[31] = step3[31];
+
+  // stage 6
+  for (i = 0; i < 4; ++i) {
+    step3[i] = _mm256_add_epi16(step1[i], step1[7 - i]);
+    step3[7 - i] = _mm256_sub_epi16(step1[i], step1[7 - i]);
+  }
+  step3[8] = step1[8];
+  step3[9] = step1[9];
+  butterfly(&step1[10], &step1[13], -cospi_16_64, cospi_16_64,
+            cospi_16_64, cospi_16_64, &step3[10], &step3[13]);
+  butterfly(&step1[11], &step1[12], -cospi_16_64, cospi_16_64,
+            cospi_16_64, cospi_16_64, &step3[11], &step3[12]);
+  step3[14] = step1[14];
+  step3[15] = step1[15];
+  for (i = 0; i < 4; ++i) {
+    step3[16 + i] = _mm256_add_epi16(step1[16 + i], step1[23 - i]);
+    step3[23 - i] = _mm256_sub_epi16(step1[16 + i], step1[23 - i]);
+    step3[24 + i] = _mm256_sub_epi16(step1[31 - i], step1[24 + i]);
+    step3[31 - i] = _mm256_add_epi16(step1[24 + i], step1[31 - i]);
+  }
+
+  // stage 7
+  for (i = 0; i < 8; ++i) {
+    step1[i] = _mm256_add_epi16(step3[i], step3[15 - i]);
+    step1[15 - i] = _mm256_sub_epi16(step3[i], step3[15 - i]);
+  }
+  for (i = 16; i < 20; ++i)
+    step1[i] = step3[i];
+  for (i = 20; i < 24; ++i)
+    butterfly(&step3[i], &step3[47 - i], -cospi_16_64, cospi_16_64,
+              cospi_16_64, cospi_16_64, &step1[i], &step1[47 - i]);
+  for (i = 28; i < 32; ++i)
+    step1[i] = step3[i];
+
+  // final stage
+  for (i = 0; i < 16; ++i) {
+    out[i] = _mm256_add_epi16(step1[i], step1[31 - i]);
+    out[31 - i] = _mm256_sub_epi16(step1[i], step1[31 - i]);
+  }
+}
+
+static void idct32_avx2(__m256i *in) {
+  __m256i step1[32], step2[32];
+
+  // stage 1
+  butterfly(&in[1], &in[31], cospi_31_64, -cospi_1_64,
+            cospi_1_64, cospi_31_64, &step1[16], &step1[31]);
+  butterfly(&in[17], &in[15], cospi_15_64, -cospi_17_64,
+            cospi_17_64, cospi_15_64, &step1[17], &step1[30]);
+  butterfly(&in[9], &in[23], cospi_23_64, -cospi_9_64,
+            cospi_9_64, cospi_23_64, &step1[18], &step1[29]);
+  butterfly(&in[25], &in[7], cospi_7_64, -cospi_25_64,
+            cospi_25_64, cospi_7_64, &step1[19], &step1[28]);
+  butterfly(&in[5], &in[27], cospi_27_64, -cospi_5_64,
+            cospi_5_64, cospi_27_64, &step1[20], &step1[27]);
+  butterfly(&in[21], &in[11], cospi_11_64, -cospi_21_64,
+            cospi_21_64, cospi_11_64, &step1[21], &step1[26]);
+  butterfly(&in[13], &in[19], cospi_19_64, -cospi_13_64,
+            cospi_13_64, cospi_19_64, &step1[22], &step1[25]);
+  butterfly(&in[29], &in[3], cospi_3_64, -cospi_29_64,
+            cospi_29_64, cospi_3_64, &step1[23], &step1[24]);
+
+  // stage 2
+  step2[0] = in[0];
+  step2[1] = in[16];
+  step2[2] = in[8];
+  step2[3] = in[24];
+  step2[4] = in[4];
+  step2[5] = in[20];
+  step2[6] = in[12];
+  step2[7] = in[28];
+  butterfly(&in[2], &in[30], cospi_30_64, -cospi_2_64,
+            cospi_2_64, cospi_30_64, &step2[8], &step2[15]);
+  butterfly(&in[18], &in[14], cospi_14_64, -cospi_18_64,
+            cospi_18_64, cospi_14_64, &step2[9], &step2[14]);
+  butterfly(&in[10], &in[22], cospi_22_64, -cospi_10_64,
+            cospi_10_64, cospi_22_64, &step2[10], &step2[13]);
+  butterfly(&in[26], &in[6], cospi_6_64, -cospi_26_64,
+            cospi_26_64, cospi_6_64, &step2[11], &step2[12]);
+  idct32_stage2_odd(step1, step2);
+
+  idct32_stages3_7(step2, in);
+}
+
+// 32-point IDCT of inputs where only in[0..7] may be non-zero.
+static void idct32_8_avx2(__m256i *in) {
+  const __m256i zero = _mm256_setzero_si256();
+  __m256i step1[32], step2[32];
+
+  // stage 1
+  step1[16] = multiply(&in[1], cospi_31_64);
+  step1[17] = zero;
+  step1[18] = zero;
+  step1[19] = multiply(&in[7], -cospi_25_64);
+  step1[20] = multiply(&in[5], cospi_27_64);
+  step1[21] = zero;
+  step1[22] = zero;
+  step1[23] = multiply(&in[3], -cospi_29_64);
+  step1[24] = multiply(&in[3], cospi_3_64);
+  step1[25] = zero;
+  step1[26] = zero;
+  step1[27] = multiply(&in[5], cospi_5_64);
+  step1[28] = multiply(&in[7], cospi_7_64);
+  step1[29] = zero;
+  step1[30] = zero;
+  step1[31] = multiply(&in[1], cospi_1_64);
+
+  // stage 2
+  step2[0] = in[0];
+  step2[1] = zero;
+  step2[2] = zero;
+  step2[3] = zero;
+  step2[4] = in[4];
+  step2[5] = zero;
+  step2[6] = zero;
+  step2[7] = zero;
+  step2[8] = multiply(&in[2], cospi_30_64);
+  step2[9] = zero;
+  step2[10] = zero;
+  step2[11] = multiply(&in[6], -cospi_26_64);
+  step2[12] = multiply(&in[6], cospi_6_64);
+  step2[13] = zero;
+  step2[14] = zero;
+  step2[15] = multiply(&in[2], cospi_2_64);
+  idct32_stage2_odd(step1, step2);
+
+  idct32_stages3_7(step2, in);
+}
+
+// Transform the columns of the 32x32 block whose row transform is stored
+// transposed in 'out', 16 columns at a time. Only the first 'rows' rows of the
+// row transform may be non-zero.
+static void idct32_columns(const int16_t *out, int rows, uint8_t *dest,
+                           int stride) {
+  const __m256i zero = _mm256_setzero_si256();
+  __m256i in[32];
+  int i, j;
+
+  for (i = 0; i < 2; ++i) {
+    const int16_t *const col = out + i * 16 * 32;
+    load_buffer_16x16(col, 32, in);
+    transpose_16x16(in);
+    if (rows <= 8) {
+      idct32_8_avx2(in);
+    } else if (rows <= 16) {
+      for (j = 16; j < 32; ++j)
+        in[j] = zero;
+      idct32_avx2(in);
+    } else {
+      load_buffer_16x16(col + 16, 32, in + 16);
+      transpose_16x16(in + 16);
+      idct32_avx2(in);
+    }
+    write_buffer_16xn(in, 32, dest + i * 16, stride);
+  }
+}
+
+void vp9_idct32x32_1024_add_avx2(const int16_t *input, uint8_t *dest,
+                                 int stride) {
+  DECLARE_ALIGNED(32, int16_t, out[32 * 32]);
+  __m256i in[32];
+  int i, j;
+
+  // Rows, 16 at a time. out[] holds the result transposed: the column
+  // transform then loads the rows it works on as 16x16 blocks.
+  for (i = 0; i < 2; ++i) {
+    load_buffer_16x16(input + i * 16 * 32, 32, in);
+    load_buffer_16x16(input + i * 16 * 32 + 16, 32, in + 16);
+    if (is_zero_16x16(in) && is_zero_16x16(in + 16)) {
+      for (j = 0; j < 32; ++j)
+        _mm256_store_si256((__m256i *)(out + j * 32 + i * 16), in[0]);
+      continue;
+    }
+    transpose_16x16(in);
+    transpose_16x16(in + 16);
+    idct32_avx2(in);
+    for (j = 0; j < 32; ++j)
+      _mm256_store_si256((__m256i *)(out + j * 32 + i * 16), in[j]);
+  }
+
+  idct32_columns(out, 32, dest, stride);
+}
+
+void vp9_idct32x32_34_add_avx2(const int16_t *input, uint8_t *dest,
+                               int stride) {
+  DECLARE_ALIGNED(32, int16_t, out[32 * 32]);
+  const __m256i zero = _mm256_setzero_si256();
+  __m256i in[32];
+  int i;
+
+  // Only the upper-left 8x8 coefficients are non-zero, so are only the first
+  // 8 rows after the row transform.
+  for (i = 0; i < 8; ++i)
+    in[i] = _mm256_loadu_si256((const __m256i *)(input + i * 32));
+  for (i = 8; i < 16; ++i)
+    in[i] = zero;
+  transpose_16x16(in);
+  idct32_8_avx2(in);
+  for (i = 0; i < 32; ++i)
+    _mm256_store_si256((__m256i *)(out + i * 32), in[i]);
+
+  idct32_columns(out, 8, dest, stride);
+}
+
+void vp9_idct32x32_1_add_avx2(const int16_t *input, uint8_t *dest,
+                              int stride) {
+  const int a = dc_only_residual(input);
+  int i;
+
+  for (i = 0; i < 32; ++i) {
+    const __m256i d = _mm256_loadu_si256((const __m256i *)dest);
+    _mm256_storeu_si256((__m256i *)dest, add_dc(d, a));
+    dest += stride;
+  }
+}
@@ -8,7 +8,9 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include "./vp9_rtcd.h"
 #include "vp9/common/x86/vp9_idct_intrin_sse2.h"
+#include "vpx_ports/mem.h"
 
 #define RECON_AND_STORE4X4(dest, in_x) \
 {                                                     \
@@ -3985,3 +3987,1237 @@ void vp9_idct32x32_1_add_sse2(const int16_t *input, uint8_t *dest, int stride) {
     dest += 8 - (stride * 32);
   }
 }
+
+#if CONFIG_VP9_HIGHBITDEPTH
+// The high bitdepth inverse transforms run the 16 bit kernels above when the
+// coefficients entering each pass are small enough for all of their stages to
+// stay exact, the 32 bit versions below otherwise.
+//
+// Largest input of each kernel for which none of its 16 bit stages overflow,
+// with a small margin. Checked with all the inputs of +/-max (the extremes of
+// every stage) against the C transforms.
+#define HIGH_IDCT4_MAX   11900
+#define HIGH_IADST4_MAX  10800
+#define HIGH_IDCT8_MAX   6100
+#define HIGH_IADST8_MAX  6300
+#define HIGH_IDCT16_MAX  3100
+#define HIGH_IADST16_MAX 3150
+
+static INLINE __m128i high_load_coeffs(const tran_low_t *input) {
+  return _mm_packs_epi32(_mm_loadu_si128((const __m128i *)input),
+                         _mm_loadu_si128((const __m128i *)(input + 4)));
+}
+
+// Returns non-zero if one of the coefficients of 'in' is out of [-max, max].
+// The ones saturated by high_load_coeffs() always are.
+static INLINE int high_out_of_range(const __m128i *in, int n, int max) {
+  const __m128i hi = _mm_set1_epi16(max);
+  const __m128i lo = _mm_set1_epi16(-max);
+  __m128i out = _mm_setzero_si128();
+  int i;
+
+  for (i = 0; i < n; ++i) {
+    out = _mm_or_si128(out, _mm_cmpgt_epi16(in[i], hi));
+    out = _mm_or_si128(out, _mm_cmplt_epi16(in[i], lo));
+  }
+  return _mm_movemask_epi8(out);
+}
+
+// ROUND_POWER_OF_TWO() of the residuals, the rounding offset is added after
+// the shift so that it cannot overflow.
+static INLINE __m128i high_round_shift(__m128i in, int bits) {
+  const __m128i one = _mm_set1_epi16(1);
+  return _mm_add_epi16(_mm_srai_epi16(in, bits),
+                       _mm_and_si128(_mm_srai_epi16(in, bits - 1), one));
+}
+
+// Adds the residuals to 8 (4) pixels, clamped to [0, max].
+static INLINE void high_recon_8(uint16_t *dest, __m128i res, __m128i max) {
+  const __m128i d = _mm_add_epi16(_mm_loadu_si128((const __m128i *)dest), res);
+  _mm_storeu_si128((__m128i *)dest,
+                   _mm_max_epi16(_mm_min_epi16(d, max), _mm_setzero_si128()));
+}
+
+static INLINE void high_recon_4(uint16_t *dest, __m128i res, __m128i max) {
+  const __m128i d = _mm_add_epi16(_mm_loadl_epi64((const __m128i *)dest), res);
+  _mm_storel_epi64((__m128i *)dest,
+                   _mm_max_epi16(_mm_min_epi16(d, max), _mm_setzero_si128()));
+}
+
+// One pass of the 4x4, 8x8 and 16x16 transforms, returns 0 without running
+// it if its input is out of range.
+static INLINE int high_txfm4(__m128i *in, int adst) {
+  if (high_out_of_range(in, 2, adst ? HIGH_IADST4_MAX : HIGH_IDCT4_MAX))
+    return 0;
+  if (adst)
+    iadst4_sse2(in);
+  else
+    idct4_sse2(in);
+  return 1;
+}
+
+static INLINE int high_txfm8(__m128i *in, int adst) {
+  if (high_out_of_range(in, 8, adst ? HIGH_IADST8_MAX : HIGH_IDCT8_MAX))
+    return 0;
+  if (adst)
+    iadst8_sse2(in);
+  else
+    idct8_sse2(in);
+  return 1;
+}
+
+static INLINE int high_txfm16(__m128i *in0, __m128i *in1, int adst) {
+  const int max = adst ? HIGH_IADST16_MAX : HIGH_IDCT16_MAX;
+  if (high_out_of_range(in0, 16, max) || high_out_of_range(in1, 16, max))
+    return 0;
+  if (adst)
+    iadst16_sse2(in0, in1);
+  else
+    idct16_sse2(in0, in1);
+  return 1;
+}
+
+// The 2D transforms, the rows are ADST for the tx_types 2 and 3 (DCT_ADST and
+// ADST_ADST), the columns for 1 and 3 (ADST_DCT and ADST_ADST).
+static int high_iht4x4_add(const tran_low_t *input, uint16_t *dest, int stride,
+                           int tx_type, int bd) {
+  const __m128i max = _mm_set1_epi16((1 << bd) - 1);
+  __m128i in[2];
+
+  in[0] = high_load_coeffs(input);
+  in[1] = high_load_coeffs(input + 8);
+  if (!high_txfm4(in, tx_type & 2) || !high_txfm4(in, tx_type & 1))
+    return 0;
+
+  in[0] = high_round_shift(in[0], 4);
+  in[1] = high_round_shift(in[1], 4);
+  high_recon_4(dest, in[0], max);
+  high_recon_4(dest + stride, _mm_srli_si128(in[0], 8), max);
+  high_recon_4(dest + 2 * stride, in[1], max);
+  high_recon_4(dest + 3 * stride, _mm_srli_si128(in[1], 8), max);
+  return 1;
+}
+
+static int high_iht8x8_add(const tran_low_t *input, uint16_t *dest, int stride,
+                           int tx_type, int bd) {
+  const __m128i max = _mm_set1_epi16((1 << bd) - 1);
+  __m128i in[8];
+  int i;
+
+  for (i = 0; i < 8; ++i)
+    in[i] = high_load_coeffs(input + 8 * i);
+  if (!high_txfm8(in, tx_type & 2) || !high_txfm8(in, tx_type & 1))
+    return 0;
+
+  for (i = 0; i < 8; ++i) {
+    high_recon_8(dest, high_round_shift(in[i], 5), max);
+    dest += stride;
+  }
+  return 1;
+}
+
+static int high_iht16x16_add(const tran_low_t *input, uint16_t *dest,
+                             int stride, int tx_type, int bd) {
+  const __m128i max = _mm_set1_epi16((1 << bd) - 1);
+  __m128i in0[16], in1[16];
+  int i;
+
+  for (i = 0; i < 16; ++i) {
+    in0[i] = high_load_coeffs(input + 16 * i);
+    in1[i] = high_load_coeffs(input + 16 * i + 8);
+  }
+  if (!high_txfm16(in0, in1, tx_type & 2) ||
+      !high_txfm16(in0, in1, tx_type & 1))
+    return 0;
+
+  for (i = 0; i < 16; ++i) {
+    high_recon_8(dest, high_round_shift(in0[i], 6), max);
+    high_recon_8(dest + 8, high_round_shift(in1[i], 6), max);
+    dest += stride;
+  }
+  return 1;
+}
+
+// The 32 bit versions of the transforms, for the blocks the 16 bit kernels
+// cannot take, i.e. most of those of the 10 and 12 bit streams. Each 32 bit
+// lane holds one of 4 rows (columns) of the block. The largest intermediate
+// value of the 1-D transforms is less than 21 times their largest input (the
+// one of the idct32), so with inputs of up to HIGH_MAX_32 all of their stages
+// stay under 2^28. The products are exact there, their multiplicands being
+// split in 14 bit halves for _mm_madd_epi16(). Valid streams are well within
+// the range, the larger coefficients are left to the C versions.
+#define HIGH_MAX_32 ((1 << 23) - 1)
+
+// WRAPLOW() of vp9_idct.c.
+#if CONFIG_EMULATE_HARDWARE_HIGHBITDEPTH
+#define HIGH_WRAPLOW(x, bd) ((((int32_t)(x)) << (24 - (bd))) >> (24 - (bd)))
+
+static INLINE __m128i high_wraplow(__m128i x, int bd) {
+  const __m128i bits = _mm_cvtsi32_si128(24 - bd);
+  return _mm_sra_epi32(_mm_sll_epi32(x, bits), bits);
+}
+#else
+#define HIGH_WRAPLOW(x, bd) (x)
+
+static INLINE __m128i high_wraplow(__m128i x, int bd) {
+  (void)bd;
+  return x;
+}
+#endif  // CONFIG_EMULATE_HARDWARE_HIGHBITDEPTH
+
+static INLINE __m128i high_add(__m128i a, __m128i b, int bd) {
+  return high_wraplow(_mm_add_epi32(a, b), bd);
+}
+
+static INLINE __m128i high_sub(__m128i a, __m128i b, int bd) {
+  return high_wraplow(_mm_sub_epi32(a, b), bd);
+}
+
+// WRAPLOW(dct_const_round_shift(x * c0 + y * c1)), 'c' being the
+// pair_set_epi16(c0, c1).
+static INLINE __m128i high_mul(__m128i x, __m128i y, __m128i c, int bd) {
+  __m128i hi, lo;
+
+  high_split(x, y, &hi, &lo);
+  return high_wraplow(high_round(_mm_madd_epi16(hi, c), _mm_madd_epi16(lo, c)),
+                      bd);
+}
+
+// The same with the 4 products x * c0 + y * c1 + z * c2 + w * c3 of the
+// ADSTs.
+static INLINE __m128i high_mul2(__m128i x, __m128i y, __m128i c01, __m128i z,
+                                __m128i w, __m128i c23, int bd) {
+  __m128i hi0, lo0, hi1, lo1;
+
+  high_split(x, y, &hi0, &lo0);
+  high_split(z, w, &hi1, &lo1);
+  return high_wraplow(
+      high_round(_mm_add_epi32(_mm_madd_epi16(hi0, c01),
+                               _mm_madd_epi16(hi1, c23)),
+                 _mm_add_epi32(_mm_madd_epi16(lo0, c01),
+                               _mm_madd_epi16(lo1, c23))), bd);
+}
+
+// Returns non-zero if one of the lanes of 'in' is out of
+// [-HIGH_MAX_32, HIGH_MAX_32].
+static INLINE int high_out_of_range_32(const __m128i *in, int n) {
+  const __m128i hi = _mm_set1_epi32(HIGH_MAX_32);
+  const __m128i lo = _mm_set1_epi32(-HIGH_MAX_32);
+  __m128i out = _mm_setzero_si128();
+  int i;
+
+  for (i = 0; i < n; ++i) {
+    out = _mm_or_si128(out, _mm_cmpgt_epi32(in[i], hi));
+    out = _mm_or_si128(out, _mm_cmplt_epi32(in[i], lo));
+  }
+  return _mm_movemask_epi8(out);
+}
+
+static INLINE int high_all_zero_32(const __m128i *in, int n) {
+  __m128i out = _mm_setzero_si128();
+  int i;
+
+  for (i = 0; i < n; ++i)
+    out = _mm_or_si128(out, in[i]);
+  return _mm_movemask_epi8(_mm_cmpeq_epi32(out, _mm_setzero_si128())) ==
+         0xffff;
+}
+
+// Adds the 32 bit residuals to 4 pixels as clip_pixel_bd_high() does,
+// wrapping the residuals when emulating the hardware.
+static INLINE void high_recon_4_32(uint16_t *dest, __m128i res, int bd) {
+  const __m128i max = _mm_set1_epi16((1 << bd) - 1);
+  const __m128i d = _mm_unpacklo_epi16(_mm_loadl_epi64((const __m128i *)dest),
+                                       _mm_setzero_si128());
+  __m128i sum = _mm_add_epi32(d, high_wraplow(res, bd));
+
+  sum = _mm_packs_epi32(sum, sum);
+  _mm_storel_epi64((__m128i *)dest, _mm_max_epi16(_mm_min_epi16(sum, max),
+                                                  _mm_setzero_si128()));
+}
+
+static INLINE __m128i high_round_shift_32(__m128i in, int bits) {
+  const __m128i rounding = _mm_set1_epi32(1 << (bits - 1));
+  return _mm_srai_epi32(_mm_add_epi32(in, rounding), bits);
+}
+
+static void high_idct4_epi32(__m128i *in, int bd) {
+  __m128i step[4];
+
+  step[0] = high_mul(in[0], in[2], pair_set_epi16(cospi_16_64, cospi_16_64),
+                     bd);
+  step[1] = high_mul(in[0], in[2], pair_set_epi16(cospi_16_64, -cospi_16_64),
+                     bd);
+  step[2] = high_mul(in[1], in[3], pair_set_epi16(cospi_24_64, -cospi_8_64),
+                     bd);
+  step[3] = high_mul(in[1], in[3], pair_set_epi16(cospi_8_64, cospi_24_64),
+                     bd);
+
+  in[0] = high_add(step[0], step[3], bd);
+  in[1] = high_add(step[1], step[2], bd);
+  in[2] = high_sub(step[1], step[2], bd);
+  in[3] = high_sub(step[0], step[3], bd);
+}
+
+static void high_iadst4_epi32(__m128i *in, int bd) {
+  const __m128i x0 = in[0];
+  const __m128i x1 = in[1];
+  const __m128i x2 = in[2];
+  const __m128i x3 = in[3];
+
+  // The sums of the products of vp9_idct.c, gathered by input.
+  in[0] = high_mul2(x0, x1, pair_set_epi16(sinpi_1_9, sinpi_3_9),
+                    x2, x3, pair_set_epi16(sinpi_4_9, sinpi_2_9), bd);
+  in[1] = high_mul2(x0, x1, pair_set_epi16(sinpi_2_9, sinpi_3_9),
+                    x2, x3, pair_set_epi16(-sinpi_1_9, -sinpi_4_9), bd);
+  in[2] = high_mul2(x0, x1, pair_set_epi16(sinpi_3_9, 0),
+                    x2, x3, pair_set_epi16(-sinpi_3_9, sinpi_3_9), bd);
+  in[3] = high_mul2(x0, x1, pair_set_epi16(sinpi_1_9 + sinpi_2_9, -sinpi_3_9),
+                    x2, x3, pair_set_epi16(sinpi_4_9 - sinpi_1_9,
+                                           sinpi_2_9 - sinpi_4_9), bd);
+}
+
+static void high_idct8_epi32(__m128i *in, int bd) {
+  __m128i step1[8], step2[8];
+
+  // stage 1
+  step1[0] = in[0];
+  step1[1] = in[2];
+  step1[2] = in[4];
+  step1[3] = in[6];
+  step1[4] = high_mul(in[1], in[7], pair_set_epi16(cospi_28_64, -cospi_4_64),
+                      bd);
+  step1[7] = high_mul(in[1], in[7], pair_set_epi16(cospi_4_64, cospi_28_64),
+                      bd);
+  step1[5] = high_mul(in[5], in[3], pair_set_epi16(cospi_12_64, -cospi_20_64),
+                      bd);
+  step1[6] = high_mul(in[5], in[3], pair_set_epi16(cospi_20_64, cospi_12_64),
+                      bd);
+
+  // stage 2 & stage 3 - even half
+  high_idct4_epi32(step1, bd);
+
+  // stage 2 - odd half
+  step2[4] = high_add(step1[4], step1[5], bd);
+  step2[5] = high_sub(step1[4], step1[5], bd);
+  step2[6] = high_sub(step1[7], step1[6], bd);
+  step2[7] = high_add(step1[6], step1[7], bd);
+
+  // stage 3 - odd half
+  step1[4] = step2[4];
+  step1[5] = high_mul(step2[6], step2[5],
+                      pair_set_epi16(cospi_16_64, -cospi_16_64), bd);
+  step1[6] = high_mul(step2[5], step2[6],
+                      pair_set_epi16(cospi_16_64, cospi_16_64), bd);
+  step1[7] = step2[7];
+
+  // stage 4
+  in[0] = high_add(step1[0], step1[7], bd);
+  in[1] = high_add(step1[1], step1[6], bd);
+  in[2] = high_add(step1[2], step1[5], bd);
+  in[3] = high_add(step1[3], step1[4], bd);
+  in[4] = high_sub(step1[3], step1[4], bd);
+  in[5] = high_sub(step1[2], step1[5], bd);
+  in[6] = high_sub(step1[1], step1[6], bd);
+  in[7] = high_sub(step1[0], step1[7], bd);
+}
+
+static void high_iadst8_epi32(__m128i *in, int bd) {
+  const __m128i zero = _mm_setzero_si128();
+  __m128i x[8], s[8];
+
+  // stage 1
+  s[0] = high_mul2(in[7], in[0], pair_set_epi16(cospi_2_64, cospi_30_64),
+                   in[3], in[4], pair_set_epi16(cospi_18_64, cospi_14_64), bd);
+  s[1] = high_mul2(in[7], in[0], pair_set_epi16(cospi_30_64, -cospi_2_64),
+                   in[3], in[4], pair_set_epi16(cospi_14_64, -cospi_18_64), bd);
+  s[2] = high_mul2(in[5], in[2], pair_set_epi16(cospi_10_64, cospi_22_64),
+                   in[1], in[6], pair_set_epi16(cospi_26_64, cospi_6_64), bd);
+  s[3] = high_mul2(in[5], in[2], pair_set_epi16(cospi_22_64, -cospi_10_64),
+                   in[1], in[6], pair_set_epi16(cospi_6_64, -cospi_26_64), bd);
+  s[4] = high_mul2(in[7], in[0], pair_set_epi16(cospi_2_64, cospi_30_64),
+                   in[3], in[4], pair_set_epi16(-cospi_18_64, -cospi_14_64),
+                   bd);
+  s[5] = high_mul2(in[7], in[0], pair_set_epi16(cospi_30_64, -cospi_2_64),
+                   in[3], in[4], pair_set_epi16(-cospi_14_64, cospi_18_64), bd);
+  s[6] = high_mul2(in[5], in[2], pair_set_epi16(cospi_10_64, cospi_22_64),
+                   in[1], in[6], pair_set_epi16(-cospi_26_64, -cospi_6_64),
+                   bd);
+  s[7] = high_mul2(in[5], in[2], pair_set_epi16(cospi_22_64, -cospi_10_64),
+                   in[1], in[6], pair_set_epi16(-cospi_6_64, cospi_26_64), bd);
+
+  // stage 2, the sums of the first half are not wrapped
+  x[0] = high_add(s[0], s[2], bd);
+  x[1] = high_add(s[1], s[3], bd);
+  x[2] = _mm_sub_epi32(s[0], s[2]);
+  x[3] = _mm_sub_epi32(s[1], s[3]);
+  x[4] = high_mul2(s[4], s[5], pair_set_epi16(cospi_8_64, cospi_24_64),
+                   s[6], s[7], pair_set_epi16(-cospi_24_64, cospi_8_64), bd);
+  x[5] = high_mul2(s[4], s[5], pair_set_epi16(cospi_24_64, -cospi_8_64),
+                   s[6], s[7], pair_set_epi16(cospi_8_64, cospi_24_64), bd);
+  x[6] = high_mul2(s[4], s[5], pair_set_epi16(cospi_8_64, cospi_24_64),
+                   s[6], s[7], pair_set_epi16(cospi_24_64, -cospi_8_64), bd);
+  x[7] = high_mul2(s[4], s[5], pair_set_epi16(cospi_24_64, -cospi_8_64),
+                   s[6], s[7], pair_set_epi16(-cospi_8_64, -cospi_24_64), bd);
+
+  // stage 3
+  s[2] = high_mul(x[2], x[3], pair_set_epi16(cospi_16_64, cospi_16_64), bd);
+  s[3] = high_mul(x[2], x[3], pair_set_epi16(cospi_16_64, -cospi_16_64), bd);
+  s[6] = high_mul(x[6], x[7], pair_set_epi16(cospi_16_64, cospi_16_64), bd);
+  s[7] = high_mul(x[6], x[7], pair_set_epi16(cospi_16_64, -cospi_16_64), bd);
+
+  in[0] = x[0];
+  in[1] = high_sub(zero, x[4], bd);
+  in[2] = s[6];
+  in[3] = high_sub(zero, s[2], bd);
+  in[4] = s[3];
+  in[5] = high_sub(zero, s[7], bd);
+  in[6] = x[5];
+  in[7] = high_sub(zero, x[1], bd);
+}
+
+static void high_iadst16_epi32(__m128i *in, int bd) {
+  const __m128i zero = _mm_setzero_si128();
+  __m128i x[16], s[16];
+
+  // stage 1
+  s[0] = high_mul2(in[15], in[0], pair_set_epi16(cospi_1_64, cospi_31_64),
+                   in[7], in[8], pair_set_epi16(cospi_17_64, cospi_15_64), bd);
+  s[1] = high_mul2(in[15], in[0], pair_set_epi16(cospi_31_64, -cospi_1_64),
+                   in[7], in[8], pair_set_epi16(cospi_15_64, -cospi_17_64), bd);
+  s[2] = high_mul2(in[13], in[2], pair_set_epi16(cospi_5_64, cospi_27_64),
+                   in[5], in[10], pair_set_epi16(cospi_21_64, cospi_11_64),
+                   bd);
+  s[3] = high_mul2(in[13], in[2], pair_set_epi16(cospi_27_64, -cospi_5_64),
+                   in[5], in[10], pair_set_epi16(cospi_11_64, -cospi_21_64),
+                   bd);
+  s[4] = high_mul2(in[11], in[4], pair_set_epi16(cospi_9_64, cospi_23_64),
+                   in[3], in[12], pair_set_epi16(cospi_25_64, cospi_7_64), bd);
+  s[5] = high_mul2(in[11], in[4], pair_set_epi16(cospi_23_64, -cospi_9_64),
+                   in[3], in[12], pair_set_epi16(cospi_7_64, -cospi_25_64),
+                   bd);
+  s[6] = high_mul2(in[9], in[6], pair_set_epi16(cospi_13_64, cospi_19_64),
+                   in[1], in[14], pair_set_epi16(cospi_29_64, cospi_3_64), bd);
+  s[7] = high_mul2(in[9], in[6], pair_set_epi16(cospi_19_64, -cospi_13_64),
+                   in[1], in[14], pair_set_epi16(cospi_3_64, -cospi_29_64),
+                   bd);
+  s[8] = high_mul2(in[15], in[0], pair_set_epi16(cospi_1_64, cospi_31_64),
+                   in[7], in[8], pair_set_epi16(-cospi_17_64, -cospi_15_64),
+                   bd);
+  s[9] = high_mul2(in[15], in[0], pair_set_epi16(cospi_31_64, -cospi_1_64),
+                   in[7], in[8], pair_set_epi16(-cospi_15_64, cospi_17_64), bd);
+  s[10] = high_mul2(in[13], in[2], pair_set_epi16(cospi_5_64, cospi_27_64),
+                    in[5], in[10], pair_set_epi16(-cospi_21_64, -cospi_11_64),
+                    bd);
+  s[11] = high_mul2(in[13], in[2], pair_set_epi16(cospi_27_64, -cospi_5_64),
+                    in[5], in[10], pair_set_epi16(-cospi_11_64, cospi_21_64),
+                    bd);
+  s[12] = high_mul2(in[11], in[4], pair_set_epi16(cospi_9_64, cospi_23_64),
+                    in[3], in[12], pair_set_epi16(-cospi_25_64, -cospi_7_64),
+                    bd);
+  s[13] = high_mul2(in[11], in[4], pair_set_epi16(cospi_23_64, -cospi_9_64),
+                    in[3], in[12], pair_set_epi16(-cospi_7_64, cospi_25_64),
+                    bd);
+  s[14] = high_mul2(in[9], in[6], pair_set_epi16(cospi_13_64, cospi_19_64),
+                    in[1], in[14], pair_set_epi16(-cospi_29_64, -cospi_3_64),
+                    bd);
+  s[15] = high_mul2(in[9], in[6], pair_set_epi16(cospi_19_64, -cospi_13_64),
+                    in[1], in[14], pair_set_epi16(-cospi_3_64, cospi_29_64),
+                    bd);
+
+  // stage 2, WRAPLOW() only casts the first of the tran_high_t it sums in
+  // vp9_idct.c, so that the sums are not wrapped.
+  x[0] = _mm_add_epi32(s[0], s[4]);
+  x[1] = _mm_add_epi32(s[1], s[5]);
+  x[2] = _mm_add_epi32(s[2], s[6]);
+  x[3] = _mm_add_epi32(s[3], s[7]);
+  x[4] = _mm_sub_epi32(s[0], s[4]);
+  x[5] = _mm_sub_epi32(s[1], s[5]);
+  x[6] = _mm_sub_epi32(s[2], s[6]);
+  x[7] = _mm_sub_epi32(s[3], s[7]);
+  x[8] = high_mul2(s[8], s[9], pair_set_epi16(cospi_4_64, cospi_28_64),
+                   s[12], s[13], pair_set_epi16(-cospi_28_64, cospi_4_64), bd);
+  x[9] = high_mul2(s[8], s[9], pair_set_epi16(cospi_28_64, -cospi_4_64),
+                   s[12], s[13], pair_set_epi16(cospi_4_64, cospi_28_64), bd);
+  x[10] = high_mul2(s[10], s[11], pair_set_epi16(cospi_20_64, cospi_12_64),
+                    s[14], s[15], pair_set_epi16(-cospi_12_64, cospi_20_64),
+                    bd);
+  x[11] = high_mul2(s[10], s[11], pair_set_epi16(cospi_12_64, -cospi_20_64),
+                    s[14], s[15], pair_set_epi16(cospi_20_64, cospi_12_64),
+                    bd);
+  x[12] = high_mul2(s[8], s[9], pair_set_epi16(cospi_4_64, cospi_28_64),
+                    s[12], s[13], pair_set_epi16(cospi_28_64, -cospi_4_64),
+                    bd);
+  x[13] = high_mul2(s[8], s[9], pair_set_epi16(cospi_28_64, -cospi_4_64),
+                    s[12], s[13], pair_set_epi16(-cospi_4_64, -cospi_28_64),
+                    bd);
+  x[14] = high_mul2(s[10], s[11], pair_set_epi16(cospi_20_64, cospi_12_64),
+                    s[14], s[15], pair_set_epi16(cospi_12_64, -cospi_20_64),
+                    bd);
+  x[15] = high_mul2(s[10], s[11], pair_set_epi16(cospi_12_64, -cospi_20_64),
+                    s[14], s[15], pair_set_epi16(-cospi_20_64, -cospi_12_64),
+                    bd);
+
+  // stage 3
+  s[0] = _mm_add_epi32(x[0], x[2]);
+  s[1] = _mm_add_epi32(x[1], x[3]);
+  s[2] = _mm_sub_epi32(x[0], x[2]);
+  s[3] = _mm_sub_epi32(x[1], x[3]);
+  s[4] = high_mul2(x[4], x[5], pair_set_epi16(cospi_8_64, cospi_24_64),
+                   x[6], x[7], pair_set_epi16(-cospi_24_64, cospi_8_64), bd);
+  s[5] = high_mul2(x[4], x[5], pair_set_epi16(cospi_24_64, -cospi_8_64),
+                   x[6], x[7], pair_set_epi16(cospi_8_64, cospi_24_64), bd);
+  s[6] = high_mul2(x[4], x[5], pair_set_epi16(cospi_8_64, cospi_24_64),
+                   x[6], x[7], pair_set_epi16(cospi_24_64, -cospi_8_64), bd);
+  s[7] = high_mul2(x[4], x[5], pair_set_epi16(cospi_24_64, -cospi_8_64),
+                   x[6], x[7], pair_set_epi16(-cospi_8_64, -cospi_24_64), bd);
+  s[8] = _mm_add_epi32(x[8], x[10]);
+  s[9] = _mm_add_epi32(x[9], x[11]);
+  s[10] = _mm_sub_epi32(x[8], x[10]);
+  s[11] = _mm_sub_epi32(x[9], x[11]);
+  s[12] = high_mul2(x[12], x[13], pair_set_epi16(cospi_8_64, cospi_24_64),
+                    x[14], x[15], pair_set_epi16(-cospi_24_64, cospi_8_64), bd);
+  s[13] = high_mul2(x[12], x[13], pair_set_epi16(cospi_24_64, -cospi_8_64),
+                    x[14], x[15], pair_set_epi16(cospi_8_64, cospi_24_64), bd);
+  s[14] = high_mul2(x[12], x[13], pair_set_epi16(cospi_8_64, cospi_24_64),
+                    x[14], x[15], pair_set_epi16(cospi_24_64, -cospi_8_64), bd);
+  s[15] = high_mul2(x[12], x[13], pair_set_epi16(cospi_24_64, -cospi_8_64),
+                    x[14], x[15], pair_set_epi16(-cospi_8_64, -cospi_24_64),
+                    bd);
+
+  // stage 4
+  x[2] = high_mul(s[2], s[3], pair_set_epi16(-cospi_16_64, -cospi_16_64), bd);
+  x[3] = high_mul(s[2], s[3], pair_set_epi16(cospi_16_64, -cospi_16_64), bd);
+  x[6] = high_mul(s[6], s[7], pair_set_epi16(cospi_16_64, cospi_16_64), bd);
+  x[7] = high_mul(s[6], s[7], pair_set_epi16(-cospi_16_64, cospi_16_64), bd);
+  x[10] = high_mul(s[10], s[11], pair_set_epi16(cospi_16_64, cospi_16_64), bd);
+  x[11] = high_mul(s[10], s[11], pair_set_epi16(-cospi_16_64, cospi_16_64),
+                   bd);
+  x[14] = high_mul(s[14], s[15], pair_set_epi16(-cospi_16_64, -cospi_16_64),
+                   bd);
+  x[15] = high_mul(s[14], s[15], pair_set_epi16(cospi_16_64, -cospi_16_64),
+                   bd);
+
+  in[0] = high_wraplow(s[0], bd);
+  in[1] = high_sub(zero, s[8], bd);
+  in[2] = s[12];
+  in[3] = high_sub(zero, s[4], bd);
+  in[4] = x[6];
+  in[5] = x[14];
+  in[6] = x[10];
+  in[7] = x[2];
+  in[8] = x[3];
+  in[9] = x[11];
+  in[10] = x[15];
+  in[11] = x[7];
+  in[12] = s[5];
+  in[13] = high_sub(zero, s[13], bd);
+  in[14] = high_wraplow(s[9], bd);
+  in[15] = high_sub(zero, s[1], bd);
+}
+
+static void high_idct16_epi32(__m128i *in, int bd) {
+  __m128i step1[16], step2[16];
+
+  // stage 1
+  step1[0] = in[0];
+  step1[1] = in[8];
+  step1[2] = in[4];
+  step1[3] = in[12];
+  step1[4] = in[2];
+  step1[5] = in[10];
+  step1[6] = in[6];
+  step1[7] = in[14];
+  step1[8] = in[1];
+  step1[9] = in[9];
+  step1[10] = in[5];
+  step1[11] = in[13];
+  step1[12] = in[3];
+  step1[13] = in[11];
+  step1[14] = in[7];
+  step1[15] = in[15];
+
+  // stage 2
+  step2[0] = step1[0];
+  step2[1] = step1[1];
+  step2[2] = step1[2];
+  step2[3] = step1[3];
+  step2[4] = step1[4];
+  step2[5] = step1[5];
+  step2[6] = step1[6];
+  step2[7] = step1[7];
+  step2[8] = high_mul(step1[8], step1[15],
+                      pair_set_epi16(cospi_30_64, -cospi_2_64), bd);
+  step2[15] = high_mul(step1[8], step1[15],
+                       pair_set_epi16(cospi_2_64, cospi_30_64), bd);
+  step2[9] = high_mul(step1[9], step1[14],
+                      pair_set_epi16(cospi_14_64, -cospi_18_64), bd);
+  step2[14] = high_mul(step1[9], step1[14],
+                       pair_set_epi16(cospi_18_64, cospi_14_64), bd);
+  step2[10] = high_mul(step1[10], step1[13],
+                       pair_set_epi16(cospi_22_64, -cospi_10_64), bd);
+  step2[13] = high_mul(step1[10], step1[13],
+                       pair_set_epi16(cospi_10_64, cospi_22_64), bd);
+  step2[11] = high_mul(step1[11], step1[12],
+                       pair_set_epi16(cospi_6_64, -cospi_26_64), bd);
+  step2[12] = high_mul(step1[11], step1[12],
+                       pair_set_epi16(cospi_26_64, cospi_6_64), bd);
+
+  // stage 3
+  step1[0] = step2[0];
+  step1[1] = step2[1];
+  step1[2] = step2[2];
+  step1[3] = step2[3];
+  step1[4] = high_mul(step2[4], step2[7],
+                      pair_set_epi16(cospi_28_64, -cospi_4_64), bd);
+  step1[7] = high_mul(step2[4], step2[7],
+                      pair_set_epi16(cospi_4_64, cospi_28_64), bd);
+  step1[5] = high_mul(step2[5], step2[6],
+                      pair_set_epi16(cospi_12_64, -cospi_20_64), bd);
+  step1[6] = high_mul(step2[5], step2[6],
+                      pair_set_epi16(cospi_20_64, cospi_12_64), bd);
+  step1[8] = high_add(step2[8], step2[9], bd);
+  step1[9] = high_sub(step2[8], step2[9], bd);
+  step1[10] = high_sub(step2[11], step2[10], bd);
+  step1[11] = high_add(step2[10], step2[11], bd);
+  step1[12] = high_add(step2[12], step2[13], bd);
+  step1[13] = high_sub(step2[12], step2[13], bd);
+  step1[14] = high_sub(step2[15], step2[14], bd);
+  step1[15] = high_add(step2[14], step2[15], bd);
+
+  // stage 4
+  step2[0] = high_mul(step1[0], step1[1],
+                      pair_set_epi16(cospi_16_64, cospi_16_64), bd);
+  step2[1] = high_mul(step1[0], step1[1],
+                      pair_set_epi16(cospi_16_64, -cospi_16_64), bd);
+  step2[2] = high_mul(step1[2], step1[3],
+                      pair_set_epi16(cospi_24_64, -cospi_8_64), bd);
+  step2[3] = high_mul(step1[2], step1[3],
+                      pair_set_epi16(cospi_8_64, cospi_24_64), bd);
+  step2[4] = high_add(step1[4], step1[5], bd);
+  step2[5] = high_sub(step1[4], step1[5], bd);
+  step2[6] = high_sub(step1[7], step1[6], bd);
+  step2[7] = high_add(step1[6], step1[7], bd);
+  step2[8] = step1[8];
+  step2[15] = step1[15];
+  step2[9] = high_mul(step1[9], step1[14],
+                      pair_set_epi16(-cospi_8_64, cospi_24_64), bd);
+  step2[14] = high_mul(step1[9], step1[14],
+                       pair_set_epi16(cospi_24_64, cospi_8_64), bd);
+  step2[10] = high_mul(step1[10], step1[13],
+                       pair_set_epi16(-cospi_24_64, -cospi_8_64), bd);
+  step2[13] = high_mul(step1[10], step1[13],
+                       pair_set_epi16(-cospi_8_64, cospi_24_64), bd);
+  step2[11] = step1[11];
+  step2[12] = step1[12];
+
+  // stage 5
+  step1[0] = high_add(step2[0], step2[3], bd);
+  step1[1] = high_add(step2[1], step2[2], bd);
+  step1[2] = high_sub(step2[1], step2[2], bd);
+  step1[3] = high_sub(step2[0], step2[3], bd);
+  step1[4] = step2[4];
+  step1[5] = high_mul(step2[6], step2[5],
+                      pair_set_epi16(cospi_16_64, -cospi_16_64), bd);
+  step1[6] = high_mul(step2[5], step2[6],
+                      pair_set_epi16(cospi_16_64, cospi_16_64), bd);
+  step1[7] = step2[7];
+  step1[8] = high_add(step2[8], step2[11], bd);
+  step1[9] = high_add(step2[9], step2[10], bd);
+  step1[10] = high_sub(step2[9], step2[10], bd);
+  step1[11] = high_sub(step2[8], step2[11], bd);
+  step1[12] = high_sub(step2[15], step2[12], bd);
+  step1[13] = high_sub(step2[14], step2[13], bd);
+  step1[14] = high_add(step2[13], step2[14], bd);
+  step1[15] = high_add(step2[12], step2[15], bd);
+
+  // stage 6
+  step2[0] = high_add(step1[0], step1[7], bd);
+  step2[1] = high_add(step1[1], step1[6], bd);
+  step2[2] = high_add(step1[2], step1[5], bd);
+  step2[3] = high_add(step1[3], step1[4], bd);
+  step2[4] = high_sub(step1[3], step1[4], bd);
+  step2[5] = high_sub(step1[2], step1[5], bd);
+  step2[6] = high_sub(step1[1], step1[6], bd);
+  step2[7] = high_sub(step1[0], step1[7], bd);
+  step2[8] = step1[8];
+  step2[9] = step1[9];
+  step2[10] = high_mul(step1[10], step1[13],
+                       pair_set_epi16(-cospi_16_64, cospi_16_64), bd);
+  step2[13] = high_mul(step1[10], step1[13],
+                       pair_set_epi16(cospi_16_64, cospi_16_64), bd);
+  step2[11] = high_mul(step1[11], step1[12],
+                       pair_set_epi16(-cospi_16_64, cospi_16_64), bd);
+  step2[12] = high_mul(step1[11], step1[12],
+                       pair_set_epi16(cospi_16_64, cospi_16_64), bd);
+  step2[14] = step1[14];
+  step2[15] = step1[15];
+
+  // stage 7
+  in[0] = high_add(step2[0], step2[15], bd);
+  in[1] = high_add(step2[1], step2[14], bd);
+  in[2] = high_add(step2[2], step2[13], bd);
+  in[3] = high_add(step2[3], step2[12], bd);
+  in[4] = high_add(step2[4], step2[11], bd);
+  in[5] = high_add(step2[5], step2[10], bd);
+  in[6] = high_add(step2[6], step2[9], bd);
+  in[7] = high_add(step2[7], step2[8], bd);
+  in[8] = high_sub(step2[7], step2[8], bd);
+  in[9] = high_sub(step2[6], step2[9], bd);
+  in[10] = high_sub(step2[5], step2[10], bd);
+  in[11] = high_sub(step2[4], step2[11], bd);
+  in[12] = high_sub(step2[3], step2[12], bd);
+  in[13] = high_sub(step2[2], step2[13], bd);
+  in[14] = high_sub(step2[1], step2[14], bd);
+  in[15] = high_sub(step2[0], step2[15], bd);
+}
+
+static void high_idct32_epi32(__m128i *in, int bd) {
+  __m128i step1[32], step2[32];
+
+  // stage 1
+  step1[0] = in[0];
+  step1[1] = in[16];
+  step1[2] = in[8];
+  step1[3] = in[24];
+  step1[4] = in[4];
+  step1[5] = in[20];
+  step1[6] = in[12];
+  step1[7] = in[28];
+  step1[8] = in[2];
+  step1[9] = in[18];
+  step1[10] = in[10];
+  step1[11] = in[26];
+  step1[12] = in[6];
+  step1[13] = in[22];
+  step1[14] = in[14];
+  step1[15] = in[30];
+  step1[16] = high_mul(in[1], in[31],
+                       pair_set_epi16(cospi_31_64, -cospi_1_64), bd);
+  step1[31] = high_mul(in[1], in[31],
+                       pair_set_epi16(cospi_1_64, cospi_31_64), bd);
+  step1[17] = high_mul(in[17], in[15],
+                       pair_set_epi16(cospi_15_64, -cospi_17_64), bd);
+  step1[30] = high_mul(in[17], in[15],
+                       pair_set_epi16(cospi_17_64, cospi_15_64), bd);
+  step1[18] = high_mul(in[9], in[23],
+                       pair_set_epi16(cospi_23_64, -cospi_9_64), bd);
+  step1[29] = high_mul(in[9], in[23],
+                       pair_set_epi16(cospi_9_64, cospi_23_64), bd);
+  step1[19] = high_mul(in[25], in[7],
+                       pair_set_epi16(cospi_7_64, -cospi_25_64), bd);
+  step1[28] = high_mul(in[25], in[7],
+                       pair_set_epi16(cospi_25_64, cospi_7_64), bd);
+  step1[20] = high_mul(in[5], in[27],
+                       pair_set_epi16(cospi_27_64, -cospi_5_64), bd);
+  step1[27] = high_mul(in[5], in[27],
+                       pair_set_epi16(cospi_5_64, cospi_27_64), bd);
+  step1[21] = high_mul(in[21], in[11],
+                       pair_set_epi16(cospi_11_64, -cospi_21_64), bd);
+  step1[26] = high_mul(in[21], in[11],
+                       pair_set_epi16(cospi_21_64, cospi_11_64), bd);
+  step1[22] = high_mul(in[13], in[19],
+                       pair_set_epi16(cospi_19_64, -cospi_13_64), bd);
+  step1[25] = high_mul(in[13], in[19],
+                       pair_set_epi16(cospi_13_64, cospi_19_64), bd);
+  step1[23] = high_mul(in[29], in[3],
+                       pair_set_epi16(cospi_3_64, -cospi_29_64), bd);
+  step1[24] = high_mul(in[29], in[3],
+                       pair_set_epi16(cospi_29_64, cospi_3_64), bd);
+
+  // stage 2
+  step2[0] = step1[0];
+  step2[1] = step1[1];
+  step2[2] = step1[2];
+  step2[3] = step1[3];
+  step2[4] = step1[4];
+  step2[5] = step1[5];
+  step2[6] = step1[6];
+  step2[7] = step1[7];
+  step2[8] = high_mul(step1[8], step1[15],
+                      pair_set_epi16(cospi_30_64, -cospi_2_64), bd);
+  step2[15] = high_mul(step1[8], step1[15],
+                       pair_set_epi16(cospi_2_64, cospi_30_64), bd);
+  step2[9] = high_mul(step1[9], step1[14],
+                      pair_set_epi16(cospi_14_64, -cospi_18_64), bd);
+  step2[14] = high_mul(step1[9], step1[14],
+                       pair_set_epi16(cospi_18_64, cospi_14_64), bd);
+  step2[10] = high_mul(step1[10], step1[13],
+                       pair_set_epi16(cospi_22_64, -cospi_10_64), bd);
+  step2[13] = high_mul(step1[10], step1[13],
+                       pair_set_epi16(cospi_10_64, cospi_22_64), bd);
+  step2[11] = high_mul(step1[11], step1[12],
+                       pair_set_epi16(cospi_6_64, -cospi_26_64), bd);
+  step2[12] = high_mul(step1[11], step1[12],
+                       pair_set_epi16(cospi_26_64, cospi_6_64), bd);
+  step2[16] = high_add(step1[16], step1[17], bd);
+  step2[17] = high_sub(step1[16], step1[17], bd);
+  step2[18] = high_sub(step1[19], step1[18], bd);
+  step2[19] = high_add(step1[18], step1[19], bd);
+  step2[20] = high_add(step1[20], step1[21], bd);
+  step2[21] = high_sub(step1[20], step1[21], bd);
+  step2[22] = high_sub(step1[23], step1[22], bd);
+  step2[23] = high_add(step1[22], step1[23], bd);
+  step2[24] = high_add(step1[24], step1[25], bd);
+  step2[25] = high_sub(step1[24], step1[25], bd);
+  step2[26] = high_sub(step1[27], step1[26], bd);
+  step2[27] = high_add(step1[26], step1[27], bd);
+  step2[28] = high_add(step1[28], step1[29], bd);
+  step2[29] = high_sub(step1[28], step1[29], bd);
+  step2[30] = high_sub(step1[31], step1[30], bd);
+  step2[31] = high_add(step1[30], step1[31], bd);
+
+  // stage 3
+  step1[0] = step2[0];
+  step1[1] = step2[1];
+  step1[2] = step2[2];
+  step1[3] = step2[3];
+  step1[4] = high_mul(step2[4], step2[7],
+                      pair_set_epi16(cospi_28_64, -cospi_4_64), bd);
+  step1[7] = high_mul(step2[4], step2[7],
+                      pair_set_epi16(cospi_4_64, cospi_28_64), bd);
+  step1[5] = high_mul(step2[5], step2[6],
+                      pair_set_epi16(cospi_12_64, -cospi_20_64), bd);
+  step1[6] = high_mul(step2[5], step2[6],
+                      pair_set_epi16(cospi_20_64, cospi_12_64), bd);
+  step1[8] = high_add(step2[8], step2[9], bd);
+  step1[9] = high_sub(step2[8], step2[9], bd);
+  step1[10] = high_sub(step2[11], step2[10], bd);
+  step1[11] = high_add(step2[10], step2[11], bd);
+  step1[12] = high_add(step2[12], step2[13], bd);
+  step1[13] = high_sub(step2[12], step2[13], bd);
+  step1[14] = high_sub(step2[15], step2[14], bd);
+  step1[15] = high_add(step2[14], step2[15], bd);
+  step1[16] = step2[16];
+  step1[31] = step2[31];
+  step1[17] = high_mul(step2[17], step2[30],
+                       pair_set_epi16(-cospi_4_64, cospi_28_64), bd);
+  step1[30] = high_mul(step2[17], step2[30],
+                       pair_set_epi16(cospi_28_64, cospi_4_64), bd);
+  step1[18] = high_mul(step2[18], step2[29],
+                       pair_set_epi16(-cospi_28_64, -cospi_4_64), bd);
+  step1[29] = high_mul(step2[18], step2[29],
+                       pair_set_epi16(-cospi_4_64, cospi_28_64), bd);
+  step1[19] = step2[19];
+  step1[20] = step2[20];
+  step1[21] = high_mul(step2[21], step2[26],
+                       pair_set_epi16(-cospi_20_64, cospi_12_64), bd);
+  step1[26] = high_mul(step2[21], step2[26],
+                       pair_set_epi16(cospi_12_64, cospi_20_64), bd);
+  step1[22] = high_mul(step2[22], step2[25],
+                       pair_set_epi16(-cospi_12_64, -cospi_20_64), bd);
+  step1[25] = high_mul(step2[22], step2[25],
+                       pair_set_epi16(-cospi_20_64, cospi_12_64), bd);
+  step1[23] = step2[23];
+  step1[24] = step2[24];
+  step1[27] = step2[27];
+  step1[28] = step2[28];
+
+  // stage 4
+  step2[0] = high_mul(step1[0], step1[1],
+                      pair_set_epi16(cospi_16_64, cospi_16_64), bd);
+  step2[1] = high_mul(step1[0], step1[1],
+                      pair_set_epi16(cospi_16_64, -cospi_16_64), bd);
+  step2[2] = high_mul(step1[2], step1[3],
+                      pair_set_epi16(cospi_24_64, -cospi_8_64), bd);
+  step2[3] = high_mul(step1[2], step1[3],
+                      pair_set_epi16(cospi_8_64, cospi_24_64), bd);
+  step2[4] = high_add(step1[4], step1[5], bd);
+  step2[5] = high_sub(step1[4], step1[5], bd);
+  step2[6] = high_sub(step1[7], step1[6], bd);
+  step2[7] = high_add(step1[6], step1[7], bd);
+  step2[8] = step1[8];
+  step2[15] = step1[15];
+  step2[9] = high_mul(step1[9], step1[14],
+                      pair_set_epi16(-cospi_8_64, cospi_24_64), bd);
+  step2[14] = high_mul(step1[9], step1[14],
+                       pair_set_epi16(cospi_24_64, cospi_8_64), bd);
+  step2[10] = high_mul(step1[10], step1[13],
+                       pair_set_epi16(-cospi_24_64, -cospi_8_64), bd);
+  step2[13] = high_mul(step1[10], step1[13],
+                       pair_set_epi16(-cospi_8_64, cospi_24_64), bd);
+  step2[11] = step1[11];
+  step2[12] = step1[12];
+  step2[16] = high_add(step1[16], step1[19], bd);
+  step2[17] = high_add(step1[17], step1[18], bd);
+  step2[18] = high_sub(step1[17], step1[18], bd);
+  step2[19] = high_sub(step1[16], step1[19], bd);
+  step2[20] = high_sub(step1[23], step1[20], bd);
+  step2[21] = high_sub(step1[22], step1[21], bd);
+  step2[22] = high_add(step1[21], step1[22], bd);
+  step2[23] = high_add(step1[20], step1[23], bd);
+  step2[24] = high_add(step1[24], step1[27], bd);
+  step2[25] = high_add(step1[25], step1[26], bd);
+  step2[26] = high_sub(step1[25], step1[26], bd);
+  step2[27] = high_sub(step1[24], step1[27], bd);
+  step2[28] = high_sub(step1[31], step1[28], bd);
+  step2[29] = high_sub(step1[30], step1[29], bd);
+  step2[30] = high_add(step1[29], step1[30], bd);
+  step2[31] = high_add(step1[28], step1[31], bd);
+
+  // stage 5
+  step1[0] = high_add(step2[0], step2[3], bd);
+  step1[1] = high_add(step2[1], step2[2], bd);
+  step1[2] = high_sub(step2[1], step2[2], bd);
+  step1[3] = high_sub(step2[0], step2[3], bd);
+  step1[4] = step2[4];
+  step1[5] = high_mul(step2[6], step2[5],
+                      pair_set_epi16(cospi_16_64, -cospi_16_64), bd);
+  step1[6] = high_mul(step2[5], step2[6],
+                      pair_set_epi16(cospi_16_64, cospi_16_64), bd);
+  step1[7] = step2[7];
+  step1[8] = high_add(step2[8], step2[11], bd);
+  step1[9] = high_add(step2[9], step2[10], bd);
+  step1[10] = high_sub(step2[9], step2[10], bd);
+  step1[11] = high_sub(step2[8], step2[11], bd);
+  step1[12] = high_sub(step2[15], step2[12], bd);
+  step1[13] = high_sub(step2[14], step2[13], bd);
+  step1[14] = high_add(step2[13], step2[14], bd);
+  step1[15] = high_add(step2[12], step2[15], bd);
+  step1[16] = step2[16];
+  step1[17] = step2[17];
+  step1[18] = high_mul(step2[18], step2[29],
+                       pair_set_epi16(-cospi_8_64, cospi_24_64), bd);
+  step1[29] = high_mul(step2[18], step2[29],
+                       pair_set_epi16(cospi_24_64, cospi_8_64), bd);
+  step1[19] = high_mul(step2[19], step2[28],
+                       pair_set_epi16(-cospi_8_64, cospi_24_64), bd);
+  step1[28] = high_mul(step2[19], step2[28],
+                       pair_set_epi16(cospi_24_64, cospi_8_64), bd);
+  step1[20] = high_mul(step2[20], step2[27],
+                       pair_set_epi16(-cospi_24_64, -cospi_8_64), bd);
+  step1[27] = high_mul(step2[20], step2[27],
+                       pair_set_epi16(-cospi_8_64, cospi_24_64), bd);
+  step1[21] = high_mul(step2[21], step2[26],
+                       pair_set_epi16(-cospi_24_64, -cospi_8_64), bd);
+  step1[26] = high_mul(step2[21], step2[26],
+                       pair_set_epi16(-cospi_8_64, cospi_24_64), bd);
+  step1[22] = step2[22];
+  step1[23] = step2[23];
+  step1[24] = step2[24];
+  step1[25] = step2[25];
+  step1[30] = step2[30];
+  step1[31] = step2[31];
+
+  // stage 6
+  step2[0] = high_add(step1[0], step1[7], bd);
+  step2[1] = high_add(step1[1], step1[6], bd);
+  step2[2] = high_add(step1[2], step1[5], bd);
+  step2[3] = high_add(step1[3], step1[4], bd);
+  step2[4] = high_sub(step1[3], step1[4], bd);
+  step2[5] = high_sub(step1[2], step1[5], bd);
+  step2[6] = high_sub(step1[1], step1[6], bd);
+  step2[7] = high_sub(step1[0], step1[7], bd);
+  step2[8] = step1[8];
+  step2[9] = step1[9];
+  step2[10] = high_mul(step1[10], step1[13],
+                       pair_set_epi16(-cospi_16_64, cospi_16_64), bd);
+  step2[13] = high_mul(step1[10], step1[13],
+                       pair_set_epi16(cospi_16_64, cospi_16_64), bd);
+  step2[11] = high_mul(step1[11], step1[12],
+                       pair_set_epi16(-cospi_16_64, cospi_16_64), bd);
+  step2[12] = high_mul(step1[11], step1[12],
+                       pair_set_epi16(cospi_16_64, cospi_16_64), bd);
+  step2[14] = high_wraplow(step1[14], bd);
+  step2[15] = high_wraplow(step1[15], bd);
+  step2[16] = high_add(step1[16], step1[23], bd);
+  step2[17] = high_add(step1[17], step1[22], bd);
+  step2[18] = high_add(step1[18], step1[21], bd);
+  step2[19] = high_add(step1[19], step1[20], bd);
+  step2[20] = high_sub(step1[19], step1[20], bd);
+  step2[21] = high_sub(step1[18], step1[21], bd);
+  step2[22] = high_sub(step1[17], step1[22], bd);
+  step2[23] = high_sub(step1[16], step1[23], bd);
+  step2[24] = high_sub(step1[31], step1[24], bd);
+  step2[25] = high_sub(step1[30], step1[25], bd);
+  step2[26] = high_sub(step1[29], step1[26], bd);
+  step2[27] = high_sub(step1[28], step1[27], bd);
+  step2[28] = high_add(step1[27], step1[28], bd);
+  step2[29] = high_add(step1[26], step1[29], bd);
+  step2[30] = high_add(step1[25], step1[30], bd);
+  step2[31] = high_add(step1[24], step1[31], bd);
+
+  // stage 7
+  step1[0] = high_add(step2[0], step2[15], bd);
+  step1[1] = high_add(step2[1], step2[14], bd);
+  step1[2] = high_add(step2[2], step2[13], bd);
+  step1[3] = high_add(step2[3], step2[12], bd);
+  step1[4] = high_add(step2[4], step2[11], bd);
+  step1[5] = high_add(step2[5], step2[10], bd);
+  step1[6] = high_add(step2[6], step2[9], bd);
+  step1[7] = high_add(step2[7], step2[8], bd);
+  step1[8] = high_sub(step2[7], step2[8], bd);
+  step1[9] = high_sub(step2[6], step2[9], bd);
+  step1[10] = high_sub(step2[5], step2[10], bd);
+  step1[11] = high_sub(step2[4], step2[11], bd);
+  step1[12] = high_sub(step2[3], step2[12], bd);
+  step1[13] = high_sub(step2[2], step2[13], bd);
+  step1[14] = high_sub(step2[1], step2[14], bd);
+  step1[15] = high_sub(step2[0], step2[15], bd);
+  step1[16] = step2[16];
+  step1[17] = step2[17];
+  step1[18] = step2[18];
+  step1[19] = step2[19];
+  step1[20] = high_mul(step2[20], step2[27],
+                       pair_set_epi16(-cospi_16_64, cospi_16_64), bd);
+  step1[27] = high_mul(step2[20], step2[27],
+                       pair_set_epi16(cospi_16_64, cospi_16_64), bd);
+  step1[21] = high_mul(step2[21], step2[26],
+                       pair_set_epi16(-cospi_16_64, cospi_16_64), bd);
+  step1[26] = high_mul(step2[21], step2[26],
+                       pair_set_epi16(cospi_16_64, cospi_16_64), bd);
+  step1[22] = high_mul(step2[22], step2[25],
+                       pair_set_epi16(-cospi_16_64, cospi_16_64), bd);
+  step1[25] = high_mul(step2[22], step2[25],
+                       pair_set_epi16(cospi_16_64, cospi_16_64), bd);
+  step1[23] = high_mul(step2[23], step2[24],
+                       pair_set_epi16(-cospi_16_64, cospi_16_64), bd);
+  step1[24] = high_mul(step2[23], step2[24],
+                       pair_set_epi16(cospi_16_64, cospi_16_64), bd);
+  step1[28] = step2[28];
+  step1[29] = step2[29];
+  step1[30] = step2[30];
+  step1[31] = step2[31];
+
+  // final stage
+  in[0] = high_add(step1[0], step1[31], bd);
+  in[1] = high_add(step1[1], step1[30], bd);
+  in[2] = high_add(step1[2], step1[29], bd);
+  in[3] = high_add(step1[3], step1[28], bd);
+  in[4] = high_add(step1[4], step1[27], bd);
+  in[5] = high_add(step1[5], step1[26], bd);
+  in[6] = high_add(step1[6], step1[25], bd);
+  in[7] = high_add(step1[7], step1[24], bd);
+  in[8] = high_add(step1[8], step1[23], bd);
+  in[9] = high_add(step1[9], step1[22], bd);
+  in[10] = high_add(step1[10], step1[21], bd);
+  in[11] = high_add(step1[11], step1[20], bd);
+  in[12] = high_add(step1[12], step1[19], bd);
+  in[13] = high_add(step1[13], step1[18], bd);
+  in[14] = high_add(step1[14], step1[17], bd);
+  in[15] = high_add(step1[15], step1[16], bd);
+  in[16] = high_sub(step1[15], step1[16], bd);
+  in[17] = high_sub(step1[14], step1[17], bd);
+  in[18] = high_sub(step1[13], step1[18], bd);
+  in[19] = high_sub(step1[12], step1[19], bd);
+  in[20] = high_sub(step1[11], step1[20], bd);
+  in[21] = high_sub(step1[10], step1[21], bd);
+  in[22] = high_sub(step1[9], step1[22], bd);
+  in[23] = high_sub(step1[8], step1[23], bd);
+  in[24] = high_sub(step1[7], step1[24], bd);
+  in[25] = high_sub(step1[6], step1[25], bd);
+  in[26] = high_sub(step1[5], step1[26], bd);
+  in[27] = high_sub(step1[4], step1[27], bd);
+  in[28] = high_sub(step1[3], step1[28], bd);
+  in[29] = high_sub(step1[2], step1[29], bd);
+  in[30] = high_sub(step1[1], step1[30], bd);
+  in[31] = high_sub(step1[0], step1[31], bd);
+}
+
+typedef void (*high_txfm_32)(__m128i *in, int bd);
+
+// The 2D transforms with the 32 bit kernels. Only the first 'rows' rows have
+// non-zero coefficients, the others are not read. Returns 0 without writing
+// to 'dest' if the input of a pass is out of range.
+static int high_iht_add_32(const tran_low_t *input, uint16_t *dest, int stride,
+                           int size, int rows, high_txfm_32 row_txfm,
+                           high_txfm_32 col_txfm, int bits, int bd) {
+  DECLARE_ALIGNED(16, tran_low_t, out[32 * 32]);
+  __m128i in[32];
+  int i, j, k;
+
+  // Rows, 4 at a time, with each row of 'in' holding the coefficients of the
+  // same column.
+  for (i = 0; i < rows; i += 4) {
+    for (j = 0; j < size; j += 4) {
+      for (k = 0; k < 4; ++k)
+        in[j + k] = _mm_loadu_si128((const __m128i *)(input + (i + k) * size +
+                                                       j));
+      high_transpose_4x4(in + j);
+    }
+    if (!high_all_zero_32(in, size)) {
+      if (high_out_of_range_32(in, size))
+        return 0;
+      row_txfm(in, bd);
+      if (high_out_of_range_32(in, size))
+        return 0;
+    }
+    for (j = 0; j < size; j += 4) {
+      high_transpose_4x4(in + j);
+      for (k = 0; k < 4; ++k)
+        _mm_store_si128((__m128i *)(out + (i + k) * size + j), in[j + k]);
+    }
+  }
+  vpx_memset(out + rows * size, 0, (size - rows) * size * sizeof(out[0]));
+
+  // Columns, 4 at a time.
+  for (j = 0; j < size; j += 4) {
+    for (i = 0; i < size; ++i)
+      in[i] = _mm_load_si128((const __m128i *)(out + i * size + j));
+    col_txfm(in, bd);
+    for (i = 0; i < size; ++i)
+      high_recon_4_32(dest + i * stride + j, high_round_shift_32(in[i], bits),
+                      bd);
+  }
+  return 1;
+}
+
+static int high_iht4x4_add_32(const tran_low_t *input, uint16_t *dest,
+                              int stride, int tx_type, int bd) {
+  return high_iht_add_32(input, dest, stride, 4, 4,
+                         tx_type & 2 ? high_iadst4_epi32 : high_idct4_epi32,
+                         tx_type & 1 ? high_iadst4_epi32 : high_idct4_epi32,
+                         4, bd);
+}
+
+static int high_iht8x8_add_32(const tran_low_t *input, uint16_t *dest,
+                              int stride, int rows, int tx_type, int bd) {
+  return high_iht_add_32(input, dest, stride, 8, rows,
+                         tx_type & 2 ? high_iadst8_epi32 : high_idct8_epi32,
+                         tx_type & 1 ? high_iadst8_epi32 : high_idct8_epi32,
+                         5, bd);
+}
+
+static int high_iht16x16_add_32(const tran_low_t *input, uint16_t *dest,
+                                int stride, int rows, int tx_type, int bd) {
+  return high_iht_add_32(input, dest, stride, 16, rows,
+                         tx_type & 2 ? high_iadst16_epi32 : high_idct16_epi32,
+                         tx_type & 1 ? high_iadst16_epi32 : high_idct16_epi32,
+                         6, bd);
+}
+
+static int high_idct32x32_add_32(const tran_low_t *input, uint16_t *dest,
+                                 int stride, int rows, int bd) {
+  return high_iht_add_32(input, dest, stride, 32, rows, high_idct32_epi32,
+                         high_idct32_epi32, 6, bd);
+}
+
+static void high_recon_dc(const tran_low_t *input, uint16_t *dest, int stride,
+                          int size, int bits, int bd) {
+  const __m128i max = _mm_set1_epi16((1 << bd) - 1);
+  tran_low_t out = HIGH_WRAPLOW(dct_const_round_shift(input[0] * cospi_16_64),
+                                bd);
+  int a1, r, c;
+
+  out = HIGH_WRAPLOW(dct_const_round_shift(out * cospi_16_64), bd);
+  a1 = ROUND_POWER_OF_TWO(out, bits);
+
+  if (a1 > (1 << bd) || a1 < -(1 << bd)) {
+    // Too large to be added in 16 bits.
+    const __m128i dc_value = _mm_set1_epi32(a1);
+    for (r = 0; r < size; ++r) {
+      for (c = 0; c < size; c += 4)
+        high_recon_4_32(dest + c, dc_value, bd);
+      dest += stride;
+    }
+  } else {
+    const __m128i dc_value = _mm_set1_epi16(a1);
+    for (r = 0; r < size; ++r) {
+      if (size == 4) {
+        high_recon_4(dest, dc_value, max);
+      } else {
+        for (c = 0; c < size; c += 8)
+          high_recon_8(dest + c, dc_value, max);
+      }
+      dest += stride;
+    }
+  }
+}
+
+void vp9_high_idct4x4_16_add_sse2(const tran_low_t *input, uint8_t *dest8,
+                                  int stride, int bd) {
+  uint16_t *dest = CONVERT_TO_SHORTPTR(dest8);
+  if (!high_iht4x4_add(input, dest, stride, 0, bd) &&
+      !high_iht4x4_add_32(input, dest, stride, 0, bd))
+    vp9_high_idct4x4_16_add_c(input, dest8, stride, bd);
+}
+
+void vp9_high_iht4x4_16_add_sse2(const tran_low_t *input, uint8_t *dest8,
+                                 int stride, int tx_type, int bd) {
+  uint16_t *dest = CONVERT_TO_SHORTPTR(dest8);
+  if (!high_iht4x4_add(input, dest, stride, tx_type, bd) &&
+      !high_iht4x4_add_32(input, dest, stride, tx_type, bd))
+    vp9_high_iht4x4_16_add_c(input, dest8, stride, tx_type, bd);
+}
+
+void vp9_high_idct4x4_1_add_sse2(const tran_low_t *input, uint8_t *dest8,
+                                 int stride, int bd) {
+  high_recon_dc(input, CONVERT_TO_SHORTPTR(dest8), stride, 4, 4, bd);
+}
+
+void vp9_high_idct8x8_64_add_sse2(const tran_low_t *input, uint8_t *dest8,
+                                  int stride, int bd) {
+  uint16_t *dest = CONVERT_TO_SHORTPTR(dest8);
+  if (!high_iht8x8_add(input, dest, stride, 0, bd) &&
+      !high_iht8x8_add_32(input, dest, stride, 8, 0, bd))
+    vp9_high_idct8x8_64_add_c(input, dest8, stride, bd);
+}
+
+void vp9_high_idct8x8_10_add_sse2(const tran_low_t *input, uint8_t *dest8,
+                                  int stride, int bd) {
+  uint16_t *dest = CONVERT_TO_SHORTPTR(dest8);
+  if (!high_iht8x8_add(input, dest, stride, 0, bd) &&
+      !high_iht8x8_add_32(input, dest, stride, 4, 0, bd))
+    vp9_high_idct8x8_10_add_c(input, dest8, stride, bd);
+}
+
+void vp9_high_iht8x8_64_add_sse2(const tran_low_t *input, uint8_t *dest8,
+                                 int stride, int tx_type, int bd) {
+  uint16_t *dest = CONVERT_TO_SHORTPTR(dest8);
+  if (!high_iht8x8_add(input, dest, stride, tx_type, bd) &&
+      !high_iht8x8_add_32(input, dest, stride, 8, tx_type, bd))
+    vp9_high_iht8x8_64_add_c(input, dest8, stride, tx_type, bd);
+}
+
+void vp9_high_idct8x8_1_add_sse2(const tran_low_t *input, uint8_t *dest8,
+                                 int stride, int bd) {
+  high_recon_dc(input, CONVERT_TO_SHORTPTR(dest8), stride, 8, 5, bd);
+}
+
+void vp9_high_idct16x16_256_add_sse2(const tran_low_t *input, uint8_t *dest8,
+                                     int stride, int bd) {
+  uint16_t *dest = CONVERT_TO_SHORTPTR(dest8);
+  if (!high_iht16x16_add(input, dest, stride, 0, bd) &&
+      !high_iht16x16_add_32(input, dest, stride, 16, 0, bd))
+    vp9_high_idct16x16_256_add_c(input, dest8, stride, bd);
+}
+
+void vp9_high_idct16x16_10_add_sse2(const tran_low_t *input, uint8_t *dest8,
+                                    int stride, int bd) {
+  uint16_t *dest = CONVERT_TO_SHORTPTR(dest8);
+  if (!high_iht16x16_add(input, dest, stride, 0, bd) &&
+      !high_iht16x16_add_32(input, dest, stride, 4, 0, bd))
+    vp9_high_idct16x16_10_add_c(input, dest8, stride, bd);
+}
+
+void vp9_high_iht16x16_256_add_sse2(const tran_low_t *input, uint8_t *dest8,
+                                    int stride, int tx_type, int bd) {
+  uint16_t *dest = CONVERT_TO_SHORTPTR(dest8);
+  if (!high_iht16x16_add(input, dest, stride, tx_type, bd) &&
+      !high_iht16x16_add_32(input, dest, stride, 16, tx_type, bd))
+    vp9_high_iht16x16_256_add_c(input, dest8, stride, tx_type, bd);
+}
+
+void vp9_high_idct16x16_1_add_sse2(const tran_low_t *input, uint8_t *dest8,
+                                   int stride, int bd) {
+  high_recon_dc(input, CONVERT_TO_SHORTPTR(dest8), stride, 16, 6, bd);
+}
+
+void vp9_high_idct32x32_1024_add_sse2(const tran_low_t *input, uint8_t *dest8,
+                                      int stride, int bd) {
+  if (!high_idct32x32_add_32(input, CONVERT_TO_SHORTPTR(dest8), stride, 32,
+                             bd))
+    vp9_high_idct32x32_1024_add_c(input, dest8, stride, bd);
+}
+
+void vp9_high_idct32x32_34_add_sse2(const tran_low_t *input, uint8_t *dest8,
+                                    int stride, int bd) {
+  if (!high_idct32x32_add_32(input, CONVERT_TO_SHORTPTR(dest8), stride, 8, bd))
+    vp9_high_idct32x32_34_add_c(input, dest8, stride, bd);
+}
+
+void vp9_high_idct32x32_1_add_sse2(const tran_low_t *input, uint8_t *dest8,
+                                   int stride, int bd) {
+  high_recon_dc(input, CONVERT_TO_SHORTPTR(dest8), stride, 32, 6, bd);
+}
+#endif  // CONFIG_VP9_HIGHBITDEPTH
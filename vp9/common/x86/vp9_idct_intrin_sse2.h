@@ -173,3 +173,36 @@ static INLINE void write_buffer_8x16(uint8_t *dest, __m128i *in, int stride) {
   RECON_AND_STORE(dest, in[14]);
   RECON_AND_STORE(dest, in[15]);
 }
+
+#if CONFIG_VP9_HIGHBITDEPTH
+// Splits the lanes of 'x' and 'y' in their high and low DCT_CONST_BITS,
+// interleaved for _mm_madd_epi16() with a pair_set_epi16() of constants.
+static INLINE void high_split(__m128i x, __m128i y, __m128i *hi, __m128i *lo) {
+  const __m128i mask_16 = _mm_set1_epi32(0xffff);
+  const __m128i mask_lo = _mm_set1_epi32((1 << DCT_CONST_BITS) - 1);
+
+  *hi = _mm_or_si128(_mm_and_si128(_mm_srai_epi32(x, DCT_CONST_BITS), mask_16),
+                     _mm_slli_epi32(_mm_srai_epi32(y, DCT_CONST_BITS), 16));
+  *lo = _mm_or_si128(_mm_and_si128(x, mask_lo),
+                     _mm_slli_epi32(_mm_and_si128(y, mask_lo), 16));
+}
+
+// dct_const_round_shift() of hi * 2^DCT_CONST_BITS + lo.
+static INLINE __m128i high_round(__m128i hi, __m128i lo) {
+  const __m128i rounding = _mm_set1_epi32(DCT_CONST_ROUNDING);
+  return _mm_add_epi32(hi, _mm_srai_epi32(_mm_add_epi32(lo, rounding),
+                                          DCT_CONST_BITS));
+}
+
+static INLINE void high_transpose_4x4(__m128i *in) {
+  const __m128i t0 = _mm_unpacklo_epi32(in[0], in[1]);
+  const __m128i t1 = _mm_unpacklo_epi32(in[2], in[3]);
+  const __m128i t2 = _mm_unpackhi_epi32(in[0], in[1]);
+  const __m128i t3 = _mm_unpackhi_epi32(in[2], in[3]);
+
+  in[0] = _mm_unpacklo_epi64(t0, t1);
+  in[1] = _mm_unpackhi_epi64(t0, t1);
+  in[2] = _mm_unpacklo_epi64(t2, t3);
+  in[3] = _mm_unpackhi_epi64(t2, t3);
+}
+#endif  // CONFIG_VP9_HIGHBITDEPTH
@@ -0,0 +1,163 @@
+/*
+ *  Copyright (c) 2014 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>  // AVX2
+
+#include "./vp9_rtcd.h"
+#include "vp9/common/vp9_common.h"
+#include "vpx_ports/mem.h"
+
+// The 32x32 predictors, a row being a single register. The directional ones
+// copy their rows out of the filtered edge like the SSSE3 versions, see
+// vp9_intrapred_intrin_ssse3.c.
+
+// (a + 2 * b + c + 2) >> 2 of the pixels.
+static INLINE __m256i avg3_epu8(__m256i a, __m256i b, __m256i c) {
+  const __m256i odd = _mm256_and_si256(_mm256_xor_si256(a, c),
+                                       _mm256_set1_epi8(1));
+  return _mm256_avg_epu8(_mm256_sub_epi8(_mm256_avg_epu8(a, c), odd), b);
+}
+
+static INLINE __m256i loadu_256(const uint8_t *p) {
+  return _mm256_loadu_si256((const __m256i *)p);
+}
+
+static INLINE void fill_block_32(uint8_t *dst, ptrdiff_t stride,
+                                 __m256i value) {
+  int r;
+  for (r = 0; r < 32; ++r) {
+    _mm256_storeu_si256((__m256i *)dst, value);
+    dst += stride;
+  }
+}
+
+// The average of the 32 pixels of 'edge', rounded like in C.
+static INLINE __m256i edge_dc_32(const uint8_t *edge) {
+  const __m256i sad = _mm256_sad_epu8(loadu_256(edge), _mm256_setzero_si256());
+  const __m128i sum = _mm_add_epi16(_mm256_castsi256_si128(sad),
+                                    _mm256_extracti128_si256(sad, 1));
+  const int dc = _mm_cvtsi128_si32(_mm_add_epi16(sum, _mm_srli_si128(sum, 8)));
+  return _mm256_set1_epi8((dc + 16) >> 5);
+}
+
+// Writes the 65 pixels of the edge, left[31] .. left[0], above[-1] ..
+// above[31], followed by above right pixels, to 'edge', and its 63 3-tap
+// filtered pixels to 'filtered'.
+static INLINE void filter_edge_32(const uint8_t *above, const uint8_t *left,
+                                  uint8_t *edge, uint8_t *filtered) {
+  const __m256i rev = _mm256_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8,
+                                       7, 6, 5, 4, 3, 2, 1, 0,
+                                       15, 14, 13, 12, 11, 10, 9, 8,
+                                       7, 6, 5, 4, 3, 2, 1, 0);
+  int i;
+
+  _mm256_store_si256((__m256i *)edge, _mm256_permute4x64_epi64(
+      _mm256_shuffle_epi8(loadu_256(left), rev), 0x4e));
+  _mm256_store_si256((__m256i *)(edge + 32), loadu_256(above - 1));
+  _mm256_store_si256((__m256i *)(edge + 64), loadu_256(above + 31));
+
+  for (i = 0; i < 64; i += 32)
+    _mm256_store_si256((__m256i *)(filtered + i),
+                       avg3_epu8(loadu_256(edge + i), loadu_256(edge + i + 1),
+                                 loadu_256(edge + i + 2)));
+}
+
+void vp9_d117_predictor_32x32_avx2(uint8_t *dst, ptrdiff_t stride,
+                                   const uint8_t *above, const uint8_t *left) {
+  // Even lanes of each half first, then the odd ones.
+  const __m256i deinterleave = _mm256_setr_epi8(0, 2, 4, 6, 8, 10, 12, 14,
+                                                1, 3, 5, 7, 9, 11, 13, 15,
+                                                0, 2, 4, 6, 8, 10, 12, 14,
+                                                1, 3, 5, 7, 9, 11, 13, 15);
+  DECLARE_ALIGNED(32, uint8_t, edge[96]);
+  DECLARE_ALIGNED(32, uint8_t, filtered[64]);
+  DECLARE_ALIGNED(32, uint8_t, even[64]);
+  DECLARE_ALIGNED(32, uint8_t, odd[64]);
+  __m256i v;
+  int r;
+
+  filter_edge_32(above, left, edge, filtered);
+
+  v = _mm256_permute4x64_epi64(_mm256_shuffle_epi8(
+      _mm256_load_si256((const __m256i *)filtered), deinterleave), 0xd8);
+  _mm_store_si128((__m128i *)even, _mm256_castsi256_si128(v));
+  _mm_storeu_si128((__m128i *)(odd + 1), _mm256_extracti128_si256(v, 1));
+  _mm256_storeu_si256((__m256i *)(even + 16),
+                      _mm256_avg_epu8(loadu_256(edge + 32),
+                                      loadu_256(edge + 33)));
+  _mm256_storeu_si256((__m256i *)(odd + 17), loadu_256(filtered + 32));
+
+  for (r = 0; r < 32; ++r) {
+    _mm256_storeu_si256((__m256i *)dst,
+                        loadu_256((r & 1 ? odd : even) + 16 - (r >> 1)));
+    dst += stride;
+  }
+}
+
+void vp9_d135_predictor_32x32_avx2(uint8_t *dst, ptrdiff_t stride,
+                                   const uint8_t *above, const uint8_t *left) {
+  DECLARE_ALIGNED(32, uint8_t, edge[96]);
+  DECLARE_ALIGNED(32, uint8_t, filtered[64]);
+  int r;
+
+  filter_edge_32(above, left, edge, filtered);
+
+  for (r = 0; r < 32; ++r) {
+    _mm256_storeu_si256((__m256i *)dst, loadu_256(filtered + 31 - r));
+    dst += stride;
+  }
+}
+
+void vp9_d153_predictor_32x32_avx2(uint8_t *dst, ptrdiff_t stride,
+                                   const uint8_t *above, const uint8_t *left) {
+  DECLARE_ALIGNED(32, uint8_t, edge[96]);
+  DECLARE_ALIGNED(32, uint8_t, filtered[64]);
+  DECLARE_ALIGNED(32, uint8_t, pairs[96]);
+  __m256i avg2, avg3, lo, hi;
+  int r;
+
+  filter_edge_32(above, left, edge, filtered);
+
+  avg2 = _mm256_avg_epu8(loadu_256(edge), loadu_256(edge + 1));
+  avg3 = _mm256_load_si256((const __m256i *)filtered);
+  lo = _mm256_unpacklo_epi8(avg2, avg3);
+  hi = _mm256_unpackhi_epi8(avg2, avg3);
+  _mm256_store_si256((__m256i *)pairs, _mm256_permute2x128_si256(lo, hi, 0x20));
+  _mm256_store_si256((__m256i *)(pairs + 32),
+                     _mm256_permute2x128_si256(lo, hi, 0x31));
+  _mm256_store_si256((__m256i *)(pairs + 64), loadu_256(filtered + 32));
+
+  for (r = 0; r < 32; ++r) {
+    _mm256_storeu_si256((__m256i *)dst, loadu_256(pairs + 62 - 2 * r));
+    dst += stride;
+  }
+}
+
+void vp9_dc_128_predictor_32x32_avx2(uint8_t *dst, ptrdiff_t stride,
+                                     const uint8_t *above,
+                                     const uint8_t *left) {
+  (void)above;
+  (void)left;
+  fill_block_32(dst, stride, _mm256_set1_epi8((char)128));
+}
+
+void vp9_dc_left_predictor_32x32_avx2(uint8_t *dst, ptrdiff_t stride,
+                                      const uint8_t *above,
+                                      const uint8_t *left) {
+  (void)above;
+  fill_block_32(dst, stride, edge_dc_32(left));
+}
+
+void vp9_dc_top_predictor_32x32_avx2(uint8_t *dst, ptrdiff_t stride,
+                                     const uint8_t *above,
+                                     const uint8_t *left) {
+  (void)left;
+  fill_block_32(dst, stride, edge_dc_32(above));
+}
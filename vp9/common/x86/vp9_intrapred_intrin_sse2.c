@@ -0,0 +1,86 @@
+/*
+ *  Copyright (c) 2014 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <emmintrin.h>  // SSE2
+
+#include "./vp9_rtcd.h"
+#include "vp9/common/vp9_common.h"
+
+// Sum of the bs pixels of 'edge'.
+static INLINE int sum_edge(const uint8_t *edge, int bs) {
+  const __m128i zero = _mm_setzero_si128();
+  __m128i sum;
+
+  if (bs == 4) {
+    sum = _mm_sad_epu8(_mm_cvtsi32_si128(*(const int *)edge), zero);
+  } else if (bs == 8) {
+    sum = _mm_sad_epu8(_mm_loadl_epi64((const __m128i *)edge), zero);
+  } else {
+    int i;
+    sum = zero;
+    for (i = 0; i < bs; i += 16)
+      sum = _mm_add_epi16(sum, _mm_sad_epu8(
+          _mm_loadu_si128((const __m128i *)(edge + i)), zero));
+    sum = _mm_add_epi16(sum, _mm_srli_si128(sum, 8));
+  }
+  return _mm_cvtsi128_si32(sum);
+}
+
+// Fills the bs x bs block with the pixels of 'value'.
+static INLINE void fill_block(uint8_t *dst, ptrdiff_t stride, int bs,
+                              __m128i value) {
+  int r, c;
+
+  for (r = 0; r < bs; ++r) {
+    if (bs == 4) {
+      *(int *)dst = _mm_cvtsi128_si32(value);
+    } else if (bs == 8) {
+      _mm_storel_epi64((__m128i *)dst, value);
+    } else {
+      for (c = 0; c < bs; c += 16)
+        _mm_storeu_si128((__m128i *)(dst + c), value);
+    }
+    dst += stride;
+  }
+}
+
+// The average of the bs pixels of 'edge', rounded like in C.
+static INLINE __m128i edge_dc(const uint8_t *edge, int bs, int log2_bs) {
+  return _mm_set1_epi8((sum_edge(edge, bs) + (bs >> 1)) >> log2_bs);
+}
+
+#define intra_pred_dc_sized(size, log2_size) \
+  void vp9_dc_128_predictor_##size##x##size##_sse2(uint8_t *dst, \
+                                                   ptrdiff_t stride, \
+                                                   const uint8_t *above, \
+                                                   const uint8_t *left) { \
+    (void)above; \
+    (void)left; \
+    fill_block(dst, stride, size, _mm_set1_epi8((char)128)); \
+  } \
+  void vp9_dc_left_predictor_##size##x##size##_sse2(uint8_t *dst, \
+                                                    ptrdiff_t stride, \
+                                                    const uint8_t *above, \
+                                                    const uint8_t *left) { \
+    (void)above; \
+    fill_block(dst, stride, size, edge_dc(left, size, log2_size)); \
+  } \
+  void vp9_dc_top_predictor_##size##x##size##_sse2(uint8_t *dst, \
+                                                   ptrdiff_t stride, \
+                                                   const uint8_t *above, \
+                                                   const uint8_t *left) { \
+    (void)left; \
+    fill_block(dst, stride, size, edge_dc(above, size, log2_size)); \
+  }
+
+intra_pred_dc_sized(4, 2)
+intra_pred_dc_sized(8, 3)
+intra_pred_dc_sized(16, 4)
+intra_pred_dc_sized(32, 5)
@@ -0,0 +1,180 @@
+/*
+ *  Copyright (c) 2014 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <tmmintrin.h>  // SSSE3
+
+#include "./vp9_rtcd.h"
+#include "vp9/common/vp9_common.h"
+#include "vpx_ports/mem.h"
+
+// The d117, d135 and d153 predictions only take pixels of the 3-tap filtered
+// edge, and for some rows or columns of the 2-tap filtered one. Each row is a
+// run of bs pixels of such an edge, the start moving by one or two pixels per
+// row, so both are filtered once and the rows copied out of them.
+//
+// The edge is laid out as left[bs - 1] .. left[0], above[-1], above[0] ..
+// above[bs - 1], in which the 3-tap filtered pixel k is centered on k + 1.
+
+// (a + 2 * b + c + 2) >> 2 of the pixels.
+static INLINE __m128i avg3_epu8(__m128i a, __m128i b, __m128i c) {
+  const __m128i odd = _mm_and_si128(_mm_xor_si128(a, c), _mm_set1_epi8(1));
+  return _mm_avg_epu8(_mm_sub_epi8(_mm_avg_epu8(a, c), odd), b);
+}
+
+static INLINE void copy_row(uint8_t *dst, const uint8_t *src, int bs) {
+  if (bs == 4) {
+    *(int *)dst = *(const int *)src;
+  } else if (bs == 8) {
+    _mm_storel_epi64((__m128i *)dst, _mm_loadl_epi64((const __m128i *)src));
+  } else {
+    int c;
+    for (c = 0; c < bs; c += 16)
+      _mm_storeu_si128((__m128i *)(dst + c),
+                       _mm_loadu_si128((const __m128i *)(src + c)));
+  }
+}
+
+// Writes the 2 * bs + 1 pixels of the edge to 'edge', followed by at least 16
+// zeros, and its 2 * bs - 1 3-tap filtered pixels to 'filtered'. Only the bs
+// pixels of the above row, besides above[-1], are read for bs 4; up to
+// 2 * bs - 2 of them, within the above right, for the larger sizes.
+static INLINE void filter_edge(const uint8_t *above, const uint8_t *left,
+                               int bs, uint8_t *edge, uint8_t *filtered) {
+  int i;
+
+  if (bs == 4) {
+    const __m128i rev = _mm_setr_epi8(3, 2, 1, 0, -1, -1, -1, -1,
+                                      -1, -1, -1, -1, -1, -1, -1, -1);
+    *(int *)edge = _mm_cvtsi128_si32(
+        _mm_shuffle_epi8(_mm_cvtsi32_si128(*(const int *)left), rev));
+    _mm_storel_epi64((__m128i *)(edge + bs),
+                     _mm_loadl_epi64((const __m128i *)(above - 1)));
+  } else {
+    const __m128i rev = _mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8,
+                                      7, 6, 5, 4, 3, 2, 1, 0);
+    if (bs == 8) {
+      _mm_storel_epi64((__m128i *)edge, _mm_shuffle_epi8(
+          _mm_loadl_epi64((const __m128i *)left), _mm_srli_si128(rev, 8)));
+    } else {
+      for (i = 0; i < bs; i += 16)
+        _mm_storeu_si128((__m128i *)(edge + bs - 16 - i), _mm_shuffle_epi8(
+            _mm_loadu_si128((const __m128i *)(left + i)), rev));
+    }
+    for (i = 0; i <= bs; i += 16)
+      _mm_storeu_si128((__m128i *)(edge + bs + i),
+                       _mm_loadu_si128((const __m128i *)(above - 1 + i)));
+  }
+  _mm_storeu_si128((__m128i *)(edge + 2 * bs + 1), _mm_setzero_si128());
+
+  for (i = 0; i < 2 * bs - 1; i += 16)
+    _mm_store_si128((__m128i *)(filtered + i), avg3_epu8(
+        _mm_loadu_si128((const __m128i *)(edge + i)),
+        _mm_loadu_si128((const __m128i *)(edge + i + 1)),
+        _mm_loadu_si128((const __m128i *)(edge + i + 2))));
+}
+
+static INLINE void d117_predictor(uint8_t *dst, ptrdiff_t stride, int bs,
+                                  const uint8_t *above, const uint8_t *left) {
+  // The even and odd rows take every other filtered pixel of the left edge,
+  // then the 2-tap and the 3-tap filtered above row respectively.
+  const __m128i deinterleave = _mm_setr_epi8(0, 2, 4, 6, 8, 10, 12, 14,
+                                             1, 3, 5, 7, 9, 11, 13, 15);
+  const int half = bs >> 1;
+  DECLARE_ALIGNED(16, uint8_t, edge[2 * 32 + 1 + 16]);
+  DECLARE_ALIGNED(16, uint8_t, filtered[2 * 32]);
+  DECLARE_ALIGNED(16, uint8_t, even[32 + 16 + 16]);
+  DECLARE_ALIGNED(16, uint8_t, odd[32 + 16 + 16]);
+  int i, r;
+
+  filter_edge(above, left, bs, edge, filtered);
+
+  for (i = 0; i < bs; i += 16) {
+    const __m128i v = _mm_shuffle_epi8(
+        _mm_load_si128((const __m128i *)(filtered + i)), deinterleave);
+    _mm_storel_epi64((__m128i *)(even + i / 2), v);
+    _mm_storel_epi64((__m128i *)(odd + 1 + i / 2), _mm_unpackhi_epi64(v, v));
+  }
+  for (i = 0; i < bs; i += 16) {
+    _mm_storeu_si128((__m128i *)(even + half + i), _mm_avg_epu8(
+        _mm_loadu_si128((const __m128i *)(edge + bs + i)),
+        _mm_loadu_si128((const __m128i *)(edge + bs + 1 + i))));
+    _mm_storeu_si128((__m128i *)(odd + half + 1 + i),
+                     _mm_loadu_si128((const __m128i *)(filtered + bs + i)));
+  }
+
+  for (r = 0; r < bs; ++r) {
+    copy_row(dst, (r & 1 ? odd : even) + half - (r >> 1), bs);
+    dst += stride;
+  }
+}
+
+static INLINE void d135_predictor(uint8_t *dst, ptrdiff_t stride, int bs,
+                                  const uint8_t *above, const uint8_t *left) {
+  DECLARE_ALIGNED(16, uint8_t, edge[2 * 32 + 1 + 16]);
+  DECLARE_ALIGNED(16, uint8_t, filtered[2 * 32]);
+  int r;
+
+  filter_edge(above, left, bs, edge, filtered);
+
+  for (r = 0; r < bs; ++r) {
+    copy_row(dst, filtered + bs - 1 - r, bs);
+    dst += stride;
+  }
+}
+
+static INLINE void d153_predictor(uint8_t *dst, ptrdiff_t stride, int bs,
+                                  const uint8_t *above, const uint8_t *left) {
+  // The rows start with pairs of the 2-tap and the 3-tap filtered left
+  // edge, then go on with the 3-tap filtered above row.
+  DECLARE_ALIGNED(16, uint8_t, edge[2 * 32 + 1 + 16]);
+  DECLARE_ALIGNED(16, uint8_t, filtered[2 * 32]);
+  DECLARE_ALIGNED(16, uint8_t, pairs[3 * 32 + 16]);
+  int i, r;
+
+  filter_edge(above, left, bs, edge, filtered);
+
+  for (i = 0; i < bs; i += 16) {
+    const __m128i avg2 = _mm_avg_epu8(
+        _mm_loadu_si128((const __m128i *)(edge + i)),
+        _mm_loadu_si128((const __m128i *)(edge + i + 1)));
+    const __m128i avg3 = _mm_load_si128((const __m128i *)(filtered + i));
+    _mm_store_si128((__m128i *)(pairs + 2 * i), _mm_unpacklo_epi8(avg2, avg3));
+    _mm_store_si128((__m128i *)(pairs + 2 * i + 16),
+                    _mm_unpackhi_epi8(avg2, avg3));
+  }
+  for (i = 0; i < bs; i += 16)
+    _mm_storeu_si128((__m128i *)(pairs + 2 * bs + i),
+                     _mm_loadu_si128((const __m128i *)(filtered + bs + i)));
+
+  for (r = 0; r < bs; ++r) {
+    copy_row(dst, pairs + 2 * (bs - 1 - r), bs);
+    dst += stride;
+  }
+}
+
+#define intra_pred_sized(type, size) \
+  void vp9_##type##_predictor_##size##x##size##_ssse3(uint8_t *dst, \
+                                                      ptrdiff_t stride, \
+                                                      const uint8_t *above, \
+                                                      const uint8_t *left) { \
+    type##_predictor(dst, stride, size, above, left); \
+  }
+
+intra_pred_sized(d117, 4)
+intra_pred_sized(d117, 8)
+intra_pred_sized(d117, 16)
+intra_pred_sized(d117, 32)
+intra_pred_sized(d135, 4)
+intra_pred_sized(d135, 8)
+intra_pred_sized(d135, 16)
+intra_pred_sized(d135, 32)
+// The smaller d153 sizes are in vp9_intrapred_ssse3.asm.
+intra_pred_sized(d153, 32)
+#undef intra_pred_sized
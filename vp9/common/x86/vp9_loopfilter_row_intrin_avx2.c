@@ -0,0 +1,424 @@
+/*
+ *  Copyright (c) 2014 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>  // AVX2
+#include <string.h>
+
+#include "./vp9_rtcd.h"
+#include "vp9/common/vp9_loopfilter.h"
+
+// The edges of a superblock row as in vp9_lpf_horizontal_row_c() and
+// vp9_lpf_vertical_row4_c(). A register holds 32 pixels along an edge,
+// 4 runs of 8 pixels each belonging to an 8x8 block with its own filter
+// length and thresholds, so the edges of all lengths are filtered together:
+// every pixel gets the 4-tap filter and, where the 8x8 and 16x16 masks and
+// the flatness allow, the 8 and 16 wide results replace it.
+//
+// The pixels across an edge are kept in 16 registers, p7 .. p0 then q0 .. q7,
+// the edge being between x[7] and x[8].
+
+static INLINE __m256i abs_diff(__m256i a, __m256i b) {
+  return _mm256_or_si256(_mm256_subs_epu8(a, b), _mm256_subs_epu8(b, a));
+}
+
+// All ones in the lanes of 'a' that are at most 'limit'.
+static INLINE __m256i at_most(__m256i a, __m256i limit) {
+  return _mm256_cmpeq_epi8(_mm256_subs_epu8(a, limit), _mm256_setzero_si256());
+}
+
+// The signed bytes of 'a' shifted right by 'bits'.
+static INLINE __m256i sra_epi8(__m256i a, int bits) {
+  const __m128i count = _mm_cvtsi32_si128(8 + bits);
+  return _mm256_packs_epi16(
+      _mm256_sra_epi16(_mm256_unpacklo_epi8(a, a), count),
+      _mm256_sra_epi16(_mm256_unpackhi_epi8(a, a), count));
+}
+
+// All ones in the 8 lanes of each block whose bit is set in the 4 bits of
+// 'bits'.
+static INLINE __m256i block_mask(unsigned int bits) {
+  const __m256i bit = _mm256_setr_epi64x(1, 2, 4, 8);
+  return _mm256_cmpeq_epi64(_mm256_and_si256(_mm256_set1_epi64x(bits), bit),
+                            bit);
+}
+
+// The 4 bytes of 'v' each repeated over the 8 lanes of its block.
+static INLINE __m256i block_splat(const uint8_t *v) {
+  const int64_t ones = 0x0101010101010101LL;
+  return _mm256_setr_epi64x(v[0] * ones, v[1] * ones, v[2] * ones,
+                            v[3] * ones);
+}
+
+static INLINE void block_thresh(const loop_filter_info_n *lfi_n,
+                                const uint8_t *lvl, __m256i *blimit,
+                                __m256i *limit, __m256i *thresh) {
+  uint8_t b[4], l[4], t[4];
+  int i;
+
+  for (i = 0; i < 4; ++i) {
+    const loop_filter_thresh *const lfi = lfi_n->lfthr + lvl[i];
+    b[i] = lfi->mblim[0];
+    l[i] = lfi->lim[0];
+    t[i] = lfi->hev_thr[0];
+  }
+  *blimit = block_splat(b);
+  *limit = block_splat(l);
+  *thresh = block_splat(t);
+}
+
+// All ones where x[7 - k] and x[8 + k] differ by at most one from x[7] and
+// x[8] respectively, for all of k = first .. last.
+static INLINE __m256i flat_mask(const __m256i *x, int first, int last) {
+  __m256i m = _mm256_setzero_si256();
+  int k;
+
+  for (k = first; k <= last; ++k)
+    m = _mm256_max_epu8(m, _mm256_max_epu8(abs_diff(x[7 - k], x[7]),
+                                           abs_diff(x[8 + k], x[8])));
+  return at_most(m, _mm256_set1_epi8(1));
+}
+
+// Writes to out[1 .. n - 2] the pixels x[1 .. n - 2] filtered with
+// [1, .., 1, 2, 1, .., 1] of n - 1 taps, the pixels x[0] and x[n - 1]
+// repeated past the ends, as in filter8() and filter16() of
+// vp9_loopfilter_filters.c.
+static INLINE void flat_filter(const __m256i *x, int n, int log2_n,
+                               __m256i *out) {
+  const int radius = n / 2 - 1;
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i round = _mm256_set1_epi16(n / 2);
+  const __m128i shift = _mm_cvtsi32_si128(log2_n);
+  __m256i w[2][16], sum[2];
+  int h, k;
+
+  for (k = 0; k < n; ++k) {
+    w[0][k] = _mm256_unpacklo_epi8(x[k], zero);
+    w[1][k] = _mm256_unpackhi_epi8(x[k], zero);
+  }
+
+  // The sum over the window of the pixel before x[1].
+  for (h = 0; h < 2; ++h) {
+    sum[h] = _mm256_mullo_epi16(w[h][0], _mm256_set1_epi16(radius + 1));
+    for (k = 1; k <= radius; ++k)
+      sum[h] = _mm256_add_epi16(sum[h], w[h][k]);
+  }
+
+  for (k = 1; k < n - 1; ++k) {
+    const int in = k + radius < n - 1 ? k + radius : n - 1;
+    const int out_k = k - 1 - radius > 0 ? k - 1 - radius : 0;
+    __m256i v[2];
+    for (h = 0; h < 2; ++h) {
+      sum[h] = _mm256_sub_epi16(_mm256_add_epi16(sum[h], w[h][in]),
+                                w[h][out_k]);
+      v[h] = _mm256_srl_epi16(_mm256_add_epi16(
+          _mm256_add_epi16(sum[h], w[h][k]), round), shift);
+    }
+    out[k] = _mm256_packus_epi16(v[0], v[1]);
+  }
+}
+
+// Filters the edge between x[7] and x[8]. 'filter', 'filter_8' and
+// 'filter_16' select the lanes to filter at all, with at least 8 taps and
+// with 16 taps. Only x[4] .. x[11] are read and written for taps 4, the
+// other pixels of x being used for taps 16 only.
+static void filter_edge(__m256i *x, int taps, __m256i blimit, __m256i limit,
+                        __m256i thresh, __m256i filter, __m256i filter_8,
+                        __m256i filter_16) {
+  const __m256i t80 = _mm256_set1_epi8((char)0x80);
+  const __m256i t1 = _mm256_set1_epi8(1);
+  const __m256i t3 = _mm256_set1_epi8(3);
+  const __m256i t4 = _mm256_set1_epi8(4);
+  const __m256i t_fe = _mm256_set1_epi8((char)0xfe);
+  __m256i mask, hev, flat = _mm256_setzero_si256();
+  __m256i flat2 = _mm256_setzero_si256();
+  __m256i f8[16], f16[16];
+  __m256i ps1, ps0, qs0, qs1, f, filter1, filter2;
+  int k;
+
+  // filter_mask() and hev_mask().
+  {
+    const __m256i p1p0 = abs_diff(x[6], x[7]);
+    const __m256i q1q0 = abs_diff(x[9], x[8]);
+    const __m256i p0q0 = abs_diff(x[7], x[8]);
+    const __m256i p1q1 = abs_diff(x[6], x[9]);
+    __m256i m = _mm256_max_epu8(p1p0, q1q0);
+
+    hev = _mm256_xor_si256(at_most(m, thresh), _mm256_cmpeq_epi8(m, m));
+    m = _mm256_max_epu8(m, _mm256_max_epu8(abs_diff(x[4], x[5]),
+                                           abs_diff(x[5], x[6])));
+    m = _mm256_max_epu8(m, _mm256_max_epu8(abs_diff(x[10], x[9]),
+                                           abs_diff(x[11], x[10])));
+    mask = _mm256_and_si256(at_most(m, limit), at_most(_mm256_adds_epu8(
+        _mm256_adds_epu8(p0q0, p0q0),
+        _mm256_srli_epi16(_mm256_and_si256(p1q1, t_fe), 1)), blimit));
+    mask = _mm256_and_si256(mask, filter);
+  }
+
+  if (taps > 4) {
+    flat = _mm256_and_si256(_mm256_and_si256(flat_mask(x, 1, 3), mask),
+                            filter_8);
+    if (_mm256_testz_si256(flat, flat)) {
+      taps = 4;
+    } else {
+      flat_filter(x + 4, 8, 3, f8 + 4);
+      if (taps == 16) {
+        flat2 = _mm256_and_si256(_mm256_and_si256(flat_mask(x, 4, 7), flat),
+                                 filter_16);
+        if (_mm256_testz_si256(flat2, flat2))
+          taps = 8;
+        else
+          flat_filter(x, 16, 4, f16);
+      }
+    }
+  }
+
+  // filter4().
+  ps1 = _mm256_xor_si256(x[6], t80);
+  ps0 = _mm256_xor_si256(x[7], t80);
+  qs0 = _mm256_xor_si256(x[8], t80);
+  qs1 = _mm256_xor_si256(x[9], t80);
+
+  f = _mm256_and_si256(_mm256_subs_epi8(ps1, qs1), hev);
+  {
+    const __m256i d = _mm256_subs_epi8(qs0, ps0);
+    f = _mm256_adds_epi8(_mm256_adds_epi8(_mm256_adds_epi8(f, d), d), d);
+  }
+  f = _mm256_and_si256(f, mask);
+  filter1 = sra_epi8(_mm256_adds_epi8(f, t4), 3);
+  filter2 = sra_epi8(_mm256_adds_epi8(f, t3), 3);
+  x[8] = _mm256_xor_si256(_mm256_subs_epi8(qs0, filter1), t80);
+  x[7] = _mm256_xor_si256(_mm256_adds_epi8(ps0, filter2), t80);
+  f = _mm256_andnot_si256(hev, sra_epi8(_mm256_adds_epi8(filter1, t1), 1));
+  x[9] = _mm256_xor_si256(_mm256_subs_epi8(qs1, f), t80);
+  x[6] = _mm256_xor_si256(_mm256_adds_epi8(ps1, f), t80);
+
+  if (taps > 4) {
+    for (k = 5; k <= 10; ++k)
+      x[k] = _mm256_blendv_epi8(x[k], f8[k], flat);
+    if (taps == 16) {
+      for (k = 1; k <= 14; ++k)
+        x[k] = _mm256_blendv_epi8(x[k], f16[k], flat2);
+    }
+  }
+}
+
+// The loads and stores of a row of 32 pixels only touch the blocks in
+// 'blocks', so nothing is accessed past the filtered area.
+static INLINE __m256i load_blocks(const uint8_t *s, __m256i blocks) {
+  return _mm256_maskload_epi64((const long long *)s, blocks);
+}
+
+static INLINE void store_blocks(uint8_t *s, __m256i blocks, __m256i v) {
+  _mm256_maskstore_epi64((long long *)s, blocks, v);
+}
+
+// Filters the horizontal edge above 's' for 32 pixels. Each of the masks has
+// a bit per block.
+static void filter_horizontal_32(uint8_t *s, int pitch,
+                                 unsigned int mask_16x16,
+                                 unsigned int mask_8x8,
+                                 unsigned int mask_4x4,
+                                 const loop_filter_info_n *lfi_n,
+                                 const uint8_t *lvl) {
+  const unsigned int mask = mask_16x16 | mask_8x8 | mask_4x4;
+  const __m256i blocks = block_mask(mask);
+  const int taps = mask_16x16 ? 16 : mask_8x8 ? 8 : 4;
+  // The rows read, p7 .. q7 or p3 .. q3, and written.
+  const int read = taps == 16 ? 8 : 4;
+  const int written = taps == 16 ? 7 : taps == 8 ? 3 : 2;
+  __m256i x[16], blimit, limit, thresh;
+  int k;
+
+  block_thresh(lfi_n, lvl, &blimit, &limit, &thresh);
+
+  for (k = 8 - read; k < 8 + read; ++k)
+    x[k] = load_blocks(s + (k - 8) * pitch, blocks);
+
+  filter_edge(x, taps, blimit, limit, thresh, blocks,
+              block_mask(mask_16x16 | mask_8x8), block_mask(mask_16x16));
+
+  for (k = 8 - written; k < 8 + written; ++k)
+    store_blocks(s + (k - 8) * pitch, blocks, x[k]);
+}
+
+void vp9_lpf_horizontal_row_avx2(uint8_t *s, int pitch,
+                                 unsigned int mask_16x16,
+                                 unsigned int mask_8x8,
+                                 unsigned int mask_4x4,
+                                 unsigned int mask_4x4_int,
+                                 const loop_filter_info_n *lfi_n,
+                                 const uint8_t *lfl) {
+  const unsigned int mask = mask_16x16 | mask_8x8 | mask_4x4 | mask_4x4_int;
+  uint8_t lvl[8] = { 0 };
+  uint8_t lvl_int[8] = { 0 };
+  int i;
+
+  // The filter levels as used by the C version, which filters a pair of
+  // 16x16 edges with the thresholds of the first one.
+  for (i = 0; i < 8 && (mask >> i); ++i) {
+    if ((mask >> i) & 1) {
+      const int is_16x16 = (mask_16x16 >> i) & 1;
+      const unsigned int pair = is_16x16 ? mask_16x16 :
+                                (mask_8x8 >> i) & 1 ? mask_8x8 : mask_4x4;
+      lvl[i] = lfl[i];
+      if ((mask_4x4_int >> i) & 1)
+        lvl_int[i] = lfl[i];
+      if (((pair >> i) & 3) == 3) {
+        ++i;
+        lvl[i] = is_16x16 ? lfl[i - 1] : lfl[i];
+        if ((mask_4x4_int >> i) & 1)
+          lvl_int[i] = lfl[i];
+      }
+    }
+  }
+
+  // The internal 4x4 edges of the blocks with 16x16 edges are left alone.
+  mask_4x4_int &= ~mask_16x16;
+
+  for (i = 0; i < 8; i += 4) {
+    const unsigned int m16 = (mask_16x16 >> i) & 0xf;
+    const unsigned int m8 = (mask_8x8 >> i) & 0xf;
+    const unsigned int m4 = (mask_4x4 >> i) & 0xf;
+    const unsigned int m4_int = (mask_4x4_int >> i) & 0xf;
+
+    if (m16 | m8 | m4)
+      filter_horizontal_32(s + 8 * i, pitch, m16, m8, m4, lfi_n, lvl + i);
+    if (m4_int)
+      filter_horizontal_32(s + 8 * i + 4 * pitch, pitch, 0, 0, m4_int, lfi_n,
+                           lvl_int + i);
+  }
+}
+
+// Transposes the 16x16 blocks of bytes in each 128 bit lane of in[] to out[].
+static INLINE void transpose_16x16(const __m256i *in, __m256i *out) {
+  // After the 4 rounds of interleaving register k holds the column whose
+  // index is k with its 4 bits reversed.
+  static const int bit_reverse[16] = {
+    0, 8, 4, 12, 2, 10, 6, 14, 1, 9, 5, 13, 3, 11, 7, 15
+  };
+  __m256i a[16], b[16];
+  int i;
+
+  for (i = 0; i < 8; ++i) {
+    a[i] = _mm256_unpacklo_epi8(in[2 * i], in[2 * i + 1]);
+    a[i + 8] = _mm256_unpackhi_epi8(in[2 * i], in[2 * i + 1]);
+  }
+  for (i = 0; i < 8; ++i) {
+    b[i] = _mm256_unpacklo_epi16(a[2 * i], a[2 * i + 1]);
+    b[i + 8] = _mm256_unpackhi_epi16(a[2 * i], a[2 * i + 1]);
+  }
+  for (i = 0; i < 8; ++i) {
+    a[i] = _mm256_unpacklo_epi32(b[2 * i], b[2 * i + 1]);
+    a[i + 8] = _mm256_unpackhi_epi32(b[2 * i], b[2 * i + 1]);
+  }
+  for (i = 0; i < 8; ++i) {
+    b[i] = _mm256_unpacklo_epi64(a[2 * i], a[2 * i + 1]);
+    b[i + 8] = _mm256_unpackhi_epi64(a[2 * i], a[2 * i + 1]);
+  }
+  for (i = 0; i < 16; ++i)
+    out[i] = b[bit_reverse[i]];
+}
+
+// Loads the 16 pixels from 's' of the 32 rows, rows 0 .. 15 in the low lanes
+// and 16 .. 31 in the high ones, and transposes them. Only the rows of the
+// blocks in 'blocks' are read.
+static INLINE void load_columns(const uint8_t *s, int pitch,
+                                unsigned int blocks, __m256i *x) {
+  __m256i rows[16];
+  int r;
+
+  for (r = 0; r < 16; ++r) {
+    const __m128i lo = (blocks >> (r >> 3)) & 1 ?
+        _mm_loadu_si128((const __m128i *)(s + r * pitch)) :
+        _mm_setzero_si128();
+    const __m128i hi = (blocks >> ((r + 16) >> 3)) & 1 ?
+        _mm_loadu_si128((const __m128i *)(s + (r + 16) * pitch)) :
+        _mm_setzero_si128();
+    rows[r] = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+  }
+  transpose_16x16(rows, x);
+}
+
+static INLINE void store_columns(uint8_t *s, int pitch, unsigned int blocks,
+                                 const __m256i *x) {
+  __m256i rows[16];
+  int r;
+
+  transpose_16x16(x, rows);
+  for (r = 0; r < 16; ++r) {
+    if ((blocks >> (r >> 3)) & 1)
+      _mm_storeu_si128((__m128i *)(s + r * pitch),
+                       _mm256_castsi256_si128(rows[r]));
+    if ((blocks >> ((r + 16) >> 3)) & 1)
+      _mm_storeu_si128((__m128i *)(s + (r + 16) * pitch),
+                       _mm256_extracti128_si256(rows[r], 1));
+  }
+}
+
+void vp9_lpf_vertical_row4_avx2(uint8_t *s, int pitch, int plane_type,
+                                unsigned int mask_16x16,
+                                unsigned int mask_8x8,
+                                unsigned int mask_4x4,
+                                unsigned int mask_4x4_int,
+                                const loop_filter_info_n *lfi_n,
+                                const uint8_t *lfl) {
+  const int cols = plane_type ? 4 : 8;
+  int c, r;
+
+  // The 32 rows are filtered together one column of blocks at a time, the
+  // registers holding columns of pixels, a bit of the masks per block row.
+  for (c = 0; c < cols; ++c) {
+    unsigned int m16 = 0, m8 = 0, m4 = 0, m4_int = 0, blocks;
+    uint8_t lvl[4] = { 0 }, lvl_int[4];
+    __m256i x[16], blimit, limit, thresh;
+
+    for (r = 0; r < 4; ++r) {
+      const int bit = r * cols + c;
+      m16 |= ((mask_16x16 >> bit) & 1) << r;
+      m8 |= ((mask_8x8 >> bit) & 1) << r;
+      m4 |= ((mask_4x4 >> bit) & 1) << r;
+      m4_int |= ((mask_4x4_int >> bit) & 1) << r;
+    }
+    blocks = m16 | m8 | m4 | m4_int;
+    if (!blocks)
+      continue;
+
+    // The levels of the blocks outside the frame are not set.
+    for (r = 0; r < 4; ++r) {
+      if ((blocks >> r) & 1)
+        lvl[r] = lfl[r * cols + c];
+    }
+    memcpy(lvl_int, lvl, sizeof(lvl));
+
+    // The C version filters a pair of 16x16 edges with the thresholds of the
+    // upper one.
+    for (r = 0; r < 4; r += 2) {
+      if (((m16 >> r) & 3) == 3)
+        lvl[r + 1] = lvl[r];
+    }
+
+    load_columns(s + 8 * c - 8, pitch, blocks, x);
+
+    if (m16 | m8 | m4) {
+      block_thresh(lfi_n, lvl, &blimit, &limit, &thresh);
+      filter_edge(x, m16 ? 16 : m8 ? 8 : 4, blimit, limit, thresh,
+                  block_mask(m16 | m8 | m4), block_mask(m16 | m8),
+                  block_mask(m16));
+    }
+    if (m4_int) {
+      // x[8] .. x[15] are the pixels around the internal edge.
+      block_thresh(lfi_n, lvl_int, &blimit, &limit, &thresh);
+      filter_edge(x + 4, 4, blimit, limit, thresh, block_mask(m4_int),
+                  _mm256_setzero_si256(), _mm256_setzero_si256());
+    }
+
+    store_columns(s + 8 * c - 8, pitch, blocks, x);
+  }
+}
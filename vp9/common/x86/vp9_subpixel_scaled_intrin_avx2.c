@@ -0,0 +1,203 @@
+/*
+ *  Copyright (c) 2014 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <assert.h>
+#include <immintrin.h>  // AVX2
+
+#include "./vp9_rtcd.h"
+#include "vp9/common/vp9_common.h"
+#include "vp9/common/vp9_convolve.h"
+#include "vp9/common/vp9_filter.h"
+#include "vpx_ports/mem.h"
+
+// The scaled 8-tap filters of vp9_subpixel_scaled_intrin_ssse3.c, with 8
+// output pixels per register: the two halves of a row each take 4 pixels,
+// and a column of the vertical filter is widened to 16 bits in one go.
+
+static INLINE __m128i load_kernel(const InterpKernel *filters, int q4) {
+  return _mm_loadu_si128((const __m128i *)filters[q4 & SUBPEL_MASK]);
+}
+
+// The 4 partial sums of the output pixels at q4_lo and q4_hi, in the low and
+// high lanes.
+static INLINE __m256i filter_pixels(const uint8_t *src,
+                                    const InterpKernel *filters,
+                                    int q4_lo, int q4_hi) {
+  const __m128i s = _mm_unpacklo_epi64(
+      _mm_loadl_epi64((const __m128i *)&src[q4_lo >> SUBPEL_BITS]),
+      _mm_loadl_epi64((const __m128i *)&src[q4_hi >> SUBPEL_BITS]));
+  const __m256i kernels = _mm256_inserti128_si256(
+      _mm256_castsi128_si256(load_kernel(filters, q4_lo)),
+      load_kernel(filters, q4_hi), 1);
+  return _mm256_madd_epi16(_mm256_cvtepu8_epi16(s), kernels);
+}
+
+// The 4 output pixels from q4_lo on, followed by the 4 from q4_hi on.
+static INLINE __m128i filter_horiz_8(const uint8_t *src,
+                                     const InterpKernel *filters,
+                                     int q4_lo, int q4_hi, int x_step_q4) {
+  const __m256i round = _mm256_set1_epi32(1 << (FILTER_BITS - 1));
+  const __m256i p0 = filter_pixels(src, filters, q4_lo, q4_hi);
+  const __m256i p1 = filter_pixels(src, filters, q4_lo + x_step_q4,
+                                   q4_hi + x_step_q4);
+  const __m256i p2 = filter_pixels(src, filters, q4_lo + 2 * x_step_q4,
+                                   q4_hi + 2 * x_step_q4);
+  const __m256i p3 = filter_pixels(src, filters, q4_lo + 3 * x_step_q4,
+                                   q4_hi + 3 * x_step_q4);
+  const __m256i sum = _mm256_srai_epi32(_mm256_add_epi32(
+      _mm256_hadd_epi32(_mm256_hadd_epi32(p0, p1),
+                        _mm256_hadd_epi32(p2, p3)), round), FILTER_BITS);
+  const __m128i res = _mm_packs_epi32(_mm256_castsi256_si128(sum),
+                                      _mm256_extracti128_si256(sum, 1));
+  return _mm_packus_epi16(res, res);
+}
+
+static INLINE void convolve_horiz(const uint8_t *src, ptrdiff_t src_stride,
+                                  uint8_t *dst, ptrdiff_t dst_stride,
+                                  const InterpKernel *filters,
+                                  int x0_q4, int x_step_q4, int w, int h) {
+  int x, y;
+  src -= SUBPEL_TAPS / 2 - 1;
+  for (y = 0; y < h; ++y) {
+    int x_q4 = x0_q4;
+    for (x = 0; x + 8 <= w; x += 8) {
+      _mm_storel_epi64((__m128i *)(dst + x),
+                       filter_horiz_8(src, filters, x_q4,
+                                      x_q4 + 4 * x_step_q4, x_step_q4));
+      x_q4 += 8 * x_step_q4;
+    }
+    if (x < w)
+      *(int *)(dst + x) = _mm_cvtsi128_si32(
+          filter_horiz_8(src, filters, x_q4, x_q4, x_step_q4));
+    src += src_stride;
+    dst += dst_stride;
+  }
+}
+
+// Loads 4 or 8 pixels of the rows a and b, interleaved.
+static INLINE __m128i load_pair(const uint8_t *a, const uint8_t *b,
+                                int n) {
+  const __m128i ra = n == 4 ? _mm_cvtsi32_si128(*(const int *)a) :
+                              _mm_loadl_epi64((const __m128i *)a);
+  const __m128i rb = n == 4 ? _mm_cvtsi32_si128(*(const int *)b) :
+                              _mm_loadl_epi64((const __m128i *)b);
+  return _mm_unpacklo_epi8(ra, rb);
+}
+
+// The 'n' output pixels of a row from the 8 source rows at 'src', the taps
+// paired as 32 bits in 'taps'.
+static INLINE __m128i filter_vert(const uint8_t *src, ptrdiff_t src_stride,
+                                  const __m256i *taps, int n) {
+  __m256i sum = _mm256_set1_epi32(1 << (FILTER_BITS - 1));
+  __m128i res;
+  int k;
+  for (k = 0; k < SUBPEL_TAPS; k += 2) {
+    const __m128i p = load_pair(src + k * src_stride,
+                                src + (k + 1) * src_stride, n);
+    sum = _mm256_add_epi32(sum, _mm256_madd_epi16(_mm256_cvtepu8_epi16(p),
+                                                  taps[k / 2]));
+  }
+  sum = _mm256_srai_epi32(sum, FILTER_BITS);
+  res = _mm_packs_epi32(_mm256_castsi256_si128(sum),
+                        _mm256_extracti128_si256(sum, 1));
+  return _mm_packus_epi16(res, res);
+}
+
+static INLINE void convolve_vert(const uint8_t *src, ptrdiff_t src_stride,
+                                 uint8_t *dst, ptrdiff_t dst_stride,
+                                 const InterpKernel *filters,
+                                 int y0_q4, int y_step_q4, int w, int h) {
+  int x, y;
+  int y_q4 = y0_q4;
+  src -= src_stride * (SUBPEL_TAPS / 2 - 1);
+  for (y = 0; y < h; ++y) {
+    const uint8_t *const src_y = &src[(y_q4 >> SUBPEL_BITS) * src_stride];
+    const __m256i kernel = _mm256_permute4x64_epi64(
+        _mm256_castsi128_si256(load_kernel(filters, y_q4)), 0x44);
+    __m256i taps[SUBPEL_TAPS / 2];
+    taps[0] = _mm256_shuffle_epi32(kernel, 0x00);
+    taps[1] = _mm256_shuffle_epi32(kernel, 0x55);
+    taps[2] = _mm256_shuffle_epi32(kernel, 0xaa);
+    taps[3] = _mm256_shuffle_epi32(kernel, 0xff);
+
+    for (x = 0; x + 8 <= w; x += 8)
+      _mm_storel_epi64((__m128i *)(dst + x),
+                       filter_vert(src_y + x, src_stride, taps, 8));
+    if (x < w)
+      *(int *)(dst + x) = _mm_cvtsi128_si32(
+          filter_vert(src_y + x, src_stride, taps, 4));
+    y_q4 += y_step_q4;
+    dst += dst_stride;
+  }
+}
+
+// The widths not a multiple of 4 are left to C.
+void vp9_convolve8_horiz_scaled_avx2(const uint8_t *src, ptrdiff_t src_stride,
+                                     uint8_t *dst, ptrdiff_t dst_stride,
+                                     const int16_t *filter_x, int x_step_q4,
+                                     const int16_t *filter_y, int y_step_q4,
+                                     int w, int h) {
+  const InterpKernel *const filters_x = get_filter_base(filter_x);
+  if (w & 3) {
+    vp9_convolve8_horiz_c(src, src_stride, dst, dst_stride,
+                          filter_x, x_step_q4, filter_y, y_step_q4, w, h);
+    return;
+  }
+  convolve_horiz(src, src_stride, dst, dst_stride, filters_x,
+                 get_filter_offset(filter_x, filters_x), x_step_q4, w, h);
+}
+
+void vp9_convolve8_vert_scaled_avx2(const uint8_t *src, ptrdiff_t src_stride,
+                                    uint8_t *dst, ptrdiff_t dst_stride,
+                                    const int16_t *filter_x, int x_step_q4,
+                                    const int16_t *filter_y, int y_step_q4,
+                                    int w, int h) {
+  const InterpKernel *const filters_y = get_filter_base(filter_y);
+  if (w & 3) {
+    vp9_convolve8_vert_c(src, src_stride, dst, dst_stride,
+                         filter_x, x_step_q4, filter_y, y_step_q4, w, h);
+    return;
+  }
+  convolve_vert(src, src_stride, dst, dst_stride, filters_y,
+                get_filter_offset(filter_y, filters_y), y_step_q4, w, h);
+}
+
+void vp9_convolve8_scaled_avx2(const uint8_t *src, ptrdiff_t src_stride,
+                               uint8_t *dst, ptrdiff_t dst_stride,
+                               const int16_t *filter_x, int x_step_q4,
+                               const int16_t *filter_y, int y_step_q4,
+                               int w, int h) {
+  // As in vp9_convolve8_c(), 64 rows 2x downscaled with their filter tails.
+  DECLARE_ALIGNED_ARRAY(16, uint8_t, temp, 64 * 135);
+  const InterpKernel *const filters_x = get_filter_base(filter_x);
+  const InterpKernel *const filters_y = get_filter_base(filter_y);
+  int intermediate_height = (((h - 1) * y_step_q4 + 15) >> 4) + SUBPEL_TAPS;
+
+  assert(w <= 64);
+  assert(h <= 64);
+  assert(y_step_q4 <= 32);
+  assert(x_step_q4 <= 32);
+
+  if (w & 3) {
+    vp9_convolve8_c(src, src_stride, dst, dst_stride,
+                    filter_x, x_step_q4, filter_y, y_step_q4, w, h);
+    return;
+  }
+
+  if (intermediate_height < h)
+    intermediate_height = h;
+
+  convolve_horiz(src - src_stride * (SUBPEL_TAPS / 2 - 1), src_stride, temp, 64,
+                 filters_x, get_filter_offset(filter_x, filters_x), x_step_q4,
+                 w, intermediate_height);
+  convolve_vert(temp + 64 * (SUBPEL_TAPS / 2 - 1), 64, dst, dst_stride,
+                filters_y, get_filter_offset(filter_y, filters_y), y_step_q4,
+                w, h);
+}
@@ -0,0 +1,229 @@
+/*
+ *  Copyright (c) 2014 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <assert.h>
+#include <tmmintrin.h>  // SSSE3
+
+#include "./vp9_rtcd.h"
+#include "vp9/common/vp9_common.h"
+#include "vp9/common/vp9_convolve.h"
+#include "vp9/common/vp9_filter.h"
+#include "vpx_ports/mem.h"
+
+// 8-tap filtering at any step between the output pixels, for predictions from
+// scaled references. The pixels of a row have their own kernels and source
+// positions, so each one is filtered on its own in 32 bits with pmaddwd and
+// the sums gathered with phaddd. The pixels of a column of the vertical
+// filter share the kernel of their row, filtered 8 at a time. Only the source
+// pixels read by the C versions are read.
+
+static INLINE __m128i load_kernel(const InterpKernel *filters, int q4) {
+  return _mm_loadu_si128((const __m128i *)filters[q4 & SUBPEL_MASK]);
+}
+
+// The 4 partial sums of the output pixel at x_q4, the source starting at the
+// first tap.
+static INLINE __m128i filter_pixel(const uint8_t *src,
+                                   const InterpKernel *filters, int x_q4) {
+  const __m128i s = _mm_loadl_epi64((const __m128i *)&src[x_q4 >> SUBPEL_BITS]);
+  return _mm_madd_epi16(_mm_unpacklo_epi8(s, _mm_setzero_si128()),
+                        load_kernel(filters, x_q4));
+}
+
+// The 4 output pixels from x_q4 on, rounded and as 32 bits.
+static INLINE __m128i filter_horiz_4(const uint8_t *src,
+                                     const InterpKernel *filters,
+                                     int x_q4, int x_step_q4) {
+  const __m128i p0 = filter_pixel(src, filters, x_q4);
+  const __m128i p1 = filter_pixel(src, filters, x_q4 + x_step_q4);
+  const __m128i p2 = filter_pixel(src, filters, x_q4 + 2 * x_step_q4);
+  const __m128i p3 = filter_pixel(src, filters, x_q4 + 3 * x_step_q4);
+  const __m128i round = _mm_set1_epi32(1 << (FILTER_BITS - 1));
+  const __m128i sum = _mm_hadd_epi32(_mm_hadd_epi32(p0, p1),
+                                     _mm_hadd_epi32(p2, p3));
+  return _mm_srai_epi32(_mm_add_epi32(sum, round), FILTER_BITS);
+}
+
+// Stores the 4 or 8 pixels of 'res', averaged with 'dst' for 'avg'.
+static INLINE void store_4(uint8_t *dst, __m128i res, int avg) {
+  if (avg)
+    res = _mm_avg_epu8(res, _mm_cvtsi32_si128(*(const int *)dst));
+  *(int *)dst = _mm_cvtsi128_si32(res);
+}
+
+static INLINE void store_8(uint8_t *dst, __m128i res, int avg) {
+  if (avg)
+    res = _mm_avg_epu8(res, _mm_loadl_epi64((const __m128i *)dst));
+  _mm_storel_epi64((__m128i *)dst, res);
+}
+
+static INLINE void convolve_horiz(const uint8_t *src, ptrdiff_t src_stride,
+                                  uint8_t *dst, ptrdiff_t dst_stride,
+                                  const InterpKernel *filters,
+                                  int x0_q4, int x_step_q4, int w, int h,
+                                  int avg) {
+  int x, y;
+  src -= SUBPEL_TAPS / 2 - 1;
+  for (y = 0; y < h; ++y) {
+    int x_q4 = x0_q4;
+    for (x = 0; x + 8 <= w; x += 8) {
+      const __m128i lo = filter_horiz_4(src, filters, x_q4, x_step_q4);
+      const __m128i hi = filter_horiz_4(src, filters, x_q4 + 4 * x_step_q4,
+                                        x_step_q4);
+      const __m128i res = _mm_packs_epi32(lo, hi);
+      store_8(dst + x, _mm_packus_epi16(res, res), avg);
+      x_q4 += 8 * x_step_q4;
+    }
+    if (x < w) {
+      const __m128i res = _mm_packs_epi32(
+          filter_horiz_4(src, filters, x_q4, x_step_q4), _mm_setzero_si128());
+      store_4(dst + x, _mm_packus_epi16(res, res), avg);
+    }
+    src += src_stride;
+    dst += dst_stride;
+  }
+}
+
+// Loads 4 or 8 pixels of the rows a and b, interleaved as 16 bits.
+static INLINE __m128i load_pair(const uint8_t *a, const uint8_t *b,
+                                int n) {
+  const __m128i ra = n == 4 ? _mm_cvtsi32_si128(*(const int *)a) :
+                              _mm_loadl_epi64((const __m128i *)a);
+  const __m128i rb = n == 4 ? _mm_cvtsi32_si128(*(const int *)b) :
+                              _mm_loadl_epi64((const __m128i *)b);
+  return _mm_unpacklo_epi8(ra, rb);
+}
+
+// The 'n' output pixels of a row from the 8 source rows at 'src', the taps
+// paired as 32 bits in 'taps'.
+static INLINE __m128i filter_vert(const uint8_t *src, ptrdiff_t src_stride,
+                                  const __m128i *taps, int n) {
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i round = _mm_set1_epi32(1 << (FILTER_BITS - 1));
+  __m128i lo = round, hi = round;
+  int k;
+  for (k = 0; k < SUBPEL_TAPS; k += 2) {
+    const __m128i p = load_pair(src + k * src_stride,
+                                src + (k + 1) * src_stride, n);
+    lo = _mm_add_epi32(lo, _mm_madd_epi16(_mm_unpacklo_epi8(p, zero),
+                                          taps[k / 2]));
+    hi = _mm_add_epi32(hi, _mm_madd_epi16(_mm_unpackhi_epi8(p, zero),
+                                          taps[k / 2]));
+  }
+  lo = _mm_packs_epi32(_mm_srai_epi32(lo, FILTER_BITS),
+                       _mm_srai_epi32(hi, FILTER_BITS));
+  return _mm_packus_epi16(lo, lo);
+}
+
+static INLINE void convolve_vert(const uint8_t *src, ptrdiff_t src_stride,
+                                 uint8_t *dst, ptrdiff_t dst_stride,
+                                 const InterpKernel *filters,
+                                 int y0_q4, int y_step_q4, int w, int h,
+                                 int avg) {
+  int x, y;
+  int y_q4 = y0_q4;
+  src -= src_stride * (SUBPEL_TAPS / 2 - 1);
+  for (y = 0; y < h; ++y) {
+    const uint8_t *const src_y = &src[(y_q4 >> SUBPEL_BITS) * src_stride];
+    const __m128i kernel = load_kernel(filters, y_q4);
+    __m128i taps[SUBPEL_TAPS / 2];
+    taps[0] = _mm_shuffle_epi32(kernel, 0x00);
+    taps[1] = _mm_shuffle_epi32(kernel, 0x55);
+    taps[2] = _mm_shuffle_epi32(kernel, 0xaa);
+    taps[3] = _mm_shuffle_epi32(kernel, 0xff);
+
+    for (x = 0; x + 8 <= w; x += 8)
+      store_8(dst + x, filter_vert(src_y + x, src_stride, taps, 8), avg);
+    if (x < w)
+      store_4(dst + x, filter_vert(src_y + x, src_stride, taps, 4), avg);
+    y_q4 += y_step_q4;
+    dst += dst_stride;
+  }
+}
+
+// The widths not a multiple of 4 are left to C.
+#define FUN_CONV_1D_SCALED(name, step_q4, filter, dir, avg) \
+void vp9_convolve8_##name##_scaled_ssse3(const uint8_t *src, \
+                                         ptrdiff_t src_stride, \
+                                         uint8_t *dst, ptrdiff_t dst_stride, \
+                                         const int16_t *filter_x, \
+                                         int x_step_q4, \
+                                         const int16_t *filter_y, \
+                                         int y_step_q4, int w, int h) { \
+  const InterpKernel *const filters = get_filter_base(filter); \
+  if (w & 3) { \
+    vp9_convolve8_##name##_c(src, src_stride, dst, dst_stride, \
+                             filter_x, x_step_q4, filter_y, y_step_q4, \
+                             w, h); \
+    return; \
+  } \
+  convolve_##dir(src, src_stride, dst, dst_stride, filters, \
+                 get_filter_offset(filter, filters), step_q4, w, h, avg); \
+}
+
+FUN_CONV_1D_SCALED(horiz, x_step_q4, filter_x, horiz, 0)
+FUN_CONV_1D_SCALED(vert, y_step_q4, filter_y, vert, 0)
+FUN_CONV_1D_SCALED(avg_horiz, x_step_q4, filter_x, horiz, 1)
+FUN_CONV_1D_SCALED(avg_vert, y_step_q4, filter_y, vert, 1)
+
+static INLINE void convolve(const uint8_t *src, ptrdiff_t src_stride,
+                            uint8_t *dst, ptrdiff_t dst_stride,
+                            const int16_t *filter_x, int x_step_q4,
+                            const int16_t *filter_y, int y_step_q4,
+                            int w, int h, int avg) {
+  // As in vp9_convolve8_c(), 64 rows 2x downscaled with their filter tails.
+  DECLARE_ALIGNED_ARRAY(16, uint8_t, temp, 64 * 135);
+  const InterpKernel *const filters_x = get_filter_base(filter_x);
+  const InterpKernel *const filters_y = get_filter_base(filter_y);
+  int intermediate_height = (((h - 1) * y_step_q4 + 15) >> 4) + SUBPEL_TAPS;
+
+  assert(w <= 64);
+  assert(h <= 64);
+  assert(y_step_q4 <= 32);
+  assert(x_step_q4 <= 32);
+
+  if (intermediate_height < h)
+    intermediate_height = h;
+
+  convolve_horiz(src - src_stride * (SUBPEL_TAPS / 2 - 1), src_stride, temp, 64,
+                 filters_x, get_filter_offset(filter_x, filters_x), x_step_q4,
+                 w, intermediate_height, 0);
+  convolve_vert(temp + 64 * (SUBPEL_TAPS / 2 - 1), 64, dst, dst_stride,
+                filters_y, get_filter_offset(filter_y, filters_y), y_step_q4,
+                w, h, avg);
+}
+
+void vp9_convolve8_scaled_ssse3(const uint8_t *src, ptrdiff_t src_stride,
+                                uint8_t *dst, ptrdiff_t dst_stride,
+                                const int16_t *filter_x, int x_step_q4,
+                                const int16_t *filter_y, int y_step_q4,
+                                int w, int h) {
+  if (w & 3) {
+    vp9_convolve8_c(src, src_stride, dst, dst_stride,
+                    filter_x, x_step_q4, filter_y, y_step_q4, w, h);
+    return;
+  }
+  convolve(src, src_stride, dst, dst_stride,
+           filter_x, x_step_q4, filter_y, y_step_q4, w, h, 0);
+}
+
+void vp9_convolve8_avg_scaled_ssse3(const uint8_t *src, ptrdiff_t src_stride,
+                                    uint8_t *dst, ptrdiff_t dst_stride,
+                                    const int16_t *filter_x, int x_step_q4,
+                                    const int16_t *filter_y, int y_step_q4,
+                                    int w, int h) {
+  if (w & 3) {
+    vp9_convolve8_avg_c(src, src_stride, dst, dst_stride,
+                        filter_x, x_step_q4, filter_y, y_step_q4, w, h);
+    return;
+  }
+  convolve(src, src_stride, dst, dst_stride,
+           filter_x, x_step_q4, filter_y, y_step_q4, w, h, 1);
+}
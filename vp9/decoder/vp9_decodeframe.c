@@ -338,10 +338,50 @@ static void set_ref(VP9_COMMON *const cm, MACROBLOCKD *const xd,
   xd->corrupted |= ref_buffer->buf->corrupted;
 }
 
-static void decode_block(VP9_COMMON *const cm, MACROBLOCKD *const xd,
+// In frame parallel mode, waits until the reference pixels used by the
+// inter prediction of the block are final.
+static void wait_for_ref_rows(VP9Decoder *const pbi, const MACROBLOCKD *xd,
+                              int mi_row, BLOCK_SIZE bsize) {
+  const MODE_INFO *const mi = xd->mi[0];
+  const int is_compound = has_second_ref(&mi->mbmi);
+  // Bottom of the block, in luma pixels.
+  const int y_end = (mi_row + num_8x8_blocks_high_lookup[bsize]) * MI_SIZE;
+  int ref;
+
+  for (ref = 0; ref < 1 + is_compound; ++ref) {
+    const RefBuffer *const ref_buf = xd->block_refs[ref];
+    int sb_rows = FRAME_SYNC_DONE;
+
+    // The rows read by a scaled prediction do not follow from its motion
+    // vector alone, wait for the whole reference.
+    if (!vp9_is_scaled(&ref_buf->sf)) {
+      int mv_row = mi->mbmi.mv[ref].as_mv.row;
+      int rows;
+
+      if (mi->mbmi.sb_type < BLOCK_8X8) {
+        int i;
+        for (i = 1; i < 4; ++i)
+          mv_row = MAX(mv_row, mi->bmi[i].as_mv[ref].as_mv.row);
+        mv_row = MAX(mv_row, mi->bmi[0].as_mv[ref].as_mv.row);
+      }
+
+      // Lowest row read by the interpolation filters, with the margin of the
+      // chroma planes, and the rows of the next SB row the loop filter still
+      // modifies.
+      rows = y_end + (MAX(mv_row, 0) >> 3) + 2 * (VP9_INTERP_EXTEND + 1) + 16;
+      sb_rows = (rows + (1 << (MI_BLOCK_SIZE_LOG2 + MI_SIZE_LOG2)) - 1) >>
+                (MI_BLOCK_SIZE_LOG2 + MI_SIZE_LOG2);
+    }
+    vp9_frame_sync_read(pbi->frame_sync, pbi->frame_worker_id, ref_buf->idx,
+                        sb_rows);
+  }
+}
+
+static void decode_block(VP9Decoder *const pbi, MACROBLOCKD *const xd,
                          const TileInfo *const tile,
                          int mi_row, int mi_col,
                          vp9_reader *r, BLOCK_SIZE bsize) {
+  VP9_COMMON *const cm = &pbi->common;
   const int less8x8 = bsize < BLOCK_8X8;
   MB_MODE_INFO *mbmi = set_offsets(cm, xd, tile, bsize, mi_row, mi_col);
   vp9_read_mode_info(cm, xd, tile, mi_row, mi_col, r);
@@ -367,6 +407,9 @@ static void decode_block(VP9_COMMON *const cm, MACROBLOCKD *const xd,
     if (has_second_ref(mbmi))
       set_ref(cm, xd, 1, mi_row, mi_col);
 
+    if (pbi->frame_sync != NULL)
+      wait_for_ref_rows(pbi, xd, mi_row, bsize);
+
     // Prediction
     vp9_dec_build_inter_predictors_sb(xd, mi_row, mi_col, bsize);
 
@@ -407,10 +450,11 @@ static PARTITION_TYPE read_partition(VP9_COMMON *cm, MACROBLOCKD *xd, int hbs,
   return p;
 }
 
-static void decode_partition(VP9_COMMON *const cm, MACROBLOCKD *const xd,
+static void decode_partition(VP9Decoder *const pbi, MACROBLOCKD *const xd,
                              const TileInfo *const tile,
                              int mi_row, int mi_col,
                              vp9_reader* r, BLOCK_SIZE bsize) {
+  VP9_COMMON *const cm = &pbi->common;
   const int hbs = num_8x8_blocks_wide_lookup[bsize] / 2;
   PARTITION_TYPE partition;
   BLOCK_SIZE subsize, uv_subsize;
@@ -425,27 +469,27 @@ static void decode_partition(VP9_COMMON *const cm, MACROBLOCKD *const xd,
     vpx_internal_error(&cm->error, VPX_CODEC_CORRUPT_FRAME,
                        "Invalid block size.");
   if (subsize < BLOCK_8X8) {
-    decode_block(cm, xd, tile, mi_row, mi_col, r, subsize);
+    decode_block(pbi, xd, tile, mi_row, mi_col, r, subsize);
   } else {
     switch (partition) {
       case PARTITION_NONE:
-        decode_block(cm, xd, tile, mi_row, mi_col, r, subsize);
+        decode_block(pbi, xd, tile, mi_row, mi_col, r, subsize);
         break;
       case PARTITION_HORZ:
-        decode_block(cm, xd, tile, mi_row, mi_col, r, subsize);
+        decode_block(pbi, xd, tile, mi_row, mi_col, r, subsize);
         if (mi_row + hbs < cm->mi_rows)
-          decode_block(cm, xd, tile, mi_row + hbs, mi_col, r, subsize);
+          decode_block(pbi, xd, tile, mi_row + hbs, mi_col, r, subsize);
         break;
       case PARTITION_VERT:
-        decode_block(cm, xd, tile, mi_row, mi_col, r, subsize);
+        decode_block(pbi, xd, tile, mi_row, mi_col, r, subsize);
         if (mi_col + hbs < cm->mi_cols)
-          decode_block(cm, xd, tile, mi_row, mi_col + hbs, r, subsize);
+          decode_block(pbi, xd, tile, mi_row, mi_col + hbs, r, subsize);
         break;
       case PARTITION_SPLIT:
-        decode_partition(cm, xd, tile, mi_row,       mi_col,       r, subsize);
-        decode_partition(cm, xd, tile, mi_row,       mi_col + hbs, r, subsize);
-        decode_partition(cm, xd, tile, mi_row + hbs, mi_col,       r, subsize);
-        decode_partition(cm, xd, tile, mi_row + hbs, mi_col + hbs, r, subsize);
+        decode_partition(pbi, xd, tile, mi_row,       mi_col,       r, subsize);
+        decode_partition(pbi, xd, tile, mi_row,       mi_col + hbs, r, subsize);
+        decode_partition(pbi, xd, tile, mi_row + hbs, mi_col,       r, subsize);
+        decode_partition(pbi, xd, tile, mi_row + hbs, mi_col + hbs, r, subsize);
         break;
       default:
         assert(0 && "Invalid partition type");
@@ -650,7 +694,9 @@ static void resize_context_buffers(VP9_COMMON *cm, int width, int height) {
   }
 }
 
-static void setup_frame_size(VP9_COMMON *cm, struct vp9_read_bit_buffer *rb) {
+static void setup_frame_size(VP9Decoder *pbi,
+                             struct vp9_read_bit_buffer *rb) {
+  VP9_COMMON *const cm = &pbi->common;
   int width, height;
   vp9_read_frame_size(rb, &width, &height);
   resize_context_buffers(cm, width, height);
@@ -662,7 +708,7 @@ static void setup_frame_size(VP9_COMMON *cm, struct vp9_read_bit_buffer *rb) {
 #if CONFIG_VP9_HIGHBITDEPTH
           cm->use_highbitdepth,
 #endif
-          VP9_DEC_BORDER_IN_PIXELS,
+          pbi->frame_border,
           &cm->frame_bufs[cm->new_fb_idx].raw_frame_buffer, cm->get_fb_cb,
           cm->cb_priv)) {
     vpx_internal_error(&cm->error, VPX_CODEC_MEM_ERROR,
@@ -679,8 +725,9 @@ static INLINE int valid_ref_frame_img_fmt(vpx_bit_depth_t ref_bit_depth,
          ref_yss == this_yss;
 }
 
-static void setup_frame_size_with_refs(VP9_COMMON *cm,
+static void setup_frame_size_with_refs(VP9Decoder *pbi,
                                        struct vp9_read_bit_buffer *rb) {
+  VP9_COMMON *const cm = &pbi->common;
   int width, height;
   int found = 0, i;
   int has_valid_ref_frame = 0;
@@ -738,7 +785,7 @@ static void setup_frame_size_with_refs(VP9_COMMON *cm,
 #if CONFIG_VP9_HIGHBITDEPTH
           cm->use_highbitdepth,
 #endif
-          VP9_DEC_BORDER_IN_PIXELS,
+          pbi->frame_border,
           &cm->frame_bufs[cm->new_fb_idx].raw_frame_buffer, cm->get_fb_cb,
           cm->cb_priv)) {
     vpx_internal_error(&cm->error, VPX_CODEC_MEM_ERROR,
@@ -908,6 +955,12 @@ static const uint8_t *decode_tiles(VP9Decoder *pbi,
     vp9_tile_set_row(&tile, cm, tile_row);
     for (mi_row = tile.mi_row_start; mi_row < tile.mi_row_end;
          mi_row += MI_BLOCK_SIZE) {
+      // The motion vector prediction reads the co-located modes of the
+      // previous frame.
+      if (pbi->frame_sync != NULL && cm->prev_mi != NULL)
+        vp9_frame_sync_read(pbi->frame_sync, pbi->frame_worker_id,
+                            pbi->prev_fb_idx,
+                            (mi_row >> MI_BLOCK_SIZE_LOG2) + 1);
       for (tile_col = 0; tile_col < tile_cols; ++tile_col) {
         const int col = pbi->inv_tile_order ?
                         tile_cols - tile_col - 1 : tile_col;
@@ -917,7 +970,7 @@ static const uint8_t *decode_tiles(VP9Decoder *pbi,
         vp9_zero(tile_data->xd.left_seg_context);
         for (mi_col = tile.mi_col_start; mi_col < tile.mi_col_end;
              mi_col += MI_BLOCK_SIZE) {
-          decode_partition(tile_data->cm, &tile_data->xd, &tile, mi_row, mi_col,
+          decode_partition(pbi, &tile_data->xd, &tile, mi_row, mi_col,
                            &tile_data->bit_reader, BLOCK_64X64);
         }
         pbi->mb.corrupted |= tile_data->xd.corrupted;
@@ -940,7 +993,15 @@ static const uint8_t *decode_tiles(VP9Decoder *pbi,
           winterface->launch(&pbi->lf_worker);
         } else {
           winterface->execute(&pbi->lf_worker);
+          // Frame workers always filter in their own thread: the rows above
+          // the filtered ones are final.
+          if (pbi->frame_sync != NULL)
+            vp9_frame_sync_write(pbi->frame_sync, cm->new_fb_idx,
+                                 mi_row >> MI_BLOCK_SIZE_LOG2);
         }
+      } else if (pbi->frame_sync != NULL) {
+        vp9_frame_sync_write(pbi->frame_sync, cm->new_fb_idx,
+                             (mi_row + MI_BLOCK_SIZE) >> MI_BLOCK_SIZE_LOG2);
       }
     }
   }
@@ -954,27 +1015,49 @@ static const uint8_t *decode_tiles(VP9Decoder *pbi,
     winterface->execute(&pbi->lf_worker);
   }
 
+  if (pbi->frame_sync != NULL)
+    vp9_frame_sync_write(pbi->frame_sync, cm->new_fb_idx, FRAME_SYNC_DONE);
+
   // Get last tile data.
   tile_data = pbi->tile_data + tile_cols * tile_rows - 1;
 
   return vp9_reader_find_end(&tile_data->bit_reader);
 }
 
-static int tile_worker_hook(TileWorkerData *const tile_data,
-                            const TileInfo *const tile) {
-  int mi_row, mi_col;
+static int tile_worker_hook(TileWorkerData *const tile_worker_data,
+                            void *unused) {
+  VP9Decoder *const pbi = tile_worker_data->pbi;
+  VP9_COMMON *const cm = tile_worker_data->cm;
+  int corrupted = 0;
+  int col;
+
+  (void)unused;
+  while ((col = vp9_tile_sync_next_tile(&pbi->tile_sync)) >= 0) {
+    TileData *const tile_data = pbi->tile_data + col;
+    TileInfo tile;
+    int mi_row, mi_col;
 
-  for (mi_row = tile->mi_row_start; mi_row < tile->mi_row_end;
-       mi_row += MI_BLOCK_SIZE) {
-    vp9_zero(tile_data->xd.left_context);
-    vp9_zero(tile_data->xd.left_seg_context);
-    for (mi_col = tile->mi_col_start; mi_col < tile->mi_col_end;
-         mi_col += MI_BLOCK_SIZE) {
-      decode_partition(tile_data->cm, &tile_data->xd, tile,
-                       mi_row, mi_col, &tile_data->bit_reader, BLOCK_64X64);
+    vp9_tile_init(&tile, cm, 0, col);
+    for (mi_row = tile.mi_row_start; mi_row < tile.mi_row_end;
+         mi_row += MI_BLOCK_SIZE) {
+      vp9_zero(tile_data->xd.left_context);
+      vp9_zero(tile_data->xd.left_seg_context);
+      for (mi_col = tile.mi_col_start; mi_col < tile.mi_col_end;
+           mi_col += MI_BLOCK_SIZE) {
+        decode_partition(pbi, &tile_data->xd, &tile, mi_row, mi_col,
+                         &tile_data->bit_reader, BLOCK_64X64);
+      }
+      vp9_tile_sync_write(&pbi->tile_sync, mi_row >> MI_BLOCK_SIZE_LOG2,
+                          tile_data->xd.corrupted);
     }
+    corrupted |= tile_data->xd.corrupted;
   }
-  return !tile_data->xd.corrupted;
+
+  // Out of tile columns: help with the loop filter.
+  if (cm->lf.filter_level)
+    vp9_loop_filter_rows_mt(&tile_worker_data->lfdata, &pbi->tile_sync,
+                            tile_worker_data->worker_id);
+  return !corrupted;
 }
 
 // sorts in descending order
@@ -995,14 +1078,13 @@ static const uint8_t *decode_tiles_mt(VP9Decoder *pbi,
                                       const uint8_t *data_end) {
   VP9_COMMON *const cm = &pbi->common;
   const VP9WorkerInterface *const winterface = vp9_get_worker_interface();
-  const uint8_t *bit_reader_end = NULL;
   const int aligned_mi_cols = mi_cols_aligned_to_sb(cm->mi_cols);
+  const int sb_rows = mi_cols_aligned_to_sb(cm->mi_rows) >> MI_BLOCK_SIZE_LOG2;
   const int tile_cols = 1 << cm->log2_tile_cols;
   const int tile_rows = 1 << cm->log2_tile_rows;
   const int num_workers = MIN(pbi->max_threads & ~1, tile_cols);
   TileBuffer tile_buffers[1][1 << 6];
   int n;
-  int final_worker = -1;
 
   assert(tile_cols <= (1 << 6));
   assert(tile_rows == 1);
@@ -1024,7 +1106,6 @@ static const uint8_t *decode_tiles_mt(VP9Decoder *pbi,
       winterface->init(worker);
       CHECK_MEM_ERROR(cm, worker->data1,
                       vpx_memalign(32, sizeof(TileWorkerData)));
-      CHECK_MEM_ERROR(cm, worker->data2, vpx_malloc(sizeof(TileInfo)));
       if (i < num_threads - 1 && !winterface->reset(worker)) {
         vpx_internal_error(&cm->error, VPX_CODEC_ERROR,
                            "Tile decoder thread creation failed");
@@ -1038,6 +1119,21 @@ static const uint8_t *decode_tiles_mt(VP9Decoder *pbi,
     pbi->tile_workers[n].hook = (VP9WorkerHook)tile_worker_hook;
   }
 
+  if (pbi->tile_sync.rows != sb_rows) {
+    vp9_tile_sync_dealloc(&pbi->tile_sync);
+    vp9_tile_sync_alloc(&pbi->tile_sync, cm, sb_rows, pbi->num_tile_workers);
+  }
+
+  if (cm->lf.filter_level) {
+    if (!pbi->lf_row_sync.sync_range || cm->last_height != cm->height) {
+      vp9_row_sync_dealloc(&pbi->lf_row_sync);
+      vp9_row_sync_alloc(&pbi->lf_row_sync, cm, sb_rows, cm->width);
+    }
+    vp9_loop_filter_frame_init(cm, cm->lf.filter_level);
+    // Mark all SB rows as not filtered.
+    vp9_row_sync_reset(&pbi->lf_row_sync);
+  }
+
   // Note: this memset assumes above_context[0], [1] and [2]
   // are allocated as part of the same buffer.
   vpx_memset(cm->above_context, 0,
@@ -1048,72 +1144,63 @@ static const uint8_t *decode_tiles_mt(VP9Decoder *pbi,
   // Load tile data into tile_buffers
   get_tile_buffers(pbi, data, data_end, tile_cols, tile_rows, tile_buffers);
 
-  // Sort the buffers based on size in descending order.
-  qsort(tile_buffers[0], tile_cols, sizeof(tile_buffers[0][0]),
-        compare_tile_buffers);
-
-  // Rearrange the tile buffers such that per-tile group the largest, and
-  // presumably the most difficult, tile will be decoded in the main thread.
-  // This should help minimize the number of instances where the main thread is
-  // waiting for a worker to complete.
-  {
-    int group_start = 0;
-    while (group_start < tile_cols) {
-      const TileBuffer largest = tile_buffers[0][group_start];
-      const int group_end = MIN(group_start + num_workers, tile_cols) - 1;
-      memmove(tile_buffers[0] + group_start, tile_buffers[0] + group_start + 1,
-              (group_end - group_start) * sizeof(tile_buffers[0][0]));
-      tile_buffers[0][group_end] = largest;
-      group_start = group_end + 1;
-    }
+  if (pbi->tile_data == NULL || tile_cols != pbi->total_tiles) {
+    vpx_free(pbi->tile_data);
+    CHECK_MEM_ERROR(cm, pbi->tile_data,
+                    vpx_memalign(32, tile_cols * sizeof(*pbi->tile_data)));
+    pbi->total_tiles = tile_cols;
   }
 
-  n = 0;
-  while (n < tile_cols) {
-    int i;
-    for (i = 0; i < num_workers && n < tile_cols; ++i) {
-      VP9Worker *const worker = &pbi->tile_workers[i];
-      TileWorkerData *const tile_data = (TileWorkerData*)worker->data1;
-      TileInfo *const tile = (TileInfo*)worker->data2;
-      TileBuffer *const buf = &tile_buffers[0][n];
+  for (n = 0; n < tile_cols; ++n) {
+    const TileBuffer *const buf = &tile_buffers[0][n];
+    TileData *const tile_data = pbi->tile_data + buf->col;
+
+    tile_data->cm = cm;
+    tile_data->xd = pbi->mb;
+    tile_data->xd.corrupted = 0;
+    setup_token_decoder(buf->data, data_end, buf->size, &cm->error,
+                        &tile_data->bit_reader, pbi->decrypt_cb,
+                        pbi->decrypt_state);
+    init_macroblockd(cm, &tile_data->xd);
+    vp9_zero(tile_data->xd.dqcoeff);
+  }
 
-      tile_data->cm = cm;
-      tile_data->xd = pbi->mb;
-      tile_data->xd.corrupted = 0;
-      vp9_tile_init(tile, tile_data->cm, 0, buf->col);
-      setup_token_decoder(buf->data, data_end, buf->size, &cm->error,
-                          &tile_data->bit_reader, pbi->decrypt_cb,
-                          pbi->decrypt_state);
-      init_macroblockd(cm, &tile_data->xd);
-      vp9_zero(tile_data->xd.dqcoeff);
+  // Sort the buffers based on size in descending order: the largest, and
+  // presumably the most difficult, tiles are decoded first, so the workers
+  // run out of work at about the same time.
+  qsort(tile_buffers[0], tile_cols, sizeof(tile_buffers[0][0]),
+        compare_tile_buffers);
+  vp9_tile_sync_reset(&pbi->tile_sync, tile_cols);
+  for (n = 0; n < tile_cols; ++n)
+    pbi->tile_sync.tile_order[n] = tile_buffers[0][n].col;
 
-      worker->had_error = 0;
-      if (i == num_workers - 1 || n == tile_cols - 1) {
-        winterface->execute(worker);
-      } else {
-        winterface->launch(worker);
-      }
+  for (n = 0; n < num_workers; ++n) {
+    VP9Worker *const worker = &pbi->tile_workers[n];
+    TileWorkerData *const tile_data = (TileWorkerData*)worker->data1;
+    LFWorkerData *const lf_data = &tile_data->lfdata;
 
-      if (buf->col == tile_cols - 1) {
-        final_worker = i;
-      }
+    tile_data->pbi = pbi;
+    tile_data->cm = cm;
+    tile_data->worker_id = n;
 
-      ++n;
-    }
+    lf_data->frame_buffer = get_frame_new_buffer(cm);
+    lf_data->cm = cm;
+    vp9_copy(lf_data->planes, pbi->mb.plane);
+    lf_data->y_only = 0;
+    lf_data->lf_sync = &pbi->lf_row_sync;
 
-    for (; i > 0; --i) {
-      VP9Worker *const worker = &pbi->tile_workers[i - 1];
-      pbi->mb.corrupted |= !winterface->sync(worker);
-    }
-    if (final_worker > -1) {
-      TileWorkerData *const tile_data =
-          (TileWorkerData*)pbi->tile_workers[final_worker].data1;
-      bit_reader_end = vp9_reader_find_end(&tile_data->bit_reader);
-      final_worker = -1;
+    worker->had_error = 0;
+    if (n == num_workers - 1) {
+      winterface->execute(worker);
+    } else {
+      winterface->launch(worker);
     }
   }
 
-  return bit_reader_end;
+  for (n = 0; n < num_workers; ++n)
+    pbi->mb.corrupted |= !winterface->sync(&pbi->tile_workers[n]);
+
+  return vp9_reader_find_end(&pbi->tile_data[tile_cols - 1].bit_reader);
 }
 
 static void error_handler(void *data) {
@@ -1221,7 +1308,7 @@ static size_t read_uncompressed_header(VP9Decoder *pbi,
       cm->frame_refs[i].buf = NULL;
     }
 
-    setup_frame_size(cm, rb);
+    setup_frame_size(pbi, rb);
     pbi->need_resync = 0;
   } else {
     cm->intra_only = cm->show_frame ? 0 : vp9_rb_read_bit(rb);
@@ -1245,7 +1332,7 @@ static size_t read_uncompressed_header(VP9Decoder *pbi,
       }
 
       pbi->refresh_frame_flags = vp9_rb_read_literal(rb, REF_FRAMES);
-      setup_frame_size(cm, rb);
+      setup_frame_size(pbi, rb);
       pbi->need_resync = 0;
     } else {
       pbi->refresh_frame_flags = vp9_rb_read_literal(rb, REF_FRAMES);
@@ -1258,7 +1345,7 @@ static size_t read_uncompressed_header(VP9Decoder *pbi,
         cm->ref_frame_sign_bias[LAST_FRAME + i] = vp9_rb_read_bit(rb);
       }
 
-      setup_frame_size_with_refs(cm, rb);
+      setup_frame_size_with_refs(pbi, rb);
 
       cm->allow_high_precision_mv = vp9_rb_read_bit(rb);
       cm->interp_filter = read_interp_filter(rb);
@@ -1269,8 +1356,6 @@ static size_t read_uncompressed_header(VP9Decoder *pbi,
                                           ref_buf->buf->y_crop_width,
                                           ref_buf->buf->y_crop_height,
                                           cm->width, cm->height);
-        if (vp9_is_scaled(&ref_buf->sf))
-          vp9_extend_frame_borders(ref_buf->buf);
       }
     }
   }
@@ -1432,9 +1517,9 @@ static struct vp9_read_bit_buffer* init_read_bit_buffer(
   return rb;
 }
 
-void vp9_decode_frame(VP9Decoder *pbi,
-                      const uint8_t *data, const uint8_t *data_end,
-                      const uint8_t **p_data_end) {
+size_t vp9_read_frame_headers(VP9Decoder *pbi,
+                              const uint8_t *data, const uint8_t *data_end,
+                              const uint8_t **p_data_end) {
   VP9_COMMON *const cm = &pbi->common;
   MACROBLOCKD *const xd = &pbi->mb;
   struct vp9_read_bit_buffer rb = { NULL, NULL, 0, NULL, 0};
@@ -1442,15 +1527,13 @@ void vp9_decode_frame(VP9Decoder *pbi,
   uint8_t clear_data[MAX_VP9_HEADER_SIZE];
   const size_t first_partition_size = read_uncompressed_header(pbi,
       init_read_bit_buffer(pbi, &rb, data, data_end, clear_data));
-  const int tile_rows = 1 << cm->log2_tile_rows;
-  const int tile_cols = 1 << cm->log2_tile_cols;
   YV12_BUFFER_CONFIG *const new_fb = get_frame_new_buffer(cm);
   xd->cur_buf = new_fb;
 
   if (!first_partition_size) {
     // showing a frame directly
     *p_data_end = data + (cm->profile <= PROFILE_2 ? 1 : 2);
-    return;
+    return 0;
   }
 
   data += vp9_rb_bytes_read(&rb);
@@ -1475,22 +1558,38 @@ void vp9_decode_frame(VP9Decoder *pbi,
   xd->corrupted = 0;
   new_fb->corrupted = read_compressed_header(pbi, data, first_partition_size);
 
+  *p_data_end = data + first_partition_size;
+  return first_partition_size;
+}
+
+void vp9_decode_frame_tiles(VP9Decoder *pbi,
+                            const uint8_t *data, const uint8_t *data_end,
+                            const uint8_t **p_data_end) {
+  VP9_COMMON *const cm = &pbi->common;
+  MACROBLOCKD *const xd = &pbi->mb;
+  const int tile_rows = 1 << cm->log2_tile_rows;
+  const int tile_cols = 1 << cm->log2_tile_cols;
+  YV12_BUFFER_CONFIG *const new_fb = get_frame_new_buffer(cm);
+
   // TODO(jzern): remove frame_parallel_decoding_mode restriction for
   // single-frame tile decoding.
   if (pbi->max_threads > 1 && tile_rows == 1 && tile_cols > 1 &&
       cm->frame_parallel_decoding_mode) {
-    *p_data_end = decode_tiles_mt(pbi, data + first_partition_size, data_end);
-    if (!xd->corrupted) {
-      // If multiple threads are used to decode tiles, then we use those threads
-      // to do parallel loopfiltering.
-      vp9_loop_filter_frame_mt(new_fb, pbi, cm, cm->lf.filter_level, 0);
-    }
+    // The tile threads also loop filter the SB rows, as soon as they are
+    // decoded in all the tile columns.
+    *p_data_end = decode_tiles_mt(pbi, data, data_end);
   } else {
-    *p_data_end = decode_tiles(pbi, data + first_partition_size, data_end);
+    *p_data_end = decode_tiles(pbi, data, data_end);
   }
 
   new_fb->corrupted |= xd->corrupted;
 
+  // The borders are only read by the application: in frame parallel mode
+  // the frame workers may read them through the overhang of the blocks
+  // crossing the edges of the frame, but never use what they read there.
+  if (pbi->extend_frame_borders)
+    vp9_extend_frame_borders(new_fb);
+
   if (!new_fb->corrupted) {
     if (!cm->error_resilient_mode && !cm->frame_parallel_decoding_mode) {
       vp9_adapt_coef_probs(cm);
@@ -1510,3 +1609,10 @@ void vp9_decode_frame(VP9Decoder *pbi,
   if (cm->refresh_frame_context)
     cm->frame_contexts[cm->frame_context_idx] = cm->fc;
 }
+
+void vp9_decode_frame(VP9Decoder *pbi,
+                      const uint8_t *data, const uint8_t *data_end,
+                      const uint8_t **p_data_end) {
+  if (vp9_read_frame_headers(pbi, data, data_end, p_data_end))
+    vp9_decode_frame_tiles(pbi, *p_data_end, data_end, p_data_end);
+}
@@ -26,6 +26,20 @@ void vp9_decode_frame(struct VP9Decoder *pbi,
                       const uint8_t *data, const uint8_t *data_end,
                       const uint8_t **p_data_end);
 
+// The two halves of vp9_decode_frame(), used by frame parallel decoding.
+// vp9_read_frame_headers() parses the uncompressed and compressed headers and
+// sets *p_data_end to the start of the tile data. It returns 0 if the frame
+// only shows an existing frame, in which case there is nothing else to decode.
+size_t vp9_read_frame_headers(struct VP9Decoder *pbi,
+                              const uint8_t *data, const uint8_t *data_end,
+                              const uint8_t **p_data_end);
+
+// Decodes the tiles starting at 'data', and adapts and stores the entropy
+// context of the frame.
+void vp9_decode_frame_tiles(struct VP9Decoder *pbi,
+                            const uint8_t *data, const uint8_t *data_end,
+                            const uint8_t **p_data_end);
+
 int vp9_read_sync_code(struct vp9_read_bit_buffer *const rb);
 void vp9_read_frame_size(struct vp9_read_bit_buffer *rb,
                          int *width, int *height);
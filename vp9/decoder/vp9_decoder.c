@@ -11,6 +11,7 @@
 #include <assert.h>
 #include <limits.h>
 #include <stdio.h>
+#include <string.h>
 
 #include "./vpx_scale_rtcd.h"
 
@@ -33,6 +34,9 @@
 #include "vp9/decoder/vp9_detokenize.h"
 #include "vp9/decoder/vp9_dthread.h"
 
+// Maximum number of frames decoded at once in frame parallel decoding.
+#define MAX_FRAME_WORKER_THREADS 4
+
 static void initialize_dec() {
   static int init_done = 0;
 
@@ -60,6 +64,11 @@ VP9Decoder *vp9_decoder_create() {
   }
 
   cm->error.setjmp = 1;
+
+  CHECK_MEM_ERROR(cm, cm->frame_bufs,
+                  (RefCntBuffer *)vpx_calloc(FRAME_BUFFERS,
+                                             sizeof(*cm->frame_bufs)));
+
   pbi->need_resync = 1;
   initialize_dec();
 
@@ -68,6 +77,7 @@ VP9Decoder *vp9_decoder_create() {
 
   cm->current_video_frame = 0;
   pbi->ready_for_new_data = 1;
+  pbi->frame_border = VP9_DEC_BORDER_IN_PIXELS;
   cm->bit_depth = VPX_BITS_8;
 
   // vp9_init_dequantizer() is first called here. Add check in
@@ -81,13 +91,49 @@ VP9Decoder *vp9_decoder_create() {
 
   vp9_get_worker_interface()->init(&pbi->lf_worker);
 
+  pbi->last_worker = -1;
+  pbi->seg_map_worker = -1;
+  pbi->output.fb_idx = -1;
+  pbi->prev_fb_idx = -1;
+
   return pbi;
 }
 
+static void remove_frame_workers(VP9Decoder *pbi) {
+  int i;
+
+  vp9_drain_frame_workers(pbi);
+  for (i = 0; i < pbi->num_frame_workers; ++i) {
+    VP9Worker *const worker = &pbi->frame_workers[i];
+    FrameWorkerData *const frame_data = (FrameWorkerData *)worker->data1;
+
+    vp9_get_worker_interface()->end(worker);
+    if (frame_data != NULL) {
+      if (frame_data->pbi != NULL) {
+        // The frame buffers belong to 'pbi'.
+        frame_data->pbi->common.frame_bufs = NULL;
+        vp9_decoder_remove(frame_data->pbi);
+      }
+      vpx_free(frame_data->data);
+      vpx_free(frame_data);
+    }
+  }
+  vpx_free(pbi->frame_workers);
+  pbi->frame_workers = NULL;
+  pbi->num_frame_workers = 0;
+
+  vp9_frame_sync_dealloc(pbi->frame_sync);
+  vpx_free(pbi->frame_sync);
+  pbi->frame_sync = NULL;
+}
+
 void vp9_decoder_remove(VP9Decoder *pbi) {
   VP9_COMMON *const cm = &pbi->common;
   int i;
 
+  if (pbi->frame_workers != NULL)
+    remove_frame_workers(pbi);
+
   vp9_get_worker_interface()->end(&pbi->lf_worker);
   vpx_free(pbi->lf_worker.data1);
   vpx_free(pbi->tile_data);
@@ -95,12 +141,12 @@ void vp9_decoder_remove(VP9Decoder *pbi) {
     VP9Worker *const worker = &pbi->tile_workers[i];
     vp9_get_worker_interface()->end(worker);
     vpx_free(worker->data1);
-    vpx_free(worker->data2);
   }
   vpx_free(pbi->tile_workers);
 
   if (pbi->num_tile_workers > 0) {
-    vp9_loop_filter_dealloc(&pbi->lf_row_sync);
+    vp9_row_sync_dealloc(&pbi->lf_row_sync);
+    vp9_tile_sync_dealloc(&pbi->tile_sync);
   }
 
   vp9_remove_common(cm);
@@ -211,6 +257,481 @@ static void swap_frame_buffers(VP9Decoder *pbi) {
     cm->frame_refs[ref_index].idx = INT_MAX;
 }
 
+// Drops a reference to a frame buffer, and releases its memory once it is no
+// longer used.
+static void release_fb(VP9_COMMON *cm, int idx) {
+  RefCntBuffer *const buf = &cm->frame_bufs[idx];
+
+  if (buf->ref_count > 0 && --buf->ref_count == 0)
+    cm->release_fb_cb(cm->cb_priv, &buf->raw_frame_buffer);
+}
+
+static void copy_error(struct vpx_internal_error_info *dst,
+                       const struct vpx_internal_error_info *src) {
+  dst->error_code = src->error_code;
+  dst->has_detail = src->has_detail;
+  memcpy(dst->detail, src->detail, sizeof(dst->detail));
+}
+
+// Copies the state that persists from frame to frame, between the decoder
+// instance of the application and the ones of the frame workers. The buffers
+// owned by each instance, as well as the frame size they are allocated for,
+// are left alone.
+static void copy_frame_state(VP9_COMMON *dst, const VP9_COMMON *src) {
+  const int last_sharpness_level = dst->lf.last_sharpness_level;
+
+  memcpy(dst->y_dequant, src->y_dequant, sizeof(src->y_dequant));
+  memcpy(dst->uv_dequant, src->uv_dequant, sizeof(src->uv_dequant));
+  dst->color_space = src->color_space;
+  dst->display_width = src->display_width;
+  dst->display_height = src->display_height;
+  dst->last_width = src->last_width;
+  dst->last_height = src->last_height;
+  dst->subsampling_x = src->subsampling_x;
+  dst->subsampling_y = src->subsampling_y;
+#if CONFIG_VP9_HIGHBITDEPTH
+  dst->use_highbitdepth = src->use_highbitdepth;
+#endif
+  memcpy(dst->ref_frame_map, src->ref_frame_map, sizeof(src->ref_frame_map));
+  memcpy(dst->frame_refs, src->frame_refs, sizeof(src->frame_refs));
+  dst->last_frame_type = src->last_frame_type;
+  dst->frame_type = src->frame_type;
+  dst->show_frame = src->show_frame;
+  dst->last_show_frame = src->last_show_frame;
+  dst->show_existing_frame = src->show_existing_frame;
+  dst->intra_only = src->intra_only;
+  dst->allow_high_precision_mv = src->allow_high_precision_mv;
+  dst->reset_frame_context = src->reset_frame_context;
+  dst->tx_mode = src->tx_mode;
+  dst->base_qindex = src->base_qindex;
+  dst->y_dc_delta_q = src->y_dc_delta_q;
+  dst->uv_dc_delta_q = src->uv_dc_delta_q;
+  dst->uv_ac_delta_q = src->uv_ac_delta_q;
+  dst->interp_filter = src->interp_filter;
+  dst->refresh_frame_context = src->refresh_frame_context;
+  memcpy(dst->ref_frame_sign_bias, src->ref_frame_sign_bias,
+         sizeof(src->ref_frame_sign_bias));
+  // The loop filter thresholds are derived from the sharpness by each
+  // instance.
+  dst->lf = src->lf;
+  dst->lf.last_sharpness_level = last_sharpness_level;
+  dst->seg = src->seg;
+  dst->allow_comp_inter_inter = src->allow_comp_inter_inter;
+  dst->comp_fixed_ref = src->comp_fixed_ref;
+  memcpy(dst->comp_var_ref, src->comp_var_ref, sizeof(src->comp_var_ref));
+  dst->reference_mode = src->reference_mode;
+  dst->fc = src->fc;
+  memcpy(dst->frame_contexts, src->frame_contexts,
+         sizeof(src->frame_contexts));
+  dst->frame_context_idx = src->frame_context_idx;
+  dst->current_video_frame = src->current_video_frame;
+  dst->profile = src->profile;
+  dst->bit_depth = src->bit_depth;
+  dst->error_resilient_mode = src->error_resilient_mode;
+  dst->frame_parallel_decoding_mode = src->frame_parallel_decoding_mode;
+  dst->log2_tile_cols = src->log2_tile_cols;
+  dst->log2_tile_rows = src->log2_tile_rows;
+}
+
+static int frame_worker_hook(void *arg1, void *arg2) {
+  FrameWorkerData *const frame_data = (FrameWorkerData *)arg1;
+  VP9Decoder *const pbi = frame_data->pbi;
+  VP9_COMMON *const cm = &pbi->common;
+  const uint8_t *data_end;
+  (void)arg2;
+
+  if (setjmp(cm->error.jmp)) {
+    cm->error.setjmp = 0;
+    vp9_clear_system_state();
+    get_frame_new_buffer(cm)->corrupted = 1;
+    // Let the frames referencing this one run to completion.
+    vp9_frame_sync_write(pbi->frame_sync, cm->new_fb_idx, FRAME_SYNC_DONE);
+    return 0;
+  }
+
+  cm->error.setjmp = 1;
+  vp9_decode_frame_tiles(pbi, frame_data->tile_start,
+                         frame_data->data + frame_data->data_size, &data_end);
+  vp9_clear_system_state();
+  cm->error.setjmp = 0;
+  return 1;
+}
+
+int vp9_init_frame_workers(VP9Decoder *pbi, int num_threads) {
+  VP9_COMMON *const cm = &pbi->common;
+  const VP9WorkerInterface *const winterface = vp9_get_worker_interface();
+  const int num_workers = MIN(num_threads, MAX_FRAME_WORKER_THREADS) + 1;
+
+  if (setjmp(cm->error.jmp)) {
+    cm->error.setjmp = 0;
+    return -1;
+  }
+
+  cm->error.setjmp = 1;
+
+  CHECK_MEM_ERROR(cm, pbi->frame_workers,
+                  (VP9Worker *)vpx_calloc(num_workers,
+                                          sizeof(*pbi->frame_workers)));
+  CHECK_MEM_ERROR(cm, pbi->frame_sync,
+                  (VP9FrameSync *)vpx_calloc(1, sizeof(*pbi->frame_sync)));
+  vp9_frame_sync_alloc(pbi->frame_sync, cm, num_workers);
+
+  // The worker count is kept in 'pbi' rather than a local, so that it
+  // survives the longjmp() of a failed allocation.
+  while (pbi->num_frame_workers < num_workers) {
+    const int i = pbi->num_frame_workers;
+    VP9Worker *const worker = &pbi->frame_workers[i];
+    FrameWorkerData *frame_data;
+    VP9Decoder *child;
+
+    winterface->init(worker);
+    ++pbi->num_frame_workers;
+    CHECK_MEM_ERROR(cm, worker->data1, vpx_calloc(1, sizeof(*frame_data)));
+    frame_data = (FrameWorkerData *)worker->data1;
+
+    child = vp9_decoder_create();
+    if (child == NULL)
+      vpx_internal_error(&cm->error, VPX_CODEC_MEM_ERROR,
+                         "Failed to allocate frame worker");
+    frame_data->pbi = child;
+
+    child->max_threads = 1;
+    child->inv_tile_order = pbi->inv_tile_order;
+    child->frame_border = pbi->frame_border;
+    child->extend_frame_borders = pbi->extend_frame_borders;
+    child->frame_sync = pbi->frame_sync;
+    child->frame_worker_id = i;
+    vpx_free(child->common.frame_bufs);
+    child->common.frame_bufs = cm->frame_bufs;
+    child->common.cb_priv = cm->cb_priv;
+    child->common.get_fb_cb = cm->get_fb_cb;
+    child->common.release_fb_cb = cm->release_fb_cb;
+
+    worker->hook = frame_worker_hook;
+    if (!winterface->reset(worker))
+      vpx_internal_error(&cm->error, VPX_CODEC_ERROR,
+                         "Frame worker thread creation failed");
+  }
+
+  cm->error.setjmp = 0;
+  return 0;
+}
+
+static void drop_output(VP9Decoder *pbi, int fb_idx, int seq) {
+  int i, n = 0;
+
+  for (i = 0; i < pbi->num_outputs; ++i) {
+    if (pbi->outputs[i].fb_idx == fb_idx && pbi->outputs[i].seq == seq)
+      release_fb(&pbi->common, pbi->outputs[i].fb_idx);
+    else
+      pbi->outputs[n++] = pbi->outputs[i];
+  }
+  pbi->num_outputs = n;
+}
+
+// Queues frame buffer 'fb_idx' for output, taking over a reference to it.
+static void push_output(VP9Decoder *pbi, int fb_idx, int seq) {
+  FrameOutput *output;
+
+  if (pbi->num_outputs == FRAME_BUFFERS) {
+    // The application does not retrieve the frames: drop the oldest one.
+    release_fb(&pbi->common, pbi->outputs[0].fb_idx);
+    memmove(pbi->outputs, pbi->outputs + 1,
+            (FRAME_BUFFERS - 1) * sizeof(pbi->outputs[0]));
+    --pbi->num_outputs;
+  }
+
+  output = &pbi->outputs[pbi->num_outputs++];
+  output->fb_idx = fb_idx;
+  output->seq = seq;
+  output->user_priv = pbi->user_priv;
+}
+
+// Waits for the oldest frame being decoded, and releases what it used.
+static int retire_frame(VP9Decoder *pbi) {
+  VP9_COMMON *const cm = &pbi->common;
+  const int oldest = (pbi->last_worker - pbi->num_pending + 1 +
+                      pbi->num_frame_workers) % pbi->num_frame_workers;
+  VP9Worker *const worker = &pbi->frame_workers[oldest];
+  FrameWorkerData *const frame_data = (FrameWorkerData *)worker->data1;
+  const VP9_COMMON *const worker_cm = &frame_data->pbi->common;
+  const int ok = vp9_get_worker_interface()->sync(worker);
+  int i;
+
+  assert(pbi->num_pending > 0);
+
+  if (!ok) {
+    pbi->need_resync = 1;
+    copy_error(&cm->error, &worker_cm->error);
+    drop_output(pbi, frame_data->fb_idx, frame_data->seq);
+  } else if (frame_data->adapt_context) {
+    cm->frame_contexts[worker_cm->frame_context_idx] =
+        worker_cm->frame_contexts[worker_cm->frame_context_idx];
+  }
+
+  for (i = 0; i < frame_data->num_holds; ++i)
+    release_fb(cm, frame_data->holds[i]);
+  frame_data->num_holds = 0;
+
+  pbi->retired_seq = frame_data->seq;
+  --pbi->num_pending;
+  return ok ? 0 : -1;
+}
+
+int vp9_drain_frame_workers(VP9Decoder *pbi) {
+  int ret = 0;
+
+  while (pbi->num_pending > 0) {
+    if (retire_frame(pbi))
+      ret = -1;
+  }
+  return ret;
+}
+
+static int get_free_fb_parallel(VP9Decoder *pbi) {
+  VP9_COMMON *const cm = &pbi->common;
+
+  for (;;) {
+    int i;
+
+    for (i = 0; i < FRAME_BUFFERS; ++i) {
+      if (cm->frame_bufs[i].ref_count == 0) {
+        cm->frame_bufs[i].ref_count = 1;
+        return i;
+      }
+    }
+
+    // All the frame buffers are used by the frames being decoded.
+    if (pbi->num_pending == 0) {
+      vpx_internal_error(&cm->error, VPX_CODEC_MEM_ERROR,
+                         "No free frame buffer");
+      return -1;
+    }
+    if (retire_frame(pbi))
+      return -1;
+  }
+}
+
+// Makes the segmentation map of the previous frames available to the frame
+// worker 'w', which may have to wait for the frame that produced it.
+static int setup_seg_map(VP9Decoder *pbi, int w, int stream_resized) {
+  VP9_COMMON *const worker_cm =
+      &((FrameWorkerData *)pbi->frame_workers[w].data1)->pbi->common;
+  const size_t map_size = worker_cm->mi_rows * worker_cm->mi_cols;
+
+  if (stream_resized || frame_is_intra_only(worker_cm) ||
+      worker_cm->error_resilient_mode) {
+    vpx_memset(worker_cm->last_frame_seg_map, 0, map_size);
+    pbi->seg_map_worker = w;
+  } else if (worker_cm->seg.enabled) {
+    const int owner = pbi->seg_map_worker;
+
+    // Maps coded without temporal prediction do not depend on the previous
+    // one.
+    if (owner != w &&
+        !(worker_cm->seg.update_map && !worker_cm->seg.temporal_update)) {
+      if (owner >= 0) {
+        const FrameWorkerData *const owner_data =
+            (const FrameWorkerData *)pbi->frame_workers[owner].data1;
+
+        while (pbi->retired_seq < owner_data->seq) {
+          if (retire_frame(pbi))
+            return -1;
+        }
+        vpx_memcpy(worker_cm->last_frame_seg_map,
+                   owner_data->pbi->common.last_frame_seg_map, map_size);
+      } else {
+        vpx_memset(worker_cm->last_frame_seg_map, 0, map_size);
+      }
+    }
+    pbi->seg_map_worker = w;
+  }
+  return 0;
+}
+
+// Parses the frame headers of the data held by 'frame_data' with its worker
+// decoder. Returns -1 on error, 0 if an existing frame is shown and 1 if the
+// tiles of the frame have to be decoded.
+static int read_worker_headers(VP9Decoder *pbi, FrameWorkerData *frame_data,
+                               size_t size) {
+  VP9Decoder *const child = frame_data->pbi;
+  VP9_COMMON *const ccm = &child->common;
+  int ret;
+
+  if (setjmp(ccm->error.jmp)) {
+    ccm->error.setjmp = 0;
+    vp9_clear_system_state();
+    pbi->need_resync = 1;
+    if (ccm->frame_refs[0].idx != INT_MAX && ccm->frame_refs[0].buf != NULL)
+      ccm->frame_refs[0].buf->corrupted = 1;
+    release_fb(&pbi->common, ccm->new_fb_idx);
+    copy_error(&pbi->common.error, &ccm->error);
+    return -1;
+  }
+
+  ccm->error.setjmp = 1;
+  ret = vp9_read_frame_headers(child, frame_data->data,
+                               frame_data->data + size,
+                               &frame_data->tile_start) != 0;
+  ccm->error.setjmp = 0;
+  return ret;
+}
+
+static int receive_frame_parallel(VP9Decoder *pbi,
+                                  size_t size, const uint8_t **psource) {
+  VP9_COMMON *const cm = &pbi->common;
+  const uint8_t *const source = *psource;
+  const int w = pbi->next_worker;
+  VP9Worker *const worker = &pbi->frame_workers[w];
+  FrameWorkerData *const frame_data = (FrameWorkerData *)worker->data1;
+  VP9Decoder *const child = frame_data->pbi;
+  VP9_COMMON *const ccm = &child->common;
+  int fb_idx, stream_resized, mask, ref_index, ret;
+
+  // Keep a frame worker available for the next frame, and wait for the
+  // entropy contexts the frame header is coded with.
+  while (pbi->num_pending > 0 &&
+         (pbi->num_pending > pbi->num_frame_workers - 2 ||
+          ((FrameWorkerData *)pbi->frame_workers[pbi->last_worker].data1)
+              ->adapt_context)) {
+    if (retire_frame(pbi))
+      return -1;
+  }
+
+  if (frame_data->data_alloc_size < size) {
+    vpx_free(frame_data->data);
+    frame_data->data = (uint8_t *)vpx_malloc(size);
+    frame_data->data_alloc_size = frame_data->data != NULL ? size : 0;
+    if (frame_data->data == NULL) {
+      vpx_internal_error(&cm->error, VPX_CODEC_MEM_ERROR,
+                         "Failed to allocate frame data");
+      return -1;
+    }
+  }
+  if (pbi->decrypt_cb != NULL)
+    pbi->decrypt_cb(pbi->decrypt_state, source, frame_data->data, (int)size);
+  else if (size > 0)
+    vpx_memcpy(frame_data->data, source, size);
+  frame_data->data_size = size;
+
+  fb_idx = get_free_fb_parallel(pbi);
+  if (fb_idx < 0)
+    return -1;
+
+  // The worker predicts motion vectors from its own modes unless told
+  // otherwise below.
+  if (ccm->mip_array[ccm->prev_mi_idx] != NULL) {
+    ccm->prev_mip = ccm->mip_array[ccm->prev_mi_idx];
+    ccm->prev_mi_grid_base = ccm->mi_grid_base_array[ccm->prev_mi_idx];
+    ccm->prev_mi = ccm->prev_mip + ccm->mi_stride + 1;
+    ccm->prev_mi_grid_visible = ccm->prev_mi_grid_base + ccm->mi_stride + 1;
+  }
+  copy_frame_state(ccm, cm);
+  ccm->new_fb_idx = fb_idx;
+  child->need_resync = pbi->need_resync;
+  child->decrypt_cb = NULL;
+  child->prev_fb_idx = -1;
+
+  ret = read_worker_headers(pbi, frame_data, size);
+  if (ret < 0)
+    return -1;
+  if (ret == 0) {
+    // Showing an existing frame: it is output once the frames decoded so far
+    // are complete.
+    push_output(pbi, ccm->new_fb_idx, pbi->submitted_seq);
+    copy_frame_state(cm, ccm);
+    pbi->refresh_frame_flags = 0;
+    cm->current_video_frame++;
+    *psource = source + (frame_data->tile_start - frame_data->data);
+    return 0;
+  }
+
+  stream_resized = ccm->width != cm->width || ccm->height != cm->height;
+  if (setup_seg_map(pbi, w, stream_resized)) {
+    release_fb(cm, fb_idx);
+    return -1;
+  }
+
+  frame_data->fb_idx = fb_idx;
+  frame_data->seq = ++pbi->submitted_seq;
+  frame_data->holds[0] = fb_idx;
+  frame_data->num_holds = 1;
+  if (!frame_is_intra_only(ccm)) {
+    int i;
+    for (i = 0; i < REFS_PER_FRAME; ++i) {
+      frame_data->holds[frame_data->num_holds++] = ccm->frame_refs[i].idx;
+      ++cm->frame_bufs[ccm->frame_refs[i].idx].ref_count;
+    }
+  }
+
+  // Predict the motion vectors from the modes of the previous frame, as
+  // decoded by its own worker.
+  if (ccm->prev_mi != NULL && pbi->last_worker >= 0) {
+    const FrameWorkerData *const prev_data =
+        (const FrameWorkerData *)pbi->frame_workers[pbi->last_worker].data1;
+    const VP9_COMMON *const prev_cm = &prev_data->pbi->common;
+
+    ccm->prev_mip = prev_cm->mip;
+    ccm->prev_mi = prev_cm->mi;
+    ccm->prev_mi_grid_base = prev_cm->mi_grid_base;
+    ccm->prev_mi_grid_visible = prev_cm->mi_grid_visible;
+    child->prev_fb_idx = prev_data->fb_idx;
+    frame_data->holds[frame_data->num_holds++] = prev_data->fb_idx;
+    ++cm->frame_bufs[prev_data->fb_idx].ref_count;
+  } else {
+    ccm->prev_mi = NULL;
+  }
+
+  // Contexts that are not adapted are final once the header is parsed.
+  frame_data->adapt_context = 0;
+  if (ccm->refresh_frame_context) {
+    if (ccm->error_resilient_mode || ccm->frame_parallel_decoding_mode)
+      ccm->frame_contexts[ccm->frame_context_idx] = ccm->fc;
+    else
+      frame_data->adapt_context = 1;
+  }
+
+  copy_frame_state(cm, ccm);
+  cm->width = ccm->width;
+  cm->height = ccm->height;
+  pbi->refresh_frame_flags = child->refresh_frame_flags;
+  pbi->need_resync = child->need_resync;
+
+  // Update the references.
+  for (mask = pbi->refresh_frame_flags, ref_index = 0; mask;
+       mask >>= 1, ++ref_index) {
+    if (mask & 1) {
+      const int old_idx = cm->ref_frame_map[ref_index];
+      cm->ref_frame_map[ref_index] = fb_idx;
+      ++cm->frame_bufs[fb_idx].ref_count;
+      if (old_idx >= 0)
+        release_fb(cm, old_idx);
+    }
+  }
+
+  if (cm->show_frame) {
+    ++cm->frame_bufs[fb_idx].ref_count;
+    push_output(pbi, fb_idx, frame_data->seq);
+  }
+
+  vp9_frame_sync_start(pbi->frame_sync, fb_idx);
+  vp9_get_worker_interface()->launch(worker);
+  ++pbi->num_pending;
+  pbi->last_worker = w;
+  pbi->next_worker = (w + 1) % pbi->num_frame_workers;
+
+  cm->new_fb_idx = fb_idx;
+  cm->last_width = cm->width;
+  cm->last_height = cm->height;
+  cm->last_show_frame = cm->show_frame;
+  if (cm->show_frame)
+    cm->current_video_frame++;
+
+  // Frames without a superframe index are assumed to hold a single frame.
+  *psource = source + size;
+  return 0;
+}
+
 int vp9_receive_compressed_data(VP9Decoder *pbi,
                                 size_t size, const uint8_t **psource) {
   VP9_COMMON *const cm = &pbi->common;
@@ -219,6 +740,13 @@ int vp9_receive_compressed_data(VP9Decoder *pbi,
 
   cm->error.error_code = VPX_CODEC_OK;
 
+  if (pbi->frame_workers != NULL) {
+    if (size == 0 && cm->frame_refs[0].idx != INT_MAX &&
+        cm->frame_refs[0].buf != NULL)
+      cm->frame_refs[0].buf->corrupted = 1;
+    return receive_frame_parallel(pbi, size, psource);
+  }
+
   if (size == 0) {
     // This is used to signal that we are missing frames.
     // We do not know if the missing frame(s) was supposed to update
@@ -293,6 +821,24 @@ int vp9_get_raw_frame(VP9Decoder *pbi, YV12_BUFFER_CONFIG *sd,
   (void)*flags;
 #endif
 
+  if (pbi->frame_workers != NULL) {
+    // Frame parallel decoding: the frames are output in order, once complete.
+    if (pbi->output.fb_idx >= 0) {
+      release_fb(cm, pbi->output.fb_idx);
+      pbi->output.fb_idx = -1;
+    }
+    if (pbi->num_outputs == 0 || pbi->outputs[0].seq > pbi->retired_seq)
+      return ret;
+
+    pbi->output = pbi->outputs[0];
+    --pbi->num_outputs;
+    memmove(pbi->outputs, pbi->outputs + 1,
+            pbi->num_outputs * sizeof(pbi->outputs[0]));
+    cm->frame_to_show = &cm->frame_bufs[pbi->output.fb_idx].buf;
+    *sd = *cm->frame_to_show;
+    return 0;
+  }
+
   if (pbi->ready_for_new_data == 1)
     return ret;
 
@@ -26,13 +26,41 @@
 extern "C" {
 #endif
 
-// TODO(hkuang): combine this with TileWorkerData.
+// Decoding state of a tile. The tile workers of decode_tiles_mt() take the
+// tile columns in any order, so this is kept per tile rather than per worker.
 typedef struct TileData {
   VP9_COMMON *cm;
   vp9_reader bit_reader;
   DECLARE_ALIGNED(16, MACROBLOCKD, xd);
 } TileData;
 
+// A frame handed over to a frame worker in frame parallel decoding.
+typedef struct FrameWorkerData {
+  struct VP9Decoder *pbi;  // Decoder instance of the frame worker.
+  // Copy of the (decrypted) compressed frame.
+  uint8_t *data;
+  size_t data_size;
+  size_t data_alloc_size;
+  const uint8_t *tile_start;
+  int fb_idx;
+  int seq;  // Decode order of the frame, starting at 1.
+  // Set when the frame context is adapted at the end of the decoding, so the
+  // next frame header can only be parsed once the frame is complete.
+  int adapt_context;
+  // Frame buffers kept alive until the frame is complete: the new frame, its
+  // references and the frame its motion vectors are predicted from.
+  int holds[REFS_PER_FRAME + 2];
+  int num_holds;
+} FrameWorkerData;
+
+// A shown frame of frame parallel decoding, available once all the frames up
+// to 'seq' in decode order are complete.
+typedef struct FrameOutput {
+  int fb_idx;
+  int seq;
+  void *user_priv;
+} FrameOutput;
+
 typedef struct VP9Decoder {
   DECLARE_ALIGNED(16, MACROBLOCKD, mb);
 
@@ -51,7 +79,8 @@ typedef struct VP9Decoder {
   TileData *tile_data;
   int total_tiles;
 
-  VP9LfSync lf_row_sync;
+  VP9RowSync lf_row_sync;
+  VP9TileSync tile_sync;
 
   vpx_decrypt_cb decrypt_cb;
   void *decrypt_state;
@@ -59,6 +88,36 @@ typedef struct VP9Decoder {
   int max_threads;
   int inv_tile_order;
   int need_resync;  // wait for key/intra-only frame
+
+  // Border of the frame buffers, in pixels. The decoder itself only reads
+  // past the edges of the frames through on demand border extension; the
+  // decoded frames are only extended into the border for the application.
+  int frame_border;
+  int extend_frame_borders;
+
+  // Frame parallel decoding. The decoder instance of the application parses
+  // the frame headers and owns the frame buffers; up to num_frame_workers - 1
+  // frames are decoded at once by the frame workers, each one with its own
+  // decoder instance.
+  VP9Worker *frame_workers;
+  int num_frame_workers;
+  int num_pending;     // Frames being decoded, in the workers before next_worker.
+  int next_worker;
+  int last_worker;     // Worker of the last decoded frame, -1 if none.
+  int seg_map_worker;  // Worker holding the current segmentation map.
+  int submitted_seq;
+  int retired_seq;
+  FrameOutput outputs[FRAME_BUFFERS];
+  int num_outputs;
+  FrameOutput output;  // Frame returned by the last vp9_get_raw_frame().
+  void *user_priv;     // Attached to the output of the next frame.
+
+  // Decoding progress of the frame buffers, shared with the frame workers.
+  VP9FrameSync *frame_sync;
+  // Frame worker only: waiter index in frame_sync, and frame buffer of the
+  // frame the modes of prev_mi belong to.
+  int frame_worker_id;
+  int prev_fb_idx;
 } VP9Decoder;
 
 int vp9_receive_compressed_data(struct VP9Decoder *pbi,
@@ -67,6 +126,16 @@ int vp9_receive_compressed_data(struct VP9Decoder *pbi,
 int vp9_get_raw_frame(struct VP9Decoder *pbi, YV12_BUFFER_CONFIG *sd,
                       vp9_ppflags_t *flags);
 
+// Enables frame parallel decoding with up to 'num_threads' frames decoded at
+// once. Has to be called before the first frame, after the frame buffer
+// callbacks are set. Returns 0 on success.
+int vp9_init_frame_workers(struct VP9Decoder *pbi, int num_threads);
+
+// Waits until all the frames passed to vp9_receive_compressed_data() are
+// decoded, so their output is available from vp9_get_raw_frame(). Returns a
+// negative value if decoding one of them failed.
+int vp9_drain_frame_workers(struct VP9Decoder *pbi);
+
 vpx_codec_err_t vp9_copy_reference_dec(struct VP9Decoder *pbi,
                                        VP9_REFFRAME ref_frame_flag,
                                        YV12_BUFFER_CONFIG *sd);
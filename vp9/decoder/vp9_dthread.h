@@ -11,7 +11,12 @@
 #ifndef VP9_DECODER_VP9_DTHREAD_H_
 #define VP9_DECODER_VP9_DTHREAD_H_
 
+#include <limits.h>
+
 #include "./vpx_config.h"
+#include "vpx_ports/vpx_atomics.h"
+#include "vp9/common/vp9_onyxc_int.h"
+#include "vp9/common/vp9_row_sync.h"
 #include "vp9/common/vp9_thread.h"
 #include "vp9/decoder/vp9_reader.h"
 
@@ -19,40 +24,109 @@ struct VP9Common;
 struct VP9Decoder;
 
 typedef struct TileWorkerData {
+  struct VP9Decoder *pbi;
   struct VP9Common *cm;
-  vp9_reader bit_reader;
-  DECLARE_ALIGNED(16, struct macroblockd, xd);
+  // Index of the worker among the tile workers.
+  int worker_id;
 
   // Row-based parallel loopfilter data
   LFWorkerData lfdata;
 } TileWorkerData;
 
-// Loopfilter row synchronization
-typedef struct VP9LfSyncData {
+// Synchronization of the tile workers decoding the tile columns of a frame.
+// The tile columns are handed out largest first to the workers; a worker out
+// of tile columns moves on to loop filter SB rows, as soon as all the tile
+// columns have decoded the rows the filtering touches.
+typedef struct VP9TileSync {
 #if CONFIG_MULTITHREAD
-  pthread_mutex_t *mutex_;
+  pthread_mutex_t mutex_;
+  // One per worker, as the win32 condition emulation only supports a single
+  // waiting thread.
   pthread_cond_t *cond_;
 #endif
-  // Allocate memory to store the loop-filtered superblock index in each row.
-  int *cur_sb_col;
-  // The optimal sync_range for different resolution and platform should be
-  // determined by testing. Currently, it is chosen to be a power-of-2 number.
-  int sync_range;
+  // Number of SB rows each worker waits for, 0 if none.
+  int *waiting_rows;
+  int num_waiters;
+  // Number of tile columns that have decoded each SB row.
+  int *tiles_done;
   int rows;
-} VP9LfSync;
+  int tile_cols;
+  // Number of leading SB rows decoded in all the tile columns.
+  int rows_done;
+  // Set once a tile column is corrupted: the waiters stop waiting then.
+  int corrupted;
+  // Set once a waiter gave up waiting.
+  int stopped;
+  // Tile columns in decoding order, and index of the next one to decode.
+  int tile_order[1 << 6];
+  vpx_atomic_int next_tile;
+} VP9TileSync;
+
+// Value of VP9FrameSync.sb_rows for frame buffers that are not being decoded.
+#define FRAME_SYNC_DONE INT_MAX
+
+// Decoding progress of the frame buffers, for frame parallel decoding. The
+// frame worker decoding a frame publishes the number of its SB rows that are
+// reconstructed and loop filtered; the frame workers decoding the following
+// frames wait on it before they use the frame as a reference.
+typedef struct VP9FrameSync {
+#if CONFIG_MULTITHREAD
+  pthread_mutex_t mutex_;
+  // One per waiter, as the win32 condition emulation only supports a single
+  // waiting thread.
+  pthread_cond_t *cond_;
+#endif
+  // Frame buffer each waiter is blocked on, -1 if none.
+  int *waiting_fb;
+  int num_waiters;
+  vpx_atomic_int sb_rows[FRAME_BUFFERS];
+} VP9FrameSync;
+
+// Allocate the synchronization data of 'num_waiters' frame workers. All the
+// frame buffers are marked as complete.
+void vp9_frame_sync_alloc(VP9FrameSync *frame_sync, struct VP9Common *cm,
+                          int num_waiters);
+
+void vp9_frame_sync_dealloc(VP9FrameSync *frame_sync);
+
+// Mark frame buffer 'fb_idx' as not decoded. Has to be called before the
+// decoding of a frame into it starts, while no worker waits on it.
+void vp9_frame_sync_start(VP9FrameSync *frame_sync, int fb_idx);
+
+// Publish that 'sb_rows' SB rows of frame buffer 'fb_idx' are final.
+void vp9_frame_sync_write(VP9FrameSync *frame_sync, int fb_idx, int sb_rows);
+
+// Wait until 'sb_rows' SB rows of frame buffer 'fb_idx' are final.
+void vp9_frame_sync_read(VP9FrameSync *frame_sync, int waiter, int fb_idx,
+                         int sb_rows);
+
+// Allocate the synchronization data of 'num_waiters' workers decoding a frame
+// of 'rows' SB rows.
+void vp9_tile_sync_alloc(VP9TileSync *tile_sync, struct VP9Common *cm,
+                         int rows, int num_waiters);
+
+void vp9_tile_sync_dealloc(VP9TileSync *tile_sync);
+
+// Mark all SB rows as not decoded, with 'tile_cols' tile columns to decode.
+// Has to be called before each frame, while no worker uses 'tile_sync'.
+void vp9_tile_sync_reset(VP9TileSync *tile_sync, int tile_cols);
+
+// Take the next tile column to decode. Returns -1 once all are taken.
+int vp9_tile_sync_next_tile(VP9TileSync *tile_sync);
 
-// Allocate memory for loopfilter row synchronization.
-void vp9_loop_filter_alloc(VP9LfSync *lf_sync, VP9_COMMON *cm, int rows,
-                           int width);
+// Publish that a tile column has decoded SB row 'sb_row', 'corrupted' if
+// the tile column is corrupted.
+void vp9_tile_sync_write(VP9TileSync *tile_sync, int sb_row, int corrupted);
 
-// Deallocate loopfilter synchronization related mutex and data.
-void vp9_loop_filter_dealloc(VP9LfSync *lf_sync);
+// Wait until the first 'sb_rows' SB rows are decoded in all the tile columns.
+// Returns 0, for this and all the later calls, if they are not as one of the
+// tile columns is corrupted.
+int vp9_tile_sync_read(VP9TileSync *tile_sync, int waiter, int sb_rows);
 
-// Multi-threaded loopfilter that uses the tile threads.
-void vp9_loop_filter_frame_mt(YV12_BUFFER_CONFIG *frame,
-                              struct VP9Decoder *pbi,
-                              struct VP9Common *cm,
-                              int frame_filter_level,
-                              int y_only);
+// Loop filter SB rows taken from 'lf_data->lf_sync', from the tile worker
+// 'waiter', until all the rows of the frame are taken. The rows are filtered
+// once their decoding, and the decoding of the row below, is complete.
+void vp9_loop_filter_rows_mt(LFWorkerData *const lf_data,
+                             VP9TileSync *tile_sync, int waiter);
 
 #endif  // VP9_DECODER_VP9_DTHREAD_H_
@@ -0,0 +1,364 @@
+/*
+ *  Copyright (c) 2014 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <assert.h>
+
+#include "./vpx_config.h"
+#include "vpx_mem/vpx_mem.h"
+
+#include "vp9/common/vp9_systemdependent.h"
+#include "vp9/common/vp9_tile_common.h"
+
+#include "vp9/encoder/cpu/vp9_ecpu.h"
+#include "vp9/encoder/vp9_context_tree.h"
+#include "vp9/encoder/vp9_encodeframe.h"
+#include "vp9/encoder/vp9_ethread.h"
+
+// CPU backend of the GPU compute interface. The work done by the OpenCL
+// kernels in vp9_pick_inter_mode.cl (ZEROMV and NEWMV search of the GPU block
+// sizes) is run through the regular, SIMD optimized, data parallel pick mode
+// path on a pool of worker threads. As with the GPU, the frame is processed
+// one sub frame after another, so that the encoder can start coding the
+// first sub frame while the workers are still analyzing the remaining ones.
+
+static void ecpu_process_sb_row(VP9_COMP *cpi, ECPU_THREAD_DATA *thread_data,
+                                int mi_row, int bsize_mask) {
+  VP9_COMMON *const cm = &cpi->common;
+  VP9_EGPU *const egpu = &cpi->egpu;
+  MACROBLOCK *const x = &thread_data->mb;
+  const int tile_cols = 1 << cm->log2_tile_cols;
+  TileInfo tile;
+  int tile_col;
+
+  vp9_get_tile_row_index(&tile, cm, mi_row);
+  for (tile_col = 0; tile_col < tile_cols; ++tile_col) {
+    GPU_BLOCK_SIZE gpu_bsize;
+
+    vp9_tile_set_col(&tile, cm, tile_col);
+    // All the block sizes of a SB row are analyzed by the same worker, as
+    // they share the MODE_INFO of the co-located blocks as scratch.
+    for (gpu_bsize = 0; gpu_bsize < GPU_BLOCK_SIZES; ++gpu_bsize) {
+      const BLOCK_SIZE bsize = get_actual_block_size(gpu_bsize);
+      const int ms = num_8x8_blocks_wide_lookup[bsize];
+      const int hbs = ms >> 1;
+      int row, col;
+
+      if (!(bsize_mask & (1 << gpu_bsize)))
+        continue;
+
+      for (row = mi_row; row < mi_row + MI_BLOCK_SIZE; row += ms) {
+        for (col = tile.mi_col_start; col < tile.mi_col_end; col += ms) {
+          const GPU_INPUT *gpu_input;
+
+          // Blocks that are forced to split are not analyzed on the GPU.
+          if (row + hbs >= cm->mi_rows || col + hbs >= cm->mi_cols)
+            continue;
+
+          gpu_input = egpu->gpu_input[gpu_bsize] +
+              get_gpu_buffer_index(cpi, row, col, gpu_bsize);
+          if (!gpu_input->do_compute)
+            continue;
+
+          vp9_pick_inter_mode_data_parallel(cpi, x, &tile, row, col, bsize,
+                                            &thread_data->ctx);
+        }
+      }
+    }
+  }
+}
+
+// Publish the completion of a SB row to the encoder threads. Any number of
+// them may be waiting for the same sub frame, so all of them are woken up.
+static void ecpu_set_row_done(VP9_ECPU *ecpu, int sb_row) {
+#if CONFIG_MULTITHREAD
+  pthread_mutex_lock(&ecpu->mutex);
+  ecpu->sb_row_done[sb_row] = 1;
+  pthread_cond_broadcast(&ecpu->cond);
+  pthread_mutex_unlock(&ecpu->mutex);
+#else
+  ecpu->sb_row_done[sb_row] = 1;
+#endif
+}
+
+static int ecpu_worker_hook(ECPU_THREAD_DATA *const thread_data,
+                            void *unused) {
+  VP9_COMP *const cpi = thread_data->cpi;
+  VP9_COMMON *const cm = &cpi->common;
+  VP9_ECPU *const ecpu = cpi->egpu.compute_framework;
+  SubFrameInfo subframe;
+  int sb_row;
+
+  (void)unused;
+  vp9_subframe_init(&subframe, cm, CPU_SUB_FRAMES);
+
+  // SB rows are interleaved across the workers. Each worker walks its rows
+  // top to bottom, so the sub frames complete in order.
+  for (sb_row = (subframe.mi_row_start >> MI_BLOCK_SIZE_LOG2) +
+                thread_data->thread_id;
+       sb_row < cm->sb_rows; sb_row += ecpu->num_workers) {
+    const int mi_row = sb_row << MI_BLOCK_SIZE_LOG2;
+    const int subframe_idx = vp9_get_subframe_index(cm, mi_row);
+
+    ecpu_process_sb_row(cpi, thread_data, mi_row,
+                        ecpu->active_bsize_mask[subframe_idx]);
+    vp9_clear_system_state();
+    ecpu_set_row_done(ecpu, sb_row);
+  }
+
+  return 1;
+}
+
+static void ecpu_launch_workers(VP9_COMP *cpi) {
+  VP9_COMMON *const cm = &cpi->common;
+  VP9_ECPU *const ecpu = cpi->egpu.compute_framework;
+  const VP9WorkerInterface *const winterface = vp9_get_worker_interface();
+  int i;
+
+  // The previous frame's analysis is complete by now, as the encoder waited
+  // for all its rows. Sync anyway so that the worker data can be reused.
+  for (i = 0; i < ecpu->num_workers; ++i)
+    winterface->sync(&ecpu->workers[i]);
+
+  for (i = 0; i < MAX_SUB_FRAMES; ++i) {
+    ecpu->active_bsize_mask[i] = ecpu->bsize_mask[i];
+    ecpu->bsize_mask[i] = 0;
+  }
+  vpx_memset(ecpu->sb_row_done, 0,
+             sizeof(*ecpu->sb_row_done) * cm->sb_rows);
+
+  for (i = 0; i < ecpu->num_workers; ++i) {
+    VP9Worker *const worker = &ecpu->workers[i];
+    ECPU_THREAD_DATA *const thread_data = &ecpu->thread_data[i];
+    MACROBLOCK *const x = &thread_data->mb;
+    PICK_MODE_CONTEXT *const ctx = &thread_data->ctx;
+    int plane;
+
+    // Copy the mb context on this thread, while 'cpi->mb' is not being
+    // modified by the encoder. The coefficient buffers are the worker's own,
+    // as the encoder threads use theirs meanwhile.
+    vp9_mb_copy(cpi, x, &cpi->mb);
+    for (plane = 0; plane < MAX_MB_PLANE; ++plane) {
+      x->plane[plane].coeff = ctx->coeff_pbuf[plane][0];
+      x->plane[plane].qcoeff = ctx->qcoeff_pbuf[plane][0];
+      x->e_mbd.plane[plane].dqcoeff = ctx->dqcoeff_pbuf[plane][0];
+      x->plane[plane].eobs = ctx->eobs_pbuf[plane][0];
+    }
+    vp9_zero(x->zcoeff_blk);
+    x->thread_id = i;
+    x->stats = &thread_data->stats;
+    x->use_gpu = 1;
+    x->data_parallel_processing = 1;
+    thread_data->cpi = cpi;
+    thread_data->thread_id = i;
+
+    worker->hook = (VP9WorkerHook)ecpu_worker_hook;
+    worker->data1 = thread_data;
+    worker->data2 = NULL;
+    winterface->launch(worker);
+  }
+}
+
+static void vp9_ecpu_alloc_buffers(VP9_COMP *cpi) {
+  VP9_COMMON *const cm = &cpi->common;
+  VP9_EGPU *const egpu = &cpi->egpu;
+  VP9_ECPU *const ecpu = egpu->compute_framework;
+  GPU_BLOCK_SIZE gpu_bsize;
+  int i;
+
+  CHECK_MEM_ERROR(cm, egpu->gpu_rd_parameters,
+                  vpx_calloc(1, sizeof(*egpu->gpu_rd_parameters)));
+
+  for (gpu_bsize = 0; gpu_bsize < GPU_BLOCK_SIZES; gpu_bsize++) {
+    const BLOCK_SIZE bsize = get_actual_block_size(gpu_bsize);
+    const int blocks_in_row = cpi->blocks_in_row[gpu_bsize];
+    const int blocks_in_col = cm->sb_rows * num_mxn_blocks_high_lookup[bsize];
+    const int alloc_size = blocks_in_row * blocks_in_col;
+
+    CHECK_MEM_ERROR(cm, egpu->gpu_input[gpu_bsize],
+                    vpx_calloc(alloc_size, sizeof(GPU_INPUT)));
+    CHECK_MEM_ERROR(cm, ecpu->gpu_output[gpu_bsize],
+                    vpx_memalign(32, alloc_size * sizeof(GPU_OUTPUT)));
+    vpx_memset(ecpu->gpu_output[gpu_bsize], 0,
+               alloc_size * sizeof(GPU_OUTPUT));
+
+    // The workers write their results through 'gpu_output_base', so it has
+    // to be valid before the first sub frame is acquired by the encoder.
+    cpi->gpu_output_base[gpu_bsize] = ecpu->gpu_output[gpu_bsize];
+  }
+
+  CHECK_MEM_ERROR(cm, ecpu->sb_row_done,
+                  vpx_calloc(cm->sb_rows, sizeof(*ecpu->sb_row_done)));
+
+  // The largest GPU block size is 32x32, i.e. 64 4x4 blocks.
+  for (i = 0; i < ecpu->num_workers; ++i)
+    vp9_alloc_mode_context(cm, 64, &ecpu->thread_data[i].ctx);
+}
+
+static void vp9_ecpu_free_buffers(VP9_COMP *cpi) {
+  VP9_EGPU *const egpu = &cpi->egpu;
+  VP9_ECPU *const ecpu = egpu->compute_framework;
+  const VP9WorkerInterface *const winterface = vp9_get_worker_interface();
+  GPU_BLOCK_SIZE gpu_bsize;
+  int i;
+
+  for (i = 0; i < ecpu->num_workers; ++i)
+    winterface->sync(&ecpu->workers[i]);
+
+  vpx_free(egpu->gpu_rd_parameters);
+  egpu->gpu_rd_parameters = NULL;
+  for (gpu_bsize = 0; gpu_bsize < GPU_BLOCK_SIZES; gpu_bsize++) {
+    vpx_free(egpu->gpu_input[gpu_bsize]);
+    egpu->gpu_input[gpu_bsize] = NULL;
+    vpx_free(ecpu->gpu_output[gpu_bsize]);
+    ecpu->gpu_output[gpu_bsize] = NULL;
+    cpi->gpu_output_base[gpu_bsize] = NULL;
+  }
+  vpx_free(ecpu->sb_row_done);
+  ecpu->sb_row_done = NULL;
+  for (i = 0; i < ecpu->num_workers; ++i)
+    vp9_free_mode_context(&ecpu->thread_data[i].ctx);
+}
+
+static void vp9_ecpu_acquire_output_buffer(VP9_COMP *cpi,
+                                           GPU_BLOCK_SIZE gpu_bsize,
+                                           void **host_ptr,
+                                           int sub_frame_idx) {
+  VP9_ECPU *const ecpu = cpi->egpu.compute_framework;
+  SubFrameInfo subframe;
+
+  vp9_subframe_init(&subframe, &cpi->common, sub_frame_idx);
+  *host_ptr = ecpu->gpu_output[gpu_bsize] +
+      get_gpu_buffer_index(cpi, subframe.mi_row_start, 0, gpu_bsize);
+}
+
+static void vp9_ecpu_enc_sync_read(VP9_COMP *cpi, int event_id) {
+  const VP9_COMMON *const cm = &cpi->common;
+  VP9_ECPU *const ecpu = cpi->egpu.compute_framework;
+  SubFrameInfo subframe;
+  int sb_row, sb_row_end;
+
+  assert(event_id < MAX_SUB_FRAMES);
+  vp9_subframe_init(&subframe, cm, event_id);
+  sb_row_end = mi_cols_aligned_to_sb(subframe.mi_row_end) >>
+      MI_BLOCK_SIZE_LOG2;
+#if CONFIG_MULTITHREAD
+  pthread_mutex_lock(&ecpu->mutex);
+  for (sb_row = subframe.mi_row_start >> MI_BLOCK_SIZE_LOG2;
+       sb_row < sb_row_end; ++sb_row) {
+    while (!ecpu->sb_row_done[sb_row])
+      pthread_cond_wait(&ecpu->cond, &ecpu->mutex);
+  }
+  pthread_mutex_unlock(&ecpu->mutex);
+#else
+  // The workers ran to completion when they were launched.
+  for (sb_row = subframe.mi_row_start >> MI_BLOCK_SIZE_LOG2;
+       sb_row < sb_row_end; ++sb_row)
+    assert(ecpu->sb_row_done[sb_row]);
+#endif
+}
+
+static void vp9_ecpu_execute(VP9_COMP *cpi, GPU_BLOCK_SIZE gpu_bsize,
+                             int subframe_idx) {
+  VP9_ECPU *const ecpu = cpi->egpu.compute_framework;
+
+  ecpu->bsize_mask[subframe_idx] |= 1 << gpu_bsize;
+
+  // The workers walk the sub frames in order, so they are started once every
+  // block size of the last sub frame has been enqueued.
+  if (subframe_idx == MAX_SUB_FRAMES - 1 && gpu_bsize == cpi->end_gpu_bsize)
+    ecpu_launch_workers(cpi);
+}
+
+static void vp9_ecpu_prepare_control_buffers(VP9_COMP *cpi) {
+  // Input and output buffers live in host memory, nothing to map.
+  (void)cpi;
+}
+
+static void vp9_ecpu_frame_cache_sync(VP9_COMP *cpi, YV12_BUFFER_CONFIG *yuv) {
+  // Frame buffers are shared with the workers, nothing to flush.
+  (void)cpi;
+  (void)yuv;
+}
+
+static void vp9_ecpu_remove(VP9_COMP *cpi) {
+  VP9_ECPU *const ecpu = cpi->egpu.compute_framework;
+  const VP9WorkerInterface *const winterface = vp9_get_worker_interface();
+  int i;
+
+  if (ecpu == NULL)
+    return;
+
+  for (i = 0; i < ecpu->num_workers && ecpu->workers != NULL; ++i)
+    winterface->end(&ecpu->workers[i]);
+#if CONFIG_MULTITHREAD
+  if (ecpu->sync_initialized) {
+    pthread_mutex_destroy(&ecpu->mutex);
+    pthread_cond_destroy(&ecpu->cond);
+  }
+#endif
+  vpx_free(ecpu->workers);
+  vpx_free(ecpu->thread_data);
+  vpx_free(ecpu);
+  cpi->egpu.compute_framework = NULL;
+}
+
+int vp9_ecpu_init(VP9_COMP *cpi) {
+  VP9_EGPU *egpu = &cpi->egpu;
+  const VP9WorkerInterface *const winterface = vp9_get_worker_interface();
+  VP9_ECPU *ecpu;
+  int i;
+
+  egpu->compute_framework = vpx_calloc(1, sizeof(VP9_ECPU));
+  if (egpu->compute_framework == NULL)
+    return 1;
+
+  egpu->alloc_buffers = vp9_ecpu_alloc_buffers;
+  egpu->free_buffers = vp9_ecpu_free_buffers;
+  egpu->acquire_output_buffer = vp9_ecpu_acquire_output_buffer;
+  egpu->execute = vp9_ecpu_execute;
+  egpu->enc_sync_read = vp9_ecpu_enc_sync_read;
+  egpu->remove = vp9_ecpu_remove;
+  egpu->prepare_control_buffers = vp9_ecpu_prepare_control_buffers;
+  egpu->frame_cache_sync = vp9_ecpu_frame_cache_sync;
+
+  ecpu = egpu->compute_framework;
+
+  // The workers are idle while the encoder threads are coding, and the other
+  // way round while the encoder threads wait for a sub frame, so one worker
+  // per encoder thread keeps all the cores busy.
+  ecpu->num_workers = MAX(cpi->max_threads, 1);
+  ecpu->workers = vpx_calloc(ecpu->num_workers, sizeof(*ecpu->workers));
+  ecpu->thread_data = vpx_memalign(32, ecpu->num_workers *
+                                       sizeof(*ecpu->thread_data));
+  if (ecpu->workers == NULL || ecpu->thread_data == NULL)
+    goto fail;
+  vpx_memset(ecpu->thread_data, 0,
+             ecpu->num_workers * sizeof(*ecpu->thread_data));
+#if CONFIG_MULTITHREAD
+  if (pthread_mutex_init(&ecpu->mutex, NULL))
+    goto fail;
+  if (pthread_cond_init(&ecpu->cond, NULL)) {
+    pthread_mutex_destroy(&ecpu->mutex);
+    goto fail;
+  }
+  ecpu->sync_initialized = 1;
+#endif
+
+  for (i = 0; i < ecpu->num_workers; ++i) {
+    winterface->init(&ecpu->workers[i]);
+    if (!winterface->reset(&ecpu->workers[i]))
+      goto fail;
+  }
+  return 0;
+
+fail:
+  vp9_ecpu_remove(cpi);
+  return 1;
+}
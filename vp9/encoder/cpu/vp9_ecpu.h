@@ -0,0 +1,65 @@
+/*
+ *  Copyright (c) 2014 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef VP9_ENCODER_CPU_VP9_ECPU_H_
+#define VP9_ENCODER_CPU_VP9_ECPU_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "vp9/common/vp9_thread.h"
+
+#include "vp9/encoder/vp9_encoder.h"
+
+// Per worker state of the CPU compute backend.
+typedef struct ECPU_THREAD_DATA {
+  struct VP9_COMP *cpi;
+
+  // worker specific mb context, set up for data parallel processing
+  DECLARE_ALIGNED(16, MACROBLOCK, mb);
+  PICK_MODE_CONTEXT ctx;
+
+  // The analysis overlaps the encoding of the frames, it is not accounted
+  // in the frame statistics.
+  VP9ThreadStats stats;
+
+  int thread_id;
+} ECPU_THREAD_DATA;
+
+typedef struct VP9_ECPU {
+  int num_workers;
+  VP9Worker *workers;
+  ECPU_THREAD_DATA *thread_data;
+
+  GPU_OUTPUT *gpu_output[GPU_BLOCK_SIZES];
+
+  // GPU block sizes requested through execute() for each sub frame, as a bit
+  // mask. 'active_bsize_mask' is the snapshot the workers operate on.
+  int bsize_mask[MAX_SUB_FRAMES];
+  int active_bsize_mask[MAX_SUB_FRAMES];
+
+  // Set once the data parallel analysis of a SB row is complete. The encoder
+  // threads wait on 'cond' for the rows of their sub frame.
+  int *sb_row_done;
+#if CONFIG_MULTITHREAD
+  pthread_mutex_t mutex;
+  pthread_cond_t cond;
+  int sync_initialized;
+#endif
+} VP9_ECPU;
+
+int vp9_ecpu_init(struct VP9_COMP *cpi);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif /* VP9_ENCODER_CPU_VP9_ECPU_H_ */
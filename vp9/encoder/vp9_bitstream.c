@@ -28,12 +28,23 @@
 #include "vp9/encoder/vp9_cost.h"
 #include "vp9/encoder/vp9_bitstream.h"
 #include "vp9/encoder/vp9_encodemv.h"
+#include "vp9/encoder/vp9_frame_stats.h"
 #include "vp9/encoder/vp9_mcomp.h"
 #include "vp9/encoder/vp9_segmentation.h"
 #include "vp9/encoder/vp9_subexp.h"
 #include "vp9/encoder/vp9_tokenize.h"
 #include "vp9/encoder/vp9_write_bit_buffer.h"
 
+// State of the packing of a column of tiles. The tile columns do not depend on
+// each other: each one is packed by a single thread, with its own block
+// context and counters that are added up to the frame's once all are packed.
+typedef struct {
+  MACROBLOCKD *xd;
+  unsigned int inter_mode[INTER_MODE_CONTEXTS][INTER_MODES];
+  unsigned int interp_filter_selected[SWITCHABLE_FILTERS];
+  unsigned int max_mv_magnitude;
+} TILE_PACK_DATA;
+
 static struct vp9_token intra_mode_encodings[INTRA_MODES];
 static struct vp9_token switchable_interp_encodings[SWITCHABLE_FILTERS];
 static struct vp9_token partition_encodings[PARTITION_TYPES];
@@ -222,12 +233,13 @@ static void write_ref_frames(const VP9_COMMON *cm, const MACROBLOCKD *xd,
   }
 }
 
-static void pack_inter_mode_mvs(VP9_COMP *cpi, const MODE_INFO *mi,
-                                vp9_writer *w) {
+static void pack_inter_mode_mvs(VP9_COMP *cpi, TILE_PACK_DATA *tp,
+                                const MODE_INFO *mi, vp9_writer *w) {
   VP9_COMMON *const cm = &cpi->common;
   const nmv_context *nmvc = &cm->fc.nmvc;
-  const MACROBLOCK *const x = &cpi->mb;
-  const MACROBLOCKD *const xd = &x->e_mbd;
+  const MACROBLOCKD *const xd = tp->xd;
+  unsigned int *const max_mv_magnitude =
+      cpi->sf.mv.auto_mv_step_size ? &tp->max_mv_magnitude : NULL;
   const struct segmentation *const seg = &cm->seg;
   const MB_MODE_INFO *const mbmi = &mi->mbmi;
   const PREDICTION_MODE mode = mbmi->mode;
@@ -285,7 +297,7 @@ static void pack_inter_mode_mvs(VP9_COMP *cpi, const MODE_INFO *mi,
     if (!vp9_segfeature_active(seg, segment_id, SEG_LVL_SKIP)) {
       if (bsize >= BLOCK_8X8) {
         write_inter_mode(w, mode, inter_probs);
-        ++cm->counts.inter_mode[mode_ctx][INTER_OFFSET(mode)];
+        ++tp->inter_mode[mode_ctx][INTER_OFFSET(mode)];
       }
     }
 
@@ -294,7 +306,7 @@ static void pack_inter_mode_mvs(VP9_COMP *cpi, const MODE_INFO *mi,
       vp9_write_token(w, vp9_switchable_interp_tree,
                       cm->fc.switchable_interp_prob[ctx],
                       &switchable_interp_encodings[mbmi->interp_filter]);
-      ++cpi->interp_filter_selected[0][mbmi->interp_filter];
+      ++tp->interp_filter_selected[mbmi->interp_filter];
     } else {
       assert(mbmi->interp_filter == cm->interp_filter);
     }
@@ -308,21 +320,21 @@ static void pack_inter_mode_mvs(VP9_COMP *cpi, const MODE_INFO *mi,
           const int j = idy * 2 + idx;
           const PREDICTION_MODE b_mode = mi->bmi[j].as_mode;
           write_inter_mode(w, b_mode, inter_probs);
-          ++cm->counts.inter_mode[mode_ctx][INTER_OFFSET(b_mode)];
+          ++tp->inter_mode[mode_ctx][INTER_OFFSET(b_mode)];
           if (b_mode == NEWMV) {
             for (ref = 0; ref < 1 + is_compound; ++ref)
-              vp9_encode_mv(cpi, w, &mi->bmi[j].as_mv[ref].as_mv,
+              vp9_encode_mv(w, &mi->bmi[j].as_mv[ref].as_mv,
                             &mbmi->ref_mvs[mbmi->ref_frame[ref]][0].as_mv,
-                            nmvc, allow_hp);
+                            nmvc, allow_hp, max_mv_magnitude);
           }
         }
       }
     } else {
       if (mode == NEWMV) {
         for (ref = 0; ref < 1 + is_compound; ++ref)
-          vp9_encode_mv(cpi, w, &mbmi->mv[ref].as_mv,
+          vp9_encode_mv(w, &mbmi->mv[ref].as_mv,
                         &mbmi->ref_mvs[mbmi->ref_frame[ref]][0].as_mv, nmvc,
-                        allow_hp);
+                        allow_hp, max_mv_magnitude);
       }
     }
   }
@@ -364,12 +376,13 @@ static void write_mb_modes_kf(const VP9_COMMON *cm, const MACROBLOCKD *xd,
   write_intra_mode(w, mbmi->uv_mode, vp9_kf_uv_mode_prob[mbmi->mode]);
 }
 
-static void write_modes_b(VP9_COMP *cpi, const TileInfo *const tile,
+static void write_modes_b(VP9_COMP *cpi, TILE_PACK_DATA *tp,
+                          const TileInfo *const tile,
                           vp9_writer *w, TOKENEXTRA **tok,
                           const TOKENEXTRA *const tok_end,
                           int mi_row, int mi_col) {
   const VP9_COMMON *const cm = &cpi->common;
-  MACROBLOCKD *const xd = &cpi->mb.e_mbd;
+  MACROBLOCKD *const xd = tp->xd;
   MODE_INFO *m;
 
   xd->mi = cm->mi_grid_visible + (mi_row * cm->mi_stride + mi_col);
@@ -382,7 +395,7 @@ static void write_modes_b(VP9_COMP *cpi, const TileInfo *const tile,
   if (frame_is_intra_only(cm)) {
     write_mb_modes_kf(cm, xd, xd->mi, w);
   } else {
-    pack_inter_mode_mvs(cpi, m, w);
+    pack_inter_mode_mvs(cpi, tp, m, w);
   }
 
   assert(*tok < tok_end);
@@ -411,12 +424,12 @@ static void write_partition(const VP9_COMMON *const cm,
   }
 }
 
-static void write_modes_sb(VP9_COMP *cpi,
+static void write_modes_sb(VP9_COMP *cpi, TILE_PACK_DATA *tp,
                            const TileInfo *const tile, vp9_writer *w,
                            TOKENEXTRA **tok, const TOKENEXTRA *const tok_end,
                            int mi_row, int mi_col, BLOCK_SIZE bsize) {
   const VP9_COMMON *const cm = &cpi->common;
-  MACROBLOCKD *const xd = &cpi->mb.e_mbd;
+  MACROBLOCKD *const xd = tp->xd;
 
   const int bsl = b_width_log2(bsize);
   const int bs = (1 << bsl) / 4;
@@ -433,30 +446,33 @@ static void write_modes_sb(VP9_COMP *cpi,
   write_partition(cm, xd, bs, mi_row, mi_col, partition, bsize, w);
   subsize = get_subsize(bsize, partition);
   if (subsize < BLOCK_8X8) {
-    write_modes_b(cpi, tile, w, tok, tok_end, mi_row, mi_col);
+    write_modes_b(cpi, tp, tile, w, tok, tok_end, mi_row, mi_col);
   } else {
     switch (partition) {
       case PARTITION_NONE:
-        write_modes_b(cpi, tile, w, tok, tok_end, mi_row, mi_col);
+        write_modes_b(cpi, tp, tile, w, tok, tok_end, mi_row, mi_col);
         break;
       case PARTITION_HORZ:
-        write_modes_b(cpi, tile, w, tok, tok_end, mi_row, mi_col);
+        write_modes_b(cpi, tp, tile, w, tok, tok_end, mi_row, mi_col);
         if (mi_row + bs < cm->mi_rows)
-          write_modes_b(cpi, tile, w, tok, tok_end, mi_row + bs, mi_col);
+          write_modes_b(cpi, tp, tile, w, tok, tok_end, mi_row + bs,
+                        mi_col);
         break;
       case PARTITION_VERT:
-        write_modes_b(cpi, tile, w, tok, tok_end, mi_row, mi_col);
+        write_modes_b(cpi, tp, tile, w, tok, tok_end, mi_row, mi_col);
         if (mi_col + bs < cm->mi_cols)
-          write_modes_b(cpi, tile, w, tok, tok_end, mi_row, mi_col + bs);
+          write_modes_b(cpi, tp, tile, w, tok, tok_end, mi_row,
+                        mi_col + bs);
         break;
       case PARTITION_SPLIT:
-        write_modes_sb(cpi, tile, w, tok, tok_end, mi_row, mi_col, subsize);
-        write_modes_sb(cpi, tile, w, tok, tok_end, mi_row, mi_col + bs,
+        write_modes_sb(cpi, tp, tile, w, tok, tok_end, mi_row, mi_col,
                        subsize);
-        write_modes_sb(cpi, tile, w, tok, tok_end, mi_row + bs, mi_col,
+        write_modes_sb(cpi, tp, tile, w, tok, tok_end, mi_row, mi_col + bs,
                        subsize);
-        write_modes_sb(cpi, tile, w, tok, tok_end, mi_row + bs, mi_col + bs,
+        write_modes_sb(cpi, tp, tile, w, tok, tok_end, mi_row + bs, mi_col,
                        subsize);
+        write_modes_sb(cpi, tp, tile, w, tok, tok_end, mi_row + bs,
+                       mi_col + bs, subsize);
         break;
       default:
         assert(0);
@@ -469,15 +485,16 @@ static void write_modes_sb(VP9_COMP *cpi,
     update_partition_context(xd, mi_row, mi_col, subsize, bsize);
 }
 
-static void write_modes(VP9_COMP *cpi, const TileInfo *const tile,
+static void write_modes(VP9_COMP *cpi, TILE_PACK_DATA *tp,
+                        const TileInfo *const tile,
                         vp9_writer *w, TOKENEXTRA **tok,
                         const TOKENEXTRA *const tok_end, int mi_row) {
   int mi_col;
 
-  vp9_zero(cpi->mb.e_mbd.left_seg_context);
+  vp9_zero(tp->xd->left_seg_context);
   for (mi_col = tile->mi_col_start; mi_col < tile->mi_col_end;
        mi_col += MI_BLOCK_SIZE)
-    write_modes_sb(cpi, tile, w, tok, tok_end, mi_row, mi_col,
+    write_modes_sb(cpi, tp, tile, w, tok, tok_end, mi_row, mi_col,
                    BLOCK_64X64);
 }
 
@@ -910,50 +927,222 @@ static int get_refresh_mask(VP9_COMP *cpi) {
   }
 }
 
-static size_t encode_tiles(VP9_COMP *cpi, uint8_t *data_ptr) {
+// Pack tile ('tile_row', 'tile_col') in the 'buf_size' bytes of 'buf',
+// returning its size, or 0 if it does not fit.
+static unsigned int pack_tile(VP9_COMP *cpi, TILE_PACK_DATA *tp,
+                              int tile_row, int tile_col, uint8_t *buf,
+                              unsigned int buf_size) {
   VP9_COMMON *const cm = &cpi->common;
   vp9_writer residual_bc;
+  TileInfo tile;
+  int mi_row;
 
-  int tile_row, tile_col;
-  size_t total_size = 0;
+  vp9_tile_init(&tile, cm, tile_row, tile_col);
+  vp9_start_encode_size(&residual_bc, buf, buf_size);
+
+  for (mi_row = tile.mi_row_start; mi_row < tile.mi_row_end;
+       mi_row += MI_BLOCK_SIZE) {
+    TOKENEXTRA *tok_start, *tok_end;
+    const int sb_row = mi_row >> MI_BLOCK_SIZE_LOG2;
+
+    tok_start = cpi->tplist[sb_row][tile_row][tile_col].start;
+    tok_end = cpi->tplist[sb_row][tile_row][tile_col].stop;
+    write_modes(cpi, tp, &tile, &residual_bc, &tok_start, tok_end, mi_row);
+  }
+  vp9_stop_encode(&residual_bc);
+
+  return residual_bc.error ? 0 : residual_bc.pos;
+}
+
+static void add_up_tile_pack_data(VP9_COMP *cpi, const TILE_PACK_DATA *tp) {
+  VP9_COMMON *const cm = &cpi->common;
+
+  ADD_UP_2D_ARRAYS(cm->counts.inter_mode, tp->inter_mode, INTER_MODE_CONTEXTS,
+                   INTER_MODES);
+  ADD_UP_1D_ARRAYS(cpi->interp_filter_selected[0], tp->interp_filter_selected,
+                   SWITCHABLE_FILTERS);
+  cpi->max_mv_magnitude = MAX(cpi->max_mv_magnitude, tp->max_mv_magnitude);
+}
+
+// Tiles of a frame packed by the encoding threads.
+typedef struct {
+  TILE_PACK_DATA tp[1 << 6];
+  uint8_t *buf[4][1 << 6];
+  unsigned int buf_size[4][1 << 6];
+  unsigned int size[4][1 << 6];
+} TILE_PACK_JOBS;
+
+// Multi-threaded hook of the packing. Each thread takes the next tile column
+// from the queue of the row synchronization and packs its tiles from top to
+// bottom, the tiles of a column share the above partition context.
+static int pack_tiles_thread_process(thread_context *const thread_ctxt,
+                                     TILE_PACK_JOBS *jobs) {
+  VP9_COMP *const cpi = thread_ctxt->cpi;
+  const int tile_cols = 1 << cpi->common.log2_tile_cols;
+  const int tile_rows = 1 << cpi->common.log2_tile_rows;
+  MACROBLOCK *const x = &thread_ctxt->mb;
+  struct vpx_usec_timer timer;
+  int tile_col;
+
+  vp9_stats_timer_start(&thread_ctxt->stats, &timer);
+  vp9_mb_copy(cpi, x, &cpi->mb);
+
+  while ((tile_col = vp9_row_sync_next_row(&cpi->row_sync)) < tile_cols) {
+    TILE_PACK_DATA *const tp = &jobs->tp[tile_col];
+    int tile_row;
+
+    tp->xd = &x->e_mbd;
+    for (tile_row = 0; tile_row < tile_rows; ++tile_row)
+      jobs->size[tile_row][tile_col] =
+          pack_tile(cpi, tp, tile_row, tile_col,
+                    jobs->buf[tile_row][tile_col],
+                    jobs->buf_size[tile_row][tile_col]);
+  }
+
+  vp9_stats_timer_mark(&thread_ctxt->stats, &timer,
+                       &thread_ctxt->stats.pass_us);
+  return 1;
+}
+
+// Pack the tiles on the encoding threads. The first tile is packed in place,
+// the others in their own part of the scratch buffer, sized after the area of
+// the tile, from where they are moved once behind their size. Returns 0 if a
+// tile does not fit in its part, leaving the frame's counters untouched.
+static size_t encode_tiles_mt(VP9_COMP *cpi, uint8_t *data_ptr) {
+  VP9_COMMON *const cm = &cpi->common;
+  const VP9WorkerInterface *const winterface = vp9_get_worker_interface();
   const int tile_cols = 1 << cm->log2_tile_cols;
   const int tile_rows = 1 << cm->log2_tile_rows;
+  const int64_t frame_area = (int64_t)cm->mi_rows * cm->mi_cols;
+  TILE_PACK_JOBS jobs;
+  struct vpx_usec_timer timer;
+  size_t total_size = 0;
+  int64_t area = 0;
+  int tile_row, tile_col, thread_id;
 
-  vpx_memset(cm->above_seg_context, 0, sizeof(*cm->above_seg_context) *
-             mi_cols_aligned_to_sb(cm->mi_cols));
+  vp9_stats_timer_start(&cpi->thread_stats, &timer);
 
-  for (tile_row = 0; tile_row < tile_rows; tile_row++) {
-    for (tile_col = 0; tile_col < tile_cols; tile_col++) {
+  for (tile_row = 0; tile_row < tile_rows; ++tile_row) {
+    for (tile_col = 0; tile_col < tile_cols; ++tile_col) {
+      const size_t start = cpi->tile_pack_buf_size * area / frame_area;
       TileInfo tile;
-      int mi_row;
 
       vp9_tile_init(&tile, cm, tile_row, tile_col);
+      area += (int64_t)(tile.mi_row_end - tile.mi_row_start) *
+              (tile.mi_col_end - tile.mi_col_start);
+      jobs.buf[tile_row][tile_col] = cpi->tile_pack_buf + start;
+      jobs.buf_size[tile_row][tile_col] =
+          (unsigned int)(cpi->tile_pack_buf_size * area / frame_area - start);
+    }
+  }
+  jobs.buf[0][0] = data_ptr + 4;
+  jobs.buf_size[0][0] = UINT_MAX;
+  vpx_memset(jobs.tp, 0, sizeof(jobs.tp[0]) * tile_cols);
+
+  vp9_row_sync_reset(&cpi->row_sync);
+
+  for (thread_id = 0; thread_id < cpi->max_threads; ++thread_id) {
+    VP9Worker *const worker = &cpi->enc_thread_hndl[thread_id];
+    thread_context *const thread_ctxt = (thread_context *)worker->data1;
+
+    worker->hook = (VP9WorkerHook)pack_tiles_thread_process;
+    worker->data2 = &jobs;
+    thread_ctxt->cpi = cpi;
+    thread_ctxt->thread_id = thread_id;
+
+    if (thread_id == cpi->max_threads - 1)
+      winterface->execute(worker);
+    else
+      winterface->launch(worker);
+  }
+
+  for (thread_id = 0; thread_id < cpi->max_threads; ++thread_id) {
+    winterface->sync(&cpi->enc_thread_hndl[thread_id]);
+    cpi->enc_thread_hndl[thread_id].data2 = NULL;
+  }
 
-      if (tile_col < tile_cols - 1 || tile_row < tile_rows - 1)
-        vp9_start_encode(&residual_bc, data_ptr + total_size + 4);
-      else
-        vp9_start_encode(&residual_bc, data_ptr + total_size);
+  for (tile_row = 0; tile_row < tile_rows; ++tile_row) {
+    for (tile_col = 0; tile_col < tile_cols; ++tile_col) {
+      if (jobs.size[tile_row][tile_col] == 0)
+        return 0;
+    }
+  }
 
-      for (mi_row = tile.mi_row_start; mi_row < tile.mi_row_end;
-          mi_row += MI_BLOCK_SIZE) {
-        TOKENEXTRA *tok_start, *tok_end;
-        const int sb_row = mi_row >> MI_BLOCK_SIZE_LOG2;
+  for (tile_col = 0; tile_col < tile_cols; ++tile_col)
+    add_up_tile_pack_data(cpi, &jobs.tp[tile_col]);
 
-        tok_start = cpi->tplist[sb_row][tile_row][tile_col].start;
-        tok_end = cpi->tplist[sb_row][tile_row][tile_col].stop;
-        write_modes(cpi, &tile, &residual_bc, &tok_start, tok_end, mi_row);
+  // Join the tiles in the bitstream order. The offset of a tile depends on
+  // the sizes of the ones before it, so they are packed apart and copied.
+  for (tile_row = 0; tile_row < tile_rows; ++tile_row) {
+    for (tile_col = 0; tile_col < tile_cols; ++tile_col) {
+      const unsigned int size = jobs.size[tile_row][tile_col];
+
+      if (tile_col < tile_cols - 1 || tile_row < tile_rows - 1) {
+        // size of this tile
+        mem_put_be32(data_ptr + total_size, size);
+        total_size += 4;
       }
-      vp9_stop_encode(&residual_bc);
+      if (tile_row || tile_col)
+        vpx_memcpy(data_ptr + total_size, jobs.buf[tile_row][tile_col], size);
+
+      total_size += size;
+    }
+  }
+
+  if (cpi->thread_stats.enabled) {
+    vpx_usec_timer_mark(&timer);
+    vp9_frame_stats_end_pass(cpi, VP9E_STAGE_PACK,
+                             vpx_usec_timer_elapsed(&timer));
+  }
+
+  return total_size;
+}
+
+static size_t encode_tiles(VP9_COMP *cpi, uint8_t *data_ptr) {
+  VP9_COMMON *const cm = &cpi->common;
+  TILE_PACK_DATA tp;
+
+  int tile_row, tile_col;
+  size_t total_size = 0;
+  const int tile_cols = 1 << cm->log2_tile_cols;
+  const int tile_rows = 1 << cm->log2_tile_rows;
+
+  vpx_memset(cm->above_seg_context, 0, sizeof(*cm->above_seg_context) *
+             mi_cols_aligned_to_sb(cm->mi_cols));
+
+  if (cpi->max_threads > 1 && tile_cols > 1) {
+    total_size = encode_tiles_mt(cpi, data_ptr);
+    if (total_size > 0)
+      return total_size;
+    // A tile outgrew its part of the scratch buffer: pack them all in place.
+    vpx_memset(cm->above_seg_context, 0, sizeof(*cm->above_seg_context) *
+               mi_cols_aligned_to_sb(cm->mi_cols));
+  }
+
+  vp9_zero(tp);
+  tp.xd = &cpi->mb.e_mbd;
+
+  for (tile_row = 0; tile_row < tile_rows; tile_row++) {
+    for (tile_col = 0; tile_col < tile_cols; tile_col++) {
+      unsigned int size;
+
       if (tile_col < tile_cols - 1 || tile_row < tile_rows - 1) {
+        size = pack_tile(cpi, &tp, tile_row, tile_col,
+                         data_ptr + total_size + 4, UINT_MAX);
         // size of this tile
-        mem_put_be32(data_ptr + total_size, residual_bc.pos);
+        mem_put_be32(data_ptr + total_size, size);
         total_size += 4;
+      } else {
+        size = pack_tile(cpi, &tp, tile_row, tile_col, data_ptr + total_size,
+                         UINT_MAX);
       }
 
-      total_size += residual_bc.pos;
+      total_size += size;
     }
   }
 
+  add_up_tile_pack_data(cpi, &tp);
+
   return total_size;
 }
 
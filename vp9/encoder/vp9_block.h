@@ -18,6 +18,7 @@
 
 #include "vp9/encoder/vp9_rd.h"
 #include "vp9/encoder/vp9_egpu.h"
+#include "vp9/encoder/vp9_frame_stats.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -117,6 +118,9 @@ struct macroblock {
   // Thread id
   int thread_id;
 
+  // Statistics of the thread running the block.
+  VP9ThreadStats *stats;
+
   // Entropy/rd stats for a set of rows encoded by an encoder thread are stored
   // here. After encoding the complete frame, stats across all threads are
   // combined for updating the probability tables and rd thresholds. In single
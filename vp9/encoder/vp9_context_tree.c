@@ -18,8 +18,8 @@ static const BLOCK_SIZE square[] = {
   BLOCK_64X64,
 };
 
-static void alloc_mode_context(VP9_COMMON *cm, int num_4x4_blk,
-                               PICK_MODE_CONTEXT *ctx) {
+void vp9_alloc_mode_context(VP9_COMMON *cm, int num_4x4_blk,
+                            PICK_MODE_CONTEXT *ctx) {
   const int num_blk = (num_4x4_blk < 4 ? 4 : num_4x4_blk);
   const int num_pix = num_blk << 4;
   int i, k;
@@ -45,7 +45,7 @@ static void alloc_mode_context(VP9_COMMON *cm, int num_4x4_blk,
   }
 }
 
-static void free_mode_context(PICK_MODE_CONTEXT *ctx) {
+void vp9_free_mode_context(PICK_MODE_CONTEXT *ctx) {
   int i, k;
   vpx_free(ctx->zcoeff_blk);
   ctx->zcoeff_blk = 0;
@@ -65,22 +65,22 @@ static void free_mode_context(PICK_MODE_CONTEXT *ctx) {
 
 static void alloc_tree_contexts(VP9_COMMON *cm, PC_TREE *tree,
                                 int num_4x4_blk) {
-  alloc_mode_context(cm, num_4x4_blk, &tree->none);
-  alloc_mode_context(cm, num_4x4_blk/2, &tree->horizontal[0]);
-  alloc_mode_context(cm, num_4x4_blk/2, &tree->vertical[0]);
+  vp9_alloc_mode_context(cm, num_4x4_blk, &tree->none);
+  vp9_alloc_mode_context(cm, num_4x4_blk/2, &tree->horizontal[0]);
+  vp9_alloc_mode_context(cm, num_4x4_blk/2, &tree->vertical[0]);
 
   /* TODO(Jbb): for 4x8 and 8x4 these allocated values are not used.
    * Figure out a better way to do this. */
-  alloc_mode_context(cm, num_4x4_blk/2, &tree->horizontal[1]);
-  alloc_mode_context(cm, num_4x4_blk/2, &tree->vertical[1]);
+  vp9_alloc_mode_context(cm, num_4x4_blk/2, &tree->horizontal[1]);
+  vp9_alloc_mode_context(cm, num_4x4_blk/2, &tree->vertical[1]);
 }
 
 static void free_tree_contexts(PC_TREE *tree) {
-  free_mode_context(&tree->none);
-  free_mode_context(&tree->horizontal[0]);
-  free_mode_context(&tree->horizontal[1]);
-  free_mode_context(&tree->vertical[0]);
-  free_mode_context(&tree->vertical[1]);
+  vp9_free_mode_context(&tree->none);
+  vp9_free_mode_context(&tree->horizontal[0]);
+  vp9_free_mode_context(&tree->horizontal[1]);
+  vp9_free_mode_context(&tree->vertical[0]);
+  vp9_free_mode_context(&tree->vertical[1]);
 }
 
 // This function sets up a tree of contexts such that at each square
@@ -114,7 +114,7 @@ void vp9_setup_pc_tree(VP9_COMMON *cm, VP9_COMP *cpi) {
   // 4x4 blocks smaller than 8x8 but in the same 8x8 block share the same
   // context so we only need to allocate 1 for each 8x8 block.
   for (i = 0; i < num_threads * leaf_nodes; ++i)
-    alloc_mode_context(cm, 1, &cpi->leaf_tree[i]);
+    vp9_alloc_mode_context(cm, 1, &cpi->leaf_tree[i]);
 
   for (thread_id = 0; thread_id < num_threads; ++thread_id) {
     int offset = pc_tree_index;
@@ -157,7 +157,7 @@ void vp9_free_pc_tree(VP9_COMP *cpi) {
 
   // Set up all 4x4 mode contexts
   for (i = 0; i < num_threads * leaf_nodes && cpi->leaf_tree != NULL; ++i)
-    free_mode_context(&cpi->leaf_tree[i]);
+    vp9_free_mode_context(&cpi->leaf_tree[i]);
 
   // Sets up all the leaf nodes in the tree.
   for (i = 0; i < num_threads * tree_nodes && cpi->pc_tree != NULL; ++i)
@@ -72,6 +72,12 @@ typedef struct PC_TREE {
   };
 } PC_TREE;
 
+// Allocate the coefficient buffers of a context for blocks of up to
+// 'num_4x4_blk' 4x4 blocks.
+void vp9_alloc_mode_context(struct VP9Common *cm, int num_4x4_blk,
+                            PICK_MODE_CONTEXT *ctx);
+void vp9_free_mode_context(PICK_MODE_CONTEXT *ctx);
+
 void vp9_setup_pc_tree(struct VP9Common *cm, struct VP9_COMP *cpi);
 void vp9_free_pc_tree(struct VP9_COMP *cpi);
 
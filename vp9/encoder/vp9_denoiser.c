@@ -10,6 +10,7 @@
 
 #include <assert.h>
 #include <limits.h>
+#include "./vp9_rtcd.h"
 #include "vpx_scale/yv12config.h"
 #include "vpx/vpx_integer.h"
 #include "vp9/common/vp9_reconinter.h"
@@ -34,17 +35,6 @@ static void make_grayscale(YV12_BUFFER_CONFIG *yuv);
 static const int widths[]  = {4, 4, 8, 8,  8, 16, 16, 16, 32, 32, 32, 64, 64};
 static const int heights[] = {4, 8, 4, 8, 16,  8, 16, 32, 16, 32, 64, 32, 64};
 
-static int absdiff_thresh(BLOCK_SIZE bs, int increase_denoising) {
-  (void)bs;
-  return 3 + (increase_denoising ? 1 : 0);
-}
-
-static int delta_thresh(BLOCK_SIZE bs, int increase_denoising) {
-  (void)bs;
-  (void)increase_denoising;
-  return 4;
-}
-
 static int noise_motion_thresh(BLOCK_SIZE bs, int increase_denoising) {
   (void)bs;
   (void)increase_denoising;
@@ -65,21 +55,11 @@ static int sse_diff_thresh(BLOCK_SIZE bs, int increase_denoising,
   }
 }
 
-static int total_adj_strong_thresh(BLOCK_SIZE bs, int increase_denoising) {
-  return widths[bs] * heights[bs] * (increase_denoising ? 3 : 2);
-}
-
-static int total_adj_weak_thresh(BLOCK_SIZE bs, int increase_denoising) {
-  return widths[bs] * heights[bs] * (increase_denoising ? 3 : 2);
-}
-
-static VP9_DENOISER_DECISION denoiser_filter(const uint8_t *sig, int sig_stride,
-                                             const uint8_t *mc_avg,
-                                             int mc_avg_stride,
-                                             uint8_t *avg, int avg_stride,
-                                             int increase_denoising,
-                                             BLOCK_SIZE bs,
-                                             int motion_magnitude) {
+int vp9_denoiser_filter_c(const uint8_t *sig, int sig_stride,
+                          const uint8_t *mc_avg, int mc_avg_stride,
+                          uint8_t *avg, int avg_stride,
+                          int increase_denoising, BLOCK_SIZE bs,
+                          int motion_magnitude) {
   int r, c;
   const uint8_t *sig_start = sig;
   const uint8_t *mc_avg_start = mc_avg;
@@ -256,6 +236,11 @@ static VP9_DENOISER_DECISION perform_motion_compensation(VP9_DENOISER *denoiser,
     ctx->newmv_sse = ctx->zeromv_sse;
   }
 
+  // Blocks not denoised yet in the INTRA_FRAME buffer are those of the last
+  // denoised frame, which the last refreshed reference took over.
+  if (frame == INTRA_FRAME)
+    frame = denoiser->last_denoised_ref;
+
   // Set the pointers in the MACROBLOCKD to point to the buffers in the denoiser
   // struct.
   for (j = 0; j < 2; ++j) {
@@ -336,10 +321,10 @@ void vp9_denoiser_denoise(VP9_DENOISER *denoiser, MACROBLOCK *mb,
                                          &motion_magnitude);
 
   if (decision == FILTER_BLOCK) {
-    decision = denoiser_filter(src.buf, src.stride,
-                               mc_avg_start, mc_avg.y_stride,
-                               avg_start, avg.y_stride,
-                               0, bs, motion_magnitude);
+    decision = vp9_denoiser_filter(src.buf, src.stride,
+                                   mc_avg_start, mc_avg.y_stride,
+                                   avg_start, avg.y_stride,
+                                   0, bs, motion_magnitude);
   }
 
   if (decision == FILTER_BLOCK) {
@@ -363,6 +348,13 @@ static void copy_frame(YV12_BUFFER_CONFIG dest, const YV12_BUFFER_CONFIG src) {
   }
 }
 
+static void swap_frame_buffer(YV12_BUFFER_CONFIG *dest,
+                              YV12_BUFFER_CONFIG *src) {
+  const YV12_BUFFER_CONFIG tmp = *dest;
+  *dest = *src;
+  *src = tmp;
+}
+
 void vp9_denoiser_update_frame_info(VP9_DENOISER *denoiser,
                                     YV12_BUFFER_CONFIG src,
                                     FRAME_TYPE frame_type,
@@ -375,19 +367,29 @@ void vp9_denoiser_update_frame_info(VP9_DENOISER *denoiser,
     for (i = 1; i < MAX_REF_FRAMES; ++i) {
       copy_frame(denoiser->running_avg_y[i], src);
     }
+    denoiser->last_denoised_ref = INTRA_FRAME;
   } else {  /* For non key frames */
-    if (refresh_alt_ref_frame) {
-      copy_frame(denoiser->running_avg_y[ALTREF_FRAME],
-                 denoiser->running_avg_y[INTRA_FRAME]);
-    }
-    if (refresh_golden_frame) {
-      copy_frame(denoiser->running_avg_y[GOLDEN_FRAME],
-                 denoiser->running_avg_y[INTRA_FRAME]);
-    }
-    if (refresh_last_frame) {
-      copy_frame(denoiser->running_avg_y[LAST_FRAME],
-                 denoiser->running_avg_y[INTRA_FRAME]);
+    const int refresh[MAX_REF_FRAMES] = {
+      0, refresh_last_frame, refresh_golden_frame, refresh_alt_ref_frame
+    };
+    MV_REFERENCE_FRAME last_refreshed = INTRA_FRAME;
+    int i;
+
+    // The denoised frame is copied to all but the last refreshed reference,
+    // which takes over its buffer. The next frame writes all its blocks to
+    // the INTRA_FRAME buffer, whatever they held.
+    for (i = LAST_FRAME; i < MAX_REF_FRAMES; ++i) {
+      if (!refresh[i])
+        continue;
+      if (last_refreshed != INTRA_FRAME)
+        copy_frame(denoiser->running_avg_y[last_refreshed],
+                   denoiser->running_avg_y[INTRA_FRAME]);
+      last_refreshed = i;
     }
+    if (last_refreshed != INTRA_FRAME)
+      swap_frame_buffer(&denoiser->running_avg_y[last_refreshed],
+                        &denoiser->running_avg_y[INTRA_FRAME]);
+    denoiser->last_denoised_ref = last_refreshed;
   }
 }
 
@@ -452,6 +454,7 @@ int vp9_denoiser_alloc(VP9_DENOISER *denoiser, int width, int height,
   make_grayscale(&denoiser->running_avg_y[i]);
 #endif
   denoiser->increase_denoising = 0;
+  denoiser->last_denoised_ref = INTRA_FRAME;
 
   return 0;
 }
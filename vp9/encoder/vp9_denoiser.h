@@ -11,6 +11,7 @@
 #ifndef VP9_ENCODER_DENOISER_H_
 #define VP9_ENCODER_DENOISER_H_
 
+#include "vp9/common/vp9_common_data.h"
 #include "vp9/encoder/vp9_block.h"
 #include "vpx_scale/yv12config.h"
 
@@ -29,8 +30,33 @@ typedef struct vp9_denoiser {
   YV12_BUFFER_CONFIG running_avg_y[MAX_REF_FRAMES];
   YV12_BUFFER_CONFIG mc_running_avg_y;
   int increase_denoising;
+  // Reference whose buffer holds the last denoised frame, INTRA_FRAME when
+  // no reference took it over.
+  MV_REFERENCE_FRAME last_denoised_ref;
 } VP9_DENOISER;
 
+// Thresholds of the filter, shared with its SIMD versions.
+static INLINE int absdiff_thresh(BLOCK_SIZE bs, int increase_denoising) {
+  (void)bs;
+  return 3 + (increase_denoising ? 1 : 0);
+}
+
+static INLINE int delta_thresh(BLOCK_SIZE bs, int increase_denoising) {
+  (void)bs;
+  (void)increase_denoising;
+  return 4;
+}
+
+static INLINE int total_adj_strong_thresh(BLOCK_SIZE bs,
+                                          int increase_denoising) {
+  return (1 << num_pels_log2_lookup[bs]) * (increase_denoising ? 3 : 2);
+}
+
+static INLINE int total_adj_weak_thresh(BLOCK_SIZE bs,
+                                        int increase_denoising) {
+  return (1 << num_pels_log2_lookup[bs]) * (increase_denoising ? 3 : 2);
+}
+
 void vp9_denoiser_update_frame_info(VP9_DENOISER *denoiser,
                                     YV12_BUFFER_CONFIG src,
                                     FRAME_TYPE frame_type,
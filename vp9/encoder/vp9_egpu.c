@@ -23,6 +23,9 @@
 #if CONFIG_OPENCL
 #include "vp9/encoder/opencl/vp9_eopencl.h"
 #endif
+#if CONFIG_CPU_COMPUTE
+#include "vp9/encoder/cpu/vp9_ecpu.h"
+#endif
 
 const BLOCK_SIZE vp9_actual_block_size_lookup[GPU_BLOCK_SIZES] = {
     BLOCK_32X32,
@@ -171,7 +174,13 @@ void vp9_free_gpu_interface_buffers(VP9_COMP *cpi) {
 
 int vp9_egpu_init(VP9_COMP *cpi) {
 #if CONFIG_OPENCL
-  return vp9_eopencl_init(cpi);
+  // vp9_gpu_init() leaves the compute framework unset when it had to fall
+  // back to host memory, in which case the OpenCL kernels can't be used.
+  if (cpi->common.gpu.compute_framework != NULL)
+    return vp9_eopencl_init(cpi);
+#endif
+#if CONFIG_CPU_COMPUTE
+  return vp9_ecpu_init(cpi);
 #else
   return 1;
 #endif
@@ -37,6 +37,10 @@
 #include "vp9/encoder/vp9_encodemb.h"
 #include "vp9/encoder/vp9_encodemv.h"
 #include "vp9/encoder/vp9_extend.h"
+#include "vp9/encoder/vp9_frame_stats.h"
+#if CONFIG_MULTI_RES_ENCODING
+#include "vp9/encoder/vp9_multi_res.h"
+#endif
 #include "vp9/encoder/vp9_pickmode.h"
 #include "vp9/encoder/vp9_rd.h"
 #include "vp9/encoder/vp9_rdopt.h"
@@ -720,6 +724,7 @@ static void rd_pick_sb_modes(VP9_COMP *cpi, MACROBLOCK *const x,
   const AQ_MODE aq_mode = cpi->oxcf.aq_mode;
   int i, orig_rdmult;
   double rdmult_ratio;
+  struct vpx_usec_timer timer;
 
   vp9_clear_system_state();
   rdmult_ratio = 1.0;  // avoid uninitialized warnings
@@ -796,6 +801,7 @@ static void rd_pick_sb_modes(VP9_COMP *cpi, MACROBLOCK *const x,
 
   // Find best coding mode & reconstruct the MB so it is available
   // as a predictor for MBs that follow in the SB
+  vp9_stats_timer_start(x->stats, &timer);
   if (frame_is_intra_only(cm)) {
     vp9_rd_pick_intra_mode_sb(cpi, x, totalrate, totaldist, bsize, ctx,
                               best_rd);
@@ -812,6 +818,8 @@ static void rd_pick_sb_modes(VP9_COMP *cpi, MACROBLOCK *const x,
                                     totaldist, bsize, ctx, best_rd);
     }
   }
+  vp9_stats_timer_mark(x->stats, &timer,
+                       &x->stats->stage_us[VP9E_STAGE_MODE_DECISION]);
 
   x->rdmult = orig_rdmult;
 
@@ -1933,6 +1941,27 @@ static void auto_partition_range(VP9_COMP *cpi, MACROBLOCK *const x,
   *max_block_size = max_size;
 }
 
+#if CONFIG_MULTI_RES_ENCODING
+// Narrow the partition search range down to the sizes the lower resolution
+// used at this location. The range is kept when they do not overlap.
+static void mr_partition_range(const VP9_COMP *cpi, int mi_row, int mi_col,
+                               BLOCK_SIZE *min_block_size,
+                               BLOCK_SIZE *max_block_size) {
+  BLOCK_SIZE mr_min, mr_max;
+
+  if (vp9_mr_get_partition_range(cpi, mi_row, mi_col, &mr_min, &mr_max)) {
+    const BLOCK_SIZE min_size = MAX(*min_block_size,
+                                    min_partition_size[mr_min]);
+    const BLOCK_SIZE max_size = MIN(*max_block_size,
+                                    max_partition_size[mr_max]);
+    if (min_size <= max_size) {
+      *min_block_size = min_size;
+      *max_block_size = max_size;
+    }
+  }
+}
+#endif
+
 // TODO(jingning) refactor functions setting partition search range
 static void set_partition_range(VP9_COMMON *cm, MACROBLOCKD *xd,
                                 int mi_row, int mi_col, BLOCK_SIZE bsize,
@@ -2492,7 +2521,18 @@ static void encode_rd_sb_row(VP9_COMP *cpi, MACROBLOCK *const x,
       const int sb_row = mi_row >> MI_BLOCK_SIZE_LOG2;
       const int sb_col = mi_col >> MI_BLOCK_SIZE_LOG2;
 
-      vp9_enc_sync_read(cpi, sb_row, sb_col);
+      struct vpx_usec_timer timer;
+
+      vp9_stats_timer_start(x->stats, &timer);
+      vp9_row_sync_read(&cpi->row_sync, sb_row, sb_col);
+      vp9_stats_timer_mark(x->stats, &timer, &x->stats->wait_us);
+
+      // Any thread may encode the row, so the adaptive rd thresholds are
+      // carried from row to row rather than kept per thread.
+      if (sb_col == 0)
+        vpx_memcpy(x->rd.thresh_freq_fact,
+                   cpi->sb_row_thresh_freq_fact[sb_row],
+                   sizeof(x->rd.thresh_freq_fact));
     }
 
     if (sf->adaptive_pred_interp_filter) {
@@ -2570,6 +2610,10 @@ static void encode_rd_sb_row(VP9_COMP *cpi, MACROBLOCK *const x,
             rd_auto_partition_range(cpi, xd, tile, mi_row, mi_col,
                                     &x->min_partition_size,
                                     &x->max_partition_size);
+#if CONFIG_MULTI_RES_ENCODING
+            mr_partition_range(cpi, mi_row, mi_col, &x->min_partition_size,
+                               &x->max_partition_size);
+#endif
           }
           rd_pick_partition(cpi, x, tile, tp, mi_row, mi_col, BLOCK_64X64,
                             &dummy_rate, &dummy_dist, INT64_MAX,
@@ -2593,6 +2637,10 @@ static void encode_rd_sb_row(VP9_COMP *cpi, MACROBLOCK *const x,
         rd_auto_partition_range(cpi, xd, tile, mi_row, mi_col,
                                 &x->min_partition_size,
                                 &x->max_partition_size);
+#if CONFIG_MULTI_RES_ENCODING
+        mr_partition_range(cpi, mi_row, mi_col, &x->min_partition_size,
+                           &x->max_partition_size);
+#endif
       }
       rd_pick_partition(cpi, x, tile, tp, mi_row, mi_col, BLOCK_64X64,
                         &dummy_rate, &dummy_dist, INT64_MAX,
@@ -2600,10 +2648,22 @@ static void encode_rd_sb_row(VP9_COMP *cpi, MACROBLOCK *const x,
     }
 
     // In multi-threading, after encoding the SB, make sure this is updated
-    // in the cur_sb_col count
+    // in the row progress
     if (cpi->max_threads > 1) {
       const int sb_row = mi_row >> MI_BLOCK_SIZE_LOG2;
-      vp9_enc_sync_write(cpi, sb_row);
+      const int sb_col = mi_col >> MI_BLOCK_SIZE_LOG2;
+
+      // The row below starts from the thresholds after the first SB of this
+      // row, which are saved before the row below can pass its first SB. The
+      // thresholds at the end of the frame carry on to the next frame.
+      if (sb_col == 0 && sb_row + 1 < cm->sb_rows)
+        vpx_memcpy(cpi->sb_row_thresh_freq_fact[sb_row + 1],
+                   x->rd.thresh_freq_fact, sizeof(x->rd.thresh_freq_fact));
+      else if (sb_col == cm->sb_cols - 1 && sb_row + 1 == cm->sb_rows)
+        vpx_memcpy(cpi->sb_row_thresh_freq_fact[0],
+                   x->rd.thresh_freq_fact, sizeof(x->rd.thresh_freq_fact));
+
+      vp9_row_sync_write(&cpi->row_sync, sb_row, sb_col, cm->sb_cols);
     }
   }
 }
@@ -2683,6 +2743,7 @@ static void nonrd_pick_sb_modes(VP9_COMP *cpi, MACROBLOCK *const x,
   VP9_COMMON *const cm = &cpi->common;
   MACROBLOCKD *const xd = &x->e_mbd;
   MB_MODE_INFO *mbmi;
+  struct vpx_usec_timer timer;
   set_offsets(cpi, x, tile, mi_row, mi_col, bsize);
   mbmi = &xd->mi[0]->mbmi;
   mbmi->sb_type = bsize;
@@ -2691,10 +2752,13 @@ static void nonrd_pick_sb_modes(VP9_COMP *cpi, MACROBLOCK *const x,
     if (mbmi->segment_id && x->in_static_area)
       x->rdmult = vp9_cyclic_refresh_get_rdmult(cpi->cyclic_refresh);
 
+  vp9_stats_timer_start(x->stats, &timer);
   if (vp9_segfeature_active(&cm->seg, mbmi->segment_id, SEG_LVL_SKIP))
     set_mode_info_seg_skip(x, cm->tx_mode, rate, dist, bsize);
   else
     vp9_pick_inter_mode(cpi, x, tile, mi_row, mi_col, rate, dist, bsize, ctx);
+  vp9_stats_timer_mark(x->stats, &timer,
+                       &x->stats->stage_us[VP9E_STAGE_MODE_DECISION]);
 
   duplicate_mode_info_in_sb(cm, xd, mi_row, mi_col, bsize);
 }
@@ -3186,6 +3250,25 @@ static void nonrd_use_partition(VP9_COMP *cpi, MACROBLOCK *const x,
 }
 
 
+void vp9_pick_inter_mode_data_parallel(VP9_COMP *cpi, MACROBLOCK *const x,
+                                       const TileInfo *const tile,
+                                       int mi_row, int mi_col,
+                                       BLOCK_SIZE bsize,
+                                       PICK_MODE_CONTEXT *ctx) {
+  MACROBLOCKD *const xd = &x->e_mbd;
+  int rate;
+  int64_t dist;
+
+  assert(x->data_parallel_processing && x->use_gpu);
+  x->in_static_area = 0;
+  x->source_variance = UINT_MAX;
+  vp9_zero(x->pred_mv);
+  xd->up_available = (mi_row != 0);
+  xd->left_available = (mi_col > tile->mi_col_start);
+
+  nonrd_pick_sb_modes(cpi, x, tile, mi_row, mi_col, &rate, &dist, bsize, ctx);
+}
+
 // In this function, a non-recursive, data-parallel execution of
 // nonrd_pick_partition in GPU is emulated.
 // Performs pick partition only the required Block sizes, non-recursively
@@ -3348,8 +3431,11 @@ static void encode_nonrd_sb_row(VP9_COMP *cpi, MACROBLOCK *const x,
         !x->data_parallel_processing) {
       const int sb_row = mi_row >> MI_BLOCK_SIZE_LOG2;
       const int sb_col = mi_col >> MI_BLOCK_SIZE_LOG2;
+      struct vpx_usec_timer timer;
 
-      vp9_enc_sync_read(cpi, sb_row, sb_col);
+      vp9_stats_timer_start(x->stats, &timer);
+      vp9_row_sync_read(&cpi->row_sync, sb_row, sb_col);
+      vp9_stats_timer_mark(x->stats, &timer, &x->stats->wait_us);
     }
 
     x->in_static_area = 0;
@@ -3406,6 +3492,10 @@ static void encode_nonrd_sb_row(VP9_COMP *cpi, MACROBLOCK *const x,
             auto_partition_range(cpi, x, tile, mi_row, mi_col,
                                  &x->min_partition_size,
                                  &x->max_partition_size);
+#if CONFIG_MULTI_RES_ENCODING
+            mr_partition_range(cpi, mi_row, mi_col, &x->min_partition_size,
+                               &x->max_partition_size);
+#endif
             nonrd_pick_partition(cpi, x, tile, tp, mi_row, mi_col, BLOCK_64X64,
                                  &dummy_rate, &dummy_dist, do_recon, INT64_MAX,
                                  cpi->pc_root[thread_id]);
@@ -3430,6 +3520,9 @@ static void encode_nonrd_sb_row(VP9_COMP *cpi, MACROBLOCK *const x,
         mi_row >= MI_BLOCK_SIZE &&
         mi_col >= MI_BLOCK_SIZE &&
         cpi->sf.lpf_pick >= LPF_PICK_FROM_Q) {
+      struct vpx_usec_timer timer;
+
+      vp9_stats_timer_start(x->stats, &timer);
       // Do a loopfilter of the top-left SB
       vp9_loop_filter_sb(cm->frame_to_show, cm, x->e_mbd.plane,
                          mi_row - MI_BLOCK_SIZE, mi_col - MI_BLOCK_SIZE, 0);
@@ -3439,13 +3532,17 @@ static void encode_nonrd_sb_row(VP9_COMP *cpi, MACROBLOCK *const x,
         vp9_loop_filter_sb(cm->frame_to_show, cm, x->e_mbd.plane,
                            mi_row - MI_BLOCK_SIZE, mi_col, 0);
       }
+      vp9_stats_timer_mark(x->stats, &timer,
+                           &x->stats->stage_us[VP9E_STAGE_LOOP_FILTER]);
     }
     // In multi-threading, after encoding the SB, make sure this is updated
-    // in the cur_sb_col count
+    // in the row progress
     if (cpi->max_threads > 1 &&
         !x->data_parallel_processing) {
       const int sb_row = mi_row >> MI_BLOCK_SIZE_LOG2;
-      vp9_enc_sync_write(cpi, sb_row);
+      const int sb_col = mi_col >> MI_BLOCK_SIZE_LOG2;
+
+      vp9_row_sync_write(&cpi->row_sync, sb_row, sb_col, cm->sb_cols);
     }
   }
 
@@ -3455,8 +3552,13 @@ static void encode_nonrd_sb_row(VP9_COMP *cpi, MACROBLOCK *const x,
       cpi->sf.lpf_pick >= LPF_PICK_FROM_Q) {
     // Do a loopfilter of the last SB row of the frame
     if (cm->lf.filter_level > 0) {
+      struct vpx_usec_timer timer;
+
+      vp9_stats_timer_start(x->stats, &timer);
       vp9_loop_filter_rows(cm->frame_to_show, cm, x->e_mbd.plane,
                            mi_row, cm->mi_rows, 0);
+      vp9_stats_timer_mark(x->stats, &timer,
+                           &x->stats->stage_us[VP9E_STAGE_LOOP_FILTER]);
     }
     vp9_post_loopfilter(cm);
   }
@@ -3583,34 +3685,36 @@ static INLINE void restore_frame_counts(VP9_COMP *cpi, MACROBLOCK *x_thread) {
                sizeof(x_thread->rd.tx_select_diff));
 }
 
-static void encode_sb_rows(VP9_COMP *cpi, MACROBLOCK *const x,
-                           int mi_row_start, int mi_row_end,
-                           int mi_row_step) {
+static void encode_sb_row(VP9_COMP *cpi, MACROBLOCK *const x, int mi_row) {
   VP9_COMMON * cm = &cpi->common;
   const int tile_cols = 1 << cm->log2_tile_cols;
+  const int sb_row = mi_row >> MI_BLOCK_SIZE_LOG2;
   int tile_col, tile_row;
-  int mi_row;
   TileInfo tile;
   TOKENEXTRA *tok = cpi->tok;
 
-  for (mi_row = mi_row_start; mi_row < mi_row_end; mi_row += mi_row_step) {
-    const int sb_row = mi_row >> MI_BLOCK_SIZE_LOG2;
-    tile_row = vp9_get_tile_row_index(&tile, cm, mi_row);
-    for (tile_col = 0; tile_col < tile_cols; ++tile_col) {
-      vp9_tile_set_col(&tile, cm, tile_col);
-      get_start_tok(cpi, tile_row, tile_col, mi_row, &tok);
-      cpi->tplist[sb_row][tile_row][tile_col].start = tok;
-      if (cpi->sf.use_nonrd_pick_mode && !frame_is_intra_only(cm))
-        encode_nonrd_sb_row(cpi, x, &tile, mi_row, &tok);
-      else
-        encode_rd_sb_row(cpi, x, &tile, mi_row, &tok);
-      cpi->tplist[sb_row][tile_row][tile_col].stop = tok;
-      assert(tok - cpi->tplist[sb_row][tile_row][0].start <=
-             get_token_alloc(MI_BLOCK_SIZE >> 1, cm->mb_cols));
-    }
+  tile_row = vp9_get_tile_row_index(&tile, cm, mi_row);
+  for (tile_col = 0; tile_col < tile_cols; ++tile_col) {
+    vp9_tile_set_col(&tile, cm, tile_col);
+    get_start_tok(cpi, tile_row, tile_col, mi_row, &tok);
+    cpi->tplist[sb_row][tile_row][tile_col].start = tok;
+    if (cpi->sf.use_nonrd_pick_mode && !frame_is_intra_only(cm))
+      encode_nonrd_sb_row(cpi, x, &tile, mi_row, &tok);
+    else
+      encode_rd_sb_row(cpi, x, &tile, mi_row, &tok);
+    cpi->tplist[sb_row][tile_row][tile_col].stop = tok;
+    assert(tok - cpi->tplist[sb_row][tile_row][0].start <=
+           get_token_alloc(MI_BLOCK_SIZE >> 1, cm->mb_cols));
   }
 }
 
+static void encode_sb_rows(VP9_COMP *cpi, MACROBLOCK *const x) {
+  int mi_row;
+
+  for (mi_row = 0; mi_row < cpi->common.mi_rows; mi_row += MI_BLOCK_SIZE)
+    encode_sb_row(cpi, x, mi_row);
+}
+
 static void encode_tiles(VP9_COMP *cpi) {
   VP9_COMMON *const cm = &cpi->common;
   MACROBLOCK *const x = &cpi->mb;
@@ -3626,64 +3730,41 @@ static void encode_tiles(VP9_COMP *cpi) {
 #if CONFIG_GPU_COMPUTE
     vp9_gpu_mv_compute(cpi, x);
 #else
-    encode_sb_rows(cpi, x, 0, cm->mi_rows, MI_BLOCK_SIZE);
+    encode_sb_rows(cpi, x);
 #endif
     x->data_parallel_processing = 0;
   }
   // encode SB
-  encode_sb_rows(cpi, x, 0, cm->mi_rows, MI_BLOCK_SIZE);
+  encode_sb_rows(cpi, x);
 
   restore_frame_counts(cpi, x);
 }
 
-void encode_tiles_mt(VP9_COMP *cpi) {
-  VP9_COMMON *const cm = &cpi->common;
+// Runs one pass of the encoding threads over all the SB rows of the frame.
+static void run_encoding_threads(VP9_COMP *cpi, int data_parallel_processing) {
   const VP9WorkerInterface *const winterface = vp9_get_worker_interface();
+  struct vpx_usec_timer timer;
   int thread_id;
 
-  // Initialize row encoding hook
-  for (thread_id = 0; thread_id < cpi->max_threads; ++thread_id) {
-    winterface->sync(&cpi->enc_thread_hndl[thread_id]);
-    cpi->enc_thread_hndl[thread_id].hook =
-        (VP9WorkerHook) encoding_thread_process;
-  }
+  vp9_stats_timer_start(&cpi->thread_stats, &timer);
 
-  // Initialize cur_sb_col to -1 for all SB rows.
-  vpx_memset(cpi->cur_sb_col, -1, (sizeof(*cpi->cur_sb_col) * cm->sb_rows));
-
-  // Call the Data parallel MV compute (to be performed by GPU)
-  if (cm->use_gpu &&
-      cpi->sf.use_nonrd_pick_mode && !frame_is_intra_only(cm)) {
-    MACROBLOCK *const x = &cpi->mb;
-    vp9_set_gpu_block_sizes(cpi);
-    (void)x;
-#if CONFIG_GPU_COMPUTE
-    // TODO(ram-ittiam): Remove this assert, after adding appropriate sanity
-    // checks for use_gpu setting
-    assert(cm->prev_mi != NULL);
-    x->data_parallel_processing = 1;
-    vp9_gpu_mv_compute(cpi, x);
-    x->data_parallel_processing = 0;
-#endif
-  }
+  // Mark all SB rows as not encoded.
+  vp9_row_sync_reset(&cpi->row_sync);
 
   for (thread_id = 0; thread_id < cpi->max_threads ; ++thread_id) {
     VP9Worker *const worker = &cpi->enc_thread_hndl[thread_id];
     thread_context *const thread_ctxt = (thread_context *)worker->data1;
 
+    worker->hook = (VP9WorkerHook) encoding_thread_process;
+
     // initialize thread context
     thread_ctxt->cpi = cpi;
 
-    // thread start sb row
-    thread_ctxt->mi_row_start = MI_BLOCK_SIZE * thread_id;
-    // thread end sb row
-    thread_ctxt->mi_row_end = cm->mi_rows;
-    // thread step sb row
-    thread_ctxt->mi_row_step = MI_BLOCK_SIZE * cpi->max_threads;
-
     //thread id
     thread_ctxt->thread_id = thread_id;
 
+    thread_ctxt->data_parallel_processing = data_parallel_processing;
+
     // start encoding
     if (thread_id == cpi->max_threads - 1) {
       winterface->execute(worker);
@@ -3693,16 +3774,49 @@ void encode_tiles_mt(VP9_COMP *cpi) {
   }
 
   // Wait till all rows are finished
+  for (thread_id = 0; thread_id < cpi->max_threads; ++thread_id)
+    winterface->sync(&cpi->enc_thread_hndl[thread_id]);
+
+  if (cpi->thread_stats.enabled) {
+    vpx_usec_timer_mark(&timer);
+    vp9_frame_stats_end_pass(cpi, VP9E_STAGE_ENCODE,
+                             vpx_usec_timer_elapsed(&timer));
+  }
+}
+
+void encode_tiles_mt(VP9_COMP *cpi) {
+  VP9_COMMON *const cm = &cpi->common;
+  int thread_id;
+
+  // Call the Data parallel MV compute (to be performed by GPU)
+  if (cm->use_gpu &&
+      cpi->sf.use_nonrd_pick_mode && !frame_is_intra_only(cm)) {
+    MACROBLOCK *const x = &cpi->mb;
+    vp9_set_gpu_block_sizes(cpi);
+    (void)x;
+    // TODO(ram-ittiam): Remove this assert, after adding appropriate sanity
+    // checks for use_gpu setting
+    assert(cm->prev_mi != NULL);
+#if CONFIG_GPU_COMPUTE
+    x->data_parallel_processing = 1;
+    vp9_gpu_mv_compute(cpi, x);
+    x->data_parallel_processing = 0;
+#else
+    // The rows are encoded by whichever thread is free, so all of them have
+    // to be analyzed first.
+    run_encoding_threads(cpi, 1);
+#endif
+  }
+
+  run_encoding_threads(cpi, 0);
+
+  // After encoding the frame, accumulate the stats across all threads,
+  // for updating probability and rd thresh tables for the next frame.
   for (thread_id = 0; thread_id < cpi->max_threads; ++thread_id) {
     VP9Worker *const worker = &cpi->enc_thread_hndl[thread_id];
     thread_context *const row_data = (thread_context *)worker->data1;
-    MACROBLOCK *const x = &row_data->mb;
 
-    winterface->sync(worker);
-
-    // After encoding the frame, accumulate the stats across all threads,
-    // for updating probability and rd thresh tables for the next frame.
-    add_up_frame_counts(cpi, x);
+    add_up_frame_counts(cpi, &row_data->mb);
   }
 }
 
@@ -3712,11 +3826,15 @@ int encoding_thread_process(thread_context *const thread_ctxt, void* data2) {
   MACROBLOCK *const x = &thread_ctxt->mb;
   MACROBLOCKD *const xd = &x->e_mbd;
   SPEED_FEATURES *const sf = &cpi->sf;
+  struct vpx_usec_timer timer;
+  int mi_row;
 
   (void)data2;
+  vp9_stats_timer_start(&thread_ctxt->stats, &timer);
   // initialize mb in thread context
   vp9_mb_copy(cpi, &thread_ctxt->mb, &cpi->mb);
   x->thread_id = thread_ctxt->thread_id;
+  x->stats = &thread_ctxt->stats;
   if (sf->use_nonrd_pick_mode) {
     // Initialize internal buffer pointers for rtc coding, where non-RD
     // mode decision is used and hence no buffer pointer swap needed.
@@ -3733,24 +3851,15 @@ int encoding_thread_process(thread_context *const thread_ctxt, void* data2) {
     }
     vp9_zero(x->zcoeff_blk);
   }
-#if !CONFIG_GPU_COMPUTE
-  // Call the Data parallel MV compute (to be performed by GPU)
-  if (cm->use_gpu &&
-      cpi->sf.use_nonrd_pick_mode &&
-      !frame_is_intra_only(cm)) {
-    // TODO(ram-ittiam): Remove this assert, after adding appropriate sanity
-    // checks for use_gpu setting
-    assert(cm->prev_mi != NULL);
-    x->data_parallel_processing = 1;
-    encode_sb_rows(cpi, x, thread_ctxt->mi_row_start, thread_ctxt->mi_row_end,
-                   thread_ctxt->mi_row_step);
-    x->data_parallel_processing = 0;
-  }
-#endif
-  (void)cm;
-  encode_sb_rows(cpi, x, thread_ctxt->mi_row_start, thread_ctxt->mi_row_end,
-                 thread_ctxt->mi_row_step);
 
+  // Take the SB rows one at a time, until all of them are taken.
+  x->data_parallel_processing = thread_ctxt->data_parallel_processing;
+  while ((mi_row = vp9_row_sync_next_row(&cpi->row_sync) * MI_BLOCK_SIZE) <
+         cm->mi_rows)
+    encode_sb_row(cpi, x, mi_row);
+  x->data_parallel_processing = 0;
+
+  vp9_stats_timer_mark(x->stats, &timer, &x->stats->pass_us);
   return 0;
 }
 
@@ -3858,6 +3967,8 @@ static void encode_frame_internal(VP9_COMP *cpi) {
 
     vpx_usec_timer_mark(&emr_timer);
     cpi->time_encode_sb_row += vpx_usec_timer_elapsed(&emr_timer);
+    vp9_frame_stats_add_stage(cpi, VP9E_STAGE_ENCODE,
+                              vpx_usec_timer_elapsed(&emr_timer));
   }
 
   sf->skip_encode_frame = sf->skip_encode_sb ? get_skip_encode_frame(cm) : 0;
@@ -4053,6 +4164,16 @@ static int get_zbin_mode_boost(const MB_MODE_INFO *mbmi, int enabled) {
   }
 }
 
+static void tokenize_sb(VP9_COMP *cpi, MACROBLOCK *const x, TOKENEXTRA **t,
+                        int dry_run, BLOCK_SIZE bsize) {
+  struct vpx_usec_timer timer;
+
+  vp9_stats_timer_start(x->stats, &timer);
+  vp9_tokenize_sb(cpi, x, t, dry_run, bsize);
+  vp9_stats_timer_mark(x->stats, &timer,
+                       &x->stats->stage_us[VP9E_STAGE_TOKENIZE]);
+}
+
 static void encode_superblock(VP9_COMP *cpi, MACROBLOCK *const x,
                               TOKENEXTRA **t, int output_enabled,
                               int mi_row, int mi_col, BLOCK_SIZE bsize,
@@ -4100,7 +4221,7 @@ static void encode_superblock(VP9_COMP *cpi, MACROBLOCK *const x,
       vp9_encode_intra_block_plane(x, MAX(bsize, BLOCK_8X8), plane);
     if (output_enabled)
       sum_intra_stats(&x->counts, mi);
-    vp9_tokenize_sb(cpi, x, t, !output_enabled, MAX(bsize, BLOCK_8X8));
+    tokenize_sb(cpi, x, t, !output_enabled, MAX(bsize, BLOCK_8X8));
   } else {
     int ref;
     const int is_compound = has_second_ref(mbmi);
@@ -4116,7 +4237,7 @@ static void encode_superblock(VP9_COMP *cpi, MACROBLOCK *const x,
     vp9_build_inter_predictors_sbuv(xd, mi_row, mi_col, MAX(bsize, BLOCK_8X8));
 
     vp9_encode_sb(x, MAX(bsize, BLOCK_8X8));
-    vp9_tokenize_sb(cpi, x, t, !output_enabled, MAX(bsize, BLOCK_8X8));
+    tokenize_sb(cpi, x, t, !output_enabled, MAX(bsize, BLOCK_8X8));
   }
 
   if (output_enabled) {
@@ -36,6 +36,15 @@ int encoding_thread_process(thread_context *const thread_ctxt, void* data2);
 int is_background(const VP9_COMP *cpi, const TileInfo *const tile,
                   int mi_row, int mi_col);
 
+// Data-parallel ZEROMV/NEWMV search of one GPU block, as performed by the GPU
+// compute kernels. The result is written to the block's GPU_OUTPUT.
+void vp9_pick_inter_mode_data_parallel(struct VP9_COMP *cpi,
+                                       struct macroblock *const x,
+                                       const TileInfo *const tile,
+                                       int mi_row, int mi_col,
+                                       BLOCK_SIZE bsize,
+                                       PICK_MODE_CONTEXT *ctx);
+
 void vp9_encode_frame(struct VP9_COMP *cpi);
 
 #ifdef __cplusplus
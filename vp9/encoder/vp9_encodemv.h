@@ -22,8 +22,11 @@ void vp9_entropy_mv_init();
 
 void vp9_write_nmv_probs(VP9_COMMON *cm, int usehp, vp9_writer *w);
 
-void vp9_encode_mv(VP9_COMP *cpi, vp9_writer* w, const MV* mv, const MV* ref,
-                   const nmv_context* mvctx, int usehp);
+// Write 'mv' as a difference to 'ref'. When 'max_mv_magnitude' is not NULL it
+// is raised to the largest full pixel component of 'mv'.
+void vp9_encode_mv(vp9_writer* w, const MV* mv, const MV* ref,
+                   const nmv_context* mvctx, int usehp,
+                   unsigned int *max_mv_magnitude);
 
 void vp9_build_nmv_cost_table(int *mvjoint, int *mvcost[2],
                               const nmv_context* mvctx, int usehp);
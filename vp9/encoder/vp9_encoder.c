@@ -36,9 +36,14 @@
 #include "vp9/encoder/vp9_encodeframe.h"
 #include "vp9/encoder/vp9_encodemv.h"
 #include "vp9/encoder/vp9_firstpass.h"
+#include "vp9/encoder/vp9_frame_stats.h"
 #include "vp9/encoder/vp9_egpu.h"
 #include "vp9/encoder/vp9_mbgraph.h"
 #include "vp9/encoder/vp9_encoder.h"
+#include "vp9/encoder/vp9_lookahead_stats.h"
+#if CONFIG_MULTI_RES_ENCODING
+#include "vp9/encoder/vp9_multi_res.h"
+#endif
 #include "vp9/encoder/vp9_picklpf.h"
 #include "vp9/encoder/vp9_ratectrl.h"
 #include "vp9/encoder/vp9_rd.h"
@@ -201,10 +206,19 @@ static void dealloc_compressor_data(VP9_COMP *cpi) {
   vp9_free_ref_frame_buffers(cm);
   vp9_free_context_buffers(cm);
 
-  vp9_free_frame_buffer(&cpi->last_frame_uf);
+  vp9_lpf_search_free(cpi->lpf_search);
+  cpi->lpf_search = NULL;
+  vpx_free(cpi->fp_frame.row_stats);
+  cpi->fp_frame.row_stats = NULL;
   vp9_free_frame_buffer(&cpi->scaled_source);
   vp9_free_frame_buffer(&cpi->scaled_last_source);
   vp9_free_frame_buffer(&cpi->alt_ref_buffer);
+#if CONFIG_MULTI_RES_ENCODING
+  vp9_free_frame_buffer(&cpi->mr_scaled_source);
+#endif
+  // The first pass may still read the newest frame of the lookahead.
+  vp9_lookahead_stats_remove(cpi->lookahead_stats);
+  cpi->lookahead_stats = NULL;
   vp9_lookahead_destroy(cm, cpi->lookahead);
 
 #if CONFIG_GPU_COMPUTE
@@ -218,6 +232,9 @@ static void dealloc_compressor_data(VP9_COMP *cpi) {
   vpx_free(cpi->tplist);
   cpi->tplist = NULL;
 
+  vpx_free(cpi->tile_pack_buf);
+  cpi->tile_pack_buf = NULL;
+
   if (cm->use_gpu) {
     vp9_free_gpu_interface_buffers(cpi);
   }
@@ -245,7 +262,9 @@ static void dealloc_compressor_data(VP9_COMP *cpi) {
       vpx_free(worker->data2);
     }
     vpx_free(cpi->enc_thread_hndl);
-    vpx_free(cpi->cur_sb_col);
+    vp9_row_sync_dealloc(&cpi->row_sync);
+    vp9_row_sync_dealloc(&cpi->fp_row_sync);
+    vpx_free(cpi->sb_row_thresh_freq_fact);
   }
 
   for (i = 0; i < MAX_LAG_BUFFERS; ++i) {
@@ -468,6 +487,11 @@ static void alloc_raw_frame_buffers(VP9_COMP *cpi) {
     vpx_internal_error(&cm->error, VPX_CODEC_MEM_ERROR,
                        "Failed to allocate lag buffers");
 
+  // Only the frame buffers of the GPU path are known to the GPU, its
+  // lookahead frames are always copies.
+  cpi->lookahead->release = cpi->source_release;
+  cpi->lookahead->use_ext_frames = !cm->use_gpu;
+
   if (vp9_realloc_frame_buffer(&cpi->alt_ref_buffer,
                                oxcf->width, oxcf->height,
                                cm->subsampling_x, cm->subsampling_y,
@@ -488,16 +512,6 @@ static void alloc_ref_frame_buffers(VP9_COMP *cpi) {
 
 static void alloc_util_frame_buffers(VP9_COMP *cpi) {
   VP9_COMMON *const cm = &cpi->common;
-  if (vp9_realloc_frame_buffer(&cpi->last_frame_uf,
-                               cm->width, cm->height,
-                               cm->subsampling_x, cm->subsampling_y,
-#if CONFIG_VP9_HIGHBITDEPTH
-                               cm->use_highbitdepth,
-#endif
-                               VP9_ENC_BORDER_IN_PIXELS, NULL, NULL, NULL))
-    vpx_internal_error(&cm->error, VPX_CODEC_MEM_ERROR,
-                       "Failed to allocate last frame buffer");
-
   if (vp9_realloc_frame_buffer(&cpi->scaled_source,
                                cm->width, cm->height,
                                cm->subsampling_x, cm->subsampling_y,
@@ -535,9 +549,24 @@ void vp9_alloc_compressor_data(VP9_COMP *cpi) {
   CHECK_MEM_ERROR(cm, cpi->tplist,
                   vpx_calloc(cm->sb_rows, sizeof(*cpi->tplist)));
 
+  vpx_free(cpi->fp_frame.row_stats);
+  CHECK_MEM_ERROR(cm, cpi->fp_frame.row_stats,
+                  vpx_calloc(cm->mb_rows, sizeof(*cpi->fp_frame.row_stats)));
+
   // don't create more threads than rows available
   cpi->max_threads = MIN(cpi->max_threads, cm->sb_rows);
 
+  // The tiles get as many bytes per pixel as the frames get in the output
+  // buffer of the codec.
+  vpx_free(cpi->tile_pack_buf);
+  cpi->tile_pack_buf = NULL;
+  if (cpi->max_threads > 1) {
+    cpi->tile_pack_buf_size = (size_t)cm->mi_rows * cm->mi_cols *
+                              MI_SIZE * MI_SIZE * 3;
+    CHECK_MEM_ERROR(cm, cpi->tile_pack_buf,
+                    vpx_malloc(cpi->tile_pack_buf_size));
+  }
+
   vp9_setup_pc_tree(&cpi->common, cpi);
 }
 
@@ -603,6 +632,7 @@ static void init_config(struct VP9_COMP *cpi, VP9EncoderConfig *oxcf) {
   // by default, single thread
   cpi->max_threads = 1;
   cpi->mb.thread_id = 0;
+  cpi->mb.stats = &cpi->thread_stats;
 #if CONFIG_MULTITHREAD
   if (cpi->oxcf.threads) {
     assert(cpi->oxcf.threads > 0);
@@ -755,6 +785,18 @@ void vp9_change_config(struct VP9_COMP *cpi, const VP9EncoderConfig *oxcf) {
   cpi->ext_refresh_frame_flags_pending = 0;
   cpi->ext_refresh_frame_context_pending = 0;
 
+  // The rate control is set up for the statistics of the lookahead frames
+  // before the first frame.
+  if (cpi->oxcf.lookahead_stats && cpi->lookahead_stats == NULL) {
+    vp9_rc_init(&cpi->oxcf, cpi->oxcf.pass, rc);
+    CHECK_MEM_ERROR(cm, cpi->lookahead_stats,
+                    vp9_lookahead_stats_create(cpi));
+  } else if (!cpi->oxcf.lookahead_stats && cpi->lookahead_stats != NULL) {
+    vp9_lookahead_stats_remove(cpi->lookahead_stats);
+    cpi->lookahead_stats = NULL;
+    vp9_rc_init(&cpi->oxcf, cpi->oxcf.pass, rc);
+  }
+
 #if CONFIG_VP9_TEMPORAL_DENOISING
   if (cpi->oxcf.noise_sensitivity > 0) {
     vp9_denoiser_alloc(&(cpi->denoiser), cm->width, cm->height,
@@ -828,6 +870,9 @@ VP9_COMP *vp9_create_compressor(VP9EncoderConfig *oxcf) {
 
   cm->error.setjmp = 1;
 
+  CHECK_MEM_ERROR(cm, cm->frame_bufs,
+                  vpx_calloc(FRAME_BUFFERS, sizeof(*cm->frame_bufs)));
+
   cpi->use_svc = 0;
 
   init_config(cpi, oxcf);
@@ -980,7 +1025,7 @@ VP9_COMP *vp9_create_compressor(VP9EncoderConfig *oxcf) {
 
   if (oxcf->pass == 1) {
     vp9_init_first_pass(cpi);
-  } else if (oxcf->pass == 2) {
+  } else if (oxcf->pass == 2 && !oxcf->lookahead_stats) {
     const size_t packet_sz = sizeof(FIRSTPASS_STATS);
     const int packets = (int)(oxcf->two_pass_stats_in.sz / packet_sz);
 
@@ -1196,6 +1241,15 @@ void vp9_remove_compressor(VP9_COMP *cpi) {
                 cpi->total_ssimg_all / cpi->count, total_encode_time);
       }
 
+      if (cpi->max_threads > 1) {
+        VP9RowSyncStats sync_stats;
+
+        vp9_row_sync_get_stats(&cpi->row_sync, &sync_stats);
+        fprintf(f, "SyncRng\t Stalls\t    Spins\t  Waits\n");
+        fprintf(f, "%7d\t%7u\t%9u\t%7u\n", cpi->row_sync.sync_range,
+                sync_stats.stalls, sync_stats.spins, sync_stats.waits);
+      }
+
       fclose(f);
     }
 
@@ -1259,9 +1313,9 @@ void vp9_remove_compressor(VP9_COMP *cpi) {
 
 #endif
 }
-static int64_t get_sse(const uint8_t *a, int a_stride,
-                       const uint8_t *b, int b_stride,
-                       int width, int height) {
+int64_t vp9_get_sse(const uint8_t *a, int a_stride,
+                    const uint8_t *b, int b_stride,
+                    int width, int height) {
   const int dw = width % 16;
   const int dh = height % 16;
   int64_t total_sse = 0;
@@ -1322,9 +1376,9 @@ static void calc_psnr(const YV12_BUFFER_CONFIG *a, const YV12_BUFFER_CONFIG *b,
     const int w = widths[i];
     const int h = heights[i];
     const uint32_t samples = w * h;
-    const uint64_t sse = get_sse(a_planes[i], a_strides[i],
-                                 b_planes[i], b_strides[i],
-                                 w, h);
+    const uint64_t sse = vp9_get_sse(a_planes[i], a_strides[i],
+                                     b_planes[i], b_strides[i],
+                                     w, h);
     psnr->sse[1 + i] = sse;
     psnr->samples[1 + i] = samples;
     psnr->psnr[1 + i] = vpx_sse_to_psnr(samples, 255.0, (double)sse);
@@ -1893,9 +1947,13 @@ static void encode_with_recode_loop(VP9_COMP *cpi,
     // accurate estimate of output frame size to determine if we need
     // to recode.
     if (cpi->sf.recode_loop >= ALLOW_RECODE_KFARFGF) {
+      struct vpx_usec_timer timer;
+
       save_coding_context(cpi);
+      vp9_stats_timer_start(&cpi->thread_stats, &timer);
       if (!cpi->sf.use_nonrd_pick_mode)
         vp9_pack_bitstream(cpi, dest, size);
+      vp9_frame_stats_mark_stage(cpi, VP9E_STAGE_PACK, &timer);
 
       rc->projected_frame_size = (int)(*size) << 3;
       restore_coding_context(cpi);
@@ -2189,6 +2247,7 @@ static void encode_frame_to_data_rate(VP9_COMP *cpi,
 #if CONFIG_GPU_COMPUTE
   VP9_EGPU *egpu = &cpi->egpu;
 #endif
+  struct vpx_usec_timer timer;
   TX_SIZE t;
   int q;
   int top_index;
@@ -2305,11 +2364,18 @@ static void encode_frame_to_data_rate(VP9_COMP *cpi,
       cm->frame_type != KEY_FRAME) {
     if (vp9_rc_drop_frame(cpi)) {
       vp9_rc_postencode_update_drop_frame(cpi);
+#if CONFIG_MULTI_RES_ENCODING
+      vp9_mr_store_drop_frame_info(cpi);
+#endif
       ++cm->current_video_frame;
       return;
     }
   }
 
+#if CONFIG_MULTI_RES_ENCODING
+  vp9_mr_setup_frame(cpi);
+#endif
+
   vp9_clear_system_state();
 
 #if CONFIG_VP9_POSTPROC
@@ -2392,7 +2458,9 @@ static void encode_frame_to_data_rate(VP9_COMP *cpi,
   if (!cpi->sf.use_nonrd_pick_mode ||
       frame_is_intra_only(cm) ||
       cpi->sf.lpf_pick < LPF_PICK_FROM_Q) {
+    vp9_stats_timer_start(&cpi->thread_stats, &timer);
     loopfilter_frame(cpi);
+    vp9_frame_stats_mark_stage(cpi, VP9E_STAGE_LOOP_FILTER, &timer);
   }
 
 #if CONFIG_GPU_COMPUTE
@@ -2401,12 +2469,17 @@ static void encode_frame_to_data_rate(VP9_COMP *cpi,
 #endif
 
   // build the bitstream
+  vp9_stats_timer_start(&cpi->thread_stats, &timer);
   vp9_pack_bitstream(cpi, dest, size);
+  vp9_frame_stats_mark_stage(cpi, VP9E_STAGE_PACK, &timer);
 
   if (cm->seg.update_map)
     update_reference_segmentation_map(cpi);
 
   release_scaled_references(cpi);
+#if CONFIG_MULTI_RES_ENCODING
+  vp9_mr_store_frame_info(cpi);
+#endif
   vp9_update_reference_frames(cpi);
 
   for (t = TX_4X4; t <= TX_32X32; t++)
@@ -2537,8 +2610,8 @@ static void check_initial_width(VP9_COMP *cpi, int subsampling_x,
 
 
 int vp9_receive_raw_frame(VP9_COMP *cpi, unsigned int frame_flags,
-                          YV12_BUFFER_CONFIG *sd, int64_t time_stamp,
-                          int64_t end_time) {
+                          YV12_BUFFER_CONFIG *sd, const vpx_image_t *img,
+                          int64_t time_stamp, int64_t end_time) {
   VP9_COMMON *cm = &cpi->common;
   struct vpx_usec_timer timer;
   int res = 0;
@@ -2549,16 +2622,33 @@ int vp9_receive_raw_frame(VP9_COMP *cpi, unsigned int frame_flags,
 
   vpx_usec_timer_start(&timer);
 
+#if CONFIG_MULTI_RES_ENCODING
+  if (cpi->oxcf.mr_total_resolutions > 1) {
+    YV12_BUFFER_CONFIG *const source = vp9_mr_scale_source(cpi, sd);
+    if (source == NULL)
+      return -1;
+    // The application's image is not referenced once downscaled.
+    if (source != sd) {
+      if (img != NULL && cpi->source_release.cb != NULL)
+        cpi->source_release.cb(cpi->source_release.cb_priv, img);
+      sd = source;
+      img = NULL;
+    }
+  }
+#endif
+
 #if CONFIG_SPATIAL_SVC
   if (is_two_pass_svc(cpi))
-    res = vp9_svc_lookahead_push(cpi, cpi->lookahead, sd, time_stamp, end_time,
-                                 frame_flags);
+    res = vp9_svc_lookahead_push(cpi, cpi->lookahead, sd, img, time_stamp,
+                                 end_time, frame_flags);
   else
 #endif
-    res = vp9_lookahead_push(cpi->lookahead,
-                             sd, time_stamp, end_time, frame_flags);
+    res = vp9_lookahead_push(cpi->lookahead, sd, img,
+                             time_stamp, end_time, frame_flags);
   if (res)
     res = -1;
+  else if (cpi->lookahead_stats != NULL)
+    res = vp9_lookahead_stats_push(cpi);
   vpx_usec_timer_mark(&timer);
   cpi->time_receive_data += vpx_usec_timer_elapsed(&timer);
 
@@ -2693,7 +2783,17 @@ int vp9_get_compressed_data(VP9_COMP *cpi, unsigned int *frame_flags,
     vp9_restore_layer_context(cpi);
   }
 
+  // The frame to code needs its first pass statistics, and the last ones are
+  // all there once the input ends.
+  if (cpi->lookahead_stats != NULL &&
+      (flush || cpi->twopass.stats_in >= cpi->twopass.stats_in_end)) {
+    vp9_lookahead_stats_sync(cpi);
+    if (flush)
+      cpi->twopass.stats_in_open = 0;
+  }
+
   vpx_usec_timer_start(&cmptimer);
+  vp9_frame_stats_start(cpi);
 
   vp9_set_high_precision_mv(cpi, ALTREF_HIGH_PRECISION_MV);
 
@@ -2733,8 +2833,12 @@ int vp9_get_compressed_data(VP9_COMP *cpi, unsigned int *frame_flags,
 #endif
 
       if (oxcf->arnr_max_frames > 0) {
+        struct vpx_usec_timer timer;
+
         // Produce the filtered ARF frame.
+        vp9_stats_timer_start(&cpi->thread_stats, &timer);
         vp9_temporal_filter(cpi, arf_src_index);
+        vp9_frame_stats_mark_stage(cpi, VP9E_STAGE_TEMPORAL_FILTER, &timer);
         vp9_extend_frame_borders(&cpi->alt_ref_buffer);
         force_src_buffer = &cpi->alt_ref_buffer;
       }
@@ -2788,6 +2892,11 @@ int vp9_get_compressed_data(VP9_COMP *cpi, unsigned int *frame_flags,
     *time_stamp = source->ts_start;
     *time_end = source->ts_end;
     *frame_flags = (source->flags & VPX_EFLAG_FORCE_KF) ? FRAMEFLAGS_KEY : 0;
+#if CONFIG_MULTI_RES_ENCODING
+    // Keep the key frames of all the resolutions aligned.
+    if (cm->show_frame && vp9_mr_is_key_frame(cpi))
+      *frame_flags = FRAMEFLAGS_KEY;
+#endif
 
   } else {
     *size = 0;
@@ -2932,6 +3041,8 @@ int vp9_get_compressed_data(VP9_COMP *cpi, unsigned int *frame_flags,
 
   vpx_usec_timer_mark(&cmptimer);
   cpi->time_compress_data += vpx_usec_timer_elapsed(&cmptimer);
+  if (*size > 0)
+    vp9_frame_stats_end(cpi, vpx_usec_timer_elapsed(&cmptimer));
 
   if (cpi->b_calculate_psnr && oxcf->pass != 1 && cm->show_frame)
     generate_psnr_packet(cpi);
@@ -3136,8 +3247,8 @@ int vp9_get_y_sse(const YV12_BUFFER_CONFIG *a, const YV12_BUFFER_CONFIG *b) {
   assert(a->y_crop_width == b->y_crop_width);
   assert(a->y_crop_height == b->y_crop_height);
 
-  return (int)get_sse(a->y_buffer, a->y_stride, b->y_buffer, b->y_stride,
-                      a->y_crop_width, a->y_crop_height);
+  return (int)vp9_get_sse(a->y_buffer, a->y_stride, b->y_buffer, b->y_stride,
+                          a->y_crop_width, a->y_crop_height);
 }
 
 
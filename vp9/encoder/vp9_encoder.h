@@ -22,6 +22,7 @@
 #include "vp9/common/vp9_entropy.h"
 #include "vp9/common/vp9_entropymode.h"
 #include "vp9/common/vp9_onyxc_int.h"
+#include "vp9/common/vp9_row_sync.h"
 #include "vp9/common/vp9_thread.h"
 
 #include "vp9/encoder/vp9_aq_cyclicrefresh.h"
@@ -171,10 +172,18 @@ typedef struct VP9EncoderConfig {
   // Enable feature to reduce the frame quantization every x frames.
   int frame_periodic_boost;
 
+  // Code the static regions of the alt ref groups with a segment of their
+  // own, overriding the speed feature.
+  int static_segmentation;
+
   // two pass datarate control
   int two_pass_vbrbias;        // two pass datarate control tweaks
   int two_pass_vbrmin_section;
   int two_pass_vbrmax_section;
+
+  // Run the two pass rate control over first pass statistics computed on the
+  // frames as they are pushed into the lookahead, with 'pass' set to 2.
+  int lookahead_stats;
   // END DATARATE CONTROL OPTIONS
   // ----------------------------------------------------------------
 
@@ -227,6 +236,17 @@ typedef struct VP9EncoderConfig {
 #if CONFIG_VP9_HIGHBITDEPTH
   int use_highbitdepth;
 #endif
+
+#if CONFIG_MULTI_RES_ENCODING
+  // Number of resolutions encoded together, and index of this one, from the
+  // lowest resolution.
+  int mr_total_resolutions;
+  int mr_encoder_id;
+  // Down-sampling factor from this resolution to the next lower one.
+  vpx_rational_t mr_down_sampling_factor;
+  // Information shared with the encoder of the next lower resolution.
+  void *mr_low_res_mode_info;
+#endif
 } VP9EncoderConfig;
 
 static INLINE int is_lossless_requested(const VP9EncoderConfig *cfg) {
@@ -240,6 +260,8 @@ typedef struct VP9_COMP {
   VP9EncoderConfig oxcf;
   struct lookahead_ctx    *lookahead;
   struct lookahead_entry  *alt_ref_source;
+  // Release of the source images referenced by the lookahead queue.
+  vpx_source_release_cb_t source_release;
 
   YV12_BUFFER_CONFIG *Source;
   YV12_BUFFER_CONFIG *Last_Source;  // NULL for first frame and alt_ref frames
@@ -267,7 +289,8 @@ typedef struct VP9_COMP {
   int ext_refresh_frame_context_pending;
   int ext_refresh_frame_context;
 
-  YV12_BUFFER_CONFIG last_frame_uf;
+  // Scratch state of the loop filter level search.
+  struct LPF_SEARCH *lpf_search;
 
   // The tokens resulted while encoding a frame are stored in the frame buffer
   // pointed by "*tok"
@@ -339,11 +362,23 @@ typedef struct VP9_COMP {
   VP9Worker *enc_thread_hndl;
   int max_threads;
 
-  // Allocate memory to store the encoded superblock index in each row.
-  int *cur_sb_col;
+  // Wavefront synchronization of the SB rows, shared by the encoding and the
+  // loop filter threads.
+  VP9RowSync row_sync;
+
+  // Adaptive rd thresholds each SB row starts from, when encoding with
+  // multiple threads.
+  int (*sb_row_thresh_freq_fact)[BLOCK_SIZES][MAX_MODES];
 
-  // minimum spatial distance (in SB) between encoding threads
-  int sync_range;
+  // Wavefront synchronization of the MB rows of the first pass, when it is
+  // run on the encoding threads.
+  VP9RowSync fp_row_sync;
+  FIRSTPASS_FRAME fp_frame;
+
+  // Scratch buffer the tiles are packed in by the encoding threads, each tile
+  // taking a part proportional to its area.
+  uint8_t *tile_pack_buf;
+  size_t tile_pack_buf_size;
 
   fractional_mv_step_fp *find_fractional_mv_step;
   vp9_full_search_fn_t full_search_sad;
@@ -355,11 +390,20 @@ typedef struct VP9_COMP {
   uint64_t time_pick_lpf;
   uint64_t time_encode_sb_row;
 
+  // Per frame statistics, collected while 'frame_stats_enabled' is set.
+  // 'thread_stats' are the ones of the encoder's thread outside of the
+  // multi-threaded passes.
+  int frame_stats_enabled;
+  VP9ThreadStats thread_stats;
+  vpx_frame_stats_t frame_stats;
+
 #if CONFIG_FP_MB_STATS
   int use_fp_mb_stats;
 #endif
 
   TWO_PASS twopass;
+  // First pass run on the lookahead frames, see 'oxcf.lookahead_stats'.
+  struct VP9LookaheadStats *lookahead_stats;
 
   YV12_BUFFER_CONFIG alt_ref_buffer;
 
@@ -436,6 +480,16 @@ typedef struct VP9_COMP {
 #if CONFIG_VP9_TEMPORAL_DENOISING
   VP9_DENOISER denoiser;
 #endif
+#if CONFIG_MULTI_RES_ENCODING
+  // Source frame downscaled to the resolution of the encoder.
+  YV12_BUFFER_CONFIG mr_scaled_source;
+  // Coded frame each reference frame was last refreshed by.
+  unsigned int mr_ref_frame_ids[MAX_REF_FRAMES];
+  // Whether the lower resolution coded the current frame, and whether its
+  // motion vectors apply, per reference frame.
+  int mr_low_res_info_avail;
+  int mr_low_res_mv_avail[MAX_REF_FRAMES];
+#endif
 #if CONFIG_GPU_COMPUTE
   VP9_EGPU egpu;
 #endif
@@ -451,10 +505,12 @@ void vp9_remove_compressor(VP9_COMP *cpi);
 void vp9_change_config(VP9_COMP *cpi, const VP9EncoderConfig *oxcf);
 
   // receive a frames worth of data. caller can assume that a copy of this
-  // frame is made and not just a copy of the pointer..
+  // frame is made and not just a copy of the pointer, unless a source release
+  // callback is set: 'img', the image 'sd' was set up from, is then handed
+  // back through it once the encoder is done with the frame.
 int vp9_receive_raw_frame(VP9_COMP *cpi, unsigned int frame_flags,
-                          YV12_BUFFER_CONFIG *sd, int64_t time_stamp,
-                          int64_t end_time_stamp);
+                          YV12_BUFFER_CONFIG *sd, const vpx_image_t *img,
+                          int64_t time_stamp, int64_t end_time_stamp);
 
 int vp9_get_compressed_data(VP9_COMP *cpi, unsigned int *frame_flags,
                             size_t *size, uint8_t *dest,
@@ -514,6 +570,11 @@ static INLINE int get_token_alloc(int mb_rows, int mb_cols) {
   return mb_rows * mb_cols * (16 * 16 * 3 + 4);
 }
 
+// Sum squared error of the 'width' x 'height' pixels of 'a' and 'b'.
+int64_t vp9_get_sse(const uint8_t *a, int a_stride,
+                    const uint8_t *b, int b_stride,
+                    int width, int height);
+
 int vp9_get_y_sse(const YV12_BUFFER_CONFIG *a, const YV12_BUFFER_CONFIG *b);
 
 void vp9_alloc_compressor_data(VP9_COMP *cpi);
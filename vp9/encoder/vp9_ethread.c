@@ -14,48 +14,8 @@
 
 #include "vp9/encoder/vp9_encoder.h"
 #include "vp9/encoder/vp9_encodeframe.h"
-
-// synchronize encoder threads
-void vp9_enc_sync_read(VP9_COMP *cpi, int sb_row, int sb_col) {
-  const VP9_COMMON *const cm = &cpi->common;
-  const volatile int *const top_sb_col = cpi->cur_sb_col + (sb_row - 1);
-
-  // Check if the dependencies necessary to encode the current SB are
-  // resolved. If the dependencies are resolved encode else do a busy wait.
-  while (sb_row && !(sb_col & (cpi->sync_range - 1))) {
-    // top right dependency
-    int idx = sb_col + cpi->sync_range;
-
-    idx = MIN(idx, (cm->sb_cols - 1));
-    if (*top_sb_col >= idx)
-      break;
-    x86_pause_hint();
-    thread_sleep(0);
-  }
-}
-
-// synchronize encoder threads
-void vp9_enc_sync_write(struct VP9_COMP *cpi, int sb_row) {
-  int *const cur_sb_col = cpi->cur_sb_col + sb_row;
-
-  // update the cur sb col
-  (*cur_sb_col)++;
-}
-
-// Set up nsync by width.
-// The optimal sync_range for different resolution and platform should be
-// determined by testing. Currently, it is chosen to be a power-of-2 number.
-static int get_sync_range(int width) {
-  // TODO(ram-ittiam): nsync numbers have to be picked by testing
-  if (width < 640)
-    return 1;
-  else if (width <= 1280)
-    return 2;
-  else if (width <= 4096)
-    return 4;
-  else
-    return 8;
-}
+#include "vp9/encoder/vp9_frame_stats.h"
+#include "vp9/encoder/vp9_picklpf.h"
 
 void vp9_create_encoding_threads(VP9_COMP *cpi) {
   VP9_COMMON * const cm = &cpi->common;
@@ -69,6 +29,9 @@ void vp9_create_encoding_threads(VP9_COMP *cpi) {
     winterface->init(worker);
     CHECK_MEM_ERROR(cm, worker->data1,
                     vpx_memalign(32, sizeof(thread_context)));
+    // The fields of the thread MACROBLOCK that vp9_mb_copy() does not set,
+    // such as use_gpu, have to start cleared.
+    vpx_memset(worker->data1, 0, sizeof(thread_context));
     worker->data2 = NULL;
     if (i < cpi->max_threads - 1 && !winterface->reset(worker)) {
       vpx_internal_error(&cm->error, VPX_CODEC_ERROR,
@@ -80,12 +43,16 @@ void vp9_create_encoding_threads(VP9_COMP *cpi) {
     winterface->sync(&cpi->enc_thread_hndl[i]);
     cpi->enc_thread_hndl[i].hook = (VP9WorkerHook) encoding_thread_process;
   }
-  CHECK_MEM_ERROR(cm, cpi->cur_sb_col,
-                  vpx_malloc(sizeof(*cpi->cur_sb_col) * cm->sb_rows));
-  // init cur sb col
-  vpx_memset(cpi->cur_sb_col, -1, (sizeof(*cpi->cur_sb_col) * cm->sb_rows));
-  // set up nsync (currently unused).
-  cpi->sync_range = get_sync_range(cpi->oxcf.width);
+  vp9_row_sync_alloc(&cpi->row_sync, cm, cm->sb_rows, cpi->oxcf.width);
+  if (cpi->oxcf.pass == 1)
+    vp9_row_sync_alloc(&cpi->fp_row_sync, cm, cm->mb_rows, cpi->oxcf.width);
+
+  CHECK_MEM_ERROR(cm, cpi->sb_row_thresh_freq_fact,
+                  vpx_malloc(sizeof(*cpi->sb_row_thresh_freq_fact) *
+                             cm->sb_rows));
+  for (i = 0; i < cm->sb_rows; ++i)
+    vpx_memcpy(cpi->sb_row_thresh_freq_fact[i], cpi->rd.thresh_freq_fact,
+               sizeof(cpi->rd.thresh_freq_fact));
 }
 
 void add_up_frame_counts(VP9_COMP *cpi, MACROBLOCK *x_thread) {
@@ -244,12 +211,18 @@ static int loop_filter_row_worker(thread_context *const thread_ctxt,
   const YV12_BUFFER_CONFIG *const frame_buffer = cm->frame_to_show;
   struct macroblockd_plane planes[MAX_MB_PLANE];
   const int num_planes = thread_ctxt->y_only ? 1 : MAX_MB_PLANE;
+  VP9ThreadStats *const stats = &thread_ctxt->stats;
+  struct vpx_usec_timer pass_timer, wait_timer;
   int mi_row, mi_col;
 
   (void)unused;
+  vp9_stats_timer_start(stats, &pass_timer);
   vp9_copy(planes, xd->plane);
-  for (mi_row = thread_ctxt->mi_row_start; mi_row < thread_ctxt->mi_row_end;
-       mi_row += thread_ctxt->mi_row_step) {
+  // Take the rows one at a time, a thread that is done with its row moves on
+  // to the next free one as soon as the wavefront allows.
+  while ((mi_row = thread_ctxt->mi_row_start +
+                   vp9_row_sync_next_row(&cpi->row_sync) * MI_BLOCK_SIZE) <
+         thread_ctxt->mi_row_end) {
     const int sb_row = mi_row >> MI_BLOCK_SIZE_LOG2;
     MODE_INFO **const mi = cm->mi_grid_visible + mi_row * cm->mi_stride;
 
@@ -258,7 +231,9 @@ static int loop_filter_row_worker(thread_context *const thread_ctxt,
       LOOP_FILTER_MASK lfm;
       int plane;
 
-      vp9_enc_sync_read(cpi, sb_row, sb_col);
+      vp9_stats_timer_start(stats, &wait_timer);
+      vp9_row_sync_read(&cpi->row_sync, sb_row, sb_col);
+      vp9_stats_timer_mark(stats, &wait_timer, &stats->wait_us);
 
       vp9_setup_dst_planes(planes, frame_buffer, mi_row, mi_col);
       vp9_setup_mask(cm, mi_row, mi_col, mi + mi_col, cm->mi_stride, &lfm);
@@ -267,59 +242,47 @@ static int loop_filter_row_worker(thread_context *const thread_ctxt,
         vp9_filter_block_plane(cm, &planes[plane], mi_row, &lfm);
       }
 
-      vp9_enc_sync_write(cpi, sb_row);
+      vp9_row_sync_write(&cpi->row_sync, sb_row, sb_col, cm->sb_cols);
     }
   }
 
+  vp9_stats_timer_mark(stats, &pass_timer, &stats->pass_us);
   return 1;
 }
 
-// VP9 Encoder: Implement multi-threaded loopfilter that uses the threads
-// used for encoding.
-void vp9e_loop_filter_frame_mt(VP9_COMP *cpi, int frame_filter_level,
-                               int y_only, int partial_frame) {
+// Run 'hook' on all the encoding threads, over SB rows [start_mi_row,
+// end_mi_row) of the frame.
+static void run_loop_filter_threads(VP9_COMP *cpi, VP9WorkerHook hook,
+                                    int start_mi_row, int end_mi_row,
+                                    int y_only) {
   VP9_COMMON *const cm = &cpi->common;
-  const int sb_rows = cm->sb_rows;
   const int num_threads = cpi->max_threads;
   const VP9WorkerInterface *const winterface = vp9_get_worker_interface();
-  int thread_id;
-  int start_mi_row = 0, end_mi_row, mi_rows_to_filter = cm->mi_rows;
+  struct vpx_usec_timer timer;
+  int thread_id, i;
 
-  if (!frame_filter_level)
-      return;
-
-  // Initialize cur_sb_col to -1 for all SB rows.
-  vpx_memset(cpi->cur_sb_col, -1, sizeof(*cpi->cur_sb_col) * sb_rows);
+  vp9_stats_timer_start(&cpi->thread_stats, &timer);
 
-  if (partial_frame && cm->mi_rows > 8) {
-    int i;
-    start_mi_row = cm->mi_rows >> 1;
-    start_mi_row &= 0xfffffff8;
-    mi_rows_to_filter = MAX(cm->mi_rows / 8, 8);
+  // Mark all SB rows as not filtered.
+  vp9_row_sync_reset(&cpi->row_sync);
 
-    // Initialize cur_sb_col to sb_cols for top SB rows indicating
-    // that deblocking is done.
-    for (i = 0; i < start_mi_row >> MI_BLOCK_SIZE_LOG2; i++)
-      cpi->cur_sb_col[i] = cm->sb_cols - 1;
-  }
-  end_mi_row = start_mi_row + mi_rows_to_filter;
+  // Mark the top SB rows as filtered, they are not touched.
+  for (i = 0; i < start_mi_row >> MI_BLOCK_SIZE_LOG2; i++)
+    vp9_row_sync_write(&cpi->row_sync, i, cm->sb_cols - 1, cm->sb_cols);
 
   // Set up loopfilter thread data.
   for (thread_id = 0; thread_id < num_threads; ++thread_id) {
     VP9Worker *const worker = &cpi->enc_thread_hndl[thread_id];
     thread_context *const thread_ctxt = (thread_context *)worker->data1;
 
-    worker->hook = (VP9WorkerHook)loop_filter_row_worker;
+    worker->hook = hook;
 
     // initialize thread context
     thread_ctxt->cpi = cpi;
 
-    // thread start sb row
-    thread_ctxt->mi_row_start = start_mi_row + MI_BLOCK_SIZE * thread_id;
-    // thread end sb row
+    // rows to filter
+    thread_ctxt->mi_row_start = start_mi_row;
     thread_ctxt->mi_row_end = end_mi_row;
-    // thread step sb row
-    thread_ctxt->mi_row_step = MI_BLOCK_SIZE * cpi->max_threads;
 
     //thread id
     thread_ctxt->thread_id = thread_id;
@@ -339,4 +302,55 @@ void vp9e_loop_filter_frame_mt(VP9_COMP *cpi, int frame_filter_level,
   for (thread_id = 0; thread_id < num_threads; ++thread_id) {
     winterface->sync(&cpi->enc_thread_hndl[thread_id]);
   }
+
+  if (cpi->thread_stats.enabled) {
+    vpx_usec_timer_mark(&timer);
+    vp9_frame_stats_end_pass(cpi, VP9E_STAGE_LOOP_FILTER,
+                             vpx_usec_timer_elapsed(&timer));
+  }
+}
+
+// VP9 Encoder: Implement multi-threaded loopfilter that uses the threads
+// used for encoding.
+void vp9e_loop_filter_frame_mt(VP9_COMP *cpi, int frame_filter_level,
+                               int y_only, int partial_frame) {
+  VP9_COMMON *const cm = &cpi->common;
+  int start_mi_row = 0, mi_rows_to_filter = cm->mi_rows;
+
+  if (!frame_filter_level)
+      return;
+
+  if (partial_frame && cm->mi_rows > 8) {
+    start_mi_row = cm->mi_rows >> 1;
+    start_mi_row &= 0xfffffff8;
+    mi_rows_to_filter = MAX(cm->mi_rows / 8, 8);
+  }
+
+  run_loop_filter_threads(cpi, (VP9WorkerHook)loop_filter_row_worker,
+                          start_mi_row, start_mi_row + mi_rows_to_filter,
+                          y_only);
+}
+
+// Row-based multi-threaded hook of the loop filter level search.
+static int lpf_search_row_worker(thread_context *const thread_ctxt,
+                                 void *unused) {
+  VP9_COMP *const cpi = thread_ctxt->cpi;
+  VP9ThreadStats *const stats = &thread_ctxt->stats;
+  struct vpx_usec_timer pass_timer;
+  int mi_row;
+
+  (void)unused;
+  vp9_stats_timer_start(stats, &pass_timer);
+  while ((mi_row = thread_ctxt->mi_row_start +
+                   vp9_row_sync_next_row(&cpi->row_sync) * MI_BLOCK_SIZE) <
+         thread_ctxt->mi_row_end)
+    vp9_lpf_search_row(cpi, mi_row, stats);
+
+  vp9_stats_timer_mark(stats, &pass_timer, &stats->pass_us);
+  return 1;
+}
+
+void vp9e_lpf_search_mt(VP9_COMP *cpi, int start_mi_row, int end_mi_row) {
+  run_loop_filter_threads(cpi, (VP9WorkerHook)lpf_search_row_worker,
+                          start_mi_row, end_mi_row, 1);
 }
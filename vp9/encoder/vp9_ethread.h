@@ -63,23 +63,24 @@ typedef struct thread_context {
   // thread specific mb context
   DECLARE_ALIGNED(16, struct macroblock, mb);
 
-  // threads shall process rows of the video frame. Below params represent
-  // the list of row id's the thread processes
+  // Range of rows processed by the threads. Each thread takes the next row
+  // of the range from the shared row queue until the range is exhausted.
   int mi_row_start, mi_row_end;
-  int mi_row_step;
+
+  // Set for the data parallel analysis pass of the encoding threads.
+  int data_parallel_processing;
 
   // thread id
   int thread_id;
 
+  // Statistics of the thread for the current frame.
+  VP9ThreadStats stats;
+
   // used by loop filter threads to determine if only y plane needs to be
   // filtered or all mb planes have to be filtered
   int y_only;
 } thread_context;
 
-void vp9_enc_sync_read(struct VP9_COMP *cpi, int sb_row, int sb_col);
-
-void vp9_enc_sync_write(struct VP9_COMP *cpi, int sb_row);
-
 void vp9_create_encoding_threads(struct VP9_COMP *cpi);
 
 void add_up_frame_counts(struct VP9_COMP *cpi, struct macroblock *x_thread);
@@ -90,4 +91,9 @@ void vp9_mb_copy(struct VP9_COMP *cpi, struct macroblock *x_dst,
 void vp9e_loop_filter_frame_mt(struct VP9_COMP *cpi, int frame_filter_level,
                                int y_only, int partial_frame);
 
+// Run the current pass of the loop filter level search over SB rows
+// [start_mi_row, end_mi_row) on the encoding threads.
+void vp9e_lpf_search_mt(struct VP9_COMP *cpi, int start_mi_row,
+                        int end_mi_row);
+
 #endif /* VP9_ETHREAD_H_ */
@@ -28,7 +28,8 @@ static void copy_and_extend_plane(const uint8_t *src, int src_pitch,
 
   for (i = 0; i < h; i++) {
     vpx_memset(dst_ptr1, src_ptr1[0], extend_left);
-    vpx_memcpy(dst_ptr1 + extend_left, src_ptr1, w);
+    if (dst_ptr1 + extend_left != src_ptr1)
+      vpx_memcpy(dst_ptr1 + extend_left, src_ptr1, w);
     vpx_memset(dst_ptr2, src_ptr2[0], extend_right);
     src_ptr1 += src_pitch;
     src_ptr2 += src_pitch;
@@ -91,6 +92,15 @@ void vp9_copy_and_extend_frame(const YV12_BUFFER_CONFIG *src,
                         et_uv, el_uv, eb_uv, er_uv);
 }
 
+void vp9_extend_frame_inplace(YV12_BUFFER_CONFIG *ybf) {
+  vp9_copy_and_extend_frame(ybf, ybf);
+}
+
+int vp9_source_extension(int width, int height) {
+  return MAX(MAX(ALIGN_POWER_OF_TWO(width, 6) - width,
+                 ALIGN_POWER_OF_TWO(height, 6) - height), 16);
+}
+
 void vp9_copy_and_extend_frame_with_rect(const YV12_BUFFER_CONFIG *src,
                                          YV12_BUFFER_CONFIG *dst,
                                          int srcy, int srcx,
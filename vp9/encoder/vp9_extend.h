@@ -22,6 +22,14 @@ extern "C" {
 void vp9_copy_and_extend_frame(const YV12_BUFFER_CONFIG *src,
                                YV12_BUFFER_CONFIG *dst);
 
+// Extend the borders of 'ybf' by the same amount as
+// vp9_copy_and_extend_frame(), without copying the frame.
+void vp9_extend_frame_inplace(YV12_BUFFER_CONFIG *ybf);
+
+// Largest luma border extension vp9_copy_and_extend_frame() applies to a
+// 'width' x 'height' frame.
+int vp9_source_extension(int width, int height);
+
 void vp9_copy_and_extend_frame_with_rect(const YV12_BUFFER_CONFIG *src,
                                          YV12_BUFFER_CONFIG *dst,
                                          int srcy, int srcx,
@@ -8,9 +8,11 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <assert.h>
 #include <limits.h>
 #include <math.h>
 #include <stdio.h>
+#include <string.h>
 
 #include "./vpx_scale_rtcd.h"
 
@@ -30,6 +32,7 @@
 #include "vp9/encoder/vp9_encoder.h"
 #include "vp9/encoder/vp9_extend.h"
 #include "vp9/encoder/vp9_firstpass.h"
+#include "vp9/encoder/vp9_frame_stats.h"
 #include "vp9/encoder/vp9_mcomp.h"
 #include "vp9/encoder/vp9_quantize.h"
 #include "vp9/encoder/vp9_rd.h"
@@ -386,18 +389,436 @@ static void set_first_pass_params(VP9_COMP *cpi) {
   cpi->rc.frames_to_key = INT_MAX;
 }
 
-void vp9_first_pass(VP9_COMP *cpi, const struct lookahead_entry *source) {
-  int mb_row, mb_col;
-  MACROBLOCK *const x = &cpi->mb;
-  VP9_COMMON *const cm = &cpi->common;
-  MACROBLOCKD *const xd = &x->e_mbd;
-  TileInfo tile;
+static void set_first_pass_buffers(VP9_COMP *cpi, MACROBLOCK *x) {
   struct macroblock_plane *const p = x->plane;
-  struct macroblockd_plane *const pd = xd->plane;
+  struct macroblockd_plane *const pd = x->e_mbd.plane;
   const PICK_MODE_CONTEXT *ctx = &cpi->pc_root[x->thread_id]->none;
   int i;
 
+  for (i = 0; i < MAX_MB_PLANE; ++i) {
+    p[i].coeff = ctx->coeff_pbuf[i][1];
+    p[i].qcoeff = ctx->qcoeff_pbuf[i][1];
+    pd[i].dqcoeff = ctx->dqcoeff_pbuf[i][1];
+    p[i].eobs = ctx->eobs_pbuf[i][1];
+  }
+  x->skip_recode = 0;
+}
+
+// Analyze MB row 'mb_row' of the frame into its statistics. The motion
+// vector predictors do not cross rows, so a row only depends on the
+// reconstruction of the row above: with 'row_sync', each MB waits for the
+// MBs above it to be reconstructed.
+static void first_pass_row(VP9_COMP *cpi, MACROBLOCK *x, int mb_row,
+                           VP9RowSync *row_sync) {
+  VP9_COMMON *const cm = &cpi->common;
+  MACROBLOCKD *const xd = &x->e_mbd;
+  const FIRSTPASS_FRAME *const fp = &cpi->fp_frame;
+  FIRSTPASS_ROW_STATS *const stats = &fp->row_stats[mb_row];
+  const YV12_BUFFER_CONFIG *const first_ref_buf = fp->first_ref_buf;
+  const YV12_BUFFER_CONFIG *const gld_yv12 = fp->gld_yv12;
+  YV12_BUFFER_CONFIG *const new_yv12 = fp->new_yv12;
+  const int uv_mb_height = fp->uv_mb_height;
+  const int intrapenalty = 256;
+  const MV zero_mv = {0, 0};
+  MV best_ref_mv = {0, 0};
   int recon_yoffset, recon_uvoffset;
+  struct vpx_usec_timer wait_timer;
+  TileInfo tile;
+  int mb_col;
+
+  vp9_zero(*stats);
+
+  // Tiling is ignored in the first pass.
+  vp9_tile_init(&tile, cm, 0, 0);
+
+  vp9_setup_src_planes(x, cpi->Source, 0, 0);
+  x->plane[0].src.buf += mb_row * 16 * x->plane[0].src.stride;
+  x->plane[1].src.buf += mb_row * uv_mb_height * x->plane[1].src.stride;
+  x->plane[2].src.buf += mb_row * uv_mb_height * x->plane[1].src.stride;
+
+  // Reset above block coeffs.
+  xd->up_available = (mb_row != 0);
+  recon_yoffset = (mb_row * fp->recon_y_stride * 16);
+  recon_uvoffset = (mb_row * fp->recon_uv_stride * uv_mb_height);
+
+  // Set up limit values for motion vectors to prevent them extending
+  // outside the UMV borders.
+  x->mv_row_min = -((mb_row * 16) + BORDER_MV_PIXELS_B16);
+  x->mv_row_max = ((cm->mb_rows - 1 - mb_row) * 16)
+                  + BORDER_MV_PIXELS_B16;
+
+  for (mb_col = 0; mb_col < cm->mb_cols; ++mb_col) {
+    int this_error;
+    const int use_dc_pred = (mb_col || mb_row) && (!mb_col || !mb_row);
+    double error_weight = 1.0;
+    const BLOCK_SIZE bsize = get_bsize(cm, mb_row, mb_col);
+#if CONFIG_FP_MB_STATS
+    const int mb_index = mb_row * cm->mb_cols + mb_col;
+#endif
+
+    if (row_sync != NULL) {
+      vp9_stats_timer_start(x->stats, &wait_timer);
+      vp9_row_sync_read(row_sync, mb_row, mb_col);
+      vp9_stats_timer_mark(x->stats, &wait_timer, &x->stats->wait_us);
+    }
+
+    vp9_clear_system_state();
+
+    xd->plane[0].dst.buf = new_yv12->y_buffer + recon_yoffset;
+    xd->plane[1].dst.buf = new_yv12->u_buffer + recon_uvoffset;
+    xd->plane[2].dst.buf = new_yv12->v_buffer + recon_uvoffset;
+    xd->left_available = (mb_col != 0);
+    xd->mi[0]->mbmi.sb_type = bsize;
+    xd->mi[0]->mbmi.ref_frame[0] = INTRA_FRAME;
+    set_mi_row_col(xd, &tile,
+                   mb_row << 1, num_8x8_blocks_high_lookup[bsize],
+                   mb_col << 1, num_8x8_blocks_wide_lookup[bsize],
+                   cm->mi_rows, cm->mi_cols);
+
+    if (cpi->oxcf.aq_mode == VARIANCE_AQ) {
+      const int energy = vp9_block_energy(cpi, x, bsize);
+      error_weight = vp9_vaq_inv_q_ratio(energy);
+    }
+
+    // Do intra 16x16 prediction.
+    x->skip_encode = 0;
+    xd->mi[0]->mbmi.mode = DC_PRED;
+    xd->mi[0]->mbmi.tx_size = use_dc_pred ?
+       (bsize >= BLOCK_16X16 ? TX_16X16 : TX_8X8) : TX_4X4;
+    vp9_encode_intra_block_plane(x, bsize, 0);
+    this_error = vp9_get_mb_ss(x->plane[0].src_diff);
+
+    if (cpi->oxcf.aq_mode == VARIANCE_AQ) {
+      vp9_clear_system_state();
+      this_error = (int)(this_error * error_weight);
+    }
+
+    // Intrapenalty below deals with situations where the intra and inter
+    // error scores are very low (e.g. a plain black frame).
+    // We do not have special cases in first pass for 0,0 and nearest etc so
+    // all inter modes carry an overhead cost estimate for the mv.
+    // When the error score is very low this causes us to pick all or lots of
+    // INTRA modes and throw lots of key frames.
+    // This penalty adds a cost matching that of a 0,0 mv to the intra case.
+    this_error += intrapenalty;
+
+    // Accumulate the intra error.
+    stats->intra_error += (int64_t)this_error;
+
+#if CONFIG_FP_MB_STATS
+    if (cpi->use_fp_mb_stats) {
+      // initialization
+      cpi->twopass.frame_mb_stats_buf[mb_index] = 0;
+    }
+#endif
+
+    // Set up limit values for motion vectors to prevent them extending
+    // outside the UMV borders.
+    x->mv_col_min = -((mb_col * 16) + BORDER_MV_PIXELS_B16);
+    x->mv_col_max = ((cm->mb_cols - 1 - mb_col) * 16) + BORDER_MV_PIXELS_B16;
+
+    // Other than for the first frame do a motion search.
+    if (fp->motion_search) {
+      int tmp_err, motion_error, raw_motion_error;
+      // Assume 0,0 motion with no mv overhead.
+      MV mv = {0, 0} , tmp_mv = {0, 0};
+      struct buf_2d unscaled_last_source_buf_2d;
+
+      xd->plane[0].pre[0].buf = first_ref_buf->y_buffer + recon_yoffset;
+      motion_error = get_prediction_error(bsize, &x->plane[0].src,
+                                          &xd->plane[0].pre[0]);
+
+      // Compute the motion error of the 0,0 motion using the last source
+      // frame as the reference. Skip the further motion search on
+      // reconstructed frame if this error is small.
+      unscaled_last_source_buf_2d.buf =
+          cpi->unscaled_last_source->y_buffer + recon_yoffset;
+      unscaled_last_source_buf_2d.stride =
+          cpi->unscaled_last_source->y_stride;
+      raw_motion_error = get_prediction_error(bsize, &x->plane[0].src,
+                                              &unscaled_last_source_buf_2d);
+
+      // TODO(pengchong): Replace the hard-coded threshold
+      if (raw_motion_error > 25 || fp->full_search) {
+        // Test last reference frame using the previous best mv as the
+        // starting point (best reference) for the search.
+        first_pass_motion_search(cpi, x, &best_ref_mv, &mv, &motion_error);
+        if (cpi->oxcf.aq_mode == VARIANCE_AQ) {
+          vp9_clear_system_state();
+          motion_error = (int)(motion_error * error_weight);
+        }
+
+        // If the current best reference mv is not centered on 0,0 then do a
+        // 0,0 based search as well.
+        if (!is_zero_mv(&best_ref_mv)) {
+          tmp_err = INT_MAX;
+          first_pass_motion_search(cpi, x, &zero_mv, &tmp_mv, &tmp_err);
+          if (cpi->oxcf.aq_mode == VARIANCE_AQ) {
+            vp9_clear_system_state();
+            tmp_err = (int)(tmp_err * error_weight);
+          }
+
+          if (tmp_err < motion_error) {
+            motion_error = tmp_err;
+            mv = tmp_mv;
+          }
+        }
+
+        // Search in an older reference frame.
+        if (gld_yv12 != NULL) {
+          // Assume 0,0 motion with no mv overhead.
+          int gf_motion_error;
+
+          xd->plane[0].pre[0].buf = gld_yv12->y_buffer + recon_yoffset;
+          gf_motion_error = get_prediction_error(bsize, &x->plane[0].src,
+                                                 &xd->plane[0].pre[0]);
+
+          first_pass_motion_search(cpi, x, &zero_mv, &tmp_mv,
+                                   &gf_motion_error);
+          if (cpi->oxcf.aq_mode == VARIANCE_AQ) {
+            vp9_clear_system_state();
+            gf_motion_error = (int)(gf_motion_error * error_weight);
+          }
+
+          if (gf_motion_error < motion_error && gf_motion_error < this_error)
+            ++stats->second_ref_count;
+
+          // Reset to last frame as reference buffer.
+          xd->plane[0].pre[0].buf = first_ref_buf->y_buffer + recon_yoffset;
+          xd->plane[1].pre[0].buf = first_ref_buf->u_buffer + recon_uvoffset;
+          xd->plane[2].pre[0].buf = first_ref_buf->v_buffer + recon_uvoffset;
+
+          // In accumulating a score for the older reference frame take the
+          // best of the motion predicted score and the intra coded error
+          // (just as will be done for) accumulation of "coded_error" for
+          // the last frame.
+          if (gf_motion_error < this_error)
+            stats->sr_coded_error += gf_motion_error;
+          else
+            stats->sr_coded_error += this_error;
+        } else {
+          stats->sr_coded_error += motion_error;
+        }
+      } else {
+        stats->sr_coded_error += motion_error;
+      }
+
+      // Start by assuming that intra mode is best.
+      best_ref_mv.row = 0;
+      best_ref_mv.col = 0;
+
+#if CONFIG_FP_MB_STATS
+      if (cpi->use_fp_mb_stats) {
+        // intra predication statistics
+        cpi->twopass.frame_mb_stats_buf[mb_index] = 0;
+        cpi->twopass.frame_mb_stats_buf[mb_index] |= FPMB_DCINTRA_MASK;
+        cpi->twopass.frame_mb_stats_buf[mb_index] |= FPMB_MOTION_ZERO_MASK;
+        if (this_error > FPMB_ERROR_LARGE_TH) {
+          cpi->twopass.frame_mb_stats_buf[mb_index] |= FPMB_ERROR_LARGE_MASK;
+        } else if (this_error < FPMB_ERROR_SMALL_TH) {
+          cpi->twopass.frame_mb_stats_buf[mb_index] |= FPMB_ERROR_SMALL_MASK;
+        }
+      }
+#endif
+
+      if (motion_error <= this_error) {
+        // Keep a count of cases where the inter and intra were very close
+        // and very low. This helps with scene cut detection for example in
+        // cropped clips with black bars at the sides or top and bottom.
+        if (((this_error - intrapenalty) * 9 <= motion_error * 10) &&
+            this_error < 2 * intrapenalty)
+          ++stats->neutral_count;
+
+        mv.row *= 8;
+        mv.col *= 8;
+        this_error = motion_error;
+        xd->mi[0]->mbmi.mode = NEWMV;
+        xd->mi[0]->mbmi.mv[0].as_mv = mv;
+        xd->mi[0]->mbmi.tx_size = TX_4X4;
+        xd->mi[0]->mbmi.ref_frame[0] = LAST_FRAME;
+        xd->mi[0]->mbmi.ref_frame[1] = NONE;
+        vp9_build_inter_predictors_sby(xd, mb_row << 1, mb_col << 1, bsize);
+        vp9_encode_sby_pass1(x, bsize);
+        stats->sum_mvr += mv.row;
+        stats->sum_mvr_abs += abs(mv.row);
+        stats->sum_mvc += mv.col;
+        stats->sum_mvc_abs += abs(mv.col);
+        stats->sum_mvrs += mv.row * mv.row;
+        stats->sum_mvcs += mv.col * mv.col;
+        ++stats->intercount;
+
+        best_ref_mv = mv;
+
+#if CONFIG_FP_MB_STATS
+        if (cpi->use_fp_mb_stats) {
+          // inter predication statistics
+          cpi->twopass.frame_mb_stats_buf[mb_index] = 0;
+          cpi->twopass.frame_mb_stats_buf[mb_index] &= ~FPMB_DCINTRA_MASK;
+          cpi->twopass.frame_mb_stats_buf[mb_index] |= FPMB_MOTION_ZERO_MASK;
+          if (this_error > FPMB_ERROR_LARGE_TH) {
+            cpi->twopass.frame_mb_stats_buf[mb_index] |=
+                FPMB_ERROR_LARGE_MASK;
+          } else if (this_error < FPMB_ERROR_SMALL_TH) {
+            cpi->twopass.frame_mb_stats_buf[mb_index] |=
+                FPMB_ERROR_SMALL_MASK;
+          }
+        }
+#endif
+
+        if (!is_zero_mv(&mv)) {
+          if (++stats->mvcount == 1)
+            stats->first_mv = mv;
+
+#if CONFIG_FP_MB_STATS
+          if (cpi->use_fp_mb_stats) {
+            cpi->twopass.frame_mb_stats_buf[mb_index] &=
+                ~FPMB_MOTION_ZERO_MASK;
+            // check estimated motion direction
+            if (mv.as_mv.col > 0 && mv.as_mv.col >= abs(mv.as_mv.row)) {
+              // right direction
+              cpi->twopass.frame_mb_stats_buf[mb_index] |=
+                  FPMB_MOTION_RIGHT_MASK;
+            } else if (mv.as_mv.row < 0 &&
+                       abs(mv.as_mv.row) >= abs(mv.as_mv.col)) {
+              // up direction
+              cpi->twopass.frame_mb_stats_buf[mb_index] |=
+                  FPMB_MOTION_UP_MASK;
+            } else if (mv.as_mv.col < 0 &&
+                       abs(mv.as_mv.col) >= abs(mv.as_mv.row)) {
+              // left direction
+              cpi->twopass.frame_mb_stats_buf[mb_index] |=
+                  FPMB_MOTION_LEFT_MASK;
+            } else {
+              // down direction
+              cpi->twopass.frame_mb_stats_buf[mb_index] |=
+                  FPMB_MOTION_DOWN_MASK;
+            }
+          }
+#endif
+
+          // Non-zero vector, was it different from the last non zero vector?
+          if (!is_equal_mv(&mv, &stats->last_mv))
+            ++stats->new_mv_count;
+          stats->last_mv = mv;
+
+          // Does the row vector point inwards or outwards?
+          if (mb_row < cm->mb_rows / 2) {
+            if (mv.row > 0)
+              --stats->sum_in_vectors;
+            else if (mv.row < 0)
+              ++stats->sum_in_vectors;
+          } else if (mb_row > cm->mb_rows / 2) {
+            if (mv.row > 0)
+              ++stats->sum_in_vectors;
+            else if (mv.row < 0)
+              --stats->sum_in_vectors;
+          }
+
+          // Does the col vector point inwards or outwards?
+          if (mb_col < cm->mb_cols / 2) {
+            if (mv.col > 0)
+              --stats->sum_in_vectors;
+            else if (mv.col < 0)
+              ++stats->sum_in_vectors;
+          } else if (mb_col > cm->mb_cols / 2) {
+            if (mv.col > 0)
+              ++stats->sum_in_vectors;
+            else if (mv.col < 0)
+              --stats->sum_in_vectors;
+          }
+        }
+      }
+    } else {
+      stats->sr_coded_error += (int64_t)this_error;
+    }
+    stats->coded_error += (int64_t)this_error;
+
+    if (row_sync != NULL)
+      vp9_row_sync_write(row_sync, mb_row, mb_col, cm->mb_cols);
+
+    // Adjust to the next column of MBs.
+    x->plane[0].src.buf += 16;
+    x->plane[1].src.buf += uv_mb_height;
+    x->plane[2].src.buf += uv_mb_height;
+
+    recon_yoffset += 16;
+    recon_uvoffset += uv_mb_height;
+  }
+
+  vp9_clear_system_state();
+}
+
+// Row-based multi-threaded hook of the first pass.
+static int first_pass_thread_process(thread_context *const thread_ctxt,
+                                     void *unused) {
+  VP9_COMP *const cpi = thread_ctxt->cpi;
+  const VP9_COMMON *const cm = &cpi->common;
+  MACROBLOCK *const x = &thread_ctxt->mb;
+  // The mode info of the MBs is only used while they are analyzed, each
+  // thread keeps its own. The fields the first pass does not set are taken
+  // from the shared one.
+  MODE_INFO mi = *cm->mi;
+  MODE_INFO *mi_ptr = &mi;
+  struct vpx_usec_timer timer;
+  int mb_row;
+
+  (void)unused;
+  vp9_stats_timer_start(&thread_ctxt->stats, &timer);
+  vp9_mb_copy(cpi, x, &cpi->mb);
+  x->thread_id = thread_ctxt->thread_id;
+  x->stats = &thread_ctxt->stats;
+  x->e_mbd.mi = &mi_ptr;
+  set_first_pass_buffers(cpi, x);
+
+  while ((mb_row = vp9_row_sync_next_row(&cpi->fp_row_sync)) < cm->mb_rows)
+    first_pass_row(cpi, x, mb_row, &cpi->fp_row_sync);
+
+  vp9_stats_timer_mark(x->stats, &timer, &x->stats->pass_us);
+  return 1;
+}
+
+static void run_first_pass_threads(VP9_COMP *cpi) {
+  const VP9WorkerInterface *const winterface = vp9_get_worker_interface();
+  struct vpx_usec_timer timer;
+  int thread_id;
+
+  vp9_stats_timer_start(&cpi->thread_stats, &timer);
+
+  // Mark all MB rows as not analyzed.
+  vp9_row_sync_reset(&cpi->fp_row_sync);
+
+  for (thread_id = 0; thread_id < cpi->max_threads; ++thread_id) {
+    VP9Worker *const worker = &cpi->enc_thread_hndl[thread_id];
+    thread_context *const thread_ctxt = (thread_context *)worker->data1;
+
+    worker->hook = (VP9WorkerHook)first_pass_thread_process;
+    thread_ctxt->cpi = cpi;
+    thread_ctxt->thread_id = thread_id;
+
+    if (thread_id == cpi->max_threads - 1)
+      winterface->execute(worker);
+    else
+      winterface->launch(worker);
+  }
+
+  // Wait till all rows are finished
+  for (thread_id = 0; thread_id < cpi->max_threads; ++thread_id)
+    winterface->sync(&cpi->enc_thread_hndl[thread_id]);
+
+  if (cpi->thread_stats.enabled) {
+    vpx_usec_timer_mark(&timer);
+    vp9_frame_stats_end_pass(cpi, VP9E_STAGE_ENCODE,
+                             vpx_usec_timer_elapsed(&timer));
+  }
+}
+
+void vp9_first_pass(VP9_COMP *cpi, const struct lookahead_entry *source) {
+  int mb_row;
+  MACROBLOCK *const x = &cpi->mb;
+  VP9_COMMON *const cm = &cpi->common;
+  MACROBLOCKD *const xd = &x->e_mbd;
+  FIRSTPASS_FRAME *const fp = &cpi->fp_frame;
+
   YV12_BUFFER_CONFIG *const lst_yv12 = get_ref_frame_buffer(cpi, LAST_FRAME);
   YV12_BUFFER_CONFIG *gld_yv12 = get_ref_frame_buffer(cpi, GOLDEN_FRAME);
   YV12_BUFFER_CONFIG *const new_yv12 = get_frame_new_buffer(cm);
@@ -414,13 +835,11 @@ void vp9_first_pass(VP9_COMP *cpi, const struct lookahead_entry *source) {
   int mvcount = 0;
   int intercount = 0;
   int second_ref_count = 0;
-  int intrapenalty = 256;
   int neutral_count = 0;
   int new_mv_count = 0;
   int sum_in_vectors = 0;
   MV lastmv = {0, 0};
   TWO_PASS *twopass = &cpi->twopass;
-  const MV zero_mv = {0, 0};
   const YV12_BUFFER_CONFIG *first_ref_buf = lst_yv12;
   LAYER_CONTEXT *const lc = is_two_pass_svc(cpi) ?
         &cpi->svc.layer_context[cpi->svc.spatial_layer_id] : NULL;
@@ -498,333 +917,60 @@ void vp9_first_pass(VP9_COMP *cpi, const struct lookahead_entry *source) {
 
   vp9_frame_init_quantizer(cpi, x);
 
-  for (i = 0; i < MAX_MB_PLANE; ++i) {
-    p[i].coeff = ctx->coeff_pbuf[i][1];
-    p[i].qcoeff = ctx->qcoeff_pbuf[i][1];
-    pd[i].dqcoeff = ctx->dqcoeff_pbuf[i][1];
-    p[i].eobs = ctx->eobs_pbuf[i][1];
-  }
-  x->skip_recode = 0;
+  set_first_pass_buffers(cpi, x);
 
   vp9_init_mv_probs(cm);
   vp9_initialize_rd_consts(cpi);
 
-  // Tiling is ignored in the first pass.
-  vp9_tile_init(&tile, cm, 0, 0);
+  fp->first_ref_buf = first_ref_buf;
+  fp->new_yv12 = new_yv12;
+  fp->recon_y_stride = recon_y_stride;
+  fp->recon_uv_stride = recon_uv_stride;
+  fp->uv_mb_height = uv_mb_height;
+  fp->motion_search = lc == NULL ? cm->current_video_frame > 0
+                                 : lc->current_video_frame_in_layer > 0;
+  fp->full_search = lc != NULL;
+  // Other than for the first two frames search in an older reference frame.
+  fp->gld_yv12 = (lc == NULL ? cm->current_video_frame > 1
+                             : lc->current_video_frame_in_layer > 1) ?
+                 gld_yv12 : NULL;
+
+  // The rows of spatial layers may outnumber the rows the synchronization
+  // was allocated with.
+  if (cpi->max_threads > 1 && cm->mb_rows <= cpi->fp_row_sync.rows) {
+    run_first_pass_threads(cpi);
+  } else {
+    for (mb_row = 0; mb_row < cm->mb_rows; ++mb_row)
+      first_pass_row(cpi, x, mb_row, NULL);
+  }
 
+  // Sum up the rows in raster order. The count of new motion vectors is the
+  // only statistic that carries over from a row to the next: the first
+  // non-zero vector of a row is not new if it is the last one of the rows
+  // above.
   for (mb_row = 0; mb_row < cm->mb_rows; ++mb_row) {
-    MV best_ref_mv = {0, 0};
-
-    // Reset above block coeffs.
-    xd->up_available = (mb_row != 0);
-    recon_yoffset = (mb_row * recon_y_stride * 16);
-    recon_uvoffset = (mb_row * recon_uv_stride * uv_mb_height);
-
-    // Set up limit values for motion vectors to prevent them extending
-    // outside the UMV borders.
-    x->mv_row_min = -((mb_row * 16) + BORDER_MV_PIXELS_B16);
-    x->mv_row_max = ((cm->mb_rows - 1 - mb_row) * 16)
-                    + BORDER_MV_PIXELS_B16;
-
-    for (mb_col = 0; mb_col < cm->mb_cols; ++mb_col) {
-      int this_error;
-      const int use_dc_pred = (mb_col || mb_row) && (!mb_col || !mb_row);
-      double error_weight = 1.0;
-      const BLOCK_SIZE bsize = get_bsize(cm, mb_row, mb_col);
-#if CONFIG_FP_MB_STATS
-      const int mb_index = mb_row * cm->mb_cols + mb_col;
-#endif
-
-      vp9_clear_system_state();
-
-      xd->plane[0].dst.buf = new_yv12->y_buffer + recon_yoffset;
-      xd->plane[1].dst.buf = new_yv12->u_buffer + recon_uvoffset;
-      xd->plane[2].dst.buf = new_yv12->v_buffer + recon_uvoffset;
-      xd->left_available = (mb_col != 0);
-      xd->mi[0]->mbmi.sb_type = bsize;
-      xd->mi[0]->mbmi.ref_frame[0] = INTRA_FRAME;
-      set_mi_row_col(xd, &tile,
-                     mb_row << 1, num_8x8_blocks_high_lookup[bsize],
-                     mb_col << 1, num_8x8_blocks_wide_lookup[bsize],
-                     cm->mi_rows, cm->mi_cols);
-
-      if (cpi->oxcf.aq_mode == VARIANCE_AQ) {
-        const int energy = vp9_block_energy(cpi, x, bsize);
-        error_weight = vp9_vaq_inv_q_ratio(energy);
-      }
-
-      // Do intra 16x16 prediction.
-      x->skip_encode = 0;
-      xd->mi[0]->mbmi.mode = DC_PRED;
-      xd->mi[0]->mbmi.tx_size = use_dc_pred ?
-         (bsize >= BLOCK_16X16 ? TX_16X16 : TX_8X8) : TX_4X4;
-      vp9_encode_intra_block_plane(x, bsize, 0);
-      this_error = vp9_get_mb_ss(x->plane[0].src_diff);
-
-      if (cpi->oxcf.aq_mode == VARIANCE_AQ) {
-        vp9_clear_system_state();
-        this_error = (int)(this_error * error_weight);
-      }
-
-      // Intrapenalty below deals with situations where the intra and inter
-      // error scores are very low (e.g. a plain black frame).
-      // We do not have special cases in first pass for 0,0 and nearest etc so
-      // all inter modes carry an overhead cost estimate for the mv.
-      // When the error score is very low this causes us to pick all or lots of
-      // INTRA modes and throw lots of key frames.
-      // This penalty adds a cost matching that of a 0,0 mv to the intra case.
-      this_error += intrapenalty;
-
-      // Accumulate the intra error.
-      intra_error += (int64_t)this_error;
-
-#if CONFIG_FP_MB_STATS
-      if (cpi->use_fp_mb_stats) {
-        // initialization
-        cpi->twopass.frame_mb_stats_buf[mb_index] = 0;
-      }
-#endif
-
-      // Set up limit values for motion vectors to prevent them extending
-      // outside the UMV borders.
-      x->mv_col_min = -((mb_col * 16) + BORDER_MV_PIXELS_B16);
-      x->mv_col_max = ((cm->mb_cols - 1 - mb_col) * 16) + BORDER_MV_PIXELS_B16;
-
-      // Other than for the first frame do a motion search.
-      if ((lc == NULL && cm->current_video_frame > 0) ||
-          (lc != NULL && lc->current_video_frame_in_layer > 0)) {
-        int tmp_err, motion_error, raw_motion_error;
-        // Assume 0,0 motion with no mv overhead.
-        MV mv = {0, 0} , tmp_mv = {0, 0};
-        struct buf_2d unscaled_last_source_buf_2d;
-
-        xd->plane[0].pre[0].buf = first_ref_buf->y_buffer + recon_yoffset;
-        motion_error = get_prediction_error(bsize, &x->plane[0].src,
-                                            &xd->plane[0].pre[0]);
-
-        // Compute the motion error of the 0,0 motion using the last source
-        // frame as the reference. Skip the further motion search on
-        // reconstructed frame if this error is small.
-        unscaled_last_source_buf_2d.buf =
-            cpi->unscaled_last_source->y_buffer + recon_yoffset;
-        unscaled_last_source_buf_2d.stride =
-            cpi->unscaled_last_source->y_stride;
-        raw_motion_error = get_prediction_error(bsize, &x->plane[0].src,
-                                                &unscaled_last_source_buf_2d);
-
-        // TODO(pengchong): Replace the hard-coded threshold
-        if (raw_motion_error > 25 || lc != NULL) {
-          // Test last reference frame using the previous best mv as the
-          // starting point (best reference) for the search.
-          first_pass_motion_search(cpi, x, &best_ref_mv, &mv, &motion_error);
-          if (cpi->oxcf.aq_mode == VARIANCE_AQ) {
-            vp9_clear_system_state();
-            motion_error = (int)(motion_error * error_weight);
-          }
-
-          // If the current best reference mv is not centered on 0,0 then do a
-          // 0,0 based search as well.
-          if (!is_zero_mv(&best_ref_mv)) {
-            tmp_err = INT_MAX;
-            first_pass_motion_search(cpi, x, &zero_mv, &tmp_mv, &tmp_err);
-            if (cpi->oxcf.aq_mode == VARIANCE_AQ) {
-              vp9_clear_system_state();
-              tmp_err = (int)(tmp_err * error_weight);
-            }
-
-            if (tmp_err < motion_error) {
-              motion_error = tmp_err;
-              mv = tmp_mv;
-            }
-          }
-
-          // Search in an older reference frame.
-          if (((lc == NULL && cm->current_video_frame > 1) ||
-               (lc != NULL && lc->current_video_frame_in_layer > 1))
-              && gld_yv12 != NULL) {
-            // Assume 0,0 motion with no mv overhead.
-            int gf_motion_error;
-
-            xd->plane[0].pre[0].buf = gld_yv12->y_buffer + recon_yoffset;
-            gf_motion_error = get_prediction_error(bsize, &x->plane[0].src,
-                                                   &xd->plane[0].pre[0]);
-
-            first_pass_motion_search(cpi, x, &zero_mv, &tmp_mv,
-                                     &gf_motion_error);
-            if (cpi->oxcf.aq_mode == VARIANCE_AQ) {
-              vp9_clear_system_state();
-              gf_motion_error = (int)(gf_motion_error * error_weight);
-            }
-
-            if (gf_motion_error < motion_error && gf_motion_error < this_error)
-              ++second_ref_count;
-
-            // Reset to last frame as reference buffer.
-            xd->plane[0].pre[0].buf = first_ref_buf->y_buffer + recon_yoffset;
-            xd->plane[1].pre[0].buf = first_ref_buf->u_buffer + recon_uvoffset;
-            xd->plane[2].pre[0].buf = first_ref_buf->v_buffer + recon_uvoffset;
-
-            // In accumulating a score for the older reference frame take the
-            // best of the motion predicted score and the intra coded error
-            // (just as will be done for) accumulation of "coded_error" for
-            // the last frame.
-            if (gf_motion_error < this_error)
-              sr_coded_error += gf_motion_error;
-            else
-              sr_coded_error += this_error;
-          } else {
-            sr_coded_error += motion_error;
-          }
-        } else {
-          sr_coded_error += motion_error;
-        }
-
-        // Start by assuming that intra mode is best.
-        best_ref_mv.row = 0;
-        best_ref_mv.col = 0;
-
-#if CONFIG_FP_MB_STATS
-        if (cpi->use_fp_mb_stats) {
-          // intra predication statistics
-          cpi->twopass.frame_mb_stats_buf[mb_index] = 0;
-          cpi->twopass.frame_mb_stats_buf[mb_index] |= FPMB_DCINTRA_MASK;
-          cpi->twopass.frame_mb_stats_buf[mb_index] |= FPMB_MOTION_ZERO_MASK;
-          if (this_error > FPMB_ERROR_LARGE_TH) {
-            cpi->twopass.frame_mb_stats_buf[mb_index] |= FPMB_ERROR_LARGE_MASK;
-          } else if (this_error < FPMB_ERROR_SMALL_TH) {
-            cpi->twopass.frame_mb_stats_buf[mb_index] |= FPMB_ERROR_SMALL_MASK;
-          }
-        }
-#endif
-
-        if (motion_error <= this_error) {
-          // Keep a count of cases where the inter and intra were very close
-          // and very low. This helps with scene cut detection for example in
-          // cropped clips with black bars at the sides or top and bottom.
-          if (((this_error - intrapenalty) * 9 <= motion_error * 10) &&
-              this_error < 2 * intrapenalty)
-            ++neutral_count;
-
-          mv.row *= 8;
-          mv.col *= 8;
-          this_error = motion_error;
-          xd->mi[0]->mbmi.mode = NEWMV;
-          xd->mi[0]->mbmi.mv[0].as_mv = mv;
-          xd->mi[0]->mbmi.tx_size = TX_4X4;
-          xd->mi[0]->mbmi.ref_frame[0] = LAST_FRAME;
-          xd->mi[0]->mbmi.ref_frame[1] = NONE;
-          vp9_build_inter_predictors_sby(xd, mb_row << 1, mb_col << 1, bsize);
-          vp9_encode_sby_pass1(x, bsize);
-          sum_mvr += mv.row;
-          sum_mvr_abs += abs(mv.row);
-          sum_mvc += mv.col;
-          sum_mvc_abs += abs(mv.col);
-          sum_mvrs += mv.row * mv.row;
-          sum_mvcs += mv.col * mv.col;
-          ++intercount;
-
-          best_ref_mv = mv;
-
-#if CONFIG_FP_MB_STATS
-          if (cpi->use_fp_mb_stats) {
-            // inter predication statistics
-            cpi->twopass.frame_mb_stats_buf[mb_index] = 0;
-            cpi->twopass.frame_mb_stats_buf[mb_index] &= ~FPMB_DCINTRA_MASK;
-            cpi->twopass.frame_mb_stats_buf[mb_index] |= FPMB_MOTION_ZERO_MASK;
-            if (this_error > FPMB_ERROR_LARGE_TH) {
-              cpi->twopass.frame_mb_stats_buf[mb_index] |=
-                  FPMB_ERROR_LARGE_MASK;
-            } else if (this_error < FPMB_ERROR_SMALL_TH) {
-              cpi->twopass.frame_mb_stats_buf[mb_index] |=
-                  FPMB_ERROR_SMALL_MASK;
-            }
-          }
-#endif
-
-          if (!is_zero_mv(&mv)) {
-            ++mvcount;
-
-#if CONFIG_FP_MB_STATS
-            if (cpi->use_fp_mb_stats) {
-              cpi->twopass.frame_mb_stats_buf[mb_index] &=
-                  ~FPMB_MOTION_ZERO_MASK;
-              // check estimated motion direction
-              if (mv.as_mv.col > 0 && mv.as_mv.col >= abs(mv.as_mv.row)) {
-                // right direction
-                cpi->twopass.frame_mb_stats_buf[mb_index] |=
-                    FPMB_MOTION_RIGHT_MASK;
-              } else if (mv.as_mv.row < 0 &&
-                         abs(mv.as_mv.row) >= abs(mv.as_mv.col)) {
-                // up direction
-                cpi->twopass.frame_mb_stats_buf[mb_index] |=
-                    FPMB_MOTION_UP_MASK;
-              } else if (mv.as_mv.col < 0 &&
-                         abs(mv.as_mv.col) >= abs(mv.as_mv.row)) {
-                // left direction
-                cpi->twopass.frame_mb_stats_buf[mb_index] |=
-                    FPMB_MOTION_LEFT_MASK;
-              } else {
-                // down direction
-                cpi->twopass.frame_mb_stats_buf[mb_index] |=
-                    FPMB_MOTION_DOWN_MASK;
-              }
-            }
-#endif
-
-            // Non-zero vector, was it different from the last non zero vector?
-            if (!is_equal_mv(&mv, &lastmv))
-              ++new_mv_count;
-            lastmv = mv;
-
-            // Does the row vector point inwards or outwards?
-            if (mb_row < cm->mb_rows / 2) {
-              if (mv.row > 0)
-                --sum_in_vectors;
-              else if (mv.row < 0)
-                ++sum_in_vectors;
-            } else if (mb_row > cm->mb_rows / 2) {
-              if (mv.row > 0)
-                ++sum_in_vectors;
-              else if (mv.row < 0)
-                --sum_in_vectors;
-            }
-
-            // Does the col vector point inwards or outwards?
-            if (mb_col < cm->mb_cols / 2) {
-              if (mv.col > 0)
-                --sum_in_vectors;
-              else if (mv.col < 0)
-                ++sum_in_vectors;
-            } else if (mb_col > cm->mb_cols / 2) {
-              if (mv.col > 0)
-                ++sum_in_vectors;
-              else if (mv.col < 0)
-                --sum_in_vectors;
-            }
-          }
-        }
-      } else {
-        sr_coded_error += (int64_t)this_error;
-      }
-      coded_error += (int64_t)this_error;
-
-      // Adjust to the next column of MBs.
-      x->plane[0].src.buf += 16;
-      x->plane[1].src.buf += uv_mb_height;
-      x->plane[2].src.buf += uv_mb_height;
-
-      recon_yoffset += 16;
-      recon_uvoffset += uv_mb_height;
+    const FIRSTPASS_ROW_STATS *const stats = &fp->row_stats[mb_row];
+
+    intra_error += stats->intra_error;
+    coded_error += stats->coded_error;
+    sr_coded_error += stats->sr_coded_error;
+    sum_mvr += stats->sum_mvr;
+    sum_mvc += stats->sum_mvc;
+    sum_mvr_abs += stats->sum_mvr_abs;
+    sum_mvc_abs += stats->sum_mvc_abs;
+    sum_mvrs += stats->sum_mvrs;
+    sum_mvcs += stats->sum_mvcs;
+    intercount += stats->intercount;
+    second_ref_count += stats->second_ref_count;
+    neutral_count += stats->neutral_count;
+    sum_in_vectors += stats->sum_in_vectors;
+    if (stats->mvcount > 0) {
+      mvcount += stats->mvcount;
+      new_mv_count += stats->new_mv_count;
+      if (is_equal_mv(&stats->first_mv, &lastmv))
+        --new_mv_count;
+      lastmv = stats->last_mv;
     }
-
-    // Adjust to the next row of MBs.
-    x->plane[0].src.buf += 16 * x->plane[0].src.stride - 16 * cm->mb_cols;
-    x->plane[1].src.buf += uv_mb_height * x->plane[1].src.stride -
-                           uv_mb_height * cm->mb_cols;
-    x->plane[2].src.buf += uv_mb_height * x->plane[1].src.stride -
-                           uv_mb_height * cm->mb_cols;
-
-    vp9_clear_system_state();
   }
 
   vp9_clear_system_state();
@@ -1069,6 +1215,82 @@ void vp9_init_second_pass(VP9_COMP *cpi) {
   cpi->rc.vbr_bits_off_target = 0;
 }
 
+void vp9_init_lookahead_second_pass(VP9_COMP *cpi,
+                                    FIRSTPASS_STATS *buf, int buf_size) {
+  TWO_PASS *const twopass = &cpi->twopass;
+
+  zero_stats(&twopass->total_stats);
+  zero_stats(&twopass->total_left_stats);
+
+  twopass->stats_buf = buf;
+  twopass->stats_buf_size = buf_size;
+  twopass->stats_in_start = buf;
+  twopass->stats_in = buf;
+  twopass->stats_in_end = buf;
+  twopass->stats_in_open = 1;
+
+  // The bits and the error of each frame are added up as its statistics are
+  // appended.
+  twopass->bits_left = 0;
+  twopass->modified_error_left = 0.0;
+  twopass->kf_group_open = 0;
+  twopass->kf_bits_share = 0;
+
+  twopass->kf_intra_err_min = KF_MB_INTRA_MIN * cpi->common.MBs;
+  twopass->gf_intra_err_min = GF_MB_INTRA_MIN * cpi->common.MBs;
+  twopass->sr_update_lag = 1;
+
+  cpi->rc.vbr_bits_off_target = 0;
+}
+
+void vp9_append_lookahead_stats(VP9_COMP *cpi, const FIRSTPASS_STATS *stats) {
+  TWO_PASS *const twopass = &cpi->twopass;
+  const VP9EncoderConfig *const oxcf = &cpi->oxcf;
+  double avg_error;
+  double mod_frame_err;
+  int64_t frame_bits;
+
+  // Make room for the frame once the window is full, keeping the statistics
+  // of the frames the gf group may read backwards.
+  if (twopass->stats_in_end == twopass->stats_buf + twopass->stats_buf_size) {
+    const FIRSTPASS_STATS *const keep =
+        twopass->stats_in - MAX_LAG_BUFFERS > twopass->stats_buf ?
+            twopass->stats_in - MAX_LAG_BUFFERS : twopass->stats_buf;
+    const ptrdiff_t shift = keep - twopass->stats_buf;
+
+    assert(shift > 0);
+    memmove(twopass->stats_buf, keep,
+            (twopass->stats_in_end - keep) * sizeof(*keep));
+    twopass->stats_in -= shift;
+    twopass->stats_in_end -= shift;
+  }
+  twopass->stats_buf[twopass->stats_in_end - twopass->stats_buf] = *stats;
+  ++twopass->stats_in_end;
+
+  accumulate_stats(&twopass->total_stats, stats);
+  accumulate_stats(&twopass->total_left_stats, stats);
+
+  avg_error = twopass->total_stats.coded_error /
+              DOUBLE_DIVIDE_CHECK(twopass->total_stats.count);
+  twopass->modified_error_min = (avg_error *
+                                    oxcf->two_pass_vbrmin_section) / 100;
+  twopass->modified_error_max = (avg_error *
+                                    oxcf->two_pass_vbrmax_section) / 100;
+  mod_frame_err = calculate_modified_err(twopass, oxcf, stats);
+
+  frame_bits = (int64_t)(stats->duration * oxcf->target_bandwidth /
+                         10000000.0);
+  twopass->bits_left += frame_bits;
+
+  // A frame of the open kf group brings its share of bits to the group.
+  if (twopass->kf_group_open && stats->frame < twopass->kf_group_end) {
+    twopass->kf_group_bits += frame_bits - twopass->kf_bits_share;
+    twopass->kf_group_error_left += (int64_t)mod_frame_err;
+  } else {
+    twopass->modified_error_left += mod_frame_err;
+  }
+}
+
 // This function gives an estimate of how badly we believe the prediction
 // quality is decaying from frame to frame.
 static double get_prediction_decay_rate(const VP9_COMMON *cm,
@@ -1677,8 +1899,12 @@ static void define_gf_group(VP9_COMP *cpi, FIRSTPASS_STATS *this_frame) {
     while (i < (rc->frames_to_key + !rc->next_key_frame_forced)) {
       ++i;
 
-      if (EOF == input_stats(twopass, this_frame))
+      if (EOF == input_stats(twopass, this_frame)) {
+        // Only count the frames the lookahead already has the stats of.
+        if (twopass->stats_in_open)
+          --i;
         break;
+      }
 
       if (i < rc->frames_to_key) {
         mod_frame_err = calculate_modified_err(twopass, oxcf, this_frame);
@@ -1693,6 +1919,11 @@ static void define_gf_group(VP9_COMP *cpi, FIRSTPASS_STATS *this_frame) {
   else
     rc->baseline_gf_interval = i;
 
+  // The lookahead can run out of stats before the next key frame, the group
+  // still has to hold a frame.
+  if (twopass->stats_in_open)
+    rc->baseline_gf_interval = MAX(rc->baseline_gf_interval, 1);
+
   // Only encode alt reference frame in temporal base layer. So
   // baseline_gf_interval should be multiple of a temporal layer group
   // (typically the frame distance between two base layer frames)
@@ -1876,6 +2107,8 @@ static void find_next_key_frame(VP9_COMP *cpi, FIRSTPASS_STATS *this_frame) {
   double kf_mod_err = 0.0;
   double kf_group_err = 0.0;
   double recent_loop_decay[8] = {1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0};
+  int kf_found = 0;
+  int kf_group_open;
 
   vp9_zero(next_frame);
 
@@ -1919,8 +2152,10 @@ static void find_next_key_frame(VP9_COMP *cpi, FIRSTPASS_STATS *this_frame) {
 
       // Check for a scene cut.
       if (test_candidate_kf(twopass, &last_frame, this_frame,
-                            twopass->stats_in))
+                            twopass->stats_in)) {
+        kf_found = 1;
         break;
+      }
 
       // How fast is the prediction quality decaying?
       loop_decay_rate = get_prediction_decay_rate(&cpi->common,
@@ -1937,8 +2172,10 @@ static void find_next_key_frame(VP9_COMP *cpi, FIRSTPASS_STATS *this_frame) {
       // Special check for transition or high motion followed by a
       // static scene.
       if (detect_transition_to_still(twopass, i, cpi->oxcf.key_freq - i,
-                                     loop_decay_rate, decay_accumulator))
+                                     loop_decay_rate, decay_accumulator)) {
+        kf_found = 1;
         break;
+      }
 
       // Step on to the next frame.
       ++rc->frames_to_key;
@@ -1953,6 +2190,11 @@ static void find_next_key_frame(VP9_COMP *cpi, FIRSTPASS_STATS *this_frame) {
     ++i;
   }
 
+  // Running out of statistics before the next key frame is only the end of
+  // the window when more frames are to come.
+  kf_group_open = twopass->stats_in_open && !kf_found &&
+                  rc->frames_to_key < cpi->oxcf.key_freq;
+
   // If there is a max kf interval set by the user we must obey it.
   // We already breakout of the loop above at 2x max.
   // This code centers the extra kf if the actual natural interval
@@ -2079,10 +2321,24 @@ static void find_next_key_frame(VP9_COMP *cpi, FIRSTPASS_STATS *this_frame) {
   if (rc->kf_boost   < MIN_KF_BOOST)
     rc->kf_boost = MIN_KF_BOOST;
 
-  kf_bits = calculate_boost_bits((rc->frames_to_key - 1),
-                                  rc->kf_boost, twopass->kf_group_bits);
-
-  twopass->kf_group_bits -= kf_bits;
+  if (kf_group_open) {
+    // The frames of the group past the window are expected at the average
+    // rate. Each frame of the group pays an even share of the key frame's
+    // boost, the frames of the window now and the others as they come.
+    const int frames_after = cpi->oxcf.key_freq - rc->frames_to_key;
+    kf_bits = calculate_boost_bits(cpi->oxcf.key_freq - 1, rc->kf_boost,
+        twopass->kf_group_bits +
+            (int64_t)frames_after * rc->avg_frame_bandwidth);
+    twopass->kf_bits_share = MAX(kf_bits - rc->avg_frame_bandwidth, 0) /
+                             (cpi->oxcf.key_freq - 1);
+    twopass->kf_group_bits -= rc->avg_frame_bandwidth +
+        (int64_t)(rc->frames_to_key - 1) * twopass->kf_bits_share;
+  } else {
+    kf_bits = calculate_boost_bits((rc->frames_to_key - 1),
+                                    rc->kf_boost, twopass->kf_group_bits);
+    twopass->kf_bits_share = 0;
+    twopass->kf_group_bits -= kf_bits;
+  }
 
   // Save the bits to spend on the key frame.
   gf_group->bit_allocation[0] = kf_bits;
@@ -2096,6 +2352,73 @@ static void find_next_key_frame(VP9_COMP *cpi, FIRSTPASS_STATS *this_frame) {
   // The count of bits left is adjusted elsewhere based on real coded frame
   // sizes.
   twopass->modified_error_left -= kf_group_err;
+
+  // The bits of the group are set from the frames of the window, the group
+  // then takes in the frames appended until it reaches the maximum interval
+  // or a scene cut is found in them.
+  twopass->kf_group_open = kf_group_open;
+  if (kf_group_open)
+    rc->frames_to_key = cpi->oxcf.key_freq;
+  twopass->kf_group_end = (int)first_frame.frame + rc->frames_to_key;
+}
+
+// Look for a scene cut in the frames appended to the window since the open kf
+// group was defined, and end the group there.
+static void find_lookahead_scene_cut(VP9_COMP *cpi,
+                                     const FIRSTPASS_STATS *this_frame) {
+  RATE_CONTROL *const rc = &cpi->rc;
+  TWO_PASS *const twopass = &cpi->twopass;
+  const VP9EncoderConfig *const oxcf = &cpi->oxcf;
+  const FIRSTPASS_STATS *const start_pos = twopass->stats_in;
+  const FIRSTPASS_STATS *const prev_frame = read_frame_stats(twopass, -2);
+  FIRSTPASS_STATS last_frame;
+  FIRSTPASS_STATS frame = *this_frame;
+  int frames_to_cut = 0;
+
+  if (!oxcf->auto_key || prev_frame == NULL)
+    return;
+
+  // An arf overlay is coded from the same source as the arf, it can't start
+  // the next kf group.
+  last_frame = *prev_frame;
+  if (rc->source_alt_ref_active) {
+    last_frame = frame;
+    if (EOF == input_stats(twopass, &frame))
+      return;
+    ++frames_to_cut;
+  }
+
+  while (frames_to_cut < rc->frames_to_key &&
+         twopass->stats_in < twopass->stats_in_end) {
+    if (test_candidate_kf(twopass, &last_frame, &frame, twopass->stats_in)) {
+      const FIRSTPASS_STATS *s;
+      double cut_err = 0.0;
+
+      // Move the frames from the cut on out of the kf group, along with
+      // their share of its bits.
+      for (s = start_pos - 1 + frames_to_cut; s < twopass->stats_in_end; ++s) {
+        if (s->frame < twopass->kf_group_end)
+          cut_err += calculate_modified_err(twopass, oxcf, s);
+      }
+      if (twopass->kf_group_error_left > 0)
+        twopass->kf_group_bits -= (int64_t)(twopass->kf_group_bits *
+            MIN(cut_err / twopass->kf_group_error_left, 1.0));
+      twopass->kf_group_error_left =
+          MAX(twopass->kf_group_error_left - (int64_t)cut_err, 0);
+      twopass->modified_error_left += cut_err;
+
+      rc->frames_to_key = frames_to_cut;
+      rc->next_key_frame_forced = 0;
+      twopass->kf_group_open = 0;
+      twopass->kf_group_end = (int)frame.frame;
+      break;
+    }
+    last_frame = frame;
+    input_stats(twopass, &frame);
+    ++frames_to_cut;
+  }
+
+  reset_fpf_position(twopass, start_pos);
 }
 
 // For VBR...adjustment to the frame target based on error from previous frames
@@ -2233,6 +2556,12 @@ void vp9_rc_get_second_pass_params(VP9_COMP *cpi) {
     twopass->active_worst_quality = tmp_q;
     rc->ni_av_qi = tmp_q;
     rc->avg_q = vp9_convert_qindex_to_q(tmp_q, cm->bit_depth);
+  } else if (twopass->stats_in_open && rc->frames_till_gf_update_due == 0) {
+    // The statistics only reach the end of the window, the worst quality
+    // follows them from one gf group to the next.
+    twopass->active_worst_quality =
+        get_twopass_worst_quality(cpi, &twopass->total_left_stats,
+                                  rc->avg_frame_bandwidth);
   }
   vp9_zero(this_frame);
   if (EOF == input_stats(twopass, &this_frame))
@@ -2241,6 +2570,12 @@ void vp9_rc_get_second_pass_params(VP9_COMP *cpi) {
   // Local copy of the current frame's first pass stats.
   this_frame_copy = this_frame;
 
+  // A new gf group may start with a scene cut seen since the kf group was
+  // defined.
+  if (twopass->kf_group_open && rc->frames_to_key > 0 &&
+      rc->frames_till_gf_update_due == 0)
+    find_lookahead_scene_cut(cpi, &this_frame);
+
   // Keyframe and section processing.
   if (rc->frames_to_key == 0 ||
       (cpi->frame_flags & FRAMEFLAGS_KEY)) {
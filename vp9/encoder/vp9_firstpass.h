@@ -11,6 +11,8 @@
 #ifndef VP9_ENCODER_VP9_FIRSTPASS_H_
 #define VP9_ENCODER_VP9_FIRSTPASS_H_
 
+#include "vp9/common/vp9_mv.h"
+
 #include "vp9/encoder/vp9_lookahead.h"
 #include "vp9/encoder/vp9_ratectrl.h"
 
@@ -61,6 +63,46 @@ typedef struct {
   int64_t spatial_layer_id;
 } FIRSTPASS_STATS;
 
+// Statistics of a MB row of the first pass. The rows are analyzed on their
+// own and summed up in raster order into the statistics of the frame, so
+// that these do not depend on the number of threads.
+typedef struct {
+  int64_t intra_error;
+  int64_t coded_error;
+  int64_t sr_coded_error;
+  int sum_mvr, sum_mvc;
+  int sum_mvr_abs, sum_mvc_abs;
+  int64_t sum_mvrs, sum_mvcs;
+  int mvcount;
+  int intercount;
+  int second_ref_count;
+  int neutral_count;
+  int new_mv_count;
+  int sum_in_vectors;
+  // First and last non-zero motion vectors of the row. The first one is
+  // counted as new in 'new_mv_count'.
+  MV first_mv;
+  MV last_mv;
+} FIRSTPASS_ROW_STATS;
+
+// Setup of the first pass of the current frame, shared by the threads
+// analyzing its MB rows.
+typedef struct {
+  const YV12_BUFFER_CONFIG *first_ref_buf;
+  // Older reference searched on top of 'first_ref_buf', NULL if none is.
+  const YV12_BUFFER_CONFIG *gld_yv12;
+  YV12_BUFFER_CONFIG *new_yv12;
+  int recon_y_stride;
+  int recon_uv_stride;
+  int uv_mb_height;
+  // Set when the frame is searched for motion.
+  int motion_search;
+  // Set to search all MBs for motion, whatever their error on the source.
+  int full_search;
+  // Statistics of each MB row, allocated with the frame size.
+  FIRSTPASS_ROW_STATS *row_stats;
+} FIRSTPASS_FRAME;
+
 typedef enum {
   KF_UPDATE = 0,
   LF_UPDATE = 1,
@@ -87,6 +129,11 @@ typedef struct {
   const FIRSTPASS_STATS *stats_in;
   const FIRSTPASS_STATS *stats_in_start;
   const FIRSTPASS_STATS *stats_in_end;
+  // Window the statistics are appended to as the frames are pushed into the
+  // lookahead, while 'stats_in_open' is set more of them are to come.
+  FIRSTPASS_STATS *stats_buf;
+  int stats_buf_size;
+  int stats_in_open;
   FIRSTPASS_STATS total_left_stats;
   int first_pass_done;
   int64_t bits_left;
@@ -107,6 +154,13 @@ typedef struct {
 
   // Error score of frames still to be coded in kf group
   int64_t kf_group_error_left;
+
+  // Set while the kf group extends beyond the statistics window, up to the
+  // frame numbered 'kf_group_end'.
+  int kf_group_open;
+  int kf_group_end;
+  // Bits each frame appended to the open kf group pays towards its key frame.
+  int kf_bits_share;
   int sr_update_lag;
 
   int kf_zeromotion_pct;
@@ -127,6 +181,13 @@ void vp9_end_first_pass(struct VP9_COMP *cpi);
 void vp9_init_second_pass(struct VP9_COMP *cpi);
 void vp9_rc_get_second_pass_params(struct VP9_COMP *cpi);
 
+// Start the second pass over statistics appended to the 'buf_size' entries
+// of 'buf' by vp9_append_lookahead_stats().
+void vp9_init_lookahead_second_pass(struct VP9_COMP *cpi,
+                                    FIRSTPASS_STATS *buf, int buf_size);
+void vp9_append_lookahead_stats(struct VP9_COMP *cpi,
+                                const FIRSTPASS_STATS *stats);
+
 // Post encode update of the rate control parameters for 2-pass
 void vp9_twopass_postencode_update(struct VP9_COMP *cpi);
 #ifdef __cplusplus
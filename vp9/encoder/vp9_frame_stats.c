@@ -0,0 +1,120 @@
+/*
+ *  Copyright (c) 2014 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "vp9/encoder/vp9_encoder.h"
+#include "vp9/encoder/vp9_ethread.h"
+#include "vp9/encoder/vp9_frame_stats.h"
+
+static int get_num_threads(const VP9_COMP *cpi) {
+  return cpi->max_threads > 1 ? cpi->max_threads : 0;
+}
+
+static VP9ThreadStats *get_thread_stats(VP9_COMP *cpi, int i) {
+  thread_context *const thread_ctxt =
+      (thread_context *)cpi->enc_thread_hndl[i].data1;
+  return &thread_ctxt->stats;
+}
+
+static void reset_thread_stats(VP9ThreadStats *stats, int enabled) {
+  vp9_zero(*stats);
+  stats->enabled = enabled;
+}
+
+void vp9_frame_stats_start(VP9_COMP *cpi) {
+  const int num_threads = get_num_threads(cpi);
+  int i;
+
+  vp9_zero(cpi->frame_stats);
+  cpi->frame_stats.threads = MIN(MAX(num_threads, 1), VP9E_STATS_MAX_THREADS);
+  reset_thread_stats(&cpi->thread_stats, cpi->frame_stats_enabled);
+  for (i = 0; i < num_threads; ++i)
+    reset_thread_stats(get_thread_stats(cpi, i), cpi->frame_stats_enabled);
+}
+
+void vp9_frame_stats_end_pass(VP9_COMP *cpi, enum vp9e_stage stage,
+                              int64_t wall_us) {
+  vpx_stage_time_t *const time = &cpi->frame_stats.stages[stage];
+  const int num_threads = get_num_threads(cpi);
+  int i;
+
+  if (!cpi->frame_stats_enabled)
+    return;
+
+  // The pass is accounted by the caller as if it was run by a single thread.
+  time->busy_us -= wall_us;
+  for (i = 0; i < num_threads; ++i) {
+    VP9ThreadStats *const stats = get_thread_stats(cpi, i);
+    const int64_t busy_us = stats->pass_us - stats->wait_us;
+    time->busy_us += busy_us;
+    if (i < VP9E_STATS_MAX_THREADS)
+      cpi->frame_stats.thread_idle_us[i] += wall_us - busy_us;
+    stats->pass_us = 0;
+    stats->wait_us = 0;
+  }
+}
+
+void vp9_frame_stats_add_stage(VP9_COMP *cpi, enum vp9e_stage stage,
+                               int64_t wall_us) {
+  vpx_stage_time_t *const time = &cpi->frame_stats.stages[stage];
+
+  if (cpi->frame_stats_enabled) {
+    time->wall_us += wall_us;
+    time->busy_us += wall_us;
+  }
+}
+
+void vp9_frame_stats_mark_stage(VP9_COMP *cpi, enum vp9e_stage stage,
+                                struct vpx_usec_timer *timer) {
+  if (cpi->frame_stats_enabled) {
+    vpx_usec_timer_mark(timer);
+    vp9_frame_stats_add_stage(cpi, stage, vpx_usec_timer_elapsed(timer));
+  }
+}
+
+static void add_thread_stats(vpx_frame_stats_t *frame_stats,
+                             const VP9ThreadStats *stats) {
+  int stage;
+
+  for (stage = 0; stage < VP9E_STAGE_COUNT; ++stage)
+    frame_stats->stages[stage].busy_us += stats->stage_us[stage];
+  frame_stats->sad_calls += stats->sad_calls;
+  frame_stats->subpel_searches += stats->subpel_searches;
+  frame_stats->rd_evals += stats->rd_evals;
+}
+
+void vp9_frame_stats_end(VP9_COMP *cpi, int64_t frame_us) {
+  const int num_threads = get_num_threads(cpi);
+  int i;
+
+  if (!cpi->frame_stats_enabled)
+    return;
+
+  cpi->frame_stats.frame_us = frame_us;
+  add_thread_stats(&cpi->frame_stats, &cpi->thread_stats);
+  for (i = 0; i < num_threads; ++i)
+    add_thread_stats(&cpi->frame_stats, get_thread_stats(cpi, i));
+}
+
+void vp9_frame_stats_accumulate(vpx_frame_stats_t *dst,
+                                const vpx_frame_stats_t *src) {
+  int i;
+
+  dst->frame_us += src->frame_us;
+  for (i = 0; i < VP9E_STAGE_COUNT; ++i) {
+    dst->stages[i].wall_us += src->stages[i].wall_us;
+    dst->stages[i].busy_us += src->stages[i].busy_us;
+  }
+  dst->threads = MAX(dst->threads, src->threads);
+  for (i = 0; i < VP9E_STATS_MAX_THREADS; ++i)
+    dst->thread_idle_us[i] += src->thread_idle_us[i];
+  dst->sad_calls += src->sad_calls;
+  dst->subpel_searches += src->subpel_searches;
+  dst->rd_evals += src->rd_evals;
+}
@@ -0,0 +1,93 @@
+/*
+ *  Copyright (c) 2014 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef VP9_ENCODER_VP9_FRAME_STATS_H_
+#define VP9_ENCODER_VP9_FRAME_STATS_H_
+
+#include "vpx/vp8cx.h"
+#include "vpx_ports/vpx_timer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Statistics of a thread for the current frame. Each encoding thread updates
+// its own, they are summed up into the frame's once the frame is coded.
+typedef struct VP9ThreadStats {
+  // Set when the statistics of the frame are collected.
+  int enabled;
+  // Busy time of the stages timed block by block.
+  int64_t stage_us[VP9E_STAGE_COUNT];
+  // Time spent in the current multi-threaded pass, and part of it spent
+  // waiting on the other threads.
+  int64_t pass_us;
+  int64_t wait_us;
+  uint64_t sad_calls;
+  uint64_t subpel_searches;
+  uint64_t rd_evals;
+} VP9ThreadStats;
+
+struct VP9_COMP;
+
+static INLINE void vp9_stats_timer_start(const VP9ThreadStats *stats,
+                                         struct vpx_usec_timer *timer) {
+  if (stats->enabled)
+    vpx_usec_timer_start(timer);
+}
+
+// Add the time elapsed since vp9_stats_timer_start() to 'time_us'.
+static INLINE void vp9_stats_timer_mark(const VP9ThreadStats *stats,
+                                        struct vpx_usec_timer *timer,
+                                        int64_t *time_us) {
+  if (stats->enabled) {
+    vpx_usec_timer_mark(timer);
+    *time_us += vpx_usec_timer_elapsed(timer);
+  }
+}
+
+// Add 'count' to one of the counters of 'stats'. The searches count their
+// events locally and add them once, so nothing is written when the
+// statistics are not collected.
+static INLINE void vp9_stats_count(VP9ThreadStats *stats, uint64_t *counter,
+                                   int count) {
+  if (stats->enabled)
+    *counter += count;
+}
+
+// Reset the statistics of all the threads for a new frame.
+void vp9_frame_stats_start(struct VP9_COMP *cpi);
+
+// Account for a multi-threaded pass of 'stage' that took 'wall_us': the time
+// each thread did not spend working on it is idle time.
+void vp9_frame_stats_end_pass(struct VP9_COMP *cpi, enum vp9e_stage stage,
+                              int64_t wall_us);
+
+// Account for 'wall_us' spent in 'stage' by the encoder's thread, on top of
+// the multi-threaded passes of the stage.
+void vp9_frame_stats_add_stage(struct VP9_COMP *cpi, enum vp9e_stage stage,
+                               int64_t wall_us);
+
+// Account for the time elapsed since 'timer' was started with
+// vp9_stats_timer_start() on the encoder's thread statistics.
+void vp9_frame_stats_mark_stage(struct VP9_COMP *cpi, enum vp9e_stage stage,
+                                struct vpx_usec_timer *timer);
+
+// Sum up the statistics of the threads into the frame's.
+void vp9_frame_stats_end(struct VP9_COMP *cpi, int64_t frame_us);
+
+// Add the statistics of 'src' to 'dst', for frames returned together.
+void vp9_frame_stats_accumulate(vpx_frame_stats_t *dst,
+                                const vpx_frame_stats_t *src);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // VP9_ENCODER_VP9_FRAME_STATS_H_
@@ -31,6 +31,36 @@ static struct lookahead_entry *pop(struct lookahead_ctx *ctx,
   return buf;
 }
 
+/* Hand the application's image of the entry back and restore its buffer */
+static void release_ext_frame(struct lookahead_ctx *ctx,
+                              struct lookahead_entry *buf) {
+  if (buf->ext_frame) {
+    buf->img = buf->own_img;
+    buf->ext_frame = 0;
+    ctx->release.cb(ctx->release.cb_priv, &buf->ext_src);
+  }
+}
+
+/* Whether the entry can reference 'src' instead of a copy of it: the frame
+ * has to have the layout of the entry's buffer, and room for the extension.
+ */
+static int can_reference_frame(const struct lookahead_ctx *ctx,
+                               const YV12_BUFFER_CONFIG *src,
+                               const YV12_BUFFER_CONFIG *dst) {
+  return ctx->use_ext_frames &&
+         src->y_crop_width == dst->y_crop_width &&
+         src->y_crop_height == dst->y_crop_height &&
+         src->uv_width == dst->uv_crop_width &&
+         src->uv_height == dst->uv_crop_height &&
+         src->y_stride == dst->y_stride &&
+         src->uv_stride == dst->uv_stride &&
+         !((uintptr_t)src->y_buffer & 15) &&
+         !((uintptr_t)src->u_buffer & 15) &&
+         !((uintptr_t)src->v_buffer & 15) &&
+         ctx->release.border >=
+             vp9_source_extension(src->y_width, src->y_height);
+}
+
 
 void vp9_lookahead_destroy(VP9_COMMON *cm, struct lookahead_ctx *ctx) {
   (void) cm;
@@ -39,6 +69,7 @@ void vp9_lookahead_destroy(VP9_COMMON *cm, struct lookahead_ctx *ctx) {
       unsigned int i;
 
       for (i = 0; i < ctx->max_sz; i++) {
+        release_ext_frame(ctx, &ctx->buf[i]);
 #if CONFIG_GPU_COMPUTE
         if (cm->use_gpu)
           vp9_gpu_free_frame_buffer(cm, &ctx->buf[i].img);
@@ -119,7 +150,8 @@ struct lookahead_ctx *vp9_lookahead_init(VP9_COMMON *cm,
 #define USE_PARTIAL_COPY 0
 
 int vp9_lookahead_push(struct lookahead_ctx *ctx, YV12_BUFFER_CONFIG   *src,
-                       int64_t ts_start, int64_t ts_end, unsigned int flags) {
+                       const vpx_image_t *img, int64_t ts_start,
+                       int64_t ts_end, unsigned int flags) {
   struct lookahead_entry *buf;
 #if USE_PARTIAL_COPY
   int row, col, active_end;
@@ -131,6 +163,8 @@ int vp9_lookahead_push(struct lookahead_ctx *ctx, YV12_BUFFER_CONFIG   *src,
     return 1;
   ctx->sz++;
   buf = pop(ctx, &ctx->write_idx);
+  // The entry was the last one kept behind the current frame.
+  release_ext_frame(ctx, buf);
 
 #if USE_PARTIAL_COPY
   // TODO(jkoleszar): This is disabled for now, as
@@ -179,8 +213,21 @@ int vp9_lookahead_push(struct lookahead_ctx *ctx, YV12_BUFFER_CONFIG   *src,
     vp9_copy_and_extend_frame(src, &buf->img);
   }
 #else
-  // Partial copy not implemented yet
-  vp9_copy_and_extend_frame(src, &buf->img);
+  if (img != NULL && ctx->release.cb != NULL &&
+      can_reference_frame(ctx, src, &buf->img)) {
+    buf->own_img = buf->img;
+    buf->img.y_buffer = src->y_buffer;
+    buf->img.u_buffer = src->u_buffer;
+    buf->img.v_buffer = src->v_buffer;
+    buf->ext_src = *img;
+    buf->ext_frame = 1;
+    vp9_extend_frame_inplace(src);
+  } else {
+    // Partial copy not implemented yet
+    vp9_copy_and_extend_frame(src, &buf->img);
+    if (img != NULL && ctx->release.cb != NULL)
+      ctx->release.cb(ctx->release.cb_priv, img);
+  }
 #endif
 
   buf->ts_start = ts_start;
@@ -197,6 +244,15 @@ struct lookahead_entry *vp9_lookahead_pop(struct lookahead_ctx *ctx,
   if (ctx->sz && (drain || ctx->sz == ctx->max_sz - MAX_PRE_FRAMES)) {
     buf = pop(ctx, &ctx->read_idx);
     ctx->sz--;
+
+    // Release the frame that just left the frames kept behind 'buf', unless
+    // its entry is in use again.
+    if (ctx->sz + MAX_PRE_FRAMES + 2 <= ctx->max_sz) {
+      int index = (int)ctx->read_idx - MAX_PRE_FRAMES - 2;
+      if (index < 0)
+        index += ctx->max_sz;
+      release_ext_frame(ctx, &ctx->buf[index]);
+    }
   }
   return buf;
 }
@@ -12,10 +12,10 @@
 #define VP9_ENCODER_VP9_LOOKAHEAD_H_
 
 #include "vpx_scale/yv12config.h"
+#include "vpx/vp8cx.h"
 #include "vpx/vpx_integer.h"
 
 #if CONFIG_SPATIAL_SVC
-#include "vpx/vp8cx.h"
 #include "vpx/vpx_encoder.h"
 #endif
 
@@ -31,6 +31,12 @@ struct lookahead_entry {
   int64_t             ts_end;
   unsigned int        flags;
 
+  // Set while 'img' refers to the pixels of the application's image
+  // 'ext_src', the buffer of the entry is kept in 'own_img' meanwhile.
+  int                 ext_frame;
+  vpx_image_t         ext_src;
+  YV12_BUFFER_CONFIG  own_img;
+
 #if CONFIG_SPATIAL_SVC
   vpx_svc_parameters_t svc_params[VPX_SS_MAX_LAYERS];
 #endif
@@ -45,6 +51,8 @@ struct lookahead_ctx {
   unsigned int read_idx;       /* Read index */
   unsigned int write_idx;      /* Write index */
   struct lookahead_entry *buf; /* Buffer list */
+  vpx_source_release_cb_t release; /* Release of the application's images */
+  int use_ext_frames;          /* Whether images may be referenced */
 };
 
 struct VP9Common;
@@ -75,18 +83,25 @@ void vp9_lookahead_destroy(struct VP9Common *cm, struct lookahead_ctx *ctx);
  * This function will copy the source image into a new framebuffer with
  * the expected stride/border.
  *
+ * If a release callback is set, 'img' is the application's image 'src' was
+ * set up from. When its layout allows it, the entry references the image
+ * rather than a copy of it, and the image is released once the entry leaves
+ * the queue. Copied images are released right away.
+ *
  * If active_map is non-NULL and there is only one frame in the queue, then copy
  * only active macroblocks.
  *
  * \param[in] ctx         Pointer to the lookahead context
  * \param[in] src         Pointer to the image to enqueue
+ * \param[in] img         Application image of 'src', may be NULL
  * \param[in] ts_start    Timestamp for the start of this frame
  * \param[in] ts_end      Timestamp for the end of this frame
  * \param[in] flags       Flags set on this frame
  * \param[in] active_map  Map that specifies which macroblock is active
  */
 int vp9_lookahead_push(struct lookahead_ctx *ctx, YV12_BUFFER_CONFIG *src,
-                       int64_t ts_start, int64_t ts_end, unsigned int flags);
+                       const vpx_image_t *img, int64_t ts_start,
+                       int64_t ts_end, unsigned int flags);
 
 
 /**\brief Get the next source buffer to encode
@@ -0,0 +1,186 @@
+/*
+ *  Copyright (c) 2014 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "vpx/internal/vpx_codec_internal.h"
+#include "vpx_mem/vpx_mem.h"
+
+#include "vp9/common/vp9_thread.h"
+
+#include "vp9/encoder/vp9_encoder.h"
+#include "vp9/encoder/vp9_firstpass.h"
+#include "vp9/encoder/vp9_lookahead.h"
+#include "vp9/encoder/vp9_lookahead_stats.h"
+#if CONFIG_MULTI_RES_ENCODING
+#include "vp9/encoder/vp9_multi_res.h"
+#endif
+
+// The window holds the statistics of the lookahead frames, and of the frames
+// already coded the gf group may still read backwards.
+#define STATS_WINDOW_SIZE (4 * MAX_LAG_BUFFERS)
+
+typedef struct VP9LookaheadStats {
+  // Encoder running the first pass, and the list its statistics are output
+  // to.
+  VP9_COMP *cpi;
+  vpx_codec_pkt_list_decl(4) pkt_list;
+  VP9Worker worker;
+  // Frame the worker runs the first pass on, NULL when there is none.
+  struct lookahead_entry *source;
+#if CONFIG_MULTI_RES_ENCODING
+  // Without an encoder, the statistics are read from the lowest resolution,
+  // up to the frames pushed into the lookahead, whose complexity they are
+  // scaled to.
+  unsigned int num_pushed;
+  unsigned int num_appended;
+  double complexity[MR_STATS_SIZE];
+#endif
+  FIRSTPASS_STATS window[STATS_WINDOW_SIZE];
+} VP9LookaheadStats;
+
+static int first_pass_worker_hook(void *arg1, void *arg2) {
+  VP9LookaheadStats *const stats = (VP9LookaheadStats *)arg1;
+  struct lookahead_entry *const source = (struct lookahead_entry *)arg2;
+  unsigned int frame_flags = 0;
+  size_t size = 0;
+  int64_t time_stamp, time_end;
+
+  vpx_codec_pkt_list_init(&stats->pkt_list);
+  if (vp9_receive_raw_frame(stats->cpi, source->flags, &source->img, NULL,
+                            source->ts_start, source->ts_end))
+    return 0;
+
+  // Without lag the frame is analyzed right away.
+  return !vp9_get_compressed_data(stats->cpi, &frame_flags, &size, NULL,
+                                  &time_stamp, &time_end, 0);
+}
+
+VP9LookaheadStats *vp9_lookahead_stats_create(VP9_COMP *cpi) {
+  const VP9WorkerInterface *const winterface = vp9_get_worker_interface();
+  VP9LookaheadStats *const stats = vpx_calloc(1, sizeof(*stats));
+  VP9EncoderConfig oxcf = cpi->oxcf;
+
+  if (stats == NULL)
+    return NULL;
+
+#if CONFIG_MULTI_RES_ENCODING
+  if (vp9_mr_reads_stats(cpi)) {
+    vp9_init_lookahead_second_pass(cpi, stats->window, STATS_WINDOW_SIZE);
+    return stats;
+  }
+#endif
+
+  oxcf.pass = 1;
+  oxcf.lag_in_frames = 0;
+  oxcf.lookahead_stats = 0;
+  oxcf.threads = 0;
+  oxcf.use_gpu = 0;
+#if CONFIG_MULTI_RES_ENCODING
+  oxcf.mr_total_resolutions = 1;
+  oxcf.mr_encoder_id = 0;
+  oxcf.mr_low_res_mode_info = NULL;
+#endif
+  // The search sites of the first pass are set up on the first frame, from
+  // the speed features of the created encoder. Like the encoder of a regular
+  // first pass, it is created at speed 0 and then set to the real speed.
+  oxcf.speed = 0;
+  stats->cpi = vp9_create_compressor(&oxcf);
+  if (stats->cpi == NULL) {
+    vpx_free(stats);
+    return NULL;
+  }
+  oxcf.speed = cpi->oxcf.speed;
+  vp9_change_config(stats->cpi, &oxcf);
+  vpx_codec_pkt_list_init(&stats->pkt_list);
+  stats->cpi->output_pkt_list = &stats->pkt_list.head;
+
+  winterface->init(&stats->worker);
+  stats->worker.hook = first_pass_worker_hook;
+  stats->worker.data1 = stats;
+  if (!winterface->reset(&stats->worker)) {
+    vp9_lookahead_stats_remove(stats);
+    return NULL;
+  }
+
+  vp9_init_lookahead_second_pass(cpi, stats->window, STATS_WINDOW_SIZE);
+  return stats;
+}
+
+void vp9_lookahead_stats_remove(VP9LookaheadStats *stats) {
+  if (stats == NULL)
+    return;
+
+  if (stats->cpi != NULL) {
+    vp9_get_worker_interface()->end(&stats->worker);
+    vp9_remove_compressor(stats->cpi);
+  }
+  vpx_free(stats);
+}
+
+int vp9_lookahead_stats_push(VP9_COMP *cpi) {
+  VP9LookaheadStats *const stats = cpi->lookahead_stats;
+  struct lookahead_ctx *const lookahead = cpi->lookahead;
+
+  vp9_lookahead_stats_sync(cpi);
+#if CONFIG_MULTI_RES_ENCODING
+  if (stats->cpi == NULL) {
+    const struct lookahead_entry *const source =
+        vp9_lookahead_peek(lookahead, vp9_lookahead_depth(lookahead) - 1);
+    if (vp9_mr_check_stats(cpi, stats->num_pushed - stats->num_appended))
+      return -1;
+    stats->complexity[stats->num_pushed % MR_STATS_SIZE] =
+        vp9_mr_source_complexity(&source->img);
+    ++stats->num_pushed;
+    return 0;
+  }
+#endif
+
+  stats->source = vp9_lookahead_peek(lookahead,
+                                     vp9_lookahead_depth(lookahead) - 1);
+  stats->worker.data2 = stats->source;
+  vp9_get_worker_interface()->launch(&stats->worker);
+  return 0;
+}
+
+void vp9_lookahead_stats_sync(VP9_COMP *cpi) {
+  VP9LookaheadStats *const stats = cpi->lookahead_stats;
+  const struct lookahead_entry *const source = stats->source;
+
+#if CONFIG_MULTI_RES_ENCODING
+  // The lowest resolution synchronizes on the same frames, the statistics
+  // not published yet are for a frame it did not need to code.
+  if (stats->cpi == NULL) {
+    FIRSTPASS_STATS this_frame;
+    while (stats->num_appended < stats->num_pushed &&
+           vp9_mr_get_stats(cpi, stats->num_appended,
+                            stats->complexity[stats->num_appended %
+                                              MR_STATS_SIZE],
+                            &this_frame)) {
+      vp9_append_lookahead_stats(cpi, &this_frame);
+      ++stats->num_appended;
+    }
+    return;
+  }
+#endif
+
+  if (source == NULL)
+    return;
+
+  stats->source = NULL;
+  if (vp9_get_worker_interface()->sync(&stats->worker)) {
+    vp9_append_lookahead_stats(cpi, &stats->cpi->twopass.this_frame_stats);
+#if CONFIG_MULTI_RES_ENCODING
+    vp9_mr_publish_stats(cpi, &stats->cpi->twopass.this_frame_stats,
+                         &source->img);
+#endif
+  } else {
+    vpx_internal_error(&cpi->common.error, VPX_CODEC_ERROR,
+                       "Failed to analyze a lookahead frame");
+  }
+}
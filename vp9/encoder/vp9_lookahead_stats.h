@@ -0,0 +1,40 @@
+/*
+ *  Copyright (c) 2014 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef VP9_ENCODER_VP9_LOOKAHEAD_STATS_H_
+#define VP9_ENCODER_VP9_LOOKAHEAD_STATS_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct VP9_COMP;
+struct VP9LookaheadStats;
+
+// Set up the first pass run on the frames pushed into the lookahead of 'cpi',
+// and the second pass over their statistics. Returns NULL on failure.
+struct VP9LookaheadStats *vp9_lookahead_stats_create(struct VP9_COMP *cpi);
+
+void vp9_lookahead_stats_remove(struct VP9LookaheadStats *stats);
+
+// Start the first pass on the newest frame of the lookahead, on the worker
+// thread, once the statistics of the previous one are appended. Returns -1
+// if the statistics of the frame cannot be had.
+int vp9_lookahead_stats_push(struct VP9_COMP *cpi);
+
+// Wait for the first pass on the newest frame, if any, and append its
+// statistics.
+void vp9_lookahead_stats_sync(struct VP9_COMP *cpi);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // VP9_ENCODER_VP9_LOOKAHEAD_STATS_H_
@@ -20,11 +20,11 @@
 
 
 static unsigned int do_16x16_motion_iteration(VP9_COMP *cpi,
+                                              MACROBLOCK *const x,
                                               const MV *ref_mv,
                                               MV *dst_mv,
                                               int mb_row,
                                               int mb_col) {
-  MACROBLOCK *const x = &cpi->mb;
   MACROBLOCKD *const xd = &x->e_mbd;
   const MV_SPEED_FEATURES *const mv_sf = &cpi->sf.mv;
   const vp9_variance_fn_ptr_t v_fn_ptr = cpi->fn_ptr[BLOCK_16X16];
@@ -78,9 +78,9 @@ static unsigned int do_16x16_motion_iteration(VP9_COMP *cpi,
           xd->plane[0].dst.buf, xd->plane[0].dst.stride);
 }
 
-static int do_16x16_motion_search(VP9_COMP *cpi, const MV *ref_mv,
-                                  int_mv *dst_mv, int mb_row, int mb_col) {
-  MACROBLOCK *const x = &cpi->mb;
+static int do_16x16_motion_search(VP9_COMP *cpi, MACROBLOCK *const x,
+                                  const MV *ref_mv, int_mv *dst_mv,
+                                  int mb_row, int mb_col) {
   MACROBLOCKD *const xd = &x->e_mbd;
   unsigned int err, tmp_err;
   MV tmp_mv;
@@ -93,7 +93,7 @@ static int do_16x16_motion_search(VP9_COMP *cpi, const MV *ref_mv,
 
   // Test last reference frame using the previous best mv as the
   // starting point (best reference) for the search
-  tmp_err = do_16x16_motion_iteration(cpi, ref_mv, &tmp_mv, mb_row, mb_col);
+  tmp_err = do_16x16_motion_iteration(cpi, x, ref_mv, &tmp_mv, mb_row, mb_col);
   if (tmp_err < err) {
     err = tmp_err;
     dst_mv->as_mv = tmp_mv;
@@ -105,7 +105,7 @@ static int do_16x16_motion_search(VP9_COMP *cpi, const MV *ref_mv,
     unsigned int tmp_err;
     MV zero_ref_mv = {0, 0}, tmp_mv;
 
-    tmp_err = do_16x16_motion_iteration(cpi, &zero_ref_mv, &tmp_mv,
+    tmp_err = do_16x16_motion_iteration(cpi, x, &zero_ref_mv, &tmp_mv,
                                         mb_row, mb_col);
     if (tmp_err < err) {
       dst_mv->as_mv = tmp_mv;
@@ -116,8 +116,7 @@ static int do_16x16_motion_search(VP9_COMP *cpi, const MV *ref_mv,
   return err;
 }
 
-static int do_16x16_zerozero_search(VP9_COMP *cpi, int_mv *dst_mv) {
-  MACROBLOCK *const x = &cpi->mb;
+static int do_16x16_zerozero_search(MACROBLOCK *const x, int_mv *dst_mv) {
   MACROBLOCKD *const xd = &x->e_mbd;
   unsigned int err;
 
@@ -130,8 +129,8 @@ static int do_16x16_zerozero_search(VP9_COMP *cpi, int_mv *dst_mv) {
 
   return err;
 }
-static int find_best_16x16_intra(VP9_COMP *cpi, PREDICTION_MODE *pbest_mode) {
-  MACROBLOCK   *const x  = &cpi->mb;
+static int find_best_16x16_intra(MACROBLOCK *const x,
+                                 PREDICTION_MODE *pbest_mode) {
   MACROBLOCKD *const xd = &x->e_mbd;
   PREDICTION_MODE best_mode = -1, mode;
   unsigned int best_err = INT_MAX;
@@ -165,6 +164,7 @@ static int find_best_16x16_intra(VP9_COMP *cpi, PREDICTION_MODE *pbest_mode) {
 static void update_mbgraph_mb_stats
 (
   VP9_COMP *cpi,
+  MACROBLOCK *const x,
   MBGRAPH_MB_STATS *stats,
   YV12_BUFFER_CONFIG *buf,
   int mb_y_offset,
@@ -174,21 +174,15 @@ static void update_mbgraph_mb_stats
   int mb_row,
   int mb_col
 ) {
-  MACROBLOCK *const x = &cpi->mb;
   MACROBLOCKD *const xd = &x->e_mbd;
   int intra_error;
-  VP9_COMMON *cm = &cpi->common;
 
   // FIXME in practice we're completely ignoring chroma here
   x->plane[0].src.buf = buf->y_buffer + mb_y_offset;
   x->plane[0].src.stride = buf->y_stride;
 
-  xd->plane[0].dst.buf = get_frame_new_buffer(cm)->y_buffer + mb_y_offset;
-  xd->plane[0].dst.stride = get_frame_new_buffer(cm)->y_stride;
-
   // do intra 16x16 prediction
-  intra_error = find_best_16x16_intra(cpi,
-                                      &stats->ref[INTRA_FRAME].m.mode);
+  intra_error = find_best_16x16_intra(x, &stats->ref[INTRA_FRAME].m.mode);
   if (intra_error <= 0)
     intra_error = 1;
   stats->ref[INTRA_FRAME].err = intra_error;
@@ -198,7 +192,7 @@ static void update_mbgraph_mb_stats
     int g_motion_error;
     xd->plane[0].pre[0].buf = golden_ref->y_buffer + mb_y_offset;
     xd->plane[0].pre[0].stride = golden_ref->y_stride;
-    g_motion_error = do_16x16_motion_search(cpi,
+    g_motion_error = do_16x16_motion_search(cpi, x,
                                             prev_golden_ref_mv,
                                             &stats->ref[GOLDEN_FRAME].m.mv,
                                             mb_row, mb_col);
@@ -214,7 +208,7 @@ static void update_mbgraph_mb_stats
     int a_motion_error;
     xd->plane[0].pre[0].buf = alt_ref->y_buffer + mb_y_offset;
     xd->plane[0].pre[0].stride = alt_ref->y_stride;
-    a_motion_error = do_16x16_zerozero_search(cpi,
+    a_motion_error = do_16x16_zerozero_search(x,
                                               &stats->ref[ALTREF_FRAME].m.mv);
 
     stats->ref[ALTREF_FRAME].err = a_motion_error;
@@ -224,19 +218,26 @@ static void update_mbgraph_mb_stats
   }
 }
 
+// The predictions of the MBs are built in 'pred': they are only compared to
+// the source, the MBs of a frame can be analyzed with their own block context
+// independently of those of the other frames.
 static void update_mbgraph_frame_stats(VP9_COMP *cpi,
+                                       MACROBLOCK *const x,
                                        MBGRAPH_FRAME_STATS *stats,
                                        YV12_BUFFER_CONFIG *buf,
                                        YV12_BUFFER_CONFIG *golden_ref,
                                        YV12_BUFFER_CONFIG *alt_ref) {
-  MACROBLOCK *const x = &cpi->mb;
   MACROBLOCKD *const xd = &x->e_mbd;
   VP9_COMMON *const cm = &cpi->common;
+  MODE_INFO **const mi = xd->mi;
+  const YV12_BUFFER_CONFIG *const cur_buf = xd->cur_buf;
+  DECLARE_ALIGNED_ARRAY(16, uint8_t, pred, 16 * 16);
 
   int mb_col, mb_row, offset = 0;
   int mb_y_offset = 0, arf_y_offset = 0, gld_y_offset = 0;
   MV gld_top_mv = {0, 0};
   MODE_INFO mi_local;
+  MODE_INFO *mi_ptr = &mi_local;
 
   vp9_zero(mi_local);
   // Set up limit values for motion vectors to prevent them extending outside
@@ -244,10 +245,11 @@ static void update_mbgraph_frame_stats(VP9_COMP *cpi,
   x->mv_row_min     = -BORDER_MV_PIXELS_B16;
   x->mv_row_max     = (cm->mb_rows - 1) * 8 + BORDER_MV_PIXELS_B16;
   xd->up_available  = 0;
-  xd->plane[0].dst.stride  = buf->y_stride;
+  xd->plane[0].dst.buf = pred;
+  xd->plane[0].dst.stride = 16;
   xd->plane[0].pre[0].stride  = buf->y_stride;
-  xd->plane[1].dst.stride = buf->uv_stride;
-  xd->mi[0] = &mi_local;
+  xd->cur_buf = buf;
+  xd->mi = &mi_ptr;
   mi_local.mbmi.sb_type = BLOCK_16X16;
   mi_local.mbmi.ref_frame[0] = LAST_FRAME;
   mi_local.mbmi.ref_frame[1] = NONE;
@@ -263,11 +265,15 @@ static void update_mbgraph_frame_stats(VP9_COMP *cpi,
     x->mv_col_min      = -BORDER_MV_PIXELS_B16;
     x->mv_col_max      = (cm->mb_cols - 1) * 8 + BORDER_MV_PIXELS_B16;
     xd->left_available = 0;
+    xd->mb_to_top_edge = -((mb_row * 16) * 8);
+    xd->mb_to_bottom_edge = ((cm->mi_rows - 2 - mb_row * 2) * MI_SIZE) * 8;
 
     for (mb_col = 0; mb_col < cm->mb_cols; mb_col++) {
       MBGRAPH_MB_STATS *mb_stats = &stats->mb_stats[offset + mb_col];
 
-      update_mbgraph_mb_stats(cpi, mb_stats, buf, mb_y_in_offset,
+      xd->mb_to_left_edge = -((mb_col * 16) * 8);
+      xd->mb_to_right_edge = ((cm->mi_cols - 2 - mb_col * 2) * MI_SIZE) * 8;
+      update_mbgraph_mb_stats(cpi, x, mb_stats, buf, mb_y_in_offset,
                               golden_ref, &gld_left_mv, alt_ref,
                               mb_row, mb_col);
       gld_left_mv = mb_stats->ref[GOLDEN_FRAME].m.mv.as_mv;
@@ -290,6 +296,65 @@ static void update_mbgraph_frame_stats(VP9_COMP *cpi,
     x->mv_row_max   -= 16;
     offset          += cm->mb_cols;
   }
+
+  // The block context is not left pointing to the local data.
+  xd->mi = mi;
+  xd->cur_buf = cur_buf;
+}
+
+static void update_mbgraph_lookahead_frame(VP9_COMP *cpi, MACROBLOCK *const x,
+                                           int i) {
+  struct lookahead_entry *q_cur = vp9_lookahead_peek(cpi->lookahead, i);
+
+  assert(q_cur != NULL);
+
+  update_mbgraph_frame_stats(cpi, x, &cpi->mbgraph_stats[i], &q_cur->img,
+                             get_ref_frame_buffer(cpi, GOLDEN_FRAME),
+                             cpi->Source);
+}
+
+// Frame-based multi-threaded hook of the motion graph analysis.
+static int mbgraph_thread_process(thread_context *const thread_ctxt,
+                                  void *unused) {
+  VP9_COMP *const cpi = thread_ctxt->cpi;
+  MACROBLOCK *const x = &thread_ctxt->mb;
+  int i;
+
+  (void)unused;
+  vp9_mb_copy(cpi, x, &cpi->mb);
+  x->thread_id = thread_ctxt->thread_id;
+  x->stats = &thread_ctxt->stats;
+
+  // The frames do not depend on each other, only the row queue of the row
+  // synchronization is used, to hand them out.
+  while ((i = vp9_row_sync_next_row(&cpi->row_sync)) < cpi->mbgraph_n_frames)
+    update_mbgraph_lookahead_frame(cpi, x, i);
+
+  return 1;
+}
+
+static void run_mbgraph_threads(VP9_COMP *cpi) {
+  const VP9WorkerInterface *const winterface = vp9_get_worker_interface();
+  int thread_id;
+
+  vp9_row_sync_reset(&cpi->row_sync);
+
+  for (thread_id = 0; thread_id < cpi->max_threads; ++thread_id) {
+    VP9Worker *const worker = &cpi->enc_thread_hndl[thread_id];
+    thread_context *const thread_ctxt = (thread_context *)worker->data1;
+
+    worker->hook = (VP9WorkerHook)mbgraph_thread_process;
+    thread_ctxt->cpi = cpi;
+    thread_ctxt->thread_id = thread_id;
+
+    if (thread_id == cpi->max_threads - 1)
+      winterface->execute(worker);
+    else
+      winterface->launch(worker);
+  }
+
+  for (thread_id = 0; thread_id < cpi->max_threads; ++thread_id)
+    winterface->sync(&cpi->enc_thread_hndl[thread_id]);
 }
 
 // void separate_arf_mbs_byzz
@@ -374,7 +439,6 @@ static void separate_arf_mbs(VP9_COMP *cpi) {
 void vp9_update_mbgraph_stats(VP9_COMP *cpi) {
   VP9_COMMON *const cm = &cpi->common;
   int i, n_frames = vp9_lookahead_depth(cpi->lookahead);
-  YV12_BUFFER_CONFIG *golden_ref = get_ref_frame_buffer(cpi, GOLDEN_FRAME);
 
   // we need to look ahead beyond where the ARF transitions into
   // being a GF - so exit if we don't look ahead beyond that
@@ -396,14 +460,11 @@ void vp9_update_mbgraph_stats(VP9_COMP *cpi) {
   // later on in this GF group
   // FIXME really, the GF/last MC search should be done forward, and
   // the ARF MC search backwards, to get optimal results for MV caching
-  for (i = 0; i < n_frames; i++) {
-    MBGRAPH_FRAME_STATS *frame_stats = &cpi->mbgraph_stats[i];
-    struct lookahead_entry *q_cur = vp9_lookahead_peek(cpi->lookahead, i);
-
-    assert(q_cur != NULL);
-
-    update_mbgraph_frame_stats(cpi, frame_stats, &q_cur->img,
-                               golden_ref, cpi->Source);
+  if (cpi->max_threads > 1) {
+    run_mbgraph_threads(cpi);
+  } else {
+    for (i = 0; i < n_frames; i++)
+      update_mbgraph_lookahead_frame(cpi, &cpi->mb, i);
   }
 
   vp9_clear_system_state();
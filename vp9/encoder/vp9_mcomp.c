@@ -313,6 +313,7 @@ int vp9_find_best_sub_pixel_tree_pruned(const MACROBLOCK *x,
                                         const uint8_t *second_pred,
                                         int w, int h) {
   SETUP_SUBPEL_SEARCH;
+  vp9_stats_count(x->stats, &x->stats->subpel_searches, 1);
 
   if (sad_list &&
       sad_list[0] != INT_MAX && sad_list[1] != INT_MAX &&
@@ -407,6 +408,7 @@ int vp9_find_best_sub_pixel_tree(const MACROBLOCK *x,
   int hstep_range = 6;
   SETUP_SUBPEL_SEARCH;
   (void) sad_list;  // to silence compiler warning
+  vp9_stats_count(x->stats, &x->stats->subpel_searches, 1);
 
   // Each subsequent iteration checks at least one point in
   // common with the last iteration could be 2 ( if diag selected)
@@ -511,6 +513,7 @@ static int vp9_pattern_search(const MACROBLOCK *x,
                               const int num_candidates[MAX_PATTERN_SCALES],
                               const MV candidates[MAX_PATTERN_SCALES]
                                                  [MAX_PATTERN_CANDIDATES]) {
+  int sad_calls = 0;
   const MACROBLOCKD *const xd = &x->e_mbd;
   MB_MODE_INFO *mbmi = &xd->mi[0]->mbmi;
   static const int search_param_to_steps[MAX_MVSEARCH_STEPS] = {
@@ -531,6 +534,7 @@ static int vp9_pattern_search(const MACROBLOCK *x,
   bc = ref_mv->col;
 
   // Work out the start point for the search
+  ++sad_calls;
   bestsad = vfp->sdf(what->buf, what->stride,
                      get_buf_from_mv(in_what, ref_mv), in_what->stride) +
       mvsad_err_cost(x, ref_mv, &fcenter_mv, sad_per_bit);
@@ -547,6 +551,7 @@ static int vp9_pattern_search(const MACROBLOCK *x,
         for (i = 0; i < num_candidates[t]; i++) {
           const MV this_mv = {br + candidates[t][i].row,
                               bc + candidates[t][i].col};
+          ++sad_calls;
           thissad = vfp->sdf(what->buf, what->stride,
                              get_buf_from_mv(in_what, &this_mv),
                              in_what->stride);
@@ -558,6 +563,7 @@ static int vp9_pattern_search(const MACROBLOCK *x,
                               bc + candidates[t][i].col};
           if (!is_mv_in(x, &this_mv))
             continue;
+          ++sad_calls;
           thissad = vfp->sdf(what->buf, what->stride,
                              get_buf_from_mv(in_what, &this_mv),
                              in_what->stride);
@@ -590,6 +596,7 @@ static int vp9_pattern_search(const MACROBLOCK *x,
           for (i = 0; i < num_candidates[s]; i++) {
             const MV this_mv = {br + candidates[s][i].row,
                                 bc + candidates[s][i].col};
+            ++sad_calls;
             thissad = vfp->sdf(what->buf, what->stride,
                                get_buf_from_mv(in_what, &this_mv),
                                in_what->stride);
@@ -623,6 +630,7 @@ static int vp9_pattern_search(const MACROBLOCK *x,
           for (i = 0; i < PATTERN_CANDIDATES_REF; i++) {
             const MV this_mv = {br + candidates[s][next_chkpts_indices[i]].row,
                                 bc + candidates[s][next_chkpts_indices[i]].col};
+            ++sad_calls;
             thissad = vfp->sdf(what->buf, what->stride,
                                get_buf_from_mv(in_what, &this_mv),
                                in_what->stride);
@@ -652,6 +660,7 @@ static int vp9_pattern_search(const MACROBLOCK *x,
       for (i = 0; i < 4; i++) {
         const MV this_mv = {br + neighbors[i].row,
                             bc + neighbors[i].col};
+        ++sad_calls;
         sad_list[i + 1] = vfp->sdf(what->buf, what->stride,
                                    get_buf_from_mv(in_what, &this_mv),
                                    in_what->stride) +
@@ -663,20 +672,23 @@ static int vp9_pattern_search(const MACROBLOCK *x,
       for (i = 0; i < 4; i++) {
         const MV this_mv = {br + neighbors[i].row,
                             bc + neighbors[i].col};
-        if (!is_mv_in(x, &this_mv))
+        if (!is_mv_in(x, &this_mv)) {
           sad_list[i + 1] = INT_MAX;
-        else
+        } else {
+          ++sad_calls;
           sad_list[i + 1] = vfp->sdf(what->buf, what->stride,
                                      get_buf_from_mv(in_what, &this_mv),
                                      in_what->stride) +
               (use_mvcost ?
                mvsad_err_cost(x, &this_mv, &fcenter_mv, sad_per_bit) :
                0);
+        }
       }
     }
   }
   best_mv->row = br;
   best_mv->col = bc;
+  vp9_stats_count(x->stats, &x->stats->sad_calls, sad_calls);
   return bestsad;
 }
 
@@ -697,6 +709,7 @@ static int vp9_pattern_search_sad(const MACROBLOCK *x,
                                   const int num_candidates[MAX_PATTERN_SCALES],
                                   const MV candidates[MAX_PATTERN_SCALES]
                                                      [MAX_PATTERN_CANDIDATES]) {
+  int sad_calls = 0;
   const MACROBLOCKD *const xd = &x->e_mbd;
   MB_MODE_INFO *mbmi = &xd->mi[0]->mbmi;
   static const int search_param_to_steps[MAX_MVSEARCH_STEPS] = {
@@ -721,6 +734,7 @@ static int vp9_pattern_search_sad(const MACROBLOCK *x,
   }
 
   // Work out the start point for the search
+  ++sad_calls;
   bestsad = vfp->sdf(what->buf, what->stride,
                      get_buf_from_mv(in_what, ref_mv), in_what->stride) +
       mvsad_err_cost(x, ref_mv, &fcenter_mv, sad_per_bit);
@@ -737,6 +751,7 @@ static int vp9_pattern_search_sad(const MACROBLOCK *x,
         for (i = 0; i < num_candidates[t]; i++) {
           const MV this_mv = {br + candidates[t][i].row,
                               bc + candidates[t][i].col};
+          ++sad_calls;
           thissad = vfp->sdf(what->buf, what->stride,
                              get_buf_from_mv(in_what, &this_mv),
                              in_what->stride);
@@ -748,6 +763,7 @@ static int vp9_pattern_search_sad(const MACROBLOCK *x,
                               bc + candidates[t][i].col};
           if (!is_mv_in(x, &this_mv))
             continue;
+          ++sad_calls;
           thissad = vfp->sdf(what->buf, what->stride,
                              get_buf_from_mv(in_what, &this_mv),
                              in_what->stride);
@@ -780,6 +796,7 @@ static int vp9_pattern_search_sad(const MACROBLOCK *x,
           for (i = 0; i < num_candidates[s]; i++) {
             const MV this_mv = {br + candidates[s][i].row,
                                 bc + candidates[s][i].col};
+            ++sad_calls;
             thissad = vfp->sdf(what->buf, what->stride,
                                get_buf_from_mv(in_what, &this_mv),
                                in_what->stride);
@@ -791,6 +808,7 @@ static int vp9_pattern_search_sad(const MACROBLOCK *x,
                                 bc + candidates[s][i].col};
             if (!is_mv_in(x, &this_mv))
               continue;
+            ++sad_calls;
             thissad = vfp->sdf(what->buf, what->stride,
                                get_buf_from_mv(in_what, &this_mv),
                                in_what->stride);
@@ -824,6 +842,7 @@ static int vp9_pattern_search_sad(const MACROBLOCK *x,
           for (i = 0; i < PATTERN_CANDIDATES_REF; i++) {
             const MV this_mv = {br + candidates[s][next_chkpts_indices[i]].row,
                                 bc + candidates[s][next_chkpts_indices[i]].col};
+            ++sad_calls;
             thissad = vfp->sdf(what->buf, what->stride,
                                get_buf_from_mv(in_what, &this_mv),
                                in_what->stride);
@@ -835,6 +854,7 @@ static int vp9_pattern_search_sad(const MACROBLOCK *x,
                                 bc + candidates[s][next_chkpts_indices[i]].col};
             if (!is_mv_in(x, &this_mv))
               continue;
+            ++sad_calls;
             thissad = vfp->sdf(what->buf, what->stride,
                                get_buf_from_mv(in_what, &this_mv),
                                in_what->stride);
@@ -858,6 +878,7 @@ static int vp9_pattern_search_sad(const MACROBLOCK *x,
           for (i = 0; i < num_candidates[s]; i++) {
             const MV this_mv = {br + candidates[s][i].row,
                                 bc + candidates[s][i].col};
+            ++sad_calls;
             sad_list[i + 1] =
             thissad = vfp->sdf(what->buf, what->stride,
                                get_buf_from_mv(in_what, &this_mv),
@@ -870,6 +891,7 @@ static int vp9_pattern_search_sad(const MACROBLOCK *x,
                                 bc + candidates[s][i].col};
             if (!is_mv_in(x, &this_mv))
               continue;
+            ++sad_calls;
             sad_list[i + 1] =
             thissad = vfp->sdf(what->buf, what->stride,
                                get_buf_from_mv(in_what, &this_mv),
@@ -898,6 +920,7 @@ static int vp9_pattern_search_sad(const MACROBLOCK *x,
           for (i = 0; i < PATTERN_CANDIDATES_REF; i++) {
             const MV this_mv = {br + candidates[s][next_chkpts_indices[i]].row,
                                 bc + candidates[s][next_chkpts_indices[i]].col};
+            ++sad_calls;
             sad_list[next_chkpts_indices[i] + 1] =
             thissad = vfp->sdf(what->buf, what->stride,
                                get_buf_from_mv(in_what, &this_mv),
@@ -912,6 +935,7 @@ static int vp9_pattern_search_sad(const MACROBLOCK *x,
               sad_list[next_chkpts_indices[i] + 1] = INT_MAX;
               continue;
             }
+            ++sad_calls;
             sad_list[next_chkpts_indices[i] + 1] =
             thissad = vfp->sdf(what->buf, what->stride,
                                get_buf_from_mv(in_what, &this_mv),
@@ -943,6 +967,7 @@ static int vp9_pattern_search_sad(const MACROBLOCK *x,
         for (i = 0; i < 4; i++) {
           const MV this_mv = {br + neighbors[i].row,
             bc + neighbors[i].col};
+          ++sad_calls;
           sad_list[i + 1] = vfp->sdf(what->buf, what->stride,
                                      get_buf_from_mv(in_what, &this_mv),
                                      in_what->stride);
@@ -951,12 +976,14 @@ static int vp9_pattern_search_sad(const MACROBLOCK *x,
         for (i = 0; i < 4; i++) {
           const MV this_mv = {br + neighbors[i].row,
             bc + neighbors[i].col};
-          if (!is_mv_in(x, &this_mv))
+          if (!is_mv_in(x, &this_mv)) {
             sad_list[i + 1] = INT_MAX;
-          else
+          } else {
+            ++sad_calls;
             sad_list[i + 1] = vfp->sdf(what->buf, what->stride,
                                        get_buf_from_mv(in_what, &this_mv),
                                        in_what->stride);
+          }
         }
       }
     } else {
@@ -974,6 +1001,7 @@ static int vp9_pattern_search_sad(const MACROBLOCK *x,
   }
   best_mv->row = br;
   best_mv->col = bc;
+  vp9_stats_count(x->stats, &x->stats->sad_calls, sad_calls);
   return bestsad;
 }
 
@@ -1167,6 +1195,7 @@ int vp9_full_range_search_c(const MACROBLOCK *x,
                             int search_param, int sad_per_bit, int *num00,
                             const vp9_variance_fn_ptr_t *fn_ptr,
                             const MV *center_mv) {
+  int sad_calls = 0;
   const MACROBLOCKD *const xd = &x->e_mbd;
   const struct buf_2d *const what = &x->plane[0].src;
   const struct buf_2d *const in_what = &xd->plane[0].pre[0];
@@ -1183,6 +1212,7 @@ int vp9_full_range_search_c(const MACROBLOCK *x,
   clamp_mv(ref_mv, x->mv_col_min, x->mv_col_max, x->mv_row_min, x->mv_row_max);
   *best_mv = *ref_mv;
   *num00 = 11;
+  ++sad_calls;
   best_sad = fn_ptr->sdf(what->buf, what->stride,
                          get_buf_from_mv(in_what, ref_mv), in_what->stride) +
                  mvsad_err_cost(x, ref_mv, &fcenter_mv, sad_per_bit);
@@ -1201,6 +1231,7 @@ int vp9_full_range_search_c(const MACROBLOCK *x,
           addrs[i] = get_buf_from_mv(in_what, &mv);
         }
 
+        sad_calls += 4;
         fn_ptr->sdx4df(what->buf, what->stride, addrs, in_what->stride, sads);
 
         for (i = 0; i < 4; ++i) {
@@ -1219,6 +1250,7 @@ int vp9_full_range_search_c(const MACROBLOCK *x,
           const MV mv = {ref_mv->row + r, ref_mv->col + c + i};
           unsigned int sad = fn_ptr->sdf(what->buf, what->stride,
               get_buf_from_mv(in_what, &mv), in_what->stride);
+          ++sad_calls;
           if (sad < best_sad) {
             sad += mvsad_err_cost(x, &mv, &fcenter_mv, sad_per_bit);
             if (sad < best_sad) {
@@ -1231,6 +1263,7 @@ int vp9_full_range_search_c(const MACROBLOCK *x,
     }
   }
 
+  vp9_stats_count(x->stats, &x->stats->sad_calls, sad_calls);
   return best_sad;
 }
 
@@ -1240,6 +1273,7 @@ int vp9_diamond_search_sad_c(const MACROBLOCK *x,
                              int sad_per_bit, int *num00,
                              const vp9_variance_fn_ptr_t *fn_ptr,
                              const MV *center_mv) {
+  int sad_calls = 0;
   int i, j, step;
 
   const MACROBLOCKD *const xd = &x->e_mbd;
@@ -1277,6 +1311,7 @@ int vp9_diamond_search_sad_c(const MACROBLOCK *x,
   best_address = in_what;
 
   // Check the starting position
+  ++sad_calls;
   bestsad = fn_ptr->sdf(what, what_stride, in_what, in_what_stride)
                 + mvsad_err_cost(x, best_mv, &fcenter_mv, sad_per_bit);
 
@@ -1304,6 +1339,7 @@ int vp9_diamond_search_sad_c(const MACROBLOCK *x,
         for (t = 0; t < 4; t++)
           block_offset[t] = ss[i + t].offset + best_address;
 
+        sad_calls += 4;
         fn_ptr->sdx4df(what, what_stride, block_offset, in_what_stride,
                        sad_array);
 
@@ -1330,6 +1366,7 @@ int vp9_diamond_search_sad_c(const MACROBLOCK *x,
           const uint8_t *const check_here = ss[i].offset + best_address;
           unsigned int thissad = fn_ptr->sdf(what, what_stride, check_here,
                                              in_what_stride);
+          ++sad_calls;
 
           if (thissad < bestsad) {
             thissad += mvsad_err_cost(x, &this_mv, &fcenter_mv, sad_per_bit);
@@ -1355,6 +1392,7 @@ int vp9_diamond_search_sad_c(const MACROBLOCK *x,
           const uint8_t *const check_here = ss[best_site].offset + best_address;
           unsigned int thissad = fn_ptr->sdf(what, what_stride, check_here,
                                              in_what_stride);
+          ++sad_calls;
           if (thissad < bestsad) {
             thissad += mvsad_err_cost(x, &this_mv, &fcenter_mv, sad_per_bit);
             if (thissad < bestsad) {
@@ -1373,6 +1411,7 @@ int vp9_diamond_search_sad_c(const MACROBLOCK *x,
       (*num00)++;
     }
   }
+  vp9_stats_count(x->stats, &x->stats->sad_calls, sad_calls);
   return bestsad;
 }
 
@@ -1442,6 +1481,7 @@ int vp9_full_search_sad_c(const MACROBLOCK *x, const MV *ref_mv,
                           int sad_per_bit, int distance,
                           const vp9_variance_fn_ptr_t *fn_ptr,
                           const MV *center_mv, MV *best_mv) {
+  int sad_calls = 0;
   int r, c;
   const MACROBLOCKD *const xd = &x->e_mbd;
   const struct buf_2d *const what = &x->plane[0].src;
@@ -1454,6 +1494,7 @@ int vp9_full_search_sad_c(const MACROBLOCK *x, const MV *ref_mv,
   int best_sad = fn_ptr->sdf(what->buf, what->stride,
       get_buf_from_mv(in_what, ref_mv), in_what->stride) +
       mvsad_err_cost(x, ref_mv, &fcenter_mv, sad_per_bit);
+  ++sad_calls;
   *best_mv = *ref_mv;
 
   for (r = row_min; r < row_max; ++r) {
@@ -1462,12 +1503,14 @@ int vp9_full_search_sad_c(const MACROBLOCK *x, const MV *ref_mv,
       const int sad = fn_ptr->sdf(what->buf, what->stride,
           get_buf_from_mv(in_what, &mv), in_what->stride) +
               mvsad_err_cost(x, &mv, &fcenter_mv, sad_per_bit);
+      ++sad_calls;
       if (sad < best_sad) {
         best_sad = sad;
         *best_mv = mv;
       }
     }
   }
+  vp9_stats_count(x->stats, &x->stats->sad_calls, sad_calls);
   return best_sad;
 }
 
@@ -1475,6 +1518,7 @@ int vp9_full_search_sadx3(const MACROBLOCK *x, const MV *ref_mv,
                           int sad_per_bit, int distance,
                           const vp9_variance_fn_ptr_t *fn_ptr,
                           const MV *center_mv, MV *best_mv) {
+  int sad_calls = 0;
   int r;
   const MACROBLOCKD *const xd = &x->e_mbd;
   const struct buf_2d *const what = &x->plane[0].src;
@@ -1487,6 +1531,7 @@ int vp9_full_search_sadx3(const MACROBLOCK *x, const MV *ref_mv,
   unsigned int best_sad = fn_ptr->sdf(what->buf, what->stride,
       get_buf_from_mv(in_what, ref_mv), in_what->stride) +
       mvsad_err_cost(x, ref_mv, &fcenter_mv, sad_per_bit);
+  ++sad_calls;
   *best_mv = *ref_mv;
 
   for (r = row_min; r < row_max; ++r) {
@@ -1498,6 +1543,7 @@ int vp9_full_search_sadx3(const MACROBLOCK *x, const MV *ref_mv,
         int i;
         unsigned int sads[3];
 
+        sad_calls += 3;
         fn_ptr->sdx3f(what->buf, what->stride, check_here, in_what->stride,
                       sads);
 
@@ -1520,6 +1566,7 @@ int vp9_full_search_sadx3(const MACROBLOCK *x, const MV *ref_mv,
     while (c < col_max) {
       unsigned int sad = fn_ptr->sdf(what->buf, what->stride,
                                      check_here, in_what->stride);
+      ++sad_calls;
       if (sad < best_sad) {
         const MV mv = {r, c};
         sad += mvsad_err_cost(x, &mv, &fcenter_mv, sad_per_bit);
@@ -1533,6 +1580,7 @@ int vp9_full_search_sadx3(const MACROBLOCK *x, const MV *ref_mv,
     }
   }
 
+  vp9_stats_count(x->stats, &x->stats->sad_calls, sad_calls);
   return best_sad;
 }
 
@@ -1540,6 +1588,7 @@ int vp9_full_search_sadx8(const MACROBLOCK *x, const MV *ref_mv,
                           int sad_per_bit, int distance,
                           const vp9_variance_fn_ptr_t *fn_ptr,
                           const MV *center_mv, MV *best_mv) {
+  int sad_calls = 0;
   int r;
   const MACROBLOCKD *const xd = &x->e_mbd;
   const struct buf_2d *const what = &x->plane[0].src;
@@ -1552,6 +1601,7 @@ int vp9_full_search_sadx8(const MACROBLOCK *x, const MV *ref_mv,
   unsigned int best_sad = fn_ptr->sdf(what->buf, what->stride,
       get_buf_from_mv(in_what, ref_mv), in_what->stride) +
       mvsad_err_cost(x, ref_mv, &fcenter_mv, sad_per_bit);
+  ++sad_calls;
   *best_mv = *ref_mv;
 
   for (r = row_min; r < row_max; ++r) {
@@ -1563,6 +1613,7 @@ int vp9_full_search_sadx8(const MACROBLOCK *x, const MV *ref_mv,
         int i;
         unsigned int sads[8];
 
+        sad_calls += 8;
         fn_ptr->sdx8f(what->buf, what->stride, check_here, in_what->stride,
                       sads);
 
@@ -1587,6 +1638,7 @@ int vp9_full_search_sadx8(const MACROBLOCK *x, const MV *ref_mv,
         int i;
         unsigned int sads[3];
 
+        sad_calls += 3;
         fn_ptr->sdx3f(what->buf, what->stride, check_here, in_what->stride,
                       sads);
 
@@ -1609,6 +1661,7 @@ int vp9_full_search_sadx8(const MACROBLOCK *x, const MV *ref_mv,
     while (c < col_max) {
       unsigned int sad = fn_ptr->sdf(what->buf, what->stride,
                                      check_here, in_what->stride);
+      ++sad_calls;
       if (sad < best_sad) {
         const MV mv = {r, c};
         sad += mvsad_err_cost(x, &mv, &fcenter_mv, sad_per_bit);
@@ -1622,6 +1675,7 @@ int vp9_full_search_sadx8(const MACROBLOCK *x, const MV *ref_mv,
     }
   }
 
+  vp9_stats_count(x->stats, &x->stats->sad_calls, sad_calls);
   return best_sad;
 }
 
@@ -1630,6 +1684,7 @@ int vp9_refining_search_sad_c(const MACROBLOCK *x,
                               int search_range,
                               const vp9_variance_fn_ptr_t *fn_ptr,
                               const MV *center_mv) {
+  int sad_calls = 0;
   const MACROBLOCKD *const xd = &x->e_mbd;
   const MV neighbors[4] = {{ -1, 0}, {0, -1}, {0, 1}, {1, 0}};
   const struct buf_2d *const what = &x->plane[0].src;
@@ -1640,6 +1695,7 @@ int vp9_refining_search_sad_c(const MACROBLOCK *x,
                                     in_what->stride) +
       mvsad_err_cost(x, ref_mv, &fcenter_mv, error_per_bit);
   int i, j;
+  ++sad_calls;
 
   for (i = 0; i < search_range; i++) {
     int best_site = -1;
@@ -1657,6 +1713,7 @@ int vp9_refining_search_sad_c(const MACROBLOCK *x,
         best_address + in_what->stride
       };
 
+      sad_calls += 4;
       fn_ptr->sdx4df(what->buf, what->stride, positions, in_what->stride, sads);
 
       for (j = 0; j < 4; ++j) {
@@ -1679,6 +1736,7 @@ int vp9_refining_search_sad_c(const MACROBLOCK *x,
           unsigned int sad = fn_ptr->sdf(what->buf, what->stride,
                                          get_buf_from_mv(in_what, &mv),
                                          in_what->stride);
+          ++sad_calls;
           if (sad < best_sad) {
             sad += mvsad_err_cost(x, &mv, &fcenter_mv, error_per_bit);
             if (sad < best_sad) {
@@ -1699,6 +1757,7 @@ int vp9_refining_search_sad_c(const MACROBLOCK *x,
     }
   }
 
+  vp9_stats_count(x->stats, &x->stats->sad_calls, sad_calls);
   return best_sad;
 }
 
@@ -1710,6 +1769,7 @@ int vp9_refining_search_8p_c(const MACROBLOCK *x,
                              const vp9_variance_fn_ptr_t *fn_ptr,
                              const MV *center_mv,
                              const uint8_t *second_pred) {
+  int sad_calls = 0;
   const MV neighbors[8] = {{-1, 0}, {0, -1}, {0, 1}, {1, 0},
                            {-1, -1}, {1, -1}, {-1, 1}, {1, 1}};
   const MACROBLOCKD *const xd = &x->e_mbd;
@@ -1720,6 +1780,7 @@ int vp9_refining_search_8p_c(const MACROBLOCK *x,
       get_buf_from_mv(in_what, ref_mv), in_what->stride, second_pred) +
       mvsad_err_cost(x, ref_mv, &fcenter_mv, error_per_bit);
   int i, j;
+  ++sad_calls;
 
   for (i = 0; i < search_range; ++i) {
     int best_site = -1;
@@ -1731,6 +1792,7 @@ int vp9_refining_search_8p_c(const MACROBLOCK *x,
       if (is_mv_in(x, &mv)) {
         unsigned int sad = fn_ptr->sdaf(what->buf, what->stride,
             get_buf_from_mv(in_what, &mv), in_what->stride, second_pred);
+        ++sad_calls;
         if (sad < best_sad) {
           sad += mvsad_err_cost(x, &mv, &fcenter_mv, error_per_bit);
           if (sad < best_sad) {
@@ -1748,6 +1810,7 @@ int vp9_refining_search_8p_c(const MACROBLOCK *x,
       ref_mv->col += neighbors[best_site].col;
     }
   }
+  vp9_stats_count(x->stats, &x->stats->sad_calls, sad_calls);
   return best_sad;
 }
 
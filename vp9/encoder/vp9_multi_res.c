@@ -0,0 +1,382 @@
+/*
+ *  Copyright (c) 2014 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "./vpx_scale_rtcd.h"
+
+#include "vp9/common/vp9_common.h"
+#include "vp9/common/vp9_mvref_common.h"
+
+#include "vp9/encoder/vp9_encoder.h"
+#include "vp9/encoder/vp9_multi_res.h"
+#include "vp9/encoder/vp9_resize.h"
+
+MR_SHARED_INFO *vp9_mr_alloc_shared_info(int width, int height) {
+  const int mi_rows = (height + MI_SIZE - 1) >> MI_SIZE_LOG2;
+  const int mi_cols = (width + MI_SIZE - 1) >> MI_SIZE_LOG2;
+  MR_SHARED_INFO *const info = calloc(1, sizeof(*info));
+  int i;
+
+  if (info == NULL)
+    return NULL;
+
+  for (i = 0; i < 2; ++i) {
+    info->frame_info[i].block_info =
+        calloc(mi_rows * mi_cols, sizeof(*info->frame_info[i].block_info));
+    if (info->frame_info[i].block_info == NULL) {
+      vp9_mr_free_shared_info(info);
+      return NULL;
+    }
+  }
+  return info;
+}
+
+void vp9_mr_free_shared_info(MR_SHARED_INFO *info) {
+  if (info != NULL) {
+    free(info->frame_info[0].block_info);
+    free(info->frame_info[1].block_info);
+    free(info);
+  }
+}
+
+YV12_BUFFER_CONFIG *vp9_mr_scale_source(VP9_COMP *cpi,
+                                        YV12_BUFFER_CONFIG *sd) {
+  VP9_COMMON *const cm = &cpi->common;
+  YV12_BUFFER_CONFIG *const dst = &cpi->mr_scaled_source;
+  int i;
+
+  if (sd->y_crop_width == cm->width && sd->y_crop_height == cm->height)
+    return sd;
+
+#if CONFIG_VP9_HIGHBITDEPTH
+  if (sd->flags & YV12_FLAG_HIGHBITDEPTH) {
+    vpx_internal_error(&cm->error, VPX_CODEC_INCAPABLE,
+                       "Downscaling high bit depth frames is not supported");
+    return NULL;
+  }
+#endif
+  if (vp9_realloc_frame_buffer(dst, cm->width, cm->height,
+                               cm->subsampling_x, cm->subsampling_y,
+#if CONFIG_VP9_HIGHBITDEPTH
+                               cm->use_highbitdepth,
+#endif
+                               VP9_ENC_BORDER_IN_PIXELS, NULL, NULL, NULL)) {
+    vpx_internal_error(&cm->error, VPX_CODEC_MEM_ERROR,
+                       "Failed to allocate the downscaled source");
+    return NULL;
+  }
+
+  {
+    const uint8_t *const srcs[3] = {sd->y_buffer, sd->u_buffer, sd->v_buffer};
+    const int src_strides[3] = {sd->y_stride, sd->uv_stride, sd->uv_stride};
+    // The chroma crop size of an application's image is not set.
+    const int src_uv_width = (sd->y_crop_width + cm->subsampling_x) >>
+                             cm->subsampling_x;
+    const int src_uv_height = (sd->y_crop_height + cm->subsampling_y) >>
+                              cm->subsampling_y;
+    const int src_widths[3] = {sd->y_crop_width, src_uv_width, src_uv_width};
+    const int src_heights[3] = {sd->y_crop_height, src_uv_height,
+                                src_uv_height};
+    uint8_t *const dsts[3] = {dst->y_buffer, dst->u_buffer, dst->v_buffer};
+    const int dst_strides[3] = {dst->y_stride, dst->uv_stride,
+                                dst->uv_stride};
+    const int dst_widths[3] = {dst->y_crop_width, dst->uv_crop_width,
+                               dst->uv_crop_width};
+    const int dst_heights[3] = {dst->y_crop_height, dst->uv_crop_height,
+                                dst->uv_crop_height};
+
+    // Unlike the convolution scaler, the resizer takes any ratio.
+    for (i = 0; i < MAX_MB_PLANE; ++i)
+      vp9_resize_plane(srcs[i], src_heights[i], src_widths[i], src_strides[i],
+                       dsts[i], dst_heights[i], dst_widths[i], dst_strides[i]);
+  }
+  vp9_extend_frame_borders(dst);
+  return dst;
+}
+
+int vp9_mr_reads_stats(const VP9_COMP *cpi) {
+  return cpi->oxcf.mr_total_resolutions > 1 && cpi->oxcf.mr_encoder_id > 0;
+}
+
+double vp9_mr_source_complexity(const YV12_BUFFER_CONFIG *src) {
+  double complexity = 0;
+  int r, c, i, j;
+
+  for (r = 0; r + 16 <= src->y_crop_height; r += 16) {
+    for (c = 0; c + 16 <= src->y_crop_width; c += 16) {
+      int64_t sum = 0, sse = 0;
+      for (i = 0; i < 16; ++i) {
+        const int offset = (r + i) * src->y_stride + c;
+#if CONFIG_VP9_HIGHBITDEPTH
+        const uint16_t *const row16 =
+            CONVERT_TO_SHORTPTR(src->y_buffer) + offset;
+#endif
+        const uint8_t *const row = src->y_buffer + offset;
+        for (j = 0; j < 16; ++j) {
+#if CONFIG_VP9_HIGHBITDEPTH
+          const int pixel = (src->flags & YV12_FLAG_HIGHBITDEPTH) ? row16[j]
+                                                                  : row[j];
+#else
+          const int pixel = row[j];
+#endif
+          sum += pixel;
+          sse += pixel * pixel;
+        }
+      }
+      complexity += (double)sse - (double)sum * sum / 256;
+    }
+  }
+  return complexity;
+}
+
+void vp9_mr_publish_stats(VP9_COMP *cpi, const FIRSTPASS_STATS *stats,
+                          const YV12_BUFFER_CONFIG *src) {
+  const VP9EncoderConfig *const oxcf = &cpi->oxcf;
+  MR_SHARED_INFO *const info = oxcf->mr_low_res_mode_info;
+  unsigned int index;
+
+  if (oxcf->mr_total_resolutions <= 1)
+    return;
+
+  index = info->num_stats % MR_STATS_SIZE;
+  info->stats[index] = *stats;
+  info->stats_complexity[index] = vp9_mr_source_complexity(src);
+  ++info->num_stats;
+  info->stats_width = cpi->common.width;
+  info->stats_height = cpi->common.height;
+  info->stats_lag_in_frames = oxcf->lag_in_frames;
+  info->auto_key = oxcf->auto_key;
+}
+
+int vp9_mr_check_stats(VP9_COMP *cpi, unsigned int num_pending) {
+  const MR_SHARED_INFO *const info = cpi->oxcf.mr_low_res_mode_info;
+
+  // All the resolutions have to code the same frames from the same
+  // statistics.
+  if (num_pending >= MR_STATS_SIZE) {
+    vpx_internal_error(&cpi->common.error, VPX_CODEC_INVALID_PARAM,
+                       "The lowest resolution shares no statistics");
+    return -1;
+  }
+  if (info->num_stats > 0 &&
+      info->stats_lag_in_frames != cpi->oxcf.lag_in_frames) {
+    vpx_internal_error(&cpi->common.error, VPX_CODEC_INVALID_PARAM,
+                       "The resolutions need the same lag");
+    return -1;
+  }
+  return 0;
+}
+
+int vp9_mr_get_stats(VP9_COMP *cpi, unsigned int index, double complexity,
+                     FIRSTPASS_STATS *stats) {
+  VP9_COMMON *const cm = &cpi->common;
+  const MR_SHARED_INFO *const info = cpi->oxcf.mr_low_res_mode_info;
+  double low_res_complexity, col_scale, row_scale, area_scale, error_scale;
+
+  if (index >= info->num_stats || index + MR_STATS_SIZE < info->num_stats)
+    return 0;
+
+  // The key frames of the higher resolutions are disabled, they are placed
+  // from the statistics as the lowest resolution places them.
+  cpi->oxcf.auto_key = info->auto_key;
+
+  // The motion vectors grow with the resolution. The errors add up over the
+  // frame, but a block of the lower resolution holds more detail: they follow
+  // the detail of the source at both resolutions instead.
+  col_scale = (double)cm->width / info->stats_width;
+  row_scale = (double)cm->height / info->stats_height;
+  area_scale = col_scale * row_scale;
+  low_res_complexity = info->stats_complexity[index % MR_STATS_SIZE];
+  error_scale = low_res_complexity >= 1.0 ? complexity / low_res_complexity
+                                          : area_scale;
+  *stats = info->stats[index % MR_STATS_SIZE];
+  stats->intra_error *= error_scale;
+  stats->coded_error *= error_scale;
+  stats->sr_coded_error *= error_scale;
+  stats->new_mv_count *= area_scale;
+  stats->MVr *= row_scale;
+  stats->mvr_abs *= row_scale;
+  stats->MVrv *= row_scale * row_scale;
+  stats->MVc *= col_scale;
+  stats->mvc_abs *= col_scale;
+  stats->MVcv *= col_scale * col_scale;
+  return 1;
+}
+
+// Get the information of the lower resolution on the frame 'cpi' codes.
+static const MR_FRAME_INFO *get_frame_info(const VP9_COMP *cpi) {
+  const MR_SHARED_INFO *const shared = cpi->oxcf.mr_low_res_mode_info;
+  return &shared->frame_info[cpi->common.show_frame];
+}
+
+static int is_low_res_frame(const VP9_COMP *cpi, const MR_FRAME_INFO *info) {
+  return cpi->oxcf.mr_encoder_id > 0 &&
+         info->frame_id == cpi->common.current_video_frame &&
+         !info->is_frame_dropped;
+}
+
+int vp9_mr_is_key_frame(const VP9_COMP *cpi) {
+  const MR_FRAME_INFO *const info = get_frame_info(cpi);
+
+  return is_low_res_frame(cpi, info) && info->frame_type == KEY_FRAME;
+}
+
+void vp9_mr_setup_frame(VP9_COMP *cpi) {
+  const VP9_COMMON *const cm = &cpi->common;
+  const MR_FRAME_INFO *const info = get_frame_info(cpi);
+  MV_REFERENCE_FRAME ref_frame;
+
+  // The GPU path searches fixed partition ranges from the source alone.
+  cpi->mr_low_res_info_avail = !cm->use_gpu && is_low_res_frame(cpi, info);
+
+  // Motion vectors are only comparable when both resolutions predict from
+  // the same frames.
+  for (ref_frame = LAST_FRAME; ref_frame <= ALTREF_FRAME; ++ref_frame)
+    cpi->mr_low_res_mv_avail[ref_frame] =
+        cpi->mr_low_res_info_avail && info->frame_type != KEY_FRAME &&
+        cm->frame_type != KEY_FRAME &&
+        info->ref_frame_ids[ref_frame] == cpi->mr_ref_frame_ids[ref_frame];
+}
+
+void vp9_mr_store_frame_info(VP9_COMP *cpi) {
+  const VP9_COMMON *const cm = &cpi->common;
+  const VP9EncoderConfig *const oxcf = &cpi->oxcf;
+  const unsigned int coded_frame_id =
+      2 * cm->current_video_frame + cm->show_frame;
+  MV_REFERENCE_FRAME ref_frame;
+
+  if (oxcf->mr_encoder_id < oxcf->mr_total_resolutions - 1) {
+    MR_SHARED_INFO *const shared = oxcf->mr_low_res_mode_info;
+    MR_FRAME_INFO *const info = &shared->frame_info[cm->show_frame];
+    int mi_row, mi_col;
+
+    info->frame_id = cm->current_video_frame;
+    info->frame_type = cm->frame_type;
+    info->is_frame_dropped = 0;
+    memcpy(info->ref_frame_ids, cpi->mr_ref_frame_ids,
+           sizeof(info->ref_frame_ids));
+    info->mi_rows = cm->mi_rows;
+    info->mi_cols = cm->mi_cols;
+
+    for (mi_row = 0; mi_row < cm->mi_rows; ++mi_row) {
+      MODE_INFO **mi = cm->mi_grid_visible + mi_row * cm->mi_stride;
+      MR_BLOCK_INFO *block = info->block_info + mi_row * cm->mi_cols;
+      for (mi_col = 0; mi_col < cm->mi_cols; ++mi_col, ++mi, ++block) {
+        const MB_MODE_INFO *const mbmi = &mi[0]->mbmi;
+        block->ref_frame = mbmi->ref_frame[0];
+        block->sb_type = mbmi->sb_type;
+        block->mv = mbmi->mv[0].as_mv;
+      }
+    }
+  }
+
+  for (ref_frame = LAST_FRAME; ref_frame <= ALTREF_FRAME; ++ref_frame) {
+    if (cm->frame_type == KEY_FRAME ||
+        (ref_frame == LAST_FRAME && cpi->refresh_last_frame) ||
+        (ref_frame == GOLDEN_FRAME && cpi->refresh_golden_frame) ||
+        (ref_frame == ALTREF_FRAME && cpi->refresh_alt_ref_frame))
+      cpi->mr_ref_frame_ids[ref_frame] = coded_frame_id;
+  }
+}
+
+void vp9_mr_store_drop_frame_info(VP9_COMP *cpi) {
+  const VP9EncoderConfig *const oxcf = &cpi->oxcf;
+
+  if (oxcf->mr_encoder_id < oxcf->mr_total_resolutions - 1) {
+    MR_SHARED_INFO *const shared = oxcf->mr_low_res_mode_info;
+    MR_FRAME_INFO *const info = &shared->frame_info[1];
+    info->frame_id = cpi->common.current_video_frame;
+    info->is_frame_dropped = 1;
+  }
+}
+
+int vp9_mr_get_pred_mv(const VP9_COMP *cpi, const MACROBLOCKD *xd,
+                       BLOCK_SIZE bsize, MV_REFERENCE_FRAME ref_frame,
+                       MV *mv) {
+  const MR_FRAME_INFO *const info = get_frame_info(cpi);
+  const vpx_rational_t *const dsf = &cpi->oxcf.mr_down_sampling_factor;
+  const int mi_row = -xd->mb_to_top_edge >> (3 + MI_SIZE_LOG2);
+  const int mi_col = -xd->mb_to_left_edge >> (3 + MI_SIZE_LOG2);
+  const MR_BLOCK_INFO *block;
+  int low_res_row, low_res_col;
+
+  if (!cpi->mr_low_res_mv_avail[ref_frame])
+    return 0;
+
+  // Take the block under the center of the current one.
+  low_res_row = (2 * mi_row + num_8x8_blocks_high_lookup[bsize]) * dsf->den /
+                (2 * dsf->num);
+  low_res_col = (2 * mi_col + num_8x8_blocks_wide_lookup[bsize]) * dsf->den /
+                (2 * dsf->num);
+  low_res_row = MIN(low_res_row, info->mi_rows - 1);
+  low_res_col = MIN(low_res_col, info->mi_cols - 1);
+  block = &info->block_info[low_res_row * info->mi_cols + low_res_col];
+  if (block->ref_frame != ref_frame)
+    return 0;
+
+  mv->row = block->mv.row * dsf->num / dsf->den;
+  mv->col = block->mv.col * dsf->num / dsf->den;
+  clamp_mv2(mv, xd);
+  return 1;
+}
+
+static BLOCK_SIZE scaled_square_size(BLOCK_SIZE bsize,
+                                     const vpx_rational_t *dsf) {
+  const int size = 4 * MAX(num_4x4_blocks_wide_lookup[bsize],
+                           num_4x4_blocks_high_lookup[bsize]) *
+                   dsf->num / dsf->den;
+
+  if (size <= 8)
+    return BLOCK_8X8;
+  else if (size <= 16)
+    return BLOCK_16X16;
+  else if (size <= 32)
+    return BLOCK_32X32;
+  else
+    return BLOCK_64X64;
+}
+
+int vp9_mr_get_partition_range(const VP9_COMP *cpi, int mi_row, int mi_col,
+                               BLOCK_SIZE *min_block_size,
+                               BLOCK_SIZE *max_block_size) {
+  const MR_FRAME_INFO *const info = get_frame_info(cpi);
+  const vpx_rational_t *const dsf = &cpi->oxcf.mr_down_sampling_factor;
+  BLOCK_SIZE min_size = BLOCK_64X64;
+  BLOCK_SIZE max_size = BLOCK_8X8;
+  int row_start, row_end, col_start, col_end;
+  int r, c;
+
+  if (!cpi->mr_low_res_info_avail)
+    return 0;
+
+  row_start = mi_row * dsf->den / dsf->num;
+  col_start = mi_col * dsf->den / dsf->num;
+  row_end = MIN(((mi_row + MI_BLOCK_SIZE) * dsf->den + dsf->num - 1) /
+                dsf->num, info->mi_rows);
+  col_end = MIN(((mi_col + MI_BLOCK_SIZE) * dsf->den + dsf->num - 1) /
+                dsf->num, info->mi_cols);
+  if (row_start >= row_end || col_start >= col_end)
+    return 0;
+
+  for (r = row_start; r < row_end; ++r) {
+    const MR_BLOCK_INFO *const block = info->block_info + r * info->mi_cols;
+    for (c = col_start; c < col_end; ++c) {
+      const BLOCK_SIZE size = scaled_square_size(block[c].sb_type, dsf);
+      min_size = MIN(min_size, size);
+      max_size = MAX(max_size, size);
+    }
+  }
+
+  *min_block_size = min_size;
+  *max_block_size = max_size;
+  return 1;
+}
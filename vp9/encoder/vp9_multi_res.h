@@ -0,0 +1,144 @@
+/*
+ *  Copyright (c) 2014 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef VP9_ENCODER_VP9_MULTI_RES_H_
+#define VP9_ENCODER_VP9_MULTI_RES_H_
+
+#include "vp9/common/vp9_blockd.h"
+#include "vp9/common/vp9_enums.h"
+#include "vp9/common/vp9_mv.h"
+
+#include "vpx_scale/yv12config.h"
+
+#include "vp9/encoder/vp9_firstpass.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// In multi-resolution encoding, the encoders run from the lowest resolution
+// to the highest one, one frame at a time. Each encoder publishes its coded
+// frames to the encoder of the next higher resolution, which places its key
+// frames on the same frames, and starts its motion and partition searches
+// from the co-located blocks. With lookahead statistics, the first pass only
+// runs at the lowest resolution, the others read its statistics scaled to
+// their size.
+
+// Coding decisions of an 8x8 block.
+typedef struct {
+  MV_REFERENCE_FRAME ref_frame;
+  BLOCK_SIZE sb_type;
+  MV mv;
+} MR_BLOCK_INFO;
+
+typedef struct {
+  // Index of the frame in the sequence, a hidden frame shares it with the
+  // next shown one.
+  unsigned int frame_id;
+  FRAME_TYPE frame_type;
+  int is_frame_dropped;
+  // Coded frame each reference frame was refreshed by, twice its frame_id
+  // plus its show_frame.
+  unsigned int ref_frame_ids[MAX_REF_FRAMES];
+  int mi_rows;
+  int mi_cols;
+  // Row-major, one entry per 8x8 block.
+  MR_BLOCK_INFO *block_info;
+} MR_FRAME_INFO;
+
+#define MR_STATS_SIZE 8
+
+typedef struct {
+  // Last hidden and shown frames, indexed by show_frame.
+  MR_FRAME_INFO frame_info[2];
+  // First pass statistics of the lowest resolution, the one of the n-th
+  // frame pushed is at n % MR_STATS_SIZE.
+  FIRSTPASS_STATS stats[MR_STATS_SIZE];
+  // Detail of the frames the statistics are from, see
+  // vp9_mr_source_complexity().
+  double stats_complexity[MR_STATS_SIZE];
+  unsigned int num_stats;
+  int stats_width;
+  int stats_height;
+  int stats_lag_in_frames;
+  int auto_key;
+} MR_SHARED_INFO;
+
+struct VP9_COMP;
+
+// Allocate the information shared by encoders of up to 'width' x 'height'
+// frames. Returns NULL on failure.
+MR_SHARED_INFO *vp9_mr_alloc_shared_info(int width, int height);
+
+void vp9_mr_free_shared_info(MR_SHARED_INFO *info);
+
+// Get the source frame at the resolution of the encoder. A larger 'sd' is
+// downscaled into a buffer of the encoder. Returns NULL and sets the error of
+// the encoder on failure.
+YV12_BUFFER_CONFIG *vp9_mr_scale_source(struct VP9_COMP *cpi,
+                                        YV12_BUFFER_CONFIG *sd);
+
+// Whether the encoder reads the first pass statistics of the lowest
+// resolution rather than running its own first pass.
+int vp9_mr_reads_stats(const struct VP9_COMP *cpi);
+
+// Get the sum of the luma variances of the 16x16 blocks of 'src'.
+double vp9_mr_source_complexity(const YV12_BUFFER_CONFIG *src);
+
+// Publish the first pass statistics of the next frame of the lowest
+// resolution, analyzed from 'src'.
+void vp9_mr_publish_stats(struct VP9_COMP *cpi, const FIRSTPASS_STATS *stats,
+                          const YV12_BUFFER_CONFIG *src);
+
+// Check the statistics of the lowest resolution can be read, with
+// 'num_pending' frames of the encoder waiting for theirs. Returns -1 and sets
+// the error of the encoder otherwise.
+int vp9_mr_check_stats(struct VP9_COMP *cpi, unsigned int num_pending);
+
+// Get the first pass statistics of the frame pushed 'index'-th, scaled to the
+// resolution of the encoder, where the frame has the given complexity.
+// Returns 0 if they are not published yet.
+int vp9_mr_get_stats(struct VP9_COMP *cpi, unsigned int index,
+                     double complexity, FIRSTPASS_STATS *stats);
+
+// Whether the lower resolution coded the current frame as a key frame.
+int vp9_mr_is_key_frame(const struct VP9_COMP *cpi);
+
+// Check which information of the lower resolution applies to the current
+// frame.
+void vp9_mr_setup_frame(struct VP9_COMP *cpi);
+
+// Publish the coded frame to the next higher resolution, then account for
+// the reference frames it refreshes.
+void vp9_mr_store_frame_info(struct VP9_COMP *cpi);
+
+// Publish a dropped frame to the next higher resolution.
+void vp9_mr_store_drop_frame_info(struct VP9_COMP *cpi);
+
+// Get the motion vector of the lower resolution block co-located with the
+// 'bsize' block of 'xd', scaled to the current resolution. Returns 0 if there
+// is none for 'ref_frame'.
+int vp9_mr_get_pred_mv(const struct VP9_COMP *cpi, const MACROBLOCKD *xd,
+                       BLOCK_SIZE bsize, MV_REFERENCE_FRAME ref_frame,
+                       MV *mv);
+
+// Get the range of the square block sizes covering the lower resolution
+// blocks co-located with the 64x64 block at 'mi_row', 'mi_col', scaled to the
+// current resolution. Returns 0 if the lower resolution is not available.
+int vp9_mr_get_partition_range(const struct VP9_COMP *cpi,
+                               int mi_row, int mi_col,
+                               BLOCK_SIZE *min_block_size,
+                               BLOCK_SIZE *max_block_size);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // VP9_ENCODER_VP9_MULTI_RES_H_
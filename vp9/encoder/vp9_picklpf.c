@@ -11,8 +11,6 @@
 #include <assert.h>
 #include <limits.h>
 
-#include "./vpx_scale_rtcd.h"
-
 #include "vpx_mem/vpx_mem.h"
 
 #include "vp9/common/vp9_loopfilter.h"
@@ -23,6 +21,38 @@
 #include "vp9/encoder/vp9_picklpf.h"
 #include "vp9/encoder/vp9_quantize.h"
 
+// Number of luma rows above a SB row that the filtering of the row reads. The
+// widest filter modifies all but the first of them.
+#define LPF_SEARCH_BORDER 8
+
+// Maximum number of filter levels evaluated in a single pass over the frame.
+#define LPF_SEARCH_MAX_LEVELS 3
+
+// The level search filters the reconstruction at several levels in a single
+// pass over the frame, one SB at a time, into scratch strips of a SB row: the
+// reconstruction is never modified. SBs are filtered in the same order as by
+// the loop filter itself, so the error at each level is the one of the frame
+// filtered at that level.
+typedef struct LPF_SEARCH {
+  const YV12_BUFFER_CONFIG *source;
+  // SB rows filtered in the pass.
+  int mi_row_start;
+  int mi_row_end;
+  int num_levels;
+  int levels[LPF_SEARCH_MAX_LEVELS];
+  // Filter level of the blocks at each of the levels.
+  loop_filter_info_n lfi[LPF_SEARCH_MAX_LEVELS];
+  // Two strips per level, used by alternate SB rows. A strip holds a SB row
+  // preceded by the LPF_SEARCH_BORDER rows above it, as filtered so far.
+  uint8_t *strips;
+  int strip_stride;
+  int strip_size;
+  // Error of each SB row at each level.
+  int64_t (*row_sse)[LPF_SEARCH_MAX_LEVELS];
+  int mi_cols;
+  int sb_rows;
+} LPF_SEARCH;
+
 static int get_max_filter_level(const VP9_COMP *cpi) {
   if (cpi->oxcf.pass == 2) {
     return cpi->twopass.section_intra_rating > 8 ? MAX_LOOP_FILTER * 3 / 4
@@ -32,28 +62,221 @@ static int get_max_filter_level(const VP9_COMP *cpi) {
   }
 }
 
+static LPF_SEARCH *alloc_search(VP9_COMP *cpi) {
+  VP9_COMMON *const cm = &cpi->common;
+  LPF_SEARCH *search = cpi->lpf_search;
+
+  if (search == NULL) {
+    CHECK_MEM_ERROR(cm, search, vpx_calloc(1, sizeof(*search)));
+    cpi->lpf_search = search;
+  }
+
+  if (search->mi_cols != cm->mi_cols || search->sb_rows != cm->sb_rows) {
+    const int strip_stride =
+        mi_cols_aligned_to_sb(cm->mi_cols) << MI_SIZE_LOG2;
+    const int strip_size =
+        ((MI_BLOCK_SIZE << MI_SIZE_LOG2) + LPF_SEARCH_BORDER) * strip_stride;
+
+    vpx_free(search->strips);
+    vpx_free(search->row_sse);
+    search->strips = NULL;
+    search->row_sse = NULL;
+    search->mi_cols = 0;
+    search->sb_rows = 0;
+    CHECK_MEM_ERROR(cm, search->strips,
+                    vpx_memalign(32, 2 * LPF_SEARCH_MAX_LEVELS * strip_size));
+    CHECK_MEM_ERROR(cm, search->row_sse,
+                    vpx_malloc(cm->sb_rows * sizeof(*search->row_sse)));
+    search->strip_stride = strip_stride;
+    search->strip_size = strip_size;
+    search->mi_cols = cm->mi_cols;
+    search->sb_rows = cm->sb_rows;
+  }
+  return search;
+}
+
+void vp9_lpf_search_free(LPF_SEARCH *search) {
+  if (search != NULL) {
+    vpx_free(search->strips);
+    vpx_free(search->row_sse);
+    vpx_free(search);
+  }
+}
+
+// Top left pixel of SB row 'sb_row' in its strip of level 'idx'.
+static uint8_t *get_strip(const LPF_SEARCH *search, int idx, int sb_row) {
+  return search->strips + (2 * idx + (sb_row & 1)) * search->strip_size +
+         LPF_SEARCH_BORDER * search->strip_stride;
+}
+
+static void copy_rows(const uint8_t *src, int src_stride,
+                      uint8_t *dst, int dst_stride, int width, int height) {
+  int r;
+
+  for (r = 0; r < height; ++r) {
+    vpx_memcpy(dst, src, width);
+    src += src_stride;
+    dst += dst_stride;
+  }
+}
 
-static int try_filter_frame(const YV12_BUFFER_CONFIG *sd, VP9_COMP *const cpi,
-                            int filt_level, int partial_frame) {
+void vp9_lpf_search_row(VP9_COMP *cpi, int mi_row, VP9ThreadStats *stats) {
   VP9_COMMON *const cm = &cpi->common;
-  int filt_err;
+  LPF_SEARCH *const search = cpi->lpf_search;
+  const YV12_BUFFER_CONFIG *const frame = cm->frame_to_show;
+  const YV12_BUFFER_CONFIG *const source = search->source;
+  const int use_row_sync = cpi->max_threads > 1;
+  const int stride = search->strip_stride;
+  const int sb_row = mi_row >> MI_BLOCK_SIZE_LOG2;
+  const int y = mi_row << MI_SIZE_LOG2;
+  const int height = MIN(MI_BLOCK_SIZE << MI_SIZE_LOG2, frame->y_height - y);
+  // The rows above the SB row are final once it is filtered, and so are its
+  // own rows but the bottom ones, unless no row below is filtered.
+  const int err_top = y > 0 ? -LPF_SEARCH_BORDER : 0;
+  const int err_bottom = mi_row + MI_BLOCK_SIZE >= search->mi_row_end ?
+      MIN(height, frame->y_crop_height - y) : height - LPF_SEARCH_BORDER;
+  const int src_offset = (y + err_top) * source->y_stride;
+  struct macroblockd_plane plane = cpi->mb.e_mbd.plane[0];
+  MODE_INFO **const mi = cm->mi_grid_visible + mi_row * cm->mi_stride;
+  int64_t sse[LPF_SEARCH_MAX_LEVELS] = { 0 };
+  struct vpx_usec_timer wait_timer;
+  int mi_col, i;
+
+  for (mi_col = 0; mi_col < cm->mi_cols; mi_col += MI_BLOCK_SIZE) {
+    const int sb_col = mi_col >> MI_BLOCK_SIZE_LOG2;
+    const int x = mi_col << MI_SIZE_LOG2;
+    const int width = MIN(MI_BLOCK_SIZE << MI_SIZE_LOG2, frame->y_width - x);
+    // The SB to the left is final once this one is filtered, and so is this
+    // one if it is the last of the row.
+    const int err_x = MAX(x - (MI_BLOCK_SIZE << MI_SIZE_LOG2), 0);
+    const int err_width = mi_col + MI_BLOCK_SIZE >= cm->mi_cols ?
+        frame->y_crop_width - err_x : x - err_x;
+
+    if (use_row_sync) {
+      vp9_stats_timer_start(stats, &wait_timer);
+      vp9_row_sync_read(&cpi->row_sync, sb_row, sb_col);
+      vp9_stats_timer_mark(stats, &wait_timer, &stats->wait_us);
+    }
+
+    for (i = 0; i < search->num_levels; ++i) {
+      uint8_t *const strip = get_strip(search, i, sb_row);
 
-  if (filt_level) {
-    vp9_loop_filter_frame_init(cm, filt_level);
+      // Take the rows above as left by the SB row above, and the unfiltered
+      // SB itself.
+      if (mi_row == search->mi_row_start) {
+        copy_rows(frame->y_buffer + (y + err_top) * frame->y_stride + x,
+                  frame->y_stride, strip + err_top * stride + x, stride,
+                  width, height - err_top);
+      } else {
+        copy_rows(get_strip(search, i, sb_row - 1) +
+                      ((MI_BLOCK_SIZE << MI_SIZE_LOG2) - LPF_SEARCH_BORDER) *
+                      stride + x,
+                  stride, strip - LPF_SEARCH_BORDER * stride + x, stride,
+                  width, LPF_SEARCH_BORDER);
+        copy_rows(frame->y_buffer + y * frame->y_stride + x, frame->y_stride,
+                  strip + x, stride, width, height);
+      }
+
+      if (search->levels[i]) {
+        LOOP_FILTER_MASK lfm;
+
+        vp9_setup_mask_lfi(cm, &search->lfi[i], mi_row, mi_col, mi + mi_col,
+                           cm->mi_stride, &lfm);
+        plane.dst.buf = strip + x;
+        plane.dst.stride = stride;
+        vp9_filter_block_plane(cm, &plane, mi_row, &lfm);
+      }
+
+      if (err_width > 0)
+        sse[i] += vp9_get_sse(source->y_buffer + src_offset + err_x,
+                              source->y_stride,
+                              strip + err_top * stride + err_x, stride,
+                              err_width, err_bottom - err_top);
+    }
+
+    // The strips of this row may be reused by the row below as soon as this
+    // is published.
+    if (use_row_sync)
+      vp9_row_sync_write(&cpi->row_sync, sb_row, sb_col, cm->sb_cols);
+  }
+
+  for (i = 0; i < search->num_levels; ++i)
+    search->row_sse[sb_row][i] = sse[i];
+}
+
+// Only the middle of the frame is filtered for a partial frame.
+static void get_search_rows(const VP9_COMMON *cm, int partial_frame,
+                            int *start_mi_row, int *end_mi_row) {
+  *start_mi_row = 0;
+  *end_mi_row = cm->mi_rows;
+  if (partial_frame && cm->mi_rows > 8) {
+    *start_mi_row = (cm->mi_rows >> 1) & ~(MI_BLOCK_SIZE - 1);
+    *end_mi_row = MIN(*start_mi_row + MAX(cm->mi_rows / 8, 8), cm->mi_rows);
   }
+}
 
-  if (cpi->max_threads > 1)
-    vp9e_loop_filter_frame_mt(cpi, filt_level, 1, 0);
-  else
-    vp9_loop_filter_frame(cm->frame_to_show, cm, &cpi->mb.e_mbd, filt_level, 1,
-                          partial_frame);
+// Error of the rows that the filtering of a partial frame leaves as they are,
+// the same at all levels. It is still part of the error of each level, as the
+// bias against higher levels is relative to it.
+static int64_t get_unfiltered_sse(const YV12_BUFFER_CONFIG *sd,
+                                  const VP9_COMMON *cm, int partial_frame) {
+  const YV12_BUFFER_CONFIG *const frame = cm->frame_to_show;
+  int start_mi_row, end_mi_row;
+  int top, bottom;
+  int64_t sse = 0;
 
-  filt_err = vp9_get_y_sse(sd, cm->frame_to_show);
+  get_search_rows(cm, partial_frame, &start_mi_row, &end_mi_row);
+  top = start_mi_row > 0 ?
+      (start_mi_row << MI_SIZE_LOG2) - LPF_SEARCH_BORDER : 0;
+  bottom = end_mi_row << MI_SIZE_LOG2;
+  if (top > 0)
+    sse += vp9_get_sse(sd->y_buffer, sd->y_stride,
+                       frame->y_buffer, frame->y_stride,
+                       frame->y_crop_width, top);
+  if (bottom < frame->y_crop_height)
+    sse += vp9_get_sse(sd->y_buffer + bottom * sd->y_stride, sd->y_stride,
+                       frame->y_buffer + bottom * frame->y_stride,
+                       frame->y_stride, frame->y_crop_width,
+                       frame->y_crop_height - bottom);
+  return sse;
+}
+
+// Set 'ss_err' of each of the 'num_levels' 'levels' to the error of the frame
+// filtered at that level, the rows left unfiltered having an error of
+// 'unfiltered_sse'.
+static void search_levels(const YV12_BUFFER_CONFIG *sd, VP9_COMP *cpi,
+                          const int *levels, int num_levels, int partial_frame,
+                          int64_t unfiltered_sse, int64_t *ss_err) {
+  VP9_COMMON *const cm = &cpi->common;
+  LPF_SEARCH *const search = alloc_search(cpi);
+  int start_mi_row, end_mi_row;
+  int mi_row, i;
+
+  assert(num_levels <= LPF_SEARCH_MAX_LEVELS);
+
+  get_search_rows(cm, partial_frame, &start_mi_row, &end_mi_row);
+  vp9_loop_filter_update_sharpness(cm);
+  search->source = sd;
+  search->mi_row_start = start_mi_row;
+  search->mi_row_end = end_mi_row;
+  search->num_levels = num_levels;
+  for (i = 0; i < num_levels; ++i) {
+    search->levels[i] = levels[i];
+    vp9_loop_filter_set_levels(cm, &search->lfi[i], levels[i]);
+  }
 
-  // Re-instate the unfiltered frame
-  vpx_yv12_copy_y(&cpi->last_frame_uf, cm->frame_to_show);
+  if (cpi->max_threads > 1) {
+    vp9e_lpf_search_mt(cpi, start_mi_row, end_mi_row);
+  } else {
+    for (mi_row = start_mi_row; mi_row < end_mi_row; mi_row += MI_BLOCK_SIZE)
+      vp9_lpf_search_row(cpi, mi_row, &cpi->thread_stats);
+  }
 
-  return filt_err;
+  for (i = 0; i < num_levels; ++i) {
+    ss_err[levels[i]] = unfiltered_sse;
+    for (mi_row = start_mi_row; mi_row < end_mi_row; mi_row += MI_BLOCK_SIZE)
+      ss_err[levels[i]] += search->row_sse[mi_row >> MI_BLOCK_SIZE_LOG2][i];
+  }
 }
 
 static int search_filter_level(const YV12_BUFFER_CONFIG *sd, VP9_COMP *cpi,
@@ -63,31 +286,41 @@ static int search_filter_level(const YV12_BUFFER_CONFIG *sd, VP9_COMP *cpi,
   const int min_filter_level = 0;
   const int max_filter_level = get_max_filter_level(cpi);
   int filt_direction = 0;
-  int best_err, filt_best;
+  const int64_t unfiltered_sse = get_unfiltered_sse(sd, cm, partial_frame);
+  int64_t best_err;
+  int filt_best;
+  int levels[LPF_SEARCH_MAX_LEVELS];
+  int num_levels = 0;
 
   // Start the search at the previous frame filter level unless it is now out of
   // range.
   int filt_mid = clamp(lf->filter_level, min_filter_level, max_filter_level);
   int filter_step = filt_mid < 16 ? 4 : filt_mid / 4;
   // Sum squared error at each filter level
-  int ss_err[MAX_LOOP_FILTER + 1];
+  int64_t ss_err[MAX_LOOP_FILTER + 1];
 
   // Set each entry to -1
   vpx_memset(ss_err, 0xFF, sizeof(ss_err));
 
-  //  Make a copy of the unfiltered / processed recon buffer
-  vpx_yv12_copy_y(cm->frame_to_show, &cpi->last_frame_uf);
+  // The first step always looks at the levels on both sides of the starting
+  // one, get all three in the same pass.
+  levels[num_levels++] = filt_mid;
+  if (filt_mid > min_filter_level)
+    levels[num_levels++] = MAX(filt_mid - filter_step, min_filter_level);
+  if (filt_mid < max_filter_level)
+    levels[num_levels++] = MIN(filt_mid + filter_step, max_filter_level);
+  search_levels(sd, cpi, levels, num_levels, partial_frame,
+                unfiltered_sse, ss_err);
 
-  best_err = try_filter_frame(sd, cpi, filt_mid, partial_frame);
+  best_err = ss_err[filt_mid];
   filt_best = filt_mid;
-  ss_err[filt_mid] = best_err;
 
   while (filter_step > 0) {
     const int filt_high = MIN(filt_mid + filter_step, max_filter_level);
     const int filt_low = MAX(filt_mid - filter_step, min_filter_level);
 
     // Bias against raising loop filter in favor of lowering it.
-    int bias = (best_err >> (15 - (filt_mid / 8))) * filter_step;
+    int64_t bias = (best_err >> (15 - (filt_mid / 8))) * filter_step;
 
     if ((cpi->oxcf.pass == 2) && (cpi->twopass.section_intra_rating < 20))
       bias = (bias * cpi->twopass.section_intra_rating) / 20;
@@ -96,11 +329,17 @@ static int search_filter_level(const YV12_BUFFER_CONFIG *sd, VP9_COMP *cpi,
     if (cm->tx_mode != ONLY_4X4)
       bias >>= 1;
 
+    // Get the error scores of the levels of this step that are not known yet.
+    num_levels = 0;
+    if (filt_direction <= 0 && filt_low != filt_mid && ss_err[filt_low] < 0)
+      levels[num_levels++] = filt_low;
+    if (filt_direction >= 0 && filt_high != filt_mid && ss_err[filt_high] < 0)
+      levels[num_levels++] = filt_high;
+    if (num_levels > 0)
+      search_levels(sd, cpi, levels, num_levels, partial_frame,
+                    unfiltered_sse, ss_err);
+
     if (filt_direction <= 0 && filt_low != filt_mid) {
-      // Get Low filter error score
-      if (ss_err[filt_low] < 0) {
-        ss_err[filt_low] = try_filter_frame(sd, cpi, filt_low, partial_frame);
-      }
       // If value is close to the best so far then bias towards a lower loop
       // filter value.
       if ((ss_err[filt_low] - bias) < best_err) {
@@ -114,9 +353,6 @@ static int search_filter_level(const YV12_BUFFER_CONFIG *sd, VP9_COMP *cpi,
 
     // Now look at filt_high
     if (filt_direction >= 0 && filt_high != filt_mid) {
-      if (ss_err[filt_high] < 0) {
-        ss_err[filt_high] = try_filter_frame(sd, cpi, filt_high, partial_frame);
-      }
       // Was it better than the previous best?
       if (ss_err[filt_high] < (best_err - bias)) {
         best_err = ss_err[filt_high];
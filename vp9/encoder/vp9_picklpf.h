@@ -17,12 +17,21 @@ extern "C" {
 #endif
 
 #include "vp9/encoder/vp9_encoder.h"
+#include "vp9/encoder/vp9_frame_stats.h"
 
 struct yv12_buffer_config;
 struct VP9_COMP;
+struct LPF_SEARCH;
 
 void vp9_pick_filter_level(const struct yv12_buffer_config *sd,
                            struct VP9_COMP *cpi, LPF_PICK_METHOD method);
+
+// Filter SB row 'mi_row' at each level of the current search pass, and add up
+// the error of its pixels that no other row modifies.
+void vp9_lpf_search_row(struct VP9_COMP *cpi, int mi_row,
+                        VP9ThreadStats *stats);
+
+void vp9_lpf_search_free(struct LPF_SEARCH *search);
 #ifdef __cplusplus
 }  // extern "C"
 #endif
@@ -616,13 +616,19 @@ void vp9_pick_inter_mode(VP9_COMP *cpi, MACROBLOCK *x,
         continue;
 
       if (this_mode == NEWMV) {
+        struct vpx_usec_timer timer;
+        int found;
+
         if (this_rd < (int64_t)(1 << num_pels_log2_lookup[bsize]))
           continue;
-        if (!combined_motion_search(cpi, x, bsize, mi_row, mi_col,
-                                    &frame_mv[NEWMV][ref_frame], &rate_mv,
-                                    best_rd)) {
+        vp9_stats_timer_start(x->stats, &timer);
+        found = combined_motion_search(cpi, x, bsize, mi_row, mi_col,
+                                       &frame_mv[NEWMV][ref_frame], &rate_mv,
+                                       best_rd);
+        vp9_stats_timer_mark(x->stats, &timer,
+                             &x->stats->stage_us[VP9E_STAGE_MOTION_SEARCH]);
+        if (!found)
           continue;
-        }
       }
 
       if (!x->data_parallel_processing &&
@@ -633,6 +639,7 @@ void vp9_pick_inter_mode(VP9_COMP *cpi, MACROBLOCK *x,
 
       mbmi->mode = this_mode;
       mbmi->mv[0].as_int = frame_mv[this_mode][ref_frame].as_int;
+      vp9_stats_count(x->stats, &x->stats->rd_evals, 1);
 
       // Search for the best prediction filter type, when the resulting
       // motion vector is at sub-pixel accuracy level for luma component, i.e.,
@@ -824,6 +831,7 @@ END:
 
     for (this_mode = DC_PRED; this_mode <= DC_PRED; ++this_mode) {
       const TX_SIZE saved_tx_size = mbmi->tx_size;
+      vp9_stats_count(x->stats, &x->stats->rd_evals, 1);
       args.mode = this_mode;
       args.rate = 0;
       args.dist = 0;
@@ -32,6 +32,9 @@
 #include "vp9/encoder/vp9_encodemv.h"
 #include "vp9/encoder/vp9_encoder.h"
 #include "vp9/encoder/vp9_mcomp.h"
+#if CONFIG_MULTI_RES_ENCODING
+#include "vp9/encoder/vp9_multi_res.h"
+#endif
 #include "vp9/encoder/vp9_quantize.h"
 #include "vp9/encoder/vp9_ratectrl.h"
 #include "vp9/encoder/vp9_rd.h"
@@ -194,7 +197,7 @@ static int compute_rd_thresh_factor(int qindex, vpx_bit_depth_t bit_depth) {
 
 void vp9_initialize_me_consts(MACROBLOCK *x, int qindex) {
 #if CONFIG_VP9_HIGHBITDEPTH
-  switch (cpi->common.bit_depth) {
+  switch (x->e_mbd.bd) {
     case VPX_BITS_8:
       x->sadperbit16 = sad_per_bit16lut_8[qindex];
       x->sadperbit4 = sad_per_bit4lut_8[qindex];
@@ -468,6 +471,7 @@ void vp9_mv_pred(VP9_COMP *cpi, MACROBLOCK *x,
         &ref_y_buffer[ref_y_stride * (this_mv->row >> 3) + (this_mv->col >> 3)];
 
     // Find sad for current vector.
+    vp9_stats_count(x->stats, &x->stats->sad_calls, 1);
     this_sad = cpi->fn_ptr[block_size].sdf(src_y_ptr, x->plane[0].src.stride,
                                            ref_y_ptr, ref_y_stride);
 
@@ -478,6 +482,27 @@ void vp9_mv_pred(VP9_COMP *cpi, MACROBLOCK *x,
     }
   }
 
+#if CONFIG_MULTI_RES_ENCODING
+  {
+    // The motion vector of the lower resolution replaces the last predicted
+    // one when it matches better.
+    MV mr_mv;
+    if (vp9_mr_get_pred_mv(cpi, xd, block_size, ref_frame, &mr_mv)) {
+      ref_y_ptr =
+          &ref_y_buffer[ref_y_stride * (mr_mv.row >> 3) + (mr_mv.col >> 3)];
+      vp9_stats_count(x->stats, &x->stats->sad_calls, 1);
+      this_sad = cpi->fn_ptr[block_size].sdf(src_y_ptr, x->plane[0].src.stride,
+                                             ref_y_ptr, ref_y_stride);
+      if (this_sad < best_sad) {
+        max_mv = MAX(max_mv, MAX(abs(mr_mv.row), abs(mr_mv.col)) >> 3);
+        x->pred_mv[ref_frame] = mr_mv;
+        best_sad = this_sad;
+        best_index = 2;
+      }
+    }
+  }
+#endif
+
   // Note the index of the mv that worked best in the reference list.
   x->mv_best_ref_index[ref_frame] = best_index;
   x->max_mv_context[ref_frame] = max_mv;
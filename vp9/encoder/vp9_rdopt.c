@@ -858,6 +858,7 @@ static int64_t rd_pick_intra_sby_mode(VP9_COMP *cpi, MACROBLOCK *x,
       bmode_costs = cpi->y_mode_costs[A][L];
     }
     mic->mbmi.mode = mode;
+    vp9_stats_count(x->stats, &x->stats->rd_evals, 1);
 
     super_block_yrd(cpi, x, &this_rate_tokenonly, &this_distortion,
         &s, NULL, bsize, local_tx_cache, best_rd);
@@ -958,6 +959,7 @@ static int64_t rd_pick_intra_sbuv_mode(VP9_COMP *cpi, MACROBLOCK *x,
       continue;
 
     xd->mi[0]->mbmi.uv_mode = mode;
+    vp9_stats_count(x->stats, &x->stats->rd_evals, 1);
 
     super_block_uvrd(cpi, x, &this_rate_tokenonly,
                      &this_distortion, &s, &this_sse, bsize, best_rd);
@@ -1368,6 +1370,7 @@ static int64_t rd_pick_best_sub8x8_mode(VP9_COMP *cpi, MACROBLOCK *x,
           MV mvp_full;
           int max_mv;
           int sad_list[5];
+          struct vpx_usec_timer timer;
 
           /* Is the best so far sufficiently good that we cant justify doing
            * and new motion search. */
@@ -1411,6 +1414,7 @@ static int64_t rd_pick_best_sub8x8_mode(VP9_COMP *cpi, MACROBLOCK *x,
 
           vp9_set_mv_search_range(x, &bsi->ref_mv[0]->as_mv);
 
+          vp9_stats_timer_start(x->stats, &timer);
           bestsme = vp9_full_pixel_search(
               cpi, x, bsize, &mvp_full, step_param, sadpb,
               cpi->sf.mv.subpel_search_method != SUBPEL_TREE ? sad_list : NULL,
@@ -1457,6 +1461,8 @@ static int64_t rd_pick_best_sub8x8_mode(VP9_COMP *cpi, MACROBLOCK *x,
             // save motion search result for use in compound prediction
             seg_mvs[i][mbmi->ref_frame[0]].as_mv = *new_mv;
           }
+          vp9_stats_timer_mark(x->stats, &timer,
+                               &x->stats->stage_us[VP9E_STAGE_MOTION_SEARCH]);
 
           if (cpi->sf.adaptive_motion_search)
             x->pred_mv[mbmi->ref_frame[0]] = *new_mv;
@@ -1477,9 +1483,14 @@ static int64_t rd_pick_best_sub8x8_mode(VP9_COMP *cpi, MACROBLOCK *x,
           mi_buf_shift(x, i);
           if (cpi->sf.comp_inter_joint_search_thresh <= bsize) {
             int rate_mv;
+            struct vpx_usec_timer timer;
+
+            vp9_stats_timer_start(x->stats, &timer);
             joint_motion_search(cpi, x, bsize, frame_mv[this_mode],
                                 mi_row, mi_col, seg_mvs[i],
                                 &rate_mv);
+            vp9_stats_timer_mark(x->stats, &timer,
+                                 &x->stats->stage_us[VP9E_STAGE_MOTION_SEARCH]);
             seg_mvs[i][mbmi->ref_frame[0]].as_int =
                 frame_mv[this_mode][mbmi->ref_frame[0]].as_int;
             seg_mvs[i][mbmi->ref_frame[1]].as_int =
@@ -2189,14 +2200,18 @@ static int64_t handle_inter_mode(VP9_COMP *cpi, MACROBLOCK *x,
 
   if (this_mode == NEWMV) {
     int rate_mv;
+    struct vpx_usec_timer timer;
     if (is_comp_pred) {
       // Initialize mv using single prediction mode result.
       frame_mv[refs[0]].as_int = single_newmv[refs[0]].as_int;
       frame_mv[refs[1]].as_int = single_newmv[refs[1]].as_int;
 
       if (cpi->sf.comp_inter_joint_search_thresh <= bsize) {
+        vp9_stats_timer_start(x->stats, &timer);
         joint_motion_search(cpi, x, bsize, frame_mv,
                             mi_row, mi_col, single_newmv, &rate_mv);
+        vp9_stats_timer_mark(x->stats, &timer,
+                             &x->stats->stage_us[VP9E_STAGE_MOTION_SEARCH]);
       } else {
         rate_mv  = vp9_mv_bit_cost(&frame_mv[refs[0]].as_mv,
                                    &mbmi->ref_mvs[refs[0]][0].as_mv,
@@ -2208,8 +2223,11 @@ static int64_t handle_inter_mode(VP9_COMP *cpi, MACROBLOCK *x,
       *rate2 += rate_mv;
     } else {
       int_mv tmp_mv;
+      vp9_stats_timer_start(x->stats, &timer);
       single_motion_search(cpi, x, bsize, mi_row, mi_col,
                            &tmp_mv, &rate_mv);
+      vp9_stats_timer_mark(x->stats, &timer,
+                           &x->stats->stage_us[VP9E_STAGE_MOTION_SEARCH]);
       if (tmp_mv.as_int == INVALID_MV)
         return INT64_MAX;
       *rate2 += rate_mv;
@@ -2866,6 +2884,8 @@ int64_t vp9_rd_pick_inter_mode_sb(VP9_COMP *cpi, MACROBLOCK *x,
         xd->plane[i].pre[1] = yv12_mb[second_ref_frame][i];
     }
 
+    vp9_stats_count(x->stats, &x->stats->rd_evals, 1);
+
     for (i = 0; i < TX_MODES; ++i)
       tx_cache[i] = INT64_MAX;
 
@@ -3191,6 +3211,11 @@ int64_t vp9_rd_pick_inter_mode_sb_seg_skip(VP9_COMP *cpi, MACROBLOCK *x,
   MB_MODE_INFO *const mbmi = &xd->mi[0]->mbmi;
   unsigned char segment_id = mbmi->segment_id;
   const int comp_pred = 0;
+  // The decoder infers the reference of a segment that codes one.
+  const MV_REFERENCE_FRAME ref_frame =
+      vp9_segfeature_active(&cm->seg, segment_id, SEG_LVL_REF_FRAME) ?
+          vp9_get_segdata(&cm->seg, segment_id, SEG_LVL_REF_FRAME) :
+          LAST_FRAME;
   int i;
   int64_t best_tx_diff[TX_MODES];
   int64_t best_pred_diff[REFERENCE_MODES];
@@ -3218,7 +3243,7 @@ int64_t vp9_rd_pick_inter_mode_sb_seg_skip(VP9_COMP *cpi, MACROBLOCK *x,
 
   mbmi->mode = ZEROMV;
   mbmi->uv_mode = DC_PRED;
-  mbmi->ref_frame[0] = LAST_FRAME;
+  mbmi->ref_frame[0] = ref_frame;
   mbmi->ref_frame[1] = NONE;
   mbmi->mv[0].as_int = 0;
   x->skip = 1;
@@ -3258,7 +3283,7 @@ int64_t vp9_rd_pick_inter_mode_sb_seg_skip(VP9_COMP *cpi, MACROBLOCK *x,
 
   // Estimate the reference frame signaling cost and add it
   // to the rolling cost variable.
-  rate2 += ref_costs_single[LAST_FRAME];
+  rate2 += ref_costs_single[ref_frame];
   this_rd = RDCOST(x->rdmult, x->rddiv, rate2, distortion2);
 
   *returnrate = rate2;
@@ -3480,6 +3505,8 @@ int64_t vp9_rd_pick_inter_mode_sub8x8(VP9_COMP *cpi, MACROBLOCK *x,
         xd->plane[i].pre[1] = yv12_mb[second_ref_frame][i];
     }
 
+    vp9_stats_count(x->stats, &x->stats->rd_evals, 1);
+
     if (ref_frame == INTRA_FRAME) {
       int rate;
       if (rd_pick_intra_sub_8x8_y_mode(cpi, x, &rate, &rate_y,
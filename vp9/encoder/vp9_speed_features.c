@@ -431,6 +431,9 @@ void vp9_set_speed_features(VP9_COMP *cpi) {
     sf->max_delta_qindex = 0;
   }
 
+  if (cpi->oxcf.static_segmentation)
+    sf->static_segmentation = 1;
+
   if (cpi->encode_breakout && oxcf->mode == REALTIME &&
       sf->encode_breakout_thresh > cpi->encode_breakout)
     cpi->encode_breakout = sf->encode_breakout_thresh;
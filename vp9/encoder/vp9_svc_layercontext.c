@@ -234,12 +234,13 @@ int vp9_is_upper_layer_key_frame(const VP9_COMP *const cpi) {
 
 #if CONFIG_SPATIAL_SVC
 int vp9_svc_lookahead_push(const VP9_COMP *const cpi, struct lookahead_ctx *ctx,
-                           YV12_BUFFER_CONFIG *src, int64_t ts_start,
-                           int64_t ts_end, unsigned int flags) {
+                           YV12_BUFFER_CONFIG *src, const vpx_image_t *img,
+                           int64_t ts_start, int64_t ts_end,
+                           unsigned int flags) {
   struct lookahead_entry *buf;
   int i, index;
 
-  if (vp9_lookahead_push(ctx, src, ts_start, ts_end, flags))
+  if (vp9_lookahead_push(ctx, src, img, ts_start, ts_end, flags))
     return 1;
 
   index = ctx->write_idx - 1;
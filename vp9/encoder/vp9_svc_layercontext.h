@@ -92,8 +92,8 @@ int vp9_is_upper_layer_key_frame(const struct VP9_COMP *const cpi);
 // with the expected stride/border
 int vp9_svc_lookahead_push(const struct VP9_COMP *const cpi,
                            struct lookahead_ctx *ctx, YV12_BUFFER_CONFIG *src,
-                           int64_t ts_start, int64_t ts_end,
-                           unsigned int flags);
+                           const vpx_image_t *img, int64_t ts_start,
+                           int64_t ts_end, unsigned int flags);
 
 // Get the next source buffer to encode
 struct lookahead_entry *vp9_svc_lookahead_pop(struct VP9_COMP *const cpi,
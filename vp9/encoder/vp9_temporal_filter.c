@@ -18,6 +18,7 @@
 #include "vp9/common/vp9_systemdependent.h"
 #include "vp9/encoder/vp9_extend.h"
 #include "vp9/encoder/vp9_firstpass.h"
+#include "vp9/encoder/vp9_frame_stats.h"
 #include "vp9/encoder/vp9_mcomp.h"
 #include "vp9/encoder/vp9_encoder.h"
 #include "vp9/encoder/vp9_quantize.h"
@@ -134,10 +135,11 @@ void vp9_temporal_filter_apply_c(uint8_t *frame1,
 }
 
 static int temporal_filter_find_matching_mb_c(VP9_COMP *cpi,
+                                              MACROBLOCK *x,
                                               uint8_t *arf_frame_buf,
                                               uint8_t *frame_ptr_buf,
-                                              int stride) {
-  MACROBLOCK *const x = &cpi->mb;
+                                              int stride,
+                                              MV *ref_mv) {
   MACROBLOCKD *const xd = &x->e_mbd;
   const MV_SPEED_FEATURES *const mv_sf = &cpi->sf.mv;
   int step_param;
@@ -149,7 +151,6 @@ static int temporal_filter_find_matching_mb_c(VP9_COMP *cpi,
 
   MV best_ref_mv1 = {0, 0};
   MV best_ref_mv1_full; /* full-pixel value of best_ref_mv1 */
-  MV *ref_mv = &x->e_mbd.mi[0]->bmi[0].as_mv[0].as_mv;
 
   // Save input state
   struct buf_2d src = x->plane[0].src;
@@ -190,173 +191,265 @@ static int temporal_filter_find_matching_mb_c(VP9_COMP *cpi,
   return bestsme;
 }
 
-static void temporal_filter_iterate_c(VP9_COMP *cpi,
-                                      YV12_BUFFER_CONFIG **frames,
-                                      int frame_count,
-                                      int alt_ref_index,
-                                      int strength,
-                                      struct scale_factors *scale) {
+// Frames the alt-ref frame is filtered from, shared by the threads filtering
+// its MB rows.
+typedef struct {
+  YV12_BUFFER_CONFIG **frames;
+  int frame_count;
+  int alt_ref_index;
+  int strength;
+  struct scale_factors *scale;
+} TEMPORAL_FILTER_DATA;
+
+// Filter MB row 'mb_row' of the alt-ref frame with 'x'. The MBs are filtered
+// independently of each other, so the rows can be filtered in any order.
+static void temporal_filter_row(VP9_COMP *cpi, MACROBLOCK *x,
+                                const TEMPORAL_FILTER_DATA *tf, int mb_row) {
+  YV12_BUFFER_CONFIG **const frames = tf->frames;
+  const int alt_ref_index = tf->alt_ref_index;
   int byte;
   int frame;
-  int mb_col, mb_row;
+  int mb_col;
   unsigned int filter_weight;
   int mb_cols = (frames[alt_ref_index]->y_crop_width + 15) >> 4;
   int mb_rows = (frames[alt_ref_index]->y_crop_height + 15) >> 4;
-  int mb_y_offset = 0;
-  int mb_uv_offset = 0;
   DECLARE_ALIGNED_ARRAY(16, unsigned int, accumulator, 16 * 16 * 3);
   DECLARE_ALIGNED_ARRAY(16, uint16_t, count, 16 * 16 * 3);
-  MACROBLOCKD *mbd = &cpi->mb.e_mbd;
+  MACROBLOCKD *mbd = &x->e_mbd;
   YV12_BUFFER_CONFIG *f = frames[alt_ref_index];
   uint8_t *dst1, *dst2;
   DECLARE_ALIGNED_ARRAY(16, uint8_t,  predictor, 16 * 16 * 3);
   const int mb_uv_height = 16 >> mbd->plane[1].subsampling_y;
   const int mb_uv_width  = 16 >> mbd->plane[1].subsampling_x;
+  int mb_y_offset = mb_row * 16 * f->y_stride;
+  int mb_uv_offset = mb_row * mb_uv_height * f->uv_stride;
+
+  // Source frames are extended to 16 pixels. This is different than
+  //  L/A/G reference frames that have a border of 32 (VP9ENCBORDERINPIXELS)
+  // A 6/8 tap filter is used for motion search.  This requires 2 pixels
+  //  before and 3 pixels after.  So the largest Y mv on a border would
+  //  then be 16 - VP9_INTERP_EXTEND. The UV blocks are half the size of the
+  //  Y and therefore only extended by 8.  The largest mv that a UV block
+  //  can support is 8 - VP9_INTERP_EXTEND.  A UV mv is half of a Y mv.
+  //  (16 - VP9_INTERP_EXTEND) >> 1 which is greater than
+  //  8 - VP9_INTERP_EXTEND.
+  // To keep the mv in play for both Y and UV planes the max that it
+  //  can be on a border is therefore 16 - (2*VP9_INTERP_EXTEND+1).
+  x->mv_row_min = -((mb_row * 16) + (17 - 2 * VP9_INTERP_EXTEND));
+  x->mv_row_max = ((mb_rows - 1 - mb_row) * 16)
+                  + (17 - 2 * VP9_INTERP_EXTEND);
+
+  for (mb_col = 0; mb_col < mb_cols; mb_col++) {
+    int i, j, k;
+    int stride;
+
+    vpx_memset(accumulator, 0, 16 * 16 * 3 * sizeof(accumulator[0]));
+    vpx_memset(count, 0, 16 * 16 * 3 * sizeof(count[0]));
+
+    x->mv_col_min = -((mb_col * 16) + (17 - 2 * VP9_INTERP_EXTEND));
+    x->mv_col_max = ((mb_cols - 1 - mb_col) * 16)
+                    + (17 - 2 * VP9_INTERP_EXTEND);
+
+    for (frame = 0; frame < tf->frame_count; frame++) {
+      const int thresh_low  = 10000;
+      const int thresh_high = 20000;
+      MV mv = {0, 0};
+
+      if (frames[frame] == NULL)
+        continue;
+
+      if (frame == alt_ref_index) {
+        filter_weight = 2;
+      } else {
+        // Find best match in this frame by MC
+        int err = temporal_filter_find_matching_mb_c(cpi, x,
+            frames[alt_ref_index]->y_buffer + mb_y_offset,
+            frames[frame]->y_buffer + mb_y_offset,
+            frames[frame]->y_stride, &mv);
+
+        // Assign higher weight to matching MB if it's error
+        // score is lower. If not applying MC default behavior
+        // is to weight all MBs equal.
+        filter_weight = err < thresh_low
+                        ? 2 : err < thresh_high ? 1 : 0;
+      }
 
-  // Save input state
-  uint8_t* input_buffer[MAX_MB_PLANE];
-  int i;
-
-  for (i = 0; i < MAX_MB_PLANE; i++)
-    input_buffer[i] = mbd->plane[i].pre[0].buf;
-
-  for (mb_row = 0; mb_row < mb_rows; mb_row++) {
-    // Source frames are extended to 16 pixels. This is different than
-    //  L/A/G reference frames that have a border of 32 (VP9ENCBORDERINPIXELS)
-    // A 6/8 tap filter is used for motion search.  This requires 2 pixels
-    //  before and 3 pixels after.  So the largest Y mv on a border would
-    //  then be 16 - VP9_INTERP_EXTEND. The UV blocks are half the size of the
-    //  Y and therefore only extended by 8.  The largest mv that a UV block
-    //  can support is 8 - VP9_INTERP_EXTEND.  A UV mv is half of a Y mv.
-    //  (16 - VP9_INTERP_EXTEND) >> 1 which is greater than
-    //  8 - VP9_INTERP_EXTEND.
-    // To keep the mv in play for both Y and UV planes the max that it
-    //  can be on a border is therefore 16 - (2*VP9_INTERP_EXTEND+1).
-    cpi->mb.mv_row_min = -((mb_row * 16) + (17 - 2 * VP9_INTERP_EXTEND));
-    cpi->mb.mv_row_max = ((mb_rows - 1 - mb_row) * 16)
-                         + (17 - 2 * VP9_INTERP_EXTEND);
-
-    for (mb_col = 0; mb_col < mb_cols; mb_col++) {
-      int i, j, k;
-      int stride;
-
-      vpx_memset(accumulator, 0, 16 * 16 * 3 * sizeof(accumulator[0]));
-      vpx_memset(count, 0, 16 * 16 * 3 * sizeof(count[0]));
-
-      cpi->mb.mv_col_min = -((mb_col * 16) + (17 - 2 * VP9_INTERP_EXTEND));
-      cpi->mb.mv_col_max = ((mb_cols - 1 - mb_col) * 16)
-                           + (17 - 2 * VP9_INTERP_EXTEND);
-
-      for (frame = 0; frame < frame_count; frame++) {
-        const int thresh_low  = 10000;
-        const int thresh_high = 20000;
-
-        if (frames[frame] == NULL)
-          continue;
-
-        mbd->mi[0]->bmi[0].as_mv[0].as_mv.row = 0;
-        mbd->mi[0]->bmi[0].as_mv[0].as_mv.col = 0;
-
-        if (frame == alt_ref_index) {
-          filter_weight = 2;
-        } else {
-          // Find best match in this frame by MC
-          int err = temporal_filter_find_matching_mb_c(cpi,
-              frames[alt_ref_index]->y_buffer + mb_y_offset,
-              frames[frame]->y_buffer + mb_y_offset,
-              frames[frame]->y_stride);
-
-          // Assign higher weight to matching MB if it's error
-          // score is lower. If not applying MC default behavior
-          // is to weight all MBs equal.
-          filter_weight = err < thresh_low
-                          ? 2 : err < thresh_high ? 1 : 0;
-        }
-
-        if (filter_weight != 0) {
-          // Construct the predictors
-          temporal_filter_predictors_mb_c(mbd,
-              frames[frame]->y_buffer + mb_y_offset,
-              frames[frame]->u_buffer + mb_uv_offset,
-              frames[frame]->v_buffer + mb_uv_offset,
-              frames[frame]->y_stride,
-              mb_uv_width, mb_uv_height,
-              mbd->mi[0]->bmi[0].as_mv[0].as_mv.row,
-              mbd->mi[0]->bmi[0].as_mv[0].as_mv.col,
-              predictor, scale,
-              mb_col * 16, mb_row * 16);
-
-          // Apply the filter (YUV)
-          vp9_temporal_filter_apply(f->y_buffer + mb_y_offset, f->y_stride,
-                                    predictor, 16, 16,
-                                    strength, filter_weight,
-                                    accumulator, count);
-          vp9_temporal_filter_apply(f->u_buffer + mb_uv_offset, f->uv_stride,
-                                    predictor + 256,
-                                    mb_uv_width, mb_uv_height, strength,
-                                    filter_weight, accumulator + 256,
-                                    count + 256);
-          vp9_temporal_filter_apply(f->v_buffer + mb_uv_offset, f->uv_stride,
-                                    predictor + 512,
-                                    mb_uv_width, mb_uv_height, strength,
-                                    filter_weight, accumulator + 512,
-                                    count + 512);
-        }
+      if (filter_weight != 0) {
+        // Construct the predictors
+        temporal_filter_predictors_mb_c(mbd,
+            frames[frame]->y_buffer + mb_y_offset,
+            frames[frame]->u_buffer + mb_uv_offset,
+            frames[frame]->v_buffer + mb_uv_offset,
+            frames[frame]->y_stride,
+            mb_uv_width, mb_uv_height,
+            mv.row, mv.col,
+            predictor, tf->scale,
+            mb_col * 16, mb_row * 16);
+
+        // Apply the filter (YUV)
+        vp9_temporal_filter_apply(f->y_buffer + mb_y_offset, f->y_stride,
+                                  predictor, 16, 16,
+                                  tf->strength, filter_weight,
+                                  accumulator, count);
+        vp9_temporal_filter_apply(f->u_buffer + mb_uv_offset, f->uv_stride,
+                                  predictor + 256,
+                                  mb_uv_width, mb_uv_height, tf->strength,
+                                  filter_weight, accumulator + 256,
+                                  count + 256);
+        vp9_temporal_filter_apply(f->v_buffer + mb_uv_offset, f->uv_stride,
+                                  predictor + 512,
+                                  mb_uv_width, mb_uv_height, tf->strength,
+                                  filter_weight, accumulator + 512,
+                                  count + 512);
       }
+    }
 
-      // Normalize filter output to produce AltRef frame
-      dst1 = cpi->alt_ref_buffer.y_buffer;
-      stride = cpi->alt_ref_buffer.y_stride;
-      byte = mb_y_offset;
-      for (i = 0, k = 0; i < 16; i++) {
-        for (j = 0; j < 16; j++, k++) {
-          unsigned int pval = accumulator[k] + (count[k] >> 1);
-          pval *= fixed_divide[count[k]];
-          pval >>= 19;
-
-          dst1[byte] = (uint8_t)pval;
-
-          // move to next pixel
-          byte++;
-        }
-        byte += stride - 16;
+    // Normalize filter output to produce AltRef frame
+    dst1 = cpi->alt_ref_buffer.y_buffer;
+    stride = cpi->alt_ref_buffer.y_stride;
+    byte = mb_y_offset;
+    for (i = 0, k = 0; i < 16; i++) {
+      for (j = 0; j < 16; j++, k++) {
+        unsigned int pval = accumulator[k] + (count[k] >> 1);
+        pval *= fixed_divide[count[k]];
+        pval >>= 19;
+
+        dst1[byte] = (uint8_t)pval;
+
+        // move to next pixel
+        byte++;
       }
+      byte += stride - 16;
+    }
 
-      dst1 = cpi->alt_ref_buffer.u_buffer;
-      dst2 = cpi->alt_ref_buffer.v_buffer;
-      stride = cpi->alt_ref_buffer.uv_stride;
-      byte = mb_uv_offset;
-      for (i = 0, k = 256; i < mb_uv_height; i++) {
-        for (j = 0; j < mb_uv_width; j++, k++) {
-          int m = k + 256;
-
-          // U
-          unsigned int pval = accumulator[k] + (count[k] >> 1);
-          pval *= fixed_divide[count[k]];
-          pval >>= 19;
-          dst1[byte] = (uint8_t)pval;
-
-          // V
-          pval = accumulator[m] + (count[m] >> 1);
-          pval *= fixed_divide[count[m]];
-          pval >>= 19;
-          dst2[byte] = (uint8_t)pval;
-
-          // move to next pixel
-          byte++;
-        }
-        byte += stride - mb_uv_width;
+    dst1 = cpi->alt_ref_buffer.u_buffer;
+    dst2 = cpi->alt_ref_buffer.v_buffer;
+    stride = cpi->alt_ref_buffer.uv_stride;
+    byte = mb_uv_offset;
+    for (i = 0, k = 256; i < mb_uv_height; i++) {
+      for (j = 0; j < mb_uv_width; j++, k++) {
+        int m = k + 256;
+
+        // U
+        unsigned int pval = accumulator[k] + (count[k] >> 1);
+        pval *= fixed_divide[count[k]];
+        pval >>= 19;
+        dst1[byte] = (uint8_t)pval;
+
+        // V
+        pval = accumulator[m] + (count[m] >> 1);
+        pval *= fixed_divide[count[m]];
+        pval >>= 19;
+        dst2[byte] = (uint8_t)pval;
+
+        // move to next pixel
+        byte++;
       }
-      mb_y_offset += 16;
-      mb_uv_offset += mb_uv_width;
+      byte += stride - mb_uv_width;
     }
-    mb_y_offset += 16 * (f->y_stride - mb_cols);
-    mb_uv_offset += mb_uv_height * f->uv_stride - mb_uv_width * mb_cols;
+    mb_y_offset += 16;
+    mb_uv_offset += mb_uv_width;
   }
+}
 
-  // Restore input state
-  for (i = 0; i < MAX_MB_PLANE; i++)
-    mbd->plane[i].pre[0].buf = input_buffer[i];
+// Row-based multi-threaded hook of the temporal filter.
+static int temporal_filter_thread_process(thread_context *const thread_ctxt,
+                                          const TEMPORAL_FILTER_DATA *tf) {
+  VP9_COMP *const cpi = thread_ctxt->cpi;
+  MACROBLOCK *const x = &thread_ctxt->mb;
+  const YV12_BUFFER_CONFIG *const f = tf->frames[tf->alt_ref_index];
+  const int mb_rows = (f->y_crop_height + 15) >> 4;
+  struct vpx_usec_timer timer;
+  int mb_row;
+
+  vp9_stats_timer_start(&thread_ctxt->stats, &timer);
+  vp9_mb_copy(cpi, x, &cpi->mb);
+  x->thread_id = thread_ctxt->thread_id;
+  x->stats = &thread_ctxt->stats;
+
+  // The MB rows do not depend on each other, only the row queue of the row
+  // synchronization is used.
+  while ((mb_row = vp9_row_sync_next_row(&cpi->row_sync)) < mb_rows)
+    temporal_filter_row(cpi, x, tf, mb_row);
+
+  vp9_stats_timer_mark(x->stats, &timer, &x->stats->pass_us);
+  return 1;
+}
+
+static void run_temporal_filter_threads(VP9_COMP *cpi,
+                                        TEMPORAL_FILTER_DATA *tf) {
+  const VP9WorkerInterface *const winterface = vp9_get_worker_interface();
+  struct vpx_usec_timer timer;
+  int thread_id;
+
+  vp9_stats_timer_start(&cpi->thread_stats, &timer);
+
+  vp9_row_sync_reset(&cpi->row_sync);
+
+  for (thread_id = 0; thread_id < cpi->max_threads; ++thread_id) {
+    VP9Worker *const worker = &cpi->enc_thread_hndl[thread_id];
+    thread_context *const thread_ctxt = (thread_context *)worker->data1;
+
+    worker->hook = (VP9WorkerHook)temporal_filter_thread_process;
+    worker->data2 = tf;
+    thread_ctxt->cpi = cpi;
+    thread_ctxt->thread_id = thread_id;
+
+    if (thread_id == cpi->max_threads - 1)
+      winterface->execute(worker);
+    else
+      winterface->launch(worker);
+  }
+
+  // Wait till all rows are finished. The data of the filter does not belong
+  // to the threads.
+  for (thread_id = 0; thread_id < cpi->max_threads; ++thread_id) {
+    winterface->sync(&cpi->enc_thread_hndl[thread_id]);
+    cpi->enc_thread_hndl[thread_id].data2 = NULL;
+  }
+
+  if (cpi->thread_stats.enabled) {
+    vpx_usec_timer_mark(&timer);
+    vp9_frame_stats_end_pass(cpi, VP9E_STAGE_TEMPORAL_FILTER,
+                             vpx_usec_timer_elapsed(&timer));
+  }
+}
+
+static void temporal_filter_iterate_c(VP9_COMP *cpi,
+                                      YV12_BUFFER_CONFIG **frames,
+                                      int frame_count,
+                                      int alt_ref_index,
+                                      int strength,
+                                      struct scale_factors *scale) {
+  TEMPORAL_FILTER_DATA tf;
+
+  tf.frames = frames;
+  tf.frame_count = frame_count;
+  tf.alt_ref_index = alt_ref_index;
+  tf.strength = strength;
+  tf.scale = scale;
+
+  if (cpi->max_threads > 1) {
+    run_temporal_filter_threads(cpi, &tf);
+  } else {
+    const int mb_rows = (frames[alt_ref_index]->y_crop_height + 15) >> 4;
+    MACROBLOCKD *mbd = &cpi->mb.e_mbd;
+    int mb_row;
+
+    // Save input state
+    uint8_t* input_buffer[MAX_MB_PLANE];
+    int i;
+
+    for (i = 0; i < MAX_MB_PLANE; i++)
+      input_buffer[i] = mbd->plane[i].pre[0].buf;
+
+    for (mb_row = 0; mb_row < mb_rows; mb_row++)
+      temporal_filter_row(cpi, &cpi->mb, &tf, mb_row);
+
+    // Restore input state
+    for (i = 0; i < MAX_MB_PLANE; i++)
+      mbd->plane[i].pre[0].buf = input_buffer[i];
+  }
 }
 
 // Apply buffer limits and context specific adjustments to arnr filter.
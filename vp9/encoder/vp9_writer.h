@@ -24,10 +24,15 @@ typedef struct {
   unsigned int range;
   int count;
   unsigned int pos;
+  // Nothing is written at 'size' or beyond: 'error' is set instead.
+  unsigned int size;
+  int error;
   uint8_t *buffer;
 } vp9_writer;
 
 void vp9_start_encode(vp9_writer *bc, uint8_t *buffer);
+// Same as vp9_start_encode(), for a buffer of 'size' bytes.
+void vp9_start_encode_size(vp9_writer *bc, uint8_t *buffer, unsigned int size);
 void vp9_stop_encode(vp9_writer *bc);
 
 static INLINE void vp9_write(vp9_writer *br, int bit, int probability) {
@@ -65,7 +70,10 @@ static INLINE void vp9_write(vp9_writer *br, int bit, int probability) {
       br->buffer[x] += 1;
     }
 
-    br->buffer[br->pos++] = (lowvalue >> (24 - offset));
+    if (br->pos < br->size)
+      br->buffer[br->pos++] = (lowvalue >> (24 - offset));
+    else
+      br->error = 1;
     lowvalue <<= offset;
     shift = count;
     lowvalue &= 0xffffff;
@@ -9,6 +9,7 @@
  */
 
 #include <emmintrin.h>  // SSE2
+#include "./vp9_rtcd.h"
 #include "vp9/common/vp9_idct.h"  // for cospi constants
 #include "vpx_ports/mem.h"
 
@@ -2832,3 +2833,1028 @@ void vp9_fdct32x32_1_sse2(const int16_t *input, int16_t *output, int stride) {
 #include "vp9/encoder/x86/vp9_dct32x32_sse2.c" // NOLINT
 #undef  FDCT32x32_HIGH_PRECISION
 #undef  FDCT32x32_2D
+
+#if CONFIG_VP9_HIGHBITDEPTH
+// The high bitdepth transforms are the 8 bit ones on wider residuals. The
+// 16 bit kernels above are exact for the residuals of 8 bit pixels, so the
+// blocks within that range are transformed by them and widened. The others,
+// which come with 10 and 12 bit pixels, are transformed in 32 bit lanes, each
+// holding one of 4 columns (rows) of the block. Whatever the int16_t
+// residuals, every intermediate value of the C transforms stays under 2^25,
+// where the products are exact, their multiplicands being split in 14 bit
+// halves for _mm_madd_epi16().
+static INLINE int high_fdct_in_range(const int16_t *input, int stride,
+                                     int size) {
+  const __m128i max = _mm_set1_epi16(255);
+  const __m128i min = _mm_set1_epi16(-255);
+  __m128i out_of_range = _mm_setzero_si128();
+  int r, c;
+
+  for (r = 0; r < size; ++r) {
+    for (c = 0; c < size; c += 8) {
+      const __m128i in = size == 4 ?
+          _mm_loadl_epi64((const __m128i *)(input + r * stride)) :
+          _mm_loadu_si128((const __m128i *)(input + r * stride + c));
+      out_of_range = _mm_or_si128(out_of_range, _mm_cmpgt_epi16(in, max));
+      out_of_range = _mm_or_si128(out_of_range, _mm_cmplt_epi16(in, min));
+    }
+  }
+  return !_mm_movemask_epi8(out_of_range);
+}
+
+static INLINE void high_store_coeffs(const int16_t *coeffs,
+                                     tran_low_t *output, int count) {
+  int i;
+  for (i = 0; i < count; i += 8) {
+    const __m128i in = _mm_load_si128((const __m128i *)(coeffs + i));
+    const __m128i sign = _mm_srai_epi16(in, 15);
+    _mm_storeu_si128((__m128i *)(output + i), _mm_unpacklo_epi16(in, sign));
+    _mm_storeu_si128((__m128i *)(output + i + 4),
+                     _mm_unpackhi_epi16(in, sign));
+  }
+}
+
+// fdct_round_shift(x * c0 + y * c1), 'c' being the pair_set_epi16(c0, c1).
+static INLINE __m128i high_fdct_mul(__m128i x, __m128i y, __m128i c) {
+  __m128i hi, lo;
+
+  high_split(x, y, &hi, &lo);
+  return high_round(_mm_madd_epi16(hi, c), _mm_madd_epi16(lo, c));
+}
+
+// The same with the 4 products x * c0 + y * c1 + z * c2 + w * c3 of the
+// ADSTs.
+static INLINE __m128i high_fdct_mul2(__m128i x, __m128i y, __m128i c01,
+                                     __m128i z, __m128i w, __m128i c23) {
+  __m128i hi0, lo0, hi1, lo1;
+
+  high_split(x, y, &hi0, &lo0);
+  high_split(z, w, &hi1, &lo1);
+  return high_round(_mm_add_epi32(_mm_madd_epi16(hi0, c01),
+                                  _mm_madd_epi16(hi1, c23)),
+                    _mm_add_epi32(_mm_madd_epi16(lo0, c01),
+                                  _mm_madd_epi16(lo1, c23)));
+}
+
+// The scalings of the coefficients between and after the passes of
+// vp9_dct.c.
+enum {
+  HIGH_FDCT_NONE,         // x
+  HIGH_FDCT_HALF,         // (x + (x < 0)) >> 1
+  HIGH_FDCT_QUARTER,      // (x + 1) >> 2
+  HIGH_FDCT_QUARTER_NEG,  // (x + 1 + (x < 0)) >> 2
+  HIGH_FDCT_QUARTER_POS   // (x + 1 + (x > 0)) >> 2
+};
+
+static INLINE __m128i high_fdct_round(__m128i x, int type) {
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i one = _mm_set1_epi32(1);
+
+  // The comparisons are -1 where true.
+  switch (type) {
+    case HIGH_FDCT_HALF:
+      return _mm_srai_epi32(_mm_sub_epi32(x, _mm_cmplt_epi32(x, zero)), 1);
+    case HIGH_FDCT_QUARTER:
+      return _mm_srai_epi32(_mm_add_epi32(x, one), 2);
+    case HIGH_FDCT_QUARTER_NEG:
+      return _mm_srai_epi32(_mm_sub_epi32(_mm_add_epi32(x, one),
+                                          _mm_cmplt_epi32(x, zero)), 2);
+    case HIGH_FDCT_QUARTER_POS:
+      return _mm_srai_epi32(_mm_sub_epi32(_mm_add_epi32(x, one),
+                                          _mm_cmpgt_epi32(x, zero)), 2);
+    default:
+      return x;
+  }
+}
+
+static void high_fdct4_epi32(__m128i *in) {
+  __m128i step[4];
+
+  step[0] = _mm_add_epi32(in[0], in[3]);
+  step[1] = _mm_add_epi32(in[1], in[2]);
+  step[2] = _mm_sub_epi32(in[1], in[2]);
+  step[3] = _mm_sub_epi32(in[0], in[3]);
+  in[0] = high_fdct_mul(step[0], step[1],
+                        pair_set_epi16(cospi_16_64, cospi_16_64));
+  in[2] = high_fdct_mul(step[0], step[1],
+                        pair_set_epi16(cospi_16_64, -cospi_16_64));
+  in[1] = high_fdct_mul(step[2], step[3],
+                        pair_set_epi16(cospi_24_64, cospi_8_64));
+  in[3] = high_fdct_mul(step[2], step[3],
+                        pair_set_epi16(-cospi_8_64, cospi_24_64));
+}
+
+static void high_fadst4_epi32(__m128i *in) {
+  const __m128i x0 = in[0];
+  const __m128i x1 = in[1];
+  const __m128i x2 = in[2];
+  const __m128i x3 = in[3];
+
+  // The sums of the products of vp9_dct.c, gathered by input.
+  in[0] = high_fdct_mul2(x0, x1, pair_set_epi16(sinpi_1_9, sinpi_2_9),
+                         x2, x3, pair_set_epi16(sinpi_3_9, sinpi_4_9));
+  in[1] = high_fdct_mul2(x0, x1, pair_set_epi16(sinpi_3_9, sinpi_3_9),
+                         x2, x3, pair_set_epi16(0, -sinpi_3_9));
+  in[2] = high_fdct_mul2(x0, x1, pair_set_epi16(sinpi_4_9, -sinpi_1_9),
+                         x2, x3, pair_set_epi16(-sinpi_3_9, sinpi_2_9));
+  in[3] = high_fdct_mul2(x0, x1, pair_set_epi16(sinpi_4_9 - sinpi_1_9,
+                                                -sinpi_1_9 - sinpi_2_9),
+                         x2, x3, pair_set_epi16(sinpi_3_9,
+                                                sinpi_2_9 - sinpi_4_9));
+}
+
+
+static void high_fdct8_epi32(__m128i *in) {
+  __m128i s0, s1, s2, s3, s4, s5, s6, s7;
+  __m128i x0, x1, x2, x3, t2, t3;
+
+  // stage 1
+  s0 = _mm_add_epi32(in[0], in[7]);
+  s1 = _mm_add_epi32(in[1], in[6]);
+  s2 = _mm_add_epi32(in[2], in[5]);
+  s3 = _mm_add_epi32(in[3], in[4]);
+  s4 = _mm_sub_epi32(in[3], in[4]);
+  s5 = _mm_sub_epi32(in[2], in[5]);
+  s6 = _mm_sub_epi32(in[1], in[6]);
+  s7 = _mm_sub_epi32(in[0], in[7]);
+
+  // fdct4(step, step);
+  x0 = _mm_add_epi32(s0, s3);
+  x1 = _mm_add_epi32(s1, s2);
+  x2 = _mm_sub_epi32(s1, s2);
+  x3 = _mm_sub_epi32(s0, s3);
+  in[0] = high_fdct_mul(x0, x1, pair_set_epi16(cospi_16_64, cospi_16_64));
+  in[2] = high_fdct_mul(x2, x3, pair_set_epi16(cospi_24_64, cospi_8_64));
+  in[4] = high_fdct_mul(x0, x1, pair_set_epi16(cospi_16_64, -cospi_16_64));
+  in[6] = high_fdct_mul(x2, x3, pair_set_epi16(-cospi_8_64, cospi_24_64));
+
+  // Stage 2
+  t2 = high_fdct_mul(s6, s5, pair_set_epi16(cospi_16_64, -cospi_16_64));
+  t3 = high_fdct_mul(s6, s5, pair_set_epi16(cospi_16_64, cospi_16_64));
+
+  // Stage 3
+  x0 = _mm_add_epi32(s4, t2);
+  x1 = _mm_sub_epi32(s4, t2);
+  x2 = _mm_sub_epi32(s7, t3);
+  x3 = _mm_add_epi32(s7, t3);
+
+  // Stage 4
+  in[1] = high_fdct_mul(x0, x3, pair_set_epi16(cospi_28_64, cospi_4_64));
+  in[3] = high_fdct_mul(x2, x1, pair_set_epi16(cospi_12_64, -cospi_20_64));
+  in[5] = high_fdct_mul(x1, x2, pair_set_epi16(cospi_12_64, cospi_20_64));
+  in[7] = high_fdct_mul(x3, x0, pair_set_epi16(cospi_28_64, -cospi_4_64));
+}
+
+static void high_fadst8_epi32(__m128i *in) {
+  const __m128i zero = _mm_setzero_si128();
+  __m128i x[8], s[8];
+
+  // stage 1
+  x[0] = high_fdct_mul2(in[7], in[0], pair_set_epi16(cospi_2_64, cospi_30_64),
+                        in[3], in[4], pair_set_epi16(cospi_18_64, cospi_14_64));
+  x[1] = high_fdct_mul2(in[7], in[0], pair_set_epi16(cospi_30_64, -cospi_2_64),
+                        in[3], in[4],
+                        pair_set_epi16(cospi_14_64, -cospi_18_64));
+  x[2] = high_fdct_mul2(in[5], in[2], pair_set_epi16(cospi_10_64, cospi_22_64),
+                        in[1], in[6], pair_set_epi16(cospi_26_64, cospi_6_64));
+  x[3] = high_fdct_mul2(in[5], in[2], pair_set_epi16(cospi_22_64, -cospi_10_64),
+                        in[1], in[6], pair_set_epi16(cospi_6_64, -cospi_26_64));
+  x[4] = high_fdct_mul2(in[7], in[0], pair_set_epi16(cospi_2_64, cospi_30_64),
+                        in[3], in[4],
+                        pair_set_epi16(-cospi_18_64, -cospi_14_64));
+  x[5] = high_fdct_mul2(in[7], in[0], pair_set_epi16(cospi_30_64, -cospi_2_64),
+                        in[3], in[4],
+                        pair_set_epi16(-cospi_14_64, cospi_18_64));
+  x[6] = high_fdct_mul2(in[5], in[2], pair_set_epi16(cospi_10_64, cospi_22_64),
+                        in[1], in[6],
+                        pair_set_epi16(-cospi_26_64, -cospi_6_64));
+  x[7] = high_fdct_mul2(in[5], in[2], pair_set_epi16(cospi_22_64, -cospi_10_64),
+                        in[1], in[6], pair_set_epi16(-cospi_6_64, cospi_26_64));
+
+  // stage 2
+  s[0] = _mm_add_epi32(x[0], x[2]);
+  s[1] = _mm_add_epi32(x[1], x[3]);
+  s[2] = _mm_sub_epi32(x[0], x[2]);
+  s[3] = _mm_sub_epi32(x[1], x[3]);
+  s[4] = high_fdct_mul2(x[4], x[5], pair_set_epi16(cospi_8_64, cospi_24_64),
+                        x[6], x[7], pair_set_epi16(-cospi_24_64, cospi_8_64));
+  s[5] = high_fdct_mul2(x[4], x[5], pair_set_epi16(cospi_24_64, -cospi_8_64),
+                        x[6], x[7], pair_set_epi16(cospi_8_64, cospi_24_64));
+  s[6] = high_fdct_mul2(x[4], x[5], pair_set_epi16(cospi_8_64, cospi_24_64),
+                        x[6], x[7], pair_set_epi16(cospi_24_64, -cospi_8_64));
+  s[7] = high_fdct_mul2(x[4], x[5], pair_set_epi16(cospi_24_64, -cospi_8_64),
+                        x[6], x[7], pair_set_epi16(-cospi_8_64, -cospi_24_64));
+
+  // stage 3
+  x[2] = high_fdct_mul(s[2], s[3], pair_set_epi16(cospi_16_64, cospi_16_64));
+  x[3] = high_fdct_mul(s[2], s[3], pair_set_epi16(cospi_16_64, -cospi_16_64));
+  x[6] = high_fdct_mul(s[6], s[7], pair_set_epi16(cospi_16_64, cospi_16_64));
+  x[7] = high_fdct_mul(s[6], s[7], pair_set_epi16(cospi_16_64, -cospi_16_64));
+
+  in[0] = s[0];
+  in[1] = _mm_sub_epi32(zero, s[4]);
+  in[2] = x[6];
+  in[3] = _mm_sub_epi32(zero, x[2]);
+  in[4] = x[3];
+  in[5] = _mm_sub_epi32(zero, x[7]);
+  in[6] = s[5];
+  in[7] = _mm_sub_epi32(zero, s[1]);
+}
+
+static void high_fdct16_epi32(__m128i *in) {
+  __m128i input[8], step1[8], step2[8], step3[8];
+
+  // step 1
+  input[0] = _mm_add_epi32(in[0], in[15]);
+  input[1] = _mm_add_epi32(in[1], in[14]);
+  input[2] = _mm_add_epi32(in[2], in[13]);
+  input[3] = _mm_add_epi32(in[3], in[12]);
+  input[4] = _mm_add_epi32(in[4], in[11]);
+  input[5] = _mm_add_epi32(in[5], in[10]);
+  input[6] = _mm_add_epi32(in[6], in[9]);
+  input[7] = _mm_add_epi32(in[7], in[8]);
+  step1[0] = _mm_sub_epi32(in[7], in[8]);
+  step1[1] = _mm_sub_epi32(in[6], in[9]);
+  step1[2] = _mm_sub_epi32(in[5], in[10]);
+  step1[3] = _mm_sub_epi32(in[4], in[11]);
+  step1[4] = _mm_sub_epi32(in[3], in[12]);
+  step1[5] = _mm_sub_epi32(in[2], in[13]);
+  step1[6] = _mm_sub_epi32(in[1], in[14]);
+  step1[7] = _mm_sub_epi32(in[0], in[15]);
+
+  // fdct8(step, step);
+  high_fdct8_epi32(input);
+  in[0] = input[0];
+  in[2] = input[1];
+  in[4] = input[2];
+  in[6] = input[3];
+  in[8] = input[4];
+  in[10] = input[5];
+  in[12] = input[6];
+  in[14] = input[7];
+
+  // step 2
+  step2[2] = high_fdct_mul(step1[5], step1[2],
+                           pair_set_epi16(cospi_16_64, -cospi_16_64));
+  step2[3] = high_fdct_mul(step1[4], step1[3],
+                           pair_set_epi16(cospi_16_64, -cospi_16_64));
+  step2[4] = high_fdct_mul(step1[4], step1[3],
+                           pair_set_epi16(cospi_16_64, cospi_16_64));
+  step2[5] = high_fdct_mul(step1[5], step1[2],
+                           pair_set_epi16(cospi_16_64, cospi_16_64));
+
+  // step 3
+  step3[0] = _mm_add_epi32(step1[0], step2[3]);
+  step3[1] = _mm_add_epi32(step1[1], step2[2]);
+  step3[2] = _mm_sub_epi32(step1[1], step2[2]);
+  step3[3] = _mm_sub_epi32(step1[0], step2[3]);
+  step3[4] = _mm_sub_epi32(step1[7], step2[4]);
+  step3[5] = _mm_sub_epi32(step1[6], step2[5]);
+  step3[6] = _mm_add_epi32(step1[6], step2[5]);
+  step3[7] = _mm_add_epi32(step1[7], step2[4]);
+
+  // step 4
+  step2[1] = high_fdct_mul(step3[1], step3[6],
+                           pair_set_epi16(-cospi_8_64, cospi_24_64));
+  step2[2] = high_fdct_mul(step3[2], step3[5],
+                           pair_set_epi16(cospi_24_64, cospi_8_64));
+  step2[5] = high_fdct_mul(step3[2], step3[5],
+                           pair_set_epi16(cospi_8_64, -cospi_24_64));
+  step2[6] = high_fdct_mul(step3[1], step3[6],
+                           pair_set_epi16(cospi_24_64, cospi_8_64));
+
+  // step 5
+  step1[0] = _mm_add_epi32(step3[0], step2[1]);
+  step1[1] = _mm_sub_epi32(step3[0], step2[1]);
+  step1[2] = _mm_add_epi32(step3[3], step2[2]);
+  step1[3] = _mm_sub_epi32(step3[3], step2[2]);
+  step1[4] = _mm_sub_epi32(step3[4], step2[5]);
+  step1[5] = _mm_add_epi32(step3[4], step2[5]);
+  step1[6] = _mm_sub_epi32(step3[7], step2[6]);
+  step1[7] = _mm_add_epi32(step3[7], step2[6]);
+
+  // step 6
+  in[1] = high_fdct_mul(step1[0], step1[7],
+                        pair_set_epi16(cospi_30_64, cospi_2_64));
+  in[9] = high_fdct_mul(step1[1], step1[6],
+                        pair_set_epi16(cospi_14_64, cospi_18_64));
+  in[5] = high_fdct_mul(step1[2], step1[5],
+                        pair_set_epi16(cospi_22_64, cospi_10_64));
+  in[13] = high_fdct_mul(step1[3], step1[4],
+                         pair_set_epi16(cospi_6_64, cospi_26_64));
+  in[3] = high_fdct_mul(step1[3], step1[4],
+                        pair_set_epi16(-cospi_26_64, cospi_6_64));
+  in[11] = high_fdct_mul(step1[2], step1[5],
+                         pair_set_epi16(-cospi_10_64, cospi_22_64));
+  in[7] = high_fdct_mul(step1[1], step1[6],
+                        pair_set_epi16(-cospi_18_64, cospi_14_64));
+  in[15] = high_fdct_mul(step1[0], step1[7],
+                         pair_set_epi16(-cospi_2_64, cospi_30_64));
+}
+
+static void high_fadst16_epi32(__m128i *in) {
+  const __m128i zero = _mm_setzero_si128();
+  __m128i x[16], s[16];
+
+  // stage 1
+  x[0] = high_fdct_mul2(in[15], in[0], pair_set_epi16(cospi_1_64, cospi_31_64),
+                        in[7], in[8], pair_set_epi16(cospi_17_64, cospi_15_64));
+  x[1] = high_fdct_mul2(in[15], in[0], pair_set_epi16(cospi_31_64, -cospi_1_64),
+                        in[7], in[8],
+                        pair_set_epi16(cospi_15_64, -cospi_17_64));
+  x[2] = high_fdct_mul2(in[13], in[2], pair_set_epi16(cospi_5_64, cospi_27_64),
+                        in[5], in[10],
+                        pair_set_epi16(cospi_21_64, cospi_11_64));
+  x[3] = high_fdct_mul2(in[13], in[2], pair_set_epi16(cospi_27_64, -cospi_5_64),
+                        in[5], in[10],
+                        pair_set_epi16(cospi_11_64, -cospi_21_64));
+  x[4] = high_fdct_mul2(in[11], in[4], pair_set_epi16(cospi_9_64, cospi_23_64),
+                        in[3], in[12], pair_set_epi16(cospi_25_64, cospi_7_64));
+  x[5] = high_fdct_mul2(in[11], in[4], pair_set_epi16(cospi_23_64, -cospi_9_64),
+                        in[3], in[12],
+                        pair_set_epi16(cospi_7_64, -cospi_25_64));
+  x[6] = high_fdct_mul2(in[9], in[6], pair_set_epi16(cospi_13_64, cospi_19_64),
+                        in[1], in[14], pair_set_epi16(cospi_29_64, cospi_3_64));
+  x[7] = high_fdct_mul2(in[9], in[6], pair_set_epi16(cospi_19_64, -cospi_13_64),
+                        in[1], in[14],
+                        pair_set_epi16(cospi_3_64, -cospi_29_64));
+  x[8] = high_fdct_mul2(in[15], in[0], pair_set_epi16(cospi_1_64, cospi_31_64),
+                        in[7], in[8],
+                        pair_set_epi16(-cospi_17_64, -cospi_15_64));
+  x[9] = high_fdct_mul2(in[15], in[0], pair_set_epi16(cospi_31_64, -cospi_1_64),
+                        in[7], in[8],
+                        pair_set_epi16(-cospi_15_64, cospi_17_64));
+  x[10] = high_fdct_mul2(in[13], in[2], pair_set_epi16(cospi_5_64, cospi_27_64),
+                         in[5], in[10],
+                         pair_set_epi16(-cospi_21_64, -cospi_11_64));
+  x[11] = high_fdct_mul2(in[13], in[2],
+                         pair_set_epi16(cospi_27_64, -cospi_5_64),
+                         in[5], in[10],
+                         pair_set_epi16(-cospi_11_64, cospi_21_64));
+  x[12] = high_fdct_mul2(in[11], in[4], pair_set_epi16(cospi_9_64, cospi_23_64),
+                         in[3], in[12],
+                         pair_set_epi16(-cospi_25_64, -cospi_7_64));
+  x[13] = high_fdct_mul2(in[11], in[4],
+                         pair_set_epi16(cospi_23_64, -cospi_9_64),
+                         in[3], in[12],
+                         pair_set_epi16(-cospi_7_64, cospi_25_64));
+  x[14] = high_fdct_mul2(in[9], in[6], pair_set_epi16(cospi_13_64, cospi_19_64),
+                         in[1], in[14],
+                         pair_set_epi16(-cospi_29_64, -cospi_3_64));
+  x[15] = high_fdct_mul2(in[9], in[6],
+                         pair_set_epi16(cospi_19_64, -cospi_13_64),
+                         in[1], in[14],
+                         pair_set_epi16(-cospi_3_64, cospi_29_64));
+
+  // stage 2
+  s[0] = _mm_add_epi32(x[0], x[4]);
+  s[1] = _mm_add_epi32(x[1], x[5]);
+  s[2] = _mm_add_epi32(x[2], x[6]);
+  s[3] = _mm_add_epi32(x[3], x[7]);
+  s[4] = _mm_sub_epi32(x[0], x[4]);
+  s[5] = _mm_sub_epi32(x[1], x[5]);
+  s[6] = _mm_sub_epi32(x[2], x[6]);
+  s[7] = _mm_sub_epi32(x[3], x[7]);
+  s[8] = high_fdct_mul2(x[8], x[9], pair_set_epi16(cospi_4_64, cospi_28_64),
+                        x[12], x[13], pair_set_epi16(-cospi_28_64, cospi_4_64));
+  s[9] = high_fdct_mul2(x[8], x[9], pair_set_epi16(cospi_28_64, -cospi_4_64),
+                        x[12], x[13], pair_set_epi16(cospi_4_64, cospi_28_64));
+  s[10] = high_fdct_mul2(x[10], x[11], pair_set_epi16(cospi_20_64, cospi_12_64),
+                         x[14], x[15],
+                         pair_set_epi16(-cospi_12_64, cospi_20_64));
+  s[11] = high_fdct_mul2(x[10], x[11],
+                         pair_set_epi16(cospi_12_64, -cospi_20_64),
+                         x[14], x[15],
+                         pair_set_epi16(cospi_20_64, cospi_12_64));
+  s[12] = high_fdct_mul2(x[8], x[9], pair_set_epi16(cospi_4_64, cospi_28_64),
+                         x[12], x[13],
+                         pair_set_epi16(cospi_28_64, -cospi_4_64));
+  s[13] = high_fdct_mul2(x[8], x[9], pair_set_epi16(cospi_28_64, -cospi_4_64),
+                         x[12], x[13],
+                         pair_set_epi16(-cospi_4_64, -cospi_28_64));
+  s[14] = high_fdct_mul2(x[10], x[11], pair_set_epi16(cospi_20_64, cospi_12_64),
+                         x[14], x[15],
+                         pair_set_epi16(cospi_12_64, -cospi_20_64));
+  s[15] = high_fdct_mul2(x[10], x[11],
+                         pair_set_epi16(cospi_12_64, -cospi_20_64),
+                         x[14], x[15],
+                         pair_set_epi16(-cospi_20_64, -cospi_12_64));
+
+  // stage 3
+  x[0] = _mm_add_epi32(s[0], s[2]);
+  x[1] = _mm_add_epi32(s[1], s[3]);
+  x[2] = _mm_sub_epi32(s[0], s[2]);
+  x[3] = _mm_sub_epi32(s[1], s[3]);
+  x[4] = high_fdct_mul2(s[4], s[5], pair_set_epi16(cospi_8_64, cospi_24_64),
+                        s[6], s[7], pair_set_epi16(-cospi_24_64, cospi_8_64));
+  x[5] = high_fdct_mul2(s[4], s[5], pair_set_epi16(cospi_24_64, -cospi_8_64),
+                        s[6], s[7], pair_set_epi16(cospi_8_64, cospi_24_64));
+  x[6] = high_fdct_mul2(s[4], s[5], pair_set_epi16(cospi_8_64, cospi_24_64),
+                        s[6], s[7], pair_set_epi16(cospi_24_64, -cospi_8_64));
+  x[7] = high_fdct_mul2(s[4], s[5], pair_set_epi16(cospi_24_64, -cospi_8_64),
+                        s[6], s[7], pair_set_epi16(-cospi_8_64, -cospi_24_64));
+  x[8] = _mm_add_epi32(s[8], s[10]);
+  x[9] = _mm_add_epi32(s[9], s[11]);
+  x[10] = _mm_sub_epi32(s[8], s[10]);
+  x[11] = _mm_sub_epi32(s[9], s[11]);
+  x[12] = high_fdct_mul2(s[12], s[13], pair_set_epi16(cospi_8_64, cospi_24_64),
+                         s[14], s[15],
+                         pair_set_epi16(-cospi_24_64, cospi_8_64));
+  x[13] = high_fdct_mul2(s[12], s[13], pair_set_epi16(cospi_24_64, -cospi_8_64),
+                         s[14], s[15], pair_set_epi16(cospi_8_64, cospi_24_64));
+  x[14] = high_fdct_mul2(s[12], s[13], pair_set_epi16(cospi_8_64, cospi_24_64),
+                         s[14], s[15],
+                         pair_set_epi16(cospi_24_64, -cospi_8_64));
+  x[15] = high_fdct_mul2(s[12], s[13], pair_set_epi16(cospi_24_64, -cospi_8_64),
+                         s[14], s[15],
+                         pair_set_epi16(-cospi_8_64, -cospi_24_64));
+
+  // stage 4
+  s[2] = high_fdct_mul(x[2], x[3], pair_set_epi16(-cospi_16_64, -cospi_16_64));
+  s[3] = high_fdct_mul(x[2], x[3], pair_set_epi16(cospi_16_64, -cospi_16_64));
+  s[6] = high_fdct_mul(x[6], x[7], pair_set_epi16(cospi_16_64, cospi_16_64));
+  s[7] = high_fdct_mul(x[6], x[7], pair_set_epi16(-cospi_16_64, cospi_16_64));
+  s[10] = high_fdct_mul(x[10], x[11], pair_set_epi16(cospi_16_64, cospi_16_64));
+  s[11] = high_fdct_mul(x[10], x[11],
+                        pair_set_epi16(-cospi_16_64, cospi_16_64));
+  s[14] = high_fdct_mul(x[14], x[15],
+                        pair_set_epi16(-cospi_16_64, -cospi_16_64));
+  s[15] = high_fdct_mul(x[14], x[15],
+                        pair_set_epi16(cospi_16_64, -cospi_16_64));
+
+  in[0] = x[0];
+  in[1] = _mm_sub_epi32(zero, x[8]);
+  in[2] = x[12];
+  in[3] = _mm_sub_epi32(zero, x[4]);
+  in[4] = s[6];
+  in[5] = s[14];
+  in[6] = s[10];
+  in[7] = s[2];
+  in[8] = s[3];
+  in[9] = s[11];
+  in[10] = s[15];
+  in[11] = s[7];
+  in[12] = x[5];
+  in[13] = _mm_sub_epi32(zero, x[13]);
+  in[14] = x[9];
+  in[15] = _mm_sub_epi32(zero, x[1]);
+}
+
+// The rd version of the 32x32 DCT rounds its intermediate values.
+static void high_fdct32(__m128i *in, int round) {
+  __m128i step[32];
+  int i;
+
+  // Stage 1
+  step[0] = _mm_add_epi32(in[0], in[31]);
+  step[1] = _mm_add_epi32(in[1], in[30]);
+  step[2] = _mm_add_epi32(in[2], in[29]);
+  step[3] = _mm_add_epi32(in[3], in[28]);
+  step[4] = _mm_add_epi32(in[4], in[27]);
+  step[5] = _mm_add_epi32(in[5], in[26]);
+  step[6] = _mm_add_epi32(in[6], in[25]);
+  step[7] = _mm_add_epi32(in[7], in[24]);
+  step[8] = _mm_add_epi32(in[8], in[23]);
+  step[9] = _mm_add_epi32(in[9], in[22]);
+  step[10] = _mm_add_epi32(in[10], in[21]);
+  step[11] = _mm_add_epi32(in[11], in[20]);
+  step[12] = _mm_add_epi32(in[12], in[19]);
+  step[13] = _mm_add_epi32(in[13], in[18]);
+  step[14] = _mm_add_epi32(in[14], in[17]);
+  step[15] = _mm_add_epi32(in[15], in[16]);
+  step[16] = _mm_sub_epi32(in[15], in[16]);
+  step[17] = _mm_sub_epi32(in[14], in[17]);
+  step[18] = _mm_sub_epi32(in[13], in[18]);
+  step[19] = _mm_sub_epi32(in[12], in[19]);
+  step[20] = _mm_sub_epi32(in[11], in[20]);
+  step[21] = _mm_sub_epi32(in[10], in[21]);
+  step[22] = _mm_sub_epi32(in[9], in[22]);
+  step[23] = _mm_sub_epi32(in[8], in[23]);
+  step[24] = _mm_sub_epi32(in[7], in[24]);
+  step[25] = _mm_sub_epi32(in[6], in[25]);
+  step[26] = _mm_sub_epi32(in[5], in[26]);
+  step[27] = _mm_sub_epi32(in[4], in[27]);
+  step[28] = _mm_sub_epi32(in[3], in[28]);
+  step[29] = _mm_sub_epi32(in[2], in[29]);
+  step[30] = _mm_sub_epi32(in[1], in[30]);
+  step[31] = _mm_sub_epi32(in[0], in[31]);
+
+  // Stage 2
+  in[0] = _mm_add_epi32(step[0], step[15]);
+  in[1] = _mm_add_epi32(step[1], step[14]);
+  in[2] = _mm_add_epi32(step[2], step[13]);
+  in[3] = _mm_add_epi32(step[3], step[12]);
+  in[4] = _mm_add_epi32(step[4], step[11]);
+  in[5] = _mm_add_epi32(step[5], step[10]);
+  in[6] = _mm_add_epi32(step[6], step[9]);
+  in[7] = _mm_add_epi32(step[7], step[8]);
+  in[8] = _mm_sub_epi32(step[7], step[8]);
+  in[9] = _mm_sub_epi32(step[6], step[9]);
+  in[10] = _mm_sub_epi32(step[5], step[10]);
+  in[11] = _mm_sub_epi32(step[4], step[11]);
+  in[12] = _mm_sub_epi32(step[3], step[12]);
+  in[13] = _mm_sub_epi32(step[2], step[13]);
+  in[14] = _mm_sub_epi32(step[1], step[14]);
+  in[15] = _mm_sub_epi32(step[0], step[15]);
+  in[16] = step[16];
+  in[17] = step[17];
+  in[18] = step[18];
+  in[19] = step[19];
+  in[20] = high_fdct_mul(step[20], step[27],
+                         pair_set_epi16(-cospi_16_64, cospi_16_64));
+  in[21] = high_fdct_mul(step[21], step[26],
+                         pair_set_epi16(-cospi_16_64, cospi_16_64));
+  in[22] = high_fdct_mul(step[22], step[25],
+                         pair_set_epi16(-cospi_16_64, cospi_16_64));
+  in[23] = high_fdct_mul(step[23], step[24],
+                         pair_set_epi16(-cospi_16_64, cospi_16_64));
+  in[24] = high_fdct_mul(step[24], step[23],
+                         pair_set_epi16(cospi_16_64, cospi_16_64));
+  in[25] = high_fdct_mul(step[25], step[22],
+                         pair_set_epi16(cospi_16_64, cospi_16_64));
+  in[26] = high_fdct_mul(step[26], step[21],
+                         pair_set_epi16(cospi_16_64, cospi_16_64));
+  in[27] = high_fdct_mul(step[27], step[20],
+                         pair_set_epi16(cospi_16_64, cospi_16_64));
+  in[28] = step[28];
+  in[29] = step[29];
+  in[30] = step[30];
+  in[31] = step[31];
+
+  // The rd version divides the magnitude by 4 here.
+  if (round) {
+    for (i = 0; i < 32; ++i)
+      in[i] = high_fdct_round(in[i], HIGH_FDCT_QUARTER_NEG);
+  }
+
+  // Stage 3
+  step[0] = _mm_add_epi32(in[0], in[7]);
+  step[1] = _mm_add_epi32(in[1], in[6]);
+  step[2] = _mm_add_epi32(in[2], in[5]);
+  step[3] = _mm_add_epi32(in[3], in[4]);
+  step[4] = _mm_sub_epi32(in[3], in[4]);
+  step[5] = _mm_sub_epi32(in[2], in[5]);
+  step[6] = _mm_sub_epi32(in[1], in[6]);
+  step[7] = _mm_sub_epi32(in[0], in[7]);
+  step[8] = in[8];
+  step[9] = in[9];
+  step[10] = high_fdct_mul(in[10], in[13],
+                           pair_set_epi16(-cospi_16_64, cospi_16_64));
+  step[11] = high_fdct_mul(in[11], in[12],
+                           pair_set_epi16(-cospi_16_64, cospi_16_64));
+  step[12] = high_fdct_mul(in[12], in[11],
+                           pair_set_epi16(cospi_16_64, cospi_16_64));
+  step[13] = high_fdct_mul(in[13], in[10],
+                           pair_set_epi16(cospi_16_64, cospi_16_64));
+  step[14] = in[14];
+  step[15] = in[15];
+  step[16] = _mm_add_epi32(in[16], in[23]);
+  step[17] = _mm_add_epi32(in[17], in[22]);
+  step[18] = _mm_add_epi32(in[18], in[21]);
+  step[19] = _mm_add_epi32(in[19], in[20]);
+  step[20] = _mm_sub_epi32(in[19], in[20]);
+  step[21] = _mm_sub_epi32(in[18], in[21]);
+  step[22] = _mm_sub_epi32(in[17], in[22]);
+  step[23] = _mm_sub_epi32(in[16], in[23]);
+  step[24] = _mm_sub_epi32(in[31], in[24]);
+  step[25] = _mm_sub_epi32(in[30], in[25]);
+  step[26] = _mm_sub_epi32(in[29], in[26]);
+  step[27] = _mm_sub_epi32(in[28], in[27]);
+  step[28] = _mm_add_epi32(in[28], in[27]);
+  step[29] = _mm_add_epi32(in[29], in[26]);
+  step[30] = _mm_add_epi32(in[30], in[25]);
+  step[31] = _mm_add_epi32(in[31], in[24]);
+
+  // Stage 4
+  in[0] = _mm_add_epi32(step[0], step[3]);
+  in[1] = _mm_add_epi32(step[1], step[2]);
+  in[2] = _mm_sub_epi32(step[1], step[2]);
+  in[3] = _mm_sub_epi32(step[0], step[3]);
+  in[4] = step[4];
+  in[5] = high_fdct_mul(step[5], step[6],
+                        pair_set_epi16(-cospi_16_64, cospi_16_64));
+  in[6] = high_fdct_mul(step[6], step[5],
+                        pair_set_epi16(cospi_16_64, cospi_16_64));
+  in[7] = step[7];
+  in[8] = _mm_add_epi32(step[8], step[11]);
+  in[9] = _mm_add_epi32(step[9], step[10]);
+  in[10] = _mm_sub_epi32(step[9], step[10]);
+  in[11] = _mm_sub_epi32(step[8], step[11]);
+  in[12] = _mm_sub_epi32(step[15], step[12]);
+  in[13] = _mm_sub_epi32(step[14], step[13]);
+  in[14] = _mm_add_epi32(step[14], step[13]);
+  in[15] = _mm_add_epi32(step[15], step[12]);
+  in[16] = step[16];
+  in[17] = step[17];
+  in[18] = high_fdct_mul(step[18], step[29],
+                         pair_set_epi16(-cospi_8_64, cospi_24_64));
+  in[19] = high_fdct_mul(step[19], step[28],
+                         pair_set_epi16(-cospi_8_64, cospi_24_64));
+  in[20] = high_fdct_mul(step[20], step[27],
+                         pair_set_epi16(-cospi_24_64, -cospi_8_64));
+  in[21] = high_fdct_mul(step[21], step[26],
+                         pair_set_epi16(-cospi_24_64, -cospi_8_64));
+  in[22] = step[22];
+  in[23] = step[23];
+  in[24] = step[24];
+  in[25] = step[25];
+  in[26] = high_fdct_mul(step[26], step[21],
+                         pair_set_epi16(cospi_24_64, -cospi_8_64));
+  in[27] = high_fdct_mul(step[27], step[20],
+                         pair_set_epi16(cospi_24_64, -cospi_8_64));
+  in[28] = high_fdct_mul(step[28], step[19],
+                         pair_set_epi16(cospi_8_64, cospi_24_64));
+  in[29] = high_fdct_mul(step[29], step[18],
+                         pair_set_epi16(cospi_8_64, cospi_24_64));
+  in[30] = step[30];
+  in[31] = step[31];
+
+  // Stage 5
+  step[0] = high_fdct_mul(in[0], in[1],
+                          pair_set_epi16(cospi_16_64, cospi_16_64));
+  step[1] = high_fdct_mul(in[1], in[0],
+                          pair_set_epi16(-cospi_16_64, cospi_16_64));
+  step[2] = high_fdct_mul(in[2], in[3],
+                          pair_set_epi16(cospi_24_64, cospi_8_64));
+  step[3] = high_fdct_mul(in[3], in[2],
+                          pair_set_epi16(cospi_24_64, -cospi_8_64));
+  step[4] = _mm_add_epi32(in[4], in[5]);
+  step[5] = _mm_sub_epi32(in[4], in[5]);
+  step[6] = _mm_sub_epi32(in[7], in[6]);
+  step[7] = _mm_add_epi32(in[7], in[6]);
+  step[8] = in[8];
+  step[9] = high_fdct_mul(in[9], in[14],
+                          pair_set_epi16(-cospi_8_64, cospi_24_64));
+  step[10] = high_fdct_mul(in[10], in[13],
+                           pair_set_epi16(-cospi_24_64, -cospi_8_64));
+  step[11] = in[11];
+  step[12] = in[12];
+  step[13] = high_fdct_mul(in[13], in[10],
+                           pair_set_epi16(cospi_24_64, -cospi_8_64));
+  step[14] = high_fdct_mul(in[14], in[9],
+                           pair_set_epi16(cospi_8_64, cospi_24_64));
+  step[15] = in[15];
+  step[16] = _mm_add_epi32(in[16], in[19]);
+  step[17] = _mm_add_epi32(in[17], in[18]);
+  step[18] = _mm_sub_epi32(in[17], in[18]);
+  step[19] = _mm_sub_epi32(in[16], in[19]);
+  step[20] = _mm_sub_epi32(in[23], in[20]);
+  step[21] = _mm_sub_epi32(in[22], in[21]);
+  step[22] = _mm_add_epi32(in[22], in[21]);
+  step[23] = _mm_add_epi32(in[23], in[20]);
+  step[24] = _mm_add_epi32(in[24], in[27]);
+  step[25] = _mm_add_epi32(in[25], in[26]);
+  step[26] = _mm_sub_epi32(in[25], in[26]);
+  step[27] = _mm_sub_epi32(in[24], in[27]);
+  step[28] = _mm_sub_epi32(in[31], in[28]);
+  step[29] = _mm_sub_epi32(in[30], in[29]);
+  step[30] = _mm_add_epi32(in[30], in[29]);
+  step[31] = _mm_add_epi32(in[31], in[28]);
+
+  // Stage 6
+  in[0] = step[0];
+  in[1] = step[1];
+  in[2] = step[2];
+  in[3] = step[3];
+  in[4] = high_fdct_mul(step[4], step[7],
+                        pair_set_epi16(cospi_28_64, cospi_4_64));
+  in[5] = high_fdct_mul(step[5], step[6],
+                        pair_set_epi16(cospi_12_64, cospi_20_64));
+  in[6] = high_fdct_mul(step[6], step[5],
+                        pair_set_epi16(cospi_12_64, -cospi_20_64));
+  in[7] = high_fdct_mul(step[7], step[4],
+                        pair_set_epi16(cospi_28_64, -cospi_4_64));
+  in[8] = _mm_add_epi32(step[8], step[9]);
+  in[9] = _mm_sub_epi32(step[8], step[9]);
+  in[10] = _mm_sub_epi32(step[11], step[10]);
+  in[11] = _mm_add_epi32(step[11], step[10]);
+  in[12] = _mm_add_epi32(step[12], step[13]);
+  in[13] = _mm_sub_epi32(step[12], step[13]);
+  in[14] = _mm_sub_epi32(step[15], step[14]);
+  in[15] = _mm_add_epi32(step[15], step[14]);
+  in[16] = step[16];
+  in[17] = high_fdct_mul(step[17], step[30],
+                         pair_set_epi16(-cospi_4_64, cospi_28_64));
+  in[18] = high_fdct_mul(step[18], step[29],
+                         pair_set_epi16(-cospi_28_64, -cospi_4_64));
+  in[19] = step[19];
+  in[20] = step[20];
+  in[21] = high_fdct_mul(step[21], step[26],
+                         pair_set_epi16(-cospi_20_64, cospi_12_64));
+  in[22] = high_fdct_mul(step[22], step[25],
+                         pair_set_epi16(-cospi_12_64, -cospi_20_64));
+  in[23] = step[23];
+  in[24] = step[24];
+  in[25] = high_fdct_mul(step[25], step[22],
+                         pair_set_epi16(cospi_12_64, -cospi_20_64));
+  in[26] = high_fdct_mul(step[26], step[21],
+                         pair_set_epi16(cospi_20_64, cospi_12_64));
+  in[27] = step[27];
+  in[28] = step[28];
+  in[29] = high_fdct_mul(step[29], step[18],
+                         pair_set_epi16(cospi_28_64, -cospi_4_64));
+  in[30] = high_fdct_mul(step[30], step[17],
+                         pair_set_epi16(cospi_4_64, cospi_28_64));
+  in[31] = step[31];
+
+  // Stage 7
+  step[0] = in[0];
+  step[1] = in[1];
+  step[2] = in[2];
+  step[3] = in[3];
+  step[4] = in[4];
+  step[5] = in[5];
+  step[6] = in[6];
+  step[7] = in[7];
+  step[8] = high_fdct_mul(in[8], in[15],
+                          pair_set_epi16(cospi_30_64, cospi_2_64));
+  step[9] = high_fdct_mul(in[9], in[14],
+                          pair_set_epi16(cospi_14_64, cospi_18_64));
+  step[10] = high_fdct_mul(in[10], in[13],
+                           pair_set_epi16(cospi_22_64, cospi_10_64));
+  step[11] = high_fdct_mul(in[11], in[12],
+                           pair_set_epi16(cospi_6_64, cospi_26_64));
+  step[12] = high_fdct_mul(in[12], in[11],
+                           pair_set_epi16(cospi_6_64, -cospi_26_64));
+  step[13] = high_fdct_mul(in[13], in[10],
+                           pair_set_epi16(cospi_22_64, -cospi_10_64));
+  step[14] = high_fdct_mul(in[14], in[9],
+                           pair_set_epi16(cospi_14_64, -cospi_18_64));
+  step[15] = high_fdct_mul(in[15], in[8],
+                           pair_set_epi16(cospi_30_64, -cospi_2_64));
+  step[16] = _mm_add_epi32(in[16], in[17]);
+  step[17] = _mm_sub_epi32(in[16], in[17]);
+  step[18] = _mm_sub_epi32(in[19], in[18]);
+  step[19] = _mm_add_epi32(in[19], in[18]);
+  step[20] = _mm_add_epi32(in[20], in[21]);
+  step[21] = _mm_sub_epi32(in[20], in[21]);
+  step[22] = _mm_sub_epi32(in[23], in[22]);
+  step[23] = _mm_add_epi32(in[23], in[22]);
+  step[24] = _mm_add_epi32(in[24], in[25]);
+  step[25] = _mm_sub_epi32(in[24], in[25]);
+  step[26] = _mm_sub_epi32(in[27], in[26]);
+  step[27] = _mm_add_epi32(in[27], in[26]);
+  step[28] = _mm_add_epi32(in[28], in[29]);
+  step[29] = _mm_sub_epi32(in[28], in[29]);
+  step[30] = _mm_sub_epi32(in[31], in[30]);
+  step[31] = _mm_add_epi32(in[31], in[30]);
+
+  // Final stage --- outputs indices are bit-reversed.
+  in[0] = step[0];
+  in[16] = step[1];
+  in[8] = step[2];
+  in[24] = step[3];
+  in[4] = step[4];
+  in[20] = step[5];
+  in[12] = step[6];
+  in[28] = step[7];
+  in[2] = step[8];
+  in[18] = step[9];
+  in[10] = step[10];
+  in[26] = step[11];
+  in[6] = step[12];
+  in[22] = step[13];
+  in[14] = step[14];
+  in[30] = step[15];
+  in[1] = high_fdct_mul(step[16], step[31],
+                        pair_set_epi16(cospi_31_64, cospi_1_64));
+  in[17] = high_fdct_mul(step[17], step[30],
+                         pair_set_epi16(cospi_15_64, cospi_17_64));
+  in[9] = high_fdct_mul(step[18], step[29],
+                        pair_set_epi16(cospi_23_64, cospi_9_64));
+  in[25] = high_fdct_mul(step[19], step[28],
+                         pair_set_epi16(cospi_7_64, cospi_25_64));
+  in[5] = high_fdct_mul(step[20], step[27],
+                        pair_set_epi16(cospi_27_64, cospi_5_64));
+  in[21] = high_fdct_mul(step[21], step[26],
+                         pair_set_epi16(cospi_11_64, cospi_21_64));
+  in[13] = high_fdct_mul(step[22], step[25],
+                         pair_set_epi16(cospi_19_64, cospi_13_64));
+  in[29] = high_fdct_mul(step[23], step[24],
+                         pair_set_epi16(cospi_3_64, cospi_29_64));
+  in[3] = high_fdct_mul(step[24], step[23],
+                        pair_set_epi16(cospi_3_64, -cospi_29_64));
+  in[19] = high_fdct_mul(step[25], step[22],
+                         pair_set_epi16(cospi_19_64, -cospi_13_64));
+  in[11] = high_fdct_mul(step[26], step[21],
+                         pair_set_epi16(cospi_11_64, -cospi_21_64));
+  in[27] = high_fdct_mul(step[27], step[20],
+                         pair_set_epi16(cospi_27_64, -cospi_5_64));
+  in[7] = high_fdct_mul(step[28], step[19],
+                        pair_set_epi16(cospi_7_64, -cospi_25_64));
+  in[23] = high_fdct_mul(step[29], step[18],
+                         pair_set_epi16(cospi_23_64, -cospi_9_64));
+  in[15] = high_fdct_mul(step[30], step[17],
+                         pair_set_epi16(cospi_15_64, -cospi_17_64));
+  in[31] = high_fdct_mul(step[31], step[16],
+                         pair_set_epi16(cospi_31_64, -cospi_1_64));
+}
+
+static void high_fdct32_epi32(__m128i *in) {
+  high_fdct32(in, 0);
+}
+
+static void high_fdct32_rd_epi32(__m128i *in) {
+  high_fdct32(in, 1);
+}
+
+typedef void (*high_fdct_1d)(__m128i *in);
+
+typedef struct {
+  high_fdct_1d cols, rows;
+} high_fdct_2d_type;
+
+static const high_fdct_2d_type HIGH_FHT_4[] = {
+  { high_fdct4_epi32,  high_fdct4_epi32  },  // DCT_DCT  = 0
+  { high_fadst4_epi32, high_fdct4_epi32  },  // ADST_DCT = 1
+  { high_fdct4_epi32,  high_fadst4_epi32 },  // DCT_ADST = 2
+  { high_fadst4_epi32, high_fadst4_epi32 }   // ADST_ADST = 3
+};
+
+static const high_fdct_2d_type HIGH_FHT_8[] = {
+  { high_fdct8_epi32,  high_fdct8_epi32  },  // DCT_DCT  = 0
+  { high_fadst8_epi32, high_fdct8_epi32  },  // ADST_DCT = 1
+  { high_fdct8_epi32,  high_fadst8_epi32 },  // DCT_ADST = 2
+  { high_fadst8_epi32, high_fadst8_epi32 }   // ADST_ADST = 3
+};
+
+static const high_fdct_2d_type HIGH_FHT_16[] = {
+  { high_fdct16_epi32,  high_fdct16_epi32  },  // DCT_DCT  = 0
+  { high_fadst16_epi32, high_fdct16_epi32  },  // ADST_DCT = 1
+  { high_fdct16_epi32,  high_fadst16_epi32 },  // DCT_ADST = 2
+  { high_fadst16_epi32, high_fadst16_epi32 }   // ADST_ADST = 3
+};
+
+// The 2D transforms of vp9_dct.c in 32 bit lanes: the columns are transformed
+// 4 at a time and stored transposed, so that the rows are too. 'shift' is the
+// scaling of the input and the rounds the ones between and after the passes.
+static INLINE void high_fdct_2d(const int16_t *input, tran_low_t *output,
+                                int stride, int size, int shift,
+                                high_fdct_1d cols, int cols_round,
+                                high_fdct_1d rows, int rows_round) {
+  const __m128i zero = _mm_setzero_si128();
+  __m128i buf[32 * 32 / 4];
+  __m128i in[32];
+  int i, j, k;
+
+  // Columns
+  for (i = 0; i < size; i += 4) {
+    for (j = 0; j < size; ++j) {
+      const __m128i x =
+          _mm_loadl_epi64((const __m128i *)(input + j * stride + i));
+      in[j] = _mm_slli_epi32(_mm_srai_epi32(_mm_unpacklo_epi16(x, x), 16),
+                             shift);
+    }
+    // The 4x4 transforms add 1 to the first input of the first column when
+    // it is not 0.
+    if (size == 4 && i == 0)
+      in[0] = _mm_add_epi32(in[0],
+                            _mm_andnot_si128(_mm_cmpeq_epi32(in[0], zero),
+                                             _mm_setr_epi32(1, 0, 0, 0)));
+    cols(in);
+    for (j = 0; j < size; j += 4) {
+      for (k = 0; k < 4; ++k)
+        in[j + k] = high_fdct_round(in[j + k], cols_round);
+      high_transpose_4x4(in + j);
+      for (k = 0; k < 4; ++k)
+        buf[j / 4 * size + i + k] = in[j + k];
+    }
+  }
+
+  // Rows
+  for (j = 0; j < size; j += 4) {
+    __m128i *const row = buf + j / 4 * size;
+
+    rows(row);
+    for (i = 0; i < size; i += 4) {
+      for (k = 0; k < 4; ++k)
+        row[i + k] = high_fdct_round(row[i + k], rows_round);
+      high_transpose_4x4(row + i);
+      for (k = 0; k < 4; ++k)
+        _mm_storeu_si128((__m128i *)(output + (j + k) * size + i),
+                         row[i + k]);
+    }
+  }
+}
+
+#define HIGH_FDCT(name, size) \
+void vp9_high_##name##_sse2(const int16_t *input, tran_low_t *output, \
+                            int stride) { \
+  if (high_fdct_in_range(input, stride, size)) { \
+    DECLARE_ALIGNED_ARRAY(16, int16_t, coeffs, size * size); \
+    vp9_##name##_sse2(input, coeffs, stride); \
+    high_store_coeffs(coeffs, output, size * size); \
+  } else { \
+    high_##name##_epi32(input, output, stride); \
+  } \
+}
+
+#define HIGH_FHT(size) \
+void vp9_high_fht##size##x##size##_sse2(const int16_t *input, \
+                                        tran_low_t *output, int stride, \
+                                        int tx_type) { \
+  if (high_fdct_in_range(input, stride, size)) { \
+    DECLARE_ALIGNED_ARRAY(16, int16_t, coeffs, size * size); \
+    vp9_fht##size##x##size##_sse2(input, coeffs, stride, tx_type); \
+    high_store_coeffs(coeffs, output, size * size); \
+  } else { \
+    high_fht##size##x##size##_epi32(input, output, stride, tx_type); \
+  } \
+}
+
+static void high_fdct4x4_epi32(const int16_t *input, tran_low_t *output,
+                               int stride) {
+  high_fdct_2d(input, output, stride, 4, 4, high_fdct4_epi32, HIGH_FDCT_NONE,
+               high_fdct4_epi32, HIGH_FDCT_QUARTER);
+}
+
+static void high_fdct8x8_epi32(const int16_t *input, tran_low_t *output,
+                               int stride) {
+  high_fdct_2d(input, output, stride, 8, 2, high_fdct8_epi32, HIGH_FDCT_NONE,
+               high_fdct8_epi32, HIGH_FDCT_HALF);
+}
+
+static void high_fdct16x16_epi32(const int16_t *input, tran_low_t *output,
+                                 int stride) {
+  high_fdct_2d(input, output, stride, 16, 2, high_fdct16_epi32,
+               HIGH_FDCT_QUARTER, high_fdct16_epi32, HIGH_FDCT_NONE);
+}
+
+static void high_fdct32x32_epi32(const int16_t *input, tran_low_t *output,
+                                 int stride) {
+  high_fdct_2d(input, output, stride, 32, 2, high_fdct32_epi32,
+               HIGH_FDCT_QUARTER_POS, high_fdct32_epi32,
+               HIGH_FDCT_QUARTER_NEG);
+}
+
+static void high_fdct32x32_rd_epi32(const int16_t *input, tran_low_t *output,
+                                    int stride) {
+  high_fdct_2d(input, output, stride, 32, 2, high_fdct32_epi32,
+               HIGH_FDCT_QUARTER_POS, high_fdct32_rd_epi32, HIGH_FDCT_NONE);
+}
+
+static void high_fht4x4_epi32(const int16_t *input, tran_low_t *output,
+                              int stride, int tx_type) {
+  const high_fdct_2d_type *const ht = &HIGH_FHT_4[tx_type];
+  high_fdct_2d(input, output, stride, 4, 4, ht->cols, HIGH_FDCT_NONE,
+               ht->rows, HIGH_FDCT_QUARTER);
+}
+
+static void high_fht8x8_epi32(const int16_t *input, tran_low_t *output,
+                              int stride, int tx_type) {
+  const high_fdct_2d_type *const ht = &HIGH_FHT_8[tx_type];
+  high_fdct_2d(input, output, stride, 8, 2, ht->cols, HIGH_FDCT_NONE,
+               ht->rows, HIGH_FDCT_HALF);
+}
+
+// Unlike the smaller ones, the 16x16 DCT rounds differently from the hybrid
+// transforms.
+static void high_fht16x16_epi32(const int16_t *input, tran_low_t *output,
+                                int stride, int tx_type) {
+  const high_fdct_2d_type *const ht = &HIGH_FHT_16[tx_type];
+  if (tx_type == DCT_DCT)
+    high_fdct16x16_epi32(input, output, stride);
+  else
+    high_fdct_2d(input, output, stride, 16, 2, ht->cols,
+                 HIGH_FDCT_QUARTER_NEG, ht->rows, HIGH_FDCT_NONE);
+}
+
+HIGH_FDCT(fdct4x4, 4)
+HIGH_FDCT(fdct8x8, 8)
+HIGH_FDCT(fdct16x16, 16)
+HIGH_FDCT(fdct32x32, 32)
+HIGH_FDCT(fdct32x32_rd, 32)
+HIGH_FHT(4)
+HIGH_FHT(8)
+HIGH_FHT(16)
+
+// The DC only versions compute output[0], the sum of the residuals scaled,
+// and clear output[1].
+static INLINE int high_fdct_sum(const int16_t *input, int stride, int size) {
+  const __m128i one = _mm_set1_epi16(1);
+  __m128i sum = _mm_setzero_si128();
+  int r, c;
+
+  for (r = 0; r < size; ++r) {
+    for (c = 0; c < size; c += 8) {
+      const __m128i in =
+          _mm_loadu_si128((const __m128i *)(input + r * stride + c));
+      sum = _mm_add_epi32(sum, _mm_madd_epi16(in, one));
+    }
+  }
+  sum = _mm_add_epi32(sum, _mm_srli_si128(sum, 8));
+  sum = _mm_add_epi32(sum, _mm_srli_si128(sum, 4));
+  return _mm_cvtsi128_si32(sum);
+}
+
+#define HIGH_FDCT_1(size, shift) \
+void vp9_high_fdct##size##x##size##_1_sse2(const int16_t *input, \
+                                           tran_low_t *output, int stride) { \
+  output[0] = high_fdct_sum(input, stride, size) >> (shift); \
+  output[1] = 0; \
+}
+
+HIGH_FDCT_1(8, 0)
+HIGH_FDCT_1(16, 1)
+HIGH_FDCT_1(32, 3)
+#endif  // CONFIG_VP9_HIGHBITDEPTH
@@ -0,0 +1,114 @@
+/*
+ *  Copyright (c) 2014 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>  // AVX2
+#include <stdlib.h>
+
+#include "./vp9_rtcd.h"
+#include "vp9/encoder/vp9_denoiser.h"
+
+static INLINE int sum_sad(__m256i sum) {
+  const __m128i sum_128 = _mm_add_epi32(_mm256_castsi256_si128(sum),
+                                        _mm256_extracti128_si256(sum, 1));
+  return _mm_cvtsi128_si32(_mm_add_epi32(sum_128,
+                                         _mm_srli_si128(sum_128, 8)));
+}
+
+// Blocks 32 and 64 pixels wide are filtered 32 pixels of a row at a time,
+// the narrower ones by the SSE2 version.
+int vp9_denoiser_filter_avx2(const uint8_t *sig, int sig_stride,
+                             const uint8_t *mc_avg, int mc_avg_stride,
+                             uint8_t *avg, int avg_stride,
+                             int increase_denoising, BLOCK_SIZE bs,
+                             int motion_magnitude) {
+  const int width = 4 << b_width_log2_lookup[bs];
+  const int height = 4 << b_height_log2_lookup[bs];
+  const int shift_inc = motion_magnitude <= MOTION_MAGNITUDE_THRESHOLD ?
+                        (increase_denoising ? 2 : 1) : 0;
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i th = _mm256_set1_epi8(absdiff_thresh(bs, increase_denoising));
+  const __m256i level0 = _mm256_set1_epi8(3 + shift_inc);
+  const __m256i level1 = _mm256_set1_epi8(4 + shift_inc);
+  const __m256i level2 = _mm256_set1_epi8(6 + shift_inc);
+  const __m256i mask_16 = _mm256_set1_epi8((char)0xf0);
+  const __m256i mask_8 = _mm256_set1_epi8((char)0xf8);
+  __m256i sum_pos = zero, sum_neg = zero, delta_8;
+  int total_adj, delta, r, c;
+
+  if (width < 32)
+    return vp9_denoiser_filter_sse2(sig, sig_stride, mc_avg, mc_avg_stride,
+                                    avg, avg_stride, increase_denoising, bs,
+                                    motion_magnitude);
+
+  // First attempt to apply a strong temporal denoising filter, see the SSE2
+  // version.
+  for (r = 0; r < height; ++r) {
+    for (c = 0; c < width; c += 32) {
+      const __m256i s = _mm256_loadu_si256((const __m256i *)(sig +
+          r * sig_stride + c));
+      const __m256i m = _mm256_loadu_si256((const __m256i *)(mc_avg +
+          r * mc_avg_stride + c));
+      const __m256i pdiff = _mm256_subs_epu8(m, s);
+      const __m256i ndiff = _mm256_subs_epu8(s, m);
+      const __m256i absdiff = _mm256_or_si256(pdiff, ndiff);
+      const __m256i small = _mm256_cmpeq_epi8(_mm256_min_epu8(absdiff, th),
+                                              absdiff);
+      const __m256i below_16 = _mm256_cmpeq_epi8(
+          _mm256_and_si256(absdiff, mask_16), zero);
+      const __m256i below_8 = _mm256_cmpeq_epi8(
+          _mm256_and_si256(absdiff, mask_8), zero);
+      __m256i level, pos, neg;
+
+      level = _mm256_blendv_epi8(level2, level1, below_16);
+      level = _mm256_blendv_epi8(level, level0, below_8);
+      level = _mm256_blendv_epi8(level, absdiff, small);
+      pos = _mm256_andnot_si256(_mm256_cmpeq_epi8(pdiff, zero), level);
+      neg = _mm256_andnot_si256(_mm256_cmpeq_epi8(ndiff, zero), level);
+      sum_pos = _mm256_add_epi32(sum_pos, _mm256_sad_epu8(pos, zero));
+      sum_neg = _mm256_add_epi32(sum_neg, _mm256_sad_epu8(neg, zero));
+      _mm256_storeu_si256((__m256i *)(avg + r * avg_stride + c),
+                          _mm256_subs_epu8(_mm256_adds_epu8(s, pos), neg));
+    }
+  }
+
+  total_adj = sum_sad(sum_pos) - sum_sad(sum_neg);
+  if (abs(total_adj) <= total_adj_strong_thresh(bs, increase_denoising))
+    return FILTER_BLOCK;
+
+  // Otherwise, dampen the filter if the delta is not too high.
+  delta = ((abs(total_adj) - total_adj_strong_thresh(bs, increase_denoising))
+           >> 8) + 1;
+  if (delta >= delta_thresh(bs, increase_denoising))
+    return COPY_BLOCK;
+
+  delta_8 = _mm256_set1_epi8((char)delta);
+  sum_pos = zero;
+  sum_neg = zero;
+  for (r = 0; r < height; ++r) {
+    for (c = 0; c < width; c += 32) {
+      const __m256i s = _mm256_loadu_si256((const __m256i *)(sig +
+          r * sig_stride + c));
+      const __m256i m = _mm256_loadu_si256((const __m256i *)(mc_avg +
+          r * mc_avg_stride + c));
+      __m256i *const a = (__m256i *)(avg + r * avg_stride + c);
+      const __m256i pos = _mm256_min_epu8(_mm256_subs_epu8(s, m), delta_8);
+      const __m256i neg = _mm256_min_epu8(_mm256_subs_epu8(m, s), delta_8);
+      sum_pos = _mm256_add_epi32(sum_pos, _mm256_sad_epu8(pos, zero));
+      sum_neg = _mm256_add_epi32(sum_neg, _mm256_sad_epu8(neg, zero));
+      _mm256_storeu_si256(a, _mm256_subs_epu8(
+          _mm256_adds_epu8(_mm256_loadu_si256(a), pos), neg));
+    }
+  }
+
+  total_adj += sum_sad(sum_pos) - sum_sad(sum_neg);
+  if (abs(total_adj) <= total_adj_weak_thresh(bs, increase_denoising))
+    return FILTER_BLOCK;
+  return COPY_BLOCK;
+}
@@ -0,0 +1,201 @@
+/*
+ *  Copyright (c) 2014 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <emmintrin.h>
+#include <stdlib.h>
+
+#include "./vp9_rtcd.h"
+#include "vpx_ports/emmintrin_compat.h"
+#include "vp9/encoder/vp9_denoiser.h"
+
+// Adjustments of the strong filter: 'th' is the largest difference copied
+// from the motion compensated average, 'level0' to 'level2' the adjustments
+// of the differences up to 7, up to 15 and above.
+typedef struct {
+  __m128i th;
+  __m128i level0;
+  __m128i level1;
+  __m128i level2;
+} denoiser_adj;
+
+static INLINE int sum_sad(__m128i sum) {
+  return _mm_cvtsi128_si32(_mm_add_epi32(sum, _mm_srli_si128(sum, 8)));
+}
+
+// Run the strong filter on 16 pixels, returning the denoised ones. The
+// adjustments made up and down are added to 'sum_pos' and 'sum_neg'.
+static INLINE __m128i strong_filter_16(__m128i sig, __m128i mc_avg,
+                                       const denoiser_adj *adj,
+                                       __m128i *sum_pos, __m128i *sum_neg) {
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i pdiff = _mm_subs_epu8(mc_avg, sig);
+  const __m128i ndiff = _mm_subs_epu8(sig, mc_avg);
+  const __m128i absdiff = _mm_or_si128(pdiff, ndiff);
+  // The differences up to the threshold are taken whole.
+  const __m128i small = _mm_cmpeq_epi8(_mm_min_epu8(absdiff, adj->th),
+                                       absdiff);
+  const __m128i below_16 = _mm_cmpeq_epi8(
+      _mm_and_si128(absdiff, _mm_set1_epi8((char)0xf0)), zero);
+  const __m128i below_8 = _mm_cmpeq_epi8(
+      _mm_and_si128(absdiff, _mm_set1_epi8((char)0xf8)), zero);
+  __m128i level, pos, neg;
+
+  level = _mm_or_si128(_mm_and_si128(below_16, adj->level1),
+                       _mm_andnot_si128(below_16, adj->level2));
+  level = _mm_or_si128(_mm_and_si128(below_8, adj->level0),
+                       _mm_andnot_si128(below_8, level));
+  level = _mm_or_si128(_mm_and_si128(small, absdiff),
+                       _mm_andnot_si128(small, level));
+
+  pos = _mm_andnot_si128(_mm_cmpeq_epi8(pdiff, zero), level);
+  neg = _mm_andnot_si128(_mm_cmpeq_epi8(ndiff, zero), level);
+  *sum_pos = _mm_add_epi32(*sum_pos, _mm_sad_epu8(pos, zero));
+  *sum_neg = _mm_add_epi32(*sum_neg, _mm_sad_epu8(neg, zero));
+  return _mm_subs_epu8(_mm_adds_epu8(sig, pos), neg);
+}
+
+// Pull the 16 denoised pixels 'avg' back towards the signal by at most
+// 'delta', adding the adjustments to 'sum_pos' and 'sum_neg'.
+static INLINE __m128i weak_filter_16(__m128i sig, __m128i mc_avg, __m128i avg,
+                                     __m128i delta,
+                                     __m128i *sum_pos, __m128i *sum_neg) {
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i pos = _mm_min_epu8(_mm_subs_epu8(sig, mc_avg), delta);
+  const __m128i neg = _mm_min_epu8(_mm_subs_epu8(mc_avg, sig), delta);
+  *sum_pos = _mm_add_epi32(*sum_pos, _mm_sad_epu8(pos, zero));
+  *sum_neg = _mm_add_epi32(*sum_neg, _mm_sad_epu8(neg, zero));
+  return _mm_subs_epu8(_mm_adds_epu8(avg, pos), neg);
+}
+
+static INLINE __m128i load_8x2(const uint8_t *p, int stride) {
+  return _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i *)p),
+                            _mm_loadl_epi64((const __m128i *)(p + stride)));
+}
+
+static INLINE void store_8x2(uint8_t *p, int stride, __m128i v) {
+  _mm_storel_epi64((__m128i *)p, v);
+  _mm_storel_epi64((__m128i *)(p + stride), _mm_srli_si128(v, 8));
+}
+
+// Blocks 8 pixels wide are filtered two rows at a time, wider ones 16 pixels
+// of a row at a time.
+static int strong_filter(const uint8_t *sig, int sig_stride,
+                         const uint8_t *mc_avg, int mc_avg_stride,
+                         uint8_t *avg, int avg_stride,
+                         int width, int height, const denoiser_adj *adj) {
+  __m128i sum_pos = _mm_setzero_si128();
+  __m128i sum_neg = _mm_setzero_si128();
+  int r, c;
+
+  if (width == 8) {
+    for (r = 0; r < height; r += 2) {
+      store_8x2(avg, avg_stride,
+                strong_filter_16(load_8x2(sig, sig_stride),
+                                 load_8x2(mc_avg, mc_avg_stride),
+                                 adj, &sum_pos, &sum_neg));
+      sig += 2 * sig_stride;
+      mc_avg += 2 * mc_avg_stride;
+      avg += 2 * avg_stride;
+    }
+  } else {
+    for (r = 0; r < height; ++r) {
+      for (c = 0; c < width; c += 16) {
+        _mm_storeu_si128(
+            (__m128i *)(avg + c),
+            strong_filter_16(_mm_loadu_si128((const __m128i *)(sig + c)),
+                             _mm_loadu_si128((const __m128i *)(mc_avg + c)),
+                             adj, &sum_pos, &sum_neg));
+      }
+      sig += sig_stride;
+      mc_avg += mc_avg_stride;
+      avg += avg_stride;
+    }
+  }
+  return sum_sad(sum_pos) - sum_sad(sum_neg);
+}
+
+static int weak_filter(const uint8_t *sig, int sig_stride,
+                       const uint8_t *mc_avg, int mc_avg_stride,
+                       uint8_t *avg, int avg_stride,
+                       int width, int height, int delta) {
+  const __m128i delta_8 = _mm_set1_epi8((char)delta);
+  __m128i sum_pos = _mm_setzero_si128();
+  __m128i sum_neg = _mm_setzero_si128();
+  int r, c;
+
+  if (width == 8) {
+    for (r = 0; r < height; r += 2) {
+      store_8x2(avg, avg_stride,
+                weak_filter_16(load_8x2(sig, sig_stride),
+                               load_8x2(mc_avg, mc_avg_stride),
+                               load_8x2(avg, avg_stride), delta_8,
+                               &sum_pos, &sum_neg));
+      sig += 2 * sig_stride;
+      mc_avg += 2 * mc_avg_stride;
+      avg += 2 * avg_stride;
+    }
+  } else {
+    for (r = 0; r < height; ++r) {
+      for (c = 0; c < width; c += 16) {
+        _mm_storeu_si128(
+            (__m128i *)(avg + c),
+            weak_filter_16(_mm_loadu_si128((const __m128i *)(sig + c)),
+                           _mm_loadu_si128((const __m128i *)(mc_avg + c)),
+                           _mm_loadu_si128((const __m128i *)(avg + c)),
+                           delta_8, &sum_pos, &sum_neg));
+      }
+      sig += sig_stride;
+      mc_avg += mc_avg_stride;
+      avg += avg_stride;
+    }
+  }
+  return sum_sad(sum_pos) - sum_sad(sum_neg);
+}
+
+int vp9_denoiser_filter_sse2(const uint8_t *sig, int sig_stride,
+                             const uint8_t *mc_avg, int mc_avg_stride,
+                             uint8_t *avg, int avg_stride,
+                             int increase_denoising, BLOCK_SIZE bs,
+                             int motion_magnitude) {
+  const int width = 4 << b_width_log2_lookup[bs];
+  const int height = 4 << b_height_log2_lookup[bs];
+  const int shift_inc = motion_magnitude <= MOTION_MAGNITUDE_THRESHOLD ?
+                        (increase_denoising ? 2 : 1) : 0;
+  denoiser_adj adj;
+  int total_adj, delta;
+
+  if (width == 4)
+    return vp9_denoiser_filter_c(sig, sig_stride, mc_avg, mc_avg_stride,
+                                 avg, avg_stride, increase_denoising, bs,
+                                 motion_magnitude);
+
+  adj.th = _mm_set1_epi8(absdiff_thresh(bs, increase_denoising));
+  adj.level0 = _mm_set1_epi8(3 + shift_inc);
+  adj.level1 = _mm_set1_epi8(4 + shift_inc);
+  adj.level2 = _mm_set1_epi8(6 + shift_inc);
+
+  // First attempt to apply a strong temporal denoising filter.
+  total_adj = strong_filter(sig, sig_stride, mc_avg, mc_avg_stride,
+                            avg, avg_stride, width, height, &adj);
+  if (abs(total_adj) <= total_adj_strong_thresh(bs, increase_denoising))
+    return FILTER_BLOCK;
+
+  // Otherwise, dampen the filter if the delta is not too high.
+  delta = ((abs(total_adj) - total_adj_strong_thresh(bs, increase_denoising))
+           >> 8) + 1;
+  if (delta >= delta_thresh(bs, increase_denoising))
+    return COPY_BLOCK;
+
+  total_adj += weak_filter(sig, sig_stride, mc_avg, mc_avg_stride,
+                           avg, avg_stride, width, height, delta);
+  if (abs(total_adj) <= total_adj_weak_thresh(bs, increase_denoising))
+    return FILTER_BLOCK;
+  return COPY_BLOCK;
+}
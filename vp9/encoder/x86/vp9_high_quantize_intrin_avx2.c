@@ -0,0 +1,228 @@
+/*
+ *  Copyright (c) 2014 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>  // AVX2
+
+#include "./vp9_rtcd.h"
+#include "./vpx_config.h"
+#include "vp9/common/vp9_common.h"
+
+// The SSE2 versions on 8 coefficients at a time, with the same range: blocks
+// with coefficients above 2^24, or a negative rounding, are left to C.
+#define HIGH_QUANT_MAX_COEFF (1 << 24)
+
+// (a * q) >> shift for the non-negative lanes of 'a' and the sign extended 16
+// bit multipliers 'q', 'shift' being 15 or 16. As in SSE2 the products are
+// formed in 64 bits with the multipliers taken unsigned, and corrected.
+static INLINE __m256i high_mul_shift(__m256i a, __m256i q, int shift) {
+  const __m128i count = _mm_cvtsi32_si128(shift);
+  const __m256i q_neg = _mm256_srai_epi32(q, 31);
+  const __m256i q_u = _mm256_and_si256(q, _mm256_set1_epi32(0xffff));
+  const __m256i even = _mm256_srl_epi64(_mm256_mul_epu32(a, q_u), count);
+  const __m256i odd = _mm256_srl_epi64(
+      _mm256_mul_epu32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(q_u, 32)),
+      count);
+  const __m256i prod = _mm256_blend_epi32(even, _mm256_slli_epi64(odd, 32),
+                                          0xaa);
+  return _mm256_sub_epi32(prod, _mm256_and_si256(q_neg,
+                                                 _mm256_slli_epi32(
+                                                     a, 16 - shift)));
+}
+
+// Quantizes the coefficients in raster order, 8 at a time, like
+// high_quantize() of vp9_high_quantize_intrin_sse2.c. Returns 0, with nothing
+// of the output to be kept, when a coefficient is out of range.
+static int high_quantize(const tran_low_t *coeff_ptr, intptr_t n_coeffs,
+                         const int *zbin, const int *round,
+                         const int16_t *quant_ptr,
+                         const int16_t *quant_shift_ptr,
+                         const int16_t *dequant_ptr, int is_32x32,
+                         tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr,
+                         uint16_t *eob_ptr, const int16_t *iscan) {
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i max_coeff = _mm256_set1_epi32(HIGH_QUANT_MAX_COEFF);
+  const __m128i one = _mm_set1_epi16(1);
+  // The DC coefficient takes the first lane of the first group.
+  __m256i zbin_v = _mm256_setr_epi32(zbin[0] - 1, zbin[1] - 1, zbin[1] - 1,
+                                     zbin[1] - 1, zbin[1] - 1, zbin[1] - 1,
+                                     zbin[1] - 1, zbin[1] - 1);
+  __m256i round_v = _mm256_setr_epi32(round[0], round[1], round[1], round[1],
+                                      round[1], round[1], round[1], round[1]);
+  __m256i quant_v = _mm256_setr_epi32(quant_ptr[0], quant_ptr[1],
+                                      quant_ptr[1], quant_ptr[1],
+                                      quant_ptr[1], quant_ptr[1],
+                                      quant_ptr[1], quant_ptr[1]);
+  __m256i shift_v = quant_shift_ptr ?
+      _mm256_setr_epi32(quant_shift_ptr[0], quant_shift_ptr[1],
+                        quant_shift_ptr[1], quant_shift_ptr[1],
+                        quant_shift_ptr[1], quant_shift_ptr[1],
+                        quant_shift_ptr[1], quant_shift_ptr[1]) : zero;
+  __m256i dequant_v = _mm256_setr_epi32(dequant_ptr[0], dequant_ptr[1],
+                                        dequant_ptr[1], dequant_ptr[1],
+                                        dequant_ptr[1], dequant_ptr[1],
+                                        dequant_ptr[1], dequant_ptr[1]);
+  __m256i out_of_range = zero;
+  __m128i eob = _mm_setzero_si128();
+  intptr_t i;
+
+  for (i = 0; i < n_coeffs; i += 8) {
+    const __m256i coeff = _mm256_loadu_si256((const __m256i *)(coeff_ptr + i));
+    const __m256i abs_coeff = _mm256_abs_epi32(coeff);
+    const __m256i t = _mm256_add_epi32(abs_coeff, round_v);
+    __m256i tmp, qcoeff, dqcoeff, zero_mask;
+    __m128i nz;
+
+    out_of_range = _mm256_or_si256(out_of_range,
+                                   _mm256_cmpgt_epi32(abs_coeff, max_coeff));
+    out_of_range = _mm256_or_si256(out_of_range,
+                                   _mm256_cmpgt_epi32(zero, abs_coeff));
+
+    if (quant_shift_ptr) {
+      tmp = high_mul_shift(t, quant_v, 16);
+      tmp = high_mul_shift(_mm256_add_epi32(tmp, t), shift_v,
+                           is_32x32 ? 15 : 16);
+    } else if (is_32x32) {
+      tmp = high_mul_shift(t, quant_v, 15);
+    } else {
+      tmp = _mm256_srai_epi32(_mm256_mullo_epi32(t, quant_v), 16);
+    }
+    tmp = _mm256_and_si256(tmp, _mm256_cmpgt_epi32(abs_coeff, zbin_v));
+
+    qcoeff = _mm256_sign_epi32(tmp, coeff);
+    dqcoeff = _mm256_mullo_epi32(qcoeff, dequant_v);
+    if (is_32x32)
+      dqcoeff = _mm256_srai_epi32(
+          _mm256_add_epi32(dqcoeff, _mm256_srli_epi32(dqcoeff, 31)), 1);
+    _mm256_storeu_si256((__m256i *)(qcoeff_ptr + i), qcoeff);
+    _mm256_storeu_si256((__m256i *)(dqcoeff_ptr + i), dqcoeff);
+
+    // Positions of the non-zero coefficients, plus one, in 16 bits.
+    zero_mask = _mm256_cmpeq_epi32(tmp, zero);
+    nz = _mm_packs_epi32(_mm256_castsi256_si128(zero_mask),
+                         _mm256_extracti128_si256(zero_mask, 1));
+    nz = _mm_andnot_si128(nz, _mm_add_epi16(
+        _mm_loadu_si128((const __m128i *)(iscan + i)), one));
+    eob = _mm_max_epi16(eob, nz);
+
+    if (i == 0) {
+      zbin_v = _mm256_permutevar8x32_epi32(zbin_v, _mm256_set1_epi32(1));
+      round_v = _mm256_permutevar8x32_epi32(round_v, _mm256_set1_epi32(1));
+      quant_v = _mm256_permutevar8x32_epi32(quant_v, _mm256_set1_epi32(1));
+      shift_v = _mm256_permutevar8x32_epi32(shift_v, _mm256_set1_epi32(1));
+      dequant_v = _mm256_permutevar8x32_epi32(dequant_v,
+                                              _mm256_set1_epi32(1));
+    }
+  }
+
+  if (_mm256_movemask_epi8(out_of_range))
+    return 0;
+
+  eob = _mm_max_epi16(eob, _mm_srli_si128(eob, 8));
+  eob = _mm_max_epi16(eob, _mm_srli_si128(eob, 4));
+  eob = _mm_max_epi16(eob, _mm_srli_si128(eob, 2));
+  *eob_ptr = (uint16_t)_mm_extract_epi16(eob, 0);
+  return 1;
+}
+
+void vp9_high_quantize_fp_avx2(const tran_low_t *coeff_ptr, intptr_t n_coeffs,
+                               int skip_block, const int16_t *zbin_ptr,
+                               const int16_t *round_ptr,
+                               const int16_t *quant_ptr,
+                               const int16_t *quant_shift_ptr,
+                               tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr,
+                               const int16_t *dequant_ptr, int zbin_oq_value,
+                               uint16_t *eob_ptr, const int16_t *scan,
+                               const int16_t *iscan) {
+  const int zbin[2] = { 0, 0 };
+  const int round[2] = { round_ptr[0], round_ptr[1] };
+
+  if (skip_block || round[0] < 0 || round[1] < 0 ||
+      !high_quantize(coeff_ptr, n_coeffs, zbin, round, quant_ptr, NULL,
+                     dequant_ptr, 0, qcoeff_ptr, dqcoeff_ptr, eob_ptr, iscan))
+    vp9_high_quantize_fp_c(coeff_ptr, n_coeffs, skip_block, zbin_ptr,
+                           round_ptr, quant_ptr, quant_shift_ptr, qcoeff_ptr,
+                           dqcoeff_ptr, dequant_ptr, zbin_oq_value, eob_ptr,
+                           scan, iscan);
+}
+
+void vp9_high_quantize_fp_32x32_avx2(const tran_low_t *coeff_ptr,
+                                     intptr_t n_coeffs, int skip_block,
+                                     const int16_t *zbin_ptr,
+                                     const int16_t *round_ptr,
+                                     const int16_t *quant_ptr,
+                                     const int16_t *quant_shift_ptr,
+                                     tran_low_t *qcoeff_ptr,
+                                     tran_low_t *dqcoeff_ptr,
+                                     const int16_t *dequant_ptr,
+                                     int zbin_oq_value, uint16_t *eob_ptr,
+                                     const int16_t *scan,
+                                     const int16_t *iscan) {
+  const int zbin[2] = { dequant_ptr[0] >> 2, dequant_ptr[1] >> 2 };
+  const int round[2] = { ROUND_POWER_OF_TWO(round_ptr[0], 1),
+                         ROUND_POWER_OF_TWO(round_ptr[1], 1) };
+
+  if (skip_block || round[0] < 0 || round[1] < 0 ||
+      !high_quantize(coeff_ptr, n_coeffs, zbin, round, quant_ptr, NULL,
+                     dequant_ptr, 1, qcoeff_ptr, dqcoeff_ptr, eob_ptr, iscan))
+    vp9_high_quantize_fp_32x32_c(coeff_ptr, n_coeffs, skip_block, zbin_ptr,
+                                 round_ptr, quant_ptr, quant_shift_ptr,
+                                 qcoeff_ptr, dqcoeff_ptr, dequant_ptr,
+                                 zbin_oq_value, eob_ptr, scan, iscan);
+}
+
+void vp9_high_quantize_b_avx2(const tran_low_t *coeff_ptr, intptr_t n_coeffs,
+                              int skip_block, const int16_t *zbin_ptr,
+                              const int16_t *round_ptr,
+                              const int16_t *quant_ptr,
+                              const int16_t *quant_shift_ptr,
+                              tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr,
+                              const int16_t *dequant_ptr, int zbin_oq_value,
+                              uint16_t *eob_ptr, const int16_t *scan,
+                              const int16_t *iscan) {
+  const int zbin[2] = { zbin_ptr[0] + zbin_oq_value,
+                        zbin_ptr[1] + zbin_oq_value };
+  const int round[2] = { round_ptr[0], round_ptr[1] };
+
+  if (skip_block || round[0] < 0 || round[1] < 0 ||
+      !high_quantize(coeff_ptr, n_coeffs, zbin, round, quant_ptr,
+                     quant_shift_ptr, dequant_ptr, 0, qcoeff_ptr, dqcoeff_ptr,
+                     eob_ptr, iscan))
+    vp9_high_quantize_b_c(coeff_ptr, n_coeffs, skip_block, zbin_ptr,
+                          round_ptr, quant_ptr, quant_shift_ptr, qcoeff_ptr,
+                          dqcoeff_ptr, dequant_ptr, zbin_oq_value, eob_ptr,
+                          scan, iscan);
+}
+
+void vp9_high_quantize_b_32x32_avx2(const tran_low_t *coeff_ptr,
+                                    intptr_t n_coeffs, int skip_block,
+                                    const int16_t *zbin_ptr,
+                                    const int16_t *round_ptr,
+                                    const int16_t *quant_ptr,
+                                    const int16_t *quant_shift_ptr,
+                                    tran_low_t *qcoeff_ptr,
+                                    tran_low_t *dqcoeff_ptr,
+                                    const int16_t *dequant_ptr,
+                                    int zbin_oq_value, uint16_t *eob_ptr,
+                                    const int16_t *scan,
+                                    const int16_t *iscan) {
+  const int zbin[2] = { ROUND_POWER_OF_TWO(zbin_ptr[0] + zbin_oq_value, 1),
+                        ROUND_POWER_OF_TWO(zbin_ptr[1] + zbin_oq_value, 1) };
+  const int round[2] = { ROUND_POWER_OF_TWO(round_ptr[0], 1),
+                         ROUND_POWER_OF_TWO(round_ptr[1], 1) };
+
+  if (skip_block || round[0] < 0 || round[1] < 0 ||
+      !high_quantize(coeff_ptr, n_coeffs, zbin, round, quant_ptr,
+                     quant_shift_ptr, dequant_ptr, 1, qcoeff_ptr, dqcoeff_ptr,
+                     eob_ptr, iscan))
+    vp9_high_quantize_b_32x32_c(coeff_ptr, n_coeffs, skip_block, zbin_ptr,
+                                round_ptr, quant_ptr, quant_shift_ptr,
+                                qcoeff_ptr, dqcoeff_ptr, dequant_ptr,
+                                zbin_oq_value, eob_ptr, scan, iscan);
+}
@@ -0,0 +1,232 @@
+/*
+ *  Copyright (c) 2014 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <emmintrin.h>  // SSE2
+
+#include "./vp9_rtcd.h"
+#include "./vpx_config.h"
+#include "vp9/common/vp9_common.h"
+
+// The coefficients are quantized in 32 bit lanes. This holds for the output
+// of the forward transforms at 12 bits with a wide margin; blocks with larger
+// coefficients, or a negative rounding, are left to the C versions.
+#define HIGH_QUANT_MAX_COEFF (1 << 24)
+
+// Low 32 bits of the products of the 32 bit lanes of 'a' and 'b'.
+static INLINE __m128i high_mullo_epi32(__m128i a, __m128i b) {
+  const __m128i even = _mm_mul_epu32(a, b);
+  const __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32),
+                                    _mm_srli_epi64(b, 32));
+  return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, 0x08),
+                            _mm_shuffle_epi32(odd, 0x08));
+}
+
+// (a * q) >> shift for the non-negative lanes of 'a' and the sign extended 16
+// bit multipliers 'q', 'shift' being 15 or 16. The products are formed in 64
+// bits with the multipliers taken unsigned; a negative one is 2^16 too large,
+// which takes a << (16 - shift) off the shifted product.
+static INLINE __m128i high_mul_shift(__m128i a, __m128i q, int shift) {
+  const __m128i count = _mm_cvtsi32_si128(shift);
+  const __m128i q_neg = _mm_srai_epi32(q, 31);
+  const __m128i q_u = _mm_and_si128(q, _mm_set1_epi32(0xffff));
+  const __m128i even = _mm_srl_epi64(_mm_mul_epu32(a, q_u), count);
+  const __m128i odd = _mm_srl_epi64(_mm_mul_epu32(_mm_srli_epi64(a, 32),
+                                                  _mm_srli_epi64(q_u, 32)),
+                                    count);
+  const __m128i prod = _mm_or_si128(_mm_and_si128(even,
+                                                  _mm_set_epi32(0, -1, 0, -1)),
+                                    _mm_slli_epi64(odd, 32));
+  return _mm_sub_epi32(prod, _mm_and_si128(q_neg,
+                                           _mm_sll_epi32(a, _mm_cvtsi32_si128(
+                                               16 - shift))));
+}
+
+// Quantizes the coefficients in raster order, 4 at a time, the end of block
+// being the largest 'iscan' position of a non-zero coefficient. Coefficients
+// below 'zbin' are zeroed. The fp versions take a single multiplier,
+// 'quant_shift_ptr' is NULL for them; like in C the 4x4 to 16x16 one is
+// applied in 32 bits. The 32x32 versions keep one more bit of the product
+// and halve the dequantized coefficients. Returns 0, with nothing of the
+// output to be kept, when a coefficient is out of range.
+static int high_quantize(const tran_low_t *coeff_ptr, intptr_t n_coeffs,
+                         const int *zbin, const int *round,
+                         const int16_t *quant_ptr,
+                         const int16_t *quant_shift_ptr,
+                         const int16_t *dequant_ptr, int is_32x32,
+                         tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr,
+                         uint16_t *eob_ptr, const int16_t *iscan) {
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i max_coeff = _mm_set1_epi32(HIGH_QUANT_MAX_COEFF);
+  const __m128i one = _mm_set1_epi16(1);
+  // The DC coefficient takes the first lane of the first group.
+  __m128i zbin_v = _mm_setr_epi32(zbin[0] - 1, zbin[1] - 1,
+                                  zbin[1] - 1, zbin[1] - 1);
+  __m128i round_v = _mm_setr_epi32(round[0], round[1], round[1], round[1]);
+  __m128i quant_v = _mm_setr_epi32(quant_ptr[0], quant_ptr[1],
+                                   quant_ptr[1], quant_ptr[1]);
+  __m128i shift_v = quant_shift_ptr ?
+      _mm_setr_epi32(quant_shift_ptr[0], quant_shift_ptr[1],
+                     quant_shift_ptr[1], quant_shift_ptr[1]) : zero;
+  __m128i dequant_v = _mm_setr_epi32(dequant_ptr[0], dequant_ptr[1],
+                                     dequant_ptr[1], dequant_ptr[1]);
+  __m128i out_of_range = zero, eob = zero;
+  intptr_t i;
+
+  for (i = 0; i < n_coeffs; i += 4) {
+    const __m128i coeff = _mm_loadu_si128((const __m128i *)(coeff_ptr + i));
+    const __m128i sign = _mm_srai_epi32(coeff, 31);
+    const __m128i abs_coeff = _mm_sub_epi32(_mm_xor_si128(coeff, sign), sign);
+    const __m128i t = _mm_add_epi32(abs_coeff, round_v);
+    __m128i tmp, qcoeff, dqcoeff, nz;
+
+    out_of_range = _mm_or_si128(out_of_range,
+                                _mm_cmpgt_epi32(abs_coeff, max_coeff));
+    out_of_range = _mm_or_si128(out_of_range,
+                                _mm_cmplt_epi32(abs_coeff, zero));
+
+    if (quant_shift_ptr) {
+      tmp = high_mul_shift(t, quant_v, 16);
+      tmp = high_mul_shift(_mm_add_epi32(tmp, t), shift_v,
+                           is_32x32 ? 15 : 16);
+    } else if (is_32x32) {
+      tmp = high_mul_shift(t, quant_v, 15);
+    } else {
+      tmp = _mm_srai_epi32(high_mullo_epi32(t, quant_v), 16);
+    }
+    tmp = _mm_and_si128(tmp, _mm_cmpgt_epi32(abs_coeff, zbin_v));
+
+    qcoeff = _mm_sub_epi32(_mm_xor_si128(tmp, sign), sign);
+    dqcoeff = high_mullo_epi32(qcoeff, dequant_v);
+    if (is_32x32)
+      dqcoeff = _mm_srai_epi32(_mm_add_epi32(dqcoeff,
+                                             _mm_srli_epi32(dqcoeff, 31)), 1);
+    _mm_storeu_si128((__m128i *)(qcoeff_ptr + i), qcoeff);
+    _mm_storeu_si128((__m128i *)(dqcoeff_ptr + i), dqcoeff);
+
+    // Positions of the non-zero coefficients, plus one, in 16 bits.
+    nz = _mm_cmpeq_epi32(tmp, zero);
+    nz = _mm_andnot_si128(_mm_packs_epi32(nz, nz),
+                          _mm_add_epi16(_mm_loadl_epi64((const __m128i *)
+                                                        (iscan + i)), one));
+    eob = _mm_max_epi16(eob, nz);
+
+    if (i == 0) {
+      zbin_v = _mm_unpackhi_epi64(zbin_v, zbin_v);
+      round_v = _mm_unpackhi_epi64(round_v, round_v);
+      quant_v = _mm_unpackhi_epi64(quant_v, quant_v);
+      shift_v = _mm_unpackhi_epi64(shift_v, shift_v);
+      dequant_v = _mm_unpackhi_epi64(dequant_v, dequant_v);
+    }
+  }
+
+  if (_mm_movemask_epi8(out_of_range))
+    return 0;
+
+  eob = _mm_max_epi16(eob, _mm_srli_si128(eob, 4));
+  eob = _mm_max_epi16(eob, _mm_srli_si128(eob, 2));
+  *eob_ptr = (uint16_t)_mm_extract_epi16(eob, 0);
+  return 1;
+}
+
+void vp9_high_quantize_fp_sse2(const tran_low_t *coeff_ptr, intptr_t n_coeffs,
+                               int skip_block, const int16_t *zbin_ptr,
+                               const int16_t *round_ptr,
+                               const int16_t *quant_ptr,
+                               const int16_t *quant_shift_ptr,
+                               tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr,
+                               const int16_t *dequant_ptr, int zbin_oq_value,
+                               uint16_t *eob_ptr, const int16_t *scan,
+                               const int16_t *iscan) {
+  const int zbin[2] = { 0, 0 };
+  const int round[2] = { round_ptr[0], round_ptr[1] };
+
+  if (skip_block || round[0] < 0 || round[1] < 0 ||
+      !high_quantize(coeff_ptr, n_coeffs, zbin, round, quant_ptr, NULL,
+                     dequant_ptr, 0, qcoeff_ptr, dqcoeff_ptr, eob_ptr, iscan))
+    vp9_high_quantize_fp_c(coeff_ptr, n_coeffs, skip_block, zbin_ptr,
+                           round_ptr, quant_ptr, quant_shift_ptr, qcoeff_ptr,
+                           dqcoeff_ptr, dequant_ptr, zbin_oq_value, eob_ptr,
+                           scan, iscan);
+}
+
+void vp9_high_quantize_fp_32x32_sse2(const tran_low_t *coeff_ptr,
+                                     intptr_t n_coeffs, int skip_block,
+                                     const int16_t *zbin_ptr,
+                                     const int16_t *round_ptr,
+                                     const int16_t *quant_ptr,
+                                     const int16_t *quant_shift_ptr,
+                                     tran_low_t *qcoeff_ptr,
+                                     tran_low_t *dqcoeff_ptr,
+                                     const int16_t *dequant_ptr,
+                                     int zbin_oq_value, uint16_t *eob_ptr,
+                                     const int16_t *scan,
+                                     const int16_t *iscan) {
+  const int zbin[2] = { dequant_ptr[0] >> 2, dequant_ptr[1] >> 2 };
+  const int round[2] = { ROUND_POWER_OF_TWO(round_ptr[0], 1),
+                         ROUND_POWER_OF_TWO(round_ptr[1], 1) };
+
+  if (skip_block || round[0] < 0 || round[1] < 0 ||
+      !high_quantize(coeff_ptr, n_coeffs, zbin, round, quant_ptr, NULL,
+                     dequant_ptr, 1, qcoeff_ptr, dqcoeff_ptr, eob_ptr, iscan))
+    vp9_high_quantize_fp_32x32_c(coeff_ptr, n_coeffs, skip_block, zbin_ptr,
+                                 round_ptr, quant_ptr, quant_shift_ptr,
+                                 qcoeff_ptr, dqcoeff_ptr, dequant_ptr,
+                                 zbin_oq_value, eob_ptr, scan, iscan);
+}
+
+void vp9_high_quantize_b_sse2(const tran_low_t *coeff_ptr, intptr_t n_coeffs,
+                              int skip_block, const int16_t *zbin_ptr,
+                              const int16_t *round_ptr,
+                              const int16_t *quant_ptr,
+                              const int16_t *quant_shift_ptr,
+                              tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr,
+                              const int16_t *dequant_ptr, int zbin_oq_value,
+                              uint16_t *eob_ptr, const int16_t *scan,
+                              const int16_t *iscan) {
+  const int zbin[2] = { zbin_ptr[0] + zbin_oq_value,
+                        zbin_ptr[1] + zbin_oq_value };
+  const int round[2] = { round_ptr[0], round_ptr[1] };
+
+  if (skip_block || round[0] < 0 || round[1] < 0 ||
+      !high_quantize(coeff_ptr, n_coeffs, zbin, round, quant_ptr,
+                     quant_shift_ptr, dequant_ptr, 0, qcoeff_ptr, dqcoeff_ptr,
+                     eob_ptr, iscan))
+    vp9_high_quantize_b_c(coeff_ptr, n_coeffs, skip_block, zbin_ptr,
+                          round_ptr, quant_ptr, quant_shift_ptr, qcoeff_ptr,
+                          dqcoeff_ptr, dequant_ptr, zbin_oq_value, eob_ptr,
+                          scan, iscan);
+}
+
+void vp9_high_quantize_b_32x32_sse2(const tran_low_t *coeff_ptr,
+                                    intptr_t n_coeffs, int skip_block,
+                                    const int16_t *zbin_ptr,
+                                    const int16_t *round_ptr,
+                                    const int16_t *quant_ptr,
+                                    const int16_t *quant_shift_ptr,
+                                    tran_low_t *qcoeff_ptr,
+                                    tran_low_t *dqcoeff_ptr,
+                                    const int16_t *dequant_ptr,
+                                    int zbin_oq_value, uint16_t *eob_ptr,
+                                    const int16_t *scan,
+                                    const int16_t *iscan) {
+  const int zbin[2] = { ROUND_POWER_OF_TWO(zbin_ptr[0] + zbin_oq_value, 1),
+                        ROUND_POWER_OF_TWO(zbin_ptr[1] + zbin_oq_value, 1) };
+  const int round[2] = { ROUND_POWER_OF_TWO(round_ptr[0], 1),
+                         ROUND_POWER_OF_TWO(round_ptr[1], 1) };
+
+  if (skip_block || round[0] < 0 || round[1] < 0 ||
+      !high_quantize(coeff_ptr, n_coeffs, zbin, round, quant_ptr,
+                     quant_shift_ptr, dequant_ptr, 1, qcoeff_ptr, dqcoeff_ptr,
+                     eob_ptr, iscan))
+    vp9_high_quantize_b_32x32_c(coeff_ptr, n_coeffs, skip_block, zbin_ptr,
+                                round_ptr, quant_ptr, quant_shift_ptr,
+                                qcoeff_ptr, dqcoeff_ptr, dequant_ptr,
+                                zbin_oq_value, eob_ptr, scan, iscan);
+}
@@ -0,0 +1,143 @@
+/*
+ *  Copyright (c) 2014 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>  // AVX2
+
+#include "./vp9_rtcd.h"
+#include "./vpx_config.h"
+#include "vp9/common/vp9_common.h"
+
+// Adds the absolute differences of the 16 pixels 'a' and 'b' to the 32 bit
+// lanes of 'sad'. Pixels are at most 12 bits, the differences fit the signed
+// multiply-add.
+static INLINE __m256i high_sad_16(__m256i a, __m256i b, __m256i sad) {
+  const __m256i absdiff = _mm256_abs_epi16(_mm256_sub_epi16(a, b));
+  return _mm256_add_epi32(sad, _mm256_madd_epi16(absdiff,
+                                                 _mm256_set1_epi16(1)));
+}
+
+static INLINE unsigned int high_sad_sum(__m256i sad) {
+  __m128i sum = _mm_add_epi32(_mm256_castsi256_si128(sad),
+                              _mm256_extracti128_si256(sad, 1));
+  sum = _mm_add_epi32(sum, _mm_srli_si128(sum, 8));
+  sum = _mm_add_epi32(sum, _mm_srli_si128(sum, 4));
+  return _mm_cvtsi128_si32(sum);
+}
+
+// SAD of a w x h block, w being a multiple of 16. When 'second_pred' is set
+// the reference is averaged with it first, the compound prediction being w
+// pixels wide.
+static INLINE unsigned int high_sad(const uint16_t *src, int src_stride,
+                                    const uint16_t *ref, int ref_stride,
+                                    const uint16_t *second_pred, int w, int h) {
+  __m256i sad = _mm256_setzero_si256();
+  int r, c;
+
+  for (r = 0; r < h; ++r) {
+    for (c = 0; c < w; c += 16) {
+      __m256i b = _mm256_loadu_si256((const __m256i *)(ref + c));
+      if (second_pred)
+        b = _mm256_avg_epu16(b, _mm256_loadu_si256((const __m256i *)
+                                                   (second_pred + c)));
+      sad = high_sad_16(_mm256_loadu_si256((const __m256i *)(src + c)), b,
+                        sad);
+    }
+    src += src_stride;
+    ref += ref_stride;
+    if (second_pred)
+      second_pred += w;
+  }
+  return high_sad_sum(sad);
+}
+
+// The 4 SADs of a w x h block, each source row being loaded once.
+static INLINE void high_sad_x4d(const uint16_t *src, int src_stride,
+                                const uint8_t *const refs[], int ref_stride,
+                                int w, int h, unsigned int *sads) {
+  const uint16_t *ref[4];
+  __m256i sad[4];
+  int i, r, c;
+
+  for (i = 0; i < 4; ++i) {
+    ref[i] = CONVERT_TO_SHORTPTR(refs[i]);
+    sad[i] = _mm256_setzero_si256();
+  }
+  for (r = 0; r < h; ++r) {
+    for (c = 0; c < w; c += 16) {
+      const __m256i a = _mm256_loadu_si256((const __m256i *)(src + c));
+      for (i = 0; i < 4; ++i)
+        sad[i] = high_sad_16(a, _mm256_loadu_si256((const __m256i *)
+                                                   (ref[i] + c)), sad[i]);
+    }
+    src += src_stride;
+    for (i = 0; i < 4; ++i)
+      ref[i] += ref_stride;
+  }
+  for (i = 0; i < 4; ++i)
+    sads[i] = high_sad_sum(sad[i]);
+}
+
+#define high_sadMxN(m, n) \
+unsigned int vp9_high_sad##m##x##n##_avx2(const uint8_t *src, \
+                                          int src_stride, \
+                                          const uint8_t *ref, \
+                                          int ref_stride) { \
+  return high_sad(CONVERT_TO_SHORTPTR(src), src_stride, \
+                  CONVERT_TO_SHORTPTR(ref), ref_stride, NULL, m, n); \
+} \
+unsigned int vp9_high_sad##m##x##n##_avg_avx2(const uint8_t *src, \
+                                              int src_stride, \
+                                              const uint8_t *ref, \
+                                              int ref_stride, \
+                                              const uint8_t *second_pred) { \
+  return high_sad(CONVERT_TO_SHORTPTR(src), src_stride, \
+                  CONVERT_TO_SHORTPTR(ref), ref_stride, \
+                  CONVERT_TO_SHORTPTR(second_pred), m, n); \
+}
+
+#define high_sadMxNx4D(m, n) \
+void vp9_high_sad##m##x##n##x4d_avx2(const uint8_t *src, int src_stride, \
+                                     const uint8_t *const refs[], \
+                                     int ref_stride, unsigned int *sads) { \
+  high_sad_x4d(CONVERT_TO_SHORTPTR(src), src_stride, refs, ref_stride, \
+               m, n, sads); \
+}
+
+// 64x64
+high_sadMxN(64, 64)
+high_sadMxNx4D(64, 64)
+
+// 64x32
+high_sadMxN(64, 32)
+high_sadMxNx4D(64, 32)
+
+// 32x64
+high_sadMxN(32, 64)
+high_sadMxNx4D(32, 64)
+
+// 32x32
+high_sadMxN(32, 32)
+high_sadMxNx4D(32, 32)
+
+// 32x16
+high_sadMxN(32, 16)
+high_sadMxNx4D(32, 16)
+
+// 16x32
+high_sadMxN(16, 32)
+high_sadMxNx4D(16, 32)
+
+// 16x16
+high_sadMxN(16, 16)
+high_sadMxNx4D(16, 16)
+
+// 16x8
+high_sadMxN(16, 8)
+high_sadMxNx4D(16, 8)
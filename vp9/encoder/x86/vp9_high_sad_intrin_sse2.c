@@ -0,0 +1,175 @@
+/*
+ *  Copyright (c) 2014 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <emmintrin.h>  // SSE2
+
+#include "./vp9_rtcd.h"
+#include "./vpx_config.h"
+#include "vp9/common/vp9_common.h"
+
+// Adds the absolute differences of the 8 pixels 'a' and 'b' to the 32 bit
+// lanes of 'sad'. Pixels are at most 12 bits, the differences fit the signed
+// multiply-add.
+static INLINE __m128i high_sad_8(__m128i a, __m128i b, __m128i sad) {
+  const __m128i absdiff = _mm_or_si128(_mm_subs_epu16(a, b),
+                                       _mm_subs_epu16(b, a));
+  return _mm_add_epi32(sad, _mm_madd_epi16(absdiff, _mm_set1_epi16(1)));
+}
+
+static INLINE __m128i high_load_4x2(const uint16_t *p, int stride) {
+  return _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i *)p),
+                            _mm_loadl_epi64((const __m128i *)(p + stride)));
+}
+
+// SAD of a w x h block. When 'second_pred' is set the reference is averaged
+// with it first, the compound prediction being w pixels wide.
+static unsigned int high_sad(const uint16_t *src, int src_stride,
+                             const uint16_t *ref, int ref_stride,
+                             const uint16_t *second_pred, int w, int h) {
+  __m128i sad = _mm_setzero_si128();
+  int r, c;
+
+  if (w == 4) {
+    for (r = 0; r < h; r += 2) {
+      __m128i b = high_load_4x2(ref, ref_stride);
+      if (second_pred) {
+        b = _mm_avg_epu16(b, _mm_loadu_si128((const __m128i *)second_pred));
+        second_pred += 8;
+      }
+      sad = high_sad_8(high_load_4x2(src, src_stride), b, sad);
+      src += 2 * src_stride;
+      ref += 2 * ref_stride;
+    }
+  } else {
+    for (r = 0; r < h; ++r) {
+      for (c = 0; c < w; c += 8) {
+        __m128i b = _mm_loadu_si128((const __m128i *)(ref + c));
+        if (second_pred)
+          b = _mm_avg_epu16(b, _mm_loadu_si128((const __m128i *)
+                                               (second_pred + c)));
+        sad = high_sad_8(_mm_loadu_si128((const __m128i *)(src + c)), b, sad);
+      }
+      src += src_stride;
+      ref += ref_stride;
+      if (second_pred)
+        second_pred += w;
+    }
+  }
+
+  sad = _mm_add_epi32(sad, _mm_srli_si128(sad, 8));
+  sad = _mm_add_epi32(sad, _mm_srli_si128(sad, 4));
+  return _mm_cvtsi128_si32(sad);
+}
+
+#define high_sadMxN(m, n) \
+unsigned int vp9_high_sad##m##x##n##_sse2(const uint8_t *src, \
+                                          int src_stride, \
+                                          const uint8_t *ref, \
+                                          int ref_stride) { \
+  return high_sad(CONVERT_TO_SHORTPTR(src), src_stride, \
+                  CONVERT_TO_SHORTPTR(ref), ref_stride, NULL, m, n); \
+} \
+unsigned int vp9_high_sad##m##x##n##_avg_sse2(const uint8_t *src, \
+                                              int src_stride, \
+                                              const uint8_t *ref, \
+                                              int ref_stride, \
+                                              const uint8_t *second_pred) { \
+  return high_sad(CONVERT_TO_SHORTPTR(src), src_stride, \
+                  CONVERT_TO_SHORTPTR(ref), ref_stride, \
+                  CONVERT_TO_SHORTPTR(second_pred), m, n); \
+}
+
+#define high_sadMxNxK(m, n, k) \
+void vp9_high_sad##m##x##n##x##k##_sse2(const uint8_t *src, int src_stride, \
+                                        const uint8_t *ref, int ref_stride, \
+                                        unsigned int *sads) { \
+  int i; \
+  for (i = 0; i < k; ++i) \
+    sads[i] = high_sad(CONVERT_TO_SHORTPTR(src), src_stride, \
+                       CONVERT_TO_SHORTPTR(ref) + i, ref_stride, NULL, m, n); \
+}
+
+#define high_sadMxNx4D(m, n) \
+void vp9_high_sad##m##x##n##x4d_sse2(const uint8_t *src, int src_stride, \
+                                     const uint8_t *const refs[], \
+                                     int ref_stride, unsigned int *sads) { \
+  int i; \
+  for (i = 0; i < 4; ++i) \
+    sads[i] = high_sad(CONVERT_TO_SHORTPTR(src), src_stride, \
+                       CONVERT_TO_SHORTPTR(refs[i]), ref_stride, NULL, m, n); \
+}
+
+// 64x64
+high_sadMxN(64, 64)
+high_sadMxNxK(64, 64, 3)
+high_sadMxNxK(64, 64, 8)
+high_sadMxNx4D(64, 64)
+
+// 64x32
+high_sadMxN(64, 32)
+high_sadMxNx4D(64, 32)
+
+// 32x64
+high_sadMxN(32, 64)
+high_sadMxNx4D(32, 64)
+
+// 32x32
+high_sadMxN(32, 32)
+high_sadMxNxK(32, 32, 3)
+high_sadMxNxK(32, 32, 8)
+high_sadMxNx4D(32, 32)
+
+// 32x16
+high_sadMxN(32, 16)
+high_sadMxNx4D(32, 16)
+
+// 16x32
+high_sadMxN(16, 32)
+high_sadMxNx4D(16, 32)
+
+// 16x16
+high_sadMxN(16, 16)
+high_sadMxNxK(16, 16, 3)
+high_sadMxNxK(16, 16, 8)
+high_sadMxNx4D(16, 16)
+
+// 16x8
+high_sadMxN(16, 8)
+high_sadMxNxK(16, 8, 3)
+high_sadMxNxK(16, 8, 8)
+high_sadMxNx4D(16, 8)
+
+// 8x16
+high_sadMxN(8, 16)
+high_sadMxNxK(8, 16, 3)
+high_sadMxNxK(8, 16, 8)
+high_sadMxNx4D(8, 16)
+
+// 8x8
+high_sadMxN(8, 8)
+high_sadMxNxK(8, 8, 3)
+high_sadMxNxK(8, 8, 8)
+high_sadMxNx4D(8, 8)
+
+// 8x4
+high_sadMxN(8, 4)
+high_sadMxNxK(8, 4, 8)
+high_sadMxNx4D(8, 4)
+
+// 4x8
+high_sadMxN(4, 8)
+high_sadMxNxK(4, 8, 8)
+high_sadMxNx4D(4, 8)
+
+// 4x4
+high_sadMxN(4, 4)
+high_sadMxNxK(4, 4, 3)
+high_sadMxNxK(4, 4, 8)
+high_sadMxNx4D(4, 4)
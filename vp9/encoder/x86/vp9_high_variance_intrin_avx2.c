@@ -0,0 +1,233 @@
+/*
+ *  Copyright (c) 2014 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>  // AVX2
+
+#include "./vp9_rtcd.h"
+#include "./vpx_config.h"
+#include "vp9/common/vp9_common.h"
+#include "vp9/common/vp9_filter.h"
+
+// Adds the differences of the 16 pixels 'a' and 'b' and their squares to the
+// 32 bit lanes of 'sum' and 'sse'. A 12 bit pair of squares is just below
+// 2^25, so 'sse' takes 64 of them before it has to be flushed.
+static INLINE void high_variance_16(__m256i a, __m256i b,
+                                    __m256i *sum, __m256i *sse) {
+  const __m256i diff = _mm256_sub_epi16(a, b);
+  *sum = _mm256_add_epi32(*sum, _mm256_madd_epi16(diff, _mm256_set1_epi16(1)));
+  *sse = _mm256_add_epi32(*sse, _mm256_madd_epi16(diff, diff));
+}
+
+// Sum of the differences and of their squares over a w x h block, w being a
+// multiple of 16. The sum is exact in 32 bits, the squares are widened to 64
+// bits every 1024 pixels.
+static void high_variance_avx2(const uint16_t *a, int a_stride,
+                               const uint16_t *b, int b_stride,
+                               int w, int h, uint64_t *sse, int *sum) {
+  const int flush_rows = 1024 / w;
+  const __m256i zero = _mm256_setzero_si256();
+  __m256i sum32 = zero, sse32 = zero, sse64 = zero;
+  __m128i sum128, sse128;
+  int r, c;
+
+  for (r = 0; r < h; ) {
+    const int rows = MIN(h - r, flush_rows);
+    int i;
+    for (i = 0; i < rows; ++i) {
+      for (c = 0; c < w; c += 16)
+        high_variance_16(_mm256_loadu_si256((const __m256i *)(a + c)),
+                         _mm256_loadu_si256((const __m256i *)(b + c)),
+                         &sum32, &sse32);
+      a += a_stride;
+      b += b_stride;
+    }
+    sse64 = _mm256_add_epi64(sse64, _mm256_unpacklo_epi32(sse32, zero));
+    sse64 = _mm256_add_epi64(sse64, _mm256_unpackhi_epi32(sse32, zero));
+    sse32 = zero;
+    r += rows;
+  }
+
+  sum128 = _mm_add_epi32(_mm256_castsi256_si128(sum32),
+                         _mm256_extracti128_si256(sum32, 1));
+  sum128 = _mm_add_epi32(sum128, _mm_srli_si128(sum128, 8));
+  sum128 = _mm_add_epi32(sum128, _mm_srli_si128(sum128, 4));
+  *sum = _mm_cvtsi128_si32(sum128);
+  sse128 = _mm_add_epi64(_mm256_castsi256_si128(sse64),
+                         _mm256_extracti128_si256(sse64, 1));
+  sse128 = _mm_add_epi64(sse128, _mm_srli_si128(sse128, 8));
+#if ARCH_X86_64
+  *sse = _mm_cvtsi128_si64(sse128);
+#else
+  {
+    uint64_t tmp;
+    _mm_storel_epi64((__m128i *)&tmp, sse128);
+    *sse = tmp;
+  }
+#endif
+}
+
+// The 10 and 12 bit versions scale the sums back to 8 bit precision, with
+// the rounding of high_10_variance() and high_12_variance().
+static INLINE void high_calc_variance(const uint8_t *a8, int a_stride,
+                                      const uint8_t *b8, int b_stride,
+                                      int w, int h, int shift,
+                                      unsigned int *sse, int *sum) {
+  uint64_t sse_long;
+  high_variance_avx2(CONVERT_TO_SHORTPTR(a8), a_stride,
+                     CONVERT_TO_SHORTPTR(b8), b_stride, w, h, &sse_long, sum);
+  if (shift) {
+    *sum = ROUND_POWER_OF_TWO(*sum, shift);
+    sse_long = ROUND_POWER_OF_TWO(sse_long, 2 * shift);
+  }
+  *sse = (unsigned int)sse_long;
+}
+
+// Bilinear filter of a w x h block, 'pixel_step' apart, matching
+// high_var_filter_block2d_bil_first_pass() and its second pass. The
+// unpacking and the packing both stay within the 128 bit lanes, which keeps
+// the pixels in order.
+static void high_filter_block2d_bil(const uint16_t *src, int src_stride,
+                                    int pixel_step, uint16_t *dst,
+                                    int w, int h, const int16_t *filter) {
+  const __m256i taps = _mm256_set1_epi32((uint16_t)filter[0] |
+                                         ((uint32_t)filter[1] << 16));
+  const __m256i rounding = _mm256_set1_epi32(1 << (FILTER_BITS - 1));
+  int r, c;
+
+  for (r = 0; r < h; ++r) {
+    for (c = 0; c < w; c += 16) {
+      const __m256i p0 = _mm256_loadu_si256((const __m256i *)(src + c));
+      const __m256i p1 =
+          _mm256_loadu_si256((const __m256i *)(src + c + pixel_step));
+      __m256i lo = _mm256_madd_epi16(_mm256_unpacklo_epi16(p0, p1), taps);
+      __m256i hi = _mm256_madd_epi16(_mm256_unpackhi_epi16(p0, p1), taps);
+      lo = _mm256_srai_epi32(_mm256_add_epi32(lo, rounding), FILTER_BITS);
+      hi = _mm256_srai_epi32(_mm256_add_epi32(hi, rounding), FILTER_BITS);
+      _mm256_storeu_si256((__m256i *)(dst + c), _mm256_packs_epi32(lo, hi));
+    }
+    src += src_stride;
+    dst += w;
+  }
+}
+
+// Sub-pixel variance of a w x h block, the source filtered into 'fdata' and
+// 'temp' first. A zero offset leaves the pixels as they are, so that pass is
+// skipped. The filtered block is averaged with 'second_pred' when it is set.
+static unsigned int high_sub_pixel_variance(const uint8_t *src8,
+                                            int src_stride,
+                                            int xoffset, int yoffset,
+                                            const uint8_t *dst8,
+                                            int dst_stride,
+                                            const uint8_t *second_pred8,
+                                            uint16_t *fdata, uint16_t *temp,
+                                            int w, int h, int shift,
+                                            unsigned int *sse) {
+  const uint16_t *src = CONVERT_TO_SHORTPTR(src8);
+  int stride = src_stride;
+  int sum;
+
+  if (xoffset) {
+    high_filter_block2d_bil(src, stride, 1, fdata, w, h + 1,
+                            BILINEAR_FILTERS_2TAP(xoffset));
+    src = fdata;
+    stride = w;
+  }
+  if (yoffset) {
+    high_filter_block2d_bil(src, stride, stride, temp, w, h,
+                            BILINEAR_FILTERS_2TAP(yoffset));
+    src = temp;
+    stride = w;
+  }
+  if (second_pred8) {
+    const uint16_t *second_pred = CONVERT_TO_SHORTPTR(second_pred8);
+    int r, c;
+    for (r = 0; r < h; ++r) {
+      for (c = 0; c < w; c += 16) {
+        _mm256_storeu_si256((__m256i *)(temp + r * w + c), _mm256_avg_epu16(
+            _mm256_loadu_si256((const __m256i *)(src + r * stride + c)),
+            _mm256_loadu_si256((const __m256i *)(second_pred + r * w + c))));
+      }
+    }
+    src = temp;
+    stride = w;
+  }
+
+  high_calc_variance(CONVERT_TO_BYTEPTR(src), stride, dst8, dst_stride, w, h,
+                     shift, sse, &sum);
+  return *sse - (((int64_t)sum * sum) / (w * h));
+}
+
+#define HIGH_VAR(W, H, BD, SHIFT) \
+unsigned int BD##variance##W##x##H##_avx2( \
+    const uint8_t *a, int a_stride, const uint8_t *b, int b_stride, \
+    unsigned int *sse) { \
+  int sum; \
+  high_calc_variance(a, a_stride, b, b_stride, W, H, SHIFT, sse, &sum); \
+  return *sse - (((int64_t)sum * sum) / (W * H)); \
+} \
+\
+unsigned int BD##sub_pixel_variance##W##x##H##_avx2( \
+    const uint8_t *src, int src_stride, int xoffset, int yoffset, \
+    const uint8_t *dst, int dst_stride, unsigned int *sse) { \
+  uint16_t fdata[(H + 1) * W]; \
+  uint16_t temp[H * W]; \
+  return high_sub_pixel_variance(src, src_stride, xoffset, yoffset, \
+                                 dst, dst_stride, NULL, fdata, temp, \
+                                 W, H, SHIFT, sse); \
+} \
+\
+unsigned int BD##sub_pixel_avg_variance##W##x##H##_avx2( \
+    const uint8_t *src, int src_stride, int xoffset, int yoffset, \
+    const uint8_t *dst, int dst_stride, unsigned int *sse, \
+    const uint8_t *second_pred) { \
+  uint16_t fdata[(H + 1) * W]; \
+  uint16_t temp[H * W]; \
+  return high_sub_pixel_variance(src, src_stride, xoffset, yoffset, \
+                                 dst, dst_stride, second_pred, fdata, temp, \
+                                 W, H, SHIFT, sse); \
+}
+
+#define HIGH_GET_VAR(S, BD, SHIFT) \
+void BD##get##S##x##S##var_avx2( \
+    const uint8_t *src, int src_stride, const uint8_t *ref, int ref_stride, \
+    unsigned int *sse, int *sum) { \
+  high_calc_variance(src, src_stride, ref, ref_stride, S, S, SHIFT, sse, sum); \
+}
+
+#define HIGH_MSE(W, H, BD, SHIFT) \
+unsigned int BD##mse##W##x##H##_avx2( \
+    const uint8_t *src, int src_stride, const uint8_t *ref, int ref_stride, \
+    unsigned int *sse) { \
+  int sum; \
+  high_calc_variance(src, src_stride, ref, ref_stride, W, H, SHIFT, sse, \
+                     &sum); \
+  return *sse; \
+}
+
+#define HIGH_ALL_DEPTHS(MACRO, W, H) \
+  MACRO(W, H, vp9_high_, 0) \
+  MACRO(W, H, vp9_high_10_, 2) \
+  MACRO(W, H, vp9_high_12_, 4)
+
+HIGH_ALL_DEPTHS(HIGH_VAR, 64, 64)
+HIGH_ALL_DEPTHS(HIGH_VAR, 64, 32)
+HIGH_ALL_DEPTHS(HIGH_VAR, 32, 64)
+HIGH_ALL_DEPTHS(HIGH_VAR, 32, 32)
+HIGH_ALL_DEPTHS(HIGH_VAR, 32, 16)
+HIGH_ALL_DEPTHS(HIGH_VAR, 16, 32)
+HIGH_ALL_DEPTHS(HIGH_VAR, 16, 16)
+HIGH_ALL_DEPTHS(HIGH_VAR, 16, 8)
+
+HIGH_GET_VAR(16, vp9_high_, 0)
+HIGH_GET_VAR(16, vp9_high_10_, 2)
+HIGH_GET_VAR(16, vp9_high_12_, 4)
+
+HIGH_ALL_DEPTHS(HIGH_MSE, 16, 16)
+HIGH_ALL_DEPTHS(HIGH_MSE, 16, 8)
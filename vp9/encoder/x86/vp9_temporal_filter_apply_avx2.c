@@ -0,0 +1,82 @@
+/*
+ *  Copyright (c) 2014 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>  // AVX2
+
+#include "./vp9_rtcd.h"
+#include "vpx/vpx_integer.h"
+
+// Blocks are 8 or 16 pixels wide, 16 pixels (one or two rows) are filtered
+// at a time. As in the SSE2 version the modifiers are computed on 16 bits,
+// so that both versions give the same results.
+void vp9_temporal_filter_apply_avx2(uint8_t *frame1,
+                                    unsigned int stride,
+                                    uint8_t *frame2,
+                                    unsigned int block_width,
+                                    unsigned int block_height,
+                                    int strength,
+                                    int filter_weight,
+                                    unsigned int *accumulator,
+                                    uint16_t *count) {
+  const __m128i shift = _mm_cvtsi32_si128(strength);
+  // 0x8000 >> (16 - strength)
+  const __m256i rounding = _mm256_srl_epi16(_mm256_set1_epi16((int16_t)0x8000),
+                                            _mm_cvtsi32_si128(16 - strength));
+  const __m256i three = _mm256_set1_epi16(3);
+  const __m256i sixteen = _mm256_set1_epi16(16);
+  const __m256i weight = _mm256_set1_epi16(filter_weight);
+  const unsigned int pixels = block_width * block_height;
+  unsigned int i;
+
+  for (i = 0; i < pixels; i += 16) {
+    __m128i src;
+    __m256i src_16, pred_16, modifier, pred_modifier, sum;
+
+    if (block_width == 16) {
+      src = _mm_loadu_si128((const __m128i *)frame1);
+      frame1 += stride;
+    } else {
+      src = _mm_unpacklo_epi64(
+          _mm_loadl_epi64((const __m128i *)frame1),
+          _mm_loadl_epi64((const __m128i *)(frame1 + stride)));
+      frame1 += 2 * stride;
+    }
+    src_16 = _mm256_cvtepu8_epi16(src);
+    pred_16 = _mm256_cvtepu8_epi16(
+        _mm_loadu_si128((const __m128i *)(frame2 + i)));
+
+    // modifier = ((src - pred)^2 * 3 + rounding) >> strength
+    modifier = _mm256_sub_epi16(src_16, pred_16);
+    modifier = _mm256_mullo_epi16(modifier, modifier);
+    modifier = _mm256_mullo_epi16(modifier, three);
+    modifier = _mm256_add_epi16(modifier, rounding);
+    modifier = _mm256_srl_epi16(modifier, shift);
+
+    // modifier = (16 - modifier) * filter_weight, the saturation takes care
+    // of modifier > 16.
+    modifier = _mm256_subs_epu16(sixteen, modifier);
+    modifier = _mm256_mullo_epi16(modifier, weight);
+
+    sum = _mm256_loadu_si256((const __m256i *)(count + i));
+    _mm256_storeu_si256((__m256i *)(count + i),
+                        _mm256_add_epi16(sum, modifier));
+
+    // accumulator += modifier * pred
+    pred_modifier = _mm256_mullo_epi16(modifier, pred_16);
+    sum = _mm256_loadu_si256((const __m256i *)(accumulator + i));
+    sum = _mm256_add_epi32(sum, _mm256_cvtepu16_epi32(
+        _mm256_castsi256_si128(pred_modifier)));
+    _mm256_storeu_si256((__m256i *)(accumulator + i), sum);
+    sum = _mm256_loadu_si256((const __m256i *)(accumulator + i + 8));
+    sum = _mm256_add_epi32(sum, _mm256_cvtepu16_epi32(
+        _mm256_extracti128_si256(pred_modifier, 1)));
+    _mm256_storeu_si256((__m256i *)(accumulator + i + 8), sum);
+  }
+}
@@ -52,6 +52,8 @@ VP9_COMMON_SRCS-yes += common/vp9_systemdependent.h
 VP9_COMMON_SRCS-yes += common/vp9_textblit.h
 VP9_COMMON_SRCS-yes += common/vp9_thread.h
 VP9_COMMON_SRCS-yes += common/vp9_thread.c
+VP9_COMMON_SRCS-yes += common/vp9_row_sync.h
+VP9_COMMON_SRCS-yes += common/vp9_row_sync.c
 VP9_COMMON_SRCS-yes += common/vp9_tile_common.h
 VP9_COMMON_SRCS-yes += common/vp9_tile_common.c
 VP9_COMMON_SRCS-yes += common/vp9_loopfilter.c
@@ -71,10 +73,16 @@ VP9_COMMON_SRCS-yes += common/vp9_gpu.c
 VP9_COMMON_SRCS-yes += common/vp9_gpu.h
 VP9_COMMON_SRCS-$(CONFIG_OPENCL) += common/opencl/vp9_opencl.c
 VP9_COMMON_SRCS-$(CONFIG_OPENCL) += common/opencl/vp9_opencl.h
+VP9_COMMON_SRCS-$(CONFIG_CPU_COMPUTE) += common/cpu/vp9_cpu.c
+VP9_COMMON_SRCS-$(CONFIG_CPU_COMPUTE) += common/cpu/vp9_cpu.h
 
 VP9_COMMON_SRCS-$(ARCH_X86)$(ARCH_X86_64) += common/x86/vp9_asm_stubs.c
 VP9_COMMON_SRCS-$(ARCH_X86)$(ARCH_X86_64) += common/x86/vp9_loopfilter_intrin_sse2.c
 VP9_COMMON_SRCS-$(HAVE_AVX2) += common/x86/vp9_loopfilter_intrin_avx2.c
+VP9_COMMON_SRCS-$(HAVE_AVX2) += common/x86/vp9_loopfilter_row_intrin_avx2.c
+VP9_COMMON_SRCS-$(HAVE_SSE2) += common/x86/vp9_intrapred_intrin_sse2.c
+VP9_COMMON_SRCS-$(HAVE_SSSE3) += common/x86/vp9_intrapred_intrin_ssse3.c
+VP9_COMMON_SRCS-$(HAVE_AVX2) += common/x86/vp9_intrapred_intrin_avx2.c
 VP9_COMMON_SRCS-$(CONFIG_VP9_POSTPROC) += common/vp9_postproc.h
 VP9_COMMON_SRCS-$(CONFIG_VP9_POSTPROC) += common/vp9_postproc.c
 VP9_COMMON_SRCS-$(HAVE_MMX) += common/x86/vp9_loopfilter_mmx.asm
@@ -84,6 +92,8 @@ VP9_COMMON_SRCS-$(HAVE_SSSE3) += common/x86/vp9_subpixel_8t_ssse3.asm
 VP9_COMMON_SRCS-$(HAVE_SSSE3) += common/x86/vp9_subpixel_bilinear_ssse3.asm
 VP9_COMMON_SRCS-$(HAVE_AVX2) += common/x86/vp9_subpixel_8t_intrin_avx2.c
 VP9_COMMON_SRCS-$(HAVE_SSSE3) += common/x86/vp9_subpixel_8t_intrin_ssse3.c
+VP9_COMMON_SRCS-$(HAVE_SSSE3) += common/x86/vp9_subpixel_scaled_intrin_ssse3.c
+VP9_COMMON_SRCS-$(HAVE_AVX2) += common/x86/vp9_subpixel_scaled_intrin_avx2.c
 ifeq ($(CONFIG_VP9_POSTPROC),yes)
 VP9_COMMON_SRCS-$(HAVE_SSE2) += common/x86/vp9_postproc_sse2.asm
 endif
@@ -129,6 +139,7 @@ VP9_COMMON_SRCS-$(HAVE_DSPR2)  += common/mips/dspr2/vp9_mblpf_vert_loopfilter_ds
 VP9_COMMON_SRCS-$(HAVE_SSE2) += common/x86/vp9_idct_intrin_sse2.c
 VP9_COMMON_SRCS-$(HAVE_SSE2) += common/x86/vp9_idct_intrin_sse2.h
 VP9_COMMON_SRCS-$(HAVE_SSSE3) += common/x86/vp9_idct_intrin_ssse3.c
+VP9_COMMON_SRCS-$(HAVE_AVX2) += common/x86/vp9_idct_intrin_avx2.c
 ifeq ($(ARCH_X86_64), yes)
 VP9_COMMON_SRCS-$(HAVE_SSSE3) += common/x86/vp9_idct_ssse3_x86_64.asm
 endif
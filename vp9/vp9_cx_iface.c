@@ -18,6 +18,10 @@
 #include "vp9/encoder/vp9_encoder.h"
 #include "vpx/vp8cx.h"
 #include "vp9/encoder/vp9_firstpass.h"
+#include "vp9/encoder/vp9_frame_stats.h"
+#if CONFIG_MULTI_RES_ENCODING
+#include "vp9/encoder/vp9_multi_res.h"
+#endif
 #include "vp9/vp9_iface_common.h"
 
 struct vp9_extracfg {
@@ -39,6 +43,8 @@ struct vp9_extracfg {
   unsigned int                frame_periodic_boost;
   vpx_bit_depth_t             bit_depth;
   vp9e_tune_content           content;
+  unsigned int                lookahead_stats;
+  unsigned int                static_segmentation;
 };
 
 static struct vp9_extracfg default_extra_cfg = {
@@ -59,7 +65,9 @@ static struct vp9_extracfg default_extra_cfg = {
   NO_AQ,                      // aq_mode
   0,                          // frame_periodic_delta_q
   VPX_BITS_8,                 // Bit depth
-  VP9E_CONTENT_DEFAULT        // content
+  VP9E_CONTENT_DEFAULT,       // content
+  0,                          // lookahead_stats
+  0                           // static_segmentation
 };
 
 struct vpx_codec_alg_priv {
@@ -79,6 +87,12 @@ struct vpx_codec_alg_priv {
   vp8_postproc_cfg_t      preview_ppcfg;
   vpx_codec_pkt_list_decl(256) pkt_list;
   unsigned int                 fixed_kf_cntr;
+  // Statistics of the frames of each packet of 'pkt_list', allocated once
+  // they are enabled, and of the invisible frames waiting to be packed with
+  // the next visible one.
+  vpx_frame_stats_t      *pkt_frame_stats;
+  vpx_frame_stats_t       pending_frame_stats;
+  vpx_frame_stats_t       last_frame_stats;
 };
 
 static VP9_REFFRAME ref_frame_to_vp9_reframe(vpx_ref_frame_type_t frame) {
@@ -158,6 +172,15 @@ static vpx_codec_err_t validate_config(vpx_codec_alg_priv_t *ctx,
   RANGE_CHECK(cfg,        g_pass,         VPX_RC_ONE_PASS, VPX_RC_LAST_PASS);
   RANGE_CHECK_BOOL(cfg,                   use_gpu);
 
+#if CONFIG_MULTI_RES_ENCODING
+  // The resolutions are encoded in lockstep, one frame at a time, from one
+  // pass over the input.
+  if (ctx->base.enc.total_encoders > 1) {
+    RANGE_CHECK(cfg,    g_pass,             VPX_RC_ONE_PASS, VPX_RC_ONE_PASS);
+    RANGE_CHECK_HI(cfg, rc_resize_allowed,  0);
+  }
+#endif
+
   if (cfg->rc_resize_allowed == 1) {
     RANGE_CHECK(cfg, rc_scaled_width, 1, cfg->g_w);
     RANGE_CHECK(cfg, rc_scaled_height, 1, cfg->g_h);
@@ -226,6 +249,15 @@ static vpx_codec_err_t validate_config(vpx_codec_alg_priv_t *ctx,
   if (extra_cfg->tuning == VP8_TUNE_SSIM)
       ERROR("Option --tune=ssim is not currently supported in VP9.");
 
+  RANGE_CHECK_BOOL(extra_cfg, lookahead_stats);
+  if (extra_cfg->lookahead_stats) {
+    if (cfg->g_pass != VPX_RC_ONE_PASS || cfg->g_lag_in_frames == 0)
+      ERROR("lookahead_stats requires a one pass encode with lag_in_frames.");
+    if (cfg->ss_number_layers > 1 || cfg->ts_number_layers > 1)
+      ERROR("lookahead_stats is not supported with layers.");
+  }
+  RANGE_CHECK_BOOL(extra_cfg, static_segmentation);
+
   if (cfg->g_pass == VPX_RC_LAST_PASS) {
     const size_t packet_sz = sizeof(FIRSTPASS_STATS);
     const int n_packets = (int)(cfg->rc_twopass_stats_in.sz / packet_sz);
@@ -306,6 +338,15 @@ static vpx_codec_err_t validate_img(vpx_codec_alg_priv_t *ctx,
       break;
   }
 
+#if CONFIG_MULTI_RES_ENCODING
+  // Lower resolutions may take the image of a higher one and downscale it.
+  if (ctx->base.enc.total_encoders > 1) {
+    if (img->d_w < ctx->cfg.g_w || img->d_h < ctx->cfg.g_h)
+      ERROR("Image size must not be smaller than the encoder configuration "
+            "size");
+    return VPX_CODEC_OK;
+  }
+#endif
   if (img->d_w != ctx->cfg.g_w || img->d_h != ctx->cfg.g_h)
     ERROR("Image size must match encoder init configuration size");
 
@@ -358,6 +399,11 @@ static vpx_codec_err_t set_encoder_config(
 
   oxcf->lag_in_frames = cfg->g_pass == VPX_RC_FIRST_PASS ? 0
                                                          : cfg->g_lag_in_frames;
+
+  // The second pass runs over the statistics of the lookahead frames.
+  oxcf->lookahead_stats = extra_cfg->lookahead_stats;
+  if (oxcf->lookahead_stats)
+    oxcf->pass = 2;
   oxcf->rc_mode = cfg->rc_end_usage;
 
   // Convert target bandwidth from Kbit/s to Bit/s
@@ -421,6 +467,8 @@ static vpx_codec_err_t set_encoder_config(
 
   oxcf->frame_periodic_boost =  extra_cfg->frame_periodic_boost;
 
+  oxcf->static_segmentation = extra_cfg->static_segmentation;
+
   oxcf->ss_number_layers = cfg->ss_number_layers;
 
   oxcf->use_gpu = cfg->use_gpu;
@@ -663,10 +711,21 @@ static vpx_codec_err_t ctrl_set_frame_periodic_boost(vpx_codec_alg_priv_t *ctx,
   return update_extra_cfg(ctx, &extra_cfg);
 }
 
+static vpx_codec_err_t encoder_mr_get_mem_loc(const vpx_codec_enc_cfg_t *cfg,
+                                              void **mem_loc) {
+#if CONFIG_MULTI_RES_ENCODING
+  *mem_loc = vp9_mr_alloc_shared_info(cfg->g_w, cfg->g_h);
+  return *mem_loc != NULL ? VPX_CODEC_OK : VPX_CODEC_MEM_ERROR;
+#else
+  (void)cfg;
+  (void)mem_loc;
+  return VPX_CODEC_INCAPABLE;
+#endif
+}
+
 static vpx_codec_err_t encoder_init(vpx_codec_ctx_t *ctx,
                                     vpx_codec_priv_enc_mr_cfg_t *data) {
   vpx_codec_err_t res = VPX_CODEC_OK;
-  (void)data;
 
   if (ctx->priv == NULL) {
     vpx_codec_alg_priv_t *const priv = vpx_calloc(1, sizeof(*priv));
@@ -675,7 +734,8 @@ static vpx_codec_err_t encoder_init(vpx_codec_ctx_t *ctx,
 
     ctx->priv = (vpx_codec_priv_t *)priv;
     ctx->priv->init_flags = ctx->init_flags;
-    ctx->priv->enc.total_encoders = 1;
+    ctx->priv->enc.total_encoders = data != NULL ? data->mr_total_resolutions
+                                                 : 1;
 
     if (ctx->config.enc) {
       // Update the reference to the config structure to an internal copy.
@@ -693,6 +753,14 @@ static vpx_codec_err_t encoder_init(vpx_codec_ctx_t *ctx,
 #if CONFIG_VP9_HIGHBITDEPTH
       priv->oxcf.use_highbitdepth =
           (ctx->init_flags & VPX_CODEC_USE_HIGHBITDEPTH) ? 1 : 0;
+#endif
+#if CONFIG_MULTI_RES_ENCODING
+      if (data != NULL) {
+        priv->oxcf.mr_total_resolutions = data->mr_total_resolutions;
+        priv->oxcf.mr_encoder_id = data->mr_encoder_id;
+        priv->oxcf.mr_down_sampling_factor = data->mr_down_sampling_factor;
+        priv->oxcf.mr_low_res_mode_info = data->mr_low_res_mode_info;
+      }
 #endif
       priv->cpi = vp9_create_compressor(&priv->oxcf);
       if (priv->cpi == NULL)
@@ -706,7 +774,14 @@ static vpx_codec_err_t encoder_init(vpx_codec_ctx_t *ctx,
 }
 
 static vpx_codec_err_t encoder_destroy(vpx_codec_alg_priv_t *ctx) {
+#if CONFIG_MULTI_RES_ENCODING
+  // The encoder of the highest resolution is the last one to be destroyed.
+  if (ctx->oxcf.mr_total_resolutions > 1 &&
+      ctx->oxcf.mr_encoder_id == ctx->oxcf.mr_total_resolutions - 1)
+    vp9_mr_free_shared_info(ctx->oxcf.mr_low_res_mode_info);
+#endif
   free(ctx->cx_data);
+  vpx_free(ctx->pkt_frame_stats);
   vp9_remove_compressor(ctx->cpi);
   vpx_free(ctx);
   return VPX_CODEC_OK;
@@ -906,8 +981,8 @@ static vpx_codec_err_t encoder_encode(vpx_codec_alg_priv_t  *ctx,
 
       // Store the original flags in to the frame buffer. Will extract the
       // key frame flag when we actually encode this frame.
-      if (vp9_receive_raw_frame(cpi, flags,
-                                &sd, dst_time_stamp, dst_end_time_stamp)) {
+      if (vp9_receive_raw_frame(cpi, flags, &sd, img,
+                                dst_time_stamp, dst_end_time_stamp)) {
         res = update_error_state(ctx, &cpi->common.error);
       }
     }
@@ -943,6 +1018,10 @@ static vpx_codec_err_t encoder_encode(vpx_codec_alg_priv_t  *ctx,
           cpi->svc.layer_context[cpi->svc.spatial_layer_id].layer_size += size;
 #endif
 
+        if (ctx->pkt_frame_stats != NULL)
+          vp9_frame_stats_accumulate(&ctx->pending_frame_stats,
+                                     &cpi->frame_stats);
+
         // Pack invisible frames with the next visible frame
         if (!cpi->common.show_frame
 #if CONFIG_SPATIAL_SVC
@@ -984,6 +1063,12 @@ static vpx_codec_err_t encoder_encode(vpx_codec_alg_priv_t  *ctx,
           pkt.data.frame.sz  = size;
         }
         pkt.data.frame.partition_id = -1;
+        if (ctx->pkt_frame_stats != NULL) {
+          const unsigned int index = ctx->pkt_list.head.cnt;
+          if (index < ctx->pkt_list.head.max)
+            ctx->pkt_frame_stats[index] = ctx->pending_frame_stats;
+          vp9_zero(ctx->pending_frame_stats);
+        }
         vpx_codec_pkt_list_add(&ctx->pkt_list.head, &pkt);
         cx_data += size;
         cx_data_sz -= size;
@@ -1004,6 +1089,11 @@ static vpx_codec_err_t encoder_encode(vpx_codec_alg_priv_t  *ctx,
           vpx_codec_pkt_list_add(&ctx->pkt_list.head, &pkt_sizes);
           vpx_codec_pkt_list_add(&ctx->pkt_list.head, &pkt_psnr);
         }
+#endif
+#if CONFIG_MULTI_RES_ENCODING
+        // The resolutions code a shown frame at a time, also when flushing.
+        if (ctx->base.enc.total_encoders > 1)
+          break;
 #endif
       }
     }
@@ -1014,7 +1104,15 @@ static vpx_codec_err_t encoder_encode(vpx_codec_alg_priv_t  *ctx,
 
 static const vpx_codec_cx_pkt_t *encoder_get_cxdata(vpx_codec_alg_priv_t *ctx,
                                                     vpx_codec_iter_t *iter) {
-  return vpx_codec_pkt_list_get(&ctx->pkt_list.head, iter);
+  const vpx_codec_cx_pkt_t *const pkt =
+      vpx_codec_pkt_list_get(&ctx->pkt_list.head, iter);
+
+  // Keep the statistics of the last frame returned for VP9E_GET_FRAME_STATS.
+  if (pkt != NULL && pkt->kind == VPX_CODEC_CX_FRAME_PKT &&
+      ctx->pkt_frame_stats != NULL)
+    ctx->last_frame_stats =
+        ctx->pkt_frame_stats[pkt - ctx->pkt_list.head.pkts];
+  return pkt;
 }
 
 static vpx_codec_err_t ctrl_set_reference(vpx_codec_alg_priv_t *ctx,
@@ -1231,6 +1329,70 @@ static vpx_codec_err_t ctrl_set_tune_content(vpx_codec_alg_priv_t *ctx,
   return update_extra_cfg(ctx, &extra_cfg);
 }
 
+static vpx_codec_err_t ctrl_set_source_release_cb(vpx_codec_alg_priv_t *ctx,
+                                                  va_list args) {
+  vpx_source_release_cb_t *const release =
+      va_arg(args, vpx_source_release_cb_t *);
+  VP9_COMP *const cpi = ctx->cpi;
+
+  if (release == NULL || release->border < 0)
+    return VPX_CODEC_INVALID_PARAM;
+
+  // The lookahead queue is set up with the first frame.
+  if (cpi->lookahead != NULL)
+    return VPX_CODEC_ERROR;
+
+  cpi->source_release = *release;
+  return VPX_CODEC_OK;
+}
+
+static vpx_codec_err_t ctrl_set_frame_stats(vpx_codec_alg_priv_t *ctx,
+                                            va_list args) {
+  const int enabled = CAST(VP9E_SET_FRAME_STATS, args) != 0;
+  const size_t max_pkts = sizeof(ctx->pkt_list.alloc.pkts) /
+                          sizeof(ctx->pkt_list.alloc.pkts[0]);
+
+  if (enabled && ctx->pkt_frame_stats == NULL) {
+    ctx->pkt_frame_stats = vpx_calloc(max_pkts,
+                                      sizeof(*ctx->pkt_frame_stats));
+    if (ctx->pkt_frame_stats == NULL)
+      return VPX_CODEC_MEM_ERROR;
+  }
+  ctx->cpi->frame_stats_enabled = enabled;
+  return VPX_CODEC_OK;
+}
+
+static vpx_codec_err_t ctrl_set_lookahead_stats(vpx_codec_alg_priv_t *ctx,
+                                               va_list args) {
+  struct vp9_extracfg extra_cfg = ctx->extra_cfg;
+  extra_cfg.lookahead_stats = CAST(VP9E_SET_LOOKAHEAD_STATS, args);
+
+  // The lookahead queue is set up with the first frame.
+  if (ctx->cpi->lookahead != NULL &&
+      extra_cfg.lookahead_stats != ctx->extra_cfg.lookahead_stats)
+    return VPX_CODEC_ERROR;
+
+  return update_extra_cfg(ctx, &extra_cfg);
+}
+
+static vpx_codec_err_t ctrl_set_static_segmentation(vpx_codec_alg_priv_t *ctx,
+                                                    va_list args) {
+  struct vp9_extracfg extra_cfg = ctx->extra_cfg;
+  extra_cfg.static_segmentation = CAST(VP9E_SET_STATIC_SEGMENTATION, args);
+  return update_extra_cfg(ctx, &extra_cfg);
+}
+
+static vpx_codec_err_t ctrl_get_frame_stats(vpx_codec_alg_priv_t *ctx,
+                                            va_list args) {
+  vpx_frame_stats_t *const stats = va_arg(args, vpx_frame_stats_t *);
+
+  if (stats == NULL)
+    return VPX_CODEC_INVALID_PARAM;
+
+  *stats = ctx->last_frame_stats;
+  return VPX_CODEC_OK;
+}
+
 static vpx_codec_ctrl_fn_map_t encoder_ctrl_maps[] = {
   {VP8_COPY_REFERENCE,                ctrl_copy_reference},
   {VP8E_UPD_ENTROPY,                  ctrl_update_entropy},
@@ -1263,12 +1425,17 @@ static vpx_codec_ctrl_fn_map_t encoder_ctrl_maps[] = {
   {VP9E_SET_SVC_PARAMETERS,           ctrl_set_svc_parameters},
   {VP9E_SET_SVC_LAYER_ID,             ctrl_set_svc_layer_id},
   {VP9E_SET_TUNE_CONTENT,             ctrl_set_tune_content},
+  {VP9E_SET_SOURCE_RELEASE_CB,        ctrl_set_source_release_cb},
   {VP9E_SET_NOISE_SENSITIVITY,        ctrl_set_noise_sensitivity},
+  {VP9E_SET_FRAME_STATS,              ctrl_set_frame_stats},
+  {VP9E_SET_LOOKAHEAD_STATS,          ctrl_set_lookahead_stats},
+  {VP9E_SET_STATIC_SEGMENTATION,      ctrl_set_static_segmentation},
 
   // Getters
   {VP8E_GET_LAST_QUANTIZER,           ctrl_get_quantizer},
   {VP8E_GET_LAST_QUANTIZER_64,        ctrl_get_quantizer64},
   {VP9_GET_REFERENCE,                 ctrl_get_reference},
+  {VP9E_GET_FRAME_STATS,              ctrl_get_frame_stats},
 
   { -1, NULL},
 };
@@ -1369,6 +1536,6 @@ CODEC_INTERFACE(vpx_codec_vp9_cx) = {
     encoder_set_config,     // vpx_codec_enc_config_set_fn_t
     NULL,        // vpx_codec_get_global_headers_fn_t
     encoder_get_preview,    // vpx_codec_get_preview_frame_fn_t
-    NULL         // vpx_codec_enc_mr_get_mem_loc_fn_t
+    encoder_mr_get_mem_loc  // vpx_codec_enc_mr_get_mem_loc_fn_t
   }
 };
@@ -26,6 +26,8 @@
 #include "vp9/vp9_iface_common.h"
 
 #define VP9_CAP_POSTPROC (CONFIG_VP9_POSTPROC ? VPX_CODEC_CAP_POSTPROC : 0)
+#define VP9_CAP_FRAME_THREADING \
+    (CONFIG_MULTITHREAD ? VPX_CODEC_CAP_FRAME_THREADING : 0)
 
 typedef vpx_codec_stream_info_t vp9_stream_info_t;
 
@@ -42,6 +44,7 @@ struct vpx_codec_alg_priv {
   int                     img_avail;
   int                     flushed;
   int                     invert_tile_order;
+  int                     frame_border;
   int                     frame_parallel_decode;  // frame-based threading.
 
   // External frame buffer info to save for VP9 common.
@@ -67,14 +70,19 @@ static vpx_codec_err_t decoder_init(vpx_codec_ctx_t *ctx,
 
     priv->si.sz = sizeof(priv->si);
     priv->flushed = 0;
+    // Frame parallel decoding needs threads, and does not support the
+    // postprocessing of the frames.
     priv->frame_parallel_decode =
-        (ctx->init_flags & VPX_CODEC_USE_FRAME_THREADING);
-    priv->frame_parallel_decode = 0;  // Disable for now
+        CONFIG_MULTITHREAD &&
+        (ctx->init_flags & VPX_CODEC_USE_FRAME_THREADING) &&
+        !(ctx->init_flags & VPX_CODEC_USE_POSTPROC);
 
     if (ctx->config.dec) {
       priv->cfg = *ctx->config.dec;
       ctx->config.dec = &priv->cfg;
     }
+    if (priv->cfg.threads <= 1)
+      priv->frame_parallel_decode = 0;
   }
 
   return VPX_CODEC_OK;
@@ -257,6 +265,10 @@ static void init_decoder(vpx_codec_alg_priv_t *ctx) {
 
   ctx->pbi->max_threads = ctx->cfg.threads;
   ctx->pbi->inv_tile_order = ctx->invert_tile_order;
+  if (ctx->frame_border > 0) {
+    ctx->pbi->frame_border = MAX(ctx->frame_border, VP9_DEC_BORDER_IN_PIXELS);
+    ctx->pbi->extend_frame_borders = 1;
+  }
   ctx->pbi->frame_parallel_decode = ctx->frame_parallel_decode;
 
   // If postprocessing was enabled by the application and a
@@ -266,6 +278,13 @@ static void init_decoder(vpx_codec_alg_priv_t *ctx) {
     set_default_ppflags(&ctx->postproc_cfg);
 
   init_buffer_callbacks(ctx);
+
+  if (ctx->frame_parallel_decode &&
+      vp9_init_frame_workers(ctx->pbi, ctx->cfg.threads)) {
+    update_error_state(ctx, &ctx->pbi->common.error);
+    vp9_decoder_remove(ctx->pbi);
+    ctx->pbi = NULL;
+  }
 }
 
 static vpx_codec_err_t decode_one(vpx_codec_alg_priv_t *ctx,
@@ -308,10 +327,16 @@ static vpx_codec_err_t decode_one(vpx_codec_alg_priv_t *ctx,
   ctx->pbi->decrypt_state = ctx->decrypt_state;
 
   cm = &ctx->pbi->common;
+  ctx->pbi->user_priv = user_priv;
 
   if (vp9_receive_compressed_data(ctx->pbi, data_sz, data))
     return update_error_state(ctx, &cm->error);
 
+  // In frame parallel mode the frames are retrieved by decoder_get_frame(),
+  // once they are complete.
+  if (ctx->frame_parallel_decode)
+    return VPX_CODEC_OK;
+
   if (ctx->base.init_flags & VPX_CODEC_USE_POSTPROC)
     set_ppflags(ctx, &flags);
 
@@ -336,6 +361,10 @@ static vpx_codec_err_t decoder_decode(vpx_codec_alg_priv_t *ctx,
 
   if (data == NULL && data_sz == 0) {
     ctx->flushed = 1;
+    // Complete the frames still being decoded.
+    if (ctx->frame_parallel_decode && ctx->pbi != NULL &&
+        vp9_drain_frame_workers(ctx->pbi))
+      return update_error_state(ctx, &ctx->pbi->common.error);
     return VPX_CODEC_OK;
   }
 
@@ -432,6 +461,23 @@ static vpx_image_t *decoder_get_frame(vpx_codec_alg_priv_t *ctx,
                                       vpx_codec_iter_t *iter) {
   vpx_image_t *img = NULL;
 
+  if (ctx->frame_parallel_decode) {
+    YV12_BUFFER_CONFIG sd;
+    vp9_ppflags_t flags = {0, 0, 0};
+
+    // Return all the frames that are complete, in display order.
+    if (ctx->pbi != NULL && !vp9_get_raw_frame(ctx->pbi, &sd, &flags)) {
+      const VP9Decoder *const pbi = ctx->pbi;
+      yuvconfig2image(&ctx->img, &sd, pbi->output.user_priv);
+      ctx->img.fb_priv =
+          pbi->common.frame_bufs[pbi->output.fb_idx].raw_frame_buffer.priv;
+      img = &ctx->img;
+      img->bit_depth = (int)pbi->common.bit_depth;
+      *iter = img;
+    }
+    return img;
+  }
+
   if (ctx->img_avail) {
     // iter acts as a flip flop, so an image is only returned on the first
     // call to get_frame.
@@ -464,6 +510,13 @@ static vpx_codec_err_t decoder_set_fb_fn(
   return VPX_CODEC_ERROR;
 }
 
+// The reference frames are only complete once all the frames passed to the
+// decoder are.
+static void drain_frame_workers(vpx_codec_alg_priv_t *ctx) {
+  if (ctx->frame_parallel_decode && ctx->pbi != NULL)
+    vp9_drain_frame_workers(ctx->pbi);
+}
+
 static vpx_codec_err_t ctrl_set_reference(vpx_codec_alg_priv_t *ctx,
                                           va_list args) {
   vpx_ref_frame_t *const data = va_arg(args, vpx_ref_frame_t *);
@@ -473,6 +526,7 @@ static vpx_codec_err_t ctrl_set_reference(vpx_codec_alg_priv_t *ctx,
     YV12_BUFFER_CONFIG sd;
 
     image2yuvconfig(&frame->img, &sd);
+    drain_frame_workers(ctx);
     return vp9_set_reference_dec(&ctx->pbi->common,
                                  (VP9_REFFRAME)frame->frame_type, &sd);
   } else {
@@ -489,6 +543,7 @@ static vpx_codec_err_t ctrl_copy_reference(vpx_codec_alg_priv_t *ctx,
     YV12_BUFFER_CONFIG sd;
 
     image2yuvconfig(&frame->img, &sd);
+    drain_frame_workers(ctx);
 
     return vp9_copy_reference_dec(ctx->pbi,
                                   (VP9_REFFRAME)frame->frame_type, &sd);
@@ -502,7 +557,10 @@ static vpx_codec_err_t ctrl_get_reference(vpx_codec_alg_priv_t *ctx,
   vp9_ref_frame_t *data = va_arg(args, vp9_ref_frame_t *);
 
   if (data) {
-    YV12_BUFFER_CONFIG* fb = get_ref_frame(&ctx->pbi->common, data->idx);
+    YV12_BUFFER_CONFIG* fb;
+
+    drain_frame_workers(ctx);
+    fb = get_ref_frame(&ctx->pbi->common, data->idx);
     if (fb == NULL) return VPX_CODEC_ERROR;
 
     yuvconfig2image(&data->img, fb, NULL);
@@ -560,7 +618,12 @@ static vpx_codec_err_t ctrl_get_frame_corrupted(vpx_codec_alg_priv_t *ctx,
 
   if (corrupted != NULL && ctx->pbi != NULL) {
     const YV12_BUFFER_CONFIG *const frame = ctx->pbi->common.frame_to_show;
-    if (frame == NULL) return VPX_CODEC_ERROR;
+    if (frame == NULL) {
+      // Frame parallel decoding may not have output any frame yet.
+      if (!ctx->frame_parallel_decode) return VPX_CODEC_ERROR;
+      *corrupted = 0;
+      return VPX_CODEC_OK;
+    }
     *corrupted = frame->corrupted;
     return VPX_CODEC_OK;
   } else {
@@ -617,6 +680,53 @@ static vpx_codec_err_t ctrl_set_decryptor(vpx_codec_alg_priv_t *ctx,
   return VPX_CODEC_OK;
 }
 
+static vpx_codec_err_t ctrl_get_frame_buffer_state(vpx_codec_alg_priv_t *ctx,
+                                                   va_list args) {
+  vpx_frame_buffer_state_t *const state =
+      va_arg(args, vpx_frame_buffer_state_t *);
+
+  if (state == NULL)
+    return VPX_CODEC_INVALID_PARAM;
+
+  state->in_use = 0;
+  state->num_refs = 0;
+  if (ctx->pbi != NULL) {
+    const VP9Decoder *const pbi = ctx->pbi;
+    const VP9_COMMON *const cm = &pbi->common;
+    int i, j;
+
+    // A buffer the application handed out again after its release may still
+    // be named by several entries, only the live ones count.
+    for (i = 0; i < FRAME_BUFFERS; ++i) {
+      const RefCntBuffer *const buf = &cm->frame_bufs[i];
+      if (buf->raw_frame_buffer.priv != state->priv)
+        continue;
+      // In serial mode, the last decoded frame is only released by the next
+      // decode call.
+      if (buf->ref_count > 0 ||
+          (pbi->frame_workers == NULL && i == cm->new_fb_idx))
+        state->in_use = 1;
+      for (j = 0; j < REF_FRAMES; ++j)
+        state->num_refs += cm->ref_frame_map[j] == i;
+    }
+  }
+  return VPX_CODEC_OK;
+}
+
+static vpx_codec_err_t ctrl_set_frame_border(vpx_codec_alg_priv_t *ctx,
+                                             va_list args) {
+  const int border = va_arg(args, int);
+
+  if (border < 0 || (border & 31))
+    return VPX_CODEC_INVALID_PARAM;
+  // Like the frame buffer functions, the border of the frame buffers cannot
+  // be changed once the decoder is initialized.
+  if (ctx->pbi != NULL)
+    return VPX_CODEC_ERROR;
+  ctx->frame_border = border;
+  return VPX_CODEC_OK;
+}
+
 static vpx_codec_ctrl_fn_map_t decoder_ctrl_maps[] = {
   {VP8_COPY_REFERENCE,            ctrl_copy_reference},
 
@@ -629,6 +739,7 @@ static vpx_codec_ctrl_fn_map_t decoder_ctrl_maps[] = {
   {VP8_SET_DBG_DISPLAY_MV,        ctrl_set_dbg_options},
   {VP9_INVERT_TILE_DECODE_ORDER,  ctrl_set_invert_tile_order},
   {VPXD_SET_DECRYPTOR,            ctrl_set_decryptor},
+  {VP9D_SET_FRAME_BORDER,         ctrl_set_frame_border},
 
   // Getters
   {VP8D_GET_LAST_REF_UPDATES,     ctrl_get_last_ref_updates},
@@ -636,6 +747,7 @@ static vpx_codec_ctrl_fn_map_t decoder_ctrl_maps[] = {
   {VP9_GET_REFERENCE,             ctrl_get_reference},
   {VP9D_GET_DISPLAY_SIZE,         ctrl_get_display_size},
   {VP9D_GET_BIT_DEPTH,            ctrl_get_bit_depth},
+  {VP9D_GET_FRAME_BUFFER_STATE,   ctrl_get_frame_buffer_state},
 
   { -1, NULL},
 };
@@ -646,7 +758,7 @@ static vpx_codec_ctrl_fn_map_t decoder_ctrl_maps[] = {
 CODEC_INTERFACE(vpx_codec_vp9_dx) = {
   "WebM Project VP9 Decoder" VERSION_STRING,
   VPX_CODEC_INTERNAL_ABI_VERSION,
-  VPX_CODEC_CAP_DECODER | VP9_CAP_POSTPROC |
+  VPX_CODEC_CAP_DECODER | VP9_CAP_POSTPROC | VP9_CAP_FRAME_THREADING |
       VPX_CODEC_CAP_EXTERNAL_FRAME_BUFFER,  // vpx_codec_caps_t
   decoder_init,       // vpx_codec_init_fn_t
   decoder_destroy,    // vpx_codec_destroy_fn_t
@@ -143,7 +143,9 @@ vpx_codec_err_t vpx_codec_enc_init_multi_ver(vpx_codec_ctx_t      *ctx,
         cfg++;
         dsf++;
       }
-      ctx--;
+      /* On failure ctx is back at the first encoder. */
+      if (!res)
+        ctx--;
     }
   }
 
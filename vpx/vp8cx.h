@@ -216,7 +216,54 @@ enum vp8e_enc_control_id {
    *                     temporal layer.
    */
   VP9E_SET_SVC_LAYER_ID,
-  VP9E_SET_TUNE_CONTENT
+  VP9E_SET_TUNE_CONTENT,
+
+  /*!\brief control function to reference source images without copying
+   *
+   * Takes a #vpx_source_release_cb_t. Once set, the encoder may keep
+   * references to the images passed to vpx_codec_encode() instead of copying
+   * them into its lookahead queue, and hands every image back through the
+   * callback when it is done with it. Has to be set before the first frame.
+   */
+  VP9E_SET_SOURCE_RELEASE_CB,
+
+  /*!\brief control function to collect per frame encoding statistics
+   *
+   * 0: off (default), 1: on. Timing the stages of each frame has a small
+   * cost, the statistics are only collected while this is on.
+   */
+  VP9E_SET_FRAME_STATS,
+
+  /*!\brief control function to get the statistics of the last frame
+   *
+   * Takes a #vpx_frame_stats_t, filled with the statistics of the last frame
+   * returned by vpx_codec_get_cx_data(), see #VP9E_SET_FRAME_STATS. The
+   * statistics of invisible frames are added to the ones of the visible frame
+   * they are returned with.
+   */
+  VP9E_GET_FRAME_STATS,
+
+  /*!\brief control function to rate control a one pass encode with two pass
+   * decisions
+   *
+   * 0: off (default), 1: on. The first pass statistics of each frame are
+   * computed as it is pushed into the lookahead, on a thread of its own, and
+   * the two pass rate control runs over those of the lookahead frames.
+   * Requires #vpx_codec_enc_cfg::g_lag_in_frames > 0, has to be set before the
+   * first frame. Scene cuts are only found with a lag of about 16 frames or
+   * more.
+   */
+  VP9E_SET_LOOKAHEAD_STATS,
+
+  /*!\brief control function to code the static regions of the alt ref
+   * groups with a segment of their own
+   *
+   * 0: off (default), 1: on. The MBs that the frames of the group predict
+   * well from the alt ref frame are found by a motion analysis of the
+   * lookahead frames, run on the encoding threads. Only used by the second
+   * pass of a two pass encode, or with #VP9E_SET_LOOKAHEAD_STATS.
+   */
+  VP9E_SET_STATIC_SEGMENTATION
 };
 
 /*!\brief vpx 1-D scaling mode
@@ -334,6 +381,82 @@ typedef struct vpx_svc_layer_id {
   int temporal_layer_id;      /**< Temporal layer id number. */
 } vpx_svc_layer_id_t;
 
+/*!\brief Source image release callback prototype
+ *
+ * Called by the encoder when it does not need the pixels of \a img any more.
+ * \a img is a copy of the image descriptor passed to vpx_codec_encode().
+ */
+typedef void (*vpx_release_source_cb_fn_t)(void *cb_priv,
+                                           const vpx_image_t *img);
+
+/*!\brief  vp9 source release callback
+ *
+ * This is used with the #VP9E_SET_SOURCE_RELEASE_CB control. Every image
+ * accepted by vpx_codec_encode() is released exactly once: right away if the
+ * encoder had to copy it, otherwise when it leaves the lookahead queue, and at
+ * the latest when the encoder is destroyed. Until then the application must
+ * neither modify nor free the image.
+ *
+ * An image is referenced instead of copied when its planes are 16 byte
+ * aligned, its strides are the ones of the encoder's own frame buffers and
+ * \a border is large enough for the encoder's source extension. The encoder
+ * writes to the borders of referenced images: \a border pixels (scaled down
+ * for chroma planes) around each plane have to be addressable.
+ */
+typedef struct vpx_source_release_cb {
+  vpx_release_source_cb_fn_t cb;  /**< release callback, NULL to disable */
+  void *cb_priv;                  /**< passed to \a cb */
+  int border;                     /**< luma border of the images, in pixels */
+} vpx_source_release_cb_t;
+
+/*!\brief vp9 encoding stages
+ *
+ * The stages timed in #vpx_frame_stats_t. Mode decision, motion search and
+ * tokenization are nested in the encoding stage, and motion search in mode
+ * decision; they are interleaved block by block and only have a busy time.
+ */
+enum vp9e_stage {
+  VP9E_STAGE_TEMPORAL_FILTER,  /**< alt ref frame filtering */
+  VP9E_STAGE_ENCODE,           /**< partitioning, mode decision and coding */
+  VP9E_STAGE_MODE_DECISION,    /**< pick of the modes of each block */
+  VP9E_STAGE_MOTION_SEARCH,    /**< motion search of the mode decision */
+  VP9E_STAGE_TOKENIZE,         /**< tokenization of the coefficients */
+  VP9E_STAGE_LOOP_FILTER,      /**< filter level search and filtering */
+  VP9E_STAGE_PACK,             /**< bitstream packing */
+  VP9E_STAGE_COUNT
+};
+
+/*!\brief Maximum number of threads in #vpx_frame_stats_t */
+#define VP9E_STATS_MAX_THREADS 64
+
+/*!\brief  vp9 time spent in an encoding stage, in microseconds */
+typedef struct vpx_stage_time {
+  int64_t wall_us;    /**< elapsed time */
+  int64_t busy_us;    /**< time spent working, summed over the threads */
+} vpx_stage_time_t;
+
+/*!\brief  vp9 frame statistics
+ *
+ * This is used with the #VP9E_GET_FRAME_STATS control. Times are wall clock
+ * times in microseconds, not CPU times: the busy time of a stage sums the
+ * time each thread spent working on it, their time waiting on each other is
+ * their idle time, and both include the time the threads were preempted.
+ * Mode decision, motion search and tokenization are timed block by block
+ * within the encode stage, they only have a busy time, as does the loop
+ * filter when it is applied along with the encoding. Motion search is part of
+ * the mode decision.
+ */
+typedef struct vpx_frame_stats {
+  int64_t frame_us;                          /**< elapsed time of the frame */
+  vpx_stage_time_t stages[VP9E_STAGE_COUNT]; /**< time of each stage */
+  int threads;                               /**< number of threads */
+  /*!\brief time each thread waited in the multi-threaded stages */
+  int64_t thread_idle_us[VP9E_STATS_MAX_THREADS];
+  uint64_t sad_calls;        /**< SADs computed by the motion searches */
+  uint64_t subpel_searches;  /**< sub-pixel motion searches */
+  uint64_t rd_evals;         /**< modes evaluated by the mode decision */
+} vpx_frame_stats_t;
+
 /*!\brief VP8 encoder control function parameter type
  *
  * Defines the data types that VP8E control functions take. Note that
@@ -389,6 +512,15 @@ VPX_CTRL_USE_TYPE(VP9E_SET_FRAME_PERIODIC_BOOST, unsigned int)
 VPX_CTRL_USE_TYPE(VP9E_SET_NOISE_SENSITIVITY,  unsigned int)
 
 VPX_CTRL_USE_TYPE(VP9E_SET_TUNE_CONTENT, int) /* vp9e_tune_content */
+
+VPX_CTRL_USE_TYPE(VP9E_SET_SOURCE_RELEASE_CB, vpx_source_release_cb_t *)
+
+VPX_CTRL_USE_TYPE(VP9E_SET_FRAME_STATS, unsigned int)
+VPX_CTRL_USE_TYPE(VP9E_GET_FRAME_STATS, vpx_frame_stats_t *)
+
+VPX_CTRL_USE_TYPE(VP9E_SET_LOOKAHEAD_STATS, unsigned int)
+
+VPX_CTRL_USE_TYPE(VP9E_SET_STATIC_SEGMENTATION, unsigned int)
 /*! @} - end defgroup vp8_encoder */
 #ifdef __cplusplus
 }  // extern "C"
@@ -81,6 +81,27 @@ enum vp8_dec_control_id {
   /** For testing. */
   VP9_INVERT_TILE_DECODE_ORDER,
 
+  /** control function to get the state of an external frame buffer. Takes a
+   * vpx_frame_buffer_state_t whose priv member identifies the buffer.
+   */
+  VP9D_GET_FRAME_BUFFER_STATE,
+
+  /** control function to set the width of the border the decoded frames are
+   * extended into, in pixels, so that they can be used in place by stages
+   * reading past their edges. Has to be a multiple of 32, and set before the
+   * first frame is decoded. The default of 0 leaves the content of the
+   * borders undefined; the decoder never writes to a frame once it has been
+   * output either way.
+   */
+  VP9D_SET_FRAME_BORDER,
+
+  /** control function to get the contention statistics of the
+   * synchronization of the MB rows decoded by different threads. Takes a
+   * vpx_row_sync_stats_t. The counts are summed since the decoder was
+   * initialized, frame size changes included.
+   */
+  VP8D_GET_ROW_SYNC_STATS,
+
   VP8_DECODER_CTRL_ID_MAX
 };
 
@@ -106,6 +127,46 @@ typedef struct vpx_decrypt_init {
  */
 typedef vpx_decrypt_init vp8_decrypt_init;
 
+/*!\brief Structure to hold the state of an external frame buffer
+ *
+ * Tells the application why the decoder is holding one of the frame buffers
+ * obtained from its get frame buffer callback. A buffer that is in use but
+ * not a reference is only held until its frame is decoded and output: the
+ * decoder releases it on the next call to vpx_codec_decode(), or, in frame
+ * parallel mode, on the next call to vpx_codec_get_frame().
+ */
+typedef struct vpx_frame_buffer_state {
+    /*! Private data of the frame buffer, as set by the get callback. */
+    void *priv;
+
+    /*! Nonzero while the decoder holds the frame buffer. */
+    int in_use;
+
+    /*! Number of the reference frame slots pointing to the frame buffer. */
+    int num_refs;
+} vpx_frame_buffer_state_t;
+
+/*!\brief Structure to hold the MB row synchronization statistics
+ *
+ * A thread decoding a MB row waits on the row above until it is sync_range
+ * MBs ahead. A wait first spins, then blocks once spinning did not pay off.
+ */
+typedef struct vpx_row_sync_stats {
+    /*! Number of times the row above was found behind. */
+    uint64_t stalls;
+
+    /*! Number of pause iterations spent spinning on the row above. */
+    uint64_t spins;
+
+    /*! Number of stalls which ended up blocking the thread. */
+    uint64_t waits;
+
+    /*! Number of MBs between the progress updates of a row, for the current
+     * frame size. 0 when the MB rows are not decoded by several threads.
+     */
+    int sync_range;
+} vpx_row_sync_stats_t;
+
 
 /*!\brief VP8 decoder control function parameter type
  *
@@ -123,6 +184,9 @@ VPX_CTRL_USE_TYPE(VP8D_SET_DECRYPTOR,           vpx_decrypt_init *)
 VPX_CTRL_USE_TYPE(VP9D_GET_DISPLAY_SIZE,        int *)
 VPX_CTRL_USE_TYPE(VP9D_GET_BIT_DEPTH,           unsigned int *)
 VPX_CTRL_USE_TYPE(VP9_INVERT_TILE_DECODE_ORDER, int)
+VPX_CTRL_USE_TYPE(VP9D_GET_FRAME_BUFFER_STATE,  vpx_frame_buffer_state_t *)
+VPX_CTRL_USE_TYPE(VP9D_SET_FRAME_BORDER,        int)
+VPX_CTRL_USE_TYPE(VP8D_GET_ROW_SYNC_STATS,      vpx_row_sync_stats_t *)
 
 /*! @} - end defgroup vp8_decoder */
 
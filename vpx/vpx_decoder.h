@@ -361,7 +361,9 @@ extern "C" {
    * \note
    * When decoding VP9, the application may be required to pass in at least
    * #VP9_MAXIMUM_REF_BUFFERS + #VPX_MAXIMUM_WORK_BUFFERS external frame
-   * buffers.
+   * buffers, or #VP9_MAXIMUM_REF_BUFFERS +
+   * #VPX_MAXIMUM_FRAME_PARALLEL_WORK_BUFFERS with
+   * #VPX_CODEC_USE_FRAME_THREADING.
    */
   vpx_codec_err_t vpx_codec_set_frame_buffer_functions(
       vpx_codec_ctx_t *ctx,
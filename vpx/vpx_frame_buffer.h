@@ -25,6 +25,11 @@ extern "C" {
  */
 #define VPX_MAXIMUM_WORK_BUFFERS 1
 
+/*!\brief The maximum number of work buffers used by libvpx when decoding
+ * with #VPX_CODEC_USE_FRAME_THREADING, one per frame decoded at once.
+ */
+#define VPX_MAXIMUM_FRAME_PARALLEL_WORK_BUFFERS 4
+
 /*!\brief The maximum number of reference buffers that a VP9 encoder may use.
  */
 #define VP9_MAXIMUM_REF_BUFFERS 8
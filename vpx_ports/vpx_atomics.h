@@ -0,0 +1,135 @@
+/*
+ *  Copyright (c) 2014 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef VPX_PORTS_VPX_ATOMICS_H_
+#define VPX_PORTS_VPX_ATOMICS_H_
+
+#include "./vpx_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  // __cplusplus
+
+#if CONFIG_MULTITHREAD
+
+#if defined(__GNUC__) && \
+    (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 7))
+#define VPX_USE_ATOMIC_BUILTINS 1
+#elif defined(_MSC_VER)
+#include <windows.h>
+#include <intrin.h>
+#elif defined(__GNUC__)
+#define VPX_USE_SYNC_BUILTINS 1
+#else
+#error Unsupported compiler, cannot build multithreaded code.
+#endif
+
+#endif  // CONFIG_MULTITHREAD
+
+typedef struct vpx_atomic_int {
+  volatile int value;
+} vpx_atomic_int;
+
+#define VPX_ATOMIC_INIT(num) { num }
+
+// vpx_atomic_fetch_add() adds 'val' and returns the previous value, as a
+// single read-modify-write with acquire and release semantics.
+
+#if defined(VPX_USE_ATOMIC_BUILTINS)
+
+static INLINE void vpx_atomic_memory_barrier(void) {
+  __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+static INLINE void vpx_atomic_store_release(vpx_atomic_int *atomic, int val) {
+  __atomic_store_n(&atomic->value, val, __ATOMIC_RELEASE);
+}
+
+static INLINE int vpx_atomic_load_acquire(const vpx_atomic_int *atomic) {
+  return __atomic_load_n(&atomic->value, __ATOMIC_ACQUIRE);
+}
+
+static INLINE int vpx_atomic_fetch_add(vpx_atomic_int *atomic, int val) {
+  return __atomic_fetch_add(&atomic->value, val, __ATOMIC_ACQ_REL);
+}
+
+#elif defined(VPX_USE_SYNC_BUILTINS)
+
+static INLINE void vpx_atomic_memory_barrier(void) {
+  __sync_synchronize();
+}
+
+static INLINE void vpx_atomic_store_release(vpx_atomic_int *atomic, int val) {
+  __sync_synchronize();
+  atomic->value = val;
+}
+
+static INLINE int vpx_atomic_load_acquire(const vpx_atomic_int *atomic) {
+  const int val = atomic->value;
+  __sync_synchronize();
+  return val;
+}
+
+static INLINE int vpx_atomic_fetch_add(vpx_atomic_int *atomic, int val) {
+  return __sync_fetch_and_add(&atomic->value, val);
+}
+
+#elif CONFIG_MULTITHREAD && defined(_MSC_VER)
+
+static INLINE void vpx_atomic_memory_barrier(void) {
+  MemoryBarrier();
+}
+
+// Volatile accesses have acquire / release semantics with MSVC, only the
+// compiler needs to be kept from reordering them.
+static INLINE void vpx_atomic_store_release(vpx_atomic_int *atomic, int val) {
+  _ReadWriteBarrier();
+  atomic->value = val;
+}
+
+static INLINE int vpx_atomic_load_acquire(const vpx_atomic_int *atomic) {
+  const int val = atomic->value;
+  _ReadWriteBarrier();
+  return val;
+}
+
+static INLINE int vpx_atomic_fetch_add(vpx_atomic_int *atomic, int val) {
+  return InterlockedExchangeAdd((volatile LONG *)&atomic->value, val);
+}
+
+#else  // !CONFIG_MULTITHREAD
+
+static INLINE void vpx_atomic_memory_barrier(void) {}
+
+static INLINE void vpx_atomic_store_release(vpx_atomic_int *atomic, int val) {
+  atomic->value = val;
+}
+
+static INLINE int vpx_atomic_load_acquire(const vpx_atomic_int *atomic) {
+  return atomic->value;
+}
+
+static INLINE int vpx_atomic_fetch_add(vpx_atomic_int *atomic, int val) {
+  const int old = atomic->value;
+  atomic->value += val;
+  return old;
+}
+
+#endif
+
+static INLINE void vpx_atomic_init(vpx_atomic_int *atomic, int val) {
+  atomic->value = val;
+}
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif  // __cplusplus
+
+#endif  // VPX_PORTS_VPX_ATOMICS_H_
@@ -13,6 +13,7 @@ PORTS_SRCS-yes += vpx_ports.mk
 
 PORTS_SRCS-$(BUILD_LIBVPX) += asm_offsets.h
 PORTS_SRCS-$(BUILD_LIBVPX) += mem.h
+PORTS_SRCS-$(BUILD_LIBVPX) += vpx_atomics.h
 PORTS_SRCS-$(BUILD_LIBVPX) += vpx_timer.h
 
 ifeq ($(ARCH_X86)$(ARCH_X86_64),yes)
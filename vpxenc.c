@@ -152,6 +152,11 @@ static const arg_def_t fpf_name         = ARG_DEF(NULL, "fpf", 1,
 static const arg_def_t fpmbf_name         = ARG_DEF(NULL, "fpmbf", 1,
                                       "First pass block statistics file name");
 #endif
+#if CONFIG_VP9_ENCODER
+static const arg_def_t frame_stats_name = ARG_DEF(NULL, "frame-stats", 1,
+                                    "Per frame encoding statistics file name "
+                                    "(VP9 only, CSV)");
+#endif
 static const arg_def_t limit = ARG_DEF(NULL, "limit", 1,
                                        "Stop encoding after n input frames");
 static const arg_def_t skip = ARG_DEF(NULL, "skip", 1,
@@ -211,6 +216,9 @@ static const arg_def_t *main_args[] = {
   &deadline, &best_dl, &good_dl, &rt_dl,
   &quietarg, &verbosearg, &psnrarg, &use_ivf, &out_part, &q_hist_n,
   &rate_hist_n, &disable_warnings, &disable_warning_prompt,
+#if CONFIG_VP9_ENCODER
+  &frame_stats_name,
+#endif
   NULL
 };
 
@@ -416,12 +424,22 @@ static const struct arg_enum_list tune_content_enum[] = {
 static const arg_def_t tune_content = ARG_DEF_ENUM(
     NULL, "tune-content", 1, "Tune content type", tune_content_enum);
 
+static const arg_def_t lookahead_stats = ARG_DEF(
+    NULL, "lookahead-stats", 1,
+    "Two pass rate control over the lookahead frames in one pass "
+    "(0: off (default), 1: on)");
+
+static const arg_def_t static_segmentation = ARG_DEF(
+    NULL, "static-segmentation", 1,
+    "Segment the static regions of the alt ref groups "
+    "(0: off (default), 1: on)");
+
 static const arg_def_t *vp9_args[] = {
   &cpu_used, &auto_altref, &sharpness, &static_thresh,
   &tile_cols, &tile_rows, &arnr_maxframes, &arnr_strength, &arnr_type,
   &tune_ssim, &cq_level, &max_intra_rate_pct, &lossless,
   &frame_parallel_decoding, &aq_mode, &frame_periodic_boost,
-  &noise_sens, &tune_content,
+  &noise_sens, &tune_content, &lookahead_stats, &static_segmentation,
 #if CONFIG_VP9 && CONFIG_VP9_HIGHBITDEPTH
   &bitdeptharg, &inbitdeptharg,
 #endif
@@ -435,7 +453,8 @@ static const int vp9_arg_ctrl_map[] = {
   VP8E_SET_TUNING, VP8E_SET_CQ_LEVEL, VP8E_SET_MAX_INTRA_BITRATE_PCT,
   VP9E_SET_LOSSLESS, VP9E_SET_FRAME_PARALLEL_DECODING, VP9E_SET_AQ_MODE,
   VP9E_SET_FRAME_PERIODIC_BOOST, VP9E_SET_NOISE_SENSITIVITY,
-  VP9E_SET_TUNE_CONTENT,
+  VP9E_SET_TUNE_CONTENT, VP9E_SET_LOOKAHEAD_STATS,
+  VP9E_SET_STATIC_SEGMENTATION,
   0
 };
 #endif
@@ -729,6 +748,9 @@ struct stream_config {
   const char               *stats_fn;
 #if CONFIG_FP_MB_STATS
   const char               *fpmb_stats_fn;
+#endif
+#if CONFIG_VP9_ENCODER
+  const char               *frame_stats_fn;
 #endif
   stereo_format_t           stereo_fmt;
   int                       arg_ctrls[ARG_CTRL_CNT_MAX][2];
@@ -761,6 +783,9 @@ struct stream_state {
   stats_io_t                stats;
 #if CONFIG_FP_MB_STATS
   stats_io_t                fpmb_stats;
+#endif
+#if CONFIG_VP9_ENCODER
+  FILE                     *frame_stats_file;
 #endif
   struct vpx_image         *img;
   vpx_codec_ctx_t           decoder;
@@ -1051,6 +1076,12 @@ static int parse_stream_params(struct VpxEncoderConfig *global,
 #if CONFIG_FP_MB_STATS
     } else if (arg_match(&arg, &fpmbf_name, argi)) {
       config->fpmb_stats_fn = arg.val;
+#endif
+#if CONFIG_VP9_ENCODER
+    } else if (arg_match(&arg, &frame_stats_name, argi)) {
+      if (strcmp(global->codec->name, "vp9") != 0)
+        die("Error: --frame-stats is only supported by VP9\n");
+      config->frame_stats_fn = arg.val;
 #endif
     } else if (arg_match(&arg, &use_ivf, argi)) {
       config->write_webm = 0;
@@ -1248,6 +1279,17 @@ static void validate_stream_config(const struct stream_state *stream,
               streami->index, stream->index);
     }
 #endif
+
+#if CONFIG_VP9_ENCODER
+    /* Check for two streams sharing a frame stats file. */
+    if (streami != stream) {
+      const char *a = stream->config.frame_stats_fn;
+      const char *b = streami->config.frame_stats_fn;
+      if (a && b && !strcmp(a, b))
+        fatal("Stream %d: duplicate frame stats file (from stream %d)",
+              streami->index, stream->index);
+    }
+#endif
   }
 }
 
@@ -1382,6 +1424,19 @@ static void open_output_file(struct stream_state *stream,
   if (!stream->config.write_webm) {
     ivf_write_file_header(stream->file, cfg, global->codec->fourcc, 0);
   }
+
+#if CONFIG_VP9_ENCODER
+  if (stream->config.frame_stats_fn) {
+    stream->frame_stats_file = fopen(stream->config.frame_stats_fn, "w");
+    if (!stream->frame_stats_file)
+      fatal("Failed to open frame statistics file");
+    fprintf(stream->frame_stats_file,
+            "frame,size,frame_us,temporal_filter_us,encode_us,encode_busy_us,"
+            "mode_decision_busy_us,motion_search_busy_us,"
+            "tokenize_busy_us,loop_filter_us,loop_filter_busy_us,"
+            "pack_us,threads,idle_us,sad_calls,subpel_searches,rd_evals\n");
+  }
+#endif
 }
 
 
@@ -1406,6 +1461,12 @@ static void close_output_file(struct stream_state *stream,
   }
 
   fclose(stream->file);
+#if CONFIG_VP9_ENCODER
+  if (stream->frame_stats_file) {
+    fclose(stream->frame_stats_file);
+    stream->frame_stats_file = NULL;
+  }
+#endif
 }
 
 
@@ -1479,6 +1540,14 @@ static void initialize_encoder(struct stream_state *stream,
     ctx_exit_on_error(&stream->encoder, "Failed to control codec");
   }
 
+#if CONFIG_VP9_ENCODER
+  if (stream->config.frame_stats_fn &&
+      stream->config.cfg.g_pass != VPX_RC_FIRST_PASS) {
+    vpx_codec_control(&stream->encoder, VP9E_SET_FRAME_STATS, 1);
+    ctx_exit_on_error(&stream->encoder, "Failed to enable frame statistics");
+  }
+#endif
+
 #if CONFIG_DECODERS
   if (global->test_decode != TEST_DECODE_OFF) {
     const VpxInterface *decoder = get_vpx_decoder_by_name(global->codec->name);
@@ -1598,6 +1667,38 @@ static void update_quantizer_histogram(struct stream_state *stream) {
 }
 
 
+#if CONFIG_VP9_ENCODER
+static void write_frame_stats(struct stream_state *stream, size_t size) {
+  vpx_frame_stats_t stats;
+  const vpx_stage_time_t *const stages = stats.stages;
+  int64_t idle_us = 0;
+  int i;
+
+  vpx_codec_control(&stream->encoder, VP9E_GET_FRAME_STATS, &stats);
+  ctx_exit_on_error(&stream->encoder, "Failed to get frame statistics");
+
+  for (i = 0; i < stats.threads; i++)
+    idle_us += stats.thread_idle_us[i];
+
+  fprintf(stream->frame_stats_file,
+          "%u,%u,%"PRId64",%"PRId64",%"PRId64",%"PRId64",%"PRId64",%"PRId64","
+          "%"PRId64",%"PRId64",%"PRId64",%"PRId64",%d,%"PRId64",%"PRIu64","
+          "%"PRIu64",%"PRIu64"\n",
+          stream->frames_out, (unsigned int)size, stats.frame_us,
+          stages[VP9E_STAGE_TEMPORAL_FILTER].wall_us,
+          stages[VP9E_STAGE_ENCODE].wall_us,
+          stages[VP9E_STAGE_ENCODE].busy_us,
+          stages[VP9E_STAGE_MODE_DECISION].busy_us,
+          stages[VP9E_STAGE_MOTION_SEARCH].busy_us,
+          stages[VP9E_STAGE_TOKENIZE].busy_us,
+          stages[VP9E_STAGE_LOOP_FILTER].wall_us,
+          stages[VP9E_STAGE_LOOP_FILTER].busy_us,
+          stages[VP9E_STAGE_PACK].wall_us,
+          stats.threads, idle_us, stats.sad_calls, stats.subpel_searches,
+          stats.rd_evals);
+}
+#endif
+
 static void get_cx_data(struct stream_state *stream,
                         struct VpxEncoderConfig *global,
                         int *got_data) {
@@ -1614,6 +1715,10 @@ static void get_cx_data(struct stream_state *stream,
       case VPX_CODEC_CX_FRAME_PKT:
         if (!(pkt->data.frame.flags & VPX_FRAME_IS_FRAGMENT)) {
           stream->frames_out++;
+#if CONFIG_VP9_ENCODER
+          if (stream->frame_stats_file)
+            write_frame_stats(stream, pkt->data.frame.sz);
+#endif
         }
         if (!global->quiet)
           fprintf(stderr, " %6luF", (unsigned long)pkt->data.frame.sz);